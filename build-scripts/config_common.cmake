@@ -165,6 +165,131 @@ if (WAMR_BUILD_LINUX_PERF EQUAL 1)
   endif ()
 endif ()
 
+if (WAMR_BUILD_MEMORY_SNAPSHOT EQUAL 1)
+  if (NOT WAMR_BUILD_PLATFORM STREQUAL "linux")
+    message(WARNING "only support memory snapshot on linux")
+    set(WAMR_BUILD_MEMORY_SNAPSHOT 0)
+  elseif (WAMR_BUILD_GC EQUAL 1)
+    message(WARNING "memory snapshot isn't supported when GC is enabled")
+    set(WAMR_BUILD_MEMORY_SNAPSHOT 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_INSTANCE_RESET EQUAL 1 AND WAMR_BUILD_GC EQUAL 1)
+  message(WARNING "instance reset isn't supported when GC is enabled")
+  set(WAMR_BUILD_INSTANCE_RESET 0)
+endif ()
+
+if (WAMR_BUILD_LAZY_FUNC_VALIDATION EQUAL 1)
+  if (NOT WAMR_BUILD_INTERP EQUAL 1)
+    message(WARNING "lazy function validation requires the interpreter")
+    set(WAMR_BUILD_LAZY_FUNC_VALIDATION 0)
+  elseif (WAMR_BUILD_FAST_JIT EQUAL 1 OR WAMR_BUILD_JIT EQUAL 1)
+    message(WARNING "lazy function validation isn't supported when JIT is enabled")
+    set(WAMR_BUILD_LAZY_FUNC_VALIDATION 0)
+  elseif (WAMR_BUILD_MINI_LOADER EQUAL 1 OR WAMR_BUILD_DEBUG_INTERP EQUAL 1)
+    message(WARNING "lazy function validation isn't supported by the mini loader and debug interpreter")
+    set(WAMR_BUILD_LAZY_FUNC_VALIDATION 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_FAST_INTERP_CACHE EQUAL 1)
+  if (NOT WAMR_BUILD_INTERP EQUAL 1 OR NOT WAMR_BUILD_FAST_INTERP EQUAL 1)
+    message(WARNING "fast interpreter cache requires the fast interpreter")
+    set(WAMR_BUILD_FAST_INTERP_CACHE 0)
+  elseif (WAMR_BUILD_FAST_JIT EQUAL 1 OR WAMR_BUILD_JIT EQUAL 1)
+    message(WARNING "fast interpreter cache isn't supported when JIT is enabled")
+    set(WAMR_BUILD_FAST_INTERP_CACHE 0)
+  elseif (WAMR_BUILD_MINI_LOADER EQUAL 1 OR WAMR_BUILD_DEBUG_INTERP EQUAL 1)
+    message(WARNING "fast interpreter cache isn't supported by the mini loader and debug interpreter")
+    set(WAMR_BUILD_FAST_INTERP_CACHE 0)
+  elseif (WAMR_BUILD_GC EQUAL 1 OR WAMR_BUILD_EXCE_HANDLING EQUAL 1)
+    message(WARNING "fast interpreter cache isn't supported when GC or exception handling is enabled")
+    set(WAMR_BUILD_FAST_INTERP_CACHE 0)
+  elseif (NOT WAMR_BUILD_PLATFORM STREQUAL "linux" AND NOT WAMR_BUILD_PLATFORM STREQUAL "darwin")
+    message(WARNING "fast interpreter cache is only supported on linux and darwin")
+    set(WAMR_BUILD_FAST_INTERP_CACHE 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_FAST_INTERP_TAIL_DISPATCH EQUAL 1)
+  if (NOT WAMR_BUILD_INTERP EQUAL 1 OR NOT WAMR_BUILD_FAST_INTERP EQUAL 1)
+    message(WARNING "fast interpreter tail-call dispatch requires the fast interpreter")
+    set(WAMR_BUILD_FAST_INTERP_TAIL_DISPATCH 0)
+  elseif (WAMR_BUILD_GC EQUAL 1)
+    message(WARNING "fast interpreter tail-call dispatch isn't supported when GC is enabled")
+    set(WAMR_BUILD_FAST_INTERP_TAIL_DISPATCH 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_AOT_SHARED_TEXT EQUAL 1)
+  if (NOT WAMR_BUILD_AOT EQUAL 1)
+    message(WARNING "aot shared text requires aot")
+    set(WAMR_BUILD_AOT_SHARED_TEXT 0)
+  elseif (NOT WAMR_BUILD_PLATFORM STREQUAL "linux" AND NOT WAMR_BUILD_PLATFORM STREQUAL "darwin")
+    message(WARNING "aot shared text is only supported on linux and darwin")
+    set(WAMR_BUILD_AOT_SHARED_TEXT 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_AOT_SAFEPOINT EQUAL 1)
+  if (NOT WAMR_BUILD_AOT EQUAL 1)
+    message(WARNING "aot safepoint requires aot")
+    set(WAMR_BUILD_AOT_SAFEPOINT 0)
+  elseif (NOT WAMR_BUILD_PLATFORM STREQUAL "linux" AND NOT WAMR_BUILD_PLATFORM STREQUAL "darwin")
+    message(WARNING "aot safepoint is only supported on linux and darwin")
+    set(WAMR_BUILD_AOT_SAFEPOINT 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_SAMPLING_PROFILING EQUAL 1)
+  if (NOT WAMR_BUILD_PLATFORM STREQUAL "linux" AND NOT WAMR_BUILD_PLATFORM STREQUAL "darwin")
+    message(WARNING "sampling profiling is only supported on linux and darwin")
+    set(WAMR_BUILD_SAMPLING_PROFILING 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_FUEL_METERING EQUAL 1)
+  if (WAMR_BUILD_DEBUG_INTERP EQUAL 1)
+    message(WARNING "fuel metering isn't supported when debug interpreter is enabled")
+    set(WAMR_BUILD_FUEL_METERING 0)
+  elseif (WAMR_BUILD_FAST_JIT EQUAL 1)
+    message(WARNING "fuel metering isn't supported when fast jit is enabled")
+    set(WAMR_BUILD_FUEL_METERING 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_SHARED_HEAP EQUAL 1)
+  if (WAMR_BUILD_FAST_JIT EQUAL 1)
+    message(WARNING "shared heap isn't supported when fast jit is enabled")
+    set(WAMR_BUILD_SHARED_HEAP 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_GC_NURSERY EQUAL 1)
+  if (NOT WAMR_BUILD_GC EQUAL 1)
+    message(WARNING "GC nursery requires GC to be enabled")
+    set(WAMR_BUILD_GC_NURSERY 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_GC_PARALLEL_MARK EQUAL 1)
+  if (NOT WAMR_BUILD_GC EQUAL 1)
+    message(WARNING "GC parallel marking requires GC to be enabled")
+    set(WAMR_BUILD_GC_PARALLEL_MARK 0)
+  endif ()
+endif ()
+
+if (WAMR_BUILD_GC_INCREMENTAL EQUAL 1)
+  if (NOT WAMR_BUILD_GC EQUAL 1)
+    message(WARNING "incremental GC requires GC to be enabled")
+    set(WAMR_BUILD_GC_INCREMENTAL 0)
+  elseif (WAMR_BUILD_GC_NURSERY EQUAL 1)
+    message(WARNING "GC nursery isn't supported when incremental GC is enabled")
+    set(WAMR_BUILD_GC_NURSERY 0)
+  endif ()
+endif ()
+
 ########################################
 
 message ("-- Build Configurations:")
@@ -261,6 +386,10 @@ if (WAMR_BUILD_MEMORY64 EQUAL 1)
   set (WAMR_DISABLE_HW_BOUND_CHECK 1)
   message ("     Memory64 memory enabled")
 endif ()
+if (WAMR_BUILD_SHARED_HEAP EQUAL 1)
+  add_definitions (-DWASM_ENABLE_SHARED_HEAP=1)
+  message ("     Shared heap enabled")
+endif ()
 if (WAMR_BUILD_THREAD_MGR EQUAL 1)
   message ("     Thread manager enabled")
 endif ()
@@ -305,6 +434,10 @@ else ()
   add_definitions (-DWASM_DISABLE_WAKEUP_BLOCKING_OP=0)
   message ("     Wakeup of blocking operations enabled")
 endif ()
+if (WAMR_DISABLE_FUTEX EQUAL 1)
+  add_definitions (-DWASM_DISABLE_FUTEX=1)
+  message ("     Futex based atomic wait/notify disabled")
+endif ()
 if (WAMR_BUILD_SIMD EQUAL 1)
   if (NOT WAMR_BUILD_TARGET MATCHES "RISCV64.*")
     add_definitions (-DWASM_ENABLE_SIMD=1)
@@ -325,6 +458,10 @@ if (WAMR_BUILD_PERF_PROFILING EQUAL 1)
   add_definitions (-DWASM_ENABLE_PERF_PROFILING=1)
   message ("     Performance profiling enabled")
 endif ()
+if (WAMR_BUILD_SAMPLING_PROFILING EQUAL 1)
+  add_definitions (-DWASM_ENABLE_SAMPLING_PROFILING=1)
+  message ("     Sampling profiling enabled")
+endif ()
 if (DEFINED WAMR_APP_THREAD_STACK_SIZE_MAX)
   add_definitions (-DAPP_THREAD_STACK_SIZE_MAX=${WAMR_APP_THREAD_STACK_SIZE_MAX})
 endif ()
@@ -358,6 +495,24 @@ if (WAMR_BUILD_GC EQUAL 1 AND WAMR_BUILD_GC_PERF_PROFILING EQUAL 1)
 else ()
   message ("     GC performance profiling disabled")
 endif ()
+if (WAMR_BUILD_GC_NURSERY EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_NURSERY=1)
+  message ("     GC nursery enabled")
+endif ()
+if (WAMR_BUILD_GC_PARALLEL_MARK EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_PARALLEL_MARK=1)
+  if (DEFINED WAMR_BUILD_GC_MARK_THREAD_NUM)
+    add_definitions (-DWASM_GC_MARK_THREAD_NUM=${WAMR_BUILD_GC_MARK_THREAD_NUM})
+  endif ()
+  message ("     GC parallel marking enabled")
+endif ()
+if (WAMR_BUILD_GC_INCREMENTAL EQUAL 1)
+  add_definitions (-DWASM_ENABLE_GC_INCREMENTAL=1)
+  if (DEFINED WAMR_BUILD_GC_PAUSE_BUDGET)
+    add_definitions (-DWASM_GC_PAUSE_BUDGET_US=${WAMR_BUILD_GC_PAUSE_BUDGET})
+  endif ()
+  message ("     Incremental GC enabled")
+endif ()
 if (WAMR_BUILD_STRINGREF EQUAL 1)
   message ("     Stringref enabled")
   if (NOT DEFINED WAMR_STRINGREF_IMPL_SOURCE)
@@ -367,10 +522,11 @@ if (WAMR_BUILD_STRINGREF EQUAL 1)
   endif()
 endif ()
 if (WAMR_BUILD_PERF_PROFILING EQUAL 1 OR
+    WAMR_BUILD_SAMPLING_PROFILING EQUAL 1 OR
     WAMR_BUILD_DUMP_CALL_STACK EQUAL 1 OR
     WAMR_BUILD_GC EQUAL 1)
-  # Enable AOT/JIT stack frame when perf-profiling, dump-call-stack
-  # or GC is enabled
+  # Enable AOT/JIT stack frame when perf-profiling, sampling-profiling,
+  # dump-call-stack or GC is enabled
   if (WAMR_BUILD_AOT EQUAL 1 OR WAMR_BUILD_JIT EQUAL 1)
     add_definitions (-DWASM_ENABLE_AOT_STACK_FRAME=1)
   endif ()
@@ -425,6 +581,10 @@ else ()
     add_definitions (-DWASM_GLOBAL_HEAP_SIZE=${WAMR_BUILD_GLOBAL_HEAP_SIZE})
   endif ()
 endif ()
+if (WAMR_BUILD_MEM_ALLOC_THREAD_CACHE EQUAL 1)
+  add_definitions (-DWASM_ENABLE_MEM_ALLOC_THREAD_CACHE=1)
+  message ("     Memory allocator thread cache enabled")
+endif ()
 if (WAMR_BUILD_STACK_GUARD_SIZE GREATER 0)
     add_definitions (-DWASM_STACK_GUARD_SIZE=${WAMR_BUILD_STACK_GUARD_SIZE})
     message ("     Custom stack guard size: " ${WAMR_BUILD_STACK_GUARD_SIZE})
@@ -530,6 +690,38 @@ if (WAMR_BUILD_LINUX_PERF EQUAL 1)
   add_definitions (-DWASM_ENABLE_LINUX_PERF=1)
   message ("     Linux perf support enabled")
 endif ()
+if (WAMR_BUILD_MEMORY_SNAPSHOT EQUAL 1)
+  add_definitions (-DWASM_ENABLE_MEMORY_SNAPSHOT=1)
+  message ("     Memory snapshot enabled")
+endif ()
+if (WAMR_BUILD_INSTANCE_RESET EQUAL 1)
+  add_definitions (-DWASM_ENABLE_INSTANCE_RESET=1)
+  message ("     Instance reset enabled")
+endif ()
+if (WAMR_BUILD_LAZY_FUNC_VALIDATION EQUAL 1)
+  add_definitions (-DWASM_ENABLE_LAZY_FUNC_VALIDATION=1)
+  message ("     Lazy function validation enabled")
+endif ()
+if (WAMR_BUILD_FAST_INTERP_CACHE EQUAL 1)
+  add_definitions (-DWASM_ENABLE_FAST_INTERP_CACHE=1)
+  message ("     Fast interpreter cache enabled")
+endif ()
+if (WAMR_BUILD_FAST_INTERP_TAIL_DISPATCH EQUAL 1)
+  add_definitions (-DWASM_ENABLE_FAST_INTERP_TAIL_DISPATCH=1)
+  message ("     Fast interpreter tail-call dispatch enabled")
+endif ()
+if (WAMR_BUILD_AOT_SHARED_TEXT EQUAL 1)
+  add_definitions (-DWASM_ENABLE_AOT_SHARED_TEXT=1)
+  message ("     AOT shared text enabled")
+endif ()
+if (WAMR_BUILD_AOT_SAFEPOINT EQUAL 1)
+  add_definitions (-DWASM_ENABLE_AOT_SAFEPOINT=1)
+  message ("     AOT safepoint enabled")
+endif ()
+if (WAMR_BUILD_FUEL_METERING EQUAL 1)
+  add_definitions (-DWASM_ENABLE_FUEL_METERING=1)
+  message ("     Fuel metering enabled")
+endif ()
 if (WAMR_BUILD_AOT EQUAL 1 OR WAMR_BUILD_JIT EQUAL 1)
   if (NOT DEFINED WAMR_BUILD_QUICK_AOT_ENTRY)
     # Enable quick aot/jit entries by default
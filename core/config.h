@@ -215,6 +215,14 @@
 #define WASM_ENABLE_SHARED_MEMORY 0
 #endif
 
+/* Shared heap, which is mapped at the top of the 32-bit app address
+   space of the module instances attached */
+#ifndef WASM_ENABLE_SHARED_HEAP
+#define WASM_ENABLE_SHARED_HEAP 0
+#elif WASM_ENABLE_SHARED_HEAP != 0 && WASM_ENABLE_FAST_JIT != 0
+#error "Shared heap isn't supported by Fast JIT"
+#endif
+
 /* Thread manager */
 #ifndef WASM_ENABLE_THREAD_MGR
 #define WASM_ENABLE_THREAD_MGR 0
@@ -286,7 +294,8 @@
 #define WASM_DEBUG_PREPROCESSOR 0
 #endif
 
-/* Enable opcode counter or not */
+/* Enable opcode counter or not, the counts of the opcodes and of the
+   adjacent opcode pairs executed by fast interpreter are dumped */
 #ifndef WASM_ENABLE_OPCODE_COUNTER
 #define WASM_ENABLE_OPCODE_COUNTER 0
 #endif
@@ -313,6 +322,12 @@
 #define WASM_DISABLE_STACK_HW_BOUND_CHECK 0
 #endif
 
+/* Disable waiting on futexes in atomic wait/notify and fall back to
+ * condition variables or not, enable it by default if it is supported */
+#ifndef WASM_DISABLE_FUTEX
+#define WASM_DISABLE_FUTEX 0
+#endif
+
 /* Disable SIMD unless it is manually enabled somewhere */
 #ifndef WASM_ENABLE_SIMD
 #define WASM_ENABLE_SIMD 0
@@ -323,6 +338,37 @@
 #define WASM_ENABLE_GC_PERF_PROFILING 0
 #endif
 
+/* Generational GC heap: bump allocate the small objects in a nursery
+   which is collected separately with the help of the write barriers */
+#ifndef WASM_ENABLE_GC_NURSERY
+#define WASM_ENABLE_GC_NURSERY 0
+#endif
+
+/* Mark and sweep the GC heap in parallel with a pool of GC worker
+   threads */
+#ifndef WASM_ENABLE_GC_PARALLEL_MARK
+#define WASM_ENABLE_GC_PARALLEL_MARK 0
+#endif
+
+/* The number of threads to mark and sweep the GC heap in parallel,
+   including the thread doing the collection */
+#ifndef WASM_GC_MARK_THREAD_NUM
+#define WASM_GC_MARK_THREAD_NUM 4
+#endif
+
+/* Incremental GC: mark the GC heap in slices run at the allocations
+   with the help of the snapshot-at-the-beginning write barriers, and
+   sweep it lazily */
+#ifndef WASM_ENABLE_GC_INCREMENTAL
+#define WASM_ENABLE_GC_INCREMENTAL 0
+#endif
+
+/* The default maximum time in microseconds of a slice of the
+   incremental GC */
+#ifndef WASM_GC_PAUSE_BUDGET_US
+#define WASM_GC_PAUSE_BUDGET_US 1000
+#endif
+
 /* Memory profiling */
 #ifndef WASM_ENABLE_MEMORY_PROFILING
 #define WASM_ENABLE_MEMORY_PROFILING 0
@@ -338,6 +384,23 @@
 #define WASM_ENABLE_PERF_PROFILING 0
 #endif
 
+/* Sampling profiling, see wasm_runtime_set_sampling_profiling */
+#ifndef WASM_ENABLE_SAMPLING_PROFILING
+#define WASM_ENABLE_SAMPLING_PROFILING 0
+#endif
+
+/* The max number of frames recorded in a sample, the outer frames of
+   a deeper call stack are dropped */
+#ifndef WASM_SAMPLING_PROFILER_MAX_DEPTH
+#define WASM_SAMPLING_PROFILER_MAX_DEPTH 32
+#endif
+
+/* The number of samples which the ring buffer of each thread can hold
+   before they are collected, must be a power of 2 */
+#ifndef WASM_SAMPLING_PROFILER_RING_SIZE
+#define WASM_SAMPLING_PROFILER_RING_SIZE 512
+#endif
+
 /* Dump call stack */
 #ifndef WASM_ENABLE_DUMP_CALL_STACK
 #define WASM_ENABLE_DUMP_CALL_STACK 0
@@ -358,6 +421,12 @@
 #define BH_ENABLE_GC_CORRUPTION_CHECK 1
 #endif
 
+/* Slab pages for small objects in the GC heaps of the EMS allocator,
+   disabled by default */
+#ifndef BH_ENABLE_GC_SLAB
+#define BH_ENABLE_GC_SLAB 0
+#endif
+
 /* Enable global heap pool if heap verification is enabled */
 #if BH_ENABLE_GC_VERIFY != 0
 #define WASM_ENABLE_GLOBAL_HEAP_POOL 1
@@ -377,6 +446,22 @@
 #define WASM_GLOBAL_HEAP_SIZE (10 * 1024 * 1024)
 #endif
 
+/* Per-thread caches of small blocks in front of the runtime's own
+   Alloc_With_Pool heap, only supported by the EMS allocator */
+#ifndef WASM_ENABLE_MEM_ALLOC_THREAD_CACHE
+#define WASM_ENABLE_MEM_ALLOC_THREAD_CACHE 0
+#endif
+
+#if BH_ENABLE_GC_VERIFY != 0 || DEFAULT_MEM_ALLOCATOR != MEM_ALLOCATOR_EMS
+#undef WASM_ENABLE_MEM_ALLOC_THREAD_CACHE
+#define WASM_ENABLE_MEM_ALLOC_THREAD_CACHE 0
+#endif
+
+/* Max bytes kept by the thread cache for each size class */
+#ifndef WASM_MEM_ALLOC_THREAD_CACHE_CLASS_BYTES
+#define WASM_MEM_ALLOC_THREAD_CACHE_CLASS_BYTES 4096
+#endif
+
 /* Default length of queue */
 #ifndef DEFAULT_QUEUE_LENGTH
 #define DEFAULT_QUEUE_LENGTH 50
@@ -644,6 +729,64 @@
 #define WASM_ENABLE_LINUX_PERF 0
 #endif
 
+/* Instantiate a module from the copy-on-write snapshot of its
+   initialized memory, globals and tables, only supported on linux */
+#ifndef WASM_ENABLE_MEMORY_SNAPSHOT
+#define WASM_ENABLE_MEMORY_SNAPSHOT 0
+#endif
+
+/* Keep the state of a module instance after instantiation and restore
+   it in place with wasm_runtime_instance_reset, see
+   InstantiationArgs.enable_reset */
+#ifndef WASM_ENABLE_INSTANCE_RESET
+#define WASM_ENABLE_INSTANCE_RESET 0
+#endif
+
+/* Validate and prepare the function bodies of a bytecode module when
+   they are called for the first time instead of at load time, see
+   LoadArgs.lazy_func_validation, only supported by the interpreter */
+#ifndef WASM_ENABLE_LAZY_FUNC_VALIDATION
+#define WASM_ENABLE_LAZY_FUNC_VALIDATION 0
+#endif
+
+/* Cache the bytecode prepared by the fast interpreter loader on disk and
+   map it back when the same module is loaded again, see
+   LoadArgs.fast_interp_cache_dir */
+#ifndef WASM_ENABLE_FAST_INTERP_CACHE
+#define WASM_ENABLE_FAST_INTERP_CACHE 0
+#endif
+
+/* Execute the hot opcodes of the fast interpreter with handler functions
+   chained by guaranteed tail calls, falls back to the labels-as-values
+   dispatch if the compiler doesn't support the musttail attribute */
+#ifndef WASM_ENABLE_FAST_INTERP_TAIL_DISPATCH
+#define WASM_ENABLE_FAST_INTERP_TAIL_DISPATCH 0
+#endif
+
+/* Load an AOT file by mapping it into memory and execute the text generated
+   by wamrc --enable-shared-text in place, so that the text pages are shared
+   between processes, see wasm_runtime_load_aot_file_mapped */
+#ifndef WASM_ENABLE_AOT_SHARED_TEXT
+#define WASM_ENABLE_AOT_SHARED_TEXT 0
+#endif
+
+/* Create a safepoint page for each exec_env, which is polled by the
+   AOTed code compiled with wamrc --enable-safepoint-page, so that the
+   thread manager can interrupt the AOTed code without polling the
+   suspend flags, requires the hw bound check */
+#ifndef WASM_ENABLE_AOT_SAFEPOINT
+#define WASM_ENABLE_AOT_SAFEPOINT 0
+#endif
+
+/* Meter the execution of wasm code with the fuel of the exec_env, which
+   is charged with the instruction count of each region ending with a
+   control instruction, see wasm_runtime_set_fuel */
+#ifndef WASM_ENABLE_FUEL_METERING
+#define WASM_ENABLE_FUEL_METERING 0
+#elif WASM_ENABLE_FUEL_METERING != 0 && WASM_ENABLE_FAST_JIT != 0
+#error "Fuel metering isn't supported by Fast JIT"
+#endif
+
 /* Support registering quick AOT/JIT function entries of some func types
    to speed up the calling process of invoking the AOT/JIT functions of
    these types from the host embedder */
@@ -11,6 +11,9 @@
 #include "../common/wasm_native.h"
 #include "../common/wasm_loader_common.h"
 #include "../compilation/aot.h"
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+#include "../common/wasm_module_snapshot.h"
+#endif
 
 #if WASM_ENABLE_DEBUG_AOT != 0
 #include "debug/elf_parser.h"
@@ -464,6 +467,30 @@ check_feature_flags(char *error_buf, uint32 error_buf_size,
     }
 #endif
 
+#if WASM_ENABLE_FUEL_METERING == 0
+    if (feature_flags & WASM_FEATURE_FUEL_METERING) {
+        set_error_buf(error_buf, error_buf_size,
+                      "fuel metering is not enabled in this build");
+        return false;
+    }
+#endif
+
+#if WASM_ENABLE_AOT_SAFEPOINT == 0 || !defined(OS_ENABLE_HW_BOUND_CHECK)
+    if (feature_flags & WASM_FEATURE_SAFEPOINT_PAGE) {
+        set_error_buf(error_buf, error_buf_size,
+                      "aot safepoint is not enabled in this build");
+        return false;
+    }
+#endif
+
+#if WASM_ENABLE_SHARED_HEAP == 0
+    if (feature_flags & WASM_FEATURE_SHARED_HEAP) {
+        set_error_buf(error_buf, error_buf_size,
+                      "shared heap is not enabled in this build");
+        return false;
+    }
+#endif
+
     return true;
 }
 
@@ -545,6 +572,22 @@ load_target_info_section(const uint8 *buf, const uint8 *buf_end,
         return false;
     }
 
+#if WASM_ENABLE_GC_NURSERY != 0
+    module->has_gc_write_barrier =
+        (target_info.feature_flags & WASM_FEATURE_GC_WRITE_BARRIER) ? true
+                                                                    : false;
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    module->has_gc_pre_write_barrier =
+        (target_info.feature_flags & WASM_FEATURE_GC_PRE_WRITE_BARRIER)
+            ? true
+            : false;
+#endif
+#if WASM_ENABLE_SHARED_HEAP != 0
+    module->has_shared_heap =
+        (target_info.feature_flags & WASM_FEATURE_SHARED_HEAP) ? true : false;
+#endif
+
     /* Finally, check feature flags */
     return check_feature_flags(error_buf, error_buf_size,
                                target_info.feature_flags);
@@ -2180,8 +2223,14 @@ fail:
 }
 
 static void
-destroy_import_funcs(AOTImportFunc *import_funcs)
+destroy_import_funcs(AOTImportFunc *import_funcs, uint32 count)
 {
+    uint32 i;
+
+    for (i = 0; i < count; i++) {
+        if (import_funcs[i].call_desc)
+            wasm_runtime_destroy_native_call_desc(import_funcs[i].call_desc);
+    }
     wasm_runtime_free(import_funcs);
 }
 
@@ -2228,6 +2277,14 @@ load_import_funcs(const uint8 **p_buf, const uint8 *buf_end, AOTModule *module,
             module_name, field_name, declare_func_type,
             &import_funcs[i].signature, &import_funcs[i].attachment,
             &import_funcs[i].call_conv_raw);
+        if (linked_func && !import_funcs[i].call_conv_raw
+            && !wasm_runtime_create_native_call_desc(
+                declare_func_type, import_funcs[i].signature,
+                &import_funcs[i].call_desc)) {
+            set_error_buf(error_buf, error_buf_size,
+                          "allocate memory failed");
+            return false;
+        }
         if (!linked_func) {
             if (!wasm_runtime_is_built_in_module(module_name)) {
                 sub_module = (AOTModule *)wasm_runtime_load_depended_module(
@@ -2255,6 +2312,14 @@ load_import_funcs(const uint8 **p_buf, const uint8 *buf_end, AOTModule *module,
             module_name, field_name, import_funcs[i].func_type,
             &import_funcs[i].signature, &import_funcs[i].attachment,
             &import_funcs[i].call_conv_raw);
+        if (import_funcs[i].func_ptr_linked && !import_funcs[i].call_conv_raw
+            && !wasm_runtime_create_native_call_desc(
+                import_funcs[i].func_type, import_funcs[i].signature,
+                &import_funcs[i].call_desc)) {
+            set_error_buf(error_buf, error_buf_size,
+                          "allocate memory failed");
+            return false;
+        }
 #endif
 
 #if WASM_ENABLE_LIBC_WASI != 0
@@ -4165,9 +4230,79 @@ aot_load_from_aot_file(const uint8 *buf, uint32 size, const LoadArgs *args,
     return module;
 }
 
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0 && defined(OS_ENABLE_FILE_MAP)
+AOTModule *
+aot_load_from_aot_file_mapped(const char *file_path, const LoadArgs *args,
+                              char *error_buf, uint32 error_buf_size)
+{
+    AOTModule *module;
+    uint8 *map_addr, *text_begin, *text_end;
+    uint64 map_size = 0, page_size = (uint64)os_getpagesize();
+
+    /* Map the file privately: the loader may still patch the text of an
+       AOT file which isn't pre-relocated, or the other sections in place,
+       which only copies the pages written, while the pages of pre-relocated
+       text are never written and stay shared in the page cache */
+    if (!(map_addr = os_mmap_file(file_path, &map_size))) {
+        set_error_buf_v(error_buf, error_buf_size, "map file %s failed",
+                        file_path);
+        return NULL;
+    }
+
+    if (map_size > UINT32_MAX) {
+        set_error_buf_v(error_buf, error_buf_size, "invalid size of file %s",
+                        file_path);
+        os_munmap_file(map_addr, map_size);
+        return NULL;
+    }
+
+    if (!(module = create_module(args->name, error_buf, error_buf_size))) {
+        os_munmap_file(map_addr, map_size);
+        return NULL;
+    }
+    module->file_map_addr = map_addr;
+    module->file_map_size = map_size;
+
+    os_thread_jit_write_protect_np(false); /* Make memory writable */
+    if (!load(map_addr, (uint32)map_size, module, false, error_buf,
+              error_buf_size)) {
+        aot_unload(module);
+        return NULL;
+    }
+
+    if (module->is_indirect_mode && module->code_size > 0) {
+        /* The text is executed in place in the mapping, for the AOT file
+           generated with `--enable-shared-text`, the code starts at a page
+           boundary and is padded to the next one */
+        text_begin = (uint8 *)((uintptr_t)module->code & ~(page_size - 1));
+        text_end = (uint8 *)module->code + module->code_size;
+        if (os_mprotect(text_begin, (size_t)(text_end - text_begin),
+                        MMAP_PROT_READ | MMAP_PROT_EXEC)
+            != 0) {
+            set_error_buf(error_buf, error_buf_size,
+                          "make aot text executable failed");
+            aot_unload(module);
+            return NULL;
+        }
+        LOG_VERBOSE("Execute the text of AOT file %s in place.", file_path);
+    }
+    os_thread_jit_write_protect_np(true); /* Make memory executable */
+    os_icache_flush(module->code, module->code_size);
+
+    LOG_VERBOSE("Load module success.\n");
+    return module;
+}
+#endif /* end of WASM_ENABLE_AOT_SHARED_TEXT != 0 \
+          && defined(OS_ENABLE_FILE_MAP) */
+
 void
 aot_unload(AOTModule *module)
 {
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    if (module->snapshot)
+        wasm_module_snapshot_delete(module->snapshot);
+#endif
+
     if (module->import_memories)
         destroy_import_memories(module->import_memories);
 
@@ -4215,7 +4350,7 @@ aot_unload(AOTModule *module)
     }
 
     if (module->import_funcs)
-        destroy_import_funcs(module->import_funcs);
+        destroy_import_funcs(module->import_funcs, module->import_func_count);
 
     if (module->exports)
         destroy_exports(module->exports);
@@ -4348,6 +4483,11 @@ aot_unload(AOTModule *module)
 #endif
 #endif
 
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0 && defined(OS_ENABLE_FILE_MAP)
+    if (module->file_map_addr)
+        os_munmap_file(module->file_map_addr, module->file_map_size);
+#endif
+
     wasm_runtime_free(module);
 }
 
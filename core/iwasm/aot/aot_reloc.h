@@ -147,9 +147,12 @@ typedef struct {
     REG_SYM(aot_rtt_type_new),             \
     REG_SYM(wasm_array_obj_copy),          \
     REG_SYM(wasm_array_obj_new),           \
+    REG_SYM(wasm_array_obj_pre_write_barrier), \
     REG_SYM(wasm_externref_obj_to_internal_obj), \
     REG_SYM(wasm_internal_obj_to_externref_obj), \
     REG_SYM(wasm_obj_is_type_of),          \
+    REG_SYM(wasm_obj_pre_write_barrier),   \
+    REG_SYM(wasm_obj_write_barrier),       \
     REG_SYM(wasm_struct_obj_new),
 #else
 #define REG_GC_SYM()
@@ -12,13 +12,17 @@
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "../common/wasm_shared_memory.h"
 #endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+#include "../common/wasm_module_snapshot.h"
+#endif
 #if WASM_ENABLE_THREAD_MGR != 0
 #include "../libraries/thread-mgr/thread_manager.h"
 #endif
 
 /*
  * Note: These offsets need to match the values hardcoded in
- * AoT compilation code: aot_create_func_context, check_suspend_flags.
+ * AoT compilation code: aot_create_func_context, check_suspend_flags,
+ * create_safepoint_page and create_fuel_info.
  */
 
 bh_static_assert(offsetof(WASMExecEnv, cur_frame) == 1 * sizeof(uintptr_t));
@@ -40,6 +44,12 @@ bh_static_assert(offsetof(WASMExecEnv, wasm_stack.top)
                  == 11 * sizeof(uintptr_t));
 bh_static_assert(offsetof(WASMExecEnv, wasm_stack.bottom)
                  == 12 * sizeof(uintptr_t));
+bh_static_assert(offsetof(WASMExecEnv, safepoint_page)
+                 == 13 * sizeof(uintptr_t));
+#if WASM_ENABLE_FUEL_METERING != 0
+bh_static_assert(offsetof(WASMExecEnv, fuel)
+                 == ((14 * sizeof(uintptr_t) + 7) & ~(uintptr_t)7));
+#endif
 
 bh_static_assert(offsetof(AOTModuleInstance, memories) == 1 * sizeof(uint64));
 bh_static_assert(offsetof(AOTModuleInstance, func_ptrs) == 5 * sizeof(uint64));
@@ -596,8 +606,8 @@ global_instantiate(AOTModuleInstance *module_inst, AOTModule *module,
 
 static bool
 tables_instantiate(AOTModuleInstance *module_inst, AOTModule *module,
-                   AOTTableInstance *first_tbl_inst, char *error_buf,
-                   uint32 error_buf_size)
+                   AOTTableInstance *first_tbl_inst, bool init_elems,
+                   char *error_buf, uint32 error_buf_size)
 {
     uint32 i, global_index, global_data_offset, base_offset, length;
     uint64 total_size;
@@ -656,7 +666,7 @@ tables_instantiate(AOTModuleInstance *module_inst, AOTModule *module,
     }
 
     /* fill table with element segment content */
-    for (i = 0; i < module->table_init_data_count; i++) {
+    for (i = 0; init_elems && i < module->table_init_data_count; i++) {
 #if WASM_ENABLE_GC == 0
         uint32 j;
 #endif
@@ -1007,7 +1017,7 @@ aot_get_default_memory(AOTModuleInstance *module_inst)
 static bool
 memories_instantiate(AOTModuleInstance *module_inst, AOTModuleInstance *parent,
                      AOTModule *module, uint32 heap_size,
-                     uint32 max_memory_pages, char *error_buf,
+                     uint32 max_memory_pages, bool init_data, char *error_buf,
                      uint32 error_buf_size)
 {
     uint32 global_index, global_data_offset, length;
@@ -1049,9 +1059,9 @@ memories_instantiate(AOTModuleInstance *module_inst, AOTModuleInstance *parent,
         if (data_seg->is_passive)
             continue;
 #endif
-        if (parent != NULL)
+        if (parent != NULL || !init_data)
             /* Ignore setting memory init data if the memory has been
-               initialized */
+               initialized, or will be restored from a snapshot */
             continue;
 
         bh_assert(data_seg->offset.init_expr_type
@@ -1484,7 +1494,9 @@ check_linked_symbol(AOTModule *module, char *error_buf, uint32 error_buf_size)
 AOTModuleInstance *
 aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
                 WASMExecEnv *exec_env_main, uint32 stack_size, uint32 heap_size,
-                uint32 max_memory_pages, char *error_buf, uint32 error_buf_size)
+                uint32 max_memory_pages,
+                const struct WASMModuleSnapshot *snapshot, char *error_buf,
+                uint32 error_buf_size)
 {
     AOTModuleInstance *module_inst;
 #if WASM_ENABLE_BULK_MEMORY != 0 || WASM_ENABLE_REF_TYPES != 0
@@ -1543,6 +1555,10 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
     module_inst->module = (void *)module;
     module_inst->e =
         (WASMModuleInstanceExtra *)((uint8 *)module_inst + extra_info_offset);
+#if WASM_ENABLE_SHARED_HEAP != 0
+    ((AOTModuleInstanceExtra *)module_inst->e)->common.shared_heap_start_off =
+        UINT64_MAX;
+#endif
 
 #if WASM_ENABLE_GC != 0
     /* Initialize gc heap first since it may be used when initializing
@@ -1562,10 +1578,24 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
         if (!extra->common.gc_heap_pool)
             goto fail;
 
-        extra->common.gc_heap_handle =
-            mem_allocator_create(extra->common.gc_heap_pool, gc_heap_size);
+        extra->common.gc_heap_handle = mem_allocator_create_gc_heap(
+            extra->common.gc_heap_pool, gc_heap_size);
         if (!extra->common.gc_heap_handle)
             goto fail;
+
+#if WASM_ENABLE_GC_NURSERY != 0
+        /* The young objects can only be collected separately if the AOT
+           code remembers the old objects referring to them */
+        if (module->has_gc_write_barrier)
+            (void)mem_allocator_enable_nursery(extra->common.gc_heap_handle);
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* Marking can only be interleaved with the AOT code if it records
+           the references it overwrites */
+        if (module->has_gc_pre_write_barrier)
+            (void)mem_allocator_enable_incremental(
+                extra->common.gc_heap_handle);
+#endif
     }
 #endif
 
@@ -1632,13 +1662,24 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
     p += module->global_data_size;
     module_inst->table_count = module->table_count + module->import_table_count;
     if (!tables_instantiate(module_inst, module, (AOTTableInstance *)p,
-                            error_buf, error_buf_size))
+                            !snapshot, error_buf, error_buf_size))
         goto fail;
 
     /* Initialize memory space */
     if (!memories_instantiate(module_inst, parent, module, heap_size,
-                              max_memory_pages, error_buf, error_buf_size))
+                              max_memory_pages, !snapshot, error_buf,
+                              error_buf_size))
+        goto fail;
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    if (snapshot
+        && !wasm_module_snapshot_apply(snapshot,
+                                       (WASMModuleInstanceCommon *)module_inst,
+                                       error_buf, error_buf_size))
         goto fail;
+#else
+    bh_assert(!snapshot);
+#endif
 
     /* Initialize function pointers */
     if (!init_func_ptrs(module_inst, module, error_buf, error_buf_size))
@@ -1841,8 +1882,10 @@ aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
     }
 #endif
 
-    if (!execute_post_instantiate_functions(module_inst, is_sub_inst,
-                                            exec_env_main)) {
+    /* The start and init functions have already run in the snapshot */
+    if (!snapshot
+        && !execute_post_instantiate_functions(module_inst, is_sub_inst,
+                                               exec_env_main)) {
         set_error_buf(error_buf, error_buf_size, module_inst->cur_exception);
         goto fail;
     }
@@ -1914,6 +1957,10 @@ aot_deinstantiate(AOTModuleInstance *module_inst, bool is_sub_inst)
         (WASMModuleInstanceCommon *)module_inst);
 #endif
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    wasm_runtime_detach_shared_heap((WASMModuleInstanceCommon *)module_inst);
+#endif
+
     if (module_inst->tables)
         wasm_runtime_free(module_inst->tables);
 
@@ -2802,9 +2849,14 @@ aot_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
             goto fail;
         }
 #endif
-        ret =
-            wasm_runtime_invoke_native(exec_env, func_ptr, func_type, signature,
-                                       attachment, argv, argc, argv);
+        if (import_func->call_desc)
+            ret = wasm_runtime_invoke_native_desc(exec_env, func_ptr,
+                                                  import_func->call_desc,
+                                                  attachment, argv, argv);
+        else
+            ret = wasm_runtime_invoke_native(exec_env, func_ptr, func_type,
+                                             signature, attachment, argv, argc,
+                                             argv);
     }
     else {
         signature = import_func->signature;
@@ -3074,6 +3126,15 @@ aot_memory_init(AOTModuleInstance *module_inst, uint32 seg_index, uint32 offset,
     maddr = wasm_runtime_addr_app_to_native(
         (WASMModuleInstanceCommon *)module_inst, (uint64)dst);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (wasm_runtime_is_app_addr_in_shared_heap(
+            (WASMModuleInstanceCommon *)module_inst, (uint64)dst,
+            (uint64)len)) {
+        bh_memcpy_s(maddr, len, data + offset, len);
+        return true;
+    }
+#endif
+
     SHARED_MEMORY_LOCK(memory_inst);
     bh_memcpy_s(maddr, CLAMP_U64_TO_U32(memory_inst->memory_data_size - dst),
                 data + offset, len);
@@ -3467,7 +3528,8 @@ aot_table_grow(AOTModuleInstance *module_inst, uint32 tbl_idx, uint32 inc_size,
 #endif /* WASM_ENABLE_REF_TYPES != 0 || WASM_ENABLE_GC != 0 */
 
 #if WASM_ENABLE_AOT_STACK_FRAME != 0
-#if WASM_ENABLE_DUMP_CALL_STACK != 0 || WASM_ENABLE_PERF_PROFILING != 0
+#if WASM_ENABLE_DUMP_CALL_STACK != 0 || WASM_ENABLE_PERF_PROFILING != 0 \
+    || WASM_ENABLE_SAMPLING_PROFILING != 0
 #if WASM_ENABLE_CUSTOM_NAME_SECTION != 0
 static const char *
 lookup_func_name(const char **func_names, uint32 *func_indexes,
@@ -3526,8 +3588,21 @@ get_func_name_from_index(const AOTModuleInstance *module_inst,
 
     return func_name;
 }
+
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+const char *
+aot_get_func_name(const AOTModuleInstance *module_inst, uint32 func_index)
+{
+    AOTModule *module = (AOTModule *)module_inst->module;
+
+    if (func_index >= module->import_func_count + module->func_count)
+        return NULL;
+    return get_func_name_from_index(module_inst, func_index);
+}
+#endif
 #endif /* end of WASM_ENABLE_DUMP_CALL_STACK != 0 || \
-          WASM_ENABLE_PERF_PROFILING != 0 */
+          WASM_ENABLE_PERF_PROFILING != 0 || \
+          WASM_ENABLE_SAMPLING_PROFILING != 0 */
 
 #if WASM_ENABLE_GC == 0
 bool
@@ -35,6 +35,11 @@ extern "C" {
 #define WASM_FEATURE_COMPONENT_MODEL (1 << 9)
 #define WASM_FEATURE_RELAXED_SIMD (1 << 10)
 #define WASM_FEATURE_FLEXIBLE_VECTORS (1 << 11)
+#define WASM_FEATURE_FUEL_METERING (1 << 12)
+#define WASM_FEATURE_SAFEPOINT_PAGE (1 << 13)
+#define WASM_FEATURE_GC_WRITE_BARRIER (1 << 14)
+#define WASM_FEATURE_GC_PRE_WRITE_BARRIER (1 << 15)
+#define WASM_FEATURE_SHARED_HEAP (1 << 16)
 
 typedef enum AOTSectionType {
     AOT_SECTION_TYPE_TARGET_INFO = 0,
@@ -265,6 +270,31 @@ typedef struct AOTModule {
     /* is indirect mode or not */
     bool is_indirect_mode;
 
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* whether the AOT code calls the write barrier for the ref stores,
+       the GC heap of the instance has nursery only if it does */
+    bool has_gc_write_barrier;
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    /* whether the AOT code calls the pre-write barrier for the ref stores,
+       the GC heap of the instance is collected incrementally only if it
+       does */
+    bool has_gc_pre_write_barrier;
+#endif
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* whether the AOT code checks the app addresses against the shared
+       heap, a shared heap can be attached to the instance only if it
+       does */
+    bool has_shared_heap;
+#endif
+
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0 && defined(OS_ENABLE_FILE_MAP)
+    /* The AOT file mapped by aot_load_from_aot_file_mapped, which is
+       referred to by the module until it is unloaded */
+    uint8 *file_map_addr;
+    uint64 file_map_size;
+#endif
+
 #if WASM_ENABLE_LIBC_WASI != 0
     WASIArguments wasi_args;
     bool import_wasi_api;
@@ -313,6 +343,11 @@ typedef struct AOTModule {
 
     /* Whether the underlying wasm binary buffer can be freed */
     bool is_binary_freeable;
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    /* The snapshot to instantiate the module from */
+    struct WASMModuleSnapshot *snapshot;
+#endif
 } AOTModule;
 
 #define AOTMemoryInstance WASMMemoryInstance
@@ -450,6 +485,21 @@ AOTModule *
 aot_load_from_aot_file(const uint8 *buf, uint32 size, const LoadArgs *args,
                        char *error_buf, uint32 error_buf_size);
 
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0 && defined(OS_ENABLE_FILE_MAP)
+/**
+ * Load a AOT module from aot file which is mapped into memory, the text
+ * of indirect mode is executed in place in the mapping
+ * @param file_path the path of the AOT file
+ * @param error_buf output of the error info
+ * @param error_buf_size the size of the error string
+ *
+ * @return return AOT module loaded, NULL if failed
+ */
+AOTModule *
+aot_load_from_aot_file_mapped(const char *file_path, const LoadArgs *args,
+                              char *error_buf, uint32 error_buf_size);
+#endif
+
 /**
  * Load a AOT module from a specified AOT section list.
  *
@@ -480,6 +530,8 @@ aot_unload(AOTModule *module);
  *        be created besides the app memory space. Both wasm app and native
  *        function can allocate memory from the heap. If heap_size is 0, the
  *        default heap size will be used.
+ * @param snapshot the snapshot to initialize the instance from, NULL to
+ *        initialize it from the module
  * @param error_buf buffer to output the error info if failed
  * @param error_buf_size the size of the error buffer
  *
@@ -488,7 +540,8 @@ aot_unload(AOTModule *module);
 AOTModuleInstance *
 aot_instantiate(AOTModule *module, AOTModuleInstance *parent,
                 WASMExecEnv *exec_env_main, uint32 stack_size, uint32 heap_size,
-                uint32 max_memory_pages, char *error_buf,
+                uint32 max_memory_pages,
+                const struct WASMModuleSnapshot *snapshot, char *error_buf,
                 uint32 error_buf_size);
 
 /**
@@ -706,6 +759,13 @@ aot_dump_call_stack(WASMExecEnv *exec_env, bool print, char *buf, uint32 len);
 void
 aot_dump_perf_profiling(const AOTModuleInstance *module_inst);
 
+#if WASM_ENABLE_SAMPLING_PROFILING != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0
+/* Get the name of a function from the name section, or its import or
+   export name, return NULL if not found */
+const char *
+aot_get_func_name(const AOTModuleInstance *module_inst, uint32 func_index);
+#endif
+
 double
 aot_summarize_wasm_execute_time(const AOTModuleInstance *inst);
 
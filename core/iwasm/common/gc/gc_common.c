@@ -5,6 +5,7 @@
 
 #include "../wasm_runtime_common.h"
 #include "gc_export.h"
+#include "mem_alloc.h"
 #if WASM_ENABLE_INTERP != 0
 #include "../interpreter/wasm_runtime.h"
 #endif
@@ -976,6 +977,60 @@ wasm_runtime_get_gc_heap_handle(WASMModuleInstanceCommon *module_inst)
     return NULL;
 }
 
+bool
+wasm_runtime_set_gc_pause_budget(WASMModuleInstanceCommon *module_inst,
+                                 uint32 budget_us)
+{
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    void *gc_heap_handle = wasm_runtime_get_gc_heap_handle(module_inst);
+
+    if (!gc_heap_handle)
+        return false;
+
+    mem_allocator_set_gc_pause_budget(gc_heap_handle, budget_us);
+    return true;
+#else
+    (void)module_inst;
+    (void)budget_us;
+    return false;
+#endif
+}
+
+bool
+wasm_runtime_get_gc_pause_stats(WASMModuleInstanceCommon *module_inst,
+                                wasm_gc_pause_stats_t *stats)
+{
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    void *gc_heap_handle = wasm_runtime_get_gc_heap_handle(module_inst);
+
+    if (!gc_heap_handle || !stats)
+        return false;
+
+    mem_allocator_get_gc_pause_stats(gc_heap_handle, stats);
+    return true;
+#else
+    (void)module_inst;
+    (void)stats;
+    return false;
+#endif
+}
+
+bool
+wasm_runtime_gc_step(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    void *gc_heap_handle = wasm_runtime_get_gc_heap_handle(module_inst);
+
+    if (!gc_heap_handle)
+        return false;
+
+    return mem_allocator_gc_step(gc_heap_handle);
+#else
+    (void)module_inst;
+    return false;
+#endif
+}
+
 bool
 wasm_runtime_get_wasm_object_extra_info_flag(WASMObjectRef obj)
 {
@@ -123,6 +123,12 @@ wasm_struct_obj_set_field(WASMStructObjectRef struct_obj, uint32 field_idx,
     field_data = (uint8 *)struct_obj + field->field_offset;
     field_size = field->field_size;
 
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (wasm_is_type_reftype(field->field_type))
+        wasm_obj_pre_write_barrier(
+            (WASMObjectRef)GET_REF_FROM_ADDR((uint32 *)field_data));
+#endif
+
     if (field_size == 4) {
         *(int32 *)field_data = value->i32;
     }
@@ -143,6 +149,11 @@ wasm_struct_obj_set_field(WASMStructObjectRef struct_obj, uint32 field_idx,
     else {
         bh_assert(0);
     }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (wasm_is_type_reftype(field->field_type))
+        wasm_obj_write_barrier((WASMObjectRef)struct_obj, value->gc_obj);
+#endif
 }
 
 void
@@ -272,6 +283,18 @@ wasm_array_obj_new(WASMExecEnv *exec_env, WASMRttTypeRef rtt_type,
                                        init_value);
 }
 
+#if WASM_ENABLE_GC_NURSERY != 0 || WASM_ENABLE_GC_INCREMENTAL != 0
+static bool
+array_obj_is_ref_elem(const WASMArrayObjectRef array_obj)
+{
+    WASMRttTypeRef rtt_type =
+        (WASMRttTypeRef)wasm_object_header((WASMObjectRef)array_obj);
+    WASMArrayType *array_type = (WASMArrayType *)rtt_type->defined_type;
+
+    return wasm_is_type_reftype(array_type->elem_type);
+}
+#endif
+
 void
 wasm_array_obj_set_elem(WASMArrayObjectRef array_obj, uint32 elem_idx,
                         const WASMValue *value)
@@ -279,6 +302,10 @@ wasm_array_obj_set_elem(WASMArrayObjectRef array_obj, uint32 elem_idx,
     uint8 *elem_data = wasm_array_obj_elem_addr(array_obj, elem_idx);
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(array_obj);
 
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    wasm_array_obj_pre_write_barrier(array_obj, elem_idx, 1);
+#endif
+
     switch (elem_size) {
         case 1:
             *(int8 *)elem_data = (int8)value->i32;
@@ -293,6 +320,11 @@ wasm_array_obj_set_elem(WASMArrayObjectRef array_obj, uint32 elem_idx,
             PUT_I64_TO_ADDR((uint32 *)elem_data, value->i64);
             break;
     }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (array_obj_is_ref_elem(array_obj))
+        wasm_obj_write_barrier((WASMObjectRef)array_obj, value->gc_obj);
+#endif
 }
 
 void
@@ -328,6 +360,10 @@ wasm_array_obj_fill(const WASMArrayObjectRef array_obj, uint32 elem_idx,
     uint8 *elem_data = wasm_array_obj_elem_addr(array_obj, elem_idx);
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(array_obj);
 
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    wasm_array_obj_pre_write_barrier(array_obj, elem_idx, len);
+#endif
+
     if (elem_size == 1) {
         memset(elem_data, (int8)value->i32, len);
         return;
@@ -347,6 +383,11 @@ wasm_array_obj_fill(const WASMArrayObjectRef array_obj, uint32 elem_idx,
         }
         elem_data += elem_size;
     }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (len > 0 && array_obj_is_ref_elem(array_obj))
+        wasm_obj_write_barrier((WASMObjectRef)array_obj, value->gc_obj);
+#endif
 }
 
 void
@@ -357,7 +398,71 @@ wasm_array_obj_copy(WASMArrayObjectRef dst_obj, uint32 dst_idx,
     uint8 *src_data = wasm_array_obj_elem_addr(src_obj, src_idx);
     uint32 elem_size = 1 << wasm_array_obj_elem_size_log(dst_obj);
 
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    wasm_array_obj_pre_write_barrier(dst_obj, dst_idx, len);
+#endif
+
     bh_memmove_s(dst_data, elem_size * len, src_data, elem_size * len);
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (array_obj_is_ref_elem(dst_obj)) {
+        uint32 i;
+
+        for (i = 0; i < len; i++, dst_data += elem_size)
+            wasm_obj_write_barrier((WASMObjectRef)dst_obj,
+                                   GET_REF_FROM_ADDR((uint32 *)dst_data));
+    }
+#endif
+}
+
+void
+wasm_obj_write_barrier(WASMObjectRef obj, WASMObjectRef value)
+{
+#if WASM_ENABLE_GC_NURSERY != 0
+    mem_allocator_write_barrier(obj, value);
+#else
+    (void)obj;
+    (void)value;
+#endif
+}
+
+void
+wasm_obj_pre_write_barrier(WASMObjectRef old_value)
+{
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (old_value)
+        mem_allocator_pre_write_barrier((void **)&old_value, 1);
+#else
+    (void)old_value;
+#endif
+}
+
+void
+wasm_array_obj_pre_write_barrier(WASMArrayObjectRef array_obj,
+                                 uint32 elem_idx, uint32 len)
+{
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    void *refs[32];
+    uint8 *elem_data;
+    uint32 i, n;
+
+    if (len == 0 || !array_obj_is_ref_elem(array_obj))
+        return;
+
+    /* The elements may be unaligned, copy them out in batches */
+    elem_data = wasm_array_obj_elem_addr(array_obj, elem_idx);
+    while (len > 0) {
+        n = len < 32 ? len : 32;
+        for (i = 0; i < n; i++, elem_data += sizeof(void *))
+            refs[i] = GET_REF_FROM_ADDR((uint32 *)elem_data);
+        mem_allocator_pre_write_barrier(refs, n);
+        len -= n;
+    }
+#else
+    (void)array_obj;
+    (void)elem_idx;
+    (void)len;
+#endif
 }
 
 uint32
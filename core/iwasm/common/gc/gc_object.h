@@ -191,6 +191,39 @@ void
 wasm_array_obj_copy(WASMArrayObjectRef dst_obj, uint32 dst_idx,
                     WASMArrayObjectRef src_obj, uint32 src_idx, uint32 len);
 
+/**
+ * Record the store of a reference into an object for the generational
+ * GC heap, it does nothing if the GC nursery isn't enabled.
+ *
+ * @param obj the object whose field or element is set
+ * @param value the reference stored into the object
+ */
+void
+wasm_obj_write_barrier(WASMObjectRef obj, WASMObjectRef value);
+
+/**
+ * Record the reference about to be overwritten for the incremental GC,
+ * so that the objects reachable when a collection cycle begins are kept.
+ * It does nothing if the incremental GC isn't enabled.
+ *
+ * @param old_value the reference currently stored in the field or element
+ */
+void
+wasm_obj_pre_write_barrier(WASMObjectRef old_value);
+
+/**
+ * Record the references in a range of array elements about to be
+ * overwritten for the incremental GC, it does nothing if the elements
+ * aren't references or the incremental GC isn't enabled.
+ *
+ * @param array_obj the WASM array object
+ * @param elem_idx the index of the first element to overwrite
+ * @param len the number of elements to overwrite
+ */
+void
+wasm_array_obj_pre_write_barrier(WASMArrayObjectRef array_obj,
+                                 uint32 elem_idx, uint32 len);
+
 /**
  * Return the logarithm of the size of array element.
  *
@@ -26,6 +26,31 @@
 #endif
 #endif
 
+static void
+exec_env_init_module_inst(WASMExecEnv *exec_env,
+                          struct WASMModuleInstanceCommon *module_inst,
+                          uint32 stack_size)
+{
+    exec_env->module_inst = module_inst;
+    exec_env->wasm_stack_size = stack_size;
+    exec_env->wasm_stack.bottom = exec_env->wasm_stack_u.bottom;
+    exec_env->wasm_stack.top_boundary =
+        exec_env->wasm_stack.bottom + stack_size;
+    exec_env->wasm_stack.top = exec_env->wasm_stack.bottom;
+#if WASM_ENABLE_FUEL_METERING != 0
+    /* Unlimited until the fuel is set by wasm_runtime_set_fuel */
+    exec_env->fuel = INT64_MAX;
+#endif
+
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT) {
+        AOTModuleInstance *i = (AOTModuleInstance *)module_inst;
+        AOTModule *m = (AOTModule *)i->module;
+        exec_env->native_symbol = m->native_symbol_list;
+    }
+#endif
+}
+
 WASMExecEnv *
 wasm_exec_env_create_internal(struct WASMModuleInstanceCommon *module_inst,
                               uint32 stack_size)
@@ -64,23 +89,16 @@ wasm_exec_env_create_internal(struct WASMModuleInstanceCommon *module_inst,
               os_mmap(NULL, os_getpagesize(), MMAP_PROT_NONE, MMAP_MAP_NONE,
                       os_get_invalid_handle())))
         goto fail5;
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+    if (!(exec_env->safepoint_page =
+              os_mmap(NULL, os_getpagesize(), MMAP_PROT_READ, MMAP_MAP_NONE,
+                      os_get_invalid_handle())))
+        goto fail6;
 #endif
-
-    exec_env->module_inst = module_inst;
-    exec_env->wasm_stack_size = stack_size;
-    exec_env->wasm_stack.bottom = exec_env->wasm_stack_u.bottom;
-    exec_env->wasm_stack.top_boundary =
-        exec_env->wasm_stack.bottom + stack_size;
-    exec_env->wasm_stack.top = exec_env->wasm_stack.bottom;
-
-#if WASM_ENABLE_AOT != 0
-    if (module_inst->module_type == Wasm_Module_AoT) {
-        AOTModuleInstance *i = (AOTModuleInstance *)module_inst;
-        AOTModule *m = (AOTModule *)i->module;
-        exec_env->native_symbol = m->native_symbol_list;
-    }
 #endif
 
+    exec_env_init_module_inst(exec_env, module_inst, stack_size);
+
 #if WASM_ENABLE_MEMORY_TRACING != 0
     wasm_runtime_dump_exec_env_mem_consumption(exec_env);
 #endif
@@ -88,6 +106,10 @@ wasm_exec_env_create_internal(struct WASMModuleInstanceCommon *module_inst,
     return exec_env;
 
 #ifdef OS_ENABLE_HW_BOUND_CHECK
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+fail6:
+    os_munmap(exec_env->exce_check_guard_page, os_getpagesize());
+#endif
 fail5:
 #if WASM_ENABLE_THREAD_MGR != 0 && WASM_ENABLE_DEBUG_INTERP != 0
     wasm_cluster_destroy_exenv_status(exec_env->current_status);
@@ -115,6 +137,9 @@ wasm_exec_env_destroy_internal(WASMExecEnv *exec_env)
 {
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     os_munmap(exec_env->exce_check_guard_page, os_getpagesize());
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+    os_munmap(exec_env->safepoint_page, os_getpagesize());
+#endif
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
     os_mutex_destroy(&exec_env->wait_lock);
@@ -227,10 +252,10 @@ wasm_exec_env_set_module_inst(WASMExecEnv *exec_env,
 {
 #if WASM_ENABLE_THREAD_MGR != 0
     wasm_cluster_traverse_lock(exec_env);
-#endif
-    exec_env->module_inst = module_inst;
-#if WASM_ENABLE_THREAD_MGR != 0
+    wasm_cluster_set_exec_env_module_inst(exec_env, module_inst);
     wasm_cluster_traverse_unlock(exec_env);
+#else
+    exec_env->module_inst = module_inst;
 #endif
 }
 
@@ -246,8 +271,10 @@ wasm_exec_env_restore_module_inst(
 
 #if WASM_ENABLE_THREAD_MGR != 0
     wasm_cluster_traverse_lock(exec_env);
-#endif
+    wasm_cluster_set_exec_env_module_inst(exec_env, module_inst_common);
+#else
     exec_env->module_inst = module_inst_common;
+#endif
     /*
      * propagate an exception if any.
      */
@@ -325,3 +352,22 @@ wasm_exec_env_pop_jmpbuf(WASMExecEnv *exec_env)
     return NULL;
 }
 #endif
+
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+void
+wasm_exec_env_arm_safepoint(WASMExecEnv *exec_env)
+{
+    /* The page is only created when the hw bound check is enabled */
+    if (exec_env->safepoint_page)
+        os_mprotect(exec_env->safepoint_page, os_getpagesize(),
+                    MMAP_PROT_NONE);
+}
+
+void
+wasm_exec_env_disarm_safepoint(WASMExecEnv *exec_env)
+{
+    if (exec_env->safepoint_page)
+        os_mprotect(exec_env->safepoint_page, os_getpagesize(),
+                    MMAP_PROT_READ);
+}
+#endif
@@ -87,6 +87,23 @@ typedef struct WASMExecEnv {
         uint8 *bottom;
     } wasm_stack;
 
+#if WASM_ENABLE_AOT != 0
+    /* The safepoint page polled by the AOTed code compiled with
+       wamrc --enable-safepoint-page at the loop back-edges, it is
+       readable normally and is made inaccessible to interrupt the
+       thread, see wasm_exec_env_arm_safepoint. NULL if the runtime
+       doesn't support it. Don't change the place of it */
+    uint8 *safepoint_page;
+#endif
+
+#if WASM_ENABLE_FUEL_METERING != 0
+    /* The remaining fuel of current thread, which is charged with the
+       instruction count of each region ending with a control instruction
+       of the wasm code, the execution traps when it becomes negative.
+       It is also used by AOTed code, don't change the place of it */
+    int64 fuel;
+#endif
+
 #if WASM_ENABLE_FAST_JIT != 0
     /**
      * Cache for
@@ -120,6 +137,17 @@ typedef struct WASMExecEnv {
 
     /* whether the aux stack is allocated */
     bool is_aux_stack_allocated;
+
+    /* the thread pool worker running current thread, NULL if current
+       thread isn't run by the thread pool */
+    struct ThreadPoolWorker *thread_pool_worker;
+
+    /* the exec_env list of the module instance which current exec_env
+       is added to, NULL if it isn't added to any, and the previous and
+       next exec_env in the list, see wasm_clusters_search_exec_env */
+    struct WASMExecEnv **inst_exec_env_list;
+    struct WASMExecEnv *inst_prev;
+    struct WASMExecEnv *inst_next;
 #endif
 
 #if WASM_ENABLE_GC != 0
@@ -312,6 +340,26 @@ WASMJmpBuf *
 wasm_exec_env_pop_jmpbuf(WASMExecEnv *exec_env);
 #endif
 
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+/**
+ * Interrupt the AOTed code running in the exec_env at its next safepoint
+ * poll by making the safepoint page inaccessible, the fault is handled by
+ * the runtime signal handler according to the suspend flags.
+ *
+ * @param exec_env the execution environment to interrupt
+ */
+void
+wasm_exec_env_arm_safepoint(WASMExecEnv *exec_env);
+
+/**
+ * Make the safepoint page readable again.
+ *
+ * @param exec_env the execution environment
+ */
+void
+wasm_exec_env_disarm_safepoint(WASMExecEnv *exec_env);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,675 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_instance_reset.h"
+#include "wasm_memory.h"
+#include "mem_alloc.h"
+#include "bh_log.h"
+#if WASM_ENABLE_INTERP != 0
+#include "../interpreter/wasm_runtime.h"
+#endif
+#if WASM_ENABLE_AOT != 0
+#include "../aot/aot_runtime.h"
+#endif
+
+static void
+set_error_buf(char *error_buf, uint32 error_buf_size, const char *string)
+{
+    if (error_buf != NULL)
+        snprintf(error_buf, error_buf_size, "%s", string);
+}
+
+#if WASM_ENABLE_INSTANCE_RESET != 0
+
+static void *
+runtime_malloc(uint64 size, char *error_buf, uint32 error_buf_size)
+{
+    void *mem;
+
+    if (size >= UINT32_MAX || !(mem = wasm_runtime_malloc((uint32)size))) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create reset image failed: allocate memory failed");
+        return NULL;
+    }
+
+    memset(mem, 0, (uint32)size);
+    return mem;
+}
+
+static WASMModuleInstanceExtraCommon *
+get_module_inst_extra_common(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        return &((WASMModuleInstance *)module_inst)->e->common;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)module_inst)
+                     ->e)
+                    ->common;
+#endif
+    return NULL;
+}
+
+static void
+reset_image_delete(WASMInstanceResetImage *image)
+{
+    uint32 i;
+
+    if (image->data_ranges)
+        wasm_runtime_free(image->data_ranges);
+    if (image->data)
+        wasm_runtime_free(image->data);
+    if (image->heap_struct)
+        wasm_runtime_free(image->heap_struct);
+
+    if (image->table_elems) {
+        for (i = 0; i < image->table_count; i++) {
+            if (image->table_elems[i])
+                wasm_runtime_free(image->table_elems[i]);
+        }
+        wasm_runtime_free(image->table_elems);
+    }
+    if (image->table_sizes)
+        wasm_runtime_free(image->table_sizes);
+    if (image->global_data)
+        wasm_runtime_free(image->global_data);
+    if (image->data_dropped)
+        wasm_runtime_free(image->data_dropped);
+    if (image->elem_dropped)
+        wasm_runtime_free(image->elem_dropped);
+    wasm_runtime_free(image);
+}
+
+static bool
+check_instance(WASMModuleInstanceCommon *module_inst_comm, char *error_buf,
+               uint32 error_buf_size)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleCommon *module = wasm_runtime_get_module(module_inst_comm);
+    wasm_import_t import_type;
+    int32 i, import_count = wasm_runtime_get_import_count(module);
+    uint32 j;
+
+    /* The memories and tables imported are owned by other instances */
+    for (i = 0; i < import_count; i++) {
+        wasm_runtime_get_import_type(module, i, &import_type);
+        if (import_type.kind == WASM_IMPORT_EXPORT_KIND_MEMORY
+            || import_type.kind == WASM_IMPORT_EXPORT_KIND_TABLE) {
+            set_error_buf(error_buf, error_buf_size,
+                          "create reset image failed: importing memory "
+                          "or table isn't supported");
+            return false;
+        }
+    }
+
+    if (module_inst->memory_count > 1
+        || (module_inst->memory_count == 1
+            && shared_memory_is_shared(module_inst->memories[0]))) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create reset image failed: multiple memories or "
+                      "shared memory isn't supported");
+        return false;
+    }
+
+    /* The externref objects referred to may have been released when
+       the instance is reset */
+    for (j = 0; j < module_inst->table_count; j++) {
+        if (module_inst->tables[j]->elem_type == VALUE_TYPE_EXTERNREF) {
+            set_error_buf(error_buf, error_buf_size,
+                          "create reset image failed: externref table "
+                          "isn't supported");
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+is_zero_data(const uint8 *data, uint64 size)
+{
+    const uint8 *end = data + size;
+
+    while (data < end && *data == 0)
+        data++;
+    return data == end;
+}
+
+/* Save the content of the non-zero pages of the memory data, only
+   which need to be restored after the memory is zeroed */
+static bool
+save_memory(WASMInstanceResetImage *image, WASMMemoryInstance *memory,
+            char *error_buf, uint32 error_buf_size)
+{
+    const uint8 *data = memory->memory_data;
+    uint64 data_size = memory->memory_data_size;
+    uint64 page_size = os_getpagesize(), offset, size, total_size = 0;
+    uint32 count = 0;
+    WASMResetDataRange *range = NULL;
+    bool last_zero = true;
+    uint8 *p;
+
+    image->memory_page_count = memory->cur_page_count;
+    image->memory_data_size = data_size;
+
+    /* The app heap may have been allocated from, e.g. by the start
+       function, save its structure to match the chunks in the pages */
+    if (memory->heap_data_end > memory->heap_data) {
+        if (!(image->heap_struct =
+                  runtime_malloc(mem_allocator_get_heap_struct_size(),
+                                 error_buf, error_buf_size)))
+            return false;
+        if (mem_allocator_save_heap_struct(memory->heap_handle,
+                                           image->heap_struct)
+            != 0) {
+            set_error_buf(error_buf, error_buf_size,
+                          "create reset image failed: save app heap failed");
+            return false;
+        }
+    }
+
+    /* Count the ranges first and then fill them */
+    for (offset = 0; offset < data_size; offset += page_size) {
+        size = data_size - offset < page_size ? data_size - offset : page_size;
+        if (is_zero_data(data + offset, size)) {
+            last_zero = true;
+            continue;
+        }
+        if (last_zero)
+            count++;
+        last_zero = false;
+        total_size += size;
+    }
+    if (count == 0)
+        return true;
+
+    if (!(image->data_ranges =
+              runtime_malloc(sizeof(WASMResetDataRange) * (uint64)count,
+                             error_buf, error_buf_size))
+        || !(image->data =
+                 runtime_malloc(total_size, error_buf, error_buf_size)))
+        return false;
+    image->data_range_count = count;
+
+    p = image->data;
+    for (offset = 0; offset < data_size; offset += page_size) {
+        size = data_size - offset < page_size ? data_size - offset : page_size;
+        if (is_zero_data(data + offset, size))
+            continue;
+        if (!range || range->offset + range->size != offset) {
+            range = range ? range + 1 : image->data_ranges;
+            range->offset = offset;
+        }
+        range->size += size;
+        memcpy(p, data + offset, (size_t)size);
+        p += size;
+    }
+    bh_assert(range == image->data_ranges + count - 1);
+    return true;
+}
+
+#if WASM_ENABLE_BULK_MEMORY != 0 || WASM_ENABLE_REF_TYPES != 0
+static bool
+save_bitmap(uint8 **p_data, uint32 *p_size, const bh_bitmap *bitmap,
+            char *error_buf, uint32 error_buf_size)
+{
+    uint32 size;
+
+    if (!bitmap)
+        return true;
+
+    size = (uint32)((bitmap->end_index - bitmap->begin_index + 7) / 8);
+    if (size == 0)
+        return true;
+
+    if (!(*p_data = runtime_malloc(size, error_buf, error_buf_size)))
+        return false;
+    bh_memcpy_s(*p_data, size, bitmap->map, size);
+    *p_size = size;
+    return true;
+}
+#endif
+
+static bool
+save_instance(WASMInstanceResetImage *image,
+              WASMModuleInstanceCommon *module_inst_comm, char *error_buf,
+              uint32 error_buf_size)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst_comm);
+    uint32 i;
+
+    if (module_inst->memory_count > 0
+        && !save_memory(image, module_inst->memories[0], error_buf,
+                        error_buf_size))
+        return false;
+
+    if (module_inst->global_data_size > 0) {
+        if (!(image->global_data = runtime_malloc(
+                  module_inst->global_data_size, error_buf, error_buf_size)))
+            return false;
+        bh_memcpy_s(image->global_data, module_inst->global_data_size,
+                    module_inst->global_data, module_inst->global_data_size);
+        image->global_data_size = module_inst->global_data_size;
+    }
+
+    if (module_inst->table_count > 0) {
+        if (!(image->table_sizes = runtime_malloc(
+                  sizeof(uint32) * (uint64)module_inst->table_count, error_buf,
+                  error_buf_size))
+            || !(image->table_elems = runtime_malloc(
+                     sizeof(table_elem_type_t *)
+                         * (uint64)module_inst->table_count,
+                     error_buf, error_buf_size)))
+            return false;
+        image->table_count = module_inst->table_count;
+
+        for (i = 0; i < module_inst->table_count; i++) {
+            WASMTableInstance *table = module_inst->tables[i];
+            uint64 size = sizeof(table_elem_type_t) * (uint64)table->cur_size;
+
+            image->table_sizes[i] = table->cur_size;
+            if (size > 0) {
+                if (!(image->table_elems[i] =
+                          runtime_malloc(size, error_buf, error_buf_size)))
+                    return false;
+                bh_memcpy_s(image->table_elems[i], (uint32)size, table->elems,
+                            (uint32)size);
+            }
+        }
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (!save_bitmap(&image->data_dropped, &image->data_dropped_size,
+                     e->data_dropped, error_buf, error_buf_size))
+        return false;
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (!save_bitmap(&image->elem_dropped, &image->elem_dropped_size,
+                     e->elem_dropped, error_buf, error_buf_size))
+        return false;
+#endif
+    (void)e;
+    return true;
+}
+
+bool
+wasm_instance_reset_capture(WASMModuleInstanceCommon *module_inst,
+                            char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst);
+    WASMInstanceResetImage *image;
+
+    bh_assert(e && !e->reset_image);
+
+    if (!check_instance(module_inst, error_buf, error_buf_size))
+        return false;
+
+    if (!(image = runtime_malloc(sizeof(WASMInstanceResetImage), error_buf,
+                                 error_buf_size)))
+        return false;
+
+    if (!save_instance(image, module_inst, error_buf, error_buf_size)) {
+        reset_image_delete(image);
+        return false;
+    }
+
+    e->reset_image = image;
+    return true;
+}
+
+void
+wasm_instance_reset_free(WASMModuleInstanceCommon *module_inst)
+{
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst);
+
+    if (e && e->reset_image) {
+        reset_image_delete(e->reset_image);
+        e->reset_image = NULL;
+    }
+}
+
+static bool
+restore_memory(const WASMInstanceResetImage *image,
+               WASMModuleInstance *module_inst, char *error_buf,
+               uint32 error_buf_size)
+{
+    WASMMemoryInstance *memory;
+    const WASMResetDataRange *range;
+    const uint8 *p = image->data;
+    uint32 i;
+
+    if (module_inst->memory_count == 0)
+        return true;
+
+    memory = module_inst->memories[0];
+    if (!wasm_reset_linear_memory(memory, image->memory_page_count,
+                                  image->memory_data_size)) {
+        set_error_buf(error_buf, error_buf_size,
+                      "reset instance failed: reset memory failed");
+        return false;
+    }
+
+    for (i = 0; i < image->data_range_count; i++) {
+        range = image->data_ranges + i;
+        memcpy(memory->memory_data + range->offset, p, (size_t)range->size);
+        p += range->size;
+    }
+
+    if (!wasm_restore_app_heap(memory, image->heap_struct)) {
+        set_error_buf(error_buf, error_buf_size,
+                      "reset instance failed: restore app heap failed");
+        return false;
+    }
+    return true;
+}
+
+#if WASM_ENABLE_LIBC_WASI != 0
+static bool
+reinit_wasi(WASMModuleInstanceCommon *module_inst, char *error_buf,
+           uint32 error_buf_size)
+{
+    WASIArguments *wasi_args = NULL;
+
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        wasi_args = &((WASMModuleInstance *)module_inst)->module->wasi_args;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        wasi_args =
+            &((AOTModule *)((AOTModuleInstance *)module_inst)->module)
+                 ->wasi_args;
+#endif
+    bh_assert(wasi_args);
+
+    /* Close the files opened by the instance and reopen the preopened
+       directories, as done when the instance was created */
+    wasm_runtime_destroy_wasi(module_inst);
+    wasm_runtime_set_wasi_ctx(module_inst, NULL);
+
+    return wasm_runtime_init_wasi(
+        module_inst, wasi_args->dir_list, wasi_args->dir_count,
+        wasi_args->map_dir_list, wasi_args->map_dir_count, wasi_args->env,
+        wasi_args->env_count, wasi_args->addr_pool, wasi_args->addr_count,
+        wasi_args->ns_lookup_pool, wasi_args->ns_lookup_count, wasi_args->argv,
+        wasi_args->argc, wasi_args->stdio[0], wasi_args->stdio[1],
+        wasi_args->stdio[2], error_buf, error_buf_size);
+}
+#endif /* end of WASM_ENABLE_LIBC_WASI != 0 */
+
+static bool
+reset_instance(WASMModuleInstanceCommon *module_inst_comm, bool reset_wasi_ctx,
+               char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst_comm);
+    const WASMInstanceResetImage *image = e ? e->reset_image : NULL;
+    uint32 i;
+
+    if (!image) {
+        set_error_buf(error_buf, error_buf_size,
+                      "reset instance failed: the instance isn't created "
+                      "with enable_reset");
+        return false;
+    }
+
+    if (!restore_memory(image, module_inst, error_buf, error_buf_size))
+        return false;
+
+    bh_assert(module_inst->global_data_size == image->global_data_size);
+    if (image->global_data_size > 0)
+        bh_memcpy_s(module_inst->global_data, module_inst->global_data_size,
+                    image->global_data, image->global_data_size);
+
+    bh_assert(module_inst->table_count == image->table_count);
+    for (i = 0; i < image->table_count; i++) {
+        WASMTableInstance *table = module_inst->tables[i];
+        uint32 size = image->table_sizes[i];
+
+        table->cur_size = size;
+        if (size > 0)
+            bh_memcpy_s(table->elems,
+                        (uint32)sizeof(table_elem_type_t) * table->max_size,
+                        image->table_elems[i],
+                        (uint32)sizeof(table_elem_type_t) * size);
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (image->data_dropped)
+        bh_memcpy_s(e->data_dropped->map, image->data_dropped_size,
+                    image->data_dropped, image->data_dropped_size);
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (image->elem_dropped)
+        bh_memcpy_s(e->elem_dropped->map, image->elem_dropped_size,
+                    image->elem_dropped, image->elem_dropped_size);
+#endif
+
+    wasm_runtime_set_exception(module_inst_comm, NULL);
+
+#if WASM_ENABLE_LIBC_WASI != 0
+    if (reset_wasi_ctx
+        && !reinit_wasi(module_inst_comm, error_buf, error_buf_size))
+        return false;
+#else
+    (void)reset_wasi_ctx;
+#endif
+    return true;
+}
+
+/* The instances of a pool, the free ones are kept as a stack so that
+   the recently released instance, whose pages are more likely to be
+   resident, is reused first */
+struct WASMInstancePool {
+    WASMModuleCommon *module;
+    InstantiationArgs args;
+    char *snapshot_init_func;
+    bool reset_wasi;
+    korp_mutex lock;
+    uint32 size;
+    /* The instances alive, acquired or not */
+    uint32 inst_count;
+    uint32 free_count;
+    WASMModuleInstanceCommon **free_insts;
+};
+
+static WASMModuleInstanceCommon *
+instance_pool_instantiate(wasm_instance_pool_t pool, char *error_buf,
+                          uint32 error_buf_size)
+{
+    return wasm_runtime_instantiate_ex(pool->module, &pool->args, error_buf,
+                                       error_buf_size);
+}
+
+#endif /* end of WASM_ENABLE_INSTANCE_RESET != 0 */
+
+bool
+wasm_runtime_instance_reset(WASMModuleInstanceCommon *module_inst,
+                            bool reset_wasi, char *error_buf,
+                            uint32 error_buf_size)
+{
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    return reset_instance(module_inst, reset_wasi, error_buf, error_buf_size);
+#else
+    (void)module_inst;
+    (void)reset_wasi;
+    set_error_buf(error_buf, error_buf_size,
+                  "reset instance failed: instance reset isn't enabled, "
+                  "please rebuild with -DWAMR_BUILD_INSTANCE_RESET=1");
+    return false;
+#endif
+}
+
+wasm_instance_pool_t
+wasm_runtime_create_instance_pool(WASMModuleCommon *module,
+                                  const InstantiationArgs *args,
+                                  uint32 pool_size, bool reset_wasi,
+                                  char *error_buf, uint32 error_buf_size)
+{
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    wasm_instance_pool_t pool;
+    WASMModuleInstanceCommon *module_inst;
+    uint64 total_size;
+
+    if (pool_size == 0) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create instance pool failed: invalid pool size");
+        return NULL;
+    }
+
+    if (!(pool = runtime_malloc(sizeof(struct WASMInstancePool), error_buf,
+                                error_buf_size)))
+        return NULL;
+
+    pool->module = module;
+    pool->args = *args;
+    pool->args.enable_reset = true;
+    pool->reset_wasi = reset_wasi;
+    pool->size = pool_size;
+
+    /* The init function may be needed to instantiate the instances
+       replacing the ones failed to reset */
+    if (args->snapshot_init_func) {
+        total_size = strlen(args->snapshot_init_func) + 1;
+        if (!(pool->snapshot_init_func =
+                  runtime_malloc(total_size, error_buf, error_buf_size)))
+            goto fail1;
+        bh_memcpy_s(pool->snapshot_init_func, (uint32)total_size,
+                    args->snapshot_init_func, (uint32)total_size);
+        pool->args.snapshot_init_func = pool->snapshot_init_func;
+    }
+
+    if (!(pool->free_insts = runtime_malloc(
+              sizeof(WASMModuleInstanceCommon *) * (uint64)pool_size,
+              error_buf, error_buf_size)))
+        goto fail2;
+
+    if (os_mutex_init(&pool->lock) != 0) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create instance pool failed: init lock failed");
+        goto fail3;
+    }
+
+    while (pool->inst_count < pool_size) {
+        if (!(module_inst =
+                  instance_pool_instantiate(pool, error_buf, error_buf_size))) {
+            wasm_runtime_destroy_instance_pool(pool);
+            return NULL;
+        }
+        pool->free_insts[pool->free_count++] = module_inst;
+        pool->inst_count++;
+    }
+    return pool;
+
+fail3:
+    wasm_runtime_free(pool->free_insts);
+fail2:
+    if (pool->snapshot_init_func)
+        wasm_runtime_free(pool->snapshot_init_func);
+fail1:
+    wasm_runtime_free(pool);
+    return NULL;
+#else
+    (void)module;
+    (void)args;
+    (void)pool_size;
+    (void)reset_wasi;
+    set_error_buf(error_buf, error_buf_size,
+                  "create instance pool failed: instance reset isn't "
+                  "enabled, please rebuild with -DWAMR_BUILD_INSTANCE_RESET=1");
+    return NULL;
+#endif
+}
+
+void
+wasm_runtime_destroy_instance_pool(wasm_instance_pool_t pool)
+{
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    uint32 i;
+
+    if (!pool)
+        return;
+
+    if (pool->free_count != pool->inst_count)
+        LOG_WARNING("warning: %u instances of the instance pool aren't "
+                    "released",
+                    pool->inst_count - pool->free_count);
+
+    for (i = 0; i < pool->free_count; i++)
+        wasm_runtime_deinstantiate(pool->free_insts[i]);
+
+    os_mutex_destroy(&pool->lock);
+    wasm_runtime_free(pool->free_insts);
+    if (pool->snapshot_init_func)
+        wasm_runtime_free(pool->snapshot_init_func);
+    wasm_runtime_free(pool);
+#else
+    (void)pool;
+#endif
+}
+
+WASMModuleInstanceCommon *
+wasm_runtime_instance_pool_acquire(wasm_instance_pool_t pool)
+{
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    WASMModuleInstanceCommon *module_inst = NULL;
+
+    os_mutex_lock(&pool->lock);
+    if (pool->free_count > 0)
+        module_inst = pool->free_insts[--pool->free_count];
+    os_mutex_unlock(&pool->lock);
+
+    return module_inst;
+#else
+    (void)pool;
+    return NULL;
+#endif
+}
+
+bool
+wasm_runtime_instance_pool_release(wasm_instance_pool_t pool,
+                                   WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    char error_buf[128];
+    bool ret = true;
+
+    /* Reset the instance out of the lock, it is owned by the caller
+       until it is put back */
+    if (!reset_instance(module_inst, pool->reset_wasi, error_buf,
+                        sizeof(error_buf))) {
+        LOG_WARNING("warning: %s, instantiate a new one", error_buf);
+        wasm_runtime_deinstantiate(module_inst);
+        if (!(module_inst =
+                  instance_pool_instantiate(pool, error_buf, sizeof(error_buf)))) {
+            LOG_WARNING("warning: %s", error_buf);
+            ret = false;
+        }
+    }
+
+    os_mutex_lock(&pool->lock);
+    if (module_inst) {
+        bh_assert(pool->free_count < pool->size);
+        pool->free_insts[pool->free_count++] = module_inst;
+    }
+    else {
+        /* The pool shrinks if the replacement can't be instantiated */
+        pool->inst_count--;
+    }
+    os_mutex_unlock(&pool->lock);
+
+    return ret;
+#else
+    (void)pool;
+    (void)module_inst;
+    return false;
+#endif
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_INSTANCE_RESET_H
+#define _WASM_INSTANCE_RESET_H
+
+#include "bh_common.h"
+#include "wasm_runtime_common.h"
+
+#if WASM_ENABLE_INSTANCE_RESET != 0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct WASMResetDataRange {
+    uint64 offset;
+    uint64 size;
+} WASMResetDataRange;
+
+/**
+ * The state of a module instance right after it was instantiated, taken
+ * when the instance is created with InstantiationArgs.enable_reset, and
+ * restored by wasm_runtime_instance_reset.
+ */
+typedef struct WASMInstanceResetImage {
+    /* Page count and data size of the default memory */
+    uint32 memory_page_count;
+    uint64 memory_data_size;
+    /* The ranges of the non-zero pages of the memory data, whose content
+       is kept in data one after another */
+    uint32 data_range_count;
+    WASMResetDataRange *data_ranges;
+    uint8 *data;
+    /* The structure of the app heap, which is restored with the memory
+       data as its pool is in the memory */
+    uint8 *heap_struct;
+
+    uint32 global_data_size;
+    uint8 *global_data;
+
+    uint32 table_count;
+    /* The current size and elements of each table */
+    uint32 *table_sizes;
+    table_elem_type_t **table_elems;
+
+    uint32 data_dropped_size;
+    uint8 *data_dropped;
+    uint32 elem_dropped_size;
+    uint8 *elem_dropped;
+} WASMInstanceResetImage;
+
+/**
+ * Take the reset image of a module instance which has just been
+ * instantiated
+ */
+bool
+wasm_instance_reset_capture(WASMModuleInstanceCommon *module_inst,
+                            char *error_buf, uint32 error_buf_size);
+
+/**
+ * Free the reset image of a module instance which is being
+ * deinstantiated
+ */
+void
+wasm_instance_reset_free(WASMModuleInstanceCommon *module_inst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of WASM_ENABLE_INSTANCE_RESET != 0 */
+
+#endif /* end of _WASM_INSTANCE_RESET_H */
@@ -5,6 +5,9 @@
 #include "wasm_loader_common.h"
 #include "bh_log.h"
 #include "../interpreter/wasm.h"
+#if WASM_ENABLE_FAST_INTERP != 0
+#include "../interpreter/wasm_opcode.h"
+#endif
 
 static void
 set_error_buf(char *error_buf, uint32 error_buf_size, const char *string,
@@ -56,3 +59,53 @@ wasm_memory_check_flags(const uint8 mem_flag, char *error_buf,
 
     return true;
 }
+
+#if WASM_ENABLE_FAST_INTERP != 0
+/* Record the operands of the i32 comparison to be emitted, frame_offset
+   is the top of the operand offset stack, and available_cell_num the
+   number of cells on it which belong to the current block */
+void
+wasm_loader_record_fusible_cmp(WASMFusibleCmp *cmp, const int16 *frame_offset,
+                               uint32 available_cell_num,
+                               uint32 operand_count)
+{
+    uint32 i;
+
+    bh_assert(operand_count <= sizeof(cmp->operands) / sizeof(int16));
+
+    cmp->operand_count = 0;
+    /* the operands aren't emitted if the stack is in polymorphic state,
+       and the type mismatch will be reported when popping them */
+    if (available_cell_num < operand_count)
+        return;
+
+    for (i = 0; i < operand_count; i++)
+        cmp->operands[i] = *(frame_offset - 1 - i);
+    cmp->operand_count = operand_count;
+}
+
+/* Get the opcode which fuses the comparison cmp_opcode with the br_if or
+   if following it, code_offset is the current code offset and
+   branch_size the size emitted since the comparison, i.e. the fuel
+   charging, the label of br_if/if and its condition operand, return 0
+   if they can't be fused */
+uint8
+wasm_loader_get_fused_cmp_opcode(const WASMFusibleCmp *cmp, uint8 cmp_opcode,
+                                 uint8 branch_opcode, uint32 code_offset,
+                                 uint32 branch_size)
+{
+    if (cmp_opcode < WASM_OP_I32_EQZ || cmp_opcode > WASM_OP_I32_GE_U)
+        return 0;
+
+    /* nothing else may be emitted between them, e.g. the copies of
+       the locals preserved before if */
+    if (cmp->operand_count == 0
+        || code_offset != cmp->code_end + branch_size)
+        return 0;
+
+    bh_assert(branch_opcode == WASM_OP_BR_IF || branch_opcode == WASM_OP_IF);
+    if (branch_opcode == WASM_OP_BR_IF)
+        return (uint8)(EXT_OP_BR_IF_I32_EQZ + (cmp_opcode - WASM_OP_I32_EQZ));
+    return (uint8)(EXT_OP_IF_I32_EQZ + (cmp_opcode - WASM_OP_I32_EQZ));
+}
+#endif
@@ -16,6 +16,29 @@ bool
 wasm_memory_check_flags(const uint8 mem_flag, char *error_buf,
                         uint32 error_buf_size, bool is_aot);
 
+#if WASM_ENABLE_FAST_INTERP != 0
+/* The i32 comparison emitted last by the fast interpreter loader, which
+   may be fused with the br_if or if following it */
+typedef struct WASMFusibleCmp {
+    /* operands of the comparison in the order they are popped */
+    int16 operands[2];
+    /* 0 if the comparison isn't fusible */
+    uint32 operand_count;
+    /* code offset where the comparison ends */
+    uint32 code_end;
+} WASMFusibleCmp;
+
+void
+wasm_loader_record_fusible_cmp(WASMFusibleCmp *cmp, const int16 *frame_offset,
+                               uint32 available_cell_num,
+                               uint32 operand_count);
+
+uint8
+wasm_loader_get_fused_cmp_opcode(const WASMFusibleCmp *cmp, uint8 cmp_opcode,
+                                 uint8 branch_opcode, uint32 code_offset,
+                                 uint32 branch_size);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
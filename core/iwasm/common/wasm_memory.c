@@ -12,6 +12,9 @@
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "../common/wasm_shared_memory.h"
 #endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+#include "wasm_module_snapshot.h"
+#endif
 
 typedef enum Memory_Mode {
     MEMORY_MODE_UNKNOWN = 0,
@@ -24,6 +27,52 @@ static Memory_Mode memory_mode = MEMORY_MODE_UNKNOWN;
 
 static mem_allocator_t pool_allocator = NULL;
 
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+#ifndef os_thread_local_attribute
+#error "Thread-local storage is required by the allocation thread cache"
+#endif
+
+/* The usable sizes of the size classes, a block of usable size in
+   [size_classes[i], size_classes[i + 1]) is cached in class i, and
+   the last class caches blocks up to THREAD_CACHE_MAX_SIZE */
+static const uint32 thread_cache_size_classes[] = {
+    16, 32, 48, 64, 96, 128, 192, 256, 384, 512, 768, 1024
+};
+
+#define THREAD_CACHE_CLASS_NUM \
+    (sizeof(thread_cache_size_classes) / sizeof(uint32))
+#define THREAD_CACHE_MAX_SIZE 1536
+#define THREAD_CACHE_MAX_BLOCKS 16
+
+typedef struct ThreadCache {
+    /* The pool generation which the cached blocks belong to */
+    uint32 generation;
+#ifdef OS_ENABLE_THREAD_KEY
+    /* Whether the cache is set as the value of thread_cache_key, i.e.
+       whether it will be flushed when the thread exits */
+    bool key_set;
+#endif
+    uint8 counts[THREAD_CACHE_CLASS_NUM];
+    void *blocks[THREAD_CACHE_CLASS_NUM][THREAD_CACHE_MAX_BLOCKS];
+} ThreadCache;
+
+static os_thread_local_attribute ThreadCache thread_cache;
+
+/* Increased each time the pool allocator is created or destroyed, so
+   that the blocks cached by a thread for a previous pool are dropped */
+static bh_atomic_32_t pool_generation;
+
+#ifdef OS_ENABLE_THREAD_KEY
+/* The key whose value is the cache of the thread, to flush the cache
+   when a host thread exits without wasm_runtime_destroy_thread_env */
+static korp_thread_key thread_cache_key;
+static bool thread_cache_key_created;
+
+static void
+thread_cache_destroy(void *value);
+#endif
+#endif
+
 static enlarge_memory_error_callback_t enlarge_memory_error_cb;
 static void *enlarge_memory_error_user_data;
 
@@ -77,6 +126,16 @@ wasm_memory_init_with_pool(void *mem, unsigned int bytes)
         memory_mode = MEMORY_MODE_POOL;
         pool_allocator = allocator;
         global_pool_size = bytes;
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+        BH_ATOMIC_32_FETCH_ADD(pool_generation, 1);
+#ifdef OS_ENABLE_THREAD_KEY
+        /* If it fails, the caches of host threads are only flushed by
+           wasm_runtime_destroy_thread_env */
+        thread_cache_key_created =
+            os_thread_key_create(&thread_cache_key, thread_cache_destroy)
+            == BHT_OK;
+#endif
+#endif
         return true;
     }
     LOG_ERROR("Init memory with pool (%p, %u) failed.\n", mem, bytes);
@@ -132,6 +191,55 @@ is_bounds_checks_enabled(WASMModuleInstanceCommon *module_inst)
 #endif
 }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+/* The shared heap ends at the top of the 32-bit app address space */
+#define SHARED_HEAP_END_OFF ((uint64)UINT32_MAX + 1)
+
+static WASMSharedHeap *shared_heap_list = NULL;
+static korp_mutex shared_heap_list_lock;
+
+static WASMModuleInstanceExtraCommon *
+get_module_inst_extra_common(WASMModuleInstanceCommon *inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (inst->module_type == Wasm_Module_Bytecode) {
+        return &((WASMModuleInstance *)inst)->e->common;
+    }
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (inst->module_type == Wasm_Module_AoT) {
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)inst)->e)
+                    ->common;
+    }
+#endif
+    bh_assert(false);
+    return NULL;
+}
+
+bool
+wasm_runtime_is_app_addr_in_shared_heap(WASMModuleInstanceCommon *module_inst,
+                                        uint64 app_offset, uint64 bytes)
+{
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst);
+
+    /* shared_heap_start_off is UINT64_MAX if no heap is attached */
+    return app_offset >= e->shared_heap_start_off
+           && bytes <= SHARED_HEAP_END_OFF - app_offset;
+}
+
+static bool
+is_native_addr_in_shared_heap(WASMModuleInstanceCommon *module_inst,
+                              uint8 *addr, uint64 bytes)
+{
+    WASMSharedHeap *heap = get_module_inst_extra_common(module_inst)->shared_heap;
+
+    return heap && heap->base_addr <= addr
+           && (uintptr_t)addr <= UINTPTR_MAX - bytes
+           && addr + bytes <= heap->base_addr + heap->size;
+}
+#endif /* end of WASM_ENABLE_SHARED_HEAP != 0 */
+
 bool
 wasm_runtime_memory_init(mem_alloc_type_t mem_alloc_type,
                          const MemAllocOption *alloc_option)
@@ -170,6 +278,17 @@ wasm_runtime_memory_destroy()
             /* Memory leak detected */
             exit(-1);
         }
+#endif
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+        BH_ATOMIC_32_FETCH_ADD(pool_generation, 1);
+#ifdef OS_ENABLE_THREAD_KEY
+        /* The caches of the threads still alive are dropped with the
+           pool, they needn't be flushed when the threads exit */
+        if (thread_cache_key_created) {
+            os_thread_key_delete(thread_cache_key);
+            thread_cache_key_created = false;
+        }
+#endif
 #endif
     }
     memory_mode = MEMORY_MODE_UNKNOWN;
@@ -184,6 +303,145 @@ wasm_runtime_memory_pool_size()
         return UINT32_MAX;
 }
 
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+static inline uint32
+thread_cache_capacity(uint32 class_idx)
+{
+    uint32 capacity = WASM_MEM_ALLOC_THREAD_CACHE_CLASS_BYTES
+                      / thread_cache_size_classes[class_idx];
+
+    if (capacity < 2)
+        capacity = 2;
+    if (capacity > THREAD_CACHE_MAX_BLOCKS)
+        capacity = THREAD_CACHE_MAX_BLOCKS;
+    return capacity;
+}
+
+static ThreadCache *
+thread_cache_get(void)
+{
+    ThreadCache *cache = &thread_cache;
+    uint32 generation = BH_ATOMIC_32_LOAD(pool_generation);
+
+    if (cache->generation != generation) {
+        /* The cached blocks belong to a pool which was destroyed */
+        memset(cache->counts, 0, sizeof(cache->counts));
+        cache->generation = generation;
+#ifdef OS_ENABLE_THREAD_KEY
+        cache->key_set = false;
+#endif
+    }
+#ifdef OS_ENABLE_THREAD_KEY
+    /* Set it again if the cache is used after it was flushed by the
+       destructor, e.g. by the destructor of another key, then pthread
+       calls the destructor again */
+    if (!cache->key_set && thread_cache_key_created
+        && os_thread_key_set(thread_cache_key, cache) == BHT_OK)
+        cache->key_set = true;
+#endif
+    return cache;
+}
+
+/* Flush the blocks cached by the current thread back to the pool */
+static void
+thread_cache_flush(ThreadCache *cache)
+{
+    uint32 i;
+
+    for (i = 0; i < THREAD_CACHE_CLASS_NUM; i++) {
+        if (cache->counts[i] > 0) {
+            mem_allocator_free_batch(pool_allocator, cache->blocks[i],
+                                     cache->counts[i]);
+            cache->counts[i] = 0;
+        }
+    }
+}
+
+static void *
+thread_cache_malloc(unsigned int size)
+{
+    ThreadCache *cache;
+    uint32 i, count;
+
+    if (size > thread_cache_size_classes[THREAD_CACHE_CLASS_NUM - 1])
+        return mem_allocator_malloc(pool_allocator, size);
+
+    for (i = 0; thread_cache_size_classes[i] < size; i++)
+        ;
+
+    cache = thread_cache_get();
+    if (cache->counts[i] > 0)
+        return cache->blocks[i][--cache->counts[i]];
+
+    /* Refill half of the class with one lock acquisition, and return
+       one of the blocks to the caller */
+    count = (uint32)mem_allocator_malloc_batch(
+        pool_allocator, thread_cache_size_classes[i], cache->blocks[i],
+        (int)thread_cache_capacity(i) / 2 + 1);
+    if (count > 0) {
+        cache->counts[i] = (uint8)(count - 1);
+        return cache->blocks[i][count - 1];
+    }
+
+    /* The pool may be exhausted while blocks are kept in the cache */
+    thread_cache_flush(cache);
+    return mem_allocator_malloc(pool_allocator, size);
+}
+
+static void
+thread_cache_free(void *ptr)
+{
+    ThreadCache *cache;
+    uint32 size, capacity, count, i;
+
+    size = mem_allocator_get_size(pool_allocator, ptr);
+    if (size < thread_cache_size_classes[0] || size >= THREAD_CACHE_MAX_SIZE) {
+        mem_allocator_free(pool_allocator, ptr);
+        return;
+    }
+
+    for (i = THREAD_CACHE_CLASS_NUM - 1; thread_cache_size_classes[i] > size;
+         i--)
+        ;
+
+    cache = thread_cache_get();
+    capacity = thread_cache_capacity(i);
+    if (cache->counts[i] >= capacity) {
+        /* Flush the older half of the class with one lock acquisition */
+        count = capacity / 2;
+        mem_allocator_free_batch(pool_allocator, cache->blocks[i], count);
+        memmove(cache->blocks[i], cache->blocks[i] + count,
+                sizeof(void *) * (cache->counts[i] - count));
+        cache->counts[i] -= count;
+    }
+    cache->blocks[i][cache->counts[i]++] = ptr;
+}
+
+#ifdef OS_ENABLE_THREAD_KEY
+/* Called when a thread which has used its cache exits */
+static void
+thread_cache_destroy(void *value)
+{
+    ThreadCache *cache = (ThreadCache *)value;
+
+    /* The value was reset by pthread before calling the destructor */
+    cache->key_set = false;
+    if (memory_mode == MEMORY_MODE_POOL
+        && cache->generation == BH_ATOMIC_32_LOAD(pool_generation))
+        thread_cache_flush(cache);
+}
+#endif
+#endif /* end of WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0 */
+
+void
+wasm_memory_flush_thread_cache(void)
+{
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+    if (memory_mode == MEMORY_MODE_POOL)
+        thread_cache_flush(thread_cache_get());
+#endif
+}
+
 static inline void *
 wasm_runtime_malloc_internal(unsigned int size)
 {
@@ -193,7 +451,11 @@ wasm_runtime_malloc_internal(unsigned int size)
         return NULL;
     }
     else if (memory_mode == MEMORY_MODE_POOL) {
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+        return thread_cache_malloc(size);
+#else
         return mem_allocator_malloc(pool_allocator, size);
+#endif
     }
     else if (memory_mode == MEMORY_MODE_ALLOCATOR) {
         return malloc_func(
@@ -219,7 +481,18 @@ wasm_runtime_realloc_internal(void *ptr, unsigned int size)
         return NULL;
     }
     else if (memory_mode == MEMORY_MODE_POOL) {
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+        void *ret = mem_allocator_realloc(pool_allocator, ptr, size);
+        if (!ret && size > 0) {
+            /* The pool may be exhausted while blocks are kept in the
+               cache */
+            thread_cache_flush(thread_cache_get());
+            ret = mem_allocator_realloc(pool_allocator, ptr, size);
+        }
+        return ret;
+#else
         return mem_allocator_realloc(pool_allocator, ptr, size);
+#endif
     }
     else if (memory_mode == MEMORY_MODE_ALLOCATOR) {
         if (realloc_func)
@@ -255,7 +528,11 @@ wasm_runtime_free_internal(void *ptr)
                     "memory hasn't been initialize.\n");
     }
     else if (memory_mode == MEMORY_MODE_POOL) {
+#if WASM_ENABLE_MEM_ALLOC_THREAD_CACHE != 0
+        thread_cache_free(ptr);
+#else
         mem_allocator_free(pool_allocator, ptr);
+#endif
     }
     else if (memory_mode == MEMORY_MODE_ALLOCATOR) {
         free_func(
@@ -323,6 +600,13 @@ wasm_runtime_validate_app_addr(WASMModuleInstanceCommon *module_inst_comm,
         return true;
     }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (wasm_runtime_is_app_addr_in_shared_heap(module_inst_comm, app_offset,
+                                                size)) {
+        return true;
+    }
+#endif
+
     memory_inst = wasm_get_default_memory(module_inst);
     if (!memory_inst) {
         goto fail;
@@ -410,6 +694,12 @@ wasm_runtime_validate_native_addr(WASMModuleInstanceCommon *module_inst_comm,
         return true;
     }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (is_native_addr_in_shared_heap(module_inst_comm, addr, size)) {
+        return true;
+    }
+#endif
+
     memory_inst = wasm_get_default_memory(module_inst);
     if (!memory_inst) {
         goto fail;
@@ -453,6 +743,15 @@ wasm_runtime_addr_app_to_native(WASMModuleInstanceCommon *module_inst_comm,
 
     bounds_checks = is_bounds_checks_enabled(module_inst_comm);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (wasm_runtime_is_app_addr_in_shared_heap(module_inst_comm, app_offset,
+                                                1)) {
+        return get_module_inst_extra_common(module_inst_comm)
+                   ->shared_heap_base_addr_adj
+               + app_offset;
+    }
+#endif
+
     memory_inst = wasm_get_default_memory(module_inst);
     if (!memory_inst) {
         return NULL;
@@ -492,6 +791,14 @@ wasm_runtime_addr_native_to_app(WASMModuleInstanceCommon *module_inst_comm,
 
     bounds_checks = is_bounds_checks_enabled(module_inst_comm);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (is_native_addr_in_shared_heap(module_inst_comm, addr, 1)) {
+        return (uint64)(addr
+                        - get_module_inst_extra_common(module_inst_comm)
+                              ->shared_heap_base_addr_adj);
+    }
+#endif
+
     memory_inst = wasm_get_default_memory(module_inst);
     if (!memory_inst) {
         return 0;
@@ -530,6 +837,19 @@ wasm_runtime_get_app_addr_range(WASMModuleInstanceCommon *module_inst_comm,
     bh_assert(module_inst_comm->module_type == Wasm_Module_Bytecode
               || module_inst_comm->module_type == Wasm_Module_AoT);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (wasm_runtime_is_app_addr_in_shared_heap(module_inst_comm, app_offset,
+                                                1)) {
+        if (p_app_start_offset)
+            *p_app_start_offset =
+                get_module_inst_extra_common(module_inst_comm)
+                    ->shared_heap_start_off;
+        if (p_app_end_offset)
+            *p_app_end_offset = SHARED_HEAP_END_OFF;
+        return true;
+    }
+#endif
+
     memory_inst = wasm_get_default_memory(module_inst);
     if (!memory_inst) {
         return false;
@@ -565,6 +885,19 @@ wasm_runtime_get_native_addr_range(WASMModuleInstanceCommon *module_inst_comm,
     bh_assert(module_inst_comm->module_type == Wasm_Module_Bytecode
               || module_inst_comm->module_type == Wasm_Module_AoT);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (is_native_addr_in_shared_heap(module_inst_comm, addr, 1)) {
+        WASMSharedHeap *heap =
+            get_module_inst_extra_common(module_inst_comm)->shared_heap;
+
+        if (p_native_start_addr)
+            *p_native_start_addr = heap->base_addr;
+        if (p_native_end_addr)
+            *p_native_end_addr = heap->base_addr + heap->size;
+        return true;
+    }
+#endif
+
     memory_inst = wasm_get_default_memory(module_inst);
     if (!memory_inst) {
         return false;
@@ -602,6 +935,32 @@ wasm_check_app_addr_and_convert(WASMModuleInstance *module_inst, bool is_str,
         return false;
     }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (wasm_runtime_is_app_addr_in_shared_heap(
+            (WASMModuleInstanceCommon *)module_inst, app_buf_addr,
+            is_str ? 1 : app_buf_size)) {
+        const char *str, *str_end;
+
+        native_addr = get_module_inst_extra_common(
+                          (WASMModuleInstanceCommon *)module_inst)
+                          ->shared_heap_base_addr_adj
+                      + app_buf_addr;
+        if (is_str) {
+            /* The whole string must be in the shared heap */
+            str = (const char *)native_addr;
+            str_end = str + (SHARED_HEAP_END_OFF - app_buf_addr);
+            while (str < str_end && *str != '\0')
+                str++;
+            if (str == str_end) {
+                wasm_set_exception(module_inst,
+                                   "out of bounds memory access");
+                return false;
+            }
+        }
+        goto success;
+    }
+#endif
+
     native_addr = memory_inst->memory_data + (uintptr_t)app_buf_addr;
 
     bounds_checks = is_bounds_checks_enabled((wasm_module_inst_t)module_inst);
@@ -739,6 +1098,251 @@ wasm_mmap_linear_memory(uint64_t map_size, uint64 commit_size)
     return wasm_mremap_linear_memory(NULL, 0, map_size, commit_size);
 }
 
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+#if WASM_MEM_ALLOC_WITH_USAGE == 0
+/* Totally 8G is mapped for a linear memory, see
+   wasm_allocate_linear_memory */
+#define LINEAR_MEMORY_MAP_SIZE (8 * (uint64)BH_GB)
+
+typedef struct LinearMemorySlot {
+    uint8 *data;
+    /* Size of the accessible range at the beginning of the slot,
+       which is zeroed and may be resident */
+    uint64 commit_size;
+} LinearMemorySlot;
+
+/* The free slots are used as a stack, so that the recently released
+   slot, whose pages are more likely to be resident, is reused first */
+static korp_mutex linear_memory_pool_lock;
+static LinearMemorySlot *linear_memory_pool_slots;
+static uint32 linear_memory_pool_size;
+static uint32 linear_memory_pool_free_count;
+static uint64 linear_memory_pool_keep_resident_size;
+static uint64 linear_memory_pool_resident_size;
+static uint64 linear_memory_pool_hit_count;
+static uint64 linear_memory_pool_miss_count;
+
+/* Zero the range and release its physical pages, the range becomes
+   inaccessible */
+static bool
+linear_memory_decommit(uint8 *data, uint64 size)
+{
+    if (size == 0)
+        return true;
+
+    if (os_mem_decommit(data, size) != 0)
+        return false;
+
+#ifndef BH_PLATFORM_WINDOWS
+    /* the pages are still accessible after madvise */
+    if (os_mprotect(data, size, MMAP_PROT_NONE) != 0)
+        return false;
+#endif
+
+    return true;
+}
+
+static uint8 *
+linear_memory_pool_acquire(uint64 commit_size)
+{
+    LinearMemorySlot slot;
+
+    /* Quick check without the lock, the pool is disabled by default */
+    if (linear_memory_pool_size == 0)
+        return NULL;
+
+    os_mutex_lock(&linear_memory_pool_lock);
+    if (linear_memory_pool_free_count == 0) {
+        linear_memory_pool_miss_count++;
+        os_mutex_unlock(&linear_memory_pool_lock);
+        return NULL;
+    }
+    slot = linear_memory_pool_slots[--linear_memory_pool_free_count];
+    linear_memory_pool_resident_size -= slot.commit_size;
+    linear_memory_pool_hit_count++;
+    os_mutex_unlock(&linear_memory_pool_lock);
+
+    if (slot.commit_size < commit_size) {
+#ifdef BH_PLATFORM_WINDOWS
+        if (!os_mem_commit(slot.data + slot.commit_size,
+                           commit_size - slot.commit_size,
+                           MMAP_PROT_READ | MMAP_PROT_WRITE)) {
+            goto fail;
+        }
+#endif
+        if (os_mprotect(slot.data + slot.commit_size,
+                        commit_size - slot.commit_size,
+                        MMAP_PROT_READ | MMAP_PROT_WRITE)
+            != 0) {
+            goto fail;
+        }
+    }
+    else if (!linear_memory_decommit(slot.data + commit_size,
+                                     slot.commit_size - commit_size)) {
+        goto fail;
+    }
+
+    return slot.data;
+
+fail:
+    wasm_munmap_linear_memory(slot.data, slot.commit_size,
+                              LINEAR_MEMORY_MAP_SIZE);
+    return NULL;
+}
+
+static bool
+linear_memory_pool_release(WASMMemoryInstance *memory_inst)
+{
+    uint8 *data = memory_inst->memory_data;
+    uint64 commit_size = memory_inst->memory_data_size;
+    uint64 keep_size;
+    bool ret = false;
+
+    if (linear_memory_pool_size == 0)
+        return false;
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    /* The pages of a file mapped over the memory data would be read again
+       after they are decommitted, replace them with anonymous pages */
+    if (memory_inst->is_file_mapped) {
+        if (!wasm_module_snapshot_unmap_memory(memory_inst))
+            return false;
+        memory_inst->is_file_mapped = 0;
+    }
+#endif
+
+    /* Reset the slot out of the lock, the pages kept resident are
+       cleared, and the others are released */
+    keep_size = linear_memory_pool_keep_resident_size;
+    if (keep_size > commit_size)
+        keep_size = commit_size;
+    memset(data, 0, (size_t)keep_size);
+    if (!linear_memory_decommit(data + keep_size, commit_size - keep_size))
+        return false;
+
+    os_mutex_lock(&linear_memory_pool_lock);
+    if (linear_memory_pool_free_count < linear_memory_pool_size) {
+        LinearMemorySlot *slot =
+            &linear_memory_pool_slots[linear_memory_pool_free_count++];
+        slot->data = data;
+        slot->commit_size = keep_size;
+        linear_memory_pool_resident_size += keep_size;
+        ret = true;
+    }
+    os_mutex_unlock(&linear_memory_pool_lock);
+
+    return ret;
+}
+#endif /* end of WASM_MEM_ALLOC_WITH_USAGE == 0 */
+
+bool
+wasm_linear_memory_pool_init(void)
+{
+#if WASM_MEM_ALLOC_WITH_USAGE == 0
+    if (os_mutex_init(&linear_memory_pool_lock) != 0)
+        return false;
+#endif
+    return true;
+}
+
+void
+wasm_linear_memory_pool_destroy(void)
+{
+#if WASM_MEM_ALLOC_WITH_USAGE == 0
+    wasm_runtime_set_linear_memory_pool(0, 0);
+    linear_memory_pool_hit_count = linear_memory_pool_miss_count = 0;
+    os_mutex_destroy(&linear_memory_pool_lock);
+#endif
+}
+#endif /* end of OS_ENABLE_HW_BOUND_CHECK */
+
+bool
+wasm_runtime_set_linear_memory_pool(uint32 pool_size,
+                                    uint64 keep_resident_size)
+{
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && WASM_MEM_ALLOC_WITH_USAGE == 0
+    LinearMemorySlot *slots = NULL, *slots_old;
+    uint32 free_count, i;
+    uint64 total_size, page_size = os_getpagesize();
+    uint8 *data;
+
+    if (pool_size > 0) {
+        total_size = sizeof(LinearMemorySlot) * (uint64)pool_size;
+        if (total_size >= UINT32_MAX
+            || !(slots = wasm_runtime_malloc((uint32)total_size))) {
+            LOG_ERROR("Create linear memory pool failed: "
+                      "allocate memory failed.\n");
+            return false;
+        }
+    }
+
+    os_mutex_lock(&linear_memory_pool_lock);
+
+    slots_old = linear_memory_pool_slots;
+    free_count = linear_memory_pool_free_count;
+    if (free_count > pool_size)
+        free_count = pool_size;
+    if (free_count > 0) {
+        bh_memcpy_s(slots, (uint32)(sizeof(LinearMemorySlot) * pool_size),
+                    slots_old, (uint32)(sizeof(LinearMemorySlot) * free_count));
+    }
+    /* Unmap the free slots which don't fit into the new pool */
+    for (i = free_count; i < linear_memory_pool_free_count; i++) {
+        linear_memory_pool_resident_size -= slots_old[i].commit_size;
+        wasm_munmap_linear_memory(slots_old[i].data, slots_old[i].commit_size,
+                                  LINEAR_MEMORY_MAP_SIZE);
+    }
+
+    /* Reserve the address space of the slots in advance */
+    while (free_count < pool_size) {
+        if (!(data = wasm_mmap_linear_memory(LINEAR_MEMORY_MAP_SIZE, 0))) {
+            LOG_WARNING("warning: only %u of %u linear memory slots are "
+                        "reserved\n",
+                        free_count, pool_size);
+            break;
+        }
+        slots[free_count].data = data;
+        slots[free_count].commit_size = 0;
+        free_count++;
+    }
+
+    linear_memory_pool_slots = slots;
+    linear_memory_pool_size = pool_size;
+    linear_memory_pool_free_count = free_count;
+    linear_memory_pool_keep_resident_size =
+        align_as_and_cast(keep_resident_size, page_size);
+
+    os_mutex_unlock(&linear_memory_pool_lock);
+
+    if (slots_old)
+        wasm_runtime_free(slots_old);
+    return true;
+#else
+    (void)pool_size;
+    (void)keep_resident_size;
+    LOG_WARNING("warning: linear memory pool requires the hardware bound "
+                "check\n");
+    return false;
+#endif
+}
+
+void
+wasm_runtime_get_linear_memory_pool_stats(linear_memory_pool_stats_t *stats)
+{
+    bh_assert(stats);
+    memset(stats, 0, sizeof(linear_memory_pool_stats_t));
+
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && WASM_MEM_ALLOC_WITH_USAGE == 0
+    os_mutex_lock(&linear_memory_pool_lock);
+    stats->pool_size = linear_memory_pool_size;
+    stats->free_count = linear_memory_pool_free_count;
+    stats->resident_size = linear_memory_pool_resident_size;
+    stats->hit_count = linear_memory_pool_hit_count;
+    stats->miss_count = linear_memory_pool_miss_count;
+    os_mutex_unlock(&linear_memory_pool_lock);
+#endif
+}
+
 bool
 wasm_enlarge_memory_internal(WASMModuleInstance *module, uint32 inc_page_count)
 {
@@ -790,6 +1394,17 @@ wasm_enlarge_memory_internal(WASMModuleInstance *module, uint32 inc_page_count)
         goto return_func;
     }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* The linear memory can't grow into the shared heap attached */
+    if (total_size_new
+        > get_module_inst_extra_common((WASMModuleInstanceCommon *)module)
+              ->shared_heap_start_off) {
+        failure_reason = MAX_SIZE_REACHED;
+        ret = false;
+        goto return_func;
+    }
+#endif
+
     bh_assert(total_size_new
               <= GET_MAX_LINEAR_MEMORY_SIZE(memory->is_memory64));
 
@@ -964,8 +1579,11 @@ wasm_deallocate_linear_memory(WASMMemoryInstance *memory_inst)
 #endif
               memory_inst->memory_data);
 #else
-    wasm_munmap_linear_memory(memory_inst->memory_data,
-                              memory_inst->memory_data_size, map_size);
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    if (!linear_memory_pool_release(memory_inst))
+#endif
+        wasm_munmap_linear_memory(memory_inst->memory_data,
+                                  memory_inst->memory_data_size, map_size);
 #endif
 
     memory_inst->memory_data = NULL;
@@ -1019,6 +1637,10 @@ wasm_allocate_linear_memory(uint8 **data, bool is_shared_memory,
             return BHT_ERROR;
         }
 #else
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+        if ((*data = linear_memory_pool_acquire(*memory_data_size)))
+            return BHT_OK;
+#endif
         if (!(*data = wasm_mmap_linear_memory(map_size, *memory_data_size))) {
             return BHT_ERROR;
         }
@@ -1027,3 +1649,378 @@ wasm_allocate_linear_memory(uint8 **data, bool is_shared_memory,
 
     return BHT_OK;
 }
+
+#if WASM_ENABLE_INSTANCE_RESET != 0
+bool
+wasm_reset_linear_memory(WASMMemoryInstance *memory, uint32 page_count,
+                         uint64 data_size)
+{
+    uint64 data_size_old = memory->memory_data_size;
+    uint32 heap_size = (uint32)(memory->heap_data_end - memory->heap_data);
+#if !defined(OS_ENABLE_HW_BOUND_CHECK) || WASM_MEM_ALLOC_WITH_USAGE != 0
+    uint64 heap_offset = (uint64)(memory->heap_data - memory->memory_data);
+    uint64 data_size_new;
+    uint8 *data_new = NULL;
+#endif
+
+    bh_assert(!shared_memory_is_shared(memory));
+    bh_assert(data_size <= data_size_old);
+
+    /* Destroy the app heap before its pool is cleared, it is restored
+       by the caller with the memory content */
+    if (heap_size > 0)
+        mem_allocator_destroy(memory->heap_handle);
+
+#if defined(OS_ENABLE_HW_BOUND_CHECK) && WASM_MEM_ALLOC_WITH_USAGE == 0
+    /* Release the pages instead of zeroing them, so that the cost is in
+       proportion to the pages touched by the instance rather than the
+       memory size, they are zero filled when touched again. The pages
+       grown since instantiation are left inaccessible. */
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    if (memory->is_file_mapped) {
+        if (!wasm_module_snapshot_unmap_memory(memory))
+            goto fail;
+        memory->is_file_mapped = 0;
+    }
+#endif
+    if (!linear_memory_decommit(memory->memory_data, data_size_old))
+        goto fail;
+#ifdef BH_PLATFORM_WINDOWS
+    if (data_size > 0
+        && !os_mem_commit(memory->memory_data, data_size,
+                          MMAP_PROT_READ | MMAP_PROT_WRITE))
+        goto fail;
+#endif
+    if (os_mprotect(memory->memory_data, data_size,
+                    MMAP_PROT_READ | MMAP_PROT_WRITE)
+        != 0)
+        goto fail;
+#else
+    if (data_size < data_size_old) {
+        /* The linear memory can't be shrunk in place, replace it with
+           a new one of the initial size */
+        if (wasm_allocate_linear_memory(&data_new, false, memory->is_memory64,
+                                        memory->num_bytes_per_page,
+                                        page_count, memory->max_page_count,
+                                        &data_size_new)
+            != BHT_OK)
+            goto fail;
+        bh_assert(data_size_new == data_size);
+#if WASM_MEM_ALLOC_WITH_USAGE != 0
+        /* The memory allocated by the host allocator may be dirty */
+        memset(data_new, 0, (size_t)data_size_new);
+#endif
+        wasm_deallocate_linear_memory(memory);
+
+        memory->memory_data = data_new;
+        memory->heap_data = data_new + heap_offset;
+        memory->heap_data_end = memory->heap_data + heap_size;
+#if defined(os_writegsbase)
+        /* write base addr of linear memory to GS segment register */
+        os_writegsbase(data_new);
+#endif
+    }
+    else if (data_size > 0)
+        memset(memory->memory_data, 0, (size_t)data_size);
+#endif
+
+    memory->cur_page_count = page_count;
+    SET_LINEAR_MEMORY_SIZE(memory, data_size);
+    memory->memory_data_end = memory->memory_data + data_size;
+    wasm_runtime_set_mem_bound_check_bytes(memory, data_size);
+    return true;
+
+fail:
+    /* Recreate an empty app heap, so that the instance can still be
+       deinstantiated */
+    if (heap_size > 0
+        && !mem_allocator_create_with_struct_and_pool(
+            memory->heap_handle, mem_allocator_get_heap_struct_size(),
+            memory->heap_data, heap_size))
+        LOG_ERROR("recreate app heap failed");
+    return false;
+}
+
+bool
+wasm_restore_app_heap(WASMMemoryInstance *memory, const void *heap_struct)
+{
+    uint32 heap_size = (uint32)(memory->heap_data_end - memory->heap_data);
+
+    if (heap_size == 0)
+        return true;
+
+    if (heap_struct
+        && mem_allocator_restore_heap_struct(
+            memory->heap_handle, heap_struct, memory->heap_data, heap_size))
+        return true;
+
+    /* Recreate an empty app heap, so that the instance can still be
+       deinstantiated */
+    if (!mem_allocator_create_with_struct_and_pool(
+            memory->heap_handle, mem_allocator_get_heap_struct_size(),
+            memory->heap_data, heap_size))
+        LOG_ERROR("recreate app heap failed");
+    return false;
+}
+#endif /* end of WASM_ENABLE_INSTANCE_RESET != 0 */
+
+#if WASM_ENABLE_SHARED_HEAP != 0
+bool
+wasm_shared_heap_init(void)
+{
+    if (os_mutex_init(&shared_heap_list_lock) != 0)
+        return false;
+    return true;
+}
+
+static void
+destroy_shared_heap(WASMSharedHeap *heap)
+{
+    mem_allocator_destroy(heap->heap_handle);
+    wasm_runtime_free(heap->heap_handle);
+    wasm_munmap_linear_memory(heap->base_addr, heap->size, heap->size);
+    wasm_runtime_free(heap);
+}
+
+void
+wasm_shared_heap_destroy(void)
+{
+    WASMSharedHeap *heap = shared_heap_list, *next;
+
+    while (heap) {
+        next = heap->next;
+        destroy_shared_heap(heap);
+        heap = next;
+    }
+    shared_heap_list = NULL;
+    os_mutex_destroy(&shared_heap_list_lock);
+}
+#endif /* end of WASM_ENABLE_SHARED_HEAP != 0 */
+
+wasm_shared_heap_t
+wasm_runtime_create_shared_heap(SharedHeapInitArgs *init_args)
+{
+#if WASM_ENABLE_SHARED_HEAP != 0
+    uint32 heap_struct_size = mem_allocator_get_heap_struct_size();
+    WASMSharedHeap *heap;
+    uint64 size;
+
+    if (!init_args || init_args->size == 0) {
+        LOG_WARNING("invalid shared heap size");
+        return NULL;
+    }
+
+    /* At least one wasm page is left for the linear memory */
+    size = align_as_and_cast(init_args->size, os_getpagesize());
+    if (size > SHARED_HEAP_END_OFF - DEFAULT_NUM_BYTES_PER_PAGE) {
+        LOG_WARNING("shared heap size is too large");
+        return NULL;
+    }
+
+    if (!(heap = wasm_runtime_malloc(sizeof(WASMSharedHeap)))) {
+        LOG_WARNING("allocate shared heap failed");
+        return NULL;
+    }
+    memset(heap, 0, sizeof(WASMSharedHeap));
+
+    if (!(heap->heap_handle = wasm_runtime_malloc(heap_struct_size))) {
+        LOG_WARNING("allocate shared heap failed");
+        goto fail1;
+    }
+
+    if (!(heap->base_addr = wasm_mmap_linear_memory(size, size))) {
+        LOG_WARNING("mmap shared heap failed");
+        goto fail2;
+    }
+
+    if (!mem_allocator_create_with_struct_and_pool(
+            heap->heap_handle, heap_struct_size, heap->base_addr,
+            (uint32)size)) {
+        LOG_WARNING("init shared heap failed");
+        goto fail3;
+    }
+
+    heap->size = size;
+    heap->start_off_mem32 = SHARED_HEAP_END_OFF - size;
+
+    os_mutex_lock(&shared_heap_list_lock);
+    heap->next = shared_heap_list;
+    shared_heap_list = heap;
+    os_mutex_unlock(&shared_heap_list_lock);
+
+    return heap;
+
+fail3:
+    wasm_munmap_linear_memory(heap->base_addr, size, size);
+fail2:
+    wasm_runtime_free(heap->heap_handle);
+fail1:
+    wasm_runtime_free(heap);
+    return NULL;
+#else
+    (void)init_args;
+    LOG_WARNING("shared heap isn't enabled in this build");
+    return NULL;
+#endif
+}
+
+bool
+wasm_runtime_destroy_shared_heap(wasm_shared_heap_t shared_heap)
+{
+#if WASM_ENABLE_SHARED_HEAP != 0
+    WASMSharedHeap **p_heap;
+
+    if (!shared_heap)
+        return false;
+
+    os_mutex_lock(&shared_heap_list_lock);
+    if (shared_heap->attached_count > 0) {
+        os_mutex_unlock(&shared_heap_list_lock);
+        LOG_WARNING("shared heap is still attached");
+        return false;
+    }
+    p_heap = &shared_heap_list;
+    while (*p_heap && *p_heap != shared_heap)
+        p_heap = &(*p_heap)->next;
+    bh_assert(*p_heap);
+    if (*p_heap)
+        *p_heap = shared_heap->next;
+    os_mutex_unlock(&shared_heap_list_lock);
+
+    destroy_shared_heap(shared_heap);
+    return true;
+#else
+    (void)shared_heap;
+    return false;
+#endif
+}
+
+bool
+wasm_runtime_attach_shared_heap(WASMModuleInstanceCommon *module_inst,
+                                wasm_shared_heap_t shared_heap)
+{
+#if WASM_ENABLE_SHARED_HEAP != 0
+    WASMModuleInstanceExtraCommon *e;
+    WASMMemoryInstance *memory;
+
+    if (!module_inst || !shared_heap)
+        return false;
+
+    e = get_module_inst_extra_common(module_inst);
+    if (e->shared_heap) {
+        LOG_WARNING("a shared heap is already attached");
+        return false;
+    }
+
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT
+        && !((AOTModule *)((AOTModuleInstance *)module_inst)->module)
+                ->has_shared_heap) {
+        LOG_WARNING("the AOT file isn't generated with shared heap enabled");
+        return false;
+    }
+#endif
+
+    memory = wasm_get_default_memory((WASMModuleInstance *)module_inst);
+    if (!memory) {
+        LOG_WARNING("the module instance has no linear memory");
+        return false;
+    }
+#if WASM_ENABLE_MEMORY64 != 0
+    if (memory->is_memory64) {
+        LOG_WARNING("shared heap isn't supported by memory64");
+        return false;
+    }
+#endif
+#if WASM_ENABLE_SHARED_MEMORY != 0
+    if (shared_memory_is_shared(memory)) {
+        LOG_WARNING("shared heap isn't supported by shared memory");
+        return false;
+    }
+#endif
+    if (memory->memory_data_size > shared_heap->start_off_mem32) {
+        LOG_WARNING("the linear memory overlaps the shared heap");
+        return false;
+    }
+
+    os_mutex_lock(&shared_heap_list_lock);
+    shared_heap->attached_count++;
+    os_mutex_unlock(&shared_heap_list_lock);
+
+    e->shared_heap = shared_heap;
+    e->shared_heap_base_addr_adj =
+        shared_heap->base_addr - shared_heap->start_off_mem32;
+    e->shared_heap_start_off = shared_heap->start_off_mem32;
+    return true;
+#else
+    (void)module_inst;
+    (void)shared_heap;
+    LOG_WARNING("shared heap isn't enabled in this build");
+    return false;
+#endif
+}
+
+void
+wasm_runtime_detach_shared_heap(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_SHARED_HEAP != 0
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst);
+
+    if (!e->shared_heap)
+        return;
+
+    os_mutex_lock(&shared_heap_list_lock);
+    e->shared_heap->attached_count--;
+    os_mutex_unlock(&shared_heap_list_lock);
+
+    e->shared_heap = NULL;
+    e->shared_heap_base_addr_adj = NULL;
+    e->shared_heap_start_off = UINT64_MAX;
+#else
+    (void)module_inst;
+#endif
+}
+
+uint64
+wasm_runtime_shared_heap_malloc(wasm_shared_heap_t shared_heap, uint64 size,
+                                void **p_native_addr)
+{
+#if WASM_ENABLE_SHARED_HEAP != 0
+    uint8 *addr = NULL;
+
+    if (shared_heap && size > 0 && size <= UINT32_MAX)
+        addr = mem_allocator_malloc(shared_heap->heap_handle, (uint32)size);
+
+    if (p_native_addr)
+        *p_native_addr = addr;
+    if (!addr)
+        return 0;
+    return shared_heap->start_off_mem32
+           + (uint64)(addr - shared_heap->base_addr);
+#else
+    (void)shared_heap;
+    (void)size;
+    if (p_native_addr)
+        *p_native_addr = NULL;
+    return 0;
+#endif
+}
+
+void
+wasm_runtime_shared_heap_free(wasm_shared_heap_t shared_heap, uint64 ptr)
+{
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (!shared_heap || ptr < shared_heap->start_off_mem32
+        || ptr >= SHARED_HEAP_END_OFF) {
+        LOG_WARNING("invalid shared heap address");
+        return;
+    }
+    mem_allocator_free(shared_heap->heap_handle,
+                       shared_heap->base_addr
+                           + (ptr - shared_heap->start_off_mem32));
+#else
+    (void)shared_heap;
+    (void)ptr;
+#endif
+}
@@ -51,6 +51,11 @@ wasm_runtime_memory_destroy();
 unsigned
 wasm_runtime_memory_pool_size();
 
+/* Return the blocks cached by the current thread to the runtime's
+   global heap pool, called before the thread exits */
+void
+wasm_memory_flush_thread_cache(void);
+
 void
 wasm_runtime_set_mem_bound_check_bytes(WASMMemoryInstance *memory,
                                        uint64 memory_data_size);
@@ -59,6 +64,14 @@ void
 wasm_runtime_set_enlarge_mem_error_callback(
     const enlarge_memory_error_callback_t callback, void *user_data);
 
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+bool
+wasm_linear_memory_pool_init(void);
+
+void
+wasm_linear_memory_pool_destroy(void);
+#endif
+
 void
 wasm_deallocate_linear_memory(WASMMemoryInstance *memory_inst);
 
@@ -68,6 +81,50 @@ wasm_allocate_linear_memory(uint8 **data, bool is_shared_memory,
                             uint64 init_page_count, uint64 max_page_count,
                             uint64 *memory_data_size);
 
+#if WASM_ENABLE_INSTANCE_RESET != 0
+/* Shrink the linear memory back to page_count pages and zero it, the
+   memory mustn't be shared. Its app heap is destroyed, if the reset
+   succeeds, the caller restores the memory content and then the heap
+   with wasm_restore_app_heap, otherwise the heap is recreated empty. */
+bool
+wasm_reset_linear_memory(WASMMemoryInstance *memory, uint32 page_count,
+                         uint64 data_size);
+
+/* Restore the app heap destroyed by wasm_reset_linear_memory from the
+   heap structure saved with the memory content, the heap is recreated
+   empty and false is returned if it can't be restored */
+bool
+wasm_restore_app_heap(WASMMemoryInstance *memory, const void *heap_struct);
+#endif
+
+#if WASM_ENABLE_SHARED_HEAP != 0
+typedef struct WASMSharedHeap {
+    struct WASMSharedHeap *next;
+    /* The allocator of the heap */
+    void *heap_handle;
+    uint8 *base_addr;
+    uint64 size;
+    /* The app offset of base_addr in the instances attached, the heap
+       ends at the top of the 32-bit app address space */
+    uint64 start_off_mem32;
+    /* The number of instances attached, protected by the heap list
+       lock */
+    uint32 attached_count;
+} WASMSharedHeap;
+
+bool
+wasm_shared_heap_init(void);
+
+void
+wasm_shared_heap_destroy(void);
+
+/* Whether the app address range [app_offset, app_offset + bytes) is in
+   the shared heap attached to the module instance */
+bool
+wasm_runtime_is_app_addr_in_shared_heap(WASMModuleInstanceCommon *module_inst,
+                                        uint64 app_offset, uint64 bytes);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,693 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_module_snapshot.h"
+#include "wasm_memory.h"
+#include "bh_log.h"
+#if WASM_ENABLE_INTERP != 0
+#include "../interpreter/wasm_runtime.h"
+#endif
+#if WASM_ENABLE_AOT != 0
+#include "../aot/aot_runtime.h"
+#endif
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+
+#if defined(__linux__) && defined(MFD_CLOEXEC) && defined(F_ADD_SEALS)
+#define SNAPSHOT_USE_MEMFD 1
+#else
+#define SNAPSHOT_USE_MEMFD 0
+#endif
+
+/* Map the memfd of the snapshot over the linear memory of the new
+   instance, which requires the linear memory to be a page aligned
+   mapping which isn't moved or resized by mremap */
+#if SNAPSHOT_USE_MEMFD != 0 && defined(OS_ENABLE_HW_BOUND_CHECK) \
+    && WASM_MEM_ALLOC_WITH_USAGE == 0
+#define SNAPSHOT_MAP_MEMORY 1
+#else
+#define SNAPSHOT_MAP_MEMORY 0
+#endif
+
+/* Lock to take the snapshot of a module only once */
+static korp_mutex snapshot_lock;
+
+static void
+set_error_buf(char *error_buf, uint32 error_buf_size, const char *string)
+{
+    if (error_buf != NULL)
+        snprintf(error_buf, error_buf_size, "%s", string);
+}
+
+static void *
+runtime_malloc(uint64 size, char *error_buf, uint32 error_buf_size)
+{
+    void *mem;
+
+    if (size >= UINT32_MAX || !(mem = wasm_runtime_malloc((uint32)size))) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create snapshot failed: allocate memory failed");
+        return NULL;
+    }
+
+    memset(mem, 0, (uint32)size);
+    return mem;
+}
+
+static WASMModuleSnapshot **
+get_module_snapshot_addr(WASMModuleCommon *module)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module->module_type == Wasm_Module_Bytecode)
+        return &((WASMModule *)module)->snapshot;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module->module_type == Wasm_Module_AoT)
+        return &((AOTModule *)module)->snapshot;
+#endif
+    return NULL;
+}
+
+static WASMModuleInstanceExtraCommon *
+get_module_inst_extra_common(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        return &((WASMModuleInstance *)module_inst)->e->common;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)module_inst)
+                     ->e)
+                    ->common;
+#endif
+    return NULL;
+}
+
+bool
+wasm_module_snapshot_init(void)
+{
+    if (os_mutex_init(&snapshot_lock) != 0)
+        return false;
+    return true;
+}
+
+void
+wasm_module_snapshot_destroy(void)
+{
+    os_mutex_destroy(&snapshot_lock);
+}
+
+void
+wasm_module_snapshot_delete(WASMModuleSnapshot *snapshot)
+{
+    uint32 i;
+
+    if (snapshot->image) {
+#if SNAPSHOT_USE_MEMFD != 0
+        if (snapshot->fd >= 0)
+            os_munmap(snapshot->image, snapshot->image_size);
+        else
+#endif
+            wasm_runtime_free(snapshot->image);
+    }
+#if SNAPSHOT_USE_MEMFD != 0
+    if (snapshot->fd >= 0)
+        close(snapshot->fd);
+#endif
+
+    if (snapshot->data_ranges)
+        wasm_runtime_free(snapshot->data_ranges);
+
+    if (snapshot->table_elems) {
+        for (i = 0; i < snapshot->table_count; i++) {
+            if (snapshot->table_elems[i])
+                wasm_runtime_free(snapshot->table_elems[i]);
+        }
+        wasm_runtime_free(snapshot->table_elems);
+    }
+    if (snapshot->table_sizes)
+        wasm_runtime_free(snapshot->table_sizes);
+    if (snapshot->global_data)
+        wasm_runtime_free(snapshot->global_data);
+    if (snapshot->data_dropped)
+        wasm_runtime_free(snapshot->data_dropped);
+    if (snapshot->elem_dropped)
+        wasm_runtime_free(snapshot->elem_dropped);
+    if (snapshot->init_func_name)
+        wasm_runtime_free(snapshot->init_func_name);
+    wasm_runtime_free(snapshot);
+}
+
+static bool
+check_module(WASMModuleCommon *module, char *error_buf, uint32 error_buf_size)
+{
+    wasm_import_t import_type;
+    int32 i, import_count = wasm_runtime_get_import_count(module);
+
+    for (i = 0; i < import_count; i++) {
+        wasm_runtime_get_import_type(module, i, &import_type);
+        if (import_type.kind != WASM_IMPORT_EXPORT_KIND_FUNC) {
+            set_error_buf(error_buf, error_buf_size,
+                          "create snapshot failed: importing memory, table "
+                          "or global isn't supported");
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool
+is_zero_data(const uint8 *data, uint64 size)
+{
+    const uint8 *end = data + size;
+
+    while (data < end && *data == 0)
+        data++;
+    return data == end;
+}
+
+/* Record the ranges of the non-zero pages of the memory data, only
+   which need to be saved and restored since the fresh linear memory
+   is zero filled */
+static bool
+save_data_ranges(WASMModuleSnapshot *snapshot, const uint8 *data,
+                 uint64 data_size, char *error_buf, uint32 error_buf_size)
+{
+    WASMSnapshotDataRange *ranges = NULL, *new_ranges;
+    uint64 page_size = os_getpagesize(), offset, size;
+    uint32 count = 0, capacity = 0;
+
+    for (offset = 0; offset < data_size; offset += page_size) {
+        size = data_size - offset < page_size ? data_size - offset : page_size;
+        if (is_zero_data(data + offset, size))
+            continue;
+
+        if (count > 0
+            && ranges[count - 1].offset + ranges[count - 1].size == offset) {
+            ranges[count - 1].size += size;
+            continue;
+        }
+
+        if (count == capacity) {
+            capacity = capacity == 0 ? 8 : capacity * 2;
+            if (!(new_ranges = runtime_malloc(sizeof(WASMSnapshotDataRange)
+                                                  * (uint64)capacity,
+                                              error_buf, error_buf_size))) {
+                if (ranges)
+                    wasm_runtime_free(ranges);
+                return false;
+            }
+            if (ranges) {
+                bh_memcpy_s(new_ranges,
+                            (uint32)sizeof(WASMSnapshotDataRange) * capacity,
+                            ranges,
+                            (uint32)sizeof(WASMSnapshotDataRange) * count);
+                wasm_runtime_free(ranges);
+            }
+            ranges = new_ranges;
+        }
+        ranges[count].offset = offset;
+        ranges[count].size = size;
+        count++;
+    }
+
+    snapshot->data_ranges = ranges;
+    snapshot->data_range_count = count;
+    return true;
+}
+
+#if SNAPSHOT_USE_MEMFD != 0
+static bool
+save_memory_to_memfd(WASMModuleSnapshot *snapshot, const uint8 *data,
+                     uint64 data_size)
+{
+    WASMSnapshotDataRange *range;
+    uint64 page_size = os_getpagesize();
+    uint32 i;
+    int fd;
+
+    snapshot->image_size = align_uint64(data_size, page_size);
+
+    if ((fd = memfd_create("wamr-snapshot", MFD_CLOEXEC | MFD_ALLOW_SEALING))
+        < 0)
+        return false;
+
+    if (ftruncate(fd, (off_t)snapshot->image_size) != 0)
+        goto fail;
+
+    /* The file is zero filled, only write the non-zero pages to keep
+       the file sparse */
+    for (i = 0; i < snapshot->data_range_count; i++) {
+        range = snapshot->data_ranges + i;
+        if (pwrite(fd, data + range->offset, (size_t)range->size,
+                   (off_t)range->offset)
+            != (ssize_t)range->size)
+            goto fail;
+    }
+
+    /* Seal the file so that the private mappings of it in the instances
+       always see the snapshot content */
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE)
+        != 0)
+        goto fail;
+
+    if (snapshot->image_size > 0) {
+        snapshot->image = mmap(NULL, (size_t)snapshot->image_size, PROT_READ,
+                               MAP_SHARED, fd, 0);
+        if (snapshot->image == MAP_FAILED) {
+            snapshot->image = NULL;
+            goto fail;
+        }
+    }
+
+    snapshot->fd = fd;
+    return true;
+fail:
+    close(fd);
+    return false;
+}
+#endif /* end of SNAPSHOT_USE_MEMFD != 0 */
+
+static bool
+save_memory(WASMModuleSnapshot *snapshot, WASMModuleInstance *module_inst,
+            char *error_buf, uint32 error_buf_size)
+{
+    WASMMemoryInstance *memory;
+
+    if (module_inst->memory_count == 0)
+        return true;
+
+    memory = module_inst->memories[0];
+    if (module_inst->memory_count > 1 || memory->is_shared_memory) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create snapshot failed: multiple memories or shared "
+                      "memory isn't supported");
+        return false;
+    }
+    if (memory->heap_data != memory->heap_data_end) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create snapshot failed: app heap isn't supported");
+        return false;
+    }
+
+    snapshot->memory_page_count = memory->cur_page_count;
+    snapshot->memory_data_size = memory->memory_data_size;
+
+    if (!save_data_ranges(snapshot, memory->memory_data,
+                          memory->memory_data_size, error_buf,
+                          error_buf_size))
+        return false;
+
+#if SNAPSHOT_USE_MEMFD != 0
+    if (save_memory_to_memfd(snapshot, memory->memory_data,
+                             memory->memory_data_size))
+        return true;
+    LOG_WARNING("create memfd for snapshot failed, copy the memory instead");
+#endif
+
+    snapshot->image_size = memory->memory_data_size;
+    if (snapshot->image_size > 0) {
+        if (!(snapshot->image = runtime_malloc(snapshot->image_size,
+                                               error_buf, error_buf_size)))
+            return false;
+        memcpy(snapshot->image, memory->memory_data,
+               (size_t)memory->memory_data_size);
+    }
+    return true;
+}
+
+#if WASM_ENABLE_BULK_MEMORY != 0 || WASM_ENABLE_REF_TYPES != 0
+static bool
+save_bitmap(uint8 **p_data, uint32 *p_size, const bh_bitmap *bitmap,
+            char *error_buf, uint32 error_buf_size)
+{
+    uint32 size;
+
+    if (!bitmap)
+        return true;
+
+    size = (uint32)((bitmap->end_index - bitmap->begin_index + 7) / 8);
+    if (size == 0)
+        return true;
+
+    if (!(*p_data = runtime_malloc(size, error_buf, error_buf_size)))
+        return false;
+    bh_memcpy_s(*p_data, size, bitmap->map, size);
+    *p_size = size;
+    return true;
+}
+#endif
+
+static bool
+save_instance(WASMModuleSnapshot *snapshot,
+              WASMModuleInstanceCommon *module_inst_comm, char *error_buf,
+              uint32 error_buf_size)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst_comm);
+    uint32 i;
+
+    if (!save_memory(snapshot, module_inst, error_buf, error_buf_size))
+        return false;
+
+    if (module_inst->global_data_size > 0) {
+        if (!(snapshot->global_data = runtime_malloc(
+                  module_inst->global_data_size, error_buf, error_buf_size)))
+            return false;
+        bh_memcpy_s(snapshot->global_data, module_inst->global_data_size,
+                    module_inst->global_data, module_inst->global_data_size);
+        snapshot->global_data_size = module_inst->global_data_size;
+    }
+
+    if (module_inst->table_count > 0) {
+        if (!(snapshot->table_sizes = runtime_malloc(
+                  sizeof(uint32) * (uint64)module_inst->table_count, error_buf,
+                  error_buf_size))
+            || !(snapshot->table_elems = runtime_malloc(
+                     sizeof(table_elem_type_t *)
+                         * (uint64)module_inst->table_count,
+                     error_buf, error_buf_size)))
+            return false;
+        snapshot->table_count = module_inst->table_count;
+
+        for (i = 0; i < module_inst->table_count; i++) {
+            WASMTableInstance *table = module_inst->tables[i];
+            uint64 size = sizeof(table_elem_type_t) * (uint64)table->cur_size;
+
+            /* The externref objects belong to the template instance */
+            if (table->elem_type == VALUE_TYPE_EXTERNREF) {
+                set_error_buf(error_buf, error_buf_size,
+                              "create snapshot failed: externref table "
+                              "isn't supported");
+                return false;
+            }
+
+            snapshot->table_sizes[i] = table->cur_size;
+            if (size > 0) {
+                if (!(snapshot->table_elems[i] =
+                          runtime_malloc(size, error_buf, error_buf_size)))
+                    return false;
+                bh_memcpy_s(snapshot->table_elems[i], (uint32)size,
+                            table->elems, (uint32)size);
+            }
+        }
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (!save_bitmap(&snapshot->data_dropped, &snapshot->data_dropped_size,
+                     e->data_dropped, error_buf, error_buf_size))
+        return false;
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (!save_bitmap(&snapshot->elem_dropped, &snapshot->elem_dropped_size,
+                     e->elem_dropped, error_buf, error_buf_size))
+        return false;
+#endif
+    (void)e;
+    return true;
+}
+
+static bool
+run_init_func(WASMModuleInstanceCommon *module_inst, const char *name,
+              uint32 stack_size, char *error_buf, uint32 error_buf_size)
+{
+    WASMFunctionInstanceCommon *func;
+    WASMExecEnv *exec_env;
+    bool ret;
+
+    if (!(func = wasm_runtime_lookup_function(module_inst, name))) {
+        snprintf(error_buf, error_buf_size,
+                 "create snapshot failed: lookup function %s failed", name);
+        return false;
+    }
+    if (wasm_func_get_param_count(func, module_inst) != 0
+        || wasm_func_get_result_count(func, module_inst) != 0) {
+        snprintf(error_buf, error_buf_size,
+                 "create snapshot failed: function %s shouldn't have "
+                 "params or results",
+                 name);
+        return false;
+    }
+
+    if (!(exec_env = wasm_runtime_create_exec_env(module_inst, stack_size))) {
+        set_error_buf(error_buf, error_buf_size,
+                      "create snapshot failed: create exec env failed");
+        return false;
+    }
+
+    if (!(ret = wasm_runtime_call_wasm(exec_env, func, 0, NULL))) {
+        snprintf(error_buf, error_buf_size,
+                 "create snapshot failed: call function %s failed: %s", name,
+                 wasm_runtime_get_exception(module_inst));
+    }
+
+    wasm_runtime_destroy_exec_env(exec_env);
+    return ret;
+}
+
+static WASMModuleSnapshot *
+create_snapshot(WASMModuleCommon *module, const InstantiationArgs *args,
+                char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleSnapshot *snapshot;
+    WASMModuleInstanceCommon *template_inst;
+    uint64 total_size;
+
+    if (!check_module(module, error_buf, error_buf_size))
+        return NULL;
+
+    if (!(snapshot = runtime_malloc(sizeof(WASMModuleSnapshot), error_buf,
+                                    error_buf_size)))
+        return NULL;
+    snapshot->fd = -1;
+
+    if (args->snapshot_init_func) {
+        total_size = strlen(args->snapshot_init_func) + 1;
+        if (!(snapshot->init_func_name =
+                  runtime_malloc(total_size, error_buf, error_buf_size)))
+            goto fail;
+        bh_memcpy_s(snapshot->init_func_name, (uint32)total_size,
+                    args->snapshot_init_func, (uint32)total_size);
+    }
+
+    /* Instantiate the template instance normally, which runs the data
+       and elem segment initialization and the start function */
+    if (!(template_inst = wasm_runtime_instantiate_internal(
+              module, NULL, NULL, args->default_stack_size, 0,
+              args->max_memory_pages, error_buf, error_buf_size)))
+        goto fail;
+
+    if (snapshot->init_func_name
+        && !run_init_func(template_inst, snapshot->init_func_name,
+                          args->default_stack_size, error_buf,
+                          error_buf_size)) {
+        wasm_runtime_deinstantiate_internal(template_inst, false);
+        goto fail;
+    }
+
+    if (!save_instance(snapshot, template_inst, error_buf, error_buf_size)) {
+        wasm_runtime_deinstantiate_internal(template_inst, false);
+        goto fail;
+    }
+
+    wasm_runtime_deinstantiate_internal(template_inst, false);
+    return snapshot;
+fail:
+    wasm_module_snapshot_delete(snapshot);
+    return NULL;
+}
+
+WASMModuleInstanceCommon *
+wasm_module_snapshot_instantiate(WASMModuleCommon *module,
+                                 const InstantiationArgs *args,
+                                 char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleSnapshot **p_snapshot = get_module_snapshot_addr(module);
+    WASMModuleSnapshot *snapshot;
+    const char *init_func = args->snapshot_init_func;
+
+    if (!p_snapshot) {
+        set_error_buf(error_buf, error_buf_size,
+                      "Instantiate module failed, invalid module type");
+        return NULL;
+    }
+
+    if (args->host_managed_heap_size > 0) {
+        set_error_buf(error_buf, error_buf_size,
+                      "Instantiate module failed, host managed heap isn't "
+                      "supported when instantiating from snapshot");
+        return NULL;
+    }
+
+    os_mutex_lock(&snapshot_lock);
+    if (!(snapshot = *p_snapshot)) {
+        if (!(snapshot = create_snapshot(module, args, error_buf,
+                                         error_buf_size))) {
+            os_mutex_unlock(&snapshot_lock);
+            return NULL;
+        }
+        *p_snapshot = snapshot;
+    }
+    os_mutex_unlock(&snapshot_lock);
+
+    /* The snapshot of a module is taken only once, a different init
+       function can't be used later */
+    if ((init_func == NULL) != (snapshot->init_func_name == NULL)
+        || (init_func && strcmp(init_func, snapshot->init_func_name) != 0)) {
+        set_error_buf(error_buf, error_buf_size,
+                      "Instantiate module failed, the snapshot was taken "
+                      "with a different init function");
+        return NULL;
+    }
+
+    return wasm_runtime_instantiate_from_snapshot(
+        module, snapshot, args->default_stack_size, args->max_memory_pages,
+        error_buf, error_buf_size);
+}
+
+static bool
+restore_memory(const WASMModuleSnapshot *snapshot,
+               WASMModuleInstance *module_inst, char *error_buf,
+               uint32 error_buf_size)
+{
+    WASMMemoryInstance *memory;
+    uint64 data_size = snapshot->memory_data_size, map_size = 0;
+#if WASM_MEM_ALLOC_WITH_USAGE == 0
+    WASMSnapshotDataRange *range;
+    uint64 begin, end;
+    uint32 i;
+#endif
+
+    if (module_inst->memory_count == 0)
+        return true;
+
+    memory = module_inst->memories[0];
+    if (memory->cur_page_count < snapshot->memory_page_count
+        && !wasm_enlarge_memory(module_inst, snapshot->memory_page_count
+                                                 - memory->cur_page_count)) {
+        set_error_buf(error_buf, error_buf_size,
+                      "restore snapshot failed: enlarge memory failed");
+        return false;
+    }
+    if (memory->memory_data_size != data_size) {
+        set_error_buf(error_buf, error_buf_size,
+                      "restore snapshot failed: memory size mismatch");
+        return false;
+    }
+
+#if SNAPSHOT_MAP_MEMORY != 0
+    /* Replace the zero pages of the fresh linear memory with a private
+       copy-on-write mapping of the memfd, only the pages written by
+       the instance are copied then */
+    if (snapshot->fd >= 0) {
+        map_size = data_size / os_getpagesize() * os_getpagesize();
+        if (map_size > 0
+            && mmap(memory->memory_data, (size_t)map_size,
+                    PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED,
+                    snapshot->fd, 0)
+                   == MAP_FAILED) {
+            set_error_buf(error_buf, error_buf_size,
+                          "restore snapshot failed: map memory failed");
+            return false;
+        }
+        memory->is_file_mapped = map_size > 0 ? 1 : 0;
+    }
+#endif
+
+#if WASM_MEM_ALLOC_WITH_USAGE == 0
+    /* The fresh linear memory is zero filled, only copy the non-zero
+       pages which haven't been mapped */
+    for (i = 0; i < snapshot->data_range_count; i++) {
+        range = snapshot->data_ranges + i;
+        begin = range->offset > map_size ? range->offset : map_size;
+        end = range->offset + range->size;
+        if (begin < end)
+            memcpy(memory->memory_data + begin, snapshot->image + begin,
+                   (size_t)(end - begin));
+    }
+#else
+    /* The linear memory allocated by the host allocator may be dirty */
+    memcpy(memory->memory_data, snapshot->image, (size_t)data_size);
+    (void)map_size;
+#endif
+    return true;
+}
+
+bool
+wasm_module_snapshot_apply(const WASMModuleSnapshot *snapshot,
+                           WASMModuleInstanceCommon *module_inst_comm,
+                           char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleInstance *module_inst = (WASMModuleInstance *)module_inst_comm;
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst_comm);
+    uint32 i;
+
+    if (!restore_memory(snapshot, module_inst, error_buf, error_buf_size))
+        return false;
+
+    bh_assert(module_inst->global_data_size == snapshot->global_data_size);
+    if (snapshot->global_data_size > 0)
+        bh_memcpy_s(module_inst->global_data, module_inst->global_data_size,
+                    snapshot->global_data, snapshot->global_data_size);
+
+    bh_assert(module_inst->table_count == snapshot->table_count);
+    for (i = 0; i < snapshot->table_count; i++) {
+        WASMTableInstance *table = module_inst->tables[i];
+        uint32 size = snapshot->table_sizes[i];
+
+        /* The table may have been grown by the start/init function */
+        if (size > table->max_size) {
+            set_error_buf(error_buf, error_buf_size,
+                          "restore snapshot failed: table size mismatch");
+            return false;
+        }
+        table->cur_size = size;
+        if (size > 0)
+            bh_memcpy_s(table->elems,
+                        (uint32)sizeof(table_elem_type_t) * table->max_size,
+                        snapshot->table_elems[i],
+                        (uint32)sizeof(table_elem_type_t) * size);
+    }
+
+#if WASM_ENABLE_BULK_MEMORY != 0
+    if (snapshot->data_dropped)
+        bh_memcpy_s(e->data_dropped->map, snapshot->data_dropped_size,
+                    snapshot->data_dropped, snapshot->data_dropped_size);
+#endif
+#if WASM_ENABLE_REF_TYPES != 0
+    if (snapshot->elem_dropped)
+        bh_memcpy_s(e->elem_dropped->map, snapshot->elem_dropped_size,
+                    snapshot->elem_dropped, snapshot->elem_dropped_size);
+#endif
+    (void)e;
+    return true;
+}
+
+bool
+wasm_module_snapshot_unmap_memory(WASMMemoryInstance *memory)
+{
+#if SNAPSHOT_MAP_MEMORY != 0
+    uint64 map_size =
+        memory->memory_data_size / os_getpagesize() * os_getpagesize();
+
+    /* The memory never shrinks, so the range covers the mapped file */
+    if (map_size > 0
+        && mmap(memory->memory_data, (size_t)map_size, PROT_READ | PROT_WRITE,
+                MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0)
+               == MAP_FAILED) {
+        LOG_WARNING("unmap the snapshot from the memory failed");
+        return false;
+    }
+    return true;
+#else
+    (void)memory;
+    return true;
+#endif
+}
+
+#endif /* end of WASM_ENABLE_MEMORY_SNAPSHOT != 0 */
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_MODULE_SNAPSHOT_H
+#define _WASM_MODULE_SNAPSHOT_H
+
+#include "bh_common.h"
+#include "wasm_runtime_common.h"
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct WASMMemoryInstance;
+
+typedef struct WASMSnapshotDataRange {
+    uint64 offset;
+    uint64 size;
+} WASMSnapshotDataRange;
+
+/**
+ * The state of a fully initialized module instance, taken once per module
+ * and used to instantiate the module again without running the data/elem
+ * segment initialization, the start function and the init function.
+ */
+typedef struct WASMModuleSnapshot {
+    /* The init function run before taking the snapshot, NULL if none */
+    char *init_func_name;
+
+    /* Page count and data size of the default memory, the memory data
+       is kept in a sealed memfd if possible, which is mapped privately
+       into the new instances, and image is the read-only mapping of it,
+       otherwise image is a copy of the memory data and fd is -1 */
+    uint32 memory_page_count;
+    uint64 memory_data_size;
+    uint64 image_size;
+    uint8 *image;
+    int fd;
+    /* The ranges of the non-zero pages of the memory data */
+    uint32 data_range_count;
+    WASMSnapshotDataRange *data_ranges;
+
+    uint32 global_data_size;
+    uint8 *global_data;
+
+    uint32 table_count;
+    /* The current size and elements of each table */
+    uint32 *table_sizes;
+    table_elem_type_t **table_elems;
+
+    uint32 data_dropped_size;
+    uint8 *data_dropped;
+    uint32 elem_dropped_size;
+    uint8 *elem_dropped;
+} WASMModuleSnapshot;
+
+bool
+wasm_module_snapshot_init(void);
+
+void
+wasm_module_snapshot_destroy(void);
+
+/**
+ * Instantiate the module from its snapshot, take the snapshot first
+ * if it hasn't been taken yet
+ */
+WASMModuleInstanceCommon *
+wasm_module_snapshot_instantiate(WASMModuleCommon *module,
+                                 const InstantiationArgs *args,
+                                 char *error_buf, uint32 error_buf_size);
+
+/**
+ * Restore the memory, globals and tables of a module instance which is
+ * being instantiated from the snapshot
+ */
+bool
+wasm_module_snapshot_apply(const WASMModuleSnapshot *snapshot,
+                           WASMModuleInstanceCommon *module_inst,
+                           char *error_buf, uint32 error_buf_size);
+
+void
+wasm_module_snapshot_delete(WASMModuleSnapshot *snapshot);
+
+/**
+ * Replace the pages of the snapshot mapped over the memory data with
+ * anonymous pages, so that they aren't read again from the snapshot
+ * when the memory is reused after its pages are decommitted
+ */
+bool
+wasm_module_snapshot_unmap_memory(struct WASMMemoryInstance *memory);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of WASM_ENABLE_MEMORY_SNAPSHOT != 0 */
+
+#endif /* end of _WASM_MODULE_SNAPSHOT_H */
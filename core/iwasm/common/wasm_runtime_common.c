@@ -21,6 +21,7 @@
 #endif
 #if WASM_ENABLE_GC != 0
 #include "gc/gc_object.h"
+#include "mem_alloc.h"
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
 #include "../libraries/thread-mgr/thread_manager.h"
@@ -31,6 +32,12 @@
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "wasm_shared_memory.h"
 #endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+#include "wasm_module_snapshot.h"
+#endif
+#if WASM_ENABLE_INSTANCE_RESET != 0
+#include "wasm_instance_reset.h"
+#endif
 #if WASM_ENABLE_FAST_JIT != 0
 #include "../fast-jit/jit_compiler.h"
 #endif
@@ -182,7 +189,48 @@ static RunningMode runtime_running_mode = Mode_Default;
 static os_thread_local_attribute WASMExecEnv *exec_env_tls = NULL;
 
 #ifndef BH_PLATFORM_WINDOWS
-static void
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+/* Handle the fault of the safepoint page, which is polled by the AOTed
+   code and made inaccessible to interrupt the thread. The fault is
+   raised synchronously by a plain load of the AOTed code, so it is safe
+   to take the locks and wait here. Return true if the thread should be
+   terminated, otherwise the faulting load is restarted. */
+static bool
+handle_safepoint(WASMExecEnv *exec_env)
+{
+#if WASM_ENABLE_THREAD_MGR != 0
+    bool terminate;
+#endif
+
+    /* Make the page readable before checking the flags, so that a
+       request raised after the check will fault again */
+    wasm_exec_env_disarm_safepoint(exec_env);
+
+#if WASM_ENABLE_THREAD_MGR != 0
+    os_mutex_lock(&exec_env->wait_lock);
+    /* Suspended by the thread manager, wait until it is resumed */
+    while (WASM_SUSPEND_FLAGS_GET(exec_env->suspend_flags)
+           & WASM_SUSPEND_FLAG_SUSPEND) {
+        os_cond_wait(&exec_env->wait_cond, &exec_env->wait_lock);
+    }
+    terminate = (WASM_SUSPEND_FLAGS_GET(exec_env->suspend_flags)
+                 & WASM_SUSPEND_FLAG_TERMINATE)
+                    ? true
+                    : false;
+    os_mutex_unlock(&exec_env->wait_lock);
+
+    if (terminate) {
+        /* Keep the page inaccessible, so that the wasm callers of the
+           native caller are also interrupted at their next safepoint */
+        wasm_exec_env_arm_safepoint(exec_env);
+        return true;
+    }
+#endif
+    return false;
+}
+#endif /* end of WASM_ENABLE_AOT_SAFEPOINT != 0 */
+
+static bool
 runtime_signal_handler(void *sig_addr)
 {
     WASMModuleInstance *module_inst;
@@ -237,7 +285,20 @@ runtime_signal_handler(void *sig_addr)
             bh_assert(wasm_copy_exception(module_inst, NULL));
             os_longjmp(jmpbuf_node->jmpbuf, 1);
         }
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+        else if (exec_env_tls->safepoint_page
+                 && exec_env_tls->safepoint_page <= (uint8 *)sig_addr
+                 && (uint8 *)sig_addr
+                        < exec_env_tls->safepoint_page + page_size) {
+            /* The address which causes segmentation fault is inside
+               the safepoint page, the thread is interrupted */
+            if (handle_safepoint(exec_env_tls))
+                os_longjmp(jmpbuf_node->jmpbuf, 1);
+            return true;
+        }
+#endif
     }
+    return false;
 }
 #else /* else of BH_PLATFORM_WINDOWS */
 
@@ -445,6 +506,71 @@ wasm_runtime_env_init()
         goto fail1;
     }
 
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    if (!wasm_module_snapshot_init()) {
+        wasm_native_destroy();
+        goto fail1;
+    }
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (!mem_allocator_init_nursery_list()) {
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+        wasm_module_snapshot_destroy();
+#endif
+        wasm_native_destroy();
+        goto fail1;
+    }
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (!mem_allocator_init_incremental_list()) {
+#if WASM_ENABLE_GC_NURSERY != 0
+        mem_allocator_destroy_nursery_list();
+#endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+        wasm_module_snapshot_destroy();
+#endif
+        wasm_native_destroy();
+        goto fail1;
+    }
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    if (!mem_allocator_init_mark_workers()) {
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        mem_allocator_destroy_incremental_list();
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+        mem_allocator_destroy_nursery_list();
+#endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+        wasm_module_snapshot_destroy();
+#endif
+        wasm_native_destroy();
+        goto fail1;
+    }
+#endif
+
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (!wasm_shared_heap_init()) {
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+        mem_allocator_destroy_mark_workers();
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        mem_allocator_destroy_incremental_list();
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+        mem_allocator_destroy_nursery_list();
+#endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+        wasm_module_snapshot_destroy();
+#endif
+        wasm_native_destroy();
+        goto fail1;
+    }
+#endif
+
 #if WASM_ENABLE_MULTI_MODULE
     if (BHT_OK != os_mutex_init(&registered_module_list_lock)) {
         goto fail2;
@@ -471,6 +597,11 @@ wasm_runtime_env_init()
     if (!runtime_signal_init()) {
         goto fail6;
     }
+
+    if (!wasm_linear_memory_pool_init()) {
+        runtime_signal_destroy();
+        goto fail6;
+    }
 #endif
 
 #if WASM_ENABLE_AOT != 0
@@ -536,6 +667,7 @@ fail7:
 #endif
 #endif
 #ifdef OS_ENABLE_HW_BOUND_CHECK
+    wasm_linear_memory_pool_destroy();
     runtime_signal_destroy();
 fail6:
 #endif
@@ -552,6 +684,21 @@ fail4:
 fail3:
     os_mutex_destroy(&registered_module_list_lock);
 fail2:
+#endif
+#if WASM_ENABLE_SHARED_HEAP != 0
+    wasm_shared_heap_destroy();
+#endif
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    mem_allocator_destroy_mark_workers();
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    mem_allocator_destroy_incremental_list();
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+    mem_allocator_destroy_nursery_list();
+#endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    wasm_module_snapshot_destroy();
 #endif
     wasm_native_destroy();
 fail1:
@@ -622,6 +769,10 @@ wasm_runtime_init()
 static void
 wasm_runtime_destroy_internal()
 {
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    wasm_sampling_profiler_destroy();
+#endif
+
 #if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
     wasm_externref_map_destroy();
 #endif
@@ -675,6 +826,33 @@ wasm_runtime_destroy_internal()
     thread_manager_destroy();
 #endif
 
+#ifdef OS_ENABLE_HW_BOUND_CHECK
+    /* Unmap the pooled linear memories after all the instances,
+       including the ones of the spawned threads, are destroyed */
+    wasm_linear_memory_pool_destroy();
+#endif
+
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* Release the shared heaps after all the instances are destroyed */
+    wasm_shared_heap_destroy();
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    mem_allocator_destroy_mark_workers();
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    mem_allocator_destroy_incremental_list();
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    mem_allocator_destroy_nursery_list();
+#endif
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    wasm_module_snapshot_destroy();
+#endif
+
     wasm_native_destroy();
     bh_platform_destroy();
 
@@ -779,8 +957,17 @@ wasm_runtime_full_init_internal(RuntimeInitArgs *init_args)
 
 #if WASM_ENABLE_THREAD_MGR != 0
     wasm_cluster_set_max_thread_num(init_args->max_thread_num);
+    wasm_cluster_set_thread_pool_size(init_args->thread_pool_size);
 #endif
 
+    if (init_args->linear_memory_pool_size > 0
+        && !wasm_runtime_set_linear_memory_pool(
+            init_args->linear_memory_pool_size,
+            init_args->linear_memory_keep_resident_size)) {
+        wasm_runtime_destroy();
+        return false;
+    }
+
     return true;
 }
 
@@ -1315,6 +1502,18 @@ wasm_runtime_set_max_thread_num(uint32 num)
 {
     wasm_cluster_set_max_thread_num(num);
 }
+
+void
+wasm_runtime_set_thread_pool_size(uint32 size)
+{
+    wasm_cluster_set_thread_pool_size(size);
+}
+
+void
+wasm_runtime_get_thread_pool_stats(thread_pool_stats_t *stats)
+{
+    wasm_cluster_get_thread_pool_stats(stats);
+}
 #endif /* end of WASM_ENABLE_THREAD_MGR */
 
 static WASMModuleCommon *
@@ -1388,6 +1587,34 @@ wasm_runtime_load_ex(uint8 *buf, uint32 size, const LoadArgs *args,
                                           error_buf_size);
 }
 
+WASMModuleCommon *
+wasm_runtime_load_aot_file_mapped(const char *file_path, const LoadArgs *args,
+                                  char *error_buf, uint32 error_buf_size)
+{
+    WASMModuleCommon *module_common = NULL;
+
+    if (!file_path || !args) {
+        return NULL;
+    }
+
+#if WASM_ENABLE_AOT != 0 && WASM_ENABLE_AOT_SHARED_TEXT != 0 \
+    && defined(OS_ENABLE_FILE_MAP)
+    module_common = (WASMModuleCommon *)aot_load_from_aot_file_mapped(
+        file_path, args, error_buf, error_buf_size);
+#else
+    set_error_buf(error_buf, error_buf_size,
+                  "WASM module load failed: AOT shared text isn't enabled "
+                  "or supported");
+#endif
+    if (!module_common) {
+        LOG_DEBUG("WASM module load failed");
+        return NULL;
+    }
+
+    return register_module_with_null_name(module_common, error_buf,
+                                          error_buf_size);
+}
+
 WASMModuleCommon *
 wasm_runtime_load(uint8 *buf, uint32 size, char *error_buf,
                   uint32 error_buf_size)
@@ -1488,30 +1715,57 @@ wasm_runtime_get_max_mem(uint32 max_memory_pages, uint32 module_init_page_count,
     return max_memory_pages;
 }
 
-WASMModuleInstanceCommon *
-wasm_runtime_instantiate_internal(WASMModuleCommon *module,
-                                  WASMModuleInstanceCommon *parent,
-                                  WASMExecEnv *exec_env_main, uint32 stack_size,
-                                  uint32 heap_size, uint32 max_memory_pages,
-                                  char *error_buf, uint32 error_buf_size)
+static WASMModuleInstanceCommon *
+instantiate_internal(WASMModuleCommon *module, WASMModuleInstanceCommon *parent,
+                     WASMExecEnv *exec_env_main, uint32 stack_size,
+                     uint32 heap_size, uint32 max_memory_pages,
+                     const struct WASMModuleSnapshot *snapshot, char *error_buf,
+                     uint32 error_buf_size)
 {
 #if WASM_ENABLE_INTERP != 0
     if (module->module_type == Wasm_Module_Bytecode)
         return (WASMModuleInstanceCommon *)wasm_instantiate(
             (WASMModule *)module, (WASMModuleInstance *)parent, exec_env_main,
-            stack_size, heap_size, max_memory_pages, error_buf, error_buf_size);
+            stack_size, heap_size, max_memory_pages, snapshot, error_buf,
+            error_buf_size);
 #endif
 #if WASM_ENABLE_AOT != 0
     if (module->module_type == Wasm_Module_AoT)
         return (WASMModuleInstanceCommon *)aot_instantiate(
             (AOTModule *)module, (AOTModuleInstance *)parent, exec_env_main,
-            stack_size, heap_size, max_memory_pages, error_buf, error_buf_size);
+            stack_size, heap_size, max_memory_pages, snapshot, error_buf,
+            error_buf_size);
 #endif
     set_error_buf(error_buf, error_buf_size,
                   "Instantiate module failed, invalid module type");
     return NULL;
 }
 
+WASMModuleInstanceCommon *
+wasm_runtime_instantiate_internal(WASMModuleCommon *module,
+                                  WASMModuleInstanceCommon *parent,
+                                  WASMExecEnv *exec_env_main, uint32 stack_size,
+                                  uint32 heap_size, uint32 max_memory_pages,
+                                  char *error_buf, uint32 error_buf_size)
+{
+    return instantiate_internal(module, parent, exec_env_main, stack_size,
+                                heap_size, max_memory_pages, NULL, error_buf,
+                                error_buf_size);
+}
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+WASMModuleInstanceCommon *
+wasm_runtime_instantiate_from_snapshot(
+    WASMModuleCommon *module, const struct WASMModuleSnapshot *snapshot,
+    uint32 stack_size, uint32 max_memory_pages, char *error_buf,
+    uint32 error_buf_size)
+{
+    return instantiate_internal(module, NULL, NULL, stack_size, 0,
+                                max_memory_pages, snapshot, error_buf,
+                                error_buf_size);
+}
+#endif
+
 WASMModuleInstanceCommon *
 wasm_runtime_instantiate(WASMModuleCommon *module, uint32 stack_size,
                          uint32 heap_size, char *error_buf,
@@ -1527,16 +1781,61 @@ wasm_runtime_instantiate_ex(WASMModuleCommon *module,
                             const InstantiationArgs *args, char *error_buf,
                             uint32 error_buf_size)
 {
-    return wasm_runtime_instantiate_internal(
-        module, NULL, NULL, args->default_stack_size,
-        args->host_managed_heap_size, args->max_memory_pages, error_buf,
-        error_buf_size);
+    WASMModuleInstanceCommon *module_inst;
+
+#if WASM_ENABLE_INSTANCE_RESET == 0
+    if (args->enable_reset) {
+        set_error_buf(error_buf, error_buf_size,
+                      "Instantiate module failed, instance reset isn't "
+                      "enabled, please rebuild with "
+                      "-DWAMR_BUILD_INSTANCE_RESET=1");
+        return NULL;
+    }
+#endif
+
+    if (args->enable_snapshot) {
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+        module_inst = wasm_module_snapshot_instantiate(module, args, error_buf,
+                                                       error_buf_size);
+#else
+        set_error_buf(error_buf, error_buf_size,
+                      "Instantiate module failed, memory snapshot isn't "
+                      "enabled, please rebuild with "
+                      "-DWAMR_BUILD_MEMORY_SNAPSHOT=1");
+        return NULL;
+#endif
+    }
+    else {
+        module_inst = wasm_runtime_instantiate_internal(
+            module, NULL, NULL, args->default_stack_size,
+            args->host_managed_heap_size, args->max_memory_pages, error_buf,
+            error_buf_size);
+    }
+
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    if (module_inst && args->enable_reset
+        && !wasm_instance_reset_capture(module_inst, error_buf,
+                                        error_buf_size)) {
+        wasm_runtime_deinstantiate_internal(module_inst, false);
+        return NULL;
+    }
+#endif
+
+    return module_inst;
 }
 
 void
 wasm_runtime_deinstantiate_internal(WASMModuleInstanceCommon *module_inst,
                                     bool is_sub_inst)
 {
+#if WASM_ENABLE_THREAD_MGR != 0
+    wasm_cluster_unregister_module_inst(module_inst);
+#endif
+
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    wasm_instance_reset_free(module_inst);
+#endif
+
 #if WASM_ENABLE_INTERP != 0
     if (module_inst->module_type == Wasm_Module_Bytecode) {
         wasm_deinstantiate((WASMModuleInstance *)module_inst, is_sub_inst);
@@ -1638,6 +1937,8 @@ wasm_runtime_init_thread_env(void)
 void
 wasm_runtime_destroy_thread_env(void)
 {
+    wasm_memory_flush_thread_cache();
+
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     runtime_signal_destroy();
 #endif
@@ -1984,6 +2285,51 @@ wasm_runtime_get_user_data(WASMExecEnv *exec_env)
     return exec_env->user_data;
 }
 
+bool
+wasm_runtime_set_fuel(WASMExecEnv *exec_env, uint64 fuel)
+{
+#if WASM_ENABLE_FUEL_METERING != 0
+    exec_env->fuel = fuel > INT64_MAX ? INT64_MAX : (int64)fuel;
+    return true;
+#else
+    (void)exec_env;
+    (void)fuel;
+    LOG_WARNING("fuel metering isn't enabled in this build");
+    return false;
+#endif
+}
+
+bool
+wasm_runtime_add_fuel(WASMExecEnv *exec_env, uint64 fuel)
+{
+#if WASM_ENABLE_FUEL_METERING != 0
+    /* The fuel is negative if the execution has run out of it */
+    uint64 remaining = exec_env->fuel > 0 ? (uint64)exec_env->fuel : 0;
+
+    if (fuel > (uint64)INT64_MAX - remaining)
+        exec_env->fuel = INT64_MAX;
+    else
+        exec_env->fuel = (int64)(remaining + fuel);
+    return true;
+#else
+    (void)exec_env;
+    (void)fuel;
+    LOG_WARNING("fuel metering isn't enabled in this build");
+    return false;
+#endif
+}
+
+uint64
+wasm_runtime_get_fuel(WASMExecEnv *exec_env)
+{
+#if WASM_ENABLE_FUEL_METERING != 0
+    return exec_env->fuel > 0 ? (uint64)exec_env->fuel : 0;
+#else
+    (void)exec_env;
+    return 0;
+#endif
+}
+
 #ifdef OS_ENABLE_HW_BOUND_CHECK
 void
 wasm_runtime_access_exce_check_guard_page()
@@ -2287,6 +2633,9 @@ wasm_runtime_call_wasm(WASMExecEnv *exec_env,
 #if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
     uint32 result_argc = 0;
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    WASMExecEnv *prev_sampling_exec_env;
+#endif
 
     if (!wasm_runtime_exec_env_check(exec_env)) {
         LOG_ERROR("Invalid exec env stack info.");
@@ -2306,6 +2655,9 @@ wasm_runtime_call_wasm(WASMExecEnv *exec_env,
     param_argc = argc;
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    prev_sampling_exec_env = wasm_sampling_profiler_enter(exec_env);
+#endif
 #if WASM_ENABLE_INTERP != 0
     if (exec_env->module_inst->module_type == Wasm_Module_Bytecode)
         ret = wasm_call_function(exec_env, (WASMFunctionInstance *)function,
@@ -2315,6 +2667,9 @@ wasm_runtime_call_wasm(WASMExecEnv *exec_env,
     if (exec_env->module_inst->module_type == Wasm_Module_AoT)
         ret = aot_call_function(exec_env, (AOTFunctionInstance *)function,
                                 param_argc, new_argv);
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    wasm_sampling_profiler_leave(prev_sampling_exec_env);
 #endif
     if (!ret) {
         if (new_argv != argv) {
@@ -2783,6 +3138,7 @@ static const char *exception_msgs[] = {
     "create stringview failed",       /* EXCE_FAILED_TO_CREATE_STRINGVIEW */
     "encode failed",                  /* EXCE_FAILED_TO_ENCODE_STRING */
     "",                               /* EXCE_ALREADY_THROWN */
+    "out of fuel",                    /* EXCE_OUT_OF_FUEL */
 };
 /* clang-format on */
 
@@ -5733,11 +6089,519 @@ fail:
                  || defined(BUILD_TARGET_RISCV64_LP64D) \
                  || defined(BUILD_TARGET_RISCV64_LP64) */
 
+/**
+ * Implementation of the compiled native calls
+ */
+
+#if defined(BUILD_TARGET_X86_64) || defined(BUILD_TARGET_AMD_64)            \
+    || defined(BUILD_TARGET_AARCH64) || defined(BUILD_TARGET_RISCV64_LP64D) \
+    || defined(BUILD_TARGET_RISCV64_LP64)
+/* The arguments are placed into the buffer of invokeNative when the
+   native is linked, the layout is the same as wasm_runtime_invoke_native:
+   float registers, int registers and then the stack */
+#define NATIVE_CALL_ARGS_PLACED 1
+
+#if defined(BUILD_TARGET_RISCV64_LP64)
+/* The float arguments are passed in the int registers */
+#define NATIVE_FLOAT_REG_SLOTS 1
+#define NATIVE_INT_REG_BASE 0
+#elif WASM_ENABLE_SIMD != 0
+#define NATIVE_FLOAT_REG_SLOTS 2
+#define NATIVE_INT_REG_BASE (MAX_REG_FLOATS * 2)
+#else
+#define NATIVE_FLOAT_REG_SLOTS 1
+#define NATIVE_INT_REG_BASE MAX_REG_FLOATS
+#endif
+#define NATIVE_STACK_BASE (NATIVE_INT_REG_BASE + MAX_REG_INTS)
+
+#if WASM_ENABLE_MEMORY64 != 0
+/* The app addresses are i64 arguments */
+#define NATIVE_APP_ADDR_CELLS 2
+#define GET_NATIVE_APP_ADDR(argv) ((uint64)GET_I64_FROM_ADDR(argv))
+#else
+#define NATIVE_APP_ADDR_CELLS 1
+#define GET_NATIVE_APP_ADDR(argv) ((uint64)*(argv))
+#endif
+
+enum {
+    /* 32-bit argument, zero-extended to the 64-bit slot */
+    NATIVE_ARG_I32 = 0,
+    NATIVE_ARG_I64,
+    NATIVE_ARG_V128,
+    /* '*' argument, at least 1 byte is checked */
+    NATIVE_ARG_APP_ADDR,
+    /* '*~' argument, the size checked is the next argument */
+    NATIVE_ARG_APP_BUF,
+    /* '$' argument */
+    NATIVE_ARG_APP_STR,
+    /* externref index converted to the host object */
+    NATIVE_ARG_EXTERNREF,
+};
+
+enum {
+    NATIVE_RET_VOID = 0,
+    NATIVE_RET_I32,
+    NATIVE_RET_I64,
+    NATIVE_RET_F32,
+    NATIVE_RET_F64,
+    NATIVE_RET_V128,
+    /* host object converted to an externref index */
+    NATIVE_RET_EXTERNREF,
+};
+
+typedef struct NativeArgMove {
+    uint8 kind;
+    /* Cell index of the argument in the wasm arguments */
+    uint32 src;
+    /* Slot index of the argument in the buffer of invokeNative */
+    uint32 dst;
+} NativeArgMove;
+#endif /* end of defined(BUILD_TARGET_X86_64)           \
+                 || defined(BUILD_TARGET_AMD_64)        \
+                 || defined(BUILD_TARGET_AARCH64)       \
+                 || defined(BUILD_TARGET_RISCV64_LP64D) \
+                 || defined(BUILD_TARGET_RISCV64_LP64) */
+
+typedef struct WASMNativeCallDesc {
+    /* The quick entry of the function type, which calls the native
+       directly if it has no app address arguments */
+    void *quick_entry;
+#ifdef NATIVE_CALL_ARGS_PLACED
+    uint8 ret_kind;
+    bool has_app_addr;
+    /* Slot count of the buffer of invokeNative, and the slots of it
+       passed in the stack */
+    uint32 slot_count;
+    uint32 n_stacks;
+    uint32 move_count;
+    NativeArgMove moves[1];
+#endif
+} WASMNativeCallDesc;
+
+#ifdef NATIVE_CALL_ARGS_PLACED
+static uint8
+get_native_arg_kind(const char *signature, uint32 param_idx, uint8 kind)
+{
+    if (signature) {
+        if (signature[param_idx + 1] == '*')
+            return signature[param_idx + 2] == '~' ? NATIVE_ARG_APP_BUF
+                                                   : NATIVE_ARG_APP_ADDR;
+        if (signature[param_idx + 1] == '$')
+            return NATIVE_ARG_APP_STR;
+    }
+    return kind;
+}
+
+static bool
+create_native_call_desc(const WASMFuncType *func_type, const char *signature,
+                        WASMNativeCallDesc **p_call_desc)
+{
+    WASMNativeCallDesc *call_desc;
+    NativeArgMove *move;
+    uint32 param_count = func_type->param_count;
+    uint32 result_count = func_type->result_count;
+    uint32 ext_ret_count = result_count > 1 ? result_count - 1 : 0;
+    uint32 n_ints = 1 /* exec_env */, n_stacks = 0, src = 0, cell_num, i;
+    uint32 *p_n_floats;
+    uint64 size;
+    bool is_float;
+#if !defined(_WIN32) && !defined(_WIN32_) \
+    && !defined(BUILD_TARGET_RISCV64_LP64)
+    uint32 n_floats = 0;
+    p_n_floats = &n_floats;
+#else
+    /* The float arguments take the positions of the int registers */
+    p_n_floats = &n_ints;
+#endif
+
+    size = offsetof(WASMNativeCallDesc, moves)
+           + sizeof(NativeArgMove) * (uint64)(param_count + ext_ret_count);
+    if (!(call_desc = runtime_malloc(size, NULL, NULL, 0)))
+        return false;
+
+    for (i = 0; i < param_count + ext_ret_count; i++) {
+        move = call_desc->moves + i;
+        move->kind = NATIVE_ARG_I64;
+        move->src = src;
+        cell_num = 2;
+        is_float = false;
+
+        /* The extra result values' addresses are 64-bit arguments */
+        if (i < param_count) {
+            switch (func_type->types[i]) {
+                case VALUE_TYPE_I32:
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+                case VALUE_TYPE_FUNCREF:
+#endif
+                    cell_num = 1;
+#if WASM_ENABLE_MEMORY64 == 0
+                    move->kind =
+                        get_native_arg_kind(signature, i, NATIVE_ARG_I32);
+#else
+                    move->kind = NATIVE_ARG_I32;
+#endif
+                    break;
+                case VALUE_TYPE_I64:
+#if WASM_ENABLE_MEMORY64 != 0
+                    move->kind =
+                        get_native_arg_kind(signature, i, NATIVE_ARG_I64);
+#endif
+                    break;
+                case VALUE_TYPE_F32:
+                    move->kind = NATIVE_ARG_I32;
+                    cell_num = 1;
+                    is_float = true;
+                    break;
+                case VALUE_TYPE_F64:
+                    is_float = true;
+                    break;
+#if WASM_ENABLE_SIMD != 0
+                case VALUE_TYPE_V128:
+                    move->kind = NATIVE_ARG_V128;
+                    cell_num = 4;
+                    is_float = true;
+                    break;
+#endif
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+                case VALUE_TYPE_EXTERNREF:
+                    /* The index is passed as is if there is no signature,
+                       the same as wasm_runtime_invoke_native */
+                    move->kind =
+                        signature ? NATIVE_ARG_EXTERNREF : NATIVE_ARG_I32;
+                    cell_num = 1;
+                    break;
+#endif
+                default:
+                    /* The GC references are passed as 64-bit pointers */
+#if WASM_ENABLE_GC == 0
+                    bh_assert(0);
+#endif
+                    break;
+            }
+        }
+        src += cell_num;
+
+        if (move->kind >= NATIVE_ARG_APP_ADDR
+            && move->kind <= NATIVE_ARG_APP_STR)
+            call_desc->has_app_addr = true;
+
+        if (is_float) {
+            if (*p_n_floats < MAX_REG_FLOATS) {
+                move->dst = NATIVE_FLOAT_REG_SLOTS * (*p_n_floats)++;
+            }
+            else {
+                move->dst = NATIVE_STACK_BASE + n_stacks;
+                n_stacks += move->kind == NATIVE_ARG_V128 ? 2 : 1;
+            }
+        }
+        else if (n_ints < MAX_REG_INTS)
+            move->dst = NATIVE_INT_REG_BASE + n_ints++;
+        else
+            move->dst = NATIVE_STACK_BASE + n_stacks++;
+    }
+
+    call_desc->move_count = param_count + ext_ret_count;
+    call_desc->n_stacks = n_stacks;
+    call_desc->slot_count = NATIVE_STACK_BASE + n_stacks;
+
+    if (result_count > 0) {
+        switch (func_type->types[param_count]) {
+            case VALUE_TYPE_I32:
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+            case VALUE_TYPE_FUNCREF:
+#endif
+                call_desc->ret_kind = NATIVE_RET_I32;
+                break;
+            case VALUE_TYPE_F32:
+                call_desc->ret_kind = NATIVE_RET_F32;
+                break;
+            case VALUE_TYPE_F64:
+                call_desc->ret_kind = NATIVE_RET_F64;
+                break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                call_desc->ret_kind = NATIVE_RET_V128;
+                break;
+#endif
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+            case VALUE_TYPE_EXTERNREF:
+                call_desc->ret_kind =
+                    signature ? NATIVE_RET_EXTERNREF : NATIVE_RET_I32;
+                break;
+#endif
+            default:
+                /* i64 and the GC references */
+                call_desc->ret_kind = NATIVE_RET_I64;
+                break;
+        }
+    }
+
+    *p_call_desc = call_desc;
+    return true;
+}
+
+/* Check an app address argument and convert it to the native address,
+   the default memory is checked directly and the other cases, e.g. the
+   address in the shared heap or the errors, are left to the full check */
+static inline bool
+native_app_addr_to_native(WASMModuleInstanceCommon *module_inst,
+                          WASMMemoryInstance *memory, uint64 app_offset,
+                          uint64 size, uint64 *p_native_addr)
+{
+    uint64 memory_data_size;
+
+    if (memory) {
+        memory_data_size = GET_LINEAR_MEMORY_SIZE(memory);
+        if (app_offset < memory_data_size
+            && size <= memory_data_size - app_offset) {
+            *p_native_addr =
+                (uint64)(uintptr_t)(memory->memory_data + app_offset);
+            return true;
+        }
+    }
+
+    if (!wasm_runtime_validate_app_addr(module_inst, app_offset, size))
+        return false;
+
+    *p_native_addr = (uint64)(uintptr_t)wasm_runtime_addr_app_to_native(
+        module_inst, app_offset);
+    return true;
+}
+
+static inline bool
+native_app_str_to_native(WASMModuleInstanceCommon *module_inst,
+                         WASMMemoryInstance *memory, uint64 app_offset,
+                         uint64 *p_native_addr)
+{
+    uint64 memory_data_size;
+
+    if (memory) {
+        memory_data_size = GET_LINEAR_MEMORY_SIZE(memory);
+        if (app_offset < memory_data_size
+            && memchr(memory->memory_data + app_offset, '\0',
+                      (size_t)(memory_data_size - app_offset))) {
+            *p_native_addr =
+                (uint64)(uintptr_t)(memory->memory_data + app_offset);
+            return true;
+        }
+    }
+
+    if (!wasm_runtime_validate_app_str_addr(module_inst, app_offset))
+        return false;
+
+    *p_native_addr = (uint64)(uintptr_t)wasm_runtime_addr_app_to_native(
+        module_inst, app_offset);
+    return true;
+}
+#endif /* end of NATIVE_CALL_ARGS_PLACED */
+
+bool
+wasm_runtime_create_native_call_desc(const WASMFuncType *func_type,
+                                     const char *signature,
+                                     WASMNativeCallDesc **p_call_desc)
+{
+    void *quick_entry = NULL;
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
+    uint32 i;
+#endif
+
+    *p_call_desc = NULL;
+
+#if WASM_ENABLE_QUICK_AOT_ENTRY != 0
+    /* The quick entries take the app addresses as i32 arguments */
+    for (i = 0; signature && signature[i] != '\0'; i++) {
+        if (signature[i] == '*' || signature[i] == '$')
+            break;
+    }
+    if (!signature || signature[i] == '\0')
+        quick_entry = wasm_native_lookup_quick_aot_entry(func_type);
+#endif
+
+#ifdef NATIVE_CALL_ARGS_PLACED
+    if (!create_native_call_desc(func_type, signature, p_call_desc))
+        return false;
+#else
+    if (quick_entry
+        && !(*p_call_desc =
+                 runtime_malloc(sizeof(WASMNativeCallDesc), NULL, NULL, 0)))
+        return false;
+    (void)func_type;
+    (void)signature;
+#endif
+
+    if (*p_call_desc)
+        (*p_call_desc)->quick_entry = quick_entry;
+    return true;
+}
+
+void
+wasm_runtime_destroy_native_call_desc(WASMNativeCallDesc *call_desc)
+{
+    wasm_runtime_free(call_desc);
+}
+
+#if defined(__GNUC__) || defined(__clang__)
+__attribute__((no_sanitize_address))
+#endif
+bool
+wasm_runtime_invoke_native_desc(WASMExecEnv *exec_env, void *func_ptr,
+                                const WASMNativeCallDesc *call_desc,
+                                void *attachment, uint32 *argv,
+                                uint32 *argv_ret)
+{
+    WASMModuleInstanceCommon *module = wasm_runtime_get_module_inst(exec_env);
+#ifdef NATIVE_CALL_ARGS_PLACED
+    WASMMemoryInstance *memory = NULL;
+    const NativeArgMove *move = call_desc->moves;
+    const NativeArgMove *move_end = move + call_desc->move_count;
+    uint64 argv_buf[32], *argv1 = argv_buf, size;
+    uint32 n_stacks = call_desc->n_stacks;
+    bool ret = false;
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+    void *externref_obj = NULL;
+    uint32 externref_idx;
+#endif
+#endif
+
+    if (call_desc->quick_entry) {
+        void (*invoke_native)(void *func_ptr, void *exec_env, uint32 *argv,
+                              uint32 *argv_ret) = call_desc->quick_entry;
+
+        exec_env->attachment = attachment;
+        invoke_native(func_ptr, exec_env, argv, argv_ret);
+        exec_env->attachment = NULL;
+        return !wasm_runtime_copy_exception(module, NULL);
+    }
+
+#ifdef NATIVE_CALL_ARGS_PLACED
+    if (call_desc->slot_count > sizeof(argv_buf) / sizeof(uint64)) {
+        size = sizeof(uint64) * (uint64)call_desc->slot_count;
+        if (!(argv1 = runtime_malloc(size, module, NULL, 0)))
+            return false;
+    }
+
+    if (call_desc->has_app_addr)
+        memory = wasm_get_default_memory((WASMModuleInstance *)module);
+
+    argv1[NATIVE_INT_REG_BASE] = (uint64)(uintptr_t)exec_env;
+
+    for (; move < move_end; move++) {
+        switch (move->kind) {
+            case NATIVE_ARG_I32:
+                argv1[move->dst] = argv[move->src];
+                break;
+            case NATIVE_ARG_I64:
+                argv1[move->dst] = (uint64)GET_I64_FROM_ADDR(argv + move->src);
+                break;
+            case NATIVE_ARG_APP_ADDR:
+                if (!native_app_addr_to_native(
+                        module, memory, GET_NATIVE_APP_ADDR(argv + move->src),
+                        1, argv1 + move->dst))
+                    goto fail;
+                break;
+            case NATIVE_ARG_APP_BUF:
+                if (!native_app_addr_to_native(
+                        module, memory, GET_NATIVE_APP_ADDR(argv + move->src),
+                        argv[move->src + NATIVE_APP_ADDR_CELLS],
+                        argv1 + move->dst))
+                    goto fail;
+                break;
+            case NATIVE_ARG_APP_STR:
+                if (!native_app_str_to_native(
+                        module, memory, GET_NATIVE_APP_ADDR(argv + move->src),
+                        argv1 + move->dst))
+                    goto fail;
+                break;
+#if WASM_ENABLE_SIMD != 0
+            case NATIVE_ARG_V128:
+                bh_memcpy_s(argv1 + move->dst, sizeof(uint64) * 2,
+                            argv + move->src, sizeof(uint32) * 4);
+                break;
+#endif
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+            case NATIVE_ARG_EXTERNREF:
+                if (!wasm_externref_ref2obj(argv[move->src], &externref_obj))
+                    goto fail;
+                argv1[move->dst] = (uint64)(uintptr_t)externref_obj;
+                break;
+#endif
+            default:
+                bh_assert(0);
+                break;
+        }
+    }
+
+    exec_env->attachment = attachment;
+    switch (call_desc->ret_kind) {
+        case NATIVE_RET_VOID:
+            invokeNative_Void(func_ptr, argv1, n_stacks);
+            break;
+        case NATIVE_RET_I32:
+            argv_ret[0] = (uint32)invokeNative_Int32(func_ptr, argv1, n_stacks);
+            break;
+        case NATIVE_RET_I64:
+            PUT_I64_TO_ADDR(argv_ret,
+                            invokeNative_Int64(func_ptr, argv1, n_stacks));
+            break;
+        case NATIVE_RET_F32:
+            *(float32 *)argv_ret =
+                invokeNative_Float32(func_ptr, argv1, n_stacks);
+            break;
+        case NATIVE_RET_F64:
+            PUT_F64_TO_ADDR(argv_ret,
+                            invokeNative_Float64(func_ptr, argv1, n_stacks));
+            break;
+#if WASM_ENABLE_SIMD != 0
+        case NATIVE_RET_V128:
+            *(v128 *)argv_ret = invokeNative_V128(func_ptr, argv1, n_stacks);
+            break;
+#endif
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+        case NATIVE_RET_EXTERNREF:
+            externref_obj = (void *)(uintptr_t)invokeNative_Int64(
+                func_ptr, argv1, n_stacks);
+            break;
+#endif
+        default:
+            bh_assert(0);
+            break;
+    }
+    exec_env->attachment = NULL;
+
+#if WASM_ENABLE_GC == 0 && WASM_ENABLE_REF_TYPES != 0
+    if (call_desc->ret_kind == NATIVE_RET_EXTERNREF) {
+        if (!wasm_externref_obj2ref(module, externref_obj, &externref_idx))
+            goto fail;
+        argv_ret[0] = externref_idx;
+    }
+#endif
+
+    ret = !wasm_runtime_copy_exception(module, NULL);
+
+fail:
+    if (argv1 != argv_buf)
+        wasm_runtime_free(argv1);
+    return ret;
+#else
+    /* Only the calls through the quick entries are compiled */
+    bh_assert(0);
+    (void)module;
+    (void)func_ptr;
+    (void)attachment;
+    (void)argv;
+    (void)argv_ret;
+    return false;
+#endif /* end of NATIVE_CALL_ARGS_PLACED */
+}
+
 bool
 wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
                            uint32 argc, uint32 argv[])
 {
     bool ret = false;
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    WASMExecEnv *prev_sampling_exec_env;
+#endif
 
     if (!wasm_runtime_exec_env_check(exec_env)) {
         LOG_ERROR("Invalid exec env stack info.");
@@ -5748,6 +6612,9 @@ wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
        exec_env->native_stack_boundary must have been set, we don't set
        it again */
 
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    prev_sampling_exec_env = wasm_sampling_profiler_enter(exec_env);
+#endif
 #if WASM_ENABLE_INTERP != 0
     if (exec_env->module_inst->module_type == Wasm_Module_Bytecode)
         ret = wasm_call_indirect(exec_env, 0, element_index, argc, argv);
@@ -5756,6 +6623,9 @@ wasm_runtime_call_indirect(WASMExecEnv *exec_env, uint32 element_index,
     if (exec_env->module_inst->module_type == Wasm_Module_AoT)
         ret = aot_call_indirect(exec_env, 0, element_index, argc, argv);
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    wasm_sampling_profiler_leave(prev_sampling_exec_env);
+#endif
 
     return ret;
 }
@@ -5835,6 +6705,7 @@ wasm_runtime_thread_routine(void *arg)
     wasm_runtime_destroy_spawned_exec_env(thread_arg->new_exec_env);
     wasm_runtime_free(thread_arg);
 
+    wasm_memory_flush_thread_cache();
     os_thread_exit(ret);
     return ret;
 }
@@ -7400,6 +8271,11 @@ wasm_runtime_is_underlying_binary_freeable(WASMModuleCommon *const module)
         /* Fast interpreter mode */
         if (!((WASMModule *)module)->is_binary_freeable)
             return false;
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        /* The function bodies not prepared yet refer to the buffer */
+        if (((WASMModule *)module)->is_lazy_func_validation)
+            return false;
+#endif
 #if WASM_ENABLE_GC != 0 && WASM_ENABLE_STRINGREF != 0
         if (((WASMModule *)module)->string_literal_ptrs)
             return false;
@@ -7420,3 +8296,27 @@ wasm_runtime_is_underlying_binary_freeable(WASMModuleCommon *const module)
 
     return true;
 }
+
+WASM_RUNTIME_API_EXTERN uint32
+wasm_runtime_get_prepared_func_count(WASMModuleCommon *const module)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module->module_type == Wasm_Module_Bytecode) {
+        WASMModule *wasm_module = (WASMModule *)module;
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        uint32 prepared_func_count;
+
+        if (wasm_module->is_lazy_func_validation) {
+            os_mutex_lock(&wasm_module->lazy_prepare_lock);
+            prepared_func_count = wasm_module->prepared_func_count;
+            os_mutex_unlock(&wasm_module->lazy_prepare_lock);
+            return prepared_func_count;
+        }
+#endif
+        return wasm_module->function_count;
+    }
+#endif
+
+    (void)module;
+    return 0;
+}
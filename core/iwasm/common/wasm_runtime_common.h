@@ -555,6 +555,11 @@ WASM_RUNTIME_API_EXTERN WASMModuleCommon *
 wasm_runtime_load(uint8 *buf, uint32 size, char *error_buf,
                   uint32 error_buf_size);
 
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN WASMModuleCommon *
+wasm_runtime_load_aot_file_mapped(const char *file_path, const LoadArgs *args,
+                                  char *error_buf, uint32 error_buf_size);
+
 /* See wasm_export.h for description */
 WASM_RUNTIME_API_EXTERN WASMModuleCommon *
 wasm_runtime_load_from_sections(WASMSection *section_list, bool is_aot,
@@ -577,6 +582,18 @@ wasm_runtime_instantiate_internal(WASMModuleCommon *module,
                                   uint32 heap_size, uint32 max_memory_pages,
                                   char *error_buf, uint32 error_buf_size);
 
+/* See wasm_module_snapshot.h */
+struct WASMModuleSnapshot;
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+/* Internal API */
+WASMModuleInstanceCommon *
+wasm_runtime_instantiate_from_snapshot(
+    WASMModuleCommon *module, const struct WASMModuleSnapshot *snapshot,
+    uint32 stack_size, uint32 max_memory_pages, char *error_buf,
+    uint32 error_buf_size);
+#endif
+
 /* Internal API */
 void
 wasm_runtime_deinstantiate_internal(WASMModuleInstanceCommon *module_inst,
@@ -673,6 +690,18 @@ wasm_runtime_set_user_data(WASMExecEnv *exec_env, void *user_data);
 WASM_RUNTIME_API_EXTERN void *
 wasm_runtime_get_user_data(WASMExecEnv *exec_env);
 
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_fuel(WASMExecEnv *exec_env, uint64 fuel);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_add_fuel(WASMExecEnv *exec_env, uint64 fuel);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN uint64
+wasm_runtime_get_fuel(WASMExecEnv *exec_env);
+
 #if WASM_CONFIGURABLE_BOUNDS_CHECKS != 0
 /* See wasm_export.h for description */
 WASM_RUNTIME_API_EXTERN void
@@ -1097,6 +1126,25 @@ wasm_runtime_invoke_native_raw(WASMExecEnv *exec_env, void *func_ptr,
                                const char *signature, void *attachment,
                                uint32 *argv, uint32 argc, uint32 *ret);
 
+/* Compile the argument checks and placement of a native function from
+   its type and signature, which is done once when the import is linked.
+   *p_call_desc is set to NULL if the call can't be compiled on the target,
+   then wasm_runtime_invoke_native is used instead. */
+bool
+wasm_runtime_create_native_call_desc(const WASMFuncType *func_type,
+                                     const char *signature,
+                                     struct WASMNativeCallDesc **p_call_desc);
+
+void
+wasm_runtime_destroy_native_call_desc(struct WASMNativeCallDesc *call_desc);
+
+/* Same as wasm_runtime_invoke_native, but with the compiled call */
+bool
+wasm_runtime_invoke_native_desc(WASMExecEnv *exec_env, void *func_ptr,
+                                const struct WASMNativeCallDesc *call_desc,
+                                void *attachment, uint32 *argv,
+                                uint32 *argv_ret);
+
 void
 wasm_runtime_read_v128(const uint8 *bytes, uint64 *ret1, uint64 *ret2);
 
@@ -1192,6 +1240,29 @@ wasm_runtime_end_blocking_op(WASMExecEnv *exec_env);
 void
 wasm_runtime_interrupt_blocking_op(WASMExecEnv *exec_env);
 
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_sampling_profiling(bool enable, uint32 interval_us);
+
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_dump_sampling_profile(WASMModuleInstanceCommon *module_inst,
+                                   const char *file_path);
+
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+/* Set the exec_env sampled on the calling thread before calling a wasm
+   function, return the previous one to be restored by
+   wasm_sampling_profiler_leave after the call */
+WASMExecEnv *
+wasm_sampling_profiler_enter(WASMExecEnv *exec_env);
+
+void
+wasm_sampling_profiler_leave(WASMExecEnv *prev_exec_env);
+
+void
+wasm_sampling_profiler_destroy(void);
+#endif
+
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_detect_native_stack_overflow(WASMExecEnv *exec_env);
 
@@ -1202,6 +1273,10 @@ wasm_runtime_detect_native_stack_overflow_size(WASMExecEnv *exec_env,
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_is_underlying_binary_freeable(WASMModuleCommon *const module);
 
+/* See wasm_export.h for description */
+WASM_RUNTIME_API_EXTERN uint32
+wasm_runtime_get_prepared_func_count(WASMModuleCommon *const module);
+
 #if WASM_ENABLE_LINUX_PERF != 0
 bool
 wasm_runtime_get_linux_perf(void);
@@ -0,0 +1,660 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_runtime_common.h"
+#include "wasm_exec_env.h"
+#include "bh_platform.h"
+#include "bh_common.h"
+#include "bh_hashmap.h"
+#include "bh_atomic.h"
+#if WASM_ENABLE_INTERP != 0
+#include "../interpreter/wasm_runtime.h"
+#include "../interpreter/wasm_interp.h"
+#endif
+#if WASM_ENABLE_AOT != 0
+#include "../aot/aot_runtime.h"
+#endif
+
+#if WASM_ENABLE_SAMPLING_PROFILING != 0 && defined(OS_ENABLE_SAMPLING_TIMER)
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#if (WASM_SAMPLING_PROFILER_RING_SIZE \
+     & (WASM_SAMPLING_PROFILER_RING_SIZE - 1))  \
+    != 0
+#error "WASM_SAMPLING_PROFILER_RING_SIZE must be a power of 2"
+#endif
+
+/* The interval to move the samples from the ring buffers into the
+   sampled stacks */
+#define COLLECT_INTERVAL_US (50 * 1000)
+
+/* The wasm call stack sampled by the signal handler */
+typedef struct SampleRecord {
+    WASMModuleInstanceCommon *module_inst;
+    uint32 depth;
+    /* The function indexes of the frames, the innermost one first */
+    uint32 func_indexes[WASM_SAMPLING_PROFILER_MAX_DEPTH];
+} SampleRecord;
+
+/**
+ * The single-producer single-consumer ring buffer of a thread: the
+ * signal handler running on the owner thread appends the samples and
+ * the collector removes them, so no lock is required. The ring buffers
+ * are kept in sampling_rings until their threads exit or the runtime is
+ * destroyed, since the signal handler may still access them after the
+ * profiling is stopped.
+ */
+typedef struct SampleRing {
+    struct SampleRing *next;
+    /* Written by the signal handler only */
+    bh_atomic_32_t head;
+    /* Written by the collector only */
+    bh_atomic_32_t tail;
+    /* The samples dropped as the ring buffer was full */
+    bh_atomic_32_t dropped;
+    SampleRecord records[WASM_SAMPLING_PROFILER_RING_SIZE];
+} SampleRing;
+
+/* An aggregated call stack, the key of sampled_stacks is its record,
+   and only the func indexes of the record's depth are allocated */
+typedef struct SampledStack {
+    uint64 count;
+    SampleRecord record;
+} SampledStack;
+
+/* The exec_env of the wasm function running on the current thread */
+static os_thread_local_attribute WASMExecEnv *volatile sampling_exec_env;
+static os_thread_local_attribute SampleRing *volatile sampling_ring;
+/* The generation of the profiler which sampling_ring belongs to, the
+   ring buffers of the previous generations were freed */
+static os_thread_local_attribute uint32 sampling_ring_generation;
+
+static bh_atomic_32_t sampling_enabled = 0;
+
+static bool profiler_inited = false;
+static uint32 profiler_generation = 1;
+static korp_mutex profiler_lock;
+static korp_cond profiler_cond;
+static SampleRing *sampling_rings = NULL;
+static HashMap *sampled_stacks = NULL;
+static uint64 sampled_stack_total = 0;
+static uint64 sample_dropped_total = 0;
+static bool collector_running = false;
+static korp_tid collector_tid;
+#ifdef OS_ENABLE_THREAD_KEY
+/* The key whose value is the ring buffer of the thread, to free the ring
+   buffer when the thread exits */
+static korp_thread_key sampling_ring_key;
+#endif
+
+static uint32
+sample_record_size(uint32 depth)
+{
+    return (uint32)offsetof(SampleRecord, func_indexes)
+           + (uint32)sizeof(uint32) * depth;
+}
+
+static uint32
+sample_record_hash(const void *key)
+{
+    const SampleRecord *record = (const SampleRecord *)key;
+    uint32 hash = (uint32)(uintptr_t)record->module_inst ^ record->depth, i;
+
+    for (i = 0; i < record->depth; i++) {
+        hash = hash * 31 + record->func_indexes[i];
+    }
+    return hash;
+}
+
+static bool
+sample_record_equal(void *key1, void *key2)
+{
+    SampleRecord *record1 = (SampleRecord *)key1;
+    SampleRecord *record2 = (SampleRecord *)key2;
+
+    return record1->module_inst == record2->module_inst
+           && record1->depth == record2->depth
+           && !memcmp(record1->func_indexes, record2->func_indexes,
+                      sizeof(uint32) * record1->depth);
+}
+
+static void
+sampled_stack_destroy(void *value)
+{
+    wasm_runtime_free(value);
+}
+
+static uint32
+walk_frames(WASMExecEnv *exec_env, uint32 *func_indexes)
+{
+    WASMModuleInstanceCommon *module_inst = exec_env->module_inst;
+    uint8 *stack_bottom = exec_env->wasm_stack.bottom;
+    uint8 *stack_top = exec_env->wasm_stack.top_boundary;
+    uint32 depth = 0;
+
+    /* The frames may be being pushed or popped, so check that each frame
+       is inside the wasm stack and below the frame it was reached from,
+       the sample is truncated otherwise */
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode) {
+        WASMModuleInstance *wasm_inst = (WASMModuleInstance *)module_inst;
+        WASMInterpFrame *frame = (WASMInterpFrame *)exec_env->cur_frame;
+
+        while (frame && depth < WASM_SAMPLING_PROFILER_MAX_DEPTH) {
+            WASMInterpFrame *prev_frame;
+
+            if ((uint8 *)frame < stack_bottom || (uint8 *)frame >= stack_top)
+                break;
+            if (frame->function) {
+                uint32 func_index =
+                    (uint32)(frame->function - wasm_inst->e->functions);
+                if (func_index >= wasm_inst->e->function_count)
+                    break;
+                func_indexes[depth++] = func_index;
+            }
+            prev_frame = frame->prev_frame;
+            if (prev_frame >= frame)
+                break;
+            frame = prev_frame;
+        }
+    }
+#endif
+#if WASM_ENABLE_AOT != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0
+    if (module_inst->module_type == Wasm_Module_AoT) {
+        AOTModule *module =
+            (AOTModule *)((AOTModuleInstance *)module_inst)->module;
+        uint32 func_count = module->import_func_count + module->func_count;
+        AOTFrame *frame = (AOTFrame *)exec_env->cur_frame;
+
+        while (frame && depth < WASM_SAMPLING_PROFILER_MAX_DEPTH) {
+            AOTFrame *prev_frame;
+
+            if ((uint8 *)frame < stack_bottom || (uint8 *)frame >= stack_top)
+                break;
+            if (frame->func_index >= func_count)
+                break;
+            func_indexes[depth++] = (uint32)frame->func_index;
+            prev_frame = frame->prev_frame;
+            if (prev_frame >= frame)
+                break;
+            frame = prev_frame;
+        }
+    }
+#endif
+
+    return depth;
+}
+
+/* Called in signal context on the thread which is running */
+static void
+sampling_signal_handler(void)
+{
+    WASMExecEnv *exec_env = sampling_exec_env;
+    SampleRing *ring = sampling_ring;
+    SampleRecord *record;
+    uint32 head, tail;
+
+    if (!exec_env || !ring || !BH_ATOMIC_32_LOAD(sampling_enabled))
+        return;
+
+    head = BH_ATOMIC_32_LOAD(ring->head);
+    tail = BH_ATOMIC_32_LOAD(ring->tail);
+    if (head - tail >= WASM_SAMPLING_PROFILER_RING_SIZE) {
+        BH_ATOMIC_32_FETCH_ADD(ring->dropped, 1);
+        return;
+    }
+
+    record = &ring->records[head & (WASM_SAMPLING_PROFILER_RING_SIZE - 1)];
+    record->module_inst = exec_env->module_inst;
+    if (!(record->depth = walk_frames(exec_env, record->func_indexes)))
+        return;
+
+    /* Publish the record to the collector */
+    BH_ATOMIC_32_STORE(ring->head, head + 1);
+}
+
+/* Move the samples from a ring buffer into the sampled stacks, the
+   caller must hold profiler_lock */
+static void
+collect_ring_samples(SampleRing *ring)
+{
+    uint32 head = BH_ATOMIC_32_LOAD(ring->head);
+    uint32 tail = BH_ATOMIC_32_LOAD(ring->tail);
+    uint32 dropped = BH_ATOMIC_32_LOAD(ring->dropped);
+
+    for (; tail != head; tail++) {
+        SampleRecord *record =
+            &ring->records[tail & (WASM_SAMPLING_PROFILER_RING_SIZE - 1)];
+        SampledStack *stack;
+        uint32 size;
+
+        if ((stack = bh_hash_map_find(sampled_stacks, record))) {
+            stack->count++;
+            continue;
+        }
+
+        size = (uint32)offsetof(SampledStack, record)
+               + sample_record_size(record->depth);
+        if (!(stack = wasm_runtime_malloc(size))) {
+            sample_dropped_total++;
+            continue;
+        }
+        stack->count = 1;
+        bh_memcpy_s(&stack->record, sample_record_size(record->depth), record,
+                    sample_record_size(record->depth));
+        if (!bh_hash_map_insert(sampled_stacks, &stack->record, stack)) {
+            wasm_runtime_free(stack);
+            sample_dropped_total++;
+            continue;
+        }
+        sampled_stack_total++;
+    }
+
+    /* Release the records to the signal handler */
+    BH_ATOMIC_32_STORE(ring->tail, head);
+
+    if (dropped > 0) {
+        BH_ATOMIC_32_FETCH_SUB(ring->dropped, dropped);
+        sample_dropped_total += dropped;
+    }
+}
+
+/* Move the samples from the ring buffers into the sampled stacks, the
+   caller must hold profiler_lock */
+static void
+collect_samples(void)
+{
+    SampleRing *ring;
+
+    for (ring = sampling_rings; ring; ring = ring->next) {
+        collect_ring_samples(ring);
+    }
+}
+
+#ifdef OS_ENABLE_THREAD_KEY
+/* Called when a thread which has a ring buffer exits, collect the samples
+   left in the ring buffer and free it */
+static void
+sampling_ring_destroy(void *value)
+{
+    SampleRing *ring = (SampleRing *)value, **p_ring;
+
+    /* The signal handler on current thread won't access it anymore */
+    sampling_ring = NULL;
+    sampling_exec_env = NULL;
+
+    os_mutex_lock(&profiler_lock);
+    for (p_ring = &sampling_rings; *p_ring; p_ring = &(*p_ring)->next) {
+        if (*p_ring == ring) {
+            if (sampled_stacks)
+                collect_ring_samples(ring);
+            *p_ring = ring->next;
+            wasm_runtime_free(ring);
+            break;
+        }
+    }
+    os_mutex_unlock(&profiler_lock);
+}
+#endif
+
+static void *
+collector_routine(void *arg)
+{
+    os_mutex_lock(&profiler_lock);
+    while (collector_running) {
+        collect_samples();
+        os_cond_reltimedwait(&profiler_cond, &profiler_lock,
+                             COLLECT_INTERVAL_US);
+    }
+    collect_samples();
+    os_mutex_unlock(&profiler_lock);
+
+    (void)arg;
+    return NULL;
+}
+
+static bool
+sampling_profiler_init(void)
+{
+    if (profiler_inited)
+        return true;
+
+    if (os_mutex_init(&profiler_lock) != 0)
+        return false;
+
+    if (os_cond_init(&profiler_cond) != 0) {
+        os_mutex_destroy(&profiler_lock);
+        return false;
+    }
+
+#ifdef OS_ENABLE_THREAD_KEY
+    if (os_thread_key_create(&sampling_ring_key, sampling_ring_destroy)
+        != BHT_OK) {
+        os_cond_destroy(&profiler_cond);
+        os_mutex_destroy(&profiler_lock);
+        return false;
+    }
+#endif
+
+    profiler_inited = true;
+    return true;
+}
+
+WASMExecEnv *
+wasm_sampling_profiler_enter(WASMExecEnv *exec_env)
+{
+    WASMExecEnv *prev_exec_env = sampling_exec_env;
+
+    if (sampling_ring_generation != profiler_generation) {
+        /* The ring buffer was freed when the runtime was destroyed */
+        sampling_ring = NULL;
+        sampling_ring_generation = profiler_generation;
+    }
+
+    if (!sampling_ring && BH_ATOMIC_32_LOAD(sampling_enabled)) {
+        SampleRing *ring;
+
+        /* Allocate the ring buffer of current thread when it runs wasm
+           functions for the first time after the profiling is started */
+        if ((ring = wasm_runtime_malloc(sizeof(SampleRing)))) {
+            memset(ring, 0, sizeof(SampleRing));
+            os_mutex_lock(&profiler_lock);
+            ring->next = sampling_rings;
+            sampling_rings = ring;
+            os_mutex_unlock(&profiler_lock);
+            sampling_ring = ring;
+#ifdef OS_ENABLE_THREAD_KEY
+            /* Free it when current thread exits, or when the runtime
+               is destroyed if it fails */
+            os_thread_key_set(sampling_ring_key, ring);
+#endif
+        }
+    }
+
+    sampling_exec_env = exec_env;
+    return prev_exec_env;
+}
+
+void
+wasm_sampling_profiler_leave(WASMExecEnv *prev_exec_env)
+{
+    sampling_exec_env = prev_exec_env;
+}
+
+static void
+stop_sampling(void)
+{
+    if (!BH_ATOMIC_32_LOAD(sampling_enabled))
+        return;
+
+    os_sampling_timer_stop();
+    BH_ATOMIC_32_STORE(sampling_enabled, 0);
+
+    os_mutex_lock(&profiler_lock);
+    collector_running = false;
+    os_cond_signal(&profiler_cond);
+    os_mutex_unlock(&profiler_lock);
+    os_thread_join(collector_tid, NULL);
+}
+
+bool
+wasm_runtime_set_sampling_profiling(bool enable, uint32 interval_us)
+{
+    if (!enable) {
+        if (profiler_inited)
+            stop_sampling();
+        return true;
+    }
+
+    if (interval_us == 0)
+        interval_us = 1000;
+
+    if (!sampling_profiler_init())
+        return false;
+
+    if (BH_ATOMIC_32_LOAD(sampling_enabled)) {
+        LOG_WARNING("sampling profiling has been started");
+        return false;
+    }
+
+    os_mutex_lock(&profiler_lock);
+    /* Discard the samples of the previous profiling */
+    if (sampled_stacks) {
+        bh_hash_map_destroy(sampled_stacks);
+        sampled_stacks = NULL;
+    }
+    sampled_stack_total = 0;
+    sample_dropped_total = 0;
+    if (!(sampled_stacks = bh_hash_map_create(
+              1024, false, sample_record_hash, sample_record_equal, NULL,
+              sampled_stack_destroy))) {
+        os_mutex_unlock(&profiler_lock);
+        return false;
+    }
+    collector_running = true;
+    os_mutex_unlock(&profiler_lock);
+
+    if (os_thread_create(&collector_tid, collector_routine, NULL,
+                         APP_THREAD_STACK_SIZE_DEFAULT)
+        != BHT_OK) {
+        LOG_ERROR("create sampling profiler thread failed");
+        collector_running = false;
+        return false;
+    }
+
+    BH_ATOMIC_32_STORE(sampling_enabled, 1);
+    if (os_sampling_timer_start(sampling_signal_handler, interval_us)
+        != BHT_OK) {
+        LOG_ERROR("start sampling profiler timer failed");
+        BH_ATOMIC_32_STORE(sampling_enabled, 0);
+        os_mutex_lock(&profiler_lock);
+        collector_running = false;
+        os_cond_signal(&profiler_cond);
+        os_mutex_unlock(&profiler_lock);
+        os_thread_join(collector_tid, NULL);
+        return false;
+    }
+
+    return true;
+}
+
+typedef struct DumpContext {
+    WASMModuleInstanceCommon *module_inst;
+    uint32 import_func_count;
+    /* -1 to print to stdout */
+    int fd;
+    bool failed;
+    uint64 sample_count;
+} DumpContext;
+
+static void
+dump_str(DumpContext *ctx, const char *str, uint32 len)
+{
+    if (ctx->failed)
+        return;
+
+    if (ctx->fd < 0) {
+        os_printf("%.*s", (int)len, str);
+        return;
+    }
+
+    while (len > 0) {
+        ssize_t ret = write(ctx->fd, str, len);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            ctx->failed = true;
+            return;
+        }
+        str += ret;
+        len -= (uint32)ret;
+    }
+}
+
+static const char *
+get_func_name(WASMModuleInstanceCommon *module_inst, uint32 func_index)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        return wasm_get_func_name((WASMModuleInstance *)module_inst,
+                                  func_index);
+#endif
+#if WASM_ENABLE_AOT != 0 && WASM_ENABLE_AOT_STACK_FRAME != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        return aot_get_func_name((AOTModuleInstance *)module_inst,
+                                 func_index);
+#endif
+    return NULL;
+}
+
+static void
+dump_sampled_stack(void *key, void *value, void *user_data)
+{
+    SampledStack *stack = (SampledStack *)value;
+    DumpContext *ctx = (DumpContext *)user_data;
+    char buf[32];
+    uint32 i, len;
+
+    if (stack->record.module_inst != ctx->module_inst)
+        return;
+
+    /* One line per call stack in the collapsed format of FlameGraph, the
+       outermost frame first, the functions without a name are written
+       as "aot_func#N" (N is the index among the non-imported functions)
+       to be translated by test-tools/flame-graph-helper */
+    for (i = stack->record.depth; i > 0; i--) {
+        uint32 func_index = stack->record.func_indexes[i - 1];
+        const char *func_name = get_func_name(ctx->module_inst, func_index);
+
+        if (func_name) {
+            dump_str(ctx, func_name, (uint32)strlen(func_name));
+        }
+        else {
+            len = (uint32)snprintf(buf, sizeof(buf), "aot_func#%u",
+                                   func_index - ctx->import_func_count);
+            dump_str(ctx, buf, len);
+        }
+        if (i > 1)
+            dump_str(ctx, ";", 1);
+    }
+
+    len = (uint32)snprintf(buf, sizeof(buf), " %" PRIu64 "\n", stack->count);
+    dump_str(ctx, buf, len);
+    ctx->sample_count += stack->count;
+
+    (void)key;
+}
+
+bool
+wasm_runtime_dump_sampling_profile(WASMModuleInstanceCommon *module_inst,
+                                   const char *file_path)
+{
+    DumpContext ctx = { 0 };
+
+    if (!module_inst || !profiler_inited)
+        return false;
+
+    ctx.module_inst = module_inst;
+    ctx.fd = -1;
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode)
+        ctx.import_func_count =
+            ((WASMModuleInstance *)module_inst)->module->import_function_count;
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT)
+        ctx.import_func_count =
+            ((AOTModule *)((AOTModuleInstance *)module_inst)->module)
+                ->import_func_count;
+#endif
+
+    if (file_path
+        && (ctx.fd = open(file_path, O_WRONLY | O_CREAT | O_TRUNC, 0644))
+               < 0) {
+        LOG_ERROR("open sampling profile file %s failed", file_path);
+        return false;
+    }
+
+    os_mutex_lock(&profiler_lock);
+    if (sampled_stacks) {
+        collect_samples();
+        bh_hash_map_traverse(sampled_stacks, dump_sampled_stack, &ctx);
+        if (sample_dropped_total > 0) {
+            LOG_WARNING("%" PRIu64 " samples were dropped, dump the "
+                        "profile more frequently or increase "
+                        "WASM_SAMPLING_PROFILER_RING_SIZE",
+                        sample_dropped_total);
+        }
+    }
+    os_mutex_unlock(&profiler_lock);
+
+    if (ctx.fd >= 0)
+        close(ctx.fd);
+
+    LOG_VERBOSE("Dumped %" PRIu64 " samples of %" PRIu64 " call stacks.",
+                ctx.sample_count, sampled_stack_total);
+    return !ctx.failed;
+}
+
+void
+wasm_sampling_profiler_destroy(void)
+{
+    SampleRing *ring, *next;
+
+    if (!profiler_inited)
+        return;
+
+    stop_sampling();
+
+    for (ring = sampling_rings; ring; ring = next) {
+        next = ring->next;
+        wasm_runtime_free(ring);
+    }
+    sampling_rings = NULL;
+    /* Invalidate sampling_ring of all the threads */
+    profiler_generation++;
+#ifdef OS_ENABLE_THREAD_KEY
+    /* The ring buffers freed above aren't passed to the destructor
+       anymore when their threads exit */
+    os_thread_key_delete(sampling_ring_key);
+#endif
+
+    if (sampled_stacks) {
+        bh_hash_map_destroy(sampled_stacks);
+        sampled_stacks = NULL;
+    }
+
+    os_cond_destroy(&profiler_cond);
+    os_mutex_destroy(&profiler_lock);
+    profiler_inited = false;
+}
+
+#else /* else of WASM_ENABLE_SAMPLING_PROFILING != 0 \
+         && defined(OS_ENABLE_SAMPLING_TIMER) */
+
+bool
+wasm_runtime_set_sampling_profiling(bool enable, uint32 interval_us)
+{
+    (void)interval_us;
+    if (enable) {
+        LOG_WARNING("sampling profiling isn't supported");
+        return false;
+    }
+    return true;
+}
+
+bool
+wasm_runtime_dump_sampling_profile(WASMModuleInstanceCommon *module_inst,
+                                   const char *file_path)
+{
+    (void)module_inst;
+    (void)file_path;
+    return false;
+}
+
+#endif /* end of WASM_ENABLE_SAMPLING_PROFILING != 0 \
+          && defined(OS_ENABLE_SAMPLING_TIMER) */
@@ -23,46 +23,68 @@ korp_mutex g_shared_memory_lock;
 /* clang-format off */
 enum {
     S_WAITING,
-    S_NOTIFIED
+    S_NOTIFIED,
+    S_TERMINATED
 };
 /* clang-format on */
 
-typedef struct AtomicWaitInfo {
-    bh_list wait_list_head;
-    bh_list *wait_list;
-    /* WARNING: insert to the list allowed only in acquire_wait_info
-       otherwise there will be data race as described in PR #2016 */
-} AtomicWaitInfo;
-
 typedef struct AtomicWaitNode {
-    bh_list_link l;
-    uint8 status;
+    struct AtomicWaitNode *prev;
+    struct AtomicWaitNode *next;
+    /* The native address the thread is waiting on */
+    void *address;
+    /* The exec_env of the waiting thread, used to wake it up when
+       the thread is terminated */
+    void *exec_env;
+    /* The wait status, it is also the futex word which the waiting
+       thread sleeps on if futex is supported */
+    bh_atomic_32_t status;
+#ifndef OS_ENABLE_FUTEX
     korp_cond wait_cond;
+#endif
 } AtomicWaitNode;
 
-/* Atomic wait map */
-static HashMap *wait_map;
-
-static uint32
-wait_address_hash(const void *address);
-
-static bool
-wait_address_equal(void *h1, void *h2);
+/*
+ * The waiting threads are kept in a fixed number of buckets hashed by
+ * the wait address, each bucket has its own lock, so that wait/notify
+ * on different addresses don't contend with each other. The wait nodes
+ * are recycled in the bucket to avoid malloc/os_cond_init in each wait.
+ */
+typedef struct AtomicWaitBucket {
+    korp_mutex lock;
+    /* FIFO list of the waiting threads */
+    AtomicWaitNode *wait_head;
+    AtomicWaitNode *wait_tail;
+    /* Free wait nodes for reuse */
+    AtomicWaitNode *free_nodes;
+    uint32 free_node_count;
+} AtomicWaitBucket;
+
+#define ATOMIC_WAIT_BUCKET_BITS 6
+#define ATOMIC_WAIT_BUCKET_NUM (1 << ATOMIC_WAIT_BUCKET_BITS)
+/* Max free wait nodes kept in each bucket */
+#define ATOMIC_WAIT_FREE_NODE_MAX 16
+
+static AtomicWaitBucket wait_buckets[ATOMIC_WAIT_BUCKET_NUM];
 
 static void
-destroy_wait_info(void *wait_info);
+wait_buckets_destroy(uint32 bucket_num);
 
 bool
 wasm_shared_memory_init()
 {
+    uint32 i;
+
     if (os_mutex_init(&g_shared_memory_lock) != 0)
         return false;
-    /* wait map not exists, create new map */
-    if (!(wait_map = bh_hash_map_create(32, true, (HashFunc)wait_address_hash,
-                                        (KeyEqualFunc)wait_address_equal, NULL,
-                                        destroy_wait_info))) {
-        os_mutex_destroy(&g_shared_memory_lock);
-        return false;
+
+    memset(wait_buckets, 0, sizeof(wait_buckets));
+    for (i = 0; i < ATOMIC_WAIT_BUCKET_NUM; i++) {
+        if (os_mutex_init(&wait_buckets[i].lock) != 0) {
+            wait_buckets_destroy(i);
+            os_mutex_destroy(&g_shared_memory_lock);
+            return false;
+        }
     }
     return true;
 }
@@ -70,7 +92,7 @@ wasm_shared_memory_init()
 void
 wasm_shared_memory_destroy()
 {
-    bh_hash_map_destroy(wait_map);
+    wait_buckets_destroy(ATOMIC_WAIT_BUCKET_NUM);
     os_mutex_destroy(&g_shared_memory_lock);
 }
 
@@ -107,140 +129,153 @@ shared_memory_dec_reference(WASMMemoryInstance *memory)
     return old - 1;
 }
 
-static korp_mutex *
-shared_memory_get_lock_pointer(WASMMemoryInstance *memory)
-{
-    bh_assert(memory != NULL);
-    return &g_shared_memory_lock;
-}
-
 /* Atomics wait && notify APIs */
-static uint32
-wait_address_hash(const void *address)
+static AtomicWaitBucket *
+wait_bucket_get(const void *address)
 {
-    return (uint32)(uintptr_t)address;
+    /* Fibonacci hashing, the low 2 bits of the address are always 0
+       since the wait/notify address must be aligned */
+    uint32 hash = (uint32)((uintptr_t)address >> 2) * 0x9E3779B9U;
+    return &wait_buckets[hash >> (32 - ATOMIC_WAIT_BUCKET_BITS)];
 }
 
-static bool
-wait_address_equal(void *h1, void *h2)
-{
-    return h1 == h2 ? true : false;
-}
-
-static bool
-is_wait_node_exists(bh_list *wait_list, AtomicWaitNode *node)
+static void
+wait_node_destroy(AtomicWaitNode *node)
 {
-    AtomicWaitNode *curr;
-    curr = bh_list_first_elem(wait_list);
-
-    while (curr) {
-        if (curr == node) {
-            return true;
-        }
-        curr = bh_list_elem_next(curr);
-    }
-
-    return false;
+#ifndef OS_ENABLE_FUTEX
+    os_cond_destroy(&node->wait_cond);
+#endif
+    wasm_runtime_free(node);
 }
 
-static uint32
-notify_wait_list(bh_list *wait_list, uint32 count)
+static void
+wait_buckets_destroy(uint32 bucket_num)
 {
+    AtomicWaitBucket *bucket;
     AtomicWaitNode *node, *next;
-    uint32 i, notify_count = count;
-
-    if (count > wait_list->len)
-        notify_count = wait_list->len;
+    uint32 i;
 
-    node = bh_list_first_elem(wait_list);
-    if (!node)
-        return 0;
-
-    for (i = 0; i < notify_count; i++) {
-        bh_assert(node);
-        next = bh_list_elem_next(node);
+    for (i = 0; i < bucket_num; i++) {
+        bucket = &wait_buckets[i];
+        /* No thread should be waiting when the runtime is destroyed */
+        bh_assert(!bucket->wait_head);
 
-        node->status = S_NOTIFIED;
-        /* wakeup */
-        os_cond_signal(&node->wait_cond);
+        node = bucket->free_nodes;
+        while (node) {
+            next = node->next;
+            wait_node_destroy(node);
+            node = next;
+        }
+        bucket->free_nodes = NULL;
+        bucket->free_node_count = 0;
 
-        node = next;
+        os_mutex_destroy(&bucket->lock);
     }
-
-    return notify_count;
 }
 
-static AtomicWaitInfo *
-acquire_wait_info(void *address, AtomicWaitNode *wait_node)
+/* Must be called with bucket->lock held */
+static AtomicWaitNode *
+wait_node_acquire(AtomicWaitBucket *bucket)
 {
-    AtomicWaitInfo *wait_info = NULL;
-    bh_list_status ret;
-
-    bh_assert(address != NULL);
+    AtomicWaitNode *node = bucket->free_nodes;
 
-    wait_info = (AtomicWaitInfo *)bh_hash_map_find(wait_map, address);
+    if (node) {
+        bucket->free_nodes = node->next;
+        bucket->free_node_count--;
+        return node;
+    }
 
-    if (!wait_node) {
-        return wait_info;
+    if (!(node = wasm_runtime_malloc(sizeof(AtomicWaitNode)))) {
+        return NULL;
     }
+    memset(node, 0, sizeof(AtomicWaitNode));
 
-    /* No wait info on this address, create new info */
-    if (!wait_info) {
-        if (!(wait_info = (AtomicWaitInfo *)wasm_runtime_malloc(
-                  sizeof(AtomicWaitInfo)))) {
-            return NULL;
-        }
-        memset(wait_info, 0, sizeof(AtomicWaitInfo));
+#ifndef OS_ENABLE_FUTEX
+    if (0 != os_cond_init(&node->wait_cond)) {
+        wasm_runtime_free(node);
+        return NULL;
+    }
+#endif
 
-        /* init wait list */
-        wait_info->wait_list = &wait_info->wait_list_head;
-        ret = bh_list_init(wait_info->wait_list);
-        bh_assert(ret == BH_LIST_SUCCESS);
-        (void)ret;
+    return node;
+}
 
-        if (!bh_hash_map_insert(wait_map, address, (void *)wait_info)) {
-            wasm_runtime_free(wait_info);
-            return NULL;
-        }
+/* Must be called with bucket->lock held */
+static void
+wait_node_release(AtomicWaitBucket *bucket, AtomicWaitNode *node)
+{
+    if (bucket->free_node_count >= ATOMIC_WAIT_FREE_NODE_MAX) {
+        wait_node_destroy(node);
+        return;
     }
 
-    ret = bh_list_insert(wait_info->wait_list, wait_node);
-    bh_assert(ret == BH_LIST_SUCCESS);
-    (void)ret;
-
-    return wait_info;
+    node->prev = NULL;
+    node->address = NULL;
+    node->exec_env = NULL;
+    node->next = bucket->free_nodes;
+    bucket->free_nodes = node;
+    bucket->free_node_count++;
 }
 
+/* Must be called with bucket->lock held */
 static void
-destroy_wait_info(void *wait_info)
+wait_list_append(AtomicWaitBucket *bucket, AtomicWaitNode *node)
 {
-    AtomicWaitNode *node, *next;
-
-    if (wait_info) {
+    node->next = NULL;
+    node->prev = bucket->wait_tail;
+    if (bucket->wait_tail)
+        bucket->wait_tail->next = node;
+    else
+        bucket->wait_head = node;
+    bucket->wait_tail = node;
+}
 
-        node = bh_list_first_elem(((AtomicWaitInfo *)wait_info)->wait_list);
+/* Must be called with bucket->lock held */
+static void
+wait_list_remove(AtomicWaitBucket *bucket, AtomicWaitNode *node)
+{
+    if (node->prev)
+        node->prev->next = node->next;
+    else
+        bucket->wait_head = node->next;
 
-        while (node) {
-            next = bh_list_elem_next(node);
-            os_cond_destroy(&node->wait_cond);
-            wasm_runtime_free(node);
-            node = next;
-        }
+    if (node->next)
+        node->next->prev = node->prev;
+    else
+        bucket->wait_tail = node->prev;
 
-        wasm_runtime_free(wait_info);
-    }
+    node->prev = node->next = NULL;
 }
 
+/* Must be called with bucket->lock held, the node must have been
+   removed from the wait list */
 static void
-map_try_release_wait_info(HashMap *wait_hash_map, AtomicWaitInfo *wait_info,
-                          void *address)
+wait_node_wakeup(AtomicWaitNode *node, uint32 status)
 {
-    if (wait_info->wait_list->len > 0) {
-        return;
+    BH_ATOMIC_32_STORE(node->status, status);
+#ifdef OS_ENABLE_FUTEX
+    os_futex_wake((uint32 *)&node->status, 1);
+#else
+    os_cond_signal(&node->wait_cond);
+#endif
+}
+
+static bool
+wait_timeout_left(int64 timeout, uint64 deadline, uint64 *p_timeout_left)
+{
+    uint64 now;
+
+    if (timeout < 0) {
+        *p_timeout_left = BHT_WAIT_FOREVER;
+        return true;
     }
 
-    bh_hash_map_remove(wait_hash_map, address, NULL, NULL);
-    destroy_wait_info(wait_info);
+    now = os_time_get_boot_us();
+    if (now >= deadline)
+        return false;
+
+    *p_timeout_left = deadline - now;
+    return true;
 }
 
 uint32
@@ -248,14 +283,11 @@ wasm_runtime_atomic_wait(WASMModuleInstanceCommon *module, void *address,
                          uint64 expect, int64 timeout, bool wait64)
 {
     WASMModuleInstance *module_inst = (WASMModuleInstance *)module;
-    AtomicWaitInfo *wait_info;
+    AtomicWaitBucket *bucket;
     AtomicWaitNode *wait_node;
-    korp_mutex *lock;
-#if WASM_ENABLE_THREAD_MGR != 0
-    WASMExecEnv *exec_env;
-#endif
-    uint64 timeout_left, timeout_wait, timeout_1sec;
-    bool check_ret, is_timeout, no_wait;
+    WASMExecEnv *exec_env = NULL;
+    uint64 deadline = 0, timeout_left;
+    bool is_timeout, no_wait;
 
     bh_assert(module->module_type == Wasm_Module_Bytecode
               || module->module_type == Wasm_Module_AoT);
@@ -286,98 +318,77 @@ wasm_runtime_atomic_wait(WASMModuleInstanceCommon *module, void *address,
     bh_assert(exec_env);
 #endif
 
-    lock = shared_memory_get_lock_pointer(module_inst->memories[0]);
+    if (timeout >= 0) {
+        /* unit of timeout is nsec, convert it to usec */
+        deadline = os_time_get_boot_us() + (uint64)timeout / 1000;
+    }
 
-    /* Lock the shared_mem_lock for the whole atomic wait process,
-       and use it to os_cond_reltimedwait */
-    os_mutex_lock(lock);
+    bucket = wait_bucket_get(address);
 
-    no_wait = (!wait64 && *(uint32 *)address != (uint32)expect)
-              || (wait64 && *(uint64 *)address != expect);
+    /* The notifier always takes the bucket lock after updating the
+       value, so checking the value and queuing the wait node with the
+       lock held can't miss a notify */
+    os_mutex_lock(&bucket->lock);
+
+    no_wait = (!wait64
+               && BH_ATOMIC_32_LOAD(*(bh_atomic_32_t *)address)
+                      != (uint32)expect)
+              || (wait64
+                  && BH_ATOMIC_64_LOAD(*(bh_atomic_64_t *)address) != expect);
 
     if (no_wait) {
-        os_mutex_unlock(lock);
+        os_mutex_unlock(&bucket->lock);
         return 1;
     }
 
-    if (!(wait_node = wasm_runtime_malloc(sizeof(AtomicWaitNode)))) {
-        os_mutex_unlock(lock);
+    if (!(wait_node = wait_node_acquire(bucket))) {
+        os_mutex_unlock(&bucket->lock);
         wasm_runtime_set_exception(module, "failed to create wait node");
         return -1;
     }
-    memset(wait_node, 0, sizeof(AtomicWaitNode));
-
-    if (0 != os_cond_init(&wait_node->wait_cond)) {
-        os_mutex_unlock(lock);
-        wasm_runtime_free(wait_node);
-        wasm_runtime_set_exception(module, "failed to init wait cond");
-        return -1;
-    }
 
+    wait_node->address = address;
+    wait_node->exec_env = exec_env;
     wait_node->status = S_WAITING;
+    wait_list_append(bucket, wait_node);
 
-    /* Acquire the wait info, create new one if not exists */
-    wait_info = acquire_wait_info(address, wait_node);
-
-    if (!wait_info) {
-        os_mutex_unlock(lock);
-        os_cond_destroy(&wait_node->wait_cond);
-        wasm_runtime_free(wait_node);
-        wasm_runtime_set_exception(module, "failed to acquire wait_info");
-        return -1;
-    }
-
-    /* unit of timeout is nsec, convert it to usec */
-    timeout_left = (uint64)timeout / 1000;
-    timeout_1sec = (uint64)1e6;
-
-    while (1) {
-        if (timeout < 0) {
-            /* wait forever until it is notified or terminated
-               here we keep waiting and checking every second */
-            os_cond_reltimedwait(&wait_node->wait_cond, lock,
-                                 (uint64)timeout_1sec);
-            if (wait_node->status == S_NOTIFIED /* notified by atomic.notify */
-#if WASM_ENABLE_THREAD_MGR != 0
-                /* terminated by other thread */
-                || wasm_cluster_is_thread_terminated(exec_env)
-#endif
-            ) {
-                break;
-            }
-        }
-        else {
-            timeout_wait =
-                timeout_left < timeout_1sec ? timeout_left : timeout_1sec;
-            os_cond_reltimedwait(&wait_node->wait_cond, lock, timeout_wait);
-            if (wait_node->status == S_NOTIFIED /* notified by atomic.notify */
-                || timeout_left <= timeout_wait /* time out */
 #if WASM_ENABLE_THREAD_MGR != 0
-                /* terminated by other thread */
-                || wasm_cluster_is_thread_terminated(exec_env)
-#endif
-            ) {
-                break;
-            }
-            timeout_left -= timeout_wait;
-        }
+    /* The terminating thread sets the flag before it scans the buckets
+       in wasm_runtime_atomic_wait_interrupt, so it either finds the node
+       queued here or we see the flag now */
+    if (wasm_cluster_is_thread_terminated(exec_env)) {
+        wait_list_remove(bucket, wait_node);
+        wait_node->status = S_TERMINATED;
     }
+#endif
 
-    is_timeout = wait_node->status == S_WAITING ? true : false;
+#ifdef OS_ENABLE_FUTEX
+    os_mutex_unlock(&bucket->lock);
 
-    check_ret = is_wait_node_exists(wait_info->wait_list, wait_node);
-    bh_assert(check_ret);
-    (void)check_ret;
+    while (BH_ATOMIC_32_LOAD(wait_node->status) == S_WAITING
+           && wait_timeout_left(timeout, deadline, &timeout_left)) {
+        os_futex_wait((uint32 *)&wait_node->status, S_WAITING, timeout_left);
+    }
+
+    os_mutex_lock(&bucket->lock);
+#else
+    while (wait_node->status == S_WAITING
+           && wait_timeout_left(timeout, deadline, &timeout_left)) {
+        os_cond_reltimedwait(&wait_node->wait_cond, &bucket->lock,
+                             timeout_left);
+    }
+#endif
 
-    /* Remove wait node from wait list */
-    bh_list_remove(wait_info->wait_list, wait_node);
-    os_cond_destroy(&wait_node->wait_cond);
-    wasm_runtime_free(wait_node);
+    /* Terminated threads also report timed out, as before */
+    is_timeout = wait_node->status != S_NOTIFIED ? true : false;
 
-    /* Release wait info if no wait nodes are attached */
-    map_try_release_wait_info(wait_map, wait_info, address);
+    /* Still in the wait list if nobody woke us up before timeout */
+    if (wait_node->status == S_WAITING) {
+        wait_list_remove(bucket, wait_node);
+    }
+    wait_node_release(bucket, wait_node);
 
-    os_mutex_unlock(lock);
+    os_mutex_unlock(&bucket->lock);
 
     return is_timeout ? 2 : 0;
 }
@@ -387,9 +398,9 @@ wasm_runtime_atomic_notify(WASMModuleInstanceCommon *module, void *address,
                            uint32 count)
 {
     WASMModuleInstance *module_inst = (WASMModuleInstance *)module;
-    uint32 notify_result;
-    AtomicWaitInfo *wait_info;
-    korp_mutex *lock;
+    AtomicWaitBucket *bucket;
+    AtomicWaitNode *node, *next;
+    uint32 notify_count = 0;
     bool out_of_bounds;
 
     bh_assert(module->module_type == Wasm_Module_Bytecode
@@ -413,24 +424,53 @@ wasm_runtime_atomic_notify(WASMModuleInstanceCommon *module, void *address,
         return 0;
     }
 
-    lock = shared_memory_get_lock_pointer(module_inst->memories[0]);
+    bucket = wait_bucket_get(address);
 
-    /* Lock the shared_mem_lock for the whole atomic notify process,
-       and use it to os_cond_signal */
-    os_mutex_lock(lock);
+    os_mutex_lock(&bucket->lock);
 
-    wait_info = acquire_wait_info(address, NULL);
-
-    /* Nobody wait on this address */
-    if (!wait_info) {
-        os_mutex_unlock(lock);
-        return 0;
+    /* Wake up the waiters on this address in FIFO order */
+    node = bucket->wait_head;
+    while (node && notify_count < count) {
+        next = node->next;
+        if (node->address == address) {
+            wait_list_remove(bucket, node);
+            wait_node_wakeup(node, S_NOTIFIED);
+            notify_count++;
+        }
+        node = next;
     }
 
-    /* Notify each wait node in the wait list */
-    notify_result = notify_wait_list(wait_info->wait_list, count);
+    os_mutex_unlock(&bucket->lock);
 
-    os_mutex_unlock(lock);
+    return notify_count;
+}
+
+#if WASM_ENABLE_THREAD_MGR != 0
+void
+wasm_runtime_atomic_wait_interrupt(WASMExecEnv *exec_env)
+{
+    AtomicWaitBucket *bucket;
+    AtomicWaitNode *node, *next;
+    uint32 i;
+
+    /* A thread waits on one address at most, but we don't know which
+       bucket it is in, scan all of them since termination is rare */
+    for (i = 0; i < ATOMIC_WAIT_BUCKET_NUM; i++) {
+        bucket = &wait_buckets[i];
 
-    return notify_result;
+        os_mutex_lock(&bucket->lock);
+        node = bucket->wait_head;
+        while (node) {
+            next = node->next;
+            if (node->exec_env == exec_env) {
+                wait_list_remove(bucket, node);
+                wait_node_wakeup(node, S_TERMINATED);
+                os_mutex_unlock(&bucket->lock);
+                return;
+            }
+            node = next;
+        }
+        os_mutex_unlock(&bucket->lock);
+    }
 }
+#endif
@@ -56,6 +56,13 @@ uint32
 wasm_runtime_atomic_notify(WASMModuleInstanceCommon *module, void *address,
                            uint32 count);
 
+#if WASM_ENABLE_THREAD_MGR != 0
+/* Wake up the thread of exec_env if it is blocked in atomic.wait, the
+   caller must have set the terminate flag of exec_env beforehand */
+void
+wasm_runtime_atomic_wait_interrupt(WASMExecEnv *exec_env);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
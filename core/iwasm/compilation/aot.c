@@ -5,7 +5,13 @@
 
 #include "aot.h"
 
+/* The code of the partitions is generated by multiple threads when
+   compiling with multiple threads, each thread has its own error */
+#ifdef os_thread_local_attribute
+static os_thread_local_attribute char aot_error[128];
+#else
 static char aot_error[128];
+#endif
 
 char *
 aot_get_last_error()
@@ -318,6 +324,7 @@ aot_create_import_funcs(const WASMModule *module)
         import_funcs[i].func_type = import_func->func_type;
         import_funcs[i].signature = import_func->signature;
         import_funcs[i].attachment = import_func->attachment;
+        import_funcs[i].call_desc = NULL;
         import_funcs[i].call_conv_raw = import_func->call_conv_raw;
         import_funcs[i].call_conv_wasm_c_api = false;
         /* Resolve function type index */
@@ -23,6 +23,12 @@ extern "C" {
 #define AOT_FUNC_INTERNAL_PREFIX "aot_func_internal#"
 #endif
 
+/* The alias of a local global, by which it is referenced by the other
+   partitions when compiling with multiple threads */
+#ifndef AOT_PARTITION_GLOBAL_PREFIX
+#define AOT_PARTITION_GLOBAL_PREFIX "aot_partition_global#"
+#endif
+
 #ifndef AOT_STACK_SIZES_NAME
 #define AOT_STACK_SIZES_NAME "aot_stack_sizes"
 #endif
@@ -217,6 +223,8 @@ typedef struct AOTImportFunc {
     const char *signature;
     /* attachment */
     void *attachment;
+    /* the call compiled from func_type and signature */
+    struct WASMNativeCallDesc *call_desc;
     bool call_conv_raw;
     bool call_conv_wasm_c_api;
     bool wasm_c_api_with_env;
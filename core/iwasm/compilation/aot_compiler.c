@@ -988,6 +988,16 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
         }
 #endif
 
+        if (comp_ctx->enable_fuel_metering) {
+            func_ctx->fuel_region_cost++;
+            if (wasm_is_fuel_charging_opcode(opcode, frame_ip, frame_ip_end)) {
+                if (!aot_emit_fuel_charge(comp_ctx, func_ctx,
+                                          func_ctx->fuel_region_cost))
+                    return false;
+                func_ctx->fuel_region_cost = 0;
+            }
+        }
+
         switch (opcode) {
             case WASM_OP_UNREACHABLE:
                 if (!aot_compile_op_unreachable(comp_ctx, func_ctx, &frame_ip))
@@ -1157,8 +1167,14 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
             case WASM_OP_CALL:
             {
                 read_leb_uint32(frame_ip, frame_ip_end, func_idx);
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_commit_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_call(comp_ctx, func_ctx, func_idx, false))
                     return false;
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_reload_fuel(comp_ctx, func_ctx))
+                    return false;
                 break;
             }
 
@@ -1176,9 +1192,15 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
                     tbl_idx = 0;
                 }
 
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_commit_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_call_indirect(comp_ctx, func_ctx, type_idx,
                                                   tbl_idx))
                     return false;
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_reload_fuel(comp_ctx, func_ctx))
+                    return false;
                 break;
             }
 
@@ -1191,8 +1213,14 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
                 }
 
                 read_leb_uint32(frame_ip, frame_ip_end, func_idx);
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_commit_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_call(comp_ctx, func_ctx, func_idx, true))
                     return false;
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_reload_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_return(comp_ctx, func_ctx, &frame_ip))
                     return false;
                 break;
@@ -1216,9 +1244,15 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
                     tbl_idx = 0;
                 }
 
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_commit_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_call_indirect(comp_ctx, func_ctx, type_idx,
                                                   tbl_idx))
                     return false;
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_reload_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_return(comp_ctx, func_ctx, &frame_ip))
                     return false;
                 break;
@@ -1346,9 +1380,15 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
                 }
 
                 read_leb_uint32(frame_ip, frame_ip_end, type_idx);
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_commit_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_call_ref(comp_ctx, func_ctx, type_idx,
                                              false))
                     return false;
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_reload_fuel(comp_ctx, func_ctx))
+                    return false;
                 break;
             }
 
@@ -1359,9 +1399,15 @@ aot_compile_func(AOTCompContext *comp_ctx, uint32 func_index)
                 }
 
                 read_leb_uint32(frame_ip, frame_ip_end, type_idx);
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_commit_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_call_ref(comp_ctx, func_ctx, type_idx,
                                              true))
                     return false;
+                if (comp_ctx->enable_fuel_metering
+                    && !aot_reload_fuel(comp_ctx, func_ctx))
+                    return false;
                 if (!aot_compile_op_return(comp_ctx, func_ctx, &frame_ip))
                     return false;
                 break;
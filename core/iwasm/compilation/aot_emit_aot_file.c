@@ -82,6 +82,15 @@ typedef struct AOTObjectData {
     const char *stack_sizes_section_name;
     uint32 stack_sizes_offset;
     uint32 *stack_sizes;
+
+    /* The partition of the functions emitted to the object when compiling
+       with multiple threads, NULL if all the functions are emitted */
+    const AOTCompPartition *partition;
+    /* The object data of the partitions merged into this one */
+    struct AOTObjectData **partitions;
+    uint32 partition_count;
+    bool is_text_allocated;
+    bool is_literal_allocated;
 } AOTObjectData;
 
 #if 0
@@ -3032,6 +3041,19 @@ typedef struct elf64_rela {
     elf64_sxword r_addend;
 } elf64_rela;
 
+struct elf64_shdr {
+    elf64_word sh_name;       /* section name */
+    elf64_word sh_type;       /* section type */
+    elf64_xword sh_flags;     /* section flags */
+    elf64_addr sh_addr;       /* virtual address */
+    elf64_off sh_offset;      /* file offset */
+    elf64_xword sh_size;      /* section size */
+    elf64_word sh_link;       /* misc info */
+    elf64_word sh_info;       /* misc info */
+    elf64_xword sh_addralign; /* memory alignment */
+    elf64_xword sh_entsize;   /* entry size if table */
+};
+
 #define SET_TARGET_INFO(f, v, type, little)     \
     do {                                        \
         type tmp = elf_header->v;               \
@@ -3356,7 +3378,7 @@ aot_resolve_object_data_sections(AOTObjectData *obj_data)
 
 static bool
 read_stack_usage_file(const AOTCompContext *comp_ctx, const char *filename,
-                      uint32 *sizes, uint32 count)
+                      uint32 *sizes, uint32 count, uint32 expected)
 {
     FILE *fp = NULL;
     if (filename == NULL) {
@@ -3439,13 +3461,13 @@ read_stack_usage_file(const AOTCompContext *comp_ctx, const char *filename,
         found++;
     }
     fclose(fp);
-    if (precheck_found != count) {
+    if (precheck_found != expected) {
         LOG_ERROR("%" PRIu32 " precheck entries found while %" PRIu32
                   " entries are expected",
-                  precheck_found, count);
+                  precheck_found, expected);
         return false;
     }
-    if (found != count) {
+    if (found != expected) {
         /*
          * LLVM seems to eliminate calls to an empty function
          * (and eliminate the function) even if it's marked noinline.
@@ -3453,7 +3475,7 @@ read_stack_usage_file(const AOTCompContext *comp_ctx, const char *filename,
         LOG_VERBOSE("%" PRIu32 " entries found while %" PRIu32
                     " entries are expected. Maybe LLVM optimization eliminated "
                     "some functions.",
-                    found, count);
+                    found, expected);
     }
     if (precheck_stack_size_min != precheck_stack_size_max) {
         /*
@@ -3498,6 +3520,117 @@ fail:
     return false;
 }
 
+/* Get the functions emitted to the object, [*p_begin, *p_end) */
+static void
+get_obj_data_func_range(const AOTObjectData *obj_data, uint32 *p_begin,
+                        uint32 *p_end)
+{
+    if (obj_data->partition) {
+        *p_begin = obj_data->partition->func_begin;
+        *p_end = obj_data->partition->func_end;
+    }
+    else {
+        *p_begin = 0;
+        *p_end = obj_data->func_count;
+    }
+}
+
+static bool
+is_last_partition(const AOTObjectData *obj_data)
+{
+    const AOTCompContext *comp_ctx = obj_data->comp_ctx;
+
+    return obj_data->partition
+           == comp_ctx->partitions + comp_ctx->partition_count - 1;
+}
+
+/* Read the stack sizes of the functions emitted to the object */
+static bool
+aot_read_stack_sizes(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
+{
+    const char *stack_usage_file = obj_data->partition
+                                       ? obj_data->partition->stack_usage_file
+                                       : comp_ctx->stack_usage_file;
+    uint32 func_begin, func_end, i;
+
+    get_obj_data_func_range(obj_data, &func_begin, &func_end);
+
+    obj_data->stack_sizes = wasm_runtime_malloc(
+        obj_data->func_count * sizeof(*obj_data->stack_sizes));
+    if (obj_data->stack_sizes == NULL) {
+        aot_set_last_error("failed to allocate memory.");
+        return false;
+    }
+    uint32 *stack_sizes = obj_data->stack_sizes;
+    for (i = 0; i < obj_data->func_count; i++) {
+        stack_sizes[i] = (uint32)-1;
+    }
+    if (!read_stack_usage_file(comp_ctx, stack_usage_file, stack_sizes,
+                               obj_data->func_count, func_end - func_begin)) {
+        return false;
+    }
+    for (i = func_begin; i < func_end; i++) {
+        const AOTFuncContext *func_ctx = comp_ctx->func_ctxes[i];
+        bool musttail = aot_target_precheck_can_use_musttail(comp_ctx);
+        unsigned int stack_consumption_to_call_wrapped_func =
+            musttail ? 0
+                     : aot_estimate_stack_usage_for_function_call(
+                         comp_ctx, func_ctx->aot_func->func_type);
+
+        /*
+         * LLVM seems to eliminate calls to an empty function
+         * (and eliminate the function) even if it's marked noinline.
+         *
+         * Note: -1 == AOT_NEG_ONE from aot_create_stack_sizes
+         */
+        if (stack_sizes[i] == (uint32)-1) {
+            if (func_ctx->stack_consumption_for_func_call != 0) {
+                /*
+                 * This happens if a function calling another
+                 * function has been optimized out.
+                 *
+                 * for example,
+                 *
+                 *   (func $func
+                 *     (local i32)
+                 *     local.get 0
+                 *     if
+                 *       call $another
+                 *     end
+                 *   )
+                 */
+                LOG_VERBOSE("AOT func#%" PRIu32
+                            " had call(s) but eliminated?",
+                            i);
+            }
+            else {
+                LOG_VERBOSE("AOT func#%" PRIu32 " eliminated?", i);
+            }
+            stack_sizes[i] = 0;
+        }
+        else {
+            LOG_VERBOSE("AOT func#%" PRIu32 " stack_size %u + %" PRIu32
+                        " + %u",
+                        i, stack_consumption_to_call_wrapped_func,
+                        stack_sizes[i],
+                        func_ctx->stack_consumption_for_func_call);
+            if (UINT32_MAX - stack_sizes[i]
+                < func_ctx->stack_consumption_for_func_call) {
+                aot_set_last_error("stack size overflow.");
+                return false;
+            }
+            stack_sizes[i] += func_ctx->stack_consumption_for_func_call;
+            if (UINT32_MAX - stack_sizes[i]
+                < stack_consumption_to_call_wrapped_func) {
+                aot_set_last_error("stack size overflow.");
+                return false;
+            }
+            stack_sizes[i] += stack_consumption_to_call_wrapped_func;
+        }
+    }
+    return true;
+}
+
 static bool
 aot_resolve_stack_sizes(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
 {
@@ -3505,6 +3638,11 @@ aot_resolve_stack_sizes(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
     LLVMSymbolIteratorRef sym_itr;
     const char *name;
 
+    /* The stack sizes are only defined in the last partition, see
+       aot_extract_module_partition */
+    if (obj_data->partition && !is_last_partition(obj_data))
+        return aot_read_stack_sizes(comp_ctx, obj_data);
+
     if (!(sym_itr = LLVMObjectFileCopySymbolIterator(obj_data->binary))) {
         aot_set_last_error("llvm get symbol iterator failed.");
         return false;
@@ -3564,79 +3702,9 @@ aot_resolve_stack_sizes(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
              */
             obj_data->stack_sizes_section_name = sec_name;
             obj_data->stack_sizes_offset = (uint32)addr;
-            obj_data->stack_sizes = wasm_runtime_malloc(
-                obj_data->func_count * sizeof(*obj_data->stack_sizes));
-            if (obj_data->stack_sizes == NULL) {
-                aot_set_last_error("failed to allocate memory.");
-                goto fail;
-            }
-            uint32 *stack_sizes = obj_data->stack_sizes;
-            for (i = 0; i < obj_data->func_count; i++) {
-                stack_sizes[i] = (uint32)-1;
-            }
-            if (!read_stack_usage_file(comp_ctx, comp_ctx->stack_usage_file,
-                                       stack_sizes, obj_data->func_count)) {
+            if (!aot_read_stack_sizes(comp_ctx, obj_data)) {
                 goto fail;
             }
-            for (i = 0; i < obj_data->func_count; i++) {
-                const AOTFuncContext *func_ctx = comp_ctx->func_ctxes[i];
-                bool musttail = aot_target_precheck_can_use_musttail(comp_ctx);
-                unsigned int stack_consumption_to_call_wrapped_func =
-                    musttail ? 0
-                             : aot_estimate_stack_usage_for_function_call(
-                                 comp_ctx, func_ctx->aot_func->func_type);
-
-                /*
-                 * LLVM seems to eliminate calls to an empty function
-                 * (and eliminate the function) even if it's marked noinline.
-                 *
-                 * Note: -1 == AOT_NEG_ONE from aot_create_stack_sizes
-                 */
-                if (stack_sizes[i] == (uint32)-1) {
-                    if (func_ctx->stack_consumption_for_func_call != 0) {
-                        /*
-                         * This happens if a function calling another
-                         * function has been optimized out.
-                         *
-                         * for example,
-                         *
-                         *   (func $func
-                         *     (local i32)
-                         *     local.get 0
-                         *     if
-                         *       call $another
-                         *     end
-                         *   )
-                         */
-                        LOG_VERBOSE("AOT func#%" PRIu32
-                                    " had call(s) but eliminated?",
-                                    i);
-                    }
-                    else {
-                        LOG_VERBOSE("AOT func#%" PRIu32 " eliminated?", i);
-                    }
-                    stack_sizes[i] = 0;
-                }
-                else {
-                    LOG_VERBOSE("AOT func#%" PRIu32 " stack_size %u + %" PRIu32
-                                " + %u",
-                                i, stack_consumption_to_call_wrapped_func,
-                                stack_sizes[i],
-                                func_ctx->stack_consumption_for_func_call);
-                    if (UINT32_MAX - stack_sizes[i]
-                        < func_ctx->stack_consumption_for_func_call) {
-                        aot_set_last_error("stack size overflow.");
-                        goto fail;
-                    }
-                    stack_sizes[i] += func_ctx->stack_consumption_for_func_call;
-                    if (UINT32_MAX - stack_sizes[i]
-                        < stack_consumption_to_call_wrapped_func) {
-                        aot_set_last_error("stack size overflow.");
-                        goto fail;
-                    }
-                    stack_sizes[i] += stack_consumption_to_call_wrapped_func;
-                }
-            }
             LLVMDisposeSectionIterator(sec_itr);
             LLVMDisposeSymbolIterator(sym_itr);
             return true;
@@ -3657,7 +3725,7 @@ aot_resolve_functions(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
     AOTObjectFunc *func;
     LLVMSymbolIteratorRef sym_itr;
     char *name, *prefix = AOT_FUNC_PREFIX;
-    uint32 func_index, total_size;
+    uint32 func_index, func_begin, func_end, total_size;
 
     /* allocate memory for aot function */
     obj_data->func_count = comp_ctx->comp_data->func_count;
@@ -3674,6 +3742,9 @@ aot_resolve_functions(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
         memset(obj_data->funcs, 0, total_size);
     }
 
+    /* aot_func#n of the other partitions are undefined symbols */
+    get_obj_data_func_range(obj_data, &func_begin, &func_end);
+
     if (!(sym_itr = LLVMObjectFileCopySymbolIterator(obj_data->binary))) {
         aot_set_last_error("llvm get symbol iterator failed.");
         return false;
@@ -3684,7 +3755,7 @@ aot_resolve_functions(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
             && str_starts_with(name, prefix)) {
             /* symbol aot_func#n */
             func_index = (uint32)atoi(name + strlen(prefix));
-            if (func_index < obj_data->func_count) {
+            if (func_index >= func_begin && func_index < func_end) {
                 LLVMSectionIteratorRef contain_section;
                 char *contain_section_name;
 
@@ -3723,7 +3794,7 @@ aot_resolve_functions(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
                  && str_starts_with(name, AOT_FUNC_INTERNAL_PREFIX)) {
             /* symbol aot_func_internal#n */
             func_index = (uint32)atoi(name + strlen(AOT_FUNC_INTERNAL_PREFIX));
-            if (func_index < obj_data->func_count) {
+            if (func_index >= func_begin && func_index < func_end) {
                 LLVMSectionIteratorRef contain_section;
                 char *contain_section_name;
 
@@ -4258,9 +4329,85 @@ aot_obj_data_destroy(AOTObjectData *obj_data)
         destroy_relocation_symbol_list(&obj_data->symbol_list);
     if (obj_data->stack_sizes)
         wasm_runtime_free(obj_data->stack_sizes);
+    if (obj_data->text && obj_data->is_text_allocated)
+        wasm_runtime_free(obj_data->text);
+    if (obj_data->literal && obj_data->is_literal_allocated)
+        wasm_runtime_free(obj_data->literal);
+    if (obj_data->partitions) {
+        uint32 i;
+        for (i = 0; i < obj_data->partition_count; i++) {
+            if (obj_data->partitions[i])
+                aot_obj_data_destroy(obj_data->partitions[i]);
+        }
+        wasm_runtime_free(obj_data->partitions);
+    }
     wasm_runtime_free(obj_data);
 }
 
+/**
+ * Resolve the object file emitted to obj_data->mem_buf, it is called by
+ * the compilation threads for the partitions, don't print the time here.
+ */
+static bool
+aot_obj_data_resolve(AOTCompContext *comp_ctx, AOTObjectData *obj_data)
+{
+    char *err = NULL;
+
+    if (!(obj_data->binary = LLVMCreateBinary(obj_data->mem_buf, NULL, &err))) {
+        if (err) {
+            LLVMDisposeMessage(err);
+            err = NULL;
+        }
+        aot_set_last_error("llvm create binary failed.");
+        return false;
+    }
+
+    /* Create wasm feature flags form compile options */
+    obj_data->target_info.feature_flags = 0;
+    if (comp_ctx->enable_simd) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_SIMD_128BIT;
+    }
+    if (comp_ctx->enable_bulk_memory) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_BULK_MEMORY;
+    }
+    if (comp_ctx->enable_thread_mgr) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_MULTI_THREAD;
+    }
+    if (comp_ctx->enable_ref_types) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_REF_TYPES;
+    }
+    if (comp_ctx->enable_gc) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_GARBAGE_COLLECTION;
+    }
+    if (comp_ctx->enable_fuel_metering) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_FUEL_METERING;
+    }
+    if (comp_ctx->enable_safepoint_page) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_SAFEPOINT_PAGE;
+    }
+    if (comp_ctx->enable_gc_write_barrier) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_GC_WRITE_BARRIER;
+    }
+    if (comp_ctx->enable_gc_pre_write_barrier) {
+        obj_data->target_info.feature_flags |=
+            WASM_FEATURE_GC_PRE_WRITE_BARRIER;
+    }
+    if (comp_ctx->enable_shared_heap) {
+        obj_data->target_info.feature_flags |= WASM_FEATURE_SHARED_HEAP;
+    }
+
+    /* resolve target info/text/relocations/functions */
+    if (!aot_resolve_target_info(comp_ctx, obj_data)
+        || !aot_resolve_text(obj_data) || !aot_resolve_literal(obj_data)
+        || !aot_resolve_object_data_sections(obj_data)
+        || !aot_resolve_functions(comp_ctx, obj_data)
+        || !aot_resolve_object_relocation_groups(obj_data))
+        return false;
+
+
+    return true;
+}
+
 static AOTObjectData *
 aot_obj_data_create(AOTCompContext *comp_ctx)
 {
@@ -4394,60 +4541,1163 @@ aot_obj_data_create(AOTCompContext *comp_ctx)
         }
     }
 
-    if (!(obj_data->binary = LLVMCreateBinary(obj_data->mem_buf, NULL, &err))) {
-        if (err) {
-            LLVMDisposeMessage(err);
-            err = NULL;
-        }
-        aot_set_last_error("llvm create binary failed.");
+    bh_print_time("Begin to resolve object file info");
+
+    if (!aot_obj_data_resolve(comp_ctx, obj_data))
         goto fail;
-    }
 
-    /* Create wasm feature flags form compile options */
-    obj_data->target_info.feature_flags = 0;
-    if (comp_ctx->enable_simd) {
-        obj_data->target_info.feature_flags |= WASM_FEATURE_SIMD_128BIT;
+    return obj_data;
+
+fail:
+    aot_obj_data_destroy(obj_data);
+    return NULL;
+}
+
+static bool
+is_text_section_name(const char *name)
+{
+    return !strcmp(name, ".text") || !strcmp(name, ".ltext");
+}
+
+static int32
+get_data_section_index(const AOTObjectData *obj_data, const char *name)
+{
+    uint32 i;
+
+    for (i = 0; i < obj_data->data_sections_count; i++) {
+        if (!strcmp(obj_data->data_sections[i].name, name))
+            return (int32)i;
     }
-    if (comp_ctx->enable_bulk_memory) {
-        obj_data->target_info.feature_flags |= WASM_FEATURE_BULK_MEMORY;
+    return -1;
+}
+
+static uint32
+get_data_section_align(const char *name)
+{
+    uint32 align;
+
+    /* ".rodata.cstN" holds constants of N bytes aligned to N bytes */
+    if (str_starts_with(name, ".rodata.cst")
+        && (align = (uint32)atoi(name + strlen(".rodata.cst"))) > 16
+        && (align & (align - 1)) == 0)
+        return align;
+    return 16;
+}
+
+/* LLVM recurses deeply in some passes, give the compilation threads
+   the same stack size as the main thread usually has */
+#define AOT_PARTITION_THREAD_STACK_SIZE (8 * 1024 * 1024)
+
+typedef struct AOTPartitionThreadArg {
+    AOTCompContext *comp_ctx;
+    LLVMMemoryBufferRef bitcode;
+    uint32 partition_index;
+    AOTObjectData *obj_data;
+    /* The last error is thread local, the error of the thread is
+       reported by the main thread */
+    char error[128];
+} AOTPartitionThreadArg;
+
+/* The section and the offset of a global defined in the last partition,
+   which is referenced by the other partitions with its alias */
+typedef struct AOTPartitionGlobal {
+    const char *section_name;
+    uint32 offset;
+} AOTPartitionGlobal;
+
+/**
+ * Emit the object of the partition, the module of the partition is read
+ * from the bitcode of the optimized module into its own LLVM context, and
+ * only the functions of the partition are kept.
+ */
+static AOTObjectData *
+aot_obj_data_create_partition(AOTCompContext *comp_ctx,
+                              LLVMMemoryBufferRef bitcode,
+                              uint32 partition_index)
+{
+    AOTCompPartition *partition = comp_ctx->partitions + partition_index;
+    AOTObjectData *obj_data;
+    LLVMContextRef context = NULL;
+    LLVMModuleRef module = NULL;
+    uint64 begin_time = os_time_get_boot_us();
+    char *err = NULL;
+
+    if (!(obj_data = wasm_runtime_malloc(sizeof(AOTObjectData)))) {
+        aot_set_last_error("allocate memory failed.");
+        return NULL;
     }
-    if (comp_ctx->enable_thread_mgr) {
-        obj_data->target_info.feature_flags |= WASM_FEATURE_MULTI_THREAD;
+    memset(obj_data, 0, sizeof(AOTObjectData));
+    obj_data->comp_ctx = comp_ctx;
+    obj_data->partition = partition;
+
+    if (!(context = LLVMContextCreate())) {
+        aot_set_last_error("create LLVM context failed.");
+        goto fail;
     }
-    if (comp_ctx->enable_ref_types) {
-        obj_data->target_info.feature_flags |= WASM_FEATURE_REF_TYPES;
+
+    if (LLVMParseBitcodeInContext2(context, bitcode, &module)) {
+        aot_set_last_error("parse LLVM bitcode failed.");
+        goto fail;
     }
-    if (comp_ctx->enable_gc) {
-        obj_data->target_info.feature_flags |= WASM_FEATURE_GARBAGE_COLLECTION;
+
+    if (!aot_extract_module_partition(comp_ctx, module, partition_index))
+        goto fail;
+
+    if (LLVMTargetMachineEmitToMemoryBuffer(partition->target_machine, module,
+                                            LLVMObjectFile, &err,
+                                            &obj_data->mem_buf)
+        != 0) {
+        if (err) {
+            LLVMDisposeMessage(err);
+            err = NULL;
+        }
+        aot_set_last_error("llvm emit to memory buffer failed.");
+        goto fail;
     }
 
-    bh_print_time("Begin to resolve object file info");
+    /* The module isn't used by the object file */
+    LLVMDisposeModule(module);
+    module = NULL;
+    LLVMContextDispose(context);
+    context = NULL;
 
-    /* resolve target info/text/relocations/functions */
-    if (!aot_resolve_target_info(comp_ctx, obj_data)
-        || !aot_resolve_text(obj_data) || !aot_resolve_literal(obj_data)
-        || !aot_resolve_object_data_sections(obj_data)
-        || !aot_resolve_functions(comp_ctx, obj_data)
-        || !aot_resolve_object_relocation_groups(obj_data))
+    if (!aot_obj_data_resolve(comp_ctx, obj_data))
         goto fail;
 
+    LOG_VERBOSE("AOT partition %" PRIu32 " emitted in %" PRIu64 " ms.",
+                partition_index, (os_time_get_boot_us() - begin_time) / 1000);
     return obj_data;
 
 fail:
+    if (module)
+        LLVMDisposeModule(module);
+    if (context)
+        LLVMContextDispose(context);
     aot_obj_data_destroy(obj_data);
     return NULL;
 }
 
-uint8 *
-aot_emit_aot_file_buf(AOTCompContext *comp_ctx, AOTCompData *comp_data,
-                      uint32 *p_aot_file_size)
+static void *
+aot_partition_thread_start(void *arg)
 {
-    AOTObjectData *obj_data = aot_obj_data_create(comp_ctx);
-    uint8 *aot_file_buf, *buf, *buf_end;
-    uint32 aot_file_size, offset = 0;
+    AOTPartitionThreadArg *thread_arg = (AOTPartitionThreadArg *)arg;
 
-    if (!obj_data)
-        return NULL;
+    if (!(thread_arg->obj_data = aot_obj_data_create_partition(
+              thread_arg->comp_ctx, thread_arg->bitcode,
+              thread_arg->partition_index)))
+        snprintf(thread_arg->error, sizeof(thread_arg->error), "%s",
+                 aot_get_last_error());
+    return NULL;
+}
+
+/* Emit the objects of the partitions in parallel, the first partition
+   is emitted by the current thread */
+static bool
+aot_emit_partitions(AOTCompContext *comp_ctx, LLVMMemoryBufferRef bitcode,
+                    AOTObjectData **partitions)
+{
+    AOTPartitionThreadArg *thread_args;
+    korp_tid *tids;
+    uint32 partition_count = comp_ctx->partition_count, i, thread_count;
+    uint64 size;
+    bool ret = true;
+
+    size = (sizeof(AOTPartitionThreadArg) + sizeof(korp_tid))
+           * (uint64)partition_count;
+    if (size >= UINT32_MAX
+        || !(thread_args = wasm_runtime_malloc((uint32)size))) {
+        aot_set_last_error("allocate memory failed.");
+        return false;
+    }
+    memset(thread_args, 0, (uint32)size);
+    tids = (korp_tid *)(thread_args + partition_count);
+
+    for (i = 0; i < partition_count; i++) {
+        thread_args[i].comp_ctx = comp_ctx;
+        thread_args[i].bitcode = bitcode;
+        thread_args[i].partition_index = i;
+    }
+
+    for (thread_count = 1; thread_count < partition_count; thread_count++) {
+        if (os_thread_create(&tids[thread_count], aot_partition_thread_start,
+                             &thread_args[thread_count],
+                             AOT_PARTITION_THREAD_STACK_SIZE)
+            != 0) {
+            aot_set_last_error("create compilation thread failed.");
+            ret = false;
+            break;
+        }
+    }
+
+    if (ret)
+        aot_partition_thread_start(&thread_args[0]);
+
+    for (i = 1; i < thread_count; i++)
+        os_thread_join(tids[i], NULL);
+
+    for (i = 0; i < partition_count; i++) {
+        partitions[i] = thread_args[i].obj_data;
+        /* Report the error of the first partition failed */
+        if (ret && !partitions[i]) {
+            aot_set_last_error(thread_args[i].error);
+            ret = false;
+        }
+    }
+
+    wasm_runtime_free(thread_args);
+    return ret;
+}
+
+/**
+ * Get the alignment of the section of an ELF64 little-endian object, the
+ * section is looked up by its contents.
+ */
+static bool
+get_elf64_section_align(const AOTObjectData *obj_data, const void *contents,
+                        uint32 size, uint64 *p_align)
+{
+    const uint8 *buf = (const uint8 *)LLVMGetBufferStart(obj_data->mem_buf);
+    uint64 buf_size = LLVMGetBufferSize(obj_data->mem_buf);
+    uint64 offset = (uint64)((const uint8 *)contents - buf);
+    struct elf64_ehdr ehdr;
+    struct elf64_shdr shdr;
+    uint32 i;
+
+    if (buf_size < sizeof(ehdr))
+        return false;
+    bh_memcpy_s(&ehdr, sizeof(ehdr), buf, sizeof(ehdr));
+    if (!is_little_endian()) {
+        exchange_uint64((uint8 *)&ehdr.e_shoff);
+        exchange_uint16((uint8 *)&ehdr.e_shentsize);
+        exchange_uint16((uint8 *)&ehdr.e_shnum);
+    }
+    if (ehdr.e_shentsize != sizeof(shdr) || ehdr.e_shoff > buf_size
+        || (buf_size - ehdr.e_shoff) / sizeof(shdr) < ehdr.e_shnum)
+        return false;
+
+    for (i = 0; i < ehdr.e_shnum; i++) {
+        bh_memcpy_s(&shdr, sizeof(shdr),
+                    buf + ehdr.e_shoff + sizeof(shdr) * (uint64)i,
+                    sizeof(shdr));
+        if (!is_little_endian()) {
+            exchange_uint64((uint8 *)&shdr.sh_offset);
+            exchange_uint64((uint8 *)&shdr.sh_size);
+            exchange_uint64((uint8 *)&shdr.sh_addralign);
+        }
+        if (shdr.sh_offset == offset && shdr.sh_size == size) {
+            *p_align = shdr.sh_addralign > 0 ? shdr.sh_addralign : 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Get the sections and the offsets of the globals defined in the last
+ * partition from their aliases, see aot_extract_module_partition.
+ */
+static bool
+aot_resolve_partition_globals(AOTObjectData *obj_data,
+                              AOTPartitionGlobal **p_globals,
+                              uint32 *p_global_count)
+{
+    AOTObjectData *last = obj_data->partitions[obj_data->partition_count - 1];
+    AOTPartitionGlobal *globals = NULL;
+    LLVMSymbolIteratorRef sym_itr;
+    LLVMSectionIteratorRef sec_itr;
+    const char *name;
+    uint32 global_count = 0, index, size;
+
+    /* Get the count of the globals */
+    if (!(sym_itr = LLVMObjectFileCopySymbolIterator(last->binary))) {
+        aot_set_last_error("llvm get symbol iterator failed.");
+        return false;
+    }
+    while (!LLVMObjectFileIsSymbolIteratorAtEnd(last->binary, sym_itr)) {
+        if ((name = LLVMGetSymbolName(sym_itr))
+            && str_starts_with(name, AOT_PARTITION_GLOBAL_PREFIX)) {
+            index = (uint32)atoi(name + strlen(AOT_PARTITION_GLOBAL_PREFIX));
+            if (index >= global_count)
+                global_count = index + 1;
+        }
+        LLVMMoveToNextSymbol(sym_itr);
+    }
+    LLVMDisposeSymbolIterator(sym_itr);
+
+    if (global_count > 0) {
+        size = (uint32)sizeof(AOTPartitionGlobal) * global_count;
+        if (!(globals = wasm_runtime_malloc(size))) {
+            aot_set_last_error("allocate memory failed.");
+            return false;
+        }
+        memset(globals, 0, size);
+
+        if (!(sym_itr = LLVMObjectFileCopySymbolIterator(last->binary))) {
+            aot_set_last_error("llvm get symbol iterator failed.");
+            wasm_runtime_free(globals);
+            return false;
+        }
+        while (!LLVMObjectFileIsSymbolIteratorAtEnd(last->binary, sym_itr)) {
+            if ((name = LLVMGetSymbolName(sym_itr))
+                && str_starts_with(name, AOT_PARTITION_GLOBAL_PREFIX)) {
+                index =
+                    (uint32)atoi(name + strlen(AOT_PARTITION_GLOBAL_PREFIX));
+                if (!(sec_itr =
+                          LLVMObjectFileCopySectionIterator(last->binary))) {
+                    aot_set_last_error("llvm get section iterator failed.");
+                    LLVMDisposeSymbolIterator(sym_itr);
+                    wasm_runtime_free(globals);
+                    return false;
+                }
+                LLVMMoveToContainingSection(sec_itr, sym_itr);
+                /* Only the globals in the data sections can be
+                   referenced */
+                if (!LLVMObjectFileIsSectionIteratorAtEnd(last->binary,
+                                                          sec_itr)
+                    && get_data_section_index(last, LLVMGetSectionName(sec_itr))
+                           >= 0) {
+                    globals[index].section_name = LLVMGetSectionName(sec_itr);
+                    globals[index].offset =
+                        (uint32)LLVMGetSymbolAddress(sym_itr);
+                }
+                LLVMDisposeSectionIterator(sec_itr);
+            }
+            LLVMMoveToNextSymbol(sym_itr);
+        }
+        LLVMDisposeSymbolIterator(sym_itr);
+    }
+
+    *p_globals = globals;
+    *p_global_count = global_count;
+    return true;
+}
+
+static const AOTPartitionGlobal *
+get_partition_global(const AOTPartitionGlobal *globals, uint32 global_count,
+                     const char *name)
+{
+    uint32 index;
+
+    if (!str_starts_with(name, AOT_PARTITION_GLOBAL_PREFIX))
+        return NULL;
+    index = (uint32)atoi(name + strlen(AOT_PARTITION_GLOBAL_PREFIX));
+    return index < global_count && globals[index].section_name
+               ? globals + index
+               : NULL;
+}
+
+/* Get the size of the data sections of the name in the partitions before
+   the partition */
+static uint32
+get_partition_data_offset(const AOTObjectData *obj_data,
+                          uint32 partition_index, const char *name)
+{
+    const AOTObjectData *part;
+    uint32 i, offset = 0;
+    int32 idx;
+
+    for (i = 0; i < partition_index; i++) {
+        part = obj_data->partitions[i];
+        if ((idx = get_data_section_index(part, name)) >= 0)
+            offset += part->data_sections[idx].size;
+    }
+    return offset;
+}
+
+/**
+ * Check whether the objects of the partitions can be merged into the
+ * object emitted from the whole module: the functions and the data of
+ * each partition are placed after the ones of the previous partitions
+ * in the same sections, the gaps between them are the paddings to the
+ * alignments of the functions and the data of the partition, which are
+ * only known for the text.
+ */
+static bool
+can_merge_partitions(const AOTObjectData *obj_data,
+                     const AOTPartitionGlobal *globals, uint32 global_count)
+{
+    const AOTObjectData *part;
+    const AOTObjectDataSection *data_section;
+    const AOTRelocationGroup *group;
+    const AOTRelocation *relocation;
+    const char *section_name;
+    uint64 align;
+    uint32 i, j, k;
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+
+        if (LLVMBinaryGetType(part->binary) != LLVMBinaryTypeELF64L
+            || part->literal_size > 0 || part->text_unlikely_size > 0
+            || part->text_hot_size > 0)
+            return false;
+
+        if (part->text_size > 0
+            && !get_elf64_section_align(part, part->text, part->text_size,
+                                        &align))
+            return false;
+
+        for (j = 0; j < part->data_sections_count; j++) {
+            data_section = part->data_sections + j;
+            if (data_section->size == 0)
+                continue;
+            if (data_section->is_data_allocated
+                || !get_elf64_section_align(part, data_section->data,
+                                            data_section->size, &align)
+                || get_partition_data_offset(obj_data, i, data_section->name)
+                           % align
+                       != 0)
+                return false;
+        }
+
+        for (j = 0; j < part->relocation_group_count; j++) {
+            group = part->relocation_groups + j;
+            /* The addends of REL relocations are stored in the sections */
+            if (!str_starts_with(group->section_name, ".rela"))
+                return false;
+            section_name = group->section_name + strlen(".rela");
+            if (!is_text_section_name(section_name)
+                && get_data_section_index(part, section_name) < 0)
+                return false;
+
+            relocation = group->relocations;
+            for (k = 0; k < group->relocation_count; k++, relocation++) {
+                if (str_starts_with(relocation->symbol_name,
+                                    AOT_PARTITION_GLOBAL_PREFIX)
+                    && !get_partition_global(globals, global_count,
+                                             relocation->symbol_name))
+                    return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Concatenate the text of the partitions, the text of each partition is
+ * aligned to its alignment, and padded with the nops like the assembler
+ * does when the whole module is emitted.
+ */
+static bool
+aot_merge_partition_text(AOTObjectData *obj_data, uint32 *text_offsets)
+{
+    AOTObjectData *part;
+    uint64 align;
+    uint32 i, text_size = 0, offset;
+    uint8 *text;
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        text_offsets[i] = text_size;
+        if (part->text_size > 0) {
+            get_elf64_section_align(part, part->text, part->text_size, &align);
+            text_offsets[i] = align_uint(text_size, (uint32)align);
+            text_size = text_offsets[i] + part->text_size;
+        }
+    }
+
+    if (text_size == 0)
+        return true;
+
+    if (!(text = wasm_runtime_malloc(text_size))) {
+        aot_set_last_error("allocate memory for text failed.");
+        return false;
+    }
+    obj_data->text = text;
+    obj_data->text_size = text_size;
+    obj_data->is_text_allocated = true;
+
+    for (i = 0, offset = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        if (part->text_size == 0)
+            continue;
+        if (text_offsets[i] > offset
+            && !aot_get_code_padding(part->partition->target_machine,
+                                     text + offset, text_offsets[i] - offset))
+            return false;
+        bh_memcpy_s(text + text_offsets[i], text_size - text_offsets[i],
+                    part->text, part->text_size);
+        offset = text_offsets[i] + part->text_size;
+    }
+    return true;
+}
+
+static bool
+aot_merge_partition_funcs(AOTObjectData *obj_data, const uint32 *text_offsets,
+                          uint32 **data_offsets)
+{
+    AOTObjectData *part,
+        *last = obj_data->partitions[obj_data->partition_count - 1];
+    uint32 i, j, size;
+    int32 idx;
+
+    obj_data->func_count = obj_data->comp_ctx->comp_data->func_count;
+    if (obj_data->func_count == 0)
+        return true;
+
+    size = (uint32)sizeof(AOTObjectFunc) * obj_data->func_count;
+    if (!(obj_data->funcs = wasm_runtime_malloc(size))) {
+        aot_set_last_error("allocate memory for functions failed.");
+        return false;
+    }
+    memset(obj_data->funcs, 0, size);
+
+    if (last->stack_sizes) {
+        size = (uint32)sizeof(uint32) * obj_data->func_count;
+        if (!(obj_data->stack_sizes = wasm_runtime_malloc(size))) {
+            aot_set_last_error("allocate memory for stack sizes failed.");
+            return false;
+        }
+        /* The stack sizes are only defined in the last partition */
+        idx = get_data_section_index(last, last->stack_sizes_section_name);
+        bh_assert(idx >= 0);
+        obj_data->stack_sizes_section_name = last->stack_sizes_section_name;
+        obj_data->stack_sizes_offset =
+            last->stack_sizes_offset
+            + data_offsets[obj_data->partition_count - 1][idx];
+    }
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = part->partition->func_begin; j < part->partition->func_end;
+             j++) {
+            obj_data->funcs[j] = part->funcs[j];
+            obj_data->funcs[j].text_offset += text_offsets[i];
+            obj_data->funcs[j].text_offset_of_aot_func_internal +=
+                text_offsets[i];
+            if (obj_data->stack_sizes)
+                obj_data->stack_sizes[j] = part->stack_sizes[j];
+        }
+    }
+    return true;
+}
+
+/**
+ * Concatenate the data sections of the same name in the order of the
+ * partitions, data_offsets[i][j] is set to the offset of the j-th data
+ * section of partition i in the merged data section.
+ */
+static bool
+aot_merge_partition_data_sections(AOTObjectData *obj_data,
+                                  uint32 **data_offsets)
+{
+    AOTObjectData *part;
+    AOTObjectDataSection *data_section, *part_section;
+    uint32 i, j, count = 0, size;
+    int32 idx;
+
+    for (i = 0; i < obj_data->partition_count; i++)
+        count += obj_data->partitions[i]->data_sections_count;
+    if (count == 0)
+        return true;
+
+    size = (uint32)sizeof(AOTObjectDataSection) * count;
+    if (!(obj_data->data_sections = wasm_runtime_malloc(size))) {
+        aot_set_last_error("allocate memory for data sections failed.");
+        return false;
+    }
+    memset(obj_data->data_sections, 0, size);
+
+    /* The sections are in the order they are created when emitting the
+       whole module, which is the order of the first partitions having
+       them */
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = 0; j < part->data_sections_count; j++) {
+            part_section = part->data_sections + j;
+            idx = get_data_section_index(obj_data, part_section->name);
+            if (idx < 0) {
+                idx = (int32)obj_data->data_sections_count++;
+                obj_data->data_sections[idx].name = part_section->name;
+            }
+            data_section = obj_data->data_sections + idx;
+            /* No padding is required, see can_merge_partitions */
+            data_offsets[i][j] = data_section->size;
+            data_section->size += part_section->size;
+        }
+    }
+
+    for (i = 0; i < obj_data->data_sections_count; i++) {
+        data_section = obj_data->data_sections + i;
+        if (data_section->size == 0)
+            continue;
+        if (!(data_section->data = wasm_runtime_malloc(data_section->size))) {
+            aot_set_last_error("allocate memory for data section failed.");
+            return false;
+        }
+        data_section->is_data_allocated = true;
+    }
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = 0; j < part->data_sections_count; j++) {
+            part_section = part->data_sections + j;
+            if (part_section->size == 0)
+                continue;
+            idx = get_data_section_index(obj_data, part_section->name);
+            data_section = obj_data->data_sections + idx;
+            bh_memcpy_s(data_section->data + data_offsets[i][j],
+                        data_section->size - data_offsets[i][j],
+                        part_section->data, part_section->size);
+        }
+    }
+    return true;
+}
+
+static int32
+get_relocation_group_index(const AOTObjectData *obj_data, const char *name)
+{
+    uint32 i;
+
+    for (i = 0; i < obj_data->relocation_group_count; i++) {
+        if (!strcmp(obj_data->relocation_groups[i].section_name, name))
+            return (int32)i;
+    }
+    return -1;
+}
+
+/**
+ * Concatenate the relocations of the relocation groups of the same name
+ * in the order of the partitions, the relocation offsets and the addends
+ * of the relocations to the sections are rebased to the merged sections,
+ * and the relocations to the aliases of the globals are converted to the
+ * relocations to their sections.
+ */
+static bool
+aot_merge_partition_relocation_groups(AOTObjectData *obj_data,
+                                      const uint32 *text_offsets,
+                                      uint32 **data_offsets,
+                                      const AOTPartitionGlobal *globals,
+                                      uint32 global_count)
+{
+    AOTObjectData *part;
+    AOTRelocationGroup *group, *part_group;
+    AOTRelocation *relocation, *part_relocation;
+    const AOTPartitionGlobal *global;
+    uint32 last_index = obj_data->partition_count - 1;
+    uint32 i, j, k, count = 0, size, base;
+    int32 idx;
+
+    for (i = 0; i < obj_data->partition_count; i++)
+        count += obj_data->partitions[i]->relocation_group_count;
+    if (count == 0)
+        return true;
+
+    size = (uint32)sizeof(AOTRelocationGroup) * count;
+    if (!(obj_data->relocation_groups = wasm_runtime_malloc(size))) {
+        aot_set_last_error("allocate memory for relocation groups failed.");
+        return false;
+    }
+    memset(obj_data->relocation_groups, 0, size);
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = 0; j < part->relocation_group_count; j++) {
+            part_group = part->relocation_groups + j;
+            idx = get_relocation_group_index(obj_data,
+                                             part_group->section_name);
+            if (idx < 0) {
+                idx = (int32)obj_data->relocation_group_count++;
+                obj_data->relocation_groups[idx].section_name =
+                    part_group->section_name;
+            }
+            obj_data->relocation_groups[idx].relocation_count +=
+                part_group->relocation_count;
+        }
+    }
+
+    for (i = 0; i < obj_data->relocation_group_count; i++) {
+        group = obj_data->relocation_groups + i;
+        size = (uint32)sizeof(AOTRelocation) * group->relocation_count;
+        if (!(group->relocations = wasm_runtime_malloc(size))) {
+            aot_set_last_error("allocate memory for relocations failed.");
+            return false;
+        }
+        memset(group->relocations, 0, size);
+        /* Count the relocations merged again */
+        group->relocation_count = 0;
+    }
+
+    for (i = 0; i < obj_data->partition_count; i++) {
+        part = obj_data->partitions[i];
+        for (j = 0; j < part->relocation_group_count; j++) {
+            part_group = part->relocation_groups + j;
+            group = obj_data->relocation_groups
+                    + get_relocation_group_index(obj_data,
+                                                 part_group->section_name);
+
+            base = is_text_section_name(part_group->section_name
+                                        + strlen(".rela"))
+                       ? text_offsets[i]
+                       : data_offsets[i][get_data_section_index(
+                           part, part_group->section_name + strlen(".rela"))];
+
+            part_relocation = part_group->relocations;
+            relocation = group->relocations + group->relocation_count;
+            for (k = 0; k < part_group->relocation_count;
+                 k++, part_relocation++, relocation++) {
+                /* The symbol name is freed with the merged object */
+                *relocation = *part_relocation;
+                part_relocation->is_symbol_name_allocated = false;
+
+                relocation->relocation_offset += base;
+                if (is_text_section_name(relocation->symbol_name)) {
+                    relocation->relocation_addend += text_offsets[i];
+                }
+                else if ((global = get_partition_global(
+                              globals, global_count, relocation->symbol_name))) {
+                    idx = get_data_section_index(
+                        obj_data->partitions[last_index],
+                        global->section_name);
+                    relocation->symbol_name = (char *)global->section_name;
+                    relocation->relocation_addend +=
+                        global->offset + data_offsets[last_index][idx];
+                }
+                else if ((idx = get_data_section_index(
+                              part, relocation->symbol_name))
+                         >= 0) {
+                    relocation->relocation_addend += data_offsets[i][idx];
+                }
+            }
+            group->relocation_count += part_group->relocation_count;
+        }
+    }
+    return true;
+}
+
+static bool
+aot_merge_partitions(AOTObjectData *obj_data, const AOTPartitionGlobal *globals,
+                     uint32 global_count)
+{
+    uint32 *text_offsets = NULL, **data_offsets = NULL, *p;
+    uint32 i, count = 0;
+    uint64 size;
+    bool ret = false;
+
+    for (i = 0; i < obj_data->partition_count; i++)
+        count += obj_data->partitions[i]->data_sections_count;
+
+    size = sizeof(uint32) * (uint64)obj_data->partition_count
+           + sizeof(uint32 *) * (uint64)obj_data->partition_count
+           + sizeof(uint32) * (uint64)count;
+    if (size >= UINT32_MAX
+        || !(text_offsets = wasm_runtime_malloc((uint32)size))) {
+        aot_set_last_error("allocate memory failed.");
+        return false;
+    }
+    memset(text_offsets, 0, (uint32)size);
+    data_offsets = (uint32 **)(text_offsets + obj_data->partition_count);
+    p = (uint32 *)(data_offsets + obj_data->partition_count);
+    for (i = 0; i < obj_data->partition_count; i++) {
+        data_offsets[i] = p;
+        p += obj_data->partitions[i]->data_sections_count;
+    }
+
+    obj_data->target_info = obj_data->partitions[0]->target_info;
+
+    if (!aot_merge_partition_text(obj_data, text_offsets)
+        || !aot_merge_partition_data_sections(obj_data, data_offsets)
+        || !aot_merge_partition_funcs(obj_data, text_offsets, data_offsets)
+        || !aot_merge_partition_relocation_groups(
+            obj_data, text_offsets, data_offsets, globals, global_count))
+        goto fail;
+
+    ret = true;
+
+fail:
+    wasm_runtime_free(text_offsets);
+    return ret;
+}
+
+/**
+ * Emit the object with multiple threads: the optimized module is written
+ * to bitcode, the object of each partition of the functions is emitted
+ * from it by a thread, then the objects are merged into the object which
+ * is the same as the one emitted from the whole module. The module is
+ * emitted by the current thread instead if it can't be split.
+ */
+static AOTObjectData *
+aot_obj_data_create_from_partitions(AOTCompContext *comp_ctx)
+{
+    AOTObjectData *obj_data;
+    AOTPartitionGlobal *globals = NULL;
+    LLVMMemoryBufferRef bitcode;
+    uint32 global_count = 0, size;
+
+    if (!aot_check_module_partitions(comp_ctx)) {
+        LOG_VERBOSE("The module can't be split into partitions, emit it "
+                    "with one thread.");
+        return aot_obj_data_create(comp_ctx);
+    }
+
+    bh_print_time("Begin to write LLVM bitcode");
+
+    if (!(bitcode = aot_write_module_bitcode(comp_ctx->module))) {
+        aot_set_last_error("write LLVM bitcode failed.");
+        return NULL;
+    }
+
+    if (!(obj_data = wasm_runtime_malloc(sizeof(AOTObjectData)))) {
+        aot_set_last_error("allocate memory failed.");
+        LLVMDisposeMemoryBuffer(bitcode);
+        return NULL;
+    }
+    memset(obj_data, 0, sizeof(AOTObjectData));
+    obj_data->comp_ctx = comp_ctx;
+
+    size = (uint32)sizeof(AOTObjectData *) * comp_ctx->partition_count;
+    if (!(obj_data->partitions = wasm_runtime_malloc(size))) {
+        aot_set_last_error("allocate memory failed.");
+        goto fail;
+    }
+    memset(obj_data->partitions, 0, size);
+    obj_data->partition_count = comp_ctx->partition_count;
+
+    bh_print_time("Begin to emit object files of partitions");
+
+    if (!aot_emit_partitions(comp_ctx, bitcode, obj_data->partitions))
+        goto fail;
+
+    bh_print_time("Begin to merge object files");
+
+    if (!aot_resolve_partition_globals(obj_data, &globals, &global_count))
+        goto fail;
+
+    if (!can_merge_partitions(obj_data, globals, global_count)) {
+        LOG_VERBOSE("The objects of the partitions can't be merged, emit "
+                    "the module with one thread.");
+        if (globals)
+            wasm_runtime_free(globals);
+        aot_obj_data_destroy(obj_data);
+        LLVMDisposeMemoryBuffer(bitcode);
+        return aot_obj_data_create(comp_ctx);
+    }
+
+    if (!aot_merge_partitions(obj_data, globals, global_count))
+        goto fail;
+
+    if (globals)
+        wasm_runtime_free(globals);
+    LLVMDisposeMemoryBuffer(bitcode);
+    return obj_data;
+
+fail:
+    if (globals)
+        wasm_runtime_free(globals);
+    aot_obj_data_destroy(obj_data);
+    LLVMDisposeMemoryBuffer(bitcode);
+    return NULL;
+}
+
+/* The alignment of the code in the AOT file emitted with shared text,
+   which is the page size of the supported targets */
+#define SHARED_TEXT_ALIGNMENT 4096
+
+/* R_X86_64_PC32 and R_X86_64_PLT32 */
+#define SHARED_TEXT_RELOC_PC32 2
+#define SHARED_TEXT_RELOC_PLT32 4
+
+static bool
+is_text_relocation_group(const char *name)
+{
+    return str_starts_with(name, ".rela.text")
+           || str_starts_with(name, ".rel.text")
+           || str_starts_with(name, ".rela.ltext")
+           || str_starts_with(name, ".rel.ltext");
+}
+
+static bool
+is_shared_text_data_section(const char *name)
+{
+    return !strcmp(name, ".rodata") || str_starts_with(name, ".rodata.cst")
+           || str_starts_with(name, ".rodata.str");
+}
+
+/* Check that a data section moved to the text isn't relocated or referenced
+   by the other sections, as it is no longer a data section of the AOT file */
+static bool
+check_shared_text_data_section(const AOTObjectData *obj_data,
+                               const uint32 *section_offsets, const char *name)
+{
+    int32 section_index = get_data_section_index(obj_data, name);
+    char buf[128];
+
+    if (section_index >= 0 && section_offsets[section_index] == 0) {
+        snprintf(buf, sizeof(buf),
+                 "shared text doesn't support relocating or referencing data "
+                 "section %s out of text.",
+                 name);
+        aot_set_last_error(buf);
+        return false;
+    }
+    return true;
+}
+
+static uint32
+get_text_section_body_offset(AOTCompContext *comp_ctx, AOTCompData *comp_data,
+                             AOTObjectData *obj_data)
+{
+    uint32 size = get_file_header_size();
+
+    /* target info section */
+    size = align_uint(size, 4);
+    size += (uint32)sizeof(uint32) * 2;
+    size += get_target_info_section_size();
+
+    /* init data section */
+    size = align_uint(size, 4);
+    size += (uint32)sizeof(uint32) * 2;
+    size += get_init_data_section_size(comp_ctx, comp_data, obj_data);
+
+    /* section id + section size of text section */
+    size = align_uint(size, 4);
+    return size + (uint32)sizeof(uint32) * 2;
+}
+
+/**
+ * Make the text of the AOT file ready to be mapped and executed in place
+ * without any modification: the read-only data sections referenced by the
+ * text are moved to the end of the text, the text relocations, which are
+ * all PC-relative in the indirect mode, are applied and removed, and the
+ * literal is used as the padding to make the code start at a page boundary
+ * of the AOT file. The text is also padded to a page boundary so that no
+ * other section shares its last page.
+ */
+static bool
+aot_resolve_shared_text(AOTCompContext *comp_ctx, AOTCompData *comp_data,
+                        AOTObjectData *obj_data)
+{
+    AOTRelocationGroup *group;
+    AOTRelocation *relocation;
+    AOTObjectDataSection *data_section;
+    const char *name;
+    uint32 *section_offsets = NULL, text_size, code_size, offset, i, j, k;
+    uint8 *text = NULL;
+    int32 section_index;
+    int64 value;
+    char buf[128];
+    bool ret = false;
+
+    if (obj_data->literal_size > 0) {
+        aot_set_last_error("shared text doesn't support literal section.");
+        return false;
+    }
+
+    if (obj_data->func_count == 0)
+        return true;
+
+    if (obj_data->data_sections_count > 0) {
+        uint32 size = (uint32)sizeof(uint32) * obj_data->data_sections_count;
+        if (!(section_offsets = wasm_runtime_malloc(size))) {
+            aot_set_last_error("allocate memory failed.");
+            return false;
+        }
+        memset(section_offsets, 0xFF, size);
+    }
+
+    /* Find out the read-only data sections referenced by the text */
+    group = obj_data->relocation_groups;
+    for (i = 0; i < obj_data->relocation_group_count; i++, group++) {
+        if (!is_text_relocation_group(group->section_name))
+            continue;
+        relocation = group->relocations;
+        for (j = 0; j < group->relocation_count; j++, relocation++) {
+            section_index =
+                get_data_section_index(obj_data, relocation->symbol_name);
+            if (section_index >= 0
+                && is_shared_text_data_section(relocation->symbol_name))
+                section_offsets[section_index] = 0;
+        }
+    }
+
+    /* The moved sections must not be relocated or referenced elsewhere */
+    group = obj_data->relocation_groups;
+    for (i = 0; i < obj_data->relocation_group_count; i++, group++) {
+        if (is_text_relocation_group(group->section_name))
+            continue;
+        name = group->section_name;
+        name += str_starts_with(name, ".rela") ? strlen(".rela")
+                : str_starts_with(name, ".rel") ? strlen(".rel")
+                                                : 0;
+        if (!check_shared_text_data_section(obj_data, section_offsets, name))
+            goto fail;
+        relocation = group->relocations;
+        for (j = 0; j < group->relocation_count; j++, relocation++) {
+            if (!check_shared_text_data_section(obj_data, section_offsets,
+                                                relocation->symbol_name))
+                goto fail;
+        }
+    }
+
+    /* Lay out the text as [text | unlikely text | hot text | data sections] */
+    code_size = align_uint(obj_data->text_size, 4)
+                + align_uint(obj_data->text_unlikely_size, 4)
+                + align_uint(obj_data->text_hot_size, 4);
+    text_size = code_size;
+    for (k = 0; k < obj_data->data_sections_count; k++) {
+        if (section_offsets[k] == 0) {
+            data_section = obj_data->data_sections + k;
+            text_size = align_uint(text_size,
+                                   get_data_section_align(data_section->name));
+            section_offsets[k] = text_size;
+            text_size += data_section->size;
+        }
+    }
+    text_size = align_uint(text_size, SHARED_TEXT_ALIGNMENT);
+
+    if (!(text = wasm_runtime_malloc(text_size))) {
+        aot_set_last_error("allocate memory for text failed.");
+        goto fail;
+    }
+    memset(text, 0, text_size);
+
+    offset = 0;
+    if (obj_data->text_size > 0)
+        bh_memcpy_s(text, text_size, obj_data->text, obj_data->text_size);
+    offset += align_uint(obj_data->text_size, 4);
+    if (obj_data->text_unlikely_size > 0)
+        bh_memcpy_s(text + offset, text_size - offset, obj_data->text_unlikely,
+                    obj_data->text_unlikely_size);
+    offset += align_uint(obj_data->text_unlikely_size, 4);
+    if (obj_data->text_hot_size > 0)
+        bh_memcpy_s(text + offset, text_size - offset, obj_data->text_hot,
+                    obj_data->text_hot_size);
+    for (k = 0; k < obj_data->data_sections_count; k++) {
+        if (section_offsets[k] != (uint32)-1) {
+            data_section = obj_data->data_sections + k;
+            bh_memcpy_s(text + section_offsets[k],
+                        text_size - section_offsets[k], data_section->data,
+                        data_section->size);
+        }
+    }
+
+    /* Apply the text relocations: S + A - P */
+    group = obj_data->relocation_groups;
+    for (i = 0; i < obj_data->relocation_group_count; i++, group++) {
+        if (!is_text_relocation_group(group->section_name))
+            continue;
+        relocation = group->relocations;
+        for (j = 0; j < group->relocation_count; j++, relocation++) {
+            name = relocation->symbol_name;
+            if (relocation->relocation_type != SHARED_TEXT_RELOC_PC32
+                && relocation->relocation_type != SHARED_TEXT_RELOC_PLT32) {
+                snprintf(buf, sizeof(buf),
+                         "shared text doesn't support relocation type %u "
+                         "of symbol %s.",
+                         relocation->relocation_type, name);
+                aot_set_last_error(buf);
+                goto fail;
+            }
+
+            if (is_text_section_name(name))
+                value = 0;
+            else if (str_starts_with(name, AOT_FUNC_INTERNAL_PREFIX)
+                     && (k = (uint32)atoi(name
+                                          + strlen(AOT_FUNC_INTERNAL_PREFIX)))
+                            < obj_data->func_count)
+                value = (int64)obj_data->funcs[k]
+                            .text_offset_of_aot_func_internal;
+            else if (str_starts_with(name, AOT_FUNC_PREFIX)
+                     && (k = (uint32)atoi(name + strlen(AOT_FUNC_PREFIX)))
+                            < obj_data->func_count)
+                value = (int64)obj_data->funcs[k].text_offset;
+            else if ((section_index = get_data_section_index(obj_data, name))
+                         >= 0
+                     && section_offsets[section_index] != (uint32)-1)
+                value = section_offsets[section_index];
+            else {
+                snprintf(buf, sizeof(buf),
+                         "shared text can't resolve symbol %s.", name);
+                aot_set_last_error(buf);
+                goto fail;
+            }
+
+            value += relocation->relocation_addend
+                     - (int64)relocation->relocation_offset;
+            if (relocation->relocation_offset + sizeof(int32) > code_size
+                || value < INT32_MIN || value > INT32_MAX) {
+                snprintf(buf, sizeof(buf),
+                         "shared text can't relocate symbol %s.", name);
+                aot_set_last_error(buf);
+                goto fail;
+            }
+            /* Store in little endian as the target is x86_64 */
+            for (k = 0; k < sizeof(int32); k++)
+                text[relocation->relocation_offset + k] =
+                    (uint8)((uint64)value >> (k * 8));
+
+            if (relocation->is_symbol_name_allocated) {
+                wasm_runtime_free(relocation->symbol_name);
+                relocation->is_symbol_name_allocated = false;
+            }
+        }
+        group->relocation_count = 0;
+    }
+
+    /* Remove the moved data sections */
+    for (j = k = 0; k < obj_data->data_sections_count; k++) {
+        data_section = obj_data->data_sections + k;
+        if (section_offsets[k] != (uint32)-1) {
+            if (data_section->is_name_allocated)
+                wasm_runtime_free(data_section->name);
+            if (data_section->is_data_allocated)
+                wasm_runtime_free(data_section->data);
+        }
+        else
+            obj_data->data_sections[j++] = *data_section;
+    }
+    obj_data->data_sections_count = j;
+
+    if (obj_data->is_text_allocated)
+        wasm_runtime_free(obj_data->text);
+    obj_data->text = text;
+    obj_data->text_size = text_size;
+    obj_data->is_text_allocated = true;
+    obj_data->text_unlikely_size = obj_data->text_hot_size = 0;
+    text = NULL;
+
+    /* Pad the code to a page boundary of the AOT file with the literal,
+       the code follows the text section header and the literal size */
+    offset = get_text_section_body_offset(comp_ctx, comp_data, obj_data)
+             + (uint32)sizeof(uint32);
+    obj_data->literal_size = align_uint(offset, SHARED_TEXT_ALIGNMENT) - offset;
+    if (obj_data->literal_size > 0) {
+        if (!(obj_data->literal =
+                  wasm_runtime_malloc(obj_data->literal_size))) {
+            aot_set_last_error("allocate memory for literal failed.");
+            obj_data->literal_size = 0;
+            goto fail;
+        }
+        memset(obj_data->literal, 0, obj_data->literal_size);
+        obj_data->is_literal_allocated = true;
+    }
+
+    ret = true;
+
+fail:
+    if (text)
+        wasm_runtime_free(text);
+    if (section_offsets)
+        wasm_runtime_free(section_offsets);
+    return ret;
+}
+
+uint8 *
+aot_emit_aot_file_buf(AOTCompContext *comp_ctx, AOTCompData *comp_data,
+                      uint32 *p_aot_file_size)
+{
+    AOTObjectData *obj_data = comp_ctx->partition_count > 1
+                                  ? aot_obj_data_create_from_partitions(comp_ctx)
+                                  : aot_obj_data_create(comp_ctx);
+    uint8 *aot_file_buf, *buf, *buf_end;
+    uint32 aot_file_size, offset = 0;
+
+    if (!obj_data)
+        return NULL;
+
+    if (comp_ctx->enable_shared_text
+        && !aot_resolve_shared_text(comp_ctx, comp_data, obj_data))
+        goto fail1;
 
     aot_file_size = get_aot_file_size(comp_ctx, comp_data, obj_data);
     if (aot_file_size == 0) {
@@ -19,6 +19,12 @@
 static char *block_name_prefix[] = { "block", "loop", "if" };
 static char *block_name_suffix[] = { "begin", "else", "end" };
 
+/* Whether the current thread can be terminated or suspended at the
+   backward jumps, by checking the suspend flags or polling the
+   safepoint page */
+#define CHECK_SUSPEND_AT_LOOP() \
+    (comp_ctx->enable_thread_mgr || comp_ctx->enable_safepoint_page)
+
 /* clang-format off */
 enum {
     LABEL_BEGIN = 0,
@@ -244,6 +250,9 @@ handle_next_reachable_block(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     aot_checked_addr_list_destroy(func_ctx);
     bh_assert(block);
 
+    /* The next reachable code is the target of some branches */
+    func_ctx->fuel_region_cost = 0;
+
 #if WASM_ENABLE_DEBUG_AOT != 0
     return_location = dwarf_gen_location(
         comp_ctx, func_ctx,
@@ -366,6 +375,11 @@ handle_next_reachable_block(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         }
     }
     if (block->label_type == LABEL_TYPE_FUNCTION) {
+        if (comp_ctx->enable_fuel_metering
+            && !aot_commit_fuel(comp_ctx, func_ctx)) {
+            goto fail;
+        }
+
         if (block->result_count) {
             /* Return the first return value */
             if (!(ret =
@@ -855,6 +869,23 @@ check_suspend_flags(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     bool is_shared_memory =
         comp_ctx->comp_data->memories[0].flags & 0x02 ? true : false;
 
+    if (comp_ctx->enable_safepoint_page) {
+        /* Poll the safepoint page with a plain load, the runtime makes
+           the page inaccessible to interrupt the thread and handles the
+           fault in its signal handler, no matter whether the memory is
+           shared or not */
+        if (!(res = LLVMBuildLoad2(comp_ctx->builder, INT8_TYPE,
+                                   func_ctx->safepoint_page,
+                                   "safepoint_poll"))) {
+            aot_set_last_error("llvm build LOAD failed");
+            return false;
+        }
+        /* Set it volatile so that it isn't removed or hoisted out of
+           the loop */
+        LLVMSetVolatile(res, true);
+        return true;
+    }
+
     /* Only need to check the suspend flags when memory is shared since
        shared memory must be enabled for multi-threading */
     if (!is_shared_memory) {
@@ -916,6 +947,62 @@ fail:
     return false;
 }
 
+bool
+aot_emit_fuel_charge(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                     uint32 cost)
+{
+    LLVMValueRef fuel, res;
+    LLVMBasicBlockRef check_fuel_succ;
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE, func_ctx->fuel,
+                                "fuel"))) {
+        aot_set_last_error("llvm build load failed");
+        return false;
+    }
+
+    if (!(fuel = LLVMBuildSub(comp_ctx->builder, fuel, I64_CONST(cost),
+                              "fuel_left"))) {
+        aot_set_last_error("llvm build sub failed");
+        return false;
+    }
+
+    /* Only the local copy is updated, it is written back to exec_env->fuel
+       by aot_commit_fuel before calls, returns and exceptions */
+    if (!LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel)) {
+        aot_set_last_error("llvm build store failed");
+        return false;
+    }
+
+    BUILD_ICMP(LLVMIntSLT, fuel, I64_ZERO, res, "out_of_fuel");
+
+    CREATE_BLOCK(check_fuel_succ, "check_fuel_succ");
+    MOVE_BLOCK_AFTER_CURR(check_fuel_succ);
+
+    if (!aot_emit_exception(comp_ctx, func_ctx, EXCE_OUT_OF_FUEL, true, res,
+                            check_fuel_succ)) {
+        goto fail;
+    }
+    return true;
+fail:
+    return false;
+}
+
+bool
+aot_reload_fuel(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef fuel;
+
+    /* The callee may have consumed the fuel or the host may have added
+       some */
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE,
+                                func_ctx->fuel_ptr, "fuel"))
+        || !LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel)) {
+        aot_set_last_error("llvm build load or store failed");
+        return false;
+    }
+    return true;
+}
+
 bool
 aot_compile_op_br(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                   uint32 br_depth, uint8 **p_frame_ip)
@@ -935,7 +1022,7 @@ aot_compile_op_br(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             return false;
 
         if (block_dst->label_type == LABEL_TYPE_LOOP) {
-            if (comp_ctx->enable_thread_mgr) {
+            if (CHECK_SUSPEND_AT_LOOP()) {
                 /* Commit sp when GC is enabled, don't commit ip */
                 if (!aot_gen_commit_sp_ip(comp_ctx->aot_frame,
                                           comp_ctx->enable_gc, false))
@@ -949,7 +1036,7 @@ aot_compile_op_br(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     }
 
     /* Terminate or suspend current thread only when this is a backward jump */
-    if (comp_ctx->enable_thread_mgr
+    if (CHECK_SUSPEND_AT_LOOP()
         && block_dst->label_type == LABEL_TYPE_LOOP) {
         if (!check_suspend_flags(comp_ctx, func_ctx, true))
             return false;
@@ -1016,7 +1103,7 @@ aot_compile_conditional_br(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             return false;
 
         if (block_dst->label_type == LABEL_TYPE_LOOP) {
-            if (comp_ctx->enable_thread_mgr) {
+            if (CHECK_SUSPEND_AT_LOOP()) {
                 /* Commit sp when GC is enabled, don't commit ip */
                 if (!aot_gen_commit_sp_ip(comp_ctx->aot_frame,
                                           comp_ctx->enable_gc, false))
@@ -1031,7 +1118,7 @@ aot_compile_conditional_br(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 
     /* Terminate or suspend current thread only when this is
        a backward jump */
-    if (comp_ctx->enable_thread_mgr
+    if (CHECK_SUSPEND_AT_LOOP()
         && block_dst->label_type == LABEL_TYPE_LOOP) {
         if (!check_suspend_flags(comp_ctx, func_ctx, true))
             return false;
@@ -1195,7 +1282,7 @@ aot_compile_op_br_table(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                 && !aot_gen_commit_values(comp_ctx->aot_frame))
                 return false;
 
-            if (comp_ctx->enable_thread_mgr) {
+            if (CHECK_SUSPEND_AT_LOOP()) {
                 /* Commit sp when GC is enabled, don't commit ip */
                 if (!aot_gen_commit_sp_ip(comp_ctx->aot_frame,
                                           comp_ctx->enable_gc, false))
@@ -1215,7 +1302,7 @@ aot_compile_op_br_table(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             }
         }
 
-        if (comp_ctx->enable_thread_mgr) {
+        if (CHECK_SUSPEND_AT_LOOP()) {
             for (i = 0; i <= br_count; i++) {
                 target_block = get_target_block(func_ctx, br_depths[i]);
                 if (!target_block)
@@ -1361,6 +1448,9 @@ aot_compile_op_return(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         (*p_frame_ip - 1) - comp_ctx->comp_data->wasm_module->buf_code);
 #endif
 
+    if (comp_ctx->enable_fuel_metering && !aot_commit_fuel(comp_ctx, func_ctx))
+        goto fail;
+
     if (block_func->result_count) {
         /* Store extra result values to function parameters */
         for (i = 0; i < block_func->result_count - 1; i++) {
@@ -1436,7 +1526,7 @@ commit_gc_and_check_suspend_flags(AOTCompContext *comp_ctx,
             return false;
 
         if (block_dst->label_type == LABEL_TYPE_LOOP) {
-            if (comp_ctx->enable_thread_mgr) {
+            if (CHECK_SUSPEND_AT_LOOP()) {
                 /* Note that GC is enabled, no need to check it again */
                 if (!aot_gen_commit_sp_ip(comp_ctx->aot_frame, true, false))
                     return false;
@@ -1450,7 +1540,7 @@ commit_gc_and_check_suspend_flags(AOTCompContext *comp_ctx,
 
     /* Terminate or suspend current thread only when this is
        a backward jump */
-    if (comp_ctx->enable_thread_mgr
+    if (CHECK_SUSPEND_AT_LOOP()
         && block_dst->label_type == LABEL_TYPE_LOOP) {
         if (!check_suspend_flags(comp_ctx, func_ctx, true))
             return false;
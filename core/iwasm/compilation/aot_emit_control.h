@@ -54,6 +54,13 @@ bool
 check_suspend_flags(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                     bool check_terminate_and_suspend);
 
+bool
+aot_emit_fuel_charge(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                     uint32 cost);
+
+bool
+aot_reload_fuel(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
+
 #if WASM_ENABLE_GC != 0
 bool
 aot_compile_op_br_on_null(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
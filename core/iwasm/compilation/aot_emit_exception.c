@@ -96,6 +96,13 @@ aot_emit_exception(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             }
         }
 
+        /* Write back the fuel left, aot_set_exception_with_id() doesn't
+           return if the exception is caught with the hardware trap */
+        if (comp_ctx->enable_fuel_metering && func_ctx->fuel
+            && !aot_commit_fuel(comp_ctx, func_ctx)) {
+            return false;
+        }
+
         /* Call aot_set_exception_with_id() to throw exception */
         param_types[0] = INT8_PTR_TYPE;
         param_types[1] = I32_TYPE;
@@ -52,6 +52,12 @@ create_func_return_block(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
         /* Create return IR */
         LLVMPositionBuilderAtEnd(comp_ctx->builder,
                                  func_ctx->func_return_block);
+        /* The callee has written back the fuel left, which is committed
+           again when this function returns */
+        if (comp_ctx->enable_fuel_metering
+            && !aot_reload_fuel(comp_ctx, func_ctx)) {
+            return false;
+        }
         if (!comp_ctx->enable_bound_check) {
             if (!aot_emit_exception(comp_ctx, func_ctx, EXCE_ALREADY_THROWN,
                                     false, NULL, NULL)) {
@@ -295,6 +295,92 @@ fail:
     return false;
 }
 
+static bool
+aot_call_wasm_obj_write_barrier(AOTCompContext *comp_ctx,
+                                AOTFuncContext *func_ctx, LLVMValueRef obj,
+                                LLVMValueRef ref)
+{
+    LLVMValueRef param_values[2], func, value;
+    LLVMTypeRef param_types[2], ret_type, func_type, func_ptr_type;
+
+    param_types[0] = GC_REF_TYPE;
+    param_types[1] = GC_REF_TYPE;
+    ret_type = VOID_TYPE;
+
+    GET_AOT_FUNCTION(wasm_obj_write_barrier, 2);
+
+    /* Call function wasm_obj_write_barrier() */
+    param_values[0] = obj;
+    param_values[1] = ref;
+    if (!LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values, 2,
+                        "")) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+
+    return true;
+fail:
+    return false;
+}
+
+static bool
+aot_call_wasm_obj_pre_write_barrier(AOTCompContext *comp_ctx,
+                                    AOTFuncContext *func_ctx,
+                                    LLVMValueRef old_value)
+{
+    LLVMValueRef param_values[1], func, value;
+    LLVMTypeRef param_types[1], ret_type, func_type, func_ptr_type;
+
+    param_types[0] = GC_REF_TYPE;
+    ret_type = VOID_TYPE;
+
+    GET_AOT_FUNCTION(wasm_obj_pre_write_barrier, 1);
+
+    /* Call function wasm_obj_pre_write_barrier() */
+    param_values[0] = old_value;
+    if (!LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values, 1,
+                        "")) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+
+    return true;
+fail:
+    return false;
+}
+
+static bool
+aot_call_wasm_array_obj_pre_write_barrier(AOTCompContext *comp_ctx,
+                                          AOTFuncContext *func_ctx,
+                                          LLVMValueRef array_obj,
+                                          LLVMValueRef elem_idx,
+                                          LLVMValueRef len)
+{
+    LLVMValueRef param_values[3], func, value;
+    LLVMTypeRef param_types[3], ret_type, func_type, func_ptr_type;
+
+    param_types[0] = GC_REF_TYPE;
+    param_types[1] = I32_TYPE;
+    param_types[2] = I32_TYPE;
+    ret_type = VOID_TYPE;
+
+    GET_AOT_FUNCTION(wasm_array_obj_pre_write_barrier, 3);
+
+    /* Call function wasm_array_obj_pre_write_barrier() */
+    param_values[0] = array_obj;
+    param_values[1] = elem_idx;
+    param_values[2] = len;
+    if (!LLVMBuildCall2(comp_ctx->builder, func_type, func, param_values, 3,
+                        "")) {
+        aot_set_last_error("llvm build call failed.");
+        goto fail;
+    }
+
+    return true;
+fail:
+    return false;
+}
+
 static void
 get_struct_field_data_types(const AOTCompContext *comp_ctx, uint8 field_type,
                             LLVMTypeRef *p_field_data_type,
@@ -703,10 +789,27 @@ aot_compile_op_struct_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                             check_struct_obj_succ))
         goto fail;
 
+    if (comp_ctx->enable_gc_pre_write_barrier
+        && wasm_is_type_reftype(field_type)) {
+        LLVMValueRef old_value;
+
+        if (!aot_struct_obj_get_field(comp_ctx, struct_obj,
+                                      I32_CONST(field_offset), &old_value,
+                                      field_type, false)
+            || !aot_call_wasm_obj_pre_write_barrier(comp_ctx, func_ctx,
+                                                    old_value))
+            goto fail;
+    }
+
     if (!aot_struct_obj_set_field(comp_ctx, struct_obj, I32_CONST(field_offset),
                                   field_value, field_type))
         goto fail;
 
+    if (comp_ctx->enable_gc_write_barrier && wasm_is_type_reftype(field_type)
+        && !aot_call_wasm_obj_write_barrier(comp_ctx, func_ctx, struct_obj,
+                                            field_value))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1440,12 +1543,25 @@ aot_compile_op_array_set(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         goto fail;
 
     SET_BUILDER_POS(check_boundary_succ);
+    if (comp_ctx->enable_gc_pre_write_barrier
+        && wasm_is_type_reftype(array_elem_type)
+        && !aot_call_wasm_array_obj_pre_write_barrier(comp_ctx, func_ctx,
+                                                      array_obj, elem_idx,
+                                                      I32_ONE))
+        goto fail;
+
     if (!aot_array_obj_set_elem(comp_ctx, func_ctx, array_obj, elem_idx,
                                 array_elem, array_elem_type)) {
         aot_set_last_error("llvm build alloca failed.");
         goto fail;
     }
 
+    if (comp_ctx->enable_gc_write_barrier
+        && wasm_is_type_reftype(array_elem_type)
+        && !aot_call_wasm_obj_write_barrier(comp_ctx, func_ctx, array_obj,
+                                            array_elem))
+        goto fail;
+
     return true;
 fail:
     return false;
@@ -1544,6 +1660,20 @@ aot_compile_op_array_fill(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                             cmp[0], inner_else))
         goto fail;
 
+    /* All the elements refer to the same object, remember the array once */
+    if (comp_ctx->enable_gc_write_barrier
+        && wasm_is_type_reftype(array_elem_type)
+        && !aot_call_wasm_obj_write_barrier(comp_ctx, func_ctx, array_obj,
+                                            fill_value))
+        goto fail;
+
+    /* Remember the elements to overwrite before the loop */
+    if (comp_ctx->enable_gc_pre_write_barrier
+        && wasm_is_type_reftype(array_elem_type)
+        && !aot_call_wasm_array_obj_pre_write_barrier(comp_ctx, func_ctx,
+                                                      array_obj, offset, len))
+        goto fail;
+
     if (!(loop_counter_addr = LLVMBuildAlloca(comp_ctx->builder, I32_TYPE,
                                               "fill_loop_counter"))) {
         aot_set_last_error("llvm build alloc failed.");
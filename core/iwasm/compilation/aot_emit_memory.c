@@ -94,6 +94,109 @@ get_memory_check_bound(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
 static LLVMValueRef
 get_memory_curr_page_count(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+/*
+ * Check whether the app address range [offset1, end) is in the shared
+ * heap attached, which ends at the top of the 32-bit app address space.
+ * If yes, compute the native address with the shared heap, otherwise
+ * the builder is positioned at the block to check the range against the
+ * linear memory, and the native address computed there must be added to
+ * the phi returned and branch to the phi block.
+ */
+static bool
+check_shared_heap_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
+                           LLVMValueRef offset1_i64, LLVMValueRef end_i64,
+                           LLVMBasicBlockRef *p_block_maddr_phi,
+                           LLVMValueRef *p_maddr_phi)
+{
+    LLVMBasicBlockRef block_curr = LLVMGetInsertBlock(comp_ctx->builder);
+    LLVMBasicBlockRef block_shared_heap, block_linear_mem, block_maddr_phi;
+    LLVMBasicBlockRef check_succ;
+    LLVMValueRef cmp, offset1, maddr, maddr_phi;
+
+    ADD_BASIC_BLOCK(block_shared_heap, "app_addr_in_shared_heap");
+    ADD_BASIC_BLOCK(check_succ, "check_shared_heap_succ");
+    ADD_BASIC_BLOCK(block_linear_mem, "app_addr_in_linear_mem");
+    ADD_BASIC_BLOCK(block_maddr_phi, "maddr_phi");
+    LLVMMoveBasicBlockAfter(block_shared_heap, block_curr);
+    LLVMMoveBasicBlockAfter(check_succ, block_shared_heap);
+    LLVMMoveBasicBlockAfter(block_linear_mem, check_succ);
+    LLVMMoveBasicBlockAfter(block_maddr_phi, block_linear_mem);
+
+    /* shared_heap_start_off is UINT64_MAX if no heap is attached */
+    BUILD_ICMP(LLVMIntUGE, offset1_i64, func_ctx->shared_heap_start_off, cmp,
+               "cmp_shared_heap_start");
+    if (!LLVMBuildCondBr(comp_ctx->builder, cmp, block_shared_heap,
+                         block_linear_mem)) {
+        aot_set_last_error("llvm build cond br failed.");
+        goto fail;
+    }
+
+    SET_BUILD_POS(block_shared_heap);
+    BUILD_ICMP(LLVMIntUGT, end_i64, I64_CONST((uint64)UINT32_MAX + 1), cmp,
+               "cmp_shared_heap_end");
+    if (!aot_emit_exception(comp_ctx, func_ctx,
+                            EXCE_OUT_OF_BOUNDS_MEMORY_ACCESS, true, cmp,
+                            check_succ)) {
+        goto fail;
+    }
+
+    SET_BUILD_POS(check_succ);
+    offset1 = offset1_i64;
+    if (comp_ctx->pointer_size != sizeof(uint64)
+        && !(offset1 = LLVMBuildTrunc(comp_ctx->builder, offset1_i64,
+                                      I32_TYPE, "offset1_i32"))) {
+        aot_set_last_error("llvm build trunc failed.");
+        goto fail;
+    }
+    /* maddr = shared_heap_base_addr_adj + offset1, the adjusted base
+       address itself isn't in the heap, so the gep isn't inbounds */
+    if (!(maddr = LLVMBuildGEP2(comp_ctx->builder, INT8_TYPE,
+                                func_ctx->shared_heap_base_addr_adj, &offset1,
+                                1, "maddr_shared_heap"))) {
+        aot_set_last_error("llvm build gep failed.");
+        goto fail;
+    }
+    if (!LLVMBuildBr(comp_ctx->builder, block_maddr_phi)) {
+        aot_set_last_error("llvm build br failed.");
+        goto fail;
+    }
+
+    SET_BUILD_POS(block_maddr_phi);
+    if (!(maddr_phi =
+              LLVMBuildPhi(comp_ctx->builder, INT8_PTR_TYPE, "maddr_phi"))) {
+        aot_set_last_error("llvm build phi failed.");
+        goto fail;
+    }
+    LLVMAddIncoming(maddr_phi, &maddr, &check_succ, 1);
+
+    SET_BUILD_POS(block_linear_mem);
+    *p_block_maddr_phi = block_maddr_phi;
+    *p_maddr_phi = maddr_phi;
+    return true;
+fail:
+    return false;
+}
+
+/* Merge the native address computed with the linear memory into the
+   phi created by check_shared_heap_overflow */
+static LLVMValueRef
+merge_shared_heap_maddr(AOTCompContext *comp_ctx,
+                        LLVMBasicBlockRef block_maddr_phi,
+                        LLVMValueRef maddr_phi, LLVMValueRef maddr)
+{
+    LLVMBasicBlockRef block_curr = LLVMGetInsertBlock(comp_ctx->builder);
+
+    if (!LLVMBuildBr(comp_ctx->builder, block_maddr_phi)) {
+        aot_set_last_error("llvm build br failed.");
+        return NULL;
+    }
+    SET_BUILD_POS(block_maddr_phi);
+    LLVMAddIncoming(maddr_phi, &maddr, &block_curr, 1);
+    return maddr_phi;
+}
+#endif /* end of WASM_ENABLE_SHARED_HEAP != 0 */
+
 LLVMValueRef
 aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
                           mem_offset_t offset, uint32 bytes, bool enable_segue)
@@ -104,6 +207,10 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     LLVMValueRef mem_base_addr, mem_check_bound;
     LLVMBasicBlockRef block_curr = LLVMGetInsertBlock(comp_ctx->builder);
     LLVMBasicBlockRef check_succ;
+#if WASM_ENABLE_SHARED_HEAP != 0
+    LLVMBasicBlockRef block_maddr_phi = NULL;
+    LLVMValueRef maddr_phi = NULL;
+#endif
     AOTValue *aot_value_top;
     uint32 local_idx_of_aot_value = 0;
     bool is_target_64bit, is_local_of_aot_value = false;
@@ -163,6 +270,12 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         is_local_of_aot_value = aot_value_top->is_local;
         local_idx_of_aot_value = aot_value_top->local_idx;
     }
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* The check of a local's address may have been skipped since it was
+       in the shared heap, don't reuse the checked address list */
+    if (comp_ctx->enable_shared_heap)
+        is_local_of_aot_value = false;
+#endif
 
     POP_MEM_OFFSET(addr);
 
@@ -219,6 +332,32 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     /* offset1 = offset + addr; */
     BUILD_OP(Add, offset_const, addr, offset1, "offset1");
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (comp_ctx->enable_shared_heap && !IS_MEMORY64) {
+        LLVMValueRef offset1_i64 = offset1, addr_i64, offset_i64, end_i64;
+
+        bh_assert(!enable_segue);
+        if (!is_target_64bit) {
+            /* offset1 may overflow on 32-bit target */
+            if (!(addr_i64 = LLVMBuildZExt(comp_ctx->builder, addr, I64_TYPE,
+                                           "addr_i64"))
+                || !(offset_i64 = LLVMBuildZExt(comp_ctx->builder, offset_const,
+                                                I64_TYPE, "offset_i64"))) {
+                aot_set_last_error("llvm build zero extend failed.");
+                goto fail;
+            }
+            BUILD_OP(Add, offset_i64, addr_i64, offset1_i64, "offset1_i64");
+        }
+        BUILD_OP(Add, offset1_i64, I64_CONST(bytes), end_i64, "end_i64");
+        if (!check_shared_heap_overflow(comp_ctx, func_ctx, offset1_i64,
+                                        end_i64, &block_maddr_phi,
+                                        &maddr_phi)) {
+            goto fail;
+        }
+        block_curr = LLVMGetInsertBlock(comp_ctx->builder);
+    }
+#endif
+
     if (comp_ctx->enable_bound_check
         && !(is_local_of_aot_value
              && aot_checked_addr_list_find(func_ctx, local_idx_of_aot_value,
@@ -303,6 +442,12 @@ aot_check_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
             goto fail;
         }
     }
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (maddr_phi) {
+        maddr = merge_shared_heap_maddr(comp_ctx, block_maddr_phi, maddr_phi,
+                                        maddr);
+    }
+#endif
     return maddr;
 fail:
     return NULL;
@@ -929,6 +1074,10 @@ check_bulk_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     LLVMBasicBlockRef block_curr = LLVMGetInsertBlock(comp_ctx->builder);
     LLVMBasicBlockRef check_succ;
     LLVMValueRef mem_size;
+#if WASM_ENABLE_SHARED_HEAP != 0
+    LLVMBasicBlockRef block_maddr_phi = NULL;
+    LLVMValueRef maddr_phi = NULL;
+#endif
 
     /* Get memory base address and memory data size */
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -995,6 +1144,19 @@ check_bulk_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     bytes = LLVMBuildZExt(comp_ctx->builder, bytes, I64_TYPE, "extend_len");
 
     BUILD_OP(Add, offset, bytes, max_addr, "max_addr");
+
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (comp_ctx->enable_shared_heap && !IS_MEMORY64
+        && !check_shared_heap_overflow(comp_ctx, func_ctx, offset, max_addr,
+                                       &block_maddr_phi, &maddr_phi)) {
+        goto fail;
+    }
+    if (maddr_phi) {
+        LLVMMoveBasicBlockAfter(check_succ,
+                                LLVMGetInsertBlock(comp_ctx->builder));
+    }
+#endif
+
     BUILD_ICMP(LLVMIntUGT, max_addr, mem_size, cmp, "cmp_max_mem_addr");
     if (!aot_emit_exception(comp_ctx, func_ctx,
                             EXCE_OUT_OF_BOUNDS_MEMORY_ACCESS, true, cmp,
@@ -1008,6 +1170,12 @@ check_bulk_memory_overflow(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
         aot_set_last_error("llvm build add failed.");
         goto fail;
     }
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (maddr_phi) {
+        maddr = merge_shared_heap_maddr(comp_ctx, block_maddr_phi, maddr_phi,
+                                        maddr);
+    }
+#endif
     return maddr;
 fail:
     return NULL;
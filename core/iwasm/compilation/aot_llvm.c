@@ -1517,6 +1517,54 @@ create_memory_info(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx,
     return true;
 }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+static bool
+create_shared_heap_info(AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef offset, field_p;
+    uint32 offset_u32 = get_module_inst_extra_offset(comp_ctx);
+
+    offset_u32 += comp_ctx->is_jit_mode
+                      ? offsetof(WASMModuleInstanceExtra, common)
+                      : offsetof(AOTModuleInstanceExtra, common);
+
+    /* Load shared_heap_start_off, UINT64_MAX if no heap is attached */
+    offset = I32_CONST(offset_u32
+                       + offsetof(WASMModuleInstanceExtraCommon,
+                                  shared_heap_start_off));
+    if (!(field_p = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                          func_ctx->aot_inst, &offset, 1,
+                                          "shared_heap_start_off_p"))) {
+        aot_set_last_error("llvm build in bounds gep failed");
+        return false;
+    }
+    if (!(func_ctx->shared_heap_start_off =
+              LLVMBuildLoad2(comp_ctx->builder, I64_TYPE, field_p,
+                             "shared_heap_start_off"))) {
+        aot_set_last_error("llvm build load failed");
+        return false;
+    }
+
+    /* Load shared_heap_base_addr_adj */
+    offset = I32_CONST(offset_u32
+                       + offsetof(WASMModuleInstanceExtraCommon,
+                                  shared_heap_base_addr_adj));
+    if (!(field_p = LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                          func_ctx->aot_inst, &offset, 1,
+                                          "shared_heap_base_addr_adj_p"))) {
+        aot_set_last_error("llvm build in bounds gep failed");
+        return false;
+    }
+    if (!(func_ctx->shared_heap_base_addr_adj =
+              LLVMBuildLoad2(comp_ctx->builder, INT8_PTR_TYPE, field_p,
+                             "shared_heap_base_addr_adj"))) {
+        aot_set_last_error("llvm build load failed");
+        return false;
+    }
+    return true;
+}
+#endif
+
 static bool
 create_cur_exception(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
 {
@@ -1533,6 +1581,79 @@ create_cur_exception(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
     return true;
 }
 
+static bool
+create_safepoint_page(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    /* exec_env->safepoint_page is the 14th pointer of exec_env, which is
+       checked by the static assertions in aot_runtime.c */
+    LLVMValueRef safepoint_page_offset = I32_CONST(13), safepoint_page_addr;
+
+    if (!(safepoint_page_addr = LLVMBuildInBoundsGEP2(
+              comp_ctx->builder, OPQ_PTR_TYPE, func_ctx->exec_env,
+              &safepoint_page_offset, 1, "safepoint_page_addr"))) {
+        aot_set_last_error("llvm build in bounds gep failed");
+        return false;
+    }
+
+    /* Only the protection of the page changes during the execution, so
+       load it once in the entry block */
+    if (!(func_ctx->safepoint_page =
+              LLVMBuildLoad2(comp_ctx->builder, OPQ_PTR_TYPE,
+                             safepoint_page_addr, "safepoint_page"))) {
+        aot_set_last_error("llvm build load failed");
+        return false;
+    }
+    return true;
+}
+
+static bool
+create_fuel_info(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef offset, fuel;
+
+    /* Offset of exec_env->fuel, which follows the safepoint_page and
+       is aligned to 8 bytes, it is checked by the static assertions in
+       aot_runtime.c */
+    offset = I32_CONST((comp_ctx->pointer_size * 14 + 7) & ~7U);
+    if (!(func_ctx->fuel_ptr =
+              LLVMBuildInBoundsGEP2(comp_ctx->builder, INT8_TYPE,
+                                    func_ctx->exec_env, &offset, 1, "fuel_addr"))
+        || !(func_ctx->fuel_ptr =
+                 LLVMBuildBitCast(comp_ctx->builder, func_ctx->fuel_ptr,
+                                  INT64_PTR_TYPE, "fuel_ptr"))) {
+        aot_set_last_error("llvm build gep or bit cast failed.");
+        return false;
+    }
+
+    if (!(func_ctx->fuel =
+              LLVMBuildAlloca(comp_ctx->builder, I64_TYPE, "fuel"))) {
+        aot_set_last_error("llvm build alloca failed.");
+        return false;
+    }
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE,
+                                func_ctx->fuel_ptr, "fuel_init"))
+        || !LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel)) {
+        aot_set_last_error("llvm build load or store failed.");
+        return false;
+    }
+    return true;
+}
+
+bool
+aot_commit_fuel(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx)
+{
+    LLVMValueRef fuel;
+
+    if (!(fuel = LLVMBuildLoad2(comp_ctx->builder, I64_TYPE, func_ctx->fuel,
+                                "fuel"))
+        || !LLVMBuildStore(comp_ctx->builder, fuel, func_ctx->fuel_ptr)) {
+        aot_set_last_error("llvm build load or store failed.");
+        return false;
+    }
+    return true;
+}
+
 static bool
 create_func_type_indexes(const AOTCompContext *comp_ctx,
                          AOTFuncContext *func_ctx)
@@ -1783,11 +1904,32 @@ aot_create_func_context(const AOTCompData *comp_data, AOTCompContext *comp_ctx,
         goto fail;
     }
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* Load the shared heap info for the memory access checks */
+    if (wasm_func->has_memory_operations && comp_ctx->enable_shared_heap
+        && !(comp_ctx->comp_data->memories[0].flags & MEMORY64_FLAG)
+        && !create_shared_heap_info(comp_ctx, func_ctx)) {
+        goto fail;
+    }
+#endif
+
     /* Load current exception */
     if (!create_cur_exception(comp_ctx, func_ctx)) {
         goto fail;
     }
 
+    /* Load the safepoint page of exec_env */
+    if (comp_ctx->enable_safepoint_page
+        && !create_safepoint_page(comp_ctx, func_ctx)) {
+        goto fail;
+    }
+
+    /* Load the fuel of exec_env */
+    if (comp_ctx->enable_fuel_metering
+        && !create_fuel_info(comp_ctx, func_ctx)) {
+        goto fail;
+    }
+
     /* Load function type indexes */
     if (wasm_func->has_op_call_indirect
         && !create_func_type_indexes(comp_ctx, func_ctx)) {
@@ -2459,6 +2601,139 @@ aot_compiler_destroy(void)
     LLVMShutdown();
 }
 
+/**
+ * Split the functions into partitions of contiguous functions with
+ * similar code size, the code of each partition is generated by its
+ * own thread, and the object files are concatenated in order.
+ */
+static void
+aot_partition_funcs(const AOTCompData *comp_data, AOTCompPartition *partitions,
+                    uint32 partition_count)
+{
+    WASMModule *module = comp_data->wasm_module;
+    uint64 total_size = 0, size = 0;
+    uint32 i, p = 1;
+
+    for (i = 0; i < comp_data->func_count; i++)
+        total_size += (uint64)module->functions[i]->code_size + 1;
+
+    partitions[0].func_begin = 0;
+    for (i = 0; i < comp_data->func_count && p < partition_count; i++) {
+        size += (uint64)module->functions[i]->code_size + 1;
+        /* Start a new partition when the current one is large enough,
+           or when each of the remaining partitions only gets one
+           function */
+        if (size * partition_count >= total_size * p
+            || comp_data->func_count - (i + 1) == partition_count - p) {
+            partitions[p - 1].func_end = i + 1;
+            partitions[p++].func_begin = i + 1;
+        }
+    }
+    partitions[partition_count - 1].func_end = comp_data->func_count;
+    bh_assert(p == partition_count);
+}
+
+static bool
+check_partition_option(const AOTCompContext *comp_ctx,
+                       aot_comp_option_t option)
+{
+    const char *reason = NULL;
+    char buf[128];
+
+    if (option->is_jit_mode)
+        reason = "jit mode";
+    else if (option->output_format != AOT_FORMAT_FILE)
+        reason = "output formats other than aot";
+    else if (comp_ctx->is_indirect_mode)
+        reason = "indirect mode or xip";
+    else if (comp_ctx->external_llc_compiler
+             || comp_ctx->external_asm_compiler)
+        reason = "external llc or asm compiler";
+    else if (comp_ctx->enable_llvm_pgo || comp_ctx->use_prof_file)
+        reason = "llvm pgo";
+    else if (option->stack_usage_file)
+        reason = "stack usage file";
+    /* The object files of the partitions are merged with the layout
+       of the single object file emitted serially, which is only done
+       for x86_64 */
+    else if (strcmp(comp_ctx->target_arch, "x86_64"))
+        reason = "targets other than x86_64";
+#if WASM_ENABLE_DEBUG_AOT != 0
+    else
+        reason = "debug aot";
+#endif
+
+    if (reason) {
+        snprintf(buf, sizeof(buf),
+                 "compiling with multiple threads isn't supported for %s.",
+                 reason);
+        aot_set_last_error(buf);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Create the partitions to generate the code with multiple threads, each
+ * partition has its own target machine created with the same options as
+ * the one of the context, and its own stack usage file.
+ */
+static bool
+aot_create_partitions(AOTCompContext *comp_ctx, aot_comp_option_t option,
+                      LLVMTargetRef target, const char *triple,
+                      const char *cpu, const char *features,
+                      LLVMCodeGenOptLevel opt_level, LLVMCodeModel code_model)
+{
+    const AOTCompData *comp_data = comp_ctx->comp_data;
+    AOTCompPartition *partition;
+    uint32 partition_count = option->thread_num, i;
+    uint64 size;
+
+    if (partition_count > comp_data->func_count)
+        partition_count = comp_data->func_count;
+
+    if (partition_count <= 1)
+        return true;
+
+    if (!check_partition_option(comp_ctx, option))
+        return false;
+
+    size = sizeof(AOTCompPartition) * (uint64)partition_count;
+    if (size >= UINT32_MAX
+        || !(comp_ctx->partitions = wasm_runtime_malloc((uint32)size))) {
+        aot_set_last_error("allocate memory failed.");
+        return false;
+    }
+    memset(comp_ctx->partitions, 0, (uint32)size);
+    comp_ctx->partition_count = partition_count;
+    aot_partition_funcs(comp_data, comp_ctx->partitions, partition_count);
+
+    for (i = 0; i < partition_count; i++) {
+        partition = comp_ctx->partitions + i;
+
+        if (comp_ctx->enable_stack_bound_check
+            || comp_ctx->enable_stack_estimation) {
+            if (!aot_generate_tempfile_name(
+                    "wamrc-su", "su", partition->stack_usage_temp_file,
+                    sizeof(partition->stack_usage_temp_file)))
+                return false;
+            partition->stack_usage_file = partition->stack_usage_temp_file;
+        }
+
+        if (!(partition->target_machine = LLVMCreateTargetMachineWithOpts(
+                  target, triple, cpu, features, opt_level, LLVMRelocStatic,
+                  code_model, false, partition->stack_usage_file))) {
+            aot_set_last_error("create LLVM target machine failed.");
+            return false;
+        }
+
+        LOG_VERBOSE("AOT partition %" PRIu32 ": func#%" PRIu32
+                    " to func#%" PRIu32,
+                    i, partition->func_begin, partition->func_end - 1);
+    }
+    return true;
+}
+
 AOTCompContext *
 aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
 {
@@ -2592,6 +2867,24 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
     if (option->enable_llvm_pgo)
         comp_ctx->enable_llvm_pgo = true;
 
+    if (option->enable_shared_text)
+        comp_ctx->enable_shared_text = true;
+
+    if (option->enable_fuel_metering)
+        comp_ctx->enable_fuel_metering = true;
+
+    if (option->enable_safepoint_page)
+        comp_ctx->enable_safepoint_page = true;
+
+    if (option->enable_gc && option->enable_gc_write_barrier)
+        comp_ctx->enable_gc_write_barrier = true;
+
+    if (option->enable_gc && option->enable_gc_pre_write_barrier)
+        comp_ctx->enable_gc_pre_write_barrier = true;
+
+    if (option->enable_shared_heap)
+        comp_ctx->enable_shared_heap = true;
+
     if (option->use_prof_file)
         comp_ctx->use_prof_file = option->use_prof_file;
 
@@ -3045,15 +3338,23 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
         else
             code_model = LLVMCodeModelSmall;
 
-        /* Create the target machine */
+        /* Create the target machine, the shared text is required to be
+           position independent, e.g. the jump tables are emitted with
+           relative offsets instead of absolute addresses */
         if (!(comp_ctx->target_machine = LLVMCreateTargetMachineWithOpts(
                   target, triple_norm, cpu, features, opt_level,
-                  LLVMRelocStatic, code_model, false,
+                  option->enable_shared_text ? LLVMRelocPIC : LLVMRelocStatic,
+                  code_model, false,
                   comp_ctx->stack_usage_file))) {
             aot_set_last_error("create LLVM target machine failed.");
             goto fail;
         }
 
+        if (option->thread_num > 1
+            && !aot_create_partitions(comp_ctx, option, target, triple_norm,
+                                      cpu, features, opt_level, code_model))
+            goto fail;
+
         /* If only to create target machine for querying information, early stop
          */
         if ((arch && !strcmp(arch, "help")) || (abi && !strcmp(abi, "help"))
@@ -3071,7 +3372,13 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
         goto fail;
     }
     if (strstr(triple, "linux") && !strcmp(comp_ctx->target_arch, "x86_64")) {
-        if (option->segue_flags) {
+        if (option->segue_flags && comp_ctx->enable_shared_heap) {
+            /* The GS register only holds the base address of the linear
+               memory, which can't be used to access the shared heap */
+            LOG_WARNING("segue is disabled since the shared heap is "
+                        "enabled");
+        }
+        else if (option->segue_flags) {
             if (option->segue_flags & (1 << 0))
                 comp_ctx->enable_segue_i32_load = true;
             if (option->segue_flags & (1 << 1))
@@ -3094,6 +3401,20 @@ aot_create_comp_context(const AOTCompData *comp_data, aot_comp_option_t option)
                 comp_ctx->enable_segue_v128_store = true;
         }
     }
+    if (comp_ctx->enable_shared_text) {
+        if (!comp_ctx->is_indirect_mode) {
+            LLVMDisposeMessage(triple);
+            aot_set_last_error("shared text requires the indirect mode.");
+            goto fail;
+        }
+        if (!strstr(triple, "linux")
+            || strcmp(comp_ctx->target_arch, "x86_64")) {
+            LLVMDisposeMessage(triple);
+            aot_set_last_error(
+                "shared text is only supported for x86_64 linux target.");
+            goto fail;
+        }
+    }
     LLVMDisposeMessage(triple);
 
 #if WASM_ENABLE_WAMR_COMPILER != 0
@@ -3227,6 +3548,21 @@ aot_destroy_comp_context(AOTCompContext *comp_ctx)
     if (!comp_ctx)
         return;
 
+    if (comp_ctx->partitions) {
+        AOTCompPartition *partition;
+        uint32 i;
+
+        for (i = 0; i < comp_ctx->partition_count; i++) {
+            partition = comp_ctx->partitions + i;
+            if (partition->stack_usage_file
+                == partition->stack_usage_temp_file)
+                (void)unlink(partition->stack_usage_temp_file);
+            if (partition->target_machine)
+                LLVMDisposeTargetMachine(partition->target_machine);
+        }
+        wasm_runtime_free(comp_ctx->partitions);
+    }
+
     if (comp_ctx->stack_usage_file == comp_ctx->stack_usage_temp_file) {
         (void)unlink(comp_ctx->stack_usage_temp_file);
     }
@@ -3608,6 +3944,13 @@ aot_build_zero_function_ret(const AOTCompContext *comp_ctx,
 {
     LLVMValueRef ret = NULL;
 
+    /* The function may return because of an exception or termination,
+       let the runtime see the fuel left */
+    if (comp_ctx->enable_fuel_metering && func_ctx->fuel
+        && !aot_commit_fuel(comp_ctx, func_ctx)) {
+        return false;
+    }
+
     if (func_type->result_count) {
         switch (func_type->types[func_type->param_count]) {
             case VALUE_TYPE_I32:
@@ -16,6 +16,7 @@
 #include "llvm-c/ExecutionEngine.h"
 #include "llvm-c/Analysis.h"
 #include "llvm-c/BitWriter.h"
+#include "llvm-c/BitReader.h"
 #if LLVM_VERSION_MAJOR < 17
 #include "llvm-c/Transforms/Utils.h"
 #include "llvm-c/Transforms/Scalar.h"
@@ -230,8 +231,22 @@ typedef struct AOTFuncContext {
 
     AOTMemInfo *mem_info;
 
+    /* The start offset and the adjusted base address of the shared heap
+       attached, loaded once at function entry */
+    LLVMValueRef shared_heap_start_off;
+    LLVMValueRef shared_heap_base_addr_adj;
+
     LLVMValueRef cur_exception;
 
+    /* Address of exec_env->fuel and its local copy, the fuel charges
+       only update the local copy, which is written back before calls,
+       returns and exceptions and reloaded after calls */
+    LLVMValueRef fuel_ptr;
+    LLVMValueRef fuel;
+
+    /* exec_env->safepoint_page, polled at the loop back-edges */
+    LLVMValueRef safepoint_page;
+
     LLVMValueRef cur_frame;
     LLVMValueRef cur_frame_ptr;
     LLVMValueRef wasm_stack_top_bound;
@@ -252,6 +267,9 @@ typedef struct AOTFuncContext {
 
     unsigned int stack_consumption_for_func_call;
 
+    /* Number of the opcodes translated since the last fuel charge */
+    uint32 fuel_region_cost;
+
     LLVMValueRef locals[1];
 } AOTFuncContext;
 
@@ -355,6 +373,20 @@ typedef struct AOTLLVMConsts {
     LLVMValueRef i8_ptr_null;
 } AOTLLVMConsts;
 
+/**
+ * A partition of the functions which is emitted to an object file by
+ * its own thread when compiling with multiple threads
+ */
+typedef struct AOTCompPartition {
+    /* The functions in [func_begin, func_end) are emitted by the
+       partition, the others are only declared */
+    uint32 func_begin;
+    uint32 func_end;
+    LLVMTargetMachineRef target_machine;
+    const char *stack_usage_file;
+    char stack_usage_temp_file[64];
+} AOTCompPartition;
+
 /**
  * Compiler context
  */
@@ -434,6 +466,27 @@ typedef struct AOTCompContext {
     /* Enable LLVM PGO (Profile-Guided Optimization) */
     bool enable_llvm_pgo;
 
+    /* Emit page-aligned and pre-relocated text which can be mapped from
+       the AOT file directly */
+    bool enable_shared_text;
+
+    /* Charge the fuel of the exec_env before each control instruction */
+    bool enable_fuel_metering;
+
+    /* Poll the safepoint page of the exec_env instead of checking the
+       suspend flags */
+    bool enable_safepoint_page;
+
+    /* Call the write barrier after the ref stores into the objects */
+    bool enable_gc_write_barrier;
+
+    /* Call the pre-write barrier before the ref stores into the objects */
+    bool enable_gc_pre_write_barrier;
+
+    /* Check the app addresses against the shared heap attached before
+       the linear memory */
+    bool enable_shared_heap;
+
     /* Treat unknown import function as wasm-c-api import function
        and allow to directly invoke it from AOT/JIT code */
     bool quick_invoke_c_api_import;
@@ -511,6 +564,12 @@ typedef struct AOTCompContext {
 
     /* Current frame information for translation */
     AOTCompFrame *aot_frame;
+
+    /* The partitions of the functions when compiling with multiple
+       threads, the module is compiled to LLVM IR and optimized as a
+       whole, and only the code generation is split */
+    AOTCompPartition *partitions;
+    uint32 partition_count;
 } AOTCompContext;
 
 enum {
@@ -588,6 +647,9 @@ bool
 aot_build_zero_function_ret(const AOTCompContext *comp_ctx,
                             AOTFuncContext *func_ctx, AOTFuncType *func_type);
 
+bool
+aot_commit_fuel(const AOTCompContext *comp_ctx, AOTFuncContext *func_ctx);
+
 LLVMValueRef
 aot_call_llvm_intrinsic(const AOTCompContext *comp_ctx,
                         const AOTFuncContext *func_ctx, const char *intrinsic,
@@ -620,6 +682,20 @@ aot_handle_llvm_errmsg(const char *string, LLVMErrorRef err);
 char *
 aot_compress_aot_func_names(AOTCompContext *comp_ctx, uint32 *p_size);
 
+bool
+aot_check_module_partitions(const AOTCompContext *comp_ctx);
+
+LLVMMemoryBufferRef
+aot_write_module_bitcode(LLVMModuleRef module);
+
+bool
+aot_extract_module_partition(const AOTCompContext *comp_ctx,
+                             LLVMModuleRef module, uint32 partition_index);
+
+bool
+aot_get_code_padding(LLVMTargetMachineRef target_machine, uint8 *buf,
+                     uint32 size);
+
 bool
 aot_set_cond_br_weights(AOTCompContext *comp_ctx, LLVMValueRef cond_br,
                         int32 weights_true, int32 weights_false);
@@ -10,12 +10,23 @@
 #include <llvm/ADT/Optional.h>
 #include <llvm/ADT/Triple.h>
 #endif
+#include <llvm/ADT/DenseMap.h>
+#include <llvm/ADT/SmallPtrSet.h>
+#include <llvm/ADT/SmallString.h>
 #include <llvm/ADT/SmallVector.h>
 #include <llvm/ADT/Twine.h>
 #include <llvm/Analysis/TargetTransformInfo.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
 #include <llvm/CodeGen/TargetPassConfig.h>
 #include <llvm/ExecutionEngine/ExecutionEngine.h>
+#include <llvm/MC/MCAsmBackend.h>
 #include <llvm/MC/MCSubtargetInfo.h>
+#include <llvm/MC/SectionKind.h>
+#if LLVM_VERSION_MAJOR >= 14
+#include <llvm/MC/TargetRegistry.h>
+#else
+#include <llvm/Support/TargetRegistry.h>
+#endif
 #include <llvm/Support/TargetSelect.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm-c/Core.h>
@@ -27,18 +38,23 @@
 #include <llvm/ExecutionEngine/JITEventListener.h>
 #include <llvm/ExecutionEngine/RTDyldMemoryManager.h>
 #include <llvm/ExecutionEngine/Orc/LLJIT.h>
+#include <llvm/IR/Constants.h>
 #include <llvm/IR/DerivedTypes.h>
+#include <llvm/IR/GlobalAlias.h>
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Instructions.h>
 #include <llvm/IR/IntrinsicInst.h>
 #include <llvm/IR/PassManager.h>
+#include <llvm/IR/Verifier.h>
 #include <llvm/Support/CommandLine.h>
 #include <llvm/Support/ErrorHandling.h>
+#include <llvm/Support/MemoryBuffer.h>
 #if LLVM_VERSION_MAJOR >= 17
 #include <llvm/Support/PGOOptions.h>
 #include <llvm/Support/VirtualFileSystem.h>
 #endif
 #include <llvm/Target/CodeGenCWrappers.h>
+#include <llvm/Target/TargetLoweringObjectFile.h>
 #include <llvm/Target/TargetMachine.h>
 #include <llvm/Target/TargetOptions.h>
 #include <llvm/Transforms/Utils/LowerMemIntrinsics.h>
@@ -422,3 +438,290 @@ aot_compress_aot_func_names(AOTCompContext *comp_ctx, uint32 *p_size)
     *p_size = compressed_str_len;
     return compressed_str;
 }
+
+/* Get the partition of the wasm function */
+static uint32
+get_partition_index(const AOTCompContext *comp_ctx, uint32 func_index)
+{
+    uint32 i;
+
+    for (i = 0; i + 1 < comp_ctx->partition_count; i++) {
+        if (func_index < comp_ctx->partitions[i].func_end)
+            break;
+    }
+    return i;
+}
+
+/**
+ * Get the partition of each function defined in the module, the functions
+ * other than aot_func#n and aot_func_internal#n, if any, belong to the
+ * partition of the function defined before them.
+ */
+static void
+get_func_partitions(const AOTCompContext *comp_ctx, Module &M,
+                    DenseMap<const Function *, uint32> &func_partitions)
+{
+    uint32 func_index = 0, index;
+
+    for (Function &F : M) {
+        StringRef name = F.getName();
+
+        if (F.isDeclaration())
+            continue;
+        if ((name.consume_front(AOT_FUNC_INTERNAL_PREFIX)
+             || name.consume_front(AOT_FUNC_PREFIX))
+            && !name.getAsInteger(10, index))
+            func_index = index;
+        func_partitions[&F] = get_partition_index(comp_ctx, func_index);
+    }
+}
+
+/* Collect the globals referenced by the constant */
+static bool
+collect_globals(const Constant *C, SmallPtrSetImpl<const Constant *> &visited,
+                SmallPtrSetImpl<const GlobalValue *> &globals)
+{
+    if (!visited.insert(C).second)
+        return true;
+    if (const GlobalValue *GV = dyn_cast<GlobalValue>(C)) {
+        globals.insert(GV);
+        return true;
+    }
+    /* The basic block of a block address belongs to the function */
+    if (isa<BlockAddress>(C))
+        return false;
+    for (const Use &U : C->operands()) {
+        if (!collect_globals(cast<Constant>(U.get()), visited, globals))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Check whether a function of the partition can reference the global when
+ * the partitions are emitted separately, with the same code and the same
+ * relocations after merging as the module is emitted as a whole.
+ */
+static bool
+can_reference_global(const AOTCompContext *comp_ctx,
+                     const DenseMap<const Function *, uint32> &func_partitions,
+                     const GlobalValue *GV, uint32 partition_index)
+{
+    TargetMachine *TM =
+        reinterpret_cast<TargetMachine *>(comp_ctx->target_machine);
+
+    if (const Function *F = dyn_cast<Function>(GV)) {
+        /* The calls to the local functions of the same section are
+           resolved when emitting the object file */
+        return F->isDeclaration() || !F->hasLocalLinkage()
+               || func_partitions.lookup(F) == partition_index;
+    }
+
+    /* All the globals are defined in the last partition */
+    if (partition_index == comp_ctx->partition_count - 1)
+        return true;
+
+    if (const GlobalVariable *GVar = dyn_cast<GlobalVariable>(GV)) {
+        if (GVar->isDeclaration())
+            return true;
+        /* The access model of a thread local variable depends on whether
+           it is defined in the module */
+        if (GVar->isThreadLocal())
+            return false;
+        if (!GVar->hasLocalLinkage())
+            return true;
+        /* A relocation to a local symbol in a mergeable section may be
+           kept as a relocation to the symbol, which is only converted to
+           the relocation to the section for the switch tables */
+        SectionKind kind = TargetLoweringObjectFile::getKindForGlobal(GVar, *TM);
+        if (kind.isMergeableConst() || kind.isMergeableCString())
+            return GVar->hasPrivateLinkage()
+                   && GVar->getName().find("switch.table.") == 0;
+        return true;
+    }
+
+    /* Aliases and ifuncs */
+    return false;
+}
+
+bool
+aot_check_module_partitions(const AOTCompContext *comp_ctx)
+{
+    Module *M = reinterpret_cast<Module *>(comp_ctx->module);
+    DenseMap<const Function *, uint32> func_partitions;
+    SmallPtrSet<const Constant *, 32> visited;
+    SmallPtrSet<const GlobalValue *, 32> globals;
+    uint32 last_partition = comp_ctx->partition_count - 1, prev_partition = 0;
+    uint32 partition_index;
+
+    /* The module is read back from its bitcode by the partitions, which
+       may fail if the module isn't valid */
+    if (verifyModule(*M))
+        return false;
+
+    get_func_partitions(comp_ctx, *M, func_partitions);
+
+    for (Function &F : *M) {
+        if (F.isDeclaration())
+            continue;
+
+        /* The object files of the partitions are concatenated in order */
+        partition_index = func_partitions.lookup(&F);
+        if (partition_index < prev_partition)
+            return false;
+        prev_partition = partition_index;
+
+        visited.clear();
+        globals.clear();
+        for (BasicBlock &BB : F) {
+            for (Instruction &I : BB) {
+                for (Value *V : I.operands()) {
+                    if (isa<Constant>(V)
+                        && !collect_globals(cast<Constant>(V), visited,
+                                            globals))
+                        return false;
+                }
+            }
+        }
+        for (const GlobalValue *GV : globals) {
+            if (!can_reference_global(comp_ctx, func_partitions, GV,
+                                      partition_index))
+                return false;
+        }
+    }
+
+    /* The initializers of the globals are emitted in the last partition */
+    visited.clear();
+    globals.clear();
+    for (GlobalVariable &GV : M->globals()) {
+        if (GV.hasAppendingLinkage())
+            return false;
+        if (GV.hasInitializer()
+            && !collect_globals(GV.getInitializer(), visited, globals))
+            return false;
+    }
+    for (GlobalAlias &GA : M->aliases()) {
+        if (!collect_globals(GA.getAliasee(), visited, globals))
+            return false;
+    }
+    for (const GlobalValue *GV : globals) {
+        if (!can_reference_global(comp_ctx, func_partitions, GV,
+                                  last_partition))
+            return false;
+    }
+    return M->ifunc_empty();
+}
+
+LLVMMemoryBufferRef
+aot_write_module_bitcode(LLVMModuleRef module)
+{
+    SmallVector<char, 0> buffer;
+    raw_svector_ostream os(buffer);
+
+    /* Preserve the order of the uses, which may affect the code
+       generated for the module read back */
+    WriteBitcodeToFile(*reinterpret_cast<Module *>(module), os, true);
+    return wrap(MemoryBuffer::getMemBufferCopy(
+                    StringRef(buffer.data(), buffer.size()))
+                    .release());
+}
+
+/**
+ * Turn the module into the one of the partition, which was checked by
+ * aot_check_module_partitions: only the bodies of the functions of the
+ * partition are kept, and all the globals are defined in the last
+ * partition, the other partitions reference the local globals by the
+ * aliases created for them in the last partition.
+ */
+bool
+aot_extract_module_partition(const AOTCompContext *comp_ctx,
+                             LLVMModuleRef module, uint32 partition_index)
+{
+    Module *M = reinterpret_cast<Module *>(module);
+    DenseMap<const Function *, uint32> func_partitions;
+    SmallVector<Function *, 32> local_funcs;
+    bool is_last = partition_index == comp_ctx->partition_count - 1;
+    uint32 global_index = 0;
+    char buf[64];
+
+    get_func_partitions(comp_ctx, *M, func_partitions);
+
+    for (Function &F : *M) {
+        if (F.isDeclaration() || func_partitions.lookup(&F) == partition_index)
+            continue;
+        if (F.hasLocalLinkage())
+            local_funcs.push_back(&F);
+        F.deleteBody();
+    }
+
+    if (!is_last) {
+        for (auto it = M->alias_begin(); it != M->alias_end();) {
+            GlobalAlias &GA = *it++;
+            if (!GA.use_empty()) {
+                aot_set_last_error("alias referenced by another partition.");
+                return false;
+            }
+            GA.eraseFromParent();
+        }
+    }
+
+    for (GlobalVariable &GV : M->globals()) {
+        snprintf(buf, sizeof(buf), "%s%" PRIu32, AOT_PARTITION_GLOBAL_PREFIX,
+                 global_index++);
+        if (GV.isDeclaration())
+            continue;
+        if (is_last) {
+            if (GV.hasLocalLinkage())
+                GlobalAlias::create(GV.getValueType(), GV.getAddressSpace(),
+                                    GlobalValue::ExternalLinkage, buf, &GV, M);
+            continue;
+        }
+        GV.setInitializer(nullptr);
+        GV.setComdat(nullptr);
+        if (GV.hasLocalLinkage()) {
+            GV.setName(buf);
+            GV.setLinkage(GlobalValue::ExternalLinkage);
+            GV.setVisibility(GlobalValue::HiddenVisibility);
+            GV.setDSOLocal(true);
+        }
+        else {
+            GV.setLinkage(GlobalValue::ExternalLinkage);
+        }
+    }
+
+    /* The local functions of the other partitions are no longer used */
+    for (Function *F : local_funcs) {
+        if (!F->use_empty()) {
+            aot_set_last_error(
+                "local function referenced by another partition.");
+            return false;
+        }
+        F->eraseFromParent();
+    }
+    return true;
+}
+
+bool
+aot_get_code_padding(LLVMTargetMachineRef target_machine, uint8 *buf,
+                     uint32 size)
+{
+    TargetMachine *TM = reinterpret_cast<TargetMachine *>(target_machine);
+    const MCSubtargetInfo *STI = TM->getMCSubtargetInfo();
+    std::unique_ptr<MCAsmBackend> backend(TM->getTarget().createMCAsmBackend(
+        *STI, *TM->getMCRegisterInfo(), TM->Options.MCOptions));
+    SmallString<64> padding;
+    raw_svector_ostream os(padding);
+
+    /* The nops emitted by the assembler to align the functions */
+#if LLVM_VERSION_MAJOR >= 13
+    if (!backend || !backend->writeNopData(os, size, STI)
+#else
+    if (!backend || !backend->writeNopData(os, size)
+#endif
+        || padding.size() != size) {
+        aot_set_last_error("get code padding failed.");
+        return false;
+    }
+    bh_memcpy_s(buf, size, padding.data(), size);
+    return true;
+}
@@ -41,6 +41,29 @@ typedef struct AOTCompOption {
     const char *stack_usage_file;
     const char *llvm_passes;
     const char *builtin_intrinsics;
+    /* Number of threads to compile the module with, 0 or 1 means the
+       functions are compiled serially in a single LLVM module */
+    uint32_t thread_num;
+    /* Emit the text section page-aligned and pre-relocated, so that the
+       runtime can map it from the AOT file and share it between processes,
+       requires the indirect mode */
+    bool enable_shared_text;
+    /* Charge the fuel of the exec_env before each control instruction */
+    bool enable_fuel_metering;
+    /* Poll the safepoint page of the exec_env at the loop back-edges,
+       which is made inaccessible by the runtime to interrupt the thread,
+       instead of checking the suspend flags */
+    bool enable_safepoint_page;
+    /* Call the write barrier after storing a reference into a struct
+       or an array, so that the runtime can use the GC nursery */
+    bool enable_gc_write_barrier;
+    /* Call the pre-write barrier before overwriting a reference in a struct
+       or an array, so that the runtime can use the incremental GC */
+    bool enable_gc_pre_write_barrier;
+    /* Check the app addresses of the memory accesses against the shared
+       heap attached to the instance, which is mapped at the top of the
+       32-bit app address space */
+    bool enable_shared_heap;
 } AOTCompOption, *aot_comp_option_t;
 
 #endif
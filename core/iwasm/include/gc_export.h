@@ -155,6 +155,22 @@ typedef uintptr_t wasm_i31_obj_t;
 
 typedef void (*wasm_obj_finalizer_t)(const wasm_obj_t obj, void *data);
 
+#define WASM_GC_PAUSE_HISTOGRAM_SIZE 16
+
+/* The pause times of the GC heap, all in microseconds */
+typedef struct wasm_gc_pause_stats_t {
+    /* the number of pauses, a stop-the-world collection or a slice of
+       the incremental collection */
+    uint64_t pause_count;
+    /* the number of completed collection cycles */
+    uint64_t gc_count;
+    uint64_t total_pause_us;
+    uint64_t max_pause_us;
+    /* histogram[i] counts the pauses shorter than (16 << i) us and not
+       counted by the previous buckets, the last bucket counts the rest */
+    uint64_t histogram[WASM_GC_PAUSE_HISTOGRAM_SIZE];
+} wasm_gc_pause_stats_t;
+
 /* Defined type related operations */
 
 /**
@@ -943,6 +959,47 @@ wasm_obj_set_gc_finalizer(wasm_exec_env_t exec_env, const wasm_obj_t obj,
 void
 wasm_obj_unset_gc_finalizer(wasm_exec_env_t exec_env, void *obj);
 
+/**
+ * Set the pause budget of the incremental GC of a module instance, each
+ * slice of the marking or sweeping stops after running for about the
+ * budget. It requires WAMR_BUILD_GC_INCREMENTAL=1.
+ *
+ * @param module_inst the module instance
+ * @param budget_us the budget in microseconds, 0 for the default budget
+ *
+ * @return true if success, false if the incremental GC isn't supported
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_gc_pause_budget(wasm_module_inst_t module_inst,
+                                 uint32_t budget_us);
+
+/**
+ * Get the pause time statistics of the GC heap of a module instance.
+ * It requires WAMR_BUILD_GC_INCREMENTAL=1.
+ *
+ * @param module_inst the module instance
+ * @param stats the buffer to return the statistics
+ *
+ * @return true if success, false if the incremental GC isn't supported
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_get_gc_pause_stats(wasm_module_inst_t module_inst,
+                                wasm_gc_pause_stats_t *stats);
+
+/**
+ * Run a slice of the incremental GC of a module instance, e.g. when the
+ * host is idle between requests. It starts a collection cycle if the
+ * heap is short of free space, and does nothing if no cycle is needed.
+ * It must not be called while the wasm code of the instance is running
+ * in another thread.
+ *
+ * @param module_inst the module instance
+ *
+ * @return true if a collection cycle is still in progress, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_gc_step(wasm_module_inst_t module_inst);
+
 #ifdef __cplusplus
 }
 #endif
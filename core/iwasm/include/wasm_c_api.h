@@ -199,6 +199,17 @@ typedef struct InstantiationArgs {
     uint32_t default_stack_size;
     uint32_t host_managed_heap_size;
     uint32_t max_memory_pages;
+    /* Instantiate from the copy-on-write snapshot of the module, which
+       is taken at the first instantiation, only used when
+       WASM_ENABLE_MEMORY_SNAPSHOT is enabled */
+    bool enable_snapshot;
+    /* The export function to run before taking the snapshot, NULL if
+       no function needs to be run */
+    const char *snapshot_init_func;
+    /* Keep the state of the instance right after instantiation, so that
+       it can be restored by wasm_runtime_instance_reset, only used when
+       WASM_ENABLE_INSTANCE_RESET is enabled */
+    bool enable_reset;
 } InstantiationArgs;
 #endif /* INSTANTIATION_ARGS_OPTION_DEFINED */
 
@@ -534,6 +545,10 @@ typedef struct LoadArgs {
     bool clone_wasm_binary;
     /* This option is only used by the AOT/wasm loader (see wasm_export.h) */
     bool wasm_binary_freeable;
+    /* This option is only used by the wasm loader (see wasm_export.h) */
+    bool lazy_func_validation;
+    /* This option is only used by the wasm loader (see wasm_export.h) */
+    const char *fast_interp_cache_dir;
     /* TODO: more fields? */
 } LoadArgs;
 #endif /* LOAD_ARGS_OPTION_DEFINED */
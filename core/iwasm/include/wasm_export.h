@@ -127,6 +127,14 @@ typedef struct wasm_section_t {
 struct WASMExecEnv;
 typedef struct WASMExecEnv *wasm_exec_env_t;
 
+/* Heap shared by the module instances attached */
+struct WASMSharedHeap;
+typedef struct WASMSharedHeap *wasm_shared_heap_t;
+
+/* Pool of module instances which are reset when released */
+struct WASMInstancePool;
+typedef struct WASMInstancePool *wasm_instance_pool_t;
+
 /* Package Type */
 typedef enum {
     Wasm_Module_Bytecode = 0,
@@ -177,6 +185,34 @@ typedef struct mem_alloc_info_t {
     uint32_t highmark_size;
 } mem_alloc_info_t;
 
+/* Thread pool statistics */
+typedef struct thread_pool_stats_t {
+    /* Max idle threads kept in the pool, 0 if the pool is disabled */
+    uint32_t pool_size;
+    /* Native threads owned by the pool, including the running ones */
+    uint32_t worker_count;
+    /* Native threads parked in the pool */
+    uint32_t idle_count;
+    /* Threads spawned with a parked native thread */
+    uint64_t hit_count;
+    /* Threads spawned with a newly created native thread */
+    uint64_t miss_count;
+} thread_pool_stats_t;
+
+/* Linear memory pool statistics */
+typedef struct linear_memory_pool_stats_t {
+    /* Max reserved slots kept in the pool, 0 if the pool is disabled */
+    uint32_t pool_size;
+    /* Reserved slots ready to be used */
+    uint32_t free_count;
+    /* Bytes of the free slots which are kept resident */
+    uint64_t resident_size;
+    /* Linear memories allocated with a pooled slot */
+    uint64_t hit_count;
+    /* Linear memories allocated with a new reservation */
+    uint64_t miss_count;
+} linear_memory_pool_stats_t;
+
 /* Running mode of runtime and module instance*/
 typedef enum RunningMode {
     Mode_Interp = 1,
@@ -227,6 +263,18 @@ typedef struct RuntimeInitArgs {
      * - interpreter. TBD
      */
     bool enable_linux_perf;
+
+    /* Max idle native threads kept to run the spawned wasm threads,
+       0 means the thread pool is disabled, only used when
+       WASM_ENABLE_THREAD_MGR is defined */
+    uint32_t thread_pool_size;
+
+    /* Max reserved linear memory slots kept for reuse and the bytes at
+       the beginning of each slot kept resident, only used when the
+       hardware bound check is enabled, see
+       wasm_runtime_set_linear_memory_pool */
+    uint32_t linear_memory_pool_size;
+    uint64_t linear_memory_keep_resident_size;
 } RuntimeInitArgs;
 
 #ifndef LOAD_ARGS_OPTION_DEFINED
@@ -240,6 +288,20 @@ typedef struct LoadArgs {
     const strings), making it possible to free the wasm binary buffer after
     loading. */
     bool wasm_binary_freeable;
+    /* False by default, used by wasm loader only when
+    WASM_ENABLE_LAZY_FUNC_VALIDATION is enabled.
+    If true, the function bodies are validated and prepared when they are
+    called for the first time instead of at load time, and the wasm binary
+    buffer must be kept until the module is unloaded. */
+    bool lazy_func_validation;
+    /* NULL by default, used by wasm loader only when
+    WASM_ENABLE_FAST_INTERP_CACHE is enabled.
+    The directory to cache the bytecode prepared by the fast interpreter in.
+    If the cache of the same wasm binary built by the same runtime exists,
+    the function bodies aren't validated and prepared again but mapped from
+    the cache file, otherwise the cache file is created after loading.
+    The directory must only be writable by trusted users. */
+    const char *fast_interp_cache_dir;
     /* TODO: more fields? */
 } LoadArgs;
 #endif /* LOAD_ARGS_OPTION_DEFINED */
@@ -251,9 +313,26 @@ typedef struct InstantiationArgs {
     uint32_t default_stack_size;
     uint32_t host_managed_heap_size;
     uint32_t max_memory_pages;
+    /* Instantiate from the copy-on-write snapshot of the module, which
+       is taken at the first instantiation, only used when
+       WASM_ENABLE_MEMORY_SNAPSHOT is enabled */
+    bool enable_snapshot;
+    /* The export function to run before taking the snapshot, NULL if
+       no function needs to be run */
+    const char *snapshot_init_func;
+    /* Keep the state of the instance right after instantiation, so that
+       it can be restored by wasm_runtime_instance_reset, only used when
+       WASM_ENABLE_INSTANCE_RESET is enabled */
+    bool enable_reset;
 } InstantiationArgs;
 #endif /* INSTANTIATION_ARGS_OPTION_DEFINED */
 
+/* Shared heap creation arguments */
+typedef struct SharedHeapInitArgs {
+    /* The size of the heap, which is rounded up to the page size */
+    uint32_t size;
+} SharedHeapInitArgs;
+
 #ifndef WASM_VALKIND_T_DEFINED
 #define WASM_VALKIND_T_DEFINED
 typedef uint8_t wasm_valkind_t;
@@ -394,6 +473,34 @@ wasm_runtime_free(void *ptr);
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_get_mem_alloc_info(mem_alloc_info_t *mem_alloc_info);
 
+/**
+ * Set up the pool of linear memory slots. With the hardware bound check
+ * each linear memory reserves 8GB of address space, the pool keeps the
+ * reservations of the destroyed memories and hands them out to the new
+ * ones to save the mmap/munmap system calls and the TLB shootdowns.
+ * A slot is zeroed when it is returned to the pool: the first
+ * keep_resident_size bytes are cleared and kept resident, the other
+ * pages are released to the OS. The slots are reserved in advance,
+ * and 0 pool_size disables the pool and unmaps the free slots.
+ *
+ * @param pool_size the max number of free slots kept in the pool
+ * @param keep_resident_size the bytes of each free slot kept resident
+ *
+ * @return true if success, false if the pool can't be created or the
+ *         hardware bound check isn't enabled
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_linear_memory_pool(uint32_t pool_size,
+                                    uint64_t keep_resident_size);
+
+/**
+ * Get the statistics of the linear memory pool
+ *
+ * @param stats the statistics to return
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_get_linear_memory_pool_stats(linear_memory_pool_stats_t *stats);
+
 /**
  * Get the package type of a buffer.
  *
@@ -495,6 +602,26 @@ WASM_RUNTIME_API_EXTERN wasm_module_t
 wasm_runtime_load_ex(uint8_t *buf, uint32_t size, const LoadArgs *args,
                      char *error_buf, uint32_t error_buf_size);
 
+/**
+ * Load a WASM module from an AOT file which is mapped into memory by the
+ * runtime instead of being read into a buffer, the mapping is kept until
+ * wasm_runtime_unload is called. The text of an AOT file generated by
+ * wamrc with `--enable-shared-text` isn't modified and is executed in
+ * place, so its pages are shared by all the modules and processes which
+ * load the same file. Only available when WAMR_BUILD_AOT_SHARED_TEXT is
+ * enabled.
+ *
+ * @param file_path the path of the AOT file
+ * @param args the load arguments, the wasm_binary_freeable field is ignored
+ * @param error_buf output of the exception info
+ * @param error_buf_size the size of the exception string
+ *
+ * @return return WASM module loaded, NULL if failed
+ */
+WASM_RUNTIME_API_EXTERN wasm_module_t
+wasm_runtime_load_aot_file_mapped(const char *file_path, const LoadArgs *args,
+                                  char *error_buf, uint32_t error_buf_size);
+
 /**
  * Load a WASM module from a specified WASM or AOT section list.
  *
@@ -618,7 +745,19 @@ wasm_runtime_instantiate(const wasm_module_t module,
  * Instantiate a WASM module, with specified instantiation arguments
  *
  * Same as wasm_runtime_instantiate, but it also allows overwriting maximum
- * memory
+ * memory.
+ *
+ * If args->enable_snapshot is set, the first call takes a snapshot of a
+ * fully initialized instance: the start function and args->snapshot_init_func
+ * (if not NULL, it must take no arguments and return no results) are
+ * executed, and the linear memory, globals and tables are saved. The later
+ * instances of the module map the saved memory copy-on-write and copy the
+ * globals and tables instead of initializing them, and neither the start
+ * function nor the init function is executed again. The snapshot is kept
+ * until the module is unloaded. Modules which import memories, tables or
+ * globals, have more than one memory, a shared memory or an externref
+ * table, or require an app heap (args->host_managed_heap_size must be 0)
+ * aren't supported.
  */
 WASM_RUNTIME_API_EXTERN wasm_module_inst_t
 wasm_runtime_instantiate_ex(const wasm_module_t module,
@@ -661,6 +800,100 @@ wasm_runtime_get_running_mode(wasm_module_inst_t module_inst);
 WASM_RUNTIME_API_EXTERN void
 wasm_runtime_deinstantiate(wasm_module_inst_t module_inst);
 
+/**
+ * Reset a WASM module instance to its state right after instantiation,
+ * which is cheaper than deinstantiating it and instantiating a new one.
+ * The instance must be created by wasm_runtime_instantiate_ex with
+ * args->enable_reset set, which fails if the module imports a memory or
+ * a table, or has more than one memory, a shared memory or an externref
+ * table.
+ *
+ * The linear memory is shrunk to its size after instantiation and its
+ * content is restored. When the memory is reserved with hardware bound
+ * check its pages are released and zero-filled again when touched,
+ * otherwise they're zeroed. The globals, tables and the dropped data and element
+ * segments are restored, and the exception is cleared. The app heap is
+ * restored to its state after instantiation, so the memory allocated from
+ * it since then, e.g. with wasm_runtime_module_malloc, mustn't be kept
+ * across resets. The start function isn't executed
+ * again, and the shared heap attached, the custom data and the contexts
+ * of the instance are kept.
+ *
+ * Note: the instance mustn't be running when it is reset. If the reset
+ * fails, the instance should be deinstantiated.
+ *
+ * @param module_inst the WASM module instance to reset
+ * @param reset_wasi whether to destroy the WASI context and initialize it
+ *        again with the WASI arguments of the module, which closes the
+ *        files opened by the instance and resets its exit code
+ * @param error_buf buffer to output the error info if failed
+ * @param error_buf_size the size of the error buffer
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_instance_reset(wasm_module_inst_t module_inst, bool reset_wasi,
+                            char *error_buf, uint32_t error_buf_size);
+
+/**
+ * Create a pool of WASM module instances for serving each request with a
+ * fresh instance: the instances are created in advance by
+ * wasm_runtime_instantiate_ex with args (args->enable_reset is implied),
+ * and reset by wasm_runtime_instance_reset when they are released.
+ *
+ * @param module the WASM module to instantiate
+ * @param args the instantiation arguments
+ * @param pool_size the number of instances
+ * @param reset_wasi whether to reset the WASI context of the instances
+ *        when they are released
+ * @param error_buf buffer to output the error info if failed
+ * @param error_buf_size the size of the error buffer
+ *
+ * @return the instance pool created if success, NULL otherwise
+ */
+WASM_RUNTIME_API_EXTERN wasm_instance_pool_t
+wasm_runtime_create_instance_pool(const wasm_module_t module,
+                                  const InstantiationArgs *args,
+                                  uint32_t pool_size, bool reset_wasi,
+                                  char *error_buf, uint32_t error_buf_size);
+
+/**
+ * Destroy an instance pool and the instances in it, the instances
+ * acquired must have been released
+ *
+ * @param pool the instance pool to destroy
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_destroy_instance_pool(wasm_instance_pool_t pool);
+
+/**
+ * Acquire an instance from an instance pool, it can be called from
+ * multiple threads
+ *
+ * @param pool the instance pool
+ *
+ * @return the module instance if success, NULL if all the instances
+ *         are in use
+ */
+WASM_RUNTIME_API_EXTERN wasm_module_inst_t
+wasm_runtime_instance_pool_acquire(wasm_instance_pool_t pool);
+
+/**
+ * Reset an instance and put it back to the pool it was acquired from.
+ * If the reset fails, the instance is deinstantiated and replaced with
+ * a new one.
+ *
+ * @param pool the instance pool
+ * @param module_inst the module instance to release
+ *
+ * @return true if success, false if the instance can't be reset and
+ *         a new one can't be instantiated either, in which case the
+ *         pool shrinks by one instance
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_instance_pool_release(wasm_instance_pool_t pool,
+                                   wasm_module_inst_t module_inst);
+
 /**
  * Get WASM module from WASM module instance
  *
@@ -1134,6 +1367,85 @@ WASM_RUNTIME_API_EXTERN uint64_t
 wasm_runtime_module_dup_data(wasm_module_inst_t module_inst, const char *src,
                              uint64_t size);
 
+/**
+ * Create a shared heap, which is mapped at the top of the 32-bit app
+ * address space of the module instances attached to it, so that the
+ * buffers allocated from it can be accessed in place by all of them.
+ * The heaps not destroyed are released when the runtime is destroyed.
+ *
+ * @param init_args the arguments of the shared heap
+ *
+ * @return the shared heap created if success, NULL otherwise
+ */
+WASM_RUNTIME_API_EXTERN wasm_shared_heap_t
+wasm_runtime_create_shared_heap(SharedHeapInitArgs *init_args);
+
+/**
+ * Destroy a shared heap, which must not be attached to any module
+ * instance
+ *
+ * @param shared_heap the shared heap to destroy
+ *
+ * @return true if success, false if it is still attached
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_destroy_shared_heap(wasm_shared_heap_t shared_heap);
+
+/**
+ * Attach a shared heap to a module instance, after which the app
+ * addresses in the heap can be loaded and stored by the wasm code
+ * and passed to the native APIs of the instance. It fails if another
+ * heap is attached, if the linear memory of the instance is 64-bit or
+ * shared, or is larger than the app offset where the heap starts, or
+ * if the AOT file isn't generated by `wamrc --enable-shared-heap`.
+ * The linear memory can't grow into the heap once it is attached.
+ *
+ * Note: the shared heap can't be attached or detached while the
+ * wasm code of the module instance is running.
+ *
+ * @param module_inst the WASM module instance
+ * @param shared_heap the shared heap to attach
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_attach_shared_heap(wasm_module_inst_t module_inst,
+                                wasm_shared_heap_t shared_heap);
+
+/**
+ * Detach the shared heap from a module instance, it is also detached
+ * when the module instance is deinstantiated
+ *
+ * @param module_inst the WASM module instance
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_detach_shared_heap(wasm_module_inst_t module_inst);
+
+/**
+ * Allocate memory from a shared heap
+ *
+ * @param shared_heap the shared heap
+ * @param size the size bytes to allocate
+ * @param p_native_addr return native address of the allocated memory
+ *        if it is not NULL, and return NULL if memory malloc failed
+ *
+ * @return the app address of the allocated memory, which is the same
+ *         in all the module instances the heap is attached to.
+ *         Return non-zero if success, zero if failed.
+ */
+WASM_RUNTIME_API_EXTERN uint64_t
+wasm_runtime_shared_heap_malloc(wasm_shared_heap_t shared_heap, uint64_t size,
+                                void **p_native_addr);
+
+/**
+ * Free memory to a shared heap
+ *
+ * @param shared_heap the shared heap
+ * @param ptr the app address of the memory to free
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_shared_heap_free(wasm_shared_heap_t shared_heap, uint64_t ptr);
+
 /**
  * Validate the app address, check whether it belongs to WASM module
  * instance's address space, or in its heap space or memory space.
@@ -1501,6 +1813,52 @@ wasm_runtime_set_user_data(wasm_exec_env_t exec_env, void *user_data);
 WASM_RUNTIME_API_EXTERN void *
 wasm_runtime_get_user_data(wasm_exec_env_t exec_env);
 
+/**
+ * Set the fuel of an execution environment. The wasm code run by it is
+ * charged with one unit of fuel per instruction executed, the cost of
+ * a region of straight-line code is charged at once when the control
+ * instruction (loop, if, else, end, br, br_if, br_table, return or a
+ * call) ending it is reached. The call traps with exception "out of fuel"
+ * when the fuel becomes negative, the fuel charged is the same whichever
+ * running mode the code runs with, so the trap is deterministic. The
+ * fuel is unlimited if it isn't set.
+ *
+ * The runtime must be built with WAMR_BUILD_FUEL_METERING=1, and the AOT
+ * file must be generated by wamrc with --enable-fuel-metering, the AOT
+ * code generated without it isn't metered.
+ *
+ * @param exec_env the execution environment
+ * @param fuel the fuel to set, clamped to INT64_MAX
+ *
+ * @return true if success, false if fuel metering isn't enabled
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_fuel(wasm_exec_env_t exec_env, uint64_t fuel);
+
+/**
+ * Add fuel to the remaining fuel of an execution environment, e.g. after
+ * the call trapped with exception "out of fuel", see wasm_runtime_set_fuel.
+ *
+ * @param exec_env the execution environment
+ * @param fuel the fuel to add, the sum is clamped to INT64_MAX
+ *
+ * @return true if success, false if fuel metering isn't enabled
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_add_fuel(wasm_exec_env_t exec_env, uint64_t fuel);
+
+/**
+ * Get the remaining fuel of an execution environment, see
+ * wasm_runtime_set_fuel.
+ *
+ * @param exec_env the execution environment
+ *
+ * @return the remaining fuel, 0 if it has run out or fuel metering isn't
+ *         enabled
+ */
+WASM_RUNTIME_API_EXTERN uint64_t
+wasm_runtime_get_fuel(wasm_exec_env_t exec_env);
+
 /**
  * Dump runtime memory consumption, including:
  *     Exec env memory consumption
@@ -1541,6 +1899,46 @@ WASM_RUNTIME_API_EXTERN double
 wasm_runtime_get_wasm_func_exec_time(wasm_module_inst_t inst,
                                      const char *func_name);
 
+/**
+ * Start or stop the sampling profiler. When started, the runtime samples
+ * the wasm call stack of the thread which is running each time the
+ * process has consumed interval_us of cpu time, and aggregates the
+ * samples in the background. Unlike the performance profiling, the wasm
+ * functions are not instrumented, and the profiling can be started and
+ * stopped at any time. A thread is sampled from its next call into wasm
+ * after the profiling is started. The samples of the previous profiling
+ * are discarded when it is started again.
+ *
+ * The runtime must be built with WAMR_BUILD_SAMPLING_PROFILING=1, and
+ * the AOT file must be generated by wamrc with --enable-dump-call-stack
+ * so that the AOT functions push the call stack frames.
+ *
+ * @param enable true to start the profiling, false to stop it
+ * @param interval_us the sampling interval in microseconds of cpu time,
+ *        0 to use the default interval of 1000 microseconds
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_set_sampling_profiling(bool enable, uint32_t interval_us);
+
+/**
+ * Dump the call stacks sampled from a module instance in the collapsed
+ * format of FlameGraph, one line per call stack with its sample count,
+ * the function names are taken from the name section, the functions
+ * without a name are written as "aot_func#N", which can be translated
+ * with test-tools/flame-graph-helper. The samples are kept, so the
+ * profile can be dumped again later.
+ *
+ * @param module_inst the module instance whose samples to dump
+ * @param file_path the file to write, NULL to print to stdout
+ *
+ * @return true if success, false otherwise
+ */
+WASM_RUNTIME_API_EXTERN bool
+wasm_runtime_dump_sampling_profile(wasm_module_inst_t module_inst,
+                                   const char *file_path);
+
 /* wasm thread callback function type */
 typedef void *(*wasm_thread_callback_t)(wasm_exec_env_t, void *);
 /* wasm thread type */
@@ -1554,6 +1952,26 @@ typedef uintptr_t wasm_thread_t;
 WASM_RUNTIME_API_EXTERN void
 wasm_runtime_set_max_thread_num(uint32_t num);
 
+/**
+ * Set the max number of idle native threads kept in the thread pool.
+ * The native thread of an exited wasm thread is parked in the pool
+ * instead of exiting, and is reused by the next spawned wasm thread,
+ * 0 disables the pool and releases the parked
+ * threads. Should be called after the runtime is initialized.
+ *
+ * @param size the max idle native thread number
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_set_thread_pool_size(uint32_t size);
+
+/**
+ * Get the statistics of the thread pool
+ *
+ * @param stats the statistics to return
+ */
+WASM_RUNTIME_API_EXTERN void
+wasm_runtime_get_thread_pool_stats(thread_pool_stats_t *stats);
+
 /**
  * Spawn a new exec_env, the spawned exec_env
  *   can be used in other threads
@@ -1960,6 +2378,18 @@ wasm_runtime_detect_native_stack_overflow_size(wasm_exec_env_t exec_env,
 WASM_RUNTIME_API_EXTERN bool
 wasm_runtime_is_underlying_binary_freeable(const wasm_module_t module);
 
+/**
+ * Get the number of functions of a bytecode module whose bodies have been
+ * validated and prepared. It is the number of the functions called so far
+ * if the module was loaded with LoadArgs.lazy_func_validation, and all the
+ * functions defined by the module otherwise.
+ *
+ * @param module the target module
+ * @return the number of prepared functions, 0 for the AOT module
+ */
+WASM_RUNTIME_API_EXTERN uint32_t
+wasm_runtime_get_prepared_func_count(const wasm_module_t module);
+
 #ifdef __cplusplus
 }
 #endif
@@ -554,6 +554,8 @@ typedef struct WASMFunctionImport {
     const char *signature;
     /* attachment */
     void *attachment;
+    /* the call compiled from func_type and signature */
+    struct WASMNativeCallDesc *call_desc;
 #if WASM_ENABLE_GC != 0
     /* the type index of this function's func_type */
     uint32 type_idx;
@@ -628,6 +630,13 @@ typedef struct WASMImport {
     } u;
 } WASMImport;
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+/* The states of WASMFunction.prepare_state */
+#define WASM_FUNC_STATE_UNPREPARED 0
+#define WASM_FUNC_STATE_PREPARED 1
+#define WASM_FUNC_STATE_INVALID 2
+#endif
+
 struct WASMFunction {
 #if WASM_ENABLE_CUSTOM_NAME_SECTION != 0
     char *field_name;
@@ -671,6 +680,21 @@ struct WASMFunction {
     uint32 exception_handler_count;
 #endif
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    /* One of WASM_FUNC_STATE_XXX, it is only changed from UNPREPARED
+       with the module's lazy_prepare_lock held */
+    uint32 prepare_state;
+    /* The validation error of the function body if it is invalid */
+    char *prepare_error;
+#endif
+
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    /* Offsets of the pointer slots in code_compiled, only recorded
+       before the fast interpreter cache file is saved */
+    uint32 *code_relocs;
+    uint32 code_reloc_count;
+#endif
+
 #if WASM_ENABLE_FAST_JIT != 0 || WASM_ENABLE_JIT != 0 \
     || WASM_ENABLE_WAMR_COMPILER != 0
     /* Whether function has opcode memory.grow */
@@ -1078,6 +1102,29 @@ struct WASMModule {
 
     /* Whether the underlying wasm binary buffer can be freed */
     bool is_binary_freeable;
+
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    /* Whether the function bodies are validated and prepared when
+       they are called for the first time */
+    bool is_lazy_func_validation;
+    /* The number of the prepared functions */
+    uint32 prepared_func_count;
+    korp_mutex lazy_prepare_lock;
+#endif
+
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    /* The mapped cache file which the prepared code and consts of the
+       functions point into, NULL if they are prepared by the loader */
+    struct WASMFastInterpCache *fast_interp_cache;
+    /* Whether to record the relocations of the prepared code, which
+       are required to save the cache file */
+    bool record_code_relocs;
+#endif
+
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    /* The snapshot to instantiate the module from */
+    struct WASMModuleSnapshot *snapshot;
+#endif
 };
 
 typedef struct BlockType {
@@ -0,0 +1,650 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "wasm_fast_interp_cache.h"
+#include "wasm_opcode.h"
+#include "../common/wasm_runtime_common.h"
+#include "../../version.h"
+
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/*
+ * Layout of the cache file, all the blocks are 8-byte aligned:
+ *   CacheFileHeader
+ *   CacheFileFunc[func_count]
+ *   the wasm binary
+ *   for each function: code, consts and relocs
+ *
+ * The binary hash only names the cache file, the wasm binary is compared
+ * byte by byte when the file is opened, so that a module whose hash
+ * collides never runs the prepared code of another module.
+ *
+ * Each reloc is the offset of a pointer slot in the code, with the kind
+ * of the slot in its top bits. The slot holds the position independent
+ * value of the pointer, which is relocated when the cache is attached.
+ */
+
+#define CACHE_MAGIC "WFIC"
+/* Bump it whenever the cache file or the prepared code changes */
+#define CACHE_VERSION 2
+
+#define CACHE_FLAG_POSSIBLE_MEMORY_GROW 1
+
+#define RELOC_KIND_SHIFT 30
+#define RELOC_OFFSET_MASK ((1U << RELOC_KIND_SHIFT) - 1)
+/* the address of a handler, saved relative to handle_table[0] */
+#define RELOC_KIND_LABEL 0
+/* an address in the code of the function, saved as offset */
+#define RELOC_KIND_CODE 1
+/* a label address which was never patched */
+#define RELOC_KIND_NULL 2
+
+typedef struct CacheFileHeader {
+    uint8 magic[4];
+    uint32 version;
+    uint64 build_id;
+    uint64 binary_hash;
+    uint32 binary_offset;
+    uint32 binary_size;
+    uint32 func_count;
+    uint32 flags;
+    uint32 file_size;
+    uint32 reserved;
+} CacheFileHeader;
+
+typedef struct CacheFileFunc {
+    uint32 code_offset;
+    uint32 code_size;
+    uint32 consts_offset;
+    uint32 const_cell_num;
+    uint32 relocs_offset;
+    uint32 reloc_count;
+    uint32 max_stack_cell_num;
+    uint32 max_block_num;
+} CacheFileFunc;
+
+struct WASMFastInterpCache {
+    uint8 *base;
+    uint32 size;
+    /* the path of the cache file, which is removed if it is corrupted */
+    char path[1];
+};
+
+/* The handlers of the fast interpreter which the labels point to */
+typedef struct HandlerRange {
+    uint8 *base;
+    intptr_t min_offset;
+    intptr_t max_offset;
+} HandlerRange;
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+void **
+wasm_interp_get_handle_table();
+#endif
+
+static void
+get_handler_range(HandlerRange *range)
+{
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+    void **handle_table = wasm_interp_get_handle_table();
+    intptr_t offset;
+    uint32 i;
+
+    range->base = (uint8 *)handle_table[0];
+    range->min_offset = range->max_offset = 0;
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++) {
+        if (!handle_table[i])
+            continue;
+        offset = (intptr_t)((uint8 *)handle_table[i] - range->base);
+        if (offset < range->min_offset)
+            range->min_offset = offset;
+        if (offset > range->max_offset)
+            range->max_offset = offset;
+    }
+#else
+    /* The labels are opcodes, there is no pointer to the handlers */
+    range->base = NULL;
+    range->min_offset = 1;
+    range->max_offset = 0;
+#endif
+}
+
+static inline uint64
+rotl64(uint64 v, uint32 n)
+{
+    return (v << n) | (v >> (64 - n));
+}
+
+static inline uint64
+hash_word(uint64 h, uint64 v)
+{
+    v *= 0x87c37b91114253d5ULL;
+    v = rotl64(v, 31);
+    v *= 0x4cf5ad432745937fULL;
+    h ^= v;
+    return rotl64(h, 27) * 5 + 0x52dce729;
+}
+
+static uint64
+hash_bytes(uint64 h, const uint8 *buf, uint32 size)
+{
+    const uint8 *p = buf, *p_end = buf + size;
+    uint64 v;
+
+    for (; p_end - p >= 8; p += 8) {
+        memcpy(&v, p, sizeof(uint64));
+        h = hash_word(h, v);
+    }
+    if (p < p_end) {
+        v = 0;
+        memcpy(&v, p, (uint32)(p_end - p));
+        h = hash_word(h, v);
+    }
+
+    /* final avalanche */
+    h ^= size;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+uint64
+wasm_fast_interp_cache_hash(const uint8 *buf, uint32 size)
+{
+    return hash_bytes(0, buf, size);
+}
+
+/* The prepared code depends on the features and the address of the
+   handlers of the fast interpreter, so the cache file can only be used
+   by the same runtime build which creates it */
+static uint64
+get_build_id(void)
+{
+    uint64 items[] = {
+        CACHE_VERSION,
+        sizeof(void *),
+        WAMR_VERSION_MAJOR,
+        WAMR_VERSION_MINOR,
+        WAMR_VERSION_PATCH,
+        WASM_ENABLE_LABELS_AS_VALUES,
+        WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS,
+        WASM_ENABLE_SIMD,
+        WASM_ENABLE_REF_TYPES,
+        WASM_ENABLE_BULK_MEMORY,
+        WASM_ENABLE_SHARED_MEMORY,
+        WASM_ENABLE_MEMORY64,
+        WASM_ENABLE_TAIL_CALL,
+        WASM_ENABLE_MULTI_MODULE,
+        WASM_ENABLE_FUEL_METERING,
+    };
+    uint64 h = hash_bytes(0, (uint8 *)items, (uint32)sizeof(items));
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+    void **handle_table = wasm_interp_get_handle_table();
+    uint32 i;
+
+    /* the handlers of the opcodes not implemented are NULL */
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++) {
+        h = hash_word(h, handle_table[i]
+                             ? (uint64)((uint8 *)handle_table[i]
+                                        - (uint8 *)handle_table[0])
+                             : 0);
+    }
+#endif
+    return h;
+}
+
+static bool
+get_cache_file_path(const char *cache_dir, uint64 binary_hash,
+                    char *buf, uint32 buf_size)
+{
+    int ret = snprintf(buf, buf_size, "%s/%016" PRIx64 "-%016" PRIx64 ".wfic",
+                       cache_dir, binary_hash, get_build_id());
+    return ret > 0 && (uint32)ret < buf_size;
+}
+
+static uint32
+align_offset(uint64 offset)
+{
+    return (uint32)align_uint64(offset, 8);
+}
+
+WASMFastInterpCache *
+wasm_fast_interp_cache_open(const char *cache_dir, uint64 binary_hash,
+                            const uint8 *binary, uint32 binary_size)
+{
+    WASMFastInterpCache *cache;
+    CacheFileHeader *header;
+    char path[PATH_MAX];
+    struct stat st;
+    uint8 *base;
+    int fd;
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0 \
+    && WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 && UINTPTR_MAX == UINT32_MAX
+    /* The labels are emitted as absolute 32-bit addresses */
+    return NULL;
+#endif
+
+    if (!get_cache_file_path(cache_dir, binary_hash, path, sizeof(path)))
+        return NULL;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return NULL;
+
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t)sizeof(CacheFileHeader)
+        || (uint64)st.st_size > UINT32_MAX) {
+        close(fd);
+        return NULL;
+    }
+
+    /* Map it privately and writable since the pointers in the code are
+       relocated in place */
+    base = mmap(NULL, (size_t)st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+        return NULL;
+
+    header = (CacheFileHeader *)base;
+    if (memcmp(header->magic, CACHE_MAGIC, 4) != 0
+        || header->version != CACHE_VERSION
+        || header->build_id != get_build_id()
+        || header->binary_hash != binary_hash
+        || header->binary_size != binary_size
+        || header->file_size != (uint32)st.st_size
+        || (header->binary_offset & 7) != 0
+        || (uint64)header->binary_offset + binary_size > header->file_size
+        || memcmp(base + header->binary_offset, binary, binary_size) != 0) {
+        LOG_VERBOSE("Ignore mismatched fast interpreter cache file %s", path);
+        munmap(base, (size_t)st.st_size);
+        return NULL;
+    }
+
+    if (!(cache = wasm_runtime_malloc(sizeof(WASMFastInterpCache)
+                                      + (uint32)strlen(path)))) {
+        munmap(base, (size_t)st.st_size);
+        return NULL;
+    }
+    cache->base = base;
+    cache->size = (uint32)st.st_size;
+    bh_strcpy_s(cache->path, (uint32)strlen(path) + 1, path);
+
+    LOG_VERBOSE("Open fast interpreter cache file %s", path);
+    return cache;
+}
+
+static void
+cache_close(WASMFastInterpCache *cache)
+{
+    munmap(cache->base, cache->size);
+    wasm_runtime_free(cache);
+}
+
+static bool
+check_block(const WASMFastInterpCache *cache, uint32 offset, uint64 size,
+            uint32 align)
+{
+    return (offset & (align - 1)) == 0 && (uint64)offset + size <= cache->size;
+}
+
+static bool
+check_func(const WASMFastInterpCache *cache, const CacheFileFunc *cf,
+           const HandlerRange *handlers)
+{
+    const uint32 *relocs;
+    uint8 *code, *slot;
+    uintptr_t value;
+    uint32 i, kind, offset, next_offset = 0;
+
+    if (cf->code_size == 0 || !check_block(cache, cf->code_offset,
+                                           cf->code_size, 8))
+        return false;
+    if (cf->const_cell_num > 0
+        && !check_block(cache, cf->consts_offset,
+                        (uint64)cf->const_cell_num * 4, 8))
+        return false;
+    if (!check_block(cache, cf->relocs_offset,
+                     (uint64)cf->reloc_count * sizeof(uint32), 8))
+        return false;
+
+    code = cache->base + cf->code_offset;
+    relocs = (const uint32 *)(cache->base + cf->relocs_offset);
+    for (i = 0; i < cf->reloc_count; i++) {
+        kind = relocs[i] >> RELOC_KIND_SHIFT;
+        offset = relocs[i] & RELOC_OFFSET_MASK;
+        /* the slots must be sorted and mustn't overlap */
+        if (offset < next_offset
+            || (uint64)offset + sizeof(void *) > cf->code_size)
+            return false;
+        next_offset = offset + (uint32)sizeof(void *);
+
+        slot = code + offset;
+        memcpy(&value, slot, sizeof(uintptr_t));
+        switch (kind) {
+            case RELOC_KIND_CODE:
+                if (value > cf->code_size)
+                    return false;
+                break;
+            case RELOC_KIND_NULL:
+                if (value != 0)
+                    return false;
+                break;
+            case RELOC_KIND_LABEL:
+                if ((intptr_t)value < handlers->min_offset
+                    || (intptr_t)value > handlers->max_offset)
+                    return false;
+                break;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+static bool
+attach_cache(WASMFastInterpCache *cache, WASMModule *module)
+{
+    CacheFileHeader *header = (CacheFileHeader *)cache->base;
+    CacheFileFunc *cfs = (CacheFileFunc *)(header + 1);
+    WASMFunction *func;
+    HandlerRange handlers;
+    const uint32 *relocs;
+    uint8 *code, *slot;
+    uintptr_t value;
+    uint32 i, j;
+
+    if (header->func_count != module->function_count
+        || !check_block(cache, (uint32)sizeof(CacheFileHeader),
+                        (uint64)header->func_count * sizeof(CacheFileFunc),
+                        8))
+        return false;
+
+    /* Check all the functions before modifying any of them */
+    get_handler_range(&handlers);
+    for (i = 0; i < header->func_count; i++) {
+        if (!check_func(cache, &cfs[i], &handlers))
+            return false;
+    }
+
+    for (i = 0; i < header->func_count; i++) {
+        func = module->functions[i];
+        code = cache->base + cfs[i].code_offset;
+        relocs = (const uint32 *)(cache->base + cfs[i].relocs_offset);
+
+        for (j = 0; j < cfs[i].reloc_count; j++) {
+            slot = code + (relocs[j] & RELOC_OFFSET_MASK);
+            memcpy(&value, slot, sizeof(uintptr_t));
+            switch (relocs[j] >> RELOC_KIND_SHIFT) {
+                case RELOC_KIND_CODE:
+                    STORE_PTR(slot, code + value);
+                    break;
+                case RELOC_KIND_LABEL:
+                    STORE_PTR(slot, handlers.base + (intptr_t)value);
+                    break;
+                default:
+                    break;
+            }
+        }
+
+        func->code_compiled = code;
+        func->code_compiled_size = cfs[i].code_size;
+        func->consts = cfs[i].const_cell_num > 0
+                           ? cache->base + cfs[i].consts_offset
+                           : NULL;
+        func->const_cell_num = cfs[i].const_cell_num;
+        func->max_stack_cell_num = cfs[i].max_stack_cell_num;
+        func->max_block_num = cfs[i].max_block_num;
+    }
+
+    if (header->flags & CACHE_FLAG_POSSIBLE_MEMORY_GROW)
+        module->possible_memory_grow = true;
+
+    /* The mapping is never written after relocating */
+    mprotect(cache->base, cache->size, PROT_READ);
+    return true;
+}
+
+bool
+wasm_fast_interp_cache_attach(WASMModule *module)
+{
+    WASMFastInterpCache *cache = module->fast_interp_cache;
+
+    bh_assert(cache);
+    if (!attach_cache(cache, module)) {
+        LOG_WARNING("warning: remove corrupted fast interpreter cache file %s",
+                    cache->path);
+        /* It is created again by the next load of the module */
+        unlink(cache->path);
+        cache_close(cache);
+        module->fast_interp_cache = NULL;
+        return false;
+    }
+    return true;
+}
+
+void
+wasm_fast_interp_cache_detach(WASMModule *module)
+{
+    WASMFastInterpCache *cache = module->fast_interp_cache;
+    uint8 *cache_end;
+    uint32 i;
+
+    if (!cache)
+        return;
+
+    cache_end = cache->base + cache->size;
+    for (i = 0; module->functions && i < module->function_count; i++) {
+        WASMFunction *func = module->functions[i];
+        if (!func)
+            continue;
+        if (func->code_compiled >= cache->base
+            && func->code_compiled < cache_end)
+            func->code_compiled = NULL;
+        if (func->consts >= cache->base && func->consts < cache_end)
+            func->consts = NULL;
+    }
+
+    cache_close(cache);
+    module->fast_interp_cache = NULL;
+}
+
+/* Convert the pointers in the copied code to position independent values,
+   the slots are the ones recorded by the loader */
+static bool
+convert_func_code(const WASMFunction *func, const HandlerRange *handlers,
+                  uint8 *code, uint32 *relocs)
+{
+    uint8 *slot, *value;
+    intptr_t handler_offset;
+    uint32 i, kind, offset;
+
+    for (i = 0; i < func->code_reloc_count; i++) {
+        offset = func->code_relocs[i];
+        if (offset > RELOC_OFFSET_MASK
+            || (uint64)offset + sizeof(void *) > func->code_compiled_size)
+            return false;
+
+        slot = code + offset;
+        memcpy(&value, slot, sizeof(uint8 *));
+        if (!value) {
+            kind = RELOC_KIND_NULL;
+        }
+        else if (value >= func->code_compiled
+                 && value <= func->code_compiled + func->code_compiled_size) {
+            kind = RELOC_KIND_CODE;
+            STORE_PTR(slot, (uintptr_t)(value - func->code_compiled));
+        }
+        else {
+            handler_offset = (intptr_t)(value - handlers->base);
+            if (handler_offset < handlers->min_offset
+                || handler_offset > handlers->max_offset)
+                return false;
+            kind = RELOC_KIND_LABEL;
+            STORE_PTR(slot, handler_offset);
+        }
+        relocs[i] = (kind << RELOC_KIND_SHIFT) | offset;
+    }
+    return true;
+}
+
+static bool
+write_all(int fd, const uint8 *buf, uint32 size)
+{
+    ssize_t ret;
+
+    while (size > 0) {
+        ret = write(fd, buf, size);
+        if (ret < 0) {
+            if (errno == EINTR)
+                continue;
+            return false;
+        }
+        buf += ret;
+        size -= (uint32)ret;
+    }
+    return true;
+}
+
+bool
+wasm_fast_interp_cache_save(const char *cache_dir, uint64 binary_hash,
+                            const uint8 *binary, uint32 binary_size,
+                            const WASMModule *module)
+{
+    CacheFileHeader *header;
+    CacheFileFunc *cfs;
+    WASMFunction *func;
+    HandlerRange handlers;
+    char path[PATH_MAX], tmp_path[PATH_MAX + 32];
+    uint8 *buf = NULL;
+    uint64 offset;
+    uint32 i, binary_offset, file_size;
+    int fd = -1;
+    bool ret = false;
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0 \
+    && WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 && UINTPTR_MAX == UINT32_MAX
+    LOG_WARNING("warning: fast interpreter cache isn't supported by the "
+                "target");
+    return false;
+#endif
+
+    if (!get_cache_file_path(cache_dir, binary_hash, path, sizeof(path)))
+        return false;
+
+    /* Layout the file */
+    offset = align_offset(sizeof(CacheFileHeader)
+                          + (uint64)sizeof(CacheFileFunc)
+                                * module->function_count);
+    if (offset > UINT32_MAX)
+        return false;
+    binary_offset = (uint32)offset;
+    offset = align_offset(offset + binary_size);
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+        if (!func->code_compiled
+            || (func->code_reloc_count > 0 && !func->code_relocs))
+            return false;
+        offset = align_offset(offset + func->code_compiled_size);
+        offset = align_offset(offset + (uint64)func->const_cell_num * 4);
+        offset = align_offset(offset
+                              + (uint64)func->code_reloc_count
+                                    * sizeof(uint32));
+        if (offset > UINT32_MAX)
+            return false;
+    }
+    file_size = (uint32)offset;
+
+    if (!(buf = wasm_runtime_malloc(file_size)))
+        return false;
+    memset(buf, 0, file_size);
+
+    header = (CacheFileHeader *)buf;
+    bh_memcpy_s(header->magic, sizeof(header->magic), CACHE_MAGIC, 4);
+    header->version = CACHE_VERSION;
+    header->build_id = get_build_id();
+    header->binary_hash = binary_hash;
+    header->binary_offset = binary_offset;
+    header->binary_size = binary_size;
+    header->func_count = module->function_count;
+    header->flags =
+        module->possible_memory_grow ? CACHE_FLAG_POSSIBLE_MEMORY_GROW : 0;
+    header->file_size = file_size;
+
+    bh_memcpy_s(buf + binary_offset, file_size - binary_offset, binary,
+                binary_size);
+
+    get_handler_range(&handlers);
+    cfs = (CacheFileFunc *)(header + 1);
+    offset = align_offset((uint64)binary_offset + binary_size);
+    for (i = 0; i < module->function_count; i++) {
+        func = module->functions[i];
+
+        cfs[i].code_offset = (uint32)offset;
+        cfs[i].code_size = func->code_compiled_size;
+        bh_memcpy_s(buf + offset, file_size - (uint32)offset,
+                    func->code_compiled, func->code_compiled_size);
+        offset = align_offset(offset + func->code_compiled_size);
+
+        cfs[i].consts_offset = (uint32)offset;
+        cfs[i].const_cell_num = func->const_cell_num;
+        if (func->const_cell_num > 0) {
+            bh_memcpy_s(buf + offset, file_size - (uint32)offset,
+                        func->consts, func->const_cell_num * 4);
+        }
+        offset = align_offset(offset + (uint64)func->const_cell_num * 4);
+
+        cfs[i].relocs_offset = (uint32)offset;
+        cfs[i].reloc_count = func->code_reloc_count;
+        if (!convert_func_code(func, &handlers, buf + cfs[i].code_offset,
+                               (uint32 *)(buf + offset))) {
+            LOG_WARNING("warning: failed to relocate the code of function %u "
+                        "for fast interpreter cache",
+                        i);
+            goto fail;
+        }
+        offset = align_offset(offset
+                              + (uint64)func->code_reloc_count
+                                    * sizeof(uint32));
+
+        cfs[i].max_stack_cell_num = func->max_stack_cell_num;
+        cfs[i].max_block_num = func->max_block_num;
+    }
+
+    /* Write to a temporary file and rename it, so that a concurrent loader
+       never sees a partially written cache file */
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d.tmp", path, (int)getpid());
+    if ((fd = open(tmp_path, O_WRONLY | O_CREAT | O_EXCL, 0644)) < 0)
+        goto fail;
+
+    if (!write_all(fd, buf, file_size)) {
+        close(fd);
+        unlink(tmp_path);
+        goto fail;
+    }
+    close(fd);
+
+    if (rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        goto fail;
+    }
+
+    LOG_VERBOSE("Save fast interpreter cache file %s", path);
+    ret = true;
+fail:
+    wasm_runtime_free(buf);
+    return ret;
+}
+
+#endif /* end of WASM_ENABLE_FAST_INTERP_CACHE != 0 */
@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef _WASM_FAST_INTERP_CACHE_H
+#define _WASM_FAST_INTERP_CACHE_H
+
+#include "wasm.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct WASMFastInterpCache WASMFastInterpCache;
+
+/**
+ * Calculate the content hash of a wasm binary, which is used together
+ * with the build id of the runtime to name the cache file.
+ */
+uint64
+wasm_fast_interp_cache_hash(const uint8 *buf, uint32 size);
+
+/**
+ * Map the cache file of a wasm binary from the cache directory.
+ *
+ * @param binary the wasm binary, which must not be modified by the loader
+ *        yet, it is compared with the copy saved in the cache file
+ *
+ * @return the mapped cache, NULL if the cache file doesn't exist, was
+ *         created by a different runtime build or for a different binary
+ */
+WASMFastInterpCache *
+wasm_fast_interp_cache_open(const char *cache_dir, uint64 binary_hash,
+                            const uint8 *binary, uint32 binary_size);
+
+/**
+ * Check the cache mapped by wasm_fast_interp_cache_open and set to
+ * module->fast_interp_cache against the module whose sections are loaded.
+ * If it matches, set the prepared code and consts of all the functions to
+ * the ones in the cache, relocating the pointers in the code, otherwise
+ * remove the corrupted cache file, unmap it and reset
+ * module->fast_interp_cache.
+ */
+bool
+wasm_fast_interp_cache_attach(WASMModule *module);
+
+/**
+ * Reset the code and consts of the functions which point into the cache
+ * of the module, and unmap it.
+ */
+void
+wasm_fast_interp_cache_detach(WASMModule *module);
+
+/**
+ * Save the prepared code and consts of the functions of a loaded module
+ * into the cache directory, the relocations recorded by the loader are
+ * required. The original wasm binary, before the loader modified it, is
+ * saved together.
+ */
+bool
+wasm_fast_interp_cache_save(const char *cache_dir, uint64 binary_hash,
+                            const uint8 *binary, uint32 binary_size,
+                            const WASMModule *module);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* end of _WASM_FAST_INTERP_CACHE_H */
@@ -46,6 +46,20 @@ typedef float64 CellType_F64;
 #define get_linear_mem_size() GET_LINEAR_MEMORY_SIZE(memory)
 #endif
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+/* The shared heap attached ends at the top of the 32-bit app address
+   space, shared_heap_start_off is UINT64_MAX if no heap is attached.
+   It is checked before the linear memory, and is followed by the check
+   of the linear memory as the else branch. */
+#define CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)           \
+    if ((uint64)(offset1) >= shared_heap_start_off                  \
+        && (uint64)(offset1) + bytes <= (uint64)UINT32_MAX + 1)     \
+        maddr = shared_heap_base_addr_adj + (uint64)(offset1);      \
+    else
+#else
+#define CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)
+#endif
+
 #if WASM_ENABLE_MEMORY64 == 0
 
 #if (!defined(OS_ENABLE_HW_BOUND_CHECK) \
@@ -53,6 +67,7 @@ typedef float64 CellType_F64;
 #define CHECK_MEMORY_OVERFLOW(bytes)                                           \
     do {                                                                       \
         uint64 offset1 = (uint64)offset + (uint64)addr;                        \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)                      \
         if (disable_bounds_checks || offset1 + bytes <= get_linear_mem_size()) \
             /* If offset1 is in valid range, maddr must also                   \
                be in valid range, no need to check it again. */                \
@@ -64,6 +79,7 @@ typedef float64 CellType_F64;
 #define CHECK_BULK_MEMORY_OVERFLOW(start, bytes, maddr)                        \
     do {                                                                       \
         uint64 offset1 = (uint32)(start);                                      \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)                      \
         if (disable_bounds_checks || offset1 + bytes <= get_linear_mem_size()) \
             /* App heap space is not valid space for                           \
              bulk memory operation */                                          \
@@ -73,15 +89,17 @@ typedef float64 CellType_F64;
     } while (0)
 #else /* else of !defined(OS_ENABLE_HW_BOUND_CHECK) || \
          WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 */
-#define CHECK_MEMORY_OVERFLOW(bytes)                    \
-    do {                                                \
-        uint64 offset1 = (uint64)offset + (uint64)addr; \
-        maddr = memory->memory_data + offset1;          \
+#define CHECK_MEMORY_OVERFLOW(bytes)                      \
+    do {                                                  \
+        uint64 offset1 = (uint64)offset + (uint64)addr;   \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr) \
+        maddr = memory->memory_data + offset1;            \
     } while (0)
 
-#define CHECK_BULK_MEMORY_OVERFLOW(start, bytes, maddr) \
-    do {                                                \
-        maddr = memory->memory_data + (uint32)(start);  \
+#define CHECK_BULK_MEMORY_OVERFLOW(start, bytes, maddr)           \
+    do {                                                          \
+        CHECK_SHARED_HEAP_OVERFLOW((uint32)(start), bytes, maddr) \
+        maddr = memory->memory_data + (uint32)(start);            \
     } while (0)
 #endif /* end of !defined(OS_ENABLE_HW_BOUND_CHECK) || \
           WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 */
@@ -92,6 +110,7 @@ typedef float64 CellType_F64;
     do {                                                                    \
         uint64 offset1 = (uint64)offset + (uint64)addr;                     \
         /* If memory64 is enabled, offset1, offset1 + bytes can overflow */ \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)                   \
         if (disable_bounds_checks                                           \
             || (offset1 >= offset && offset1 + bytes >= offset1             \
                 && offset1 + bytes <= get_linear_mem_size()))               \
@@ -103,6 +122,7 @@ typedef float64 CellType_F64;
     do {                                                           \
         uint64 offset1 = (uint64)(start);                          \
         /* If memory64 is enabled, offset1 + bytes can overflow */ \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)          \
         if (disable_bounds_checks                                  \
             || (offset1 + bytes >= offset1                         \
                 && offset1 + bytes <= get_linear_mem_size()))      \
@@ -1212,6 +1232,11 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             argv_ret[1] = frame->lp[1];
         }
     }
+    else if (func_import->call_desc) {
+        ret = wasm_runtime_invoke_native_desc(
+            exec_env, native_func_pointer, func_import->call_desc,
+            func_import->attachment, frame->lp, argv_ret);
+    }
     else if (!func_import->call_conv_raw) {
         ret = wasm_runtime_invoke_native(
             exec_env, native_func_pointer, func_import->func_type,
@@ -1393,10 +1418,39 @@ wasm_interp_call_func_import(WASMModuleInstance *module_inst,
 #endif /* WASM_ENABLE_DEBUG_INTERP */
 #endif /* WASM_ENABLE_THREAD_MGR */
 
+#if WASM_ENABLE_FUEL_METERING != 0
+/* fuel_count is the number of opcodes executed since the last control
+   instruction, charge it together with the current control instruction
+   so as to get the same fuel consumption as the other running modes */
+#define CHARGE_FUEL()                                        \
+    do {                                                     \
+        exec_env->fuel -= fuel_count;                        \
+        fuel_count = 0;                                      \
+        if (exec_env->fuel < 0) {                            \
+            wasm_set_exception(module, "out of fuel");       \
+            goto got_exception;                              \
+        }                                                    \
+    } while (0)
+/* The opcode at the branch target is an end opcode which isn't charged
+   by the other running modes, skip it */
+#define SKIP_FUEL_OF_END() fuel_count = -1
+#else
+#define CHARGE_FUEL() (void)0
+#define SKIP_FUEL_OF_END() (void)0
+#endif
+
 #if WASM_ENABLE_LABELS_AS_VALUES != 0
 
 #define HANDLE_OP(opcode) HANDLE_##opcode:
+#if WASM_ENABLE_FUEL_METERING != 0
+#define FETCH_OPCODE_AND_DISPATCH()      \
+    do {                                 \
+        fuel_count++;                    \
+        goto *handle_table[*frame_ip++]; \
+    } while (0)
+#else
 #define FETCH_OPCODE_AND_DISPATCH() goto *handle_table[*frame_ip++]
+#endif
 
 #if WASM_ENABLE_THREAD_MGR != 0 && WASM_ENABLE_DEBUG_INTERP != 0
 #define HANDLE_OP_END()                                                   \
@@ -1457,6 +1511,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                                WASMInterpFrame *prev_frame)
 {
     WASMMemoryInstance *memory = wasm_get_default_memory(module);
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* The shared heap isn't attached or detached during the call */
+    uint64 shared_heap_start_off = module->e->common.shared_heap_start_off;
+    uint8 *shared_heap_base_addr_adj =
+        module->e->common.shared_heap_base_addr_adj;
+#endif
 #if !defined(OS_ENABLE_HW_BOUND_CHECK)              \
     || WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 \
     || WASM_ENABLE_BULK_MEMORY != 0
@@ -1466,6 +1526,8 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         linear_mem_size = memory->memory_data_size;
 #else
         linear_mem_size = GET_LINEAR_MEMORY_SIZE(memory);
+    /* Unused if it's reloaded by get_linear_mem_size() in each check */
+    (void)linear_mem_size;
 #endif
 #endif
     WASMFuncType **wasm_types = (WASMFuncType **)module->module->types;
@@ -1524,6 +1586,9 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_TAIL_CALL != 0 || WASM_ENABLE_GC != 0
     bool is_return_call = false;
 #endif
+#if WASM_ENABLE_FUEL_METERING != 0
+    int32 fuel_count = 0;
+#endif
 #if WASM_ENABLE_MEMORY64 != 0
     /* TODO: multi-memories for now assuming the memory idx type is consistent
      * across multi-memories */
@@ -1550,6 +1615,9 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_LABELS_AS_VALUES == 0
     while (frame_ip < frame_ip_end) {
         opcode = *frame_ip++;
+#if WASM_ENABLE_FUEL_METERING != 0
+        fuel_count++;
+#endif
         switch (opcode) {
 #else
     FETCH_OPCODE_AND_DISPATCH();
@@ -1989,6 +2057,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(EXT_OP_LOOP)
             {
+                CHARGE_FUEL();
                 read_leb_uint32(frame_ip, frame_ip_end, type_index);
                 param_cell_num =
                     ((WASMFuncType *)wasm_types[type_index])->param_cell_num;
@@ -1999,6 +2068,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_LOOP)
             {
+                CHARGE_FUEL();
                 value_type = *frame_ip++;
                 param_cell_num = 0;
                 cell_num = 0;
@@ -2009,6 +2079,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(EXT_OP_IF)
             {
+                CHARGE_FUEL();
                 read_leb_uint32(frame_ip, frame_ip_end, type_index);
                 param_cell_num =
                     ((WASMFuncType *)wasm_types[type_index])->param_cell_num;
@@ -2019,6 +2090,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_IF)
             {
+                CHARGE_FUEL();
                 value_type = *frame_ip++;
                 param_cell_num = 0;
                 cell_num = wasm_value_type_cell_num(value_type);
@@ -2065,12 +2137,15 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
             HANDLE_OP(WASM_OP_ELSE)
             {
                 /* comes from the if branch in WASM_OP_IF */
+                CHARGE_FUEL();
                 frame_ip = (frame_csp - 1)->target_addr;
+                SKIP_FUEL_OF_END();
                 HANDLE_OP_END();
             }
 
             HANDLE_OP(WASM_OP_END)
             {
+                CHARGE_FUEL();
                 if (frame_csp > frame->csp_bottom + 1) {
                     POP_CSP();
                 }
@@ -2094,6 +2169,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_BR)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2110,11 +2186,16 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                     }
                     frame_ip = end_addr;
                 }
+                if (frame_ip != (frame_csp - 1)->begin_addr) {
+                    /* not the branch to a loop */
+                    SKIP_FUEL_OF_END();
+                }
                 HANDLE_OP_END();
             }
 
             HANDLE_OP(WASM_OP_BR_IF)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2127,6 +2208,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_BR_TABLE)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2144,6 +2226,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                     bh_list_first_elem(module->module->br_table_cache_list);
                 BrTableCache *node_next;
 
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2165,6 +2248,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_RETURN)
             {
+                CHARGE_FUEL();
                 frame_sp -= cur_func->ret_cell_num;
                 for (i = 0; i < cur_func->ret_cell_num; i++) {
 #if WASM_ENABLE_GC != 0
@@ -2182,6 +2266,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_CALL)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2200,6 +2285,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_TAIL_CALL != 0
             HANDLE_OP(WASM_OP_RETURN_CALL)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2225,6 +2311,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 WASMTableInstance *tbl_inst;
                 uint32 tbl_idx;
 
+                CHARGE_FUEL();
 #if WASM_ENABLE_TAIL_CALL != 0
                 opcode = *(frame_ip - 1);
 #endif
@@ -2489,6 +2576,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_GC != 0
             HANDLE_OP(WASM_OP_CALL_REF)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2506,6 +2594,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_RETURN_CALL_REF)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2544,6 +2633,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_BR_ON_NULL)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -2559,6 +2649,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_BR_ON_NON_NULL)
             {
+                CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                 CHECK_SUSPEND_FLAGS();
 #endif
@@ -3161,6 +3252,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                         int32 heap_type, heap_type_dst;
                         uint8 castflags;
 
+                        CHARGE_FUEL();
 #if WASM_ENABLE_THREAD_MGR != 0
                         CHECK_SUSPEND_FLAGS();
 #endif
@@ -5578,9 +5670,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #ifndef OS_ENABLE_HW_BOUND_CHECK
                         CHECK_BULK_MEMORY_OVERFLOW(addr, bytes, maddr);
 #else
-                        if ((uint64)(uint32)addr + bytes > linear_mem_size)
-                            goto out_of_bounds;
-                        maddr = memory->memory_data + (uint32)addr;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)addr, bytes, maddr)
+                        {
+                            if ((uint64)(uint32)addr + bytes > linear_mem_size)
+                                goto out_of_bounds;
+                            maddr = memory->memory_data + (uint32)addr;
+                        }
 #endif
 
                         if (bh_bitmap_get_bit(module->e->common.data_dropped,
@@ -5597,7 +5692,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                         if (offset + bytes > seg_len)
                             goto out_of_bounds;
 
-                        bh_memcpy_s(maddr, (uint32)(linear_mem_size - addr),
+                        bh_memcpy_s(maddr, (uint32)bytes,
                                     data + offset, (uint32)bytes);
                         break;
                     }
@@ -5628,17 +5723,23 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                         CHECK_BULK_MEMORY_OVERFLOW(src, len, msrc);
                         CHECK_BULK_MEMORY_OVERFLOW(dst, len, mdst);
 #else
-                        if ((uint64)(uint32)src + len > linear_mem_size)
-                            goto out_of_bounds;
-                        msrc = memory->memory_data + (uint32)src;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)src, len, msrc)
+                        {
+                            if ((uint64)(uint32)src + len > linear_mem_size)
+                                goto out_of_bounds;
+                            msrc = memory->memory_data + (uint32)src;
+                        }
 
-                        if ((uint64)(uint32)dst + len > linear_mem_size)
-                            goto out_of_bounds;
-                        mdst = memory->memory_data + (uint32)dst;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)dst, len, mdst)
+                        {
+                            if ((uint64)(uint32)dst + len > linear_mem_size)
+                                goto out_of_bounds;
+                            mdst = memory->memory_data + (uint32)dst;
+                        }
 #endif
 
                         /* allowing the destination and source to overlap */
-                        bh_memmove_s(mdst, (uint32)(linear_mem_size - dst),
+                        bh_memmove_s(mdst, (uint32)len,
                                      msrc, len);
                         break;
                     }
@@ -5659,9 +5760,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #ifndef OS_ENABLE_HW_BOUND_CHECK
                         CHECK_BULK_MEMORY_OVERFLOW(dst, len, mdst);
 #else
-                        if ((uint64)(uint32)dst + len > linear_mem_size)
-                            goto out_of_bounds;
-                        mdst = memory->memory_data + (uint32)dst;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)dst, len, mdst)
+                        {
+                            if ((uint64)(uint32)dst + len > linear_mem_size)
+                                goto out_of_bounds;
+                            mdst = memory->memory_data + (uint32)dst;
+                        }
 #endif
 
                         memset(mdst, fill_val, len);
@@ -6238,6 +6342,10 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
             HANDLE_OP(WASM_OP_IMPDEP)
             {
+#if WASM_ENABLE_FUEL_METERING != 0
+                /* Not an opcode of the wasm code */
+                fuel_count = 0;
+#endif
                 frame = prev_frame;
                 frame_ip = frame->ip;
                 frame_sp = frame->sp;
@@ -6332,6 +6440,11 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_TAIL_CALL != 0 || WASM_ENABLE_GC != 0
     call_func_from_return_call:
     {
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        if (!wasm_ensure_func_prepared(module, cur_func)) {
+            goto got_exception;
+        }
+#endif
         POP(cur_func->param_cell_num);
         if (cur_func->param_cell_num > 0) {
             word_copy(frame->lp, frame_sp, cur_func->param_cell_num);
@@ -6346,6 +6459,11 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
     {
         /* Only do the copy when it's called from interpreter.  */
         WASMInterpFrame *outs_area = wasm_exec_env_wasm_stack_top(exec_env);
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        if (!wasm_ensure_func_prepared(module, cur_func)) {
+            goto got_exception;
+        }
+#endif
         if (cur_func->param_cell_num > 0) {
             POP(cur_func->param_cell_num);
             word_copy(outs_area->lp, frame_sp, cur_func->param_cell_num);
@@ -7136,6 +7254,12 @@ wasm_interp_call_wasm(WASMModuleInstance *module_inst, WASMExecEnv *exec_env,
     }
     argc = function->param_cell_num;
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    if (!wasm_ensure_func_prepared(module_inst, function)) {
+        return;
+    }
+#endif
+
 #if defined(OS_ENABLE_HW_BOUND_CHECK) && WASM_DISABLE_STACK_HW_BOUND_CHECK == 0
     /*
      * wasm_runtime_detect_native_stack_overflow is done by
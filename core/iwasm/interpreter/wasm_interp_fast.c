@@ -20,6 +20,18 @@
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "../common/wasm_shared_memory.h"
 #endif
+#if WASM_ENABLE_SIMD != 0
+/* The hot v128 operations are mapped to SSE2 or NEON intrinsics if
+   the target supports them, others are done lane by lane */
+#if defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define WASM_INTERP_SIMD_SSE2 1
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define WASM_INTERP_SIMD_NEON 1
+#endif
+#endif
 
 typedef int32 CellType_I32;
 typedef int64 CellType_I64;
@@ -37,11 +49,30 @@ typedef float64 CellType_F64;
 #define get_linear_mem_size() GET_LINEAR_MEMORY_SIZE(memory)
 #endif
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+/* The shared heap attached ends at the top of the 32-bit app address
+   space, shared_heap_start_off is UINT64_MAX if no heap is attached.
+   It is checked before the linear memory, and is followed by the check
+   of the linear memory as the else branch. */
+#define CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)           \
+    if ((uint64)(offset1) >= shared_heap_start_off                  \
+        && (uint64)(offset1) + bytes <= (uint64)UINT32_MAX + 1)     \
+        maddr = shared_heap_base_addr_adj + (uint64)(offset1);      \
+    else
+/* The accesses to the shared heap are not handled by the tail-call
+   dispatch handlers, which exit to the main loop for them */
+#define is_shared_heap_attached() (shared_heap_start_off != UINT64_MAX)
+#else
+#define CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)
+#define is_shared_heap_attached() false
+#endif
+
 #if !defined(OS_ENABLE_HW_BOUND_CHECK) \
     || WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0
 #define CHECK_MEMORY_OVERFLOW(bytes)                                           \
     do {                                                                       \
         uint64 offset1 = (uint64)offset + (uint64)addr;                        \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)                      \
         if (disable_bounds_checks || offset1 + bytes <= get_linear_mem_size()) \
             /* If offset1 is in valid range, maddr must also                   \
                 be in valid range, no need to check it again. */               \
@@ -53,6 +84,7 @@ typedef float64 CellType_F64;
 #define CHECK_BULK_MEMORY_OVERFLOW(start, bytes, maddr)                        \
     do {                                                                       \
         uint64 offset1 = (uint32)(start);                                      \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr)                      \
         if (disable_bounds_checks || offset1 + bytes <= get_linear_mem_size()) \
             /* App heap space is not valid space for                           \
                bulk memory operation */                                        \
@@ -60,17 +92,31 @@ typedef float64 CellType_F64;
         else                                                                   \
             goto out_of_bounds;                                                \
     } while (0)
+
+/* The memory size passed to the handlers of the tail-call dispatch */
+#define get_tail_memory_size()                                          \
+    (!memory ? 0                                                        \
+             : (disable_bounds_checks && !is_shared_heap_attached()     \
+                    ? UINT64_MAX                                        \
+                    : get_linear_mem_size()))
 #else
-#define CHECK_MEMORY_OVERFLOW(bytes)                    \
-    do {                                                \
-        uint64 offset1 = (uint64)offset + (uint64)addr; \
-        maddr = memory->memory_data + offset1;          \
+#define CHECK_MEMORY_OVERFLOW(bytes)                      \
+    do {                                                  \
+        uint64 offset1 = (uint64)offset + (uint64)addr;   \
+        CHECK_SHARED_HEAP_OVERFLOW(offset1, bytes, maddr) \
+        maddr = memory->memory_data + offset1;            \
     } while (0)
 
-#define CHECK_BULK_MEMORY_OVERFLOW(start, bytes, maddr) \
-    do {                                                \
-        maddr = memory->memory_data + (uint32)(start);  \
+#define CHECK_BULK_MEMORY_OVERFLOW(start, bytes, maddr)           \
+    do {                                                          \
+        CHECK_SHARED_HEAP_OVERFLOW((uint32)(start), bytes, maddr) \
+        maddr = memory->memory_data + (uint32)(start);            \
     } while (0)
+
+#define get_tail_memory_size()                                 \
+    (!memory ? 0                                               \
+             : (is_shared_heap_attached() ? GET_LINEAR_MEMORY_SIZE(memory) \
+                                          : UINT64_MAX))
 #endif /* !defined(OS_ENABLE_HW_BOUND_CHECK) \
           || WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 */
 
@@ -307,6 +353,38 @@ LOAD_PTR(void *addr)
 #endif /* end of UINTPTR_MAX */
 #endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 
+/* The frame cells are only 4-byte aligned, so v128 values are read
+   and written by parts */
+static inline V128
+GET_V128_FROM_ADDR(const uint32 *addr)
+{
+    union {
+        V128 val;
+        uint32 parts[4];
+    } u;
+
+    u.parts[0] = addr[0];
+    u.parts[1] = addr[1];
+    u.parts[2] = addr[2];
+    u.parts[3] = addr[3];
+    return u.val;
+}
+
+static inline void
+PUT_V128_TO_ADDR(uint32 *addr, V128 value)
+{
+    union {
+        V128 val;
+        uint32 parts[4];
+    } u;
+
+    u.val = value;
+    addr[0] = u.parts[0];
+    addr[1] = u.parts[1];
+    addr[2] = u.parts[2];
+    addr[3] = u.parts[3];
+}
+
 #if WASM_ENABLE_GC != 0
 static void
 init_frame_refs(uint8 *frame_ref, uint32 cell_num, WASMFunctionInstance *func)
@@ -435,6 +513,8 @@ wasm_interp_get_frame_ref(WASMInterpFrame *frame)
     (type) GET_F64_FROM_ADDR(frame_lp + *(int16 *)(frame_ip + off))
 #define GET_OPERAND_REF(type, off) \
     (type) GET_REF_FROM_ADDR(frame_lp + *(int16 *)(frame_ip + off))
+#define GET_OPERAND_V128(type, off) \
+    GET_V128_FROM_ADDR(frame_lp + *(int16 *)(frame_ip + off))
 
 #define GET_OPERAND(type, op_type, off) GET_OPERAND_##op_type(type, off)
 
@@ -485,6 +565,14 @@ wasm_interp_get_frame_ref(WASMInterpFrame *frame)
 
 #define POP_F64() (GET_F64_FROM_ADDR(frame_lp + GET_OFFSET()))
 
+#define POP_V128() GET_V128_FROM_ADDR(frame_lp + GET_OFFSET())
+
+#define PUSH_V128(value)                            \
+    do {                                            \
+        uint32 *addr_tmp = frame_lp + GET_OFFSET(); \
+        PUT_V128_TO_ADDR(addr_tmp, value);          \
+    } while (0)
+
 #define POP_REF()                                                    \
     (opnd_off = GET_OFFSET(), CLEAR_FRAME_REF((unsigned)(opnd_off)), \
      GET_REF_FROM_ADDR(frame_lp + opnd_off))
@@ -497,6 +585,16 @@ wasm_interp_get_frame_ref(WASMInterpFrame *frame)
 #define UPDATE_FRAME_REF() (void)0
 #endif
 
+/* The fuel is charged to a local copy, which is written back to exec_env
+   before the code out of the interpreter loop reads or changes it */
+#if WASM_ENABLE_FUEL_METERING != 0
+#define SYNC_FUEL() exec_env->fuel = fuel
+#define UPDATE_FUEL() fuel = exec_env->fuel
+#else
+#define SYNC_FUEL() (void)0
+#define UPDATE_FUEL() (void)0
+#endif
+
 #define SYNC_ALL_TO_FRAME()   \
     do {                      \
         frame->ip = frame_ip; \
@@ -554,6 +652,24 @@ wasm_interp_get_frame_ref(WASMInterpFrame *frame)
         frame_ip += 6;                                               \
     } while (0)
 
+/* i32 comparison fused with br_if or if, evaluate the condition and
+   continue with the branch, whose operands follow the two operands of
+   the comparison */
+#define DEF_OP_FUSED_EQZ(handle_op_branch)                \
+    do {                                                  \
+        cond = (uint32)(GET_OPERAND(int32, I32, 0) == 0); \
+        frame_ip += 2;                                    \
+        goto handle_op_branch;                            \
+    } while (0)
+
+#define DEF_OP_FUSED_CMP(src_type, cond_op, handle_op_branch)       \
+    do {                                                            \
+        cond = (uint32)(GET_OPERAND(src_type, I32, 2)               \
+                            cond_op GET_OPERAND(src_type, I32, 0)); \
+        frame_ip += 4;                                              \
+        goto handle_op_branch;                                      \
+    } while (0)
+
 #define DEF_OP_BIT_COUNT(src_type, src_op_type, operation)               \
     do {                                                                 \
         SET_OPERAND(                                                     \
@@ -829,6 +945,370 @@ trunc_f64_to_int(WASMModuleInstance *module, uint8 *frame_ip, uint32 *frame_lp,
         PUSH_##dst_op_type(value);                                   \
     } while (0)
 
+#if WASM_ENABLE_SIMD != 0
+#if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
+#define GET_SIMD_LANE() lane = *frame_ip++;
+#else
+#define GET_SIMD_LANE() \
+    lane = *frame_ip;   \
+    frame_ip += 2;
+#endif
+
+#define SIMD_SAT(v, min, max) ((v) < (min) ? (min) : (v) > (max) ? (max) : (v))
+
+/* Lane-wise v128 operations, a and b are the lanes of the first and
+   the second operands converted to ctype */
+#define DEF_OP_SIMD_UNARY(ctype, field, lanes, expr) \
+    do {                                             \
+        V128 v1 = POP_V128(), res;                   \
+        uint32 i;                                    \
+        for (i = 0; i < lanes; i++) {                \
+            ctype a = (ctype)v1.field[i];            \
+            res.field[i] = (expr);                   \
+        }                                            \
+        PUSH_V128(res);                              \
+    } while (0)
+
+#define DEF_OP_SIMD_BINARY(ctype, field, lanes, expr) \
+    do {                                              \
+        V128 v2 = POP_V128(), v1 = POP_V128(), res;   \
+        uint32 i;                                     \
+        for (i = 0; i < lanes; i++) {                 \
+            ctype a = (ctype)v1.field[i];             \
+            ctype b = (ctype)v2.field[i];             \
+            res.field[i] = (expr);                    \
+        }                                             \
+        PUSH_V128(res);                               \
+    } while (0)
+
+/* The result lane is all ones if cond is true, otherwise all zeros */
+#define DEF_OP_SIMD_COMPARE(ctype, field, res_field, lanes, cond) \
+    do {                                                          \
+        V128 v2 = POP_V128(), v1 = POP_V128(), res;               \
+        uint32 i;                                                 \
+        for (i = 0; i < lanes; i++) {                             \
+            ctype a = (ctype)v1.field[i];                         \
+            ctype b = (ctype)v2.field[i];                         \
+            res.res_field[i] = (cond) ? -1 : 0;                   \
+        }                                                         \
+        PUSH_V128(res);                                           \
+    } while (0)
+
+/* c is the shift count modulo the lane width */
+#define DEF_OP_SIMD_SHIFT(ctype, field, lanes, expr)                     \
+    do {                                                                 \
+        uint32 c = (uint32)POP_I32() & (uint32)(sizeof(ctype) * 8 - 1); \
+        V128 v1 = POP_V128(), res;                                       \
+        uint32 i;                                                        \
+        for (i = 0; i < lanes; i++) {                                    \
+            ctype a = (ctype)v1.field[i];                                \
+            res.field[i] = (expr);                                       \
+        }                                                                \
+        PUSH_V128(res);                                                  \
+    } while (0)
+
+/* Operations whose result lanes are wider than the source lanes, a is
+   the i-th lane of the low or high half of the operand, and for the
+   pairwise ones, a and b are the two lanes added together */
+#define DEF_OP_SIMD_EXTEND(ctype, field, res_field, lanes, high, expr) \
+    do {                                                               \
+        V128 v1 = POP_V128(), res;                                     \
+        uint32 i;                                                      \
+        for (i = 0; i < lanes; i++) {                                  \
+            ctype a = (ctype)v1.field[i + ((high) ? lanes : 0)];       \
+            res.res_field[i] = (expr);                                 \
+        }                                                              \
+        PUSH_V128(res);                                                \
+    } while (0)
+
+#define DEF_OP_SIMD_EXTMUL(ctype, field, res_field, lanes, high, expr) \
+    do {                                                               \
+        V128 v2 = POP_V128(), v1 = POP_V128(), res;                    \
+        uint32 i;                                                      \
+        for (i = 0; i < lanes; i++) {                                  \
+            ctype a = (ctype)v1.field[i + ((high) ? lanes : 0)];       \
+            ctype b = (ctype)v2.field[i + ((high) ? lanes : 0)];       \
+            res.res_field[i] = (expr);                                 \
+        }                                                              \
+        PUSH_V128(res);                                                \
+    } while (0)
+
+#define DEF_OP_SIMD_PAIRWISE(ctype, field, res_field, lanes, expr) \
+    do {                                                           \
+        V128 v1 = POP_V128(), res;                                 \
+        uint32 i;                                                  \
+        for (i = 0; i < lanes; i++) {                              \
+            ctype a = (ctype)v1.field[i * 2];                      \
+            ctype b = (ctype)v1.field[i * 2 + 1];                  \
+            res.res_field[i] = (expr);                             \
+        }                                                          \
+        PUSH_V128(res);                                            \
+    } while (0)
+
+/* The lanes of the first operand are narrowed into the low half of the
+   result, and the lanes of the second operand into the high half */
+#define DEF_OP_SIMD_NARROW(field, res_field, lanes, min, max)         \
+    do {                                                              \
+        V128 v2 = POP_V128(), v1 = POP_V128(), res;                   \
+        uint32 i;                                                     \
+        for (i = 0; i < lanes; i++) {                                 \
+            res.res_field[i] = SIMD_SAT(v1.field[i], min, max);       \
+            res.res_field[i + lanes] = SIMD_SAT(v2.field[i], min, max); \
+        }                                                             \
+        PUSH_V128(res);                                               \
+    } while (0)
+
+#define DEF_OP_SIMD_ALL_TRUE(field, lanes)   \
+    do {                                     \
+        V128 v1 = POP_V128();                \
+        int32 ret = 1;                       \
+        uint32 i;                            \
+        for (i = 0; i < lanes; i++) {        \
+            if (v1.field[i] == 0) {          \
+                ret = 0;                     \
+                break;                       \
+            }                                \
+        }                                    \
+        PUSH_I32(ret);                       \
+    } while (0)
+
+#define DEF_OP_SIMD_BITMASK(field, lanes)      \
+    do {                                       \
+        V128 v1 = POP_V128();                  \
+        uint32 ret = 0, i;                     \
+        for (i = 0; i < lanes; i++) {          \
+            if (v1.field[i] < 0)               \
+                ret |= (uint32)1 << i;         \
+        }                                      \
+        PUSH_I32(ret);                         \
+    } while (0)
+
+#define DEF_OP_SIMD_SPLAT(ctype, field, lanes, value) \
+    do {                                              \
+        ctype splat_value = (ctype)(value);           \
+        V128 res;                                     \
+        uint32 i;                                     \
+        for (i = 0; i < lanes; i++)                   \
+            res.field[i] = splat_value;               \
+        PUSH_V128(res);                               \
+    } while (0)
+
+#define DEF_OP_SIMD_LOAD_EXTEND(ctype, field, res_field, lanes)          \
+    do {                                                                 \
+        uint32 offset, addr;                                             \
+        V128 v1, res;                                                    \
+        uint32 i;                                                        \
+        offset = read_uint32(frame_ip);                                  \
+        addr = (uint32)POP_I32();                                        \
+        CHECK_MEMORY_OVERFLOW(8);                                        \
+        memcpy(&v1, maddr, 8);                                           \
+        for (i = 0; i < lanes; i++)                                      \
+            res.res_field[i] = (ctype)v1.field[i];                       \
+        PUSH_V128(res);                                                  \
+    } while (0)
+
+#define DEF_OP_SIMD_LOAD_SPLAT(ctype, field, lanes)                       \
+    do {                                                                  \
+        uint32 offset, addr;                                              \
+        ctype value;                                                      \
+        offset = read_uint32(frame_ip);                                   \
+        addr = (uint32)POP_I32();                                         \
+        CHECK_MEMORY_OVERFLOW(sizeof(ctype));                             \
+        memcpy(&value, maddr, sizeof(ctype));                             \
+        DEF_OP_SIMD_SPLAT(ctype, field, lanes, value);                    \
+    } while (0)
+
+/* Load a lane from memory into the v128 operand, or store a lane of it
+   into memory */
+#define DEF_OP_SIMD_LOAD_STORE_LANE(bytes, is_load)              \
+    do {                                                         \
+        uint32 offset, addr;                                     \
+        uint8 lane;                                              \
+        V128 v1;                                                 \
+        offset = read_uint32(frame_ip);                          \
+        GET_SIMD_LANE();                                         \
+        v1 = POP_V128();                                         \
+        addr = (uint32)POP_I32();                                \
+        CHECK_MEMORY_OVERFLOW(bytes);                            \
+        if (is_load) {                                           \
+            memcpy((uint8 *)&v1 + lane * (bytes), maddr, bytes); \
+            PUSH_V128(v1);                                       \
+        }                                                        \
+        else {                                                   \
+            memcpy(maddr, (uint8 *)&v1 + lane * (bytes), bytes); \
+        }                                                        \
+    } while (0)
+
+#if defined(WASM_INTERP_SIMD_SSE2) || defined(WASM_INTERP_SIMD_NEON)
+#define WASM_INTERP_SIMD_INTRINSICS 1
+#endif
+
+#if defined(WASM_INTERP_SIMD_SSE2)
+/* Binary operation done with an SSE2 intrinsic, type is the suffix of
+   the load/store intrinsics: si128, ps or pd */
+#define DEF_OP_SIMD_SSE2(type, intrinsic)                                \
+    do {                                                                 \
+        int16 off2 = GET_OFFSET();                                       \
+        int16 off1 = GET_OFFSET();                                       \
+        _mm_storeu_##type((void *)(frame_lp + GET_OFFSET()),             \
+                          intrinsic(_mm_loadu_##type((void *)(frame_lp   \
+                                                              + off1)),  \
+                                    _mm_loadu_##type((void *)(frame_lp   \
+                                                              + off2)))); \
+    } while (0)
+
+#define DEF_OP_SIMD_SSE2_UNARY(type, intrinsic)                           \
+    do {                                                                  \
+        int16 off1 = GET_OFFSET();                                        \
+        _mm_storeu_##type(                                                \
+            (void *)(frame_lp + GET_OFFSET()),                            \
+            intrinsic(_mm_loadu_##type((void *)(frame_lp + off1))));      \
+    } while (0)
+
+#define DEF_OP_SIMD_SSE2_SHIFT(intrinsic, mask)                            \
+    do {                                                                   \
+        int32 c = (int32)(frame_lp[GET_OFFSET()] & (mask));                \
+        int16 off1 = GET_OFFSET();                                         \
+        _mm_storeu_si128(                                                  \
+            (void *)(frame_lp + GET_OFFSET()),                             \
+            intrinsic(_mm_loadu_si128((void *)(frame_lp + off1)),          \
+                      _mm_cvtsi32_si128(c)));                              \
+    } while (0)
+
+#define DEF_OP_SIMD_INTRINSIC(sse2_type, sse2_op, neon_type, neon_res_type, \
+                              neon_op)                                      \
+    DEF_OP_SIMD_SSE2(sse2_type, sse2_op)
+#define DEF_OP_SIMD_INTRINSIC_UNARY(sse2_type, sse2_op, neon_type, neon_op) \
+    DEF_OP_SIMD_SSE2_UNARY(sse2_type, sse2_op)
+
+static inline __m128i
+sse2_v128_andnot(__m128i a, __m128i b)
+{
+    return _mm_andnot_si128(b, a);
+}
+
+static inline __m128
+sse2_f32x4_pmin(__m128 a, __m128 b)
+{
+    return _mm_min_ps(b, a);
+}
+
+static inline __m128
+sse2_f32x4_pmax(__m128 a, __m128 b)
+{
+    return _mm_max_ps(b, a);
+}
+
+static inline __m128d
+sse2_f64x2_pmin(__m128d a, __m128d b)
+{
+    return _mm_min_pd(b, a);
+}
+
+static inline __m128d
+sse2_f64x2_pmax(__m128d a, __m128d b)
+{
+    return _mm_max_pd(b, a);
+}
+#elif defined(WASM_INTERP_SIMD_NEON)
+/* Binary operation done with a NEON intrinsic, type is the suffix of
+   the vld1q/vst1q intrinsics of the operands and res_type is the one
+   of the result, e.g. u32 for the f32x4 comparisons */
+#define DEF_OP_SIMD_NEON(type, res_type, intrinsic)                   \
+    do {                                                              \
+        int16 off2 = GET_OFFSET();                                    \
+        int16 off1 = GET_OFFSET();                                    \
+        vst1q_##res_type(                                             \
+            (void *)(frame_lp + GET_OFFSET()),                        \
+            intrinsic(vld1q_##type((void *)(frame_lp + off1)),        \
+                      vld1q_##type((void *)(frame_lp + off2))));      \
+    } while (0)
+
+#define DEF_OP_SIMD_NEON_UNARY(type, intrinsic)                              \
+    do {                                                                     \
+        int16 off1 = GET_OFFSET();                                           \
+        vst1q_##type((void *)(frame_lp + GET_OFFSET()),                      \
+                     intrinsic(vld1q_##type((void *)(frame_lp + off1))));    \
+    } while (0)
+
+#define DEF_OP_SIMD_INTRINSIC(sse2_type, sse2_op, neon_type, neon_res_type, \
+                              neon_op)                                      \
+    DEF_OP_SIMD_NEON(neon_type, neon_res_type, neon_op)
+#define DEF_OP_SIMD_INTRINSIC_UNARY(sse2_type, sse2_op, neon_type, neon_op) \
+    DEF_OP_SIMD_NEON_UNARY(neon_type, neon_op)
+#endif
+
+/* Use the intrinsic if available, otherwise do it lane by lane */
+#if WASM_INTERP_SIMD_INTRINSICS != 0
+#define DEF_OP_SIMD_BINARY_OPT(sse2_type, sse2_op, neon_type, neon_op, ctype, \
+                               field, lanes, expr)                           \
+    DEF_OP_SIMD_INTRINSIC(sse2_type, sse2_op, neon_type, neon_type, neon_op)
+#define DEF_OP_SIMD_COMPARE_OPT(sse2_type, sse2_op, neon_type, neon_res_type, \
+                                neon_op, ctype, field, res_field, lanes,     \
+                                cond)                                        \
+    DEF_OP_SIMD_INTRINSIC(sse2_type, sse2_op, neon_type, neon_res_type,      \
+                          neon_op)
+#define DEF_OP_SIMD_UNARY_OPT(sse2_type, sse2_op, neon_type, neon_op, ctype, \
+                              field, lanes, expr)                           \
+    DEF_OP_SIMD_INTRINSIC_UNARY(sse2_type, sse2_op, neon_type, neon_op)
+#else
+#define DEF_OP_SIMD_BINARY_OPT(sse2_type, sse2_op, neon_type, neon_op, ctype, \
+                               field, lanes, expr)                           \
+    DEF_OP_SIMD_BINARY(ctype, field, lanes, expr)
+#define DEF_OP_SIMD_COMPARE_OPT(sse2_type, sse2_op, neon_type, neon_res_type, \
+                                neon_op, ctype, field, res_field, lanes,     \
+                                cond)                                        \
+    DEF_OP_SIMD_COMPARE(ctype, field, res_field, lanes, cond)
+#define DEF_OP_SIMD_UNARY_OPT(sse2_type, sse2_op, neon_type, neon_op, ctype, \
+                              field, lanes, expr)                           \
+    DEF_OP_SIMD_UNARY(ctype, field, lanes, expr)
+#endif
+
+static inline int32
+simd_f32_to_i32_sat(float32 a)
+{
+    if (isnan(a))
+        return 0;
+    if (a < -2147483648.0f)
+        return INT32_MIN;
+    if (a >= 2147483648.0f)
+        return INT32_MAX;
+    return (int32)a;
+}
+
+static inline uint32
+simd_f32_to_u32_sat(float32 a)
+{
+    if (isnan(a) || a <= -1.0f)
+        return 0;
+    if (a >= 4294967296.0f)
+        return UINT32_MAX;
+    return (uint32)a;
+}
+
+static inline int32
+simd_f64_to_i32_sat(float64 a)
+{
+    if (isnan(a))
+        return 0;
+    if (a <= -2147483649.0)
+        return INT32_MIN;
+    if (a >= 2147483648.0)
+        return INT32_MAX;
+    return (int32)a;
+}
+
+static inline uint32
+simd_f64_to_u32_sat(float64 a)
+{
+    if (isnan(a) || a <= -1.0)
+        return 0;
+    if (a >= 4294967296.0)
+        return UINT32_MAX;
+    return (uint32)a;
+}
+#endif /* end of WASM_ENABLE_SIMD != 0 */
+
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
 #define CELL_SIZE sizeof(uint8)
 #else
@@ -890,7 +1370,7 @@ copy_stack_values(WASMModuleInstance *module, uint32 *frame_lp, uint32 arity,
             frame_ref[src] = 0;
 #endif
         }
-        else {
+        else if (cell == 2) {
             tmp_buf[buf_index] = frame_lp[src];
             tmp_buf[buf_index + 1] = frame_lp[src + 1];
 #if WASM_ENABLE_GC != 0
@@ -900,6 +1380,17 @@ copy_stack_values(WASMModuleInstance *module, uint32 *frame_lp, uint32 arity,
             frame_ref[src + 1] = 0;
 #endif
         }
+#if WASM_ENABLE_SIMD != 0
+        else {
+            /* v128 value, which is never a reference */
+            bh_assert(cell == 4);
+            PUT_V128_TO_ADDR(tmp_buf + buf_index,
+                             GET_V128_FROM_ADDR(frame_lp + src));
+#if WASM_ENABLE_GC != 0
+            memset(tmp_ref_buf + buf_index, 0, 4);
+#endif
+        }
+#endif
         buf_index += cell;
     }
 
@@ -914,7 +1405,7 @@ copy_stack_values(WASMModuleInstance *module, uint32 *frame_lp, uint32 arity,
             frame_ref[dst] = tmp_ref_buf[buf_index];
 #endif
         }
-        else {
+        else if (cell == 2) {
             frame_lp[dst] = tmp_buf[buf_index];
             frame_lp[dst + 1] = tmp_buf[buf_index + 1];
 #if WASM_ENABLE_GC != 0
@@ -922,6 +1413,15 @@ copy_stack_values(WASMModuleInstance *module, uint32 *frame_lp, uint32 arity,
             frame_ref[dst + 1] = tmp_ref_buf[buf_index + 1];
 #endif
         }
+#if WASM_ENABLE_SIMD != 0
+        else {
+            PUT_V128_TO_ADDR(frame_lp + dst,
+                             GET_V128_FROM_ADDR(tmp_buf + buf_index));
+#if WASM_ENABLE_GC != 0
+            memset(frame_ref + dst, 0, 4);
+#endif
+        }
+#endif
         buf_index += cell;
     }
 
@@ -984,6 +1484,11 @@ fail:
                         SET_FRAME_REF((unsigned)(dst_offsets[0] + 1));     \
                     }                                                      \
                 }                                                          \
+                else if (cells[0] == 4) {                                  \
+                    PUT_V128_TO_ADDR(                                      \
+                        frame_lp + dst_offsets[0],                         \
+                        GET_V128_FROM_ADDR(frame_lp + src_offsets[0]));    \
+                }                                                          \
             }                                                              \
             else {                                                         \
                 if (!copy_stack_values(module, frame_lp, arity, frame_ref, \
@@ -1024,6 +1529,11 @@ fail:
                         frame_lp + dst_offsets[0],                          \
                         GET_I64_FROM_ADDR(frame_lp + src_offsets[0]));      \
                 }                                                           \
+                else if (cells[0] == 4) {                                   \
+                    PUT_V128_TO_ADDR(                                       \
+                        frame_lp + dst_offsets[0],                          \
+                        GET_V128_FROM_ADDR(frame_lp + src_offsets[0]));     \
+                }                                                           \
             }                                                               \
             else {                                                          \
                 if (!copy_stack_values(module, frame_lp, arity, total_cell, \
@@ -1154,7 +1664,8 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
         cur_func->param_cell_num > 2 ? cur_func->param_cell_num : 2;
     unsigned all_cell_num;
     WASMInterpFrame *frame;
-    uint32 argv_ret[2], cur_func_index;
+    /* 4 cells for the v128 result */
+    uint32 argv_ret[4], cur_func_index;
     void *native_func_pointer = NULL;
     bool ret;
 #if WASM_ENABLE_GC != 0
@@ -1215,6 +1726,11 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
             argv_ret[1] = frame->lp[1];
         }
     }
+    else if (func_import->call_desc) {
+        ret = wasm_runtime_invoke_native_desc(
+            exec_env, native_func_pointer, func_import->call_desc,
+            func_import->attachment, frame->lp, argv_ret);
+    }
     else if (!func_import->call_conv_raw) {
         ret = wasm_runtime_invoke_native(
             exec_env, native_func_pointer, func_import->func_type,
@@ -1252,6 +1768,12 @@ wasm_interp_call_func_native(WASMModuleInstance *module_inst,
         prev_frame->lp[prev_frame->ret_offset] = argv_ret[0];
         prev_frame->lp[prev_frame->ret_offset + 1] = argv_ret[1];
     }
+#if WASM_ENABLE_SIMD != 0
+    else if (cur_func->ret_cell_num == 4) {
+        PUT_V128_TO_ADDR(prev_frame->lp + prev_frame->ret_offset,
+                         GET_V128_FROM_ADDR(argv_ret));
+    }
+#endif
 
     FREE_FRAME(exec_env, frame);
     wasm_exec_env_set_cur_frame(exec_env, prev_frame);
@@ -1361,96 +1883,1701 @@ DEFINE_GOTO_TABLE(OpcodeInfo, opcode_table);
 #undef HANDLE_OPCODE
 /* clang-format on */
 
+/* Count of the adjacent opcode pairs executed, which is used to choose
+   the opcode sequences fused into superinstructions by the loader */
+static uint64 opcode_pair_count[WASM_INSTRUCTION_NUM][WASM_INSTRUCTION_NUM];
+static uint8 last_opcode_counted;
+
+#define OPCODE_PAIR_DUMP_NUM 32
+
+static inline void
+wasm_interp_count_op(uint8 opcode)
+{
+    opcode_table[opcode].count++;
+    opcode_pair_count[last_opcode_counted][opcode]++;
+    last_opcode_counted = opcode;
+}
+
+static void
+wasm_interp_dump_op_pair_count(uint64 total_count)
+{
+    uint64 count, max_count, prev_max_count = UINT64_MAX;
+    uint32 i, j, k, max_i = 0, max_j = 0, prev_i = 0, prev_j = 0;
+
+    os_printf("top opcode pairs:\n");
+    /* select the pairs in descending order of count, the pairs with
+       the same count are ordered by their opcodes */
+    for (k = 0; k < OPCODE_PAIR_DUMP_NUM; k++) {
+        max_count = 0;
+        for (i = 0; i < WASM_INSTRUCTION_NUM; i++) {
+            for (j = 0; j < WASM_INSTRUCTION_NUM; j++) {
+                count = opcode_pair_count[i][j];
+                if (count > max_count
+                    && (count < prev_max_count
+                        || (count == prev_max_count
+                            && i * WASM_INSTRUCTION_NUM + j
+                                   > prev_i * WASM_INSTRUCTION_NUM + prev_j))) {
+                    max_count = count;
+                    max_i = i;
+                    max_j = j;
+                }
+            }
+        }
+        if (max_count == 0)
+            break;
+        os_printf("\t\t%s, %s count:\t\t%ld,\t\t%.2f%%\n",
+                  opcode_table[max_i].name, opcode_table[max_j].name,
+                  max_count, max_count * 100.0f / total_count);
+        prev_max_count = max_count;
+        prev_i = max_i;
+        prev_j = max_j;
+    }
+}
+
 static void
 wasm_interp_dump_op_count()
 {
     uint32 i;
     uint64 total_count = 0;
-    for (i = 0; i < WASM_OP_IMPDEP; i++)
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++)
         total_count += opcode_table[i].count;
 
     os_printf("total opcode count: %ld\n", total_count);
-    for (i = 0; i < WASM_OP_IMPDEP; i++)
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++)
         if (opcode_table[i].count > 0)
             os_printf("\t\t%s count:\t\t%ld,\t\t%.2f%%\n", opcode_table[i].name,
                       opcode_table[i].count,
                       opcode_table[i].count * 100.0f / total_count);
+    wasm_interp_dump_op_pair_count(total_count);
 }
 #endif
 
-#if WASM_ENABLE_LABELS_AS_VALUES != 0
+/* Check whether the compiler guarantees the tail calls between the
+   handlers of the tail-call dispatch, it may also be predefined by the
+   build flags, e.g. to empty to rely on the sibling call optimization
+   of the compiler */
+#ifndef WASM_INTERP_MUSTTAIL
+#if defined(__has_attribute)
+#if __has_attribute(musttail)
+#define WASM_INTERP_MUSTTAIL __attribute__((musttail))
+#endif
+#endif
+#endif
 
-/* #define HANDLE_OP(opcode) HANDLE_##opcode:printf(#opcode"\n"); */
-#if WASM_ENABLE_OPCODE_COUNTER != 0
-#define HANDLE_OP(opcode) HANDLE_##opcode : opcode_table[opcode].count++;
+#if WASM_ENABLE_FAST_INTERP_TAIL_DISPATCH != 0                             \
+    && WASM_ENABLE_LABELS_AS_VALUES != 0                                   \
+    && WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0 && WASM_ENABLE_GC == 0 \
+    && WASM_ENABLE_OPCODE_COUNTER == 0 && defined(WASM_INTERP_MUSTTAIL)
+#define WASM_INTERP_TAIL_DISPATCH 1
 #else
-#define HANDLE_OP(opcode) HANDLE_##opcode:
+/* Fall back to the labels-as-values dispatch of the main loop */
+#define WASM_INTERP_TAIL_DISPATCH 0
 #endif
-#if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
-#define FETCH_OPCODE_AND_DISPATCH()                    \
-    do {                                               \
-        const void *p_label_addr = *(void **)frame_ip; \
-        frame_ip += sizeof(void *);                    \
-        goto *p_label_addr;                            \
+
+#if WASM_INTERP_TAIL_DISPATCH != 0
+/**
+ * The tail-call dispatch of the fast interpreter: the hot opcodes are
+ * executed by separate handler functions which share the prepared
+ * bytecode with the main loop, each handler jumps to the handler of the
+ * next opcode with a guaranteed tail call, so that the operands of the
+ * handlers stay in the argument registers. The handle table exported to
+ * the loader contains the handler functions, the other opcodes are
+ * handled by exit stubs which return to the main loop with the opcode
+ * in the context.
+ *
+ * A handler never raises an exception or changes the state of the
+ * frame other than the operand cells: if an opcode may trap or needs the
+ * main loop (integer divide by zero, out of bounds memory access, branch
+ * with more than one result, suspend flags set, etc.), the handler
+ * returns to the main loop without consuming the opcode, which is then
+ * executed again by the labels-as-values handler.
+ */
+typedef struct WASMInterpTailContext {
+    WASMExecEnv *exec_env;
+    /* the opcode to execute in the main loop, set by the handler which
+       returns to the main loop */
+    uint32 opcode;
+} WASMInterpTailContext;
+
+typedef uint8 *(*WASMInterpTailHandler)(uint8 *frame_ip, uint32 *frame_lp,
+                                        uint8 *memory_data,
+                                        uint64 memory_size,
+                                        WASMInterpTailContext *tail_ctx);
+
+#define TAIL_HANDLER(opcode)                                              \
+    static uint8 *tail_handle_##opcode(uint8 *frame_ip, uint32 *frame_lp, \
+                                       uint8 *memory_data,                \
+                                       uint64 memory_size,                \
+                                       WASMInterpTailContext *tail_ctx)
+
+#define TAIL_DISPATCH()                                                    \
+    do {                                                                   \
+        WASMInterpTailHandler next_handler =                               \
+            *(WASMInterpTailHandler *)frame_ip;                            \
+        WASM_INTERP_MUSTTAIL return next_handler(                          \
+            frame_ip + sizeof(void *), frame_lp, memory_data, memory_size, \
+            tail_ctx);                                                     \
+    } while (0)
+
+/* Return to the main loop to execute the opcode whose operands start
+   at frame_ip_org */
+#define TAIL_EXIT(op, frame_ip_org) \
+    do {                            \
+        tail_ctx->opcode = op;      \
+        return frame_ip_org;        \
+    } while (0)
+
+/* memory_size is UINT64_MAX if the bounds checks are disabled */
+#define TAIL_CHECK_MEMORY_OVERFLOW(op, bytes, frame_ip_org) \
+    do {                                                    \
+        uint64 offset1 = (uint64)offset + (uint64)addr;     \
+        if (offset1 + bytes > memory_size)                  \
+            TAIL_EXIT(op, frame_ip_org);                    \
+        maddr = memory_data + offset1;                      \
+    } while (0)
+
+#if WASM_ENABLE_THREAD_MGR != 0
+#define TAIL_CHECK_SUSPEND_FLAGS(op, frame_ip_org)                     \
+    do {                                                               \
+        if (WASM_SUSPEND_FLAGS_GET(tail_ctx->exec_env->suspend_flags)) \
+            TAIL_EXIT(op, frame_ip_org);                               \
     } while (0)
 #else
-#if UINTPTR_MAX == UINT64_MAX
-#define FETCH_OPCODE_AND_DISPATCH()                                       \
+#define TAIL_CHECK_SUSPEND_FLAGS(op, frame_ip_org) (void)0
+#endif
+
+/* Same as RECOVER_BR_INFO, but copy at most one result */
+#define TAIL_RECOVER_BR_INFO(op, frame_ip_org)                             \
+    do {                                                                   \
+        uint32 arity = read_uint32(frame_ip);                              \
+        if (arity) {                                                       \
+            uint8 cell;                                                    \
+            int16 src_offset;                                              \
+            uint16 dst_offset;                                             \
+            if (arity != 1)                                                \
+                TAIL_EXIT(op, frame_ip_org);                               \
+            /* skip total cell num */                                      \
+            frame_ip += sizeof(uint32);                                    \
+            cell = *frame_ip;                                              \
+            src_offset = *(int16 *)(frame_ip + CELL_SIZE);                 \
+            dst_offset = *(uint16 *)(frame_ip + CELL_SIZE + 2);            \
+            frame_ip += CELL_SIZE + sizeof(int16) + sizeof(uint16);        \
+            if (cell == 1)                                                 \
+                frame_lp[dst_offset] = frame_lp[src_offset];               \
+            else if (cell == 2)                                            \
+                PUT_I64_TO_ADDR(frame_lp + dst_offset,                     \
+                                GET_I64_FROM_ADDR(frame_lp + src_offset)); \
+            else                                                           \
+                TAIL_EXIT(op, frame_ip_org);                               \
+        }                                                                  \
+        frame_ip = (uint8 *)LOAD_PTR(frame_ip);                            \
+    } while (0)
+
+#define DEF_TAIL_OP_BR_IF(op, operand_size, cond_expr) \
+    do {                                               \
+        uint8 *frame_ip_org = frame_ip;                \
+        uint32 cond = (uint32)(cond_expr);             \
+        frame_ip += operand_size;                      \
+        TAIL_CHECK_SUSPEND_FLAGS(op, frame_ip_org);    \
+        if (cond)                                      \
+            TAIL_RECOVER_BR_INFO(op, frame_ip_org);    \
+        else                                           \
+            SKIP_BR_INFO();                            \
+    } while (0)
+
+#define DEF_TAIL_OP_IF(operand_size, cond_expr)                           \
     do {                                                                  \
-        const void *p_label_addr;                                         \
-        bh_assert(((uintptr_t)frame_ip & 1) == 0);                        \
-        /* int32 relative offset was emitted in 64-bit target */          \
-        p_label_addr = label_base + (int32)LOAD_U32_WITH_2U16S(frame_ip); \
-        frame_ip += sizeof(int32);                                        \
-        goto *p_label_addr;                                               \
+        uint32 cond = (uint32)(cond_expr);                                \
+        frame_ip += operand_size;                                         \
+        if (cond == 0) {                                                  \
+            uint8 *else_addr = (uint8 *)LOAD_PTR(frame_ip);               \
+            if (else_addr == NULL)                                        \
+                frame_ip = (uint8 *)LOAD_PTR(frame_ip + sizeof(uint8 *)); \
+            else                                                          \
+                frame_ip = else_addr;                                     \
+        }                                                                 \
+        else {                                                            \
+            frame_ip += sizeof(uint8 *) * 2;                              \
+        }                                                                 \
     } while (0)
-#else
-#define FETCH_OPCODE_AND_DISPATCH()                                      \
+
+#define DEF_TAIL_OP_LOAD(op, bytes, ...)                     \
+    do {                                                     \
+        uint8 *frame_ip_org = frame_ip, *maddr;              \
+        uint32 offset, addr;                                 \
+        int16 addr_ret;                                      \
+        offset = read_uint32(frame_ip);                      \
+        addr = GET_OPERAND(uint32, I32, 0);                  \
+        frame_ip += 2;                                       \
+        addr_ret = GET_OFFSET();                             \
+        TAIL_CHECK_MEMORY_OVERFLOW(op, bytes, frame_ip_org); \
+        __VA_ARGS__;                                         \
+    } while (0)
+
+#define DEF_TAIL_OP_STORE(op, bytes, src_type, src_op_type, ...) \
+    do {                                                         \
+        uint8 *frame_ip_org = frame_ip, *maddr;                  \
+        uint32 offset, addr;                                     \
+        src_type sval;                                           \
+        offset = read_uint32(frame_ip);                          \
+        sval = GET_OPERAND(src_type, src_op_type, 0);            \
+        addr = GET_OPERAND(uint32, I32, 2);                      \
+        frame_ip += 4;                                           \
+        TAIL_CHECK_MEMORY_OVERFLOW(op, bytes, frame_ip_org);     \
+        __VA_ARGS__;                                             \
+    } while (0)
+
+/* Let the main loop raise the exceptions, the overflow of the signed
+   remainder is also left to it */
+#define DEF_TAIL_OP_DIV(op, src_type, src_op_type, operation, min_value) \
     do {                                                                 \
-        const void *p_label_addr;                                        \
-        bh_assert(((uintptr_t)frame_ip & 1) == 0);                       \
-        /* uint32 label address was emitted in 32-bit target */          \
-        p_label_addr = (void *)(uintptr_t)LOAD_U32_WITH_2U16S(frame_ip); \
-        frame_ip += sizeof(int32);                                       \
-        goto *p_label_addr;                                              \
+        src_type a = GET_OPERAND(src_type, src_op_type, 2);              \
+        src_type b = GET_OPERAND(src_type, src_op_type, 0);              \
+        if (b == 0 || (a == (src_type)(min_value) && b == (src_type)-1)) \
+            TAIL_EXIT(op, frame_ip);                                     \
+        SET_OPERAND(src_op_type, 4, a operation b);                      \
+        frame_ip += 6;                                                   \
     } while (0)
-#endif
-#endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
-#define HANDLE_OP_END() FETCH_OPCODE_AND_DISPATCH()
 
-#else /* else of WASM_ENABLE_LABELS_AS_VALUES */
+#define DEF_TAIL_OP_FUNC(src_type, src_op_type, func)             \
+    do {                                                          \
+        SET_OPERAND(src_op_type, 4,                               \
+                    func(GET_OPERAND(src_type, src_op_type, 2),   \
+                         GET_OPERAND(src_type, src_op_type, 0))); \
+        frame_ip += 6;                                            \
+    } while (0)
 
-#define HANDLE_OP(opcode) case opcode:
-#define HANDLE_OP_END() continue
+TAIL_HANDLER(WASM_OP_IF)
+{
+    DEF_TAIL_OP_IF(2, GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
 
-#endif /* end of WASM_ENABLE_LABELS_AS_VALUES */
+TAIL_HANDLER(WASM_OP_ELSE)
+{
+    frame_ip = (uint8 *)LOAD_PTR(frame_ip);
+    TAIL_DISPATCH();
+}
 
-#if WASM_ENABLE_LABELS_AS_VALUES != 0
-static void **global_handle_table;
-#endif
+TAIL_HANDLER(WASM_OP_BR)
+{
+    uint8 *frame_ip_org = frame_ip;
 
-static inline uint8 *
-get_global_addr(uint8 *global_data, WASMGlobalInstance *global)
+    TAIL_CHECK_SUSPEND_FLAGS(WASM_OP_BR, frame_ip_org);
+    TAIL_RECOVER_BR_INFO(WASM_OP_BR, frame_ip_org);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_BR_IF)
 {
-#if WASM_ENABLE_MULTI_MODULE == 0
-    return global_data + global->data_offset;
-#else
-    return global->import_global_inst
-               ? global->import_module_inst->global_data
-                     + global->import_global_inst->data_offset
-               : global_data + global->data_offset;
-#endif
+    DEF_TAIL_OP_BR_IF(WASM_OP_BR_IF, 2, GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
 }
 
-static void
-wasm_interp_call_func_bytecode(WASMModuleInstance *module,
-                               WASMExecEnv *exec_env,
-                               WASMFunctionInstance *cur_func,
-                               WASMInterpFrame *prev_frame)
+TAIL_HANDLER(EXT_OP_BR_IF_I32_EQZ)
 {
-    WASMMemoryInstance *memory = wasm_get_default_memory(module);
-#if !defined(OS_ENABLE_HW_BOUND_CHECK)              \
-    || WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 \
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_EQZ, 2, GET_OPERAND(int32, I32, 0) == 0);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_EQ)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_EQ, 4,
+                      GET_OPERAND(uint32, I32, 2)
+                          == GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_NE)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_NE, 4,
+                      GET_OPERAND(uint32, I32, 2)
+                          != GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_LT_S)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_LT_S, 4,
+                      GET_OPERAND(int32, I32, 2)
+                          < GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_LT_U)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_LT_U, 4,
+                      GET_OPERAND(uint32, I32, 2)
+                          < GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_GT_S)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_GT_S, 4,
+                      GET_OPERAND(int32, I32, 2)
+                          > GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_GT_U)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_GT_U, 4,
+                      GET_OPERAND(uint32, I32, 2)
+                          > GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_LE_S)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_LE_S, 4,
+                      GET_OPERAND(int32, I32, 2)
+                          <= GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_LE_U)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_LE_U, 4,
+                      GET_OPERAND(uint32, I32, 2)
+                          <= GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_GE_S)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_GE_S, 4,
+                      GET_OPERAND(int32, I32, 2)
+                          >= GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_BR_IF_I32_GE_U)
+{
+    DEF_TAIL_OP_BR_IF(EXT_OP_BR_IF_I32_GE_U, 4,
+                      GET_OPERAND(uint32, I32, 2)
+                          >= GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_EQZ)
+{
+    DEF_TAIL_OP_IF(2, GET_OPERAND(int32, I32, 0) == 0);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_EQ)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(uint32, I32, 2)
+                       == GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_NE)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(uint32, I32, 2)
+                       != GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_LT_S)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(int32, I32, 2)
+                       < GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_LT_U)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(uint32, I32, 2)
+                       < GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_GT_S)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(int32, I32, 2)
+                       > GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_GT_U)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(uint32, I32, 2)
+                       > GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_LE_S)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(int32, I32, 2)
+                       <= GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_LE_U)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(uint32, I32, 2)
+                       <= GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_GE_S)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(int32, I32, 2)
+                       >= GET_OPERAND(int32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_IF_I32_GE_U)
+{
+    DEF_TAIL_OP_IF(4,
+                   GET_OPERAND(uint32, I32, 2)
+                       >= GET_OPERAND(uint32, I32, 0));
+    TAIL_DISPATCH();
+}
+
+#if WASM_ENABLE_FUEL_METERING != 0
+TAIL_HANDLER(EXT_OP_CHARGE_FUEL)
+{
+    uint8 *frame_ip_org = frame_ip;
+    uint32 cost = read_uint32(frame_ip);
+
+    /* Let the main loop throw the exception */
+    if (tail_ctx->exec_env->fuel < (int64)cost)
+        TAIL_EXIT(EXT_OP_CHARGE_FUEL, frame_ip_org);
+    tail_ctx->exec_env->fuel -= cost;
+    TAIL_DISPATCH();
+}
+#endif
+
+TAIL_HANDLER(WASM_OP_SELECT)
+{
+    uint32 cond = frame_lp[GET_OFFSET()];
+    int16 addr1 = GET_OFFSET();
+    int16 addr2 = GET_OFFSET();
+    int16 addr_ret = GET_OFFSET();
+
+    frame_lp[addr_ret] = frame_lp[cond ? addr2 : addr1];
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_SELECT_64)
+{
+    uint32 cond = frame_lp[GET_OFFSET()];
+    int16 addr1 = GET_OFFSET();
+    int16 addr2 = GET_OFFSET();
+    int16 addr_ret = GET_OFFSET();
+
+    PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                    GET_I64_FROM_ADDR(frame_lp + (cond ? addr2 : addr1)));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_SET_LOCAL_FAST)
+{
+    uint32 local_offset = *frame_ip++;
+
+    *(uint32 *)(frame_lp + local_offset) = GET_OPERAND(uint32, I32, 0);
+    frame_ip += 2;
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_SET_LOCAL_FAST_I64)
+{
+    uint32 local_offset = *frame_ip++;
+
+    PUT_I64_TO_ADDR((uint32 *)(frame_lp + local_offset),
+                    GET_OPERAND(uint64, I64, 0));
+    frame_ip += 2;
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_COPY_STACK_TOP)
+{
+    int16 addr1 = GET_OFFSET();
+    int16 addr2 = GET_OFFSET();
+
+    frame_lp[addr2] = frame_lp[addr1];
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(EXT_OP_COPY_STACK_TOP_I64)
+{
+    int16 addr1 = GET_OFFSET();
+    int16 addr2 = GET_OFFSET();
+
+    PUT_I64_TO_ADDR(frame_lp + addr2, GET_I64_FROM_ADDR(frame_lp + addr1));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LOAD)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I32_LOAD, 4, frame_lp[addr_ret] = LOAD_I32(maddr));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD, 8,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret, LOAD_I64(maddr)));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LOAD8_S)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I32_LOAD8_S, 1,
+                     frame_lp[addr_ret] = sign_ext_8_32(*(int8 *)maddr));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LOAD8_U)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I32_LOAD8_U, 1,
+                     frame_lp[addr_ret] = (uint32)(*(uint8 *)maddr));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LOAD16_S)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I32_LOAD16_S, 2,
+                     frame_lp[addr_ret] = sign_ext_16_32(LOAD_I16(maddr)));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LOAD16_U)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I32_LOAD16_U, 2,
+                     frame_lp[addr_ret] = (uint32)(LOAD_U16(maddr)));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD8_S)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD8_S, 1,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                                     sign_ext_8_64(*(int8 *)maddr)));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD8_U)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD8_U, 1,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                                     (uint64)(*(uint8 *)maddr)));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD16_S)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD16_S, 2,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                                     sign_ext_16_64(LOAD_I16(maddr))));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD16_U)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD16_U, 2,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                                     (uint64)(LOAD_U16(maddr))));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD32_S)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD32_S, 4,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                                     sign_ext_32_64(LOAD_I32(maddr))));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LOAD32_U)
+{
+    DEF_TAIL_OP_LOAD(WASM_OP_I64_LOAD32_U, 4,
+                     PUT_I64_TO_ADDR(frame_lp + addr_ret,
+                                     (uint64)(LOAD_U32(maddr))));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_STORE)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I32_STORE, 4, uint32, I32,
+                      STORE_U32(maddr, sval));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_STORE8)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I32_STORE8, 1, uint32, I32,
+                      STORE_U8(maddr, (uint8)sval));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_STORE16)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I32_STORE16, 2, uint32, I32,
+                      STORE_U16(maddr, (uint16)sval));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_STORE)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I64_STORE, 8, uint64, I64,
+                      STORE_I64(maddr, sval));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_STORE8)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I64_STORE8, 1, uint64, I64,
+                      *(uint8 *)maddr = (uint8)sval);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_STORE16)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I64_STORE16, 2, uint64, I64,
+                      STORE_U16(maddr, (uint16)sval));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_STORE32)
+{
+    DEF_TAIL_OP_STORE(WASM_OP_I64_STORE32, 4, uint64, I64,
+                      STORE_U32(maddr, (uint32)sval));
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_CONST)
+{
+    uint8 *orig_ip = frame_ip;
+    int16 addr_ret;
+
+    frame_ip += sizeof(uint32);
+    addr_ret = GET_OFFSET();
+
+    frame_lp[addr_ret] = *(uint32 *)orig_ip;
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_CONST)
+{
+    uint8 *orig_ip = frame_ip;
+    int16 addr_ret;
+
+    frame_ip += sizeof(uint64);
+    addr_ret = GET_OFFSET();
+
+    PUT_I64_TO_ADDR(frame_lp + addr_ret, *(uint64 *)orig_ip);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_EQZ)
+{
+    DEF_OP_EQZ(int32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_EQ)
+{
+    DEF_OP_CMP(uint32, I32, ==);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_NE)
+{
+    DEF_OP_CMP(uint32, I32, !=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LT_S)
+{
+    DEF_OP_CMP(int32, I32, <);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LT_U)
+{
+    DEF_OP_CMP(uint32, I32, <);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_GT_S)
+{
+    DEF_OP_CMP(int32, I32, >);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_GT_U)
+{
+    DEF_OP_CMP(uint32, I32, >);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LE_S)
+{
+    DEF_OP_CMP(int32, I32, <=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_LE_U)
+{
+    DEF_OP_CMP(uint32, I32, <=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_GE_S)
+{
+    DEF_OP_CMP(int32, I32, >=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_GE_U)
+{
+    DEF_OP_CMP(uint32, I32, >=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_EQZ)
+{
+    DEF_OP_EQZ(int64, I64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_EQ)
+{
+    DEF_OP_CMP(uint64, I64, ==);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_NE)
+{
+    DEF_OP_CMP(uint64, I64, !=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LT_S)
+{
+    DEF_OP_CMP(int64, I64, <);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LT_U)
+{
+    DEF_OP_CMP(uint64, I64, <);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_GT_S)
+{
+    DEF_OP_CMP(int64, I64, >);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_GT_U)
+{
+    DEF_OP_CMP(uint64, I64, >);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LE_S)
+{
+    DEF_OP_CMP(int64, I64, <=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_LE_U)
+{
+    DEF_OP_CMP(uint64, I64, <=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_GE_S)
+{
+    DEF_OP_CMP(int64, I64, >=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_GE_U)
+{
+    DEF_OP_CMP(uint64, I64, >=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_EQ)
+{
+    DEF_OP_CMP(float32, F32, ==);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_NE)
+{
+    DEF_OP_CMP(float32, F32, !=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_LT)
+{
+    DEF_OP_CMP(float32, F32, <);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_GT)
+{
+    DEF_OP_CMP(float32, F32, >);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_LE)
+{
+    DEF_OP_CMP(float32, F32, <=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_GE)
+{
+    DEF_OP_CMP(float32, F32, >=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_EQ)
+{
+    DEF_OP_CMP(float64, F64, ==);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_NE)
+{
+    DEF_OP_CMP(float64, F64, !=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_LT)
+{
+    DEF_OP_CMP(float64, F64, <);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_GT)
+{
+    DEF_OP_CMP(float64, F64, >);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_LE)
+{
+    DEF_OP_CMP(float64, F64, <=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_GE)
+{
+    DEF_OP_CMP(float64, F64, >=);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_CLZ)
+{
+    DEF_OP_BIT_COUNT(uint32, I32, clz32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_CTZ)
+{
+    DEF_OP_BIT_COUNT(uint32, I32, ctz32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_POPCNT)
+{
+    DEF_OP_BIT_COUNT(uint32, I32, popcount32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_ADD)
+{
+    DEF_OP_NUMERIC(uint32, uint32, I32, +);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_SUB)
+{
+    DEF_OP_NUMERIC(uint32, uint32, I32, -);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_MUL)
+{
+    DEF_OP_NUMERIC(uint32, uint32, I32, *);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_DIV_S)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I32_DIV_S, int32, I32, /, INT32_MIN);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_DIV_U)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I32_DIV_U, uint32, I32, /, 0);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_REM_S)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I32_REM_S, int32, I32, %, INT32_MIN);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_REM_U)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I32_REM_U, uint32, I32, %, 0);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_AND)
+{
+    DEF_OP_NUMERIC(uint32, uint32, I32, &);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_OR)
+{
+    DEF_OP_NUMERIC(uint32, uint32, I32, |);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_XOR)
+{
+    DEF_OP_NUMERIC(uint32, uint32, I32, ^);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_SHL)
+{
+    DEF_OP_NUMERIC2(uint32, uint32, I32, <<);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_SHR_S)
+{
+    DEF_OP_NUMERIC2(int32, uint32, I32, >>);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_SHR_U)
+{
+    DEF_OP_NUMERIC2(uint32, uint32, I32, >>);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_ROTL)
+{
+    DEF_TAIL_OP_FUNC(uint32, I32, rotl32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_ROTR)
+{
+    DEF_TAIL_OP_FUNC(uint32, I32, rotr32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_CLZ)
+{
+    DEF_OP_BIT_COUNT(uint64, I64, clz64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_CTZ)
+{
+    DEF_OP_BIT_COUNT(uint64, I64, ctz64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_POPCNT)
+{
+    DEF_OP_BIT_COUNT(uint64, I64, popcount64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_ADD)
+{
+    DEF_OP_NUMERIC_64(uint64, uint64, I64, +);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_SUB)
+{
+    DEF_OP_NUMERIC_64(uint64, uint64, I64, -);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_MUL)
+{
+    DEF_OP_NUMERIC_64(uint64, uint64, I64, *);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_DIV_S)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I64_DIV_S, int64, I64, /, INT64_MIN);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_DIV_U)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I64_DIV_U, uint64, I64, /, 0);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_REM_S)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I64_REM_S, int64, I64, %, INT64_MIN);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_REM_U)
+{
+    DEF_TAIL_OP_DIV(WASM_OP_I64_REM_U, uint64, I64, %, 0);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_AND)
+{
+    DEF_OP_NUMERIC_64(uint64, uint64, I64, &);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_OR)
+{
+    DEF_OP_NUMERIC_64(uint64, uint64, I64, |);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_XOR)
+{
+    DEF_OP_NUMERIC_64(uint64, uint64, I64, ^);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_SHL)
+{
+    DEF_OP_NUMERIC2_64(uint64, uint64, I64, <<);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_SHR_S)
+{
+    DEF_OP_NUMERIC2_64(int64, uint64, I64, >>);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_SHR_U)
+{
+    DEF_OP_NUMERIC2_64(uint64, uint64, I64, >>);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_ROTL)
+{
+    DEF_TAIL_OP_FUNC(uint64, I64, rotl64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_ROTR)
+{
+    DEF_TAIL_OP_FUNC(uint64, I64, rotr64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_ABS)
+{
+    DEF_OP_MATH(float32, F32, fabsf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_CEIL)
+{
+    DEF_OP_MATH(float32, F32, ceilf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_FLOOR)
+{
+    DEF_OP_MATH(float32, F32, floorf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_TRUNC)
+{
+    DEF_OP_MATH(float32, F32, truncf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_NEAREST)
+{
+    DEF_OP_MATH(float32, F32, rintf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_SQRT)
+{
+    DEF_OP_MATH(float32, F32, sqrtf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_ADD)
+{
+    DEF_OP_NUMERIC(float32, float32, F32, +);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_SUB)
+{
+    DEF_OP_NUMERIC(float32, float32, F32, -);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_MUL)
+{
+    DEF_OP_NUMERIC(float32, float32, F32, *);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_DIV)
+{
+    DEF_OP_NUMERIC(float32, float32, F32, /);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_MIN)
+{
+    DEF_TAIL_OP_FUNC(float32, F32, f32_min);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_MAX)
+{
+    DEF_TAIL_OP_FUNC(float32, F32, f32_max);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_COPYSIGN)
+{
+    DEF_TAIL_OP_FUNC(float32, F32, local_copysignf);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_ABS)
+{
+    DEF_OP_MATH(float64, F64, fabs);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_CEIL)
+{
+    DEF_OP_MATH(float64, F64, ceil);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_FLOOR)
+{
+    DEF_OP_MATH(float64, F64, floor);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_TRUNC)
+{
+    DEF_OP_MATH(float64, F64, trunc);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_NEAREST)
+{
+    DEF_OP_MATH(float64, F64, rint);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_SQRT)
+{
+    DEF_OP_MATH(float64, F64, sqrt);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_ADD)
+{
+    DEF_OP_NUMERIC_64(float64, float64, F64, +);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_SUB)
+{
+    DEF_OP_NUMERIC_64(float64, float64, F64, -);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_MUL)
+{
+    DEF_OP_NUMERIC_64(float64, float64, F64, *);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_DIV)
+{
+    DEF_OP_NUMERIC_64(float64, float64, F64, /);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_MIN)
+{
+    DEF_TAIL_OP_FUNC(float64, F64, f64_min);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_MAX)
+{
+    DEF_TAIL_OP_FUNC(float64, F64, f64_max);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_COPYSIGN)
+{
+    DEF_TAIL_OP_FUNC(float64, F64, local_copysign);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_WRAP_I64)
+{
+    int32 value = (int32)(POP_I64() & 0xFFFFFFFFLL);
+    PUSH_I32(value);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_EXTEND_S_I32)
+{
+    DEF_OP_CONVERT(int64, I64, int32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_EXTEND_U_I32)
+{
+    DEF_OP_CONVERT(int64, I64, uint32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_CONVERT_S_I32)
+{
+    DEF_OP_CONVERT(float32, F32, int32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_CONVERT_U_I32)
+{
+    DEF_OP_CONVERT(float32, F32, uint32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_CONVERT_S_I64)
+{
+    DEF_OP_CONVERT(float32, F32, int64, I64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_CONVERT_U_I64)
+{
+    DEF_OP_CONVERT(float32, F32, uint64, I64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F32_DEMOTE_F64)
+{
+    DEF_OP_CONVERT(float32, F32, float64, F64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_CONVERT_S_I32)
+{
+    DEF_OP_CONVERT(float64, F64, int32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_CONVERT_U_I32)
+{
+    DEF_OP_CONVERT(float64, F64, uint32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_CONVERT_S_I64)
+{
+    DEF_OP_CONVERT(float64, F64, int64, I64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_CONVERT_U_I64)
+{
+    DEF_OP_CONVERT(float64, F64, uint64, I64);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_F64_PROMOTE_F32)
+{
+    DEF_OP_CONVERT(float64, F64, float32, F32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I32_REINTERPRET_F32)
+{
+    DEF_OP_REINTERPRET(uint32, I32);
+    TAIL_DISPATCH();
+}
+
+TAIL_HANDLER(WASM_OP_I64_REINTERPRET_F64)
+{
+    DEF_OP_REINTERPRET(int64, I64);
+    TAIL_DISPATCH();
+}
+
+/* The exit stubs return to the main loop to execute the opcodes which
+   have no handler functions */
+#define DEF_TAIL_EXIT_STUB(n)       \
+    TAIL_HANDLER(exit_##n)          \
+    {                               \
+        (void)frame_lp;             \
+        (void)memory_data;          \
+        (void)memory_size;          \
+        TAIL_EXIT(0x##n, frame_ip); \
+    }
+
+#define DEF_TAIL_EXIT_STUBS(h)                        \
+    DEF_TAIL_EXIT_STUB(h##0) DEF_TAIL_EXIT_STUB(h##1) \
+    DEF_TAIL_EXIT_STUB(h##2) DEF_TAIL_EXIT_STUB(h##3) \
+    DEF_TAIL_EXIT_STUB(h##4) DEF_TAIL_EXIT_STUB(h##5) \
+    DEF_TAIL_EXIT_STUB(h##6) DEF_TAIL_EXIT_STUB(h##7) \
+    DEF_TAIL_EXIT_STUB(h##8) DEF_TAIL_EXIT_STUB(h##9) \
+    DEF_TAIL_EXIT_STUB(h##a) DEF_TAIL_EXIT_STUB(h##b) \
+    DEF_TAIL_EXIT_STUB(h##c) DEF_TAIL_EXIT_STUB(h##d) \
+    DEF_TAIL_EXIT_STUB(h##e) DEF_TAIL_EXIT_STUB(h##f)
+
+/* clang-format off */
+DEF_TAIL_EXIT_STUBS(0) DEF_TAIL_EXIT_STUBS(1) DEF_TAIL_EXIT_STUBS(2)
+DEF_TAIL_EXIT_STUBS(3) DEF_TAIL_EXIT_STUBS(4) DEF_TAIL_EXIT_STUBS(5)
+DEF_TAIL_EXIT_STUBS(6) DEF_TAIL_EXIT_STUBS(7) DEF_TAIL_EXIT_STUBS(8)
+DEF_TAIL_EXIT_STUBS(9) DEF_TAIL_EXIT_STUBS(a) DEF_TAIL_EXIT_STUBS(b)
+DEF_TAIL_EXIT_STUBS(c) DEF_TAIL_EXIT_STUBS(d) DEF_TAIL_EXIT_STUBS(e)
+DEF_TAIL_EXIT_STUBS(f)
+/* clang-format on */
+
+#define TAIL_EXIT_STUBS(h)                                \
+    tail_handle_exit_##h##0, tail_handle_exit_##h##1,     \
+        tail_handle_exit_##h##2, tail_handle_exit_##h##3, \
+        tail_handle_exit_##h##4, tail_handle_exit_##h##5, \
+        tail_handle_exit_##h##6, tail_handle_exit_##h##7, \
+        tail_handle_exit_##h##8, tail_handle_exit_##h##9, \
+        tail_handle_exit_##h##a, tail_handle_exit_##h##b, \
+        tail_handle_exit_##h##c, tail_handle_exit_##h##d, \
+        tail_handle_exit_##h##e, tail_handle_exit_##h##f
+
+static const WASMInterpTailHandler tail_exit_stubs[WASM_INSTRUCTION_NUM] = {
+    TAIL_EXIT_STUBS(0), TAIL_EXIT_STUBS(1), TAIL_EXIT_STUBS(2),
+    TAIL_EXIT_STUBS(3), TAIL_EXIT_STUBS(4), TAIL_EXIT_STUBS(5),
+    TAIL_EXIT_STUBS(6), TAIL_EXIT_STUBS(7), TAIL_EXIT_STUBS(8),
+    TAIL_EXIT_STUBS(9), TAIL_EXIT_STUBS(a), TAIL_EXIT_STUBS(b),
+    TAIL_EXIT_STUBS(c), TAIL_EXIT_STUBS(d), TAIL_EXIT_STUBS(e),
+    TAIL_EXIT_STUBS(f)
+};
+
+static void *tail_handle_table[WASM_INSTRUCTION_NUM];
+
+#define SET_TAIL_HANDLE_TABLE_ELEM(opcode)                   \
+    tail_handle_table[opcode] = (void *)tail_handle_##opcode
+
+static void
+init_tail_handle_table(void **handle_table)
+{
+    uint32 i;
+
+    for (i = 0; i < WASM_INSTRUCTION_NUM; i++) {
+        /* Leave the opcodes which have no labels unset */
+        if (handle_table[i])
+            tail_handle_table[i] = (void *)tail_exit_stubs[i];
+    }
+
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_IF);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_ELSE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_BR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_BR_IF);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_EQZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_EQ);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_NE);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_LT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_LT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_GT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_GT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_LE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_LE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_GE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_BR_IF_I32_GE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_EQZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_EQ);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_NE);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_LT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_LT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_GT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_GT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_LE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_LE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_GE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_IF_I32_GE_U);
+#if WASM_ENABLE_FUEL_METERING != 0
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_CHARGE_FUEL);
+#endif
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_SELECT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_SELECT_64);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_SET_LOCAL_FAST);
+    tail_handle_table[EXT_OP_TEE_LOCAL_FAST] =
+        tail_handle_table[EXT_OP_SET_LOCAL_FAST];
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_SET_LOCAL_FAST_I64);
+    tail_handle_table[EXT_OP_TEE_LOCAL_FAST_I64] =
+        tail_handle_table[EXT_OP_SET_LOCAL_FAST_I64];
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_COPY_STACK_TOP);
+    SET_TAIL_HANDLE_TABLE_ELEM(EXT_OP_COPY_STACK_TOP_I64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LOAD);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LOAD8_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LOAD8_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LOAD16_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LOAD16_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD8_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD8_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD16_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD16_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD32_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LOAD32_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_STORE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_STORE8);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_STORE16);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_STORE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_STORE8);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_STORE16);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_STORE32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_CONST);
+    tail_handle_table[WASM_OP_F32_CONST] = tail_handle_table[WASM_OP_I32_CONST];
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_CONST);
+    tail_handle_table[WASM_OP_F64_CONST] = tail_handle_table[WASM_OP_I64_CONST];
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_EQZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_EQ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_NE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_GT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_GT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_LE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_GE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_GE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_EQZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_EQ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_NE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_GT_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_GT_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_LE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_GE_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_GE_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_EQ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_NE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_LT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_GT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_LE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_GE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_EQ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_NE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_LT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_GT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_LE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_GE);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_CLZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_CTZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_POPCNT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_ADD);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_SUB);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_MUL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_DIV_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_DIV_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_REM_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_REM_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_AND);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_OR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_XOR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_SHL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_SHR_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_SHR_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_ROTL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_ROTR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_CLZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_CTZ);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_POPCNT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_ADD);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_SUB);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_MUL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_DIV_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_DIV_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_REM_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_REM_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_AND);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_OR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_XOR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_SHL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_SHR_S);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_SHR_U);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_ROTL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_ROTR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_ABS);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_CEIL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_FLOOR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_TRUNC);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_NEAREST);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_SQRT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_ADD);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_SUB);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_MUL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_DIV);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_MIN);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_MAX);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_COPYSIGN);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_ABS);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_CEIL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_FLOOR);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_TRUNC);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_NEAREST);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_SQRT);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_ADD);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_SUB);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_MUL);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_DIV);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_MIN);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_MAX);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_COPYSIGN);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_WRAP_I64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_EXTEND_S_I32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_EXTEND_U_I32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_CONVERT_S_I32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_CONVERT_U_I32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_CONVERT_S_I64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_CONVERT_U_I64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F32_DEMOTE_F64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_CONVERT_S_I32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_CONVERT_U_I32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_CONVERT_S_I64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_CONVERT_U_I64);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_F64_PROMOTE_F32);
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I32_REINTERPRET_F32);
+    tail_handle_table[WASM_OP_F32_REINTERPRET_I32] =
+        tail_handle_table[WASM_OP_I32_REINTERPRET_F32];
+    SET_TAIL_HANDLE_TABLE_ELEM(WASM_OP_I64_REINTERPRET_F64);
+    tail_handle_table[WASM_OP_F64_REINTERPRET_I64] =
+        tail_handle_table[WASM_OP_I64_REINTERPRET_F64];
+}
+#endif /* end of WASM_INTERP_TAIL_DISPATCH != 0 */
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+
+/* #define HANDLE_OP(opcode) HANDLE_##opcode:printf(#opcode"\n"); */
+#if WASM_ENABLE_OPCODE_COUNTER != 0
+#define HANDLE_OP(opcode) HANDLE_##opcode : wasm_interp_count_op(opcode);
+#else
+#define HANDLE_OP(opcode) HANDLE_##opcode:
+#endif
+#if WASM_INTERP_TAIL_DISPATCH != 0
+/* Call the handler functions until one of them returns to the main loop */
+#define FETCH_OPCODE_AND_DISPATCH() goto tail_dispatch
+#elif WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
+#define FETCH_OPCODE_AND_DISPATCH()                    \
+    do {                                               \
+        const void *p_label_addr = *(void **)frame_ip; \
+        frame_ip += sizeof(void *);                    \
+        goto *p_label_addr;                            \
+    } while (0)
+#else
+#if UINTPTR_MAX == UINT64_MAX
+#define FETCH_OPCODE_AND_DISPATCH()                                       \
+    do {                                                                  \
+        const void *p_label_addr;                                         \
+        bh_assert(((uintptr_t)frame_ip & 1) == 0);                        \
+        /* int32 relative offset was emitted in 64-bit target */          \
+        p_label_addr = label_base + (int32)LOAD_U32_WITH_2U16S(frame_ip); \
+        frame_ip += sizeof(int32);                                        \
+        goto *p_label_addr;                                               \
+    } while (0)
+#else
+#define FETCH_OPCODE_AND_DISPATCH()                                      \
+    do {                                                                 \
+        const void *p_label_addr;                                        \
+        bh_assert(((uintptr_t)frame_ip & 1) == 0);                       \
+        /* uint32 label address was emitted in 32-bit target */          \
+        p_label_addr = (void *)(uintptr_t)LOAD_U32_WITH_2U16S(frame_ip); \
+        frame_ip += sizeof(int32);                                       \
+        goto *p_label_addr;                                              \
+    } while (0)
+#endif
+#endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
+#define HANDLE_OP_END() FETCH_OPCODE_AND_DISPATCH()
+
+#else /* else of WASM_ENABLE_LABELS_AS_VALUES */
+
+#define HANDLE_OP(opcode) case opcode:
+#define HANDLE_OP_END() continue
+
+#endif /* end of WASM_ENABLE_LABELS_AS_VALUES */
+
+#if WASM_ENABLE_LABELS_AS_VALUES != 0
+static void **global_handle_table;
+#endif
+
+static inline uint8 *
+get_global_addr(uint8 *global_data, WASMGlobalInstance *global)
+{
+#if WASM_ENABLE_MULTI_MODULE == 0
+    return global_data + global->data_offset;
+#else
+    return global->import_global_inst
+               ? global->import_module_inst->global_data
+                     + global->import_global_inst->data_offset
+               : global_data + global->data_offset;
+#endif
+}
+
+static void
+wasm_interp_call_func_bytecode(WASMModuleInstance *module,
+                               WASMExecEnv *exec_env,
+                               WASMFunctionInstance *cur_func,
+                               WASMInterpFrame *prev_frame)
+{
+    WASMMemoryInstance *memory = wasm_get_default_memory(module);
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* The shared heap isn't attached or detached during the call, the
+       module instance has no extra info when getting the handle table */
+    uint64 shared_heap_start_off =
+        module->e ? module->e->common.shared_heap_start_off : UINT64_MAX;
+    uint8 *shared_heap_base_addr_adj =
+        module->e ? module->e->common.shared_heap_base_addr_adj : NULL;
+#endif
+#if !defined(OS_ENABLE_HW_BOUND_CHECK)              \
+    || WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0 \
     || WASM_ENABLE_BULK_MEMORY != 0
     uint64 linear_mem_size = 0;
     if (memory)
@@ -1516,17 +3643,30 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #if WASM_ENABLE_TAIL_CALL != 0 || WASM_ENABLE_GC != 0
     bool is_return_call = false;
 #endif
+#if WASM_INTERP_TAIL_DISPATCH != 0
+    WASMInterpTailContext tail_ctx = { exec_env, 0 };
+#endif
+#if WASM_ENABLE_FUEL_METERING != 0
+    int64 fuel = 0;
+#endif
 
 #if WASM_ENABLE_LABELS_AS_VALUES != 0
 #define HANDLE_OPCODE(op) &&HANDLE_##op
     DEFINE_GOTO_TABLE(const void *, handle_table);
 #undef HANDLE_OPCODE
     if (exec_env == NULL) {
+#if WASM_INTERP_TAIL_DISPATCH != 0
+        init_tail_handle_table((void **)handle_table);
+        global_handle_table = tail_handle_table;
+#else
         global_handle_table = (void **)handle_table;
+#endif
         return;
     }
 #endif
 
+    UPDATE_FUEL();
+
 #if WASM_ENABLE_LABELS_AS_VALUES == 0
     while (frame_ip < frame_ip_end) {
         opcode = *frame_ip++;
@@ -1548,6 +3688,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
             {
                 cond = (uint32)POP_I32();
 
+            handle_op_if:
                 if (cond == 0) {
                     uint8 *else_addr = (uint8 *)LOAD_PTR(frame_ip);
                     if (else_addr == NULL) {
@@ -1580,20 +3721,148 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
-            HANDLE_OP(WASM_OP_BR_IF)
+            HANDLE_OP(WASM_OP_BR_IF)
+            {
+                cond = frame_lp[GET_OFFSET()];
+
+            handle_op_br_if:
+#if WASM_ENABLE_THREAD_MGR != 0
+                CHECK_SUSPEND_FLAGS();
+#endif
+                if (cond)
+                    goto recover_br_info;
+                else
+                    SKIP_BR_INFO();
+
+                HANDLE_OP_END();
+            }
+
+            /* i32 comparisons fused with br_if by the loader */
+            HANDLE_OP(EXT_OP_BR_IF_I32_EQZ)
+            {
+                DEF_OP_FUSED_EQZ(handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_EQ)
+            {
+                DEF_OP_FUSED_CMP(uint32, ==, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_NE)
+            {
+                DEF_OP_FUSED_CMP(uint32, !=, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LT_S)
+            {
+                DEF_OP_FUSED_CMP(int32, <, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LT_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, <, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GT_S)
+            {
+                DEF_OP_FUSED_CMP(int32, >, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GT_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, >, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LE_S)
+            {
+                DEF_OP_FUSED_CMP(int32, <=, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_LE_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, <=, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GE_S)
+            {
+                DEF_OP_FUSED_CMP(int32, >=, handle_op_br_if);
+            }
+
+            HANDLE_OP(EXT_OP_BR_IF_I32_GE_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, >=, handle_op_br_if);
+            }
+
+            /* i32 comparisons fused with if by the loader */
+            HANDLE_OP(EXT_OP_IF_I32_EQZ)
+            {
+                DEF_OP_FUSED_EQZ(handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_EQ)
+            {
+                DEF_OP_FUSED_CMP(uint32, ==, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_NE)
+            {
+                DEF_OP_FUSED_CMP(uint32, !=, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_LT_S)
+            {
+                DEF_OP_FUSED_CMP(int32, <, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_LT_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, <, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_GT_S)
+            {
+                DEF_OP_FUSED_CMP(int32, >, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_GT_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, >, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_LE_S)
+            {
+                DEF_OP_FUSED_CMP(int32, <=, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_LE_U)
+            {
+                DEF_OP_FUSED_CMP(uint32, <=, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_GE_S)
+            {
+                DEF_OP_FUSED_CMP(int32, >=, handle_op_if);
+            }
+
+            HANDLE_OP(EXT_OP_IF_I32_GE_U)
             {
-#if WASM_ENABLE_THREAD_MGR != 0
-                CHECK_SUSPEND_FLAGS();
-#endif
-                cond = frame_lp[GET_OFFSET()];
+                DEF_OP_FUSED_CMP(uint32, >=, handle_op_if);
+            }
 
-                if (cond)
-                    goto recover_br_info;
-                else
-                    SKIP_BR_INFO();
+#if WASM_ENABLE_FUEL_METERING != 0
+            /* emitted by the loader before the control instructions */
+            HANDLE_OP(EXT_OP_CHARGE_FUEL)
+            {
+                uint32 cost = read_uint32(frame_ip);
 
+                fuel -= cost;
+                if (fuel < 0) {
+                    wasm_set_exception(module, "out of fuel");
+                    goto got_exception;
+                }
                 HANDLE_OP_END();
             }
+#endif
 
             HANDLE_OP(WASM_OP_BR_TABLE)
             {
@@ -1652,6 +3921,13 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                                         GET_OPERAND(uint64, I64, off));
                         ret_offset += 2;
                     }
+#if WASM_ENABLE_SIMD != 0
+                    else if (ret_types[ret_idx] == VALUE_TYPE_V128) {
+                        PUT_V128_TO_ADDR(prev_frame->lp + ret_offset,
+                                         GET_OPERAND(V128, V128, off));
+                        ret_offset += 4;
+                    }
+#endif
 #if WASM_ENABLE_GC != 0
                     else if (wasm_is_type_reftype(ret_types[ret_idx])) {
                         PUT_REF_TO_ADDR(prev_frame->lp + ret_offset,
@@ -1815,6 +4091,28 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+#if WASM_ENABLE_SIMD != 0
+            HANDLE_OP(WASM_OP_SELECT_128)
+            {
+                cond = frame_lp[GET_OFFSET()];
+                addr1 = GET_OFFSET();
+                addr2 = GET_OFFSET();
+                addr_ret = GET_OFFSET();
+
+                if (!cond) {
+                    if (addr_ret != addr1)
+                        PUT_V128_TO_ADDR(frame_lp + addr_ret,
+                                         GET_V128_FROM_ADDR(frame_lp + addr1));
+                }
+                else {
+                    if (addr_ret != addr2)
+                        PUT_V128_TO_ADDR(frame_lp + addr_ret,
+                                         GET_V128_FROM_ADDR(frame_lp + addr2));
+                }
+                HANDLE_OP_END();
+            }
+#endif
+
 #if WASM_ENABLE_GC != 0
             HANDLE_OP(WASM_OP_SELECT_T)
             {
@@ -3475,6 +5773,25 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+#if WASM_ENABLE_SIMD != 0
+            HANDLE_OP(EXT_OP_SET_LOCAL_FAST_V128)
+            HANDLE_OP(EXT_OP_TEE_LOCAL_FAST_V128)
+            {
+                /* clang-format off */
+#if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
+                local_offset = *frame_ip++;
+#else
+                local_offset = *frame_ip;
+                frame_ip += 2;
+#endif
+                /* clang-format on */
+                PUT_V128_TO_ADDR(frame_lp + local_offset,
+                                 GET_OPERAND(V128, V128, 0));
+                frame_ip += 2;
+                HANDLE_OP_END();
+            }
+#endif
+
             HANDLE_OP(WASM_OP_GET_GLOBAL)
             {
                 global_idx = read_uint32(frame_ip);
@@ -3512,6 +5829,20 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+#if WASM_ENABLE_SIMD != 0
+            HANDLE_OP(WASM_OP_GET_GLOBAL_V128)
+            {
+                global_idx = read_uint32(frame_ip);
+                bh_assert(global_idx < module->e->global_count);
+                global = globals + global_idx;
+                global_addr = get_global_addr(global_data, global);
+                addr_ret = GET_OFFSET();
+                PUT_V128_TO_ADDR(frame_lp + addr_ret,
+                                 GET_V128_FROM_ADDR((uint32 *)global_addr));
+                HANDLE_OP_END();
+            }
+#endif
+
             HANDLE_OP(WASM_OP_SET_GLOBAL)
             {
                 global_idx = read_uint32(frame_ip);
@@ -3579,6 +5910,20 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+#if WASM_ENABLE_SIMD != 0
+            HANDLE_OP(WASM_OP_SET_GLOBAL_V128)
+            {
+                global_idx = read_uint32(frame_ip);
+                bh_assert(global_idx < module->e->global_count);
+                global = globals + global_idx;
+                global_addr = get_global_addr(global_data, global);
+                addr1 = GET_OFFSET();
+                PUT_V128_TO_ADDR((uint32 *)global_addr,
+                                 GET_V128_FROM_ADDR(frame_lp + addr1));
+                HANDLE_OP_END();
+            }
+#endif
+
             /* memory load instructions */
             HANDLE_OP(WASM_OP_I32_LOAD)
             {
@@ -4823,6 +7168,18 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 HANDLE_OP_END();
             }
 
+#if WASM_ENABLE_SIMD != 0
+            HANDLE_OP(EXT_OP_COPY_STACK_TOP_V128)
+            {
+                addr1 = GET_OFFSET();
+                addr2 = GET_OFFSET();
+
+                PUT_V128_TO_ADDR(frame_lp + addr2,
+                                 GET_V128_FROM_ADDR(frame_lp + addr1));
+                HANDLE_OP_END();
+            }
+#endif
+
             HANDLE_OP(EXT_OP_COPY_STACK_VALUES)
             {
                 uint32 values_count, total_cell;
@@ -4881,6 +7238,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                     PUT_I64_TO_ADDR((uint32 *)(frame_lp + local_offset),
                                     GET_I64_FROM_ADDR(frame_lp + addr1));
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (local_type == VALUE_TYPE_V128) {
+                    PUT_V128_TO_ADDR(frame_lp + local_offset,
+                                     GET_V128_FROM_ADDR(frame_lp + addr1));
+                }
+#endif
 #if WASM_ENABLE_GC != 0
                 else if (wasm_is_type_reftype(local_type)) {
                     PUT_REF_TO_ADDR((uint32 *)(frame_lp + local_offset),
@@ -4984,9 +7347,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #ifndef OS_ENABLE_HW_BOUND_CHECK
                         CHECK_BULK_MEMORY_OVERFLOW(addr, bytes, maddr);
 #else
-                        if ((uint64)(uint32)addr + bytes > linear_mem_size)
-                            goto out_of_bounds;
-                        maddr = memory->memory_data + (uint32)addr;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)addr, bytes, maddr)
+                        {
+                            if ((uint64)(uint32)addr + bytes > linear_mem_size)
+                                goto out_of_bounds;
+                            maddr = memory->memory_data + (uint32)addr;
+                        }
 #endif
                         if (bh_bitmap_get_bit(module->e->common.data_dropped,
                                               segment)) {
@@ -5002,7 +7368,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                         if (offset + bytes > seg_len)
                             goto out_of_bounds;
 
-                        bh_memcpy_s(maddr, (uint32)(linear_mem_size - addr),
+                        bh_memcpy_s(maddr, (uint32)bytes,
                                     data + offset, (uint32)bytes);
                         break;
                     }
@@ -5032,17 +7398,23 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                         CHECK_BULK_MEMORY_OVERFLOW(src, len, msrc);
                         CHECK_BULK_MEMORY_OVERFLOW(dst, len, mdst);
 #else
-                        if ((uint64)(uint32)src + len > linear_mem_size)
-                            goto out_of_bounds;
-                        msrc = memory->memory_data + (uint32)src;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)src, len, msrc)
+                        {
+                            if ((uint64)(uint32)src + len > linear_mem_size)
+                                goto out_of_bounds;
+                            msrc = memory->memory_data + (uint32)src;
+                        }
 
-                        if ((uint64)(uint32)dst + len > linear_mem_size)
-                            goto out_of_bounds;
-                        mdst = memory->memory_data + (uint32)dst;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)dst, len, mdst)
+                        {
+                            if ((uint64)(uint32)dst + len > linear_mem_size)
+                                goto out_of_bounds;
+                            mdst = memory->memory_data + (uint32)dst;
+                        }
 #endif
 
                         /* allowing the destination and source to overlap */
-                        bh_memmove_s(mdst, (uint32)(linear_mem_size - dst),
+                        bh_memmove_s(mdst, (uint32)len,
                                      msrc, len);
                         break;
                     }
@@ -5062,9 +7434,12 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 #ifndef OS_ENABLE_HW_BOUND_CHECK
                         CHECK_BULK_MEMORY_OVERFLOW(dst, len, mdst);
 #else
-                        if ((uint64)(uint32)dst + len > linear_mem_size)
-                            goto out_of_bounds;
-                        mdst = memory->memory_data + (uint32)dst;
+                        CHECK_SHARED_HEAP_OVERFLOW((uint32)dst, len, mdst)
+                        {
+                            if ((uint64)(uint32)dst + len > linear_mem_size)
+                                goto out_of_bounds;
+                            mdst = memory->memory_data + (uint32)dst;
+                        }
 #endif
 
                         memset(mdst, fill_val, len);
@@ -5423,214 +7798,1299 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                             readv = (uint64)LOAD_U16(maddr);
                             shared_memory_unlock(memory);
                         }
-                        else if (opcode == WASM_OP_ATOMIC_I64_LOAD32_U) {
+                        else if (opcode == WASM_OP_ATOMIC_I64_LOAD32_U) {
+                            CHECK_MEMORY_OVERFLOW(4);
+                            CHECK_ATOMIC_MEMORY_ACCESS(4);
+                            shared_memory_lock(memory);
+                            readv = (uint64)LOAD_U32(maddr);
+                            shared_memory_unlock(memory);
+                        }
+                        else {
+                            CHECK_MEMORY_OVERFLOW(8);
+                            CHECK_ATOMIC_MEMORY_ACCESS(8);
+                            shared_memory_lock(memory);
+                            readv = LOAD_I64(maddr);
+                            shared_memory_unlock(memory);
+                        }
+
+                        PUSH_I64(readv);
+                        break;
+                    }
+                    case WASM_OP_ATOMIC_I32_STORE:
+                    case WASM_OP_ATOMIC_I32_STORE8:
+                    case WASM_OP_ATOMIC_I32_STORE16:
+                    {
+                        uint32 sval;
+
+                        sval = (uint32)POP_I32();
+                        addr = POP_I32();
+
+                        if (opcode == WASM_OP_ATOMIC_I32_STORE8) {
+                            CHECK_MEMORY_OVERFLOW(1);
+                            CHECK_ATOMIC_MEMORY_ACCESS(1);
+                            shared_memory_lock(memory);
+                            *(uint8 *)maddr = (uint8)sval;
+                            shared_memory_unlock(memory);
+                        }
+                        else if (opcode == WASM_OP_ATOMIC_I32_STORE16) {
+                            CHECK_MEMORY_OVERFLOW(2);
+                            CHECK_ATOMIC_MEMORY_ACCESS(2);
+                            shared_memory_lock(memory);
+                            STORE_U16(maddr, (uint16)sval);
+                            shared_memory_unlock(memory);
+                        }
+                        else {
+                            CHECK_MEMORY_OVERFLOW(4);
+                            CHECK_ATOMIC_MEMORY_ACCESS(4);
+                            shared_memory_lock(memory);
+                            STORE_U32(maddr, sval);
+                            shared_memory_unlock(memory);
+                        }
+                        break;
+                    }
+
+                    case WASM_OP_ATOMIC_I64_STORE:
+                    case WASM_OP_ATOMIC_I64_STORE8:
+                    case WASM_OP_ATOMIC_I64_STORE16:
+                    case WASM_OP_ATOMIC_I64_STORE32:
+                    {
+                        uint64 sval;
+
+                        sval = (uint64)POP_I64();
+                        addr = POP_I32();
+
+                        if (opcode == WASM_OP_ATOMIC_I64_STORE8) {
+                            CHECK_MEMORY_OVERFLOW(1);
+                            CHECK_ATOMIC_MEMORY_ACCESS(1);
+                            shared_memory_lock(memory);
+                            *(uint8 *)maddr = (uint8)sval;
+                            shared_memory_unlock(memory);
+                        }
+                        else if (opcode == WASM_OP_ATOMIC_I64_STORE16) {
+                            CHECK_MEMORY_OVERFLOW(2);
+                            CHECK_ATOMIC_MEMORY_ACCESS(2);
+                            shared_memory_lock(memory);
+                            STORE_U16(maddr, (uint16)sval);
+                            shared_memory_unlock(memory);
+                        }
+                        else if (opcode == WASM_OP_ATOMIC_I64_STORE32) {
+                            CHECK_MEMORY_OVERFLOW(4);
+                            CHECK_ATOMIC_MEMORY_ACCESS(4);
+                            shared_memory_lock(memory);
+                            STORE_U32(maddr, (uint32)sval);
+                            shared_memory_unlock(memory);
+                        }
+                        else {
+                            CHECK_MEMORY_OVERFLOW(8);
+                            CHECK_ATOMIC_MEMORY_ACCESS(8);
+                            shared_memory_lock(memory);
+                            STORE_I64(maddr, sval);
+                            shared_memory_unlock(memory);
+                        }
+                        break;
+                    }
+
+                    case WASM_OP_ATOMIC_RMW_I32_CMPXCHG:
+                    case WASM_OP_ATOMIC_RMW_I32_CMPXCHG8_U:
+                    case WASM_OP_ATOMIC_RMW_I32_CMPXCHG16_U:
+                    {
+                        uint32 readv, sval, expect;
+
+                        sval = POP_I32();
+                        expect = POP_I32();
+                        addr = POP_I32();
+
+                        if (opcode == WASM_OP_ATOMIC_RMW_I32_CMPXCHG8_U) {
+                            CHECK_MEMORY_OVERFLOW(1);
+                            CHECK_ATOMIC_MEMORY_ACCESS(1);
+
+                            expect = (uint8)expect;
+                            shared_memory_lock(memory);
+                            readv = (uint32)(*(uint8 *)maddr);
+                            if (readv == expect)
+                                *(uint8 *)maddr = (uint8)(sval);
+                            shared_memory_unlock(memory);
+                        }
+                        else if (opcode == WASM_OP_ATOMIC_RMW_I32_CMPXCHG16_U) {
+                            CHECK_MEMORY_OVERFLOW(2);
+                            CHECK_ATOMIC_MEMORY_ACCESS(2);
+
+                            expect = (uint16)expect;
+                            shared_memory_lock(memory);
+                            readv = (uint32)LOAD_U16(maddr);
+                            if (readv == expect)
+                                STORE_U16(maddr, (uint16)(sval));
+                            shared_memory_unlock(memory);
+                        }
+                        else {
+                            CHECK_MEMORY_OVERFLOW(4);
+                            CHECK_ATOMIC_MEMORY_ACCESS(4);
+
+                            shared_memory_lock(memory);
+                            readv = LOAD_I32(maddr);
+                            if (readv == expect)
+                                STORE_U32(maddr, sval);
+                            shared_memory_unlock(memory);
+                        }
+                        PUSH_I32(readv);
+                        break;
+                    }
+                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG:
+                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG8_U:
+                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG16_U:
+                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG32_U:
+                    {
+                        uint64 readv, sval, expect;
+
+                        sval = (uint64)POP_I64();
+                        expect = (uint64)POP_I64();
+                        addr = POP_I32();
+
+                        if (opcode == WASM_OP_ATOMIC_RMW_I64_CMPXCHG8_U) {
+                            CHECK_MEMORY_OVERFLOW(1);
+                            CHECK_ATOMIC_MEMORY_ACCESS(1);
+
+                            expect = (uint8)expect;
+                            shared_memory_lock(memory);
+                            readv = (uint64)(*(uint8 *)maddr);
+                            if (readv == expect)
+                                *(uint8 *)maddr = (uint8)(sval);
+                            shared_memory_unlock(memory);
+                        }
+                        else if (opcode == WASM_OP_ATOMIC_RMW_I64_CMPXCHG16_U) {
+                            CHECK_MEMORY_OVERFLOW(2);
+                            CHECK_ATOMIC_MEMORY_ACCESS(2);
+
+                            expect = (uint16)expect;
+                            shared_memory_lock(memory);
+                            readv = (uint64)LOAD_U16(maddr);
+                            if (readv == expect)
+                                STORE_U16(maddr, (uint16)(sval));
+                            shared_memory_unlock(memory);
+                        }
+                        else if (opcode == WASM_OP_ATOMIC_RMW_I64_CMPXCHG32_U) {
                             CHECK_MEMORY_OVERFLOW(4);
                             CHECK_ATOMIC_MEMORY_ACCESS(4);
+
+                            expect = (uint32)expect;
                             shared_memory_lock(memory);
                             readv = (uint64)LOAD_U32(maddr);
+                            if (readv == expect)
+                                STORE_U32(maddr, (uint32)(sval));
                             shared_memory_unlock(memory);
                         }
                         else {
                             CHECK_MEMORY_OVERFLOW(8);
                             CHECK_ATOMIC_MEMORY_ACCESS(8);
+
                             shared_memory_lock(memory);
-                            readv = LOAD_I64(maddr);
+                            readv = (uint64)LOAD_I64(maddr);
+                            if (readv == expect)
+                                STORE_I64(maddr, sval);
                             shared_memory_unlock(memory);
                         }
-
                         PUSH_I64(readv);
                         break;
                     }
-                    case WASM_OP_ATOMIC_I32_STORE:
-                    case WASM_OP_ATOMIC_I32_STORE8:
-                    case WASM_OP_ATOMIC_I32_STORE16:
+
+                        DEF_ATOMIC_RMW_OPCODE(ADD, +);
+                        DEF_ATOMIC_RMW_OPCODE(SUB, -);
+                        DEF_ATOMIC_RMW_OPCODE(AND, &);
+                        DEF_ATOMIC_RMW_OPCODE(OR, |);
+                        DEF_ATOMIC_RMW_OPCODE(XOR, ^);
+                        /* xchg, ignore the read value, and store the given
+                          value: readv * 0 + sval */
+                        DEF_ATOMIC_RMW_OPCODE(XCHG, *0 +);
+                }
+
+                HANDLE_OP_END();
+            }
+#endif
+
+#if WASM_ENABLE_SIMD != 0
+            HANDLE_OP(WASM_OP_SIMD_PREFIX)
+            {
+                GET_OPCODE();
+
+                switch (opcode) {
+                    /* memory instruction */
+                    case SIMD_v128_load:
                     {
-                        uint32 sval;
+                        uint32 offset, addr;
+                        V128 res;
+                        offset = read_uint32(frame_ip);
+                        addr = (uint32)POP_I32();
+                        CHECK_MEMORY_OVERFLOW(16);
+                        memcpy(&res, maddr, 16);
+                        PUSH_V128(res);
+                        break;
+                    }
+                    case SIMD_v128_load8x8_s:
+                        DEF_OP_SIMD_LOAD_EXTEND(int8, i8x16, i16x8, 8);
+                        break;
+                    case SIMD_v128_load8x8_u:
+                        DEF_OP_SIMD_LOAD_EXTEND(uint8, i8x16, i16x8, 8);
+                        break;
+                    case SIMD_v128_load16x4_s:
+                        DEF_OP_SIMD_LOAD_EXTEND(int16, i16x8, i32x4, 4);
+                        break;
+                    case SIMD_v128_load16x4_u:
+                        DEF_OP_SIMD_LOAD_EXTEND(uint16, i16x8, i32x4, 4);
+                        break;
+                    case SIMD_v128_load32x2_s:
+                        DEF_OP_SIMD_LOAD_EXTEND(int32, i32x4, i64x2, 2);
+                        break;
+                    case SIMD_v128_load32x2_u:
+                        DEF_OP_SIMD_LOAD_EXTEND(uint32, i32x4, i64x2, 2);
+                        break;
+                    case SIMD_v128_load8_splat:
+                        DEF_OP_SIMD_LOAD_SPLAT(int8, i8x16, 16);
+                        break;
+                    case SIMD_v128_load16_splat:
+                        DEF_OP_SIMD_LOAD_SPLAT(int16, i16x8, 8);
+                        break;
+                    case SIMD_v128_load32_splat:
+                        DEF_OP_SIMD_LOAD_SPLAT(int32, i32x4, 4);
+                        break;
+                    case SIMD_v128_load64_splat:
+                        DEF_OP_SIMD_LOAD_SPLAT(int64, i64x2, 2);
+                        break;
+                    case SIMD_v128_store:
+                    {
+                        uint32 offset, addr;
+                        V128 v1;
+                        offset = read_uint32(frame_ip);
+                        v1 = POP_V128();
+                        addr = (uint32)POP_I32();
+                        CHECK_MEMORY_OVERFLOW(16);
+                        memcpy(maddr, &v1, 16);
+                        break;
+                    }
 
-                        sval = (uint32)POP_I32();
-                        addr = POP_I32();
+                    /* basic operation */
+                    case SIMD_v128_const:
+                    {
+                        /* Only emitted when the const can't be put into
+                           the const slots */
+                        V128 res;
+                        bh_memcpy_s(&res, sizeof(V128), frame_ip, 16);
+                        frame_ip += 16;
+                        PUSH_V128(res);
+                        break;
+                    }
+                    case SIMD_v8x16_shuffle:
+                    {
+                        V128 mask, v2, v1, res;
+                        uint32 i;
+                        bh_memcpy_s(&mask, sizeof(V128), frame_ip, 16);
+                        frame_ip += 16;
+                        v2 = POP_V128();
+                        v1 = POP_V128();
+                        for (i = 0; i < 16; i++) {
+                            uint8 index = (uint8)mask.i8x16[i];
+                            res.i8x16[i] = index < 16 ? v1.i8x16[index]
+                                                      : v2.i8x16[index - 16];
+                        }
+                        PUSH_V128(res);
+                        break;
+                    }
+                    case SIMD_v8x16_swizzle:
+                    {
+                        V128 v2 = POP_V128(), v1 = POP_V128(), res;
+                        uint32 i;
+                        for (i = 0; i < 16; i++) {
+                            uint8 index = (uint8)v2.i8x16[i];
+                            res.i8x16[i] = index < 16 ? v1.i8x16[index] : 0;
+                        }
+                        PUSH_V128(res);
+                        break;
+                    }
 
-                        if (opcode == WASM_OP_ATOMIC_I32_STORE8) {
-                            CHECK_MEMORY_OVERFLOW(1);
-                            CHECK_ATOMIC_MEMORY_ACCESS(1);
-                            shared_memory_lock(memory);
-                            *(uint8 *)maddr = (uint8)sval;
-                            shared_memory_unlock(memory);
+                    /* splat operation */
+                    case SIMD_i8x16_splat:
+                        DEF_OP_SIMD_SPLAT(int8, i8x16, 16, POP_I32());
+                        break;
+                    case SIMD_i16x8_splat:
+                        DEF_OP_SIMD_SPLAT(int16, i16x8, 8, POP_I32());
+                        break;
+                    case SIMD_i32x4_splat:
+                        DEF_OP_SIMD_SPLAT(int32, i32x4, 4, POP_I32());
+                        break;
+                    case SIMD_i64x2_splat:
+                        DEF_OP_SIMD_SPLAT(int64, i64x2, 2, POP_I64());
+                        break;
+                    case SIMD_f32x4_splat:
+                        DEF_OP_SIMD_SPLAT(float32, f32x4, 4, POP_F32());
+                        break;
+                    case SIMD_f64x2_splat:
+                        DEF_OP_SIMD_SPLAT(float64, f64x2, 2, POP_F64());
+                        break;
+
+                    /* lane operation */
+                    case SIMD_i8x16_extract_lane_s:
+                    case SIMD_i8x16_extract_lane_u:
+                    case SIMD_i16x8_extract_lane_s:
+                    case SIMD_i16x8_extract_lane_u:
+                    case SIMD_i32x4_extract_lane:
+                    case SIMD_i64x2_extract_lane:
+                    case SIMD_f32x4_extract_lane:
+                    case SIMD_f64x2_extract_lane:
+                    {
+                        uint8 lane;
+                        V128 v1;
+                        GET_SIMD_LANE();
+                        v1 = POP_V128();
+                        if (opcode == SIMD_i8x16_extract_lane_s)
+                            PUSH_I32((int32)v1.i8x16[lane]);
+                        else if (opcode == SIMD_i8x16_extract_lane_u)
+                            PUSH_I32((int32)(uint8)v1.i8x16[lane]);
+                        else if (opcode == SIMD_i16x8_extract_lane_s)
+                            PUSH_I32((int32)v1.i16x8[lane]);
+                        else if (opcode == SIMD_i16x8_extract_lane_u)
+                            PUSH_I32((int32)(uint16)v1.i16x8[lane]);
+                        else if (opcode == SIMD_i32x4_extract_lane)
+                            PUSH_I32(v1.i32x4[lane]);
+                        else if (opcode == SIMD_i64x2_extract_lane)
+                            PUSH_I64(v1.i64x2[lane]);
+                        else if (opcode == SIMD_f32x4_extract_lane)
+                            PUSH_F32(v1.f32x4[lane]);
+                        else
+                            PUSH_F64(v1.f64x2[lane]);
+                        break;
+                    }
+                    case SIMD_i8x16_replace_lane:
+                    case SIMD_i16x8_replace_lane:
+                    case SIMD_i32x4_replace_lane:
+                    case SIMD_i64x2_replace_lane:
+                    case SIMD_f32x4_replace_lane:
+                    case SIMD_f64x2_replace_lane:
+                    {
+                        uint8 lane;
+                        V128 v1;
+                        GET_SIMD_LANE();
+                        if (opcode == SIMD_i8x16_replace_lane) {
+                            int8 value = (int8)POP_I32();
+                            v1 = POP_V128();
+                            v1.i8x16[lane] = value;
                         }
-                        else if (opcode == WASM_OP_ATOMIC_I32_STORE16) {
-                            CHECK_MEMORY_OVERFLOW(2);
-                            CHECK_ATOMIC_MEMORY_ACCESS(2);
-                            shared_memory_lock(memory);
-                            STORE_U16(maddr, (uint16)sval);
-                            shared_memory_unlock(memory);
+                        else if (opcode == SIMD_i16x8_replace_lane) {
+                            int16 value = (int16)POP_I32();
+                            v1 = POP_V128();
+                            v1.i16x8[lane] = value;
+                        }
+                        else if (opcode == SIMD_i32x4_replace_lane) {
+                            int32 value = POP_I32();
+                            v1 = POP_V128();
+                            v1.i32x4[lane] = value;
+                        }
+                        else if (opcode == SIMD_i64x2_replace_lane) {
+                            int64 value = POP_I64();
+                            v1 = POP_V128();
+                            v1.i64x2[lane] = value;
+                        }
+                        else if (opcode == SIMD_f32x4_replace_lane) {
+                            float32 value = POP_F32();
+                            v1 = POP_V128();
+                            v1.f32x4[lane] = value;
                         }
                         else {
-                            CHECK_MEMORY_OVERFLOW(4);
-                            CHECK_ATOMIC_MEMORY_ACCESS(4);
-                            shared_memory_lock(memory);
-                            STORE_U32(maddr, sval);
-                            shared_memory_unlock(memory);
+                            float64 value = POP_F64();
+                            v1 = POP_V128();
+                            v1.f64x2[lane] = value;
                         }
+                        PUSH_V128(v1);
+                        break;
+                    }
+
+                    /* i8x16 compare operation */
+                    case SIMD_i8x16_eq:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmpeq_epi8, u8, u8,
+                                                vceqq_u8, int8, i8x16, i8x16,
+                                                16, a == b);
+                        break;
+                    case SIMD_i8x16_ne:
+                        DEF_OP_SIMD_COMPARE(int8, i8x16, i8x16, 16, a != b);
+                        break;
+                    case SIMD_i8x16_lt_s:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmplt_epi8, s8, u8,
+                                                vcltq_s8, int8, i8x16, i8x16,
+                                                16, a < b);
+                        break;
+                    case SIMD_i8x16_lt_u:
+                        DEF_OP_SIMD_COMPARE(uint8, i8x16, i8x16, 16, a < b);
+                        break;
+                    case SIMD_i8x16_gt_s:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmpgt_epi8, s8, u8,
+                                                vcgtq_s8, int8, i8x16, i8x16,
+                                                16, a > b);
+                        break;
+                    case SIMD_i8x16_gt_u:
+                        DEF_OP_SIMD_COMPARE(uint8, i8x16, i8x16, 16, a > b);
+                        break;
+                    case SIMD_i8x16_le_s:
+                        DEF_OP_SIMD_COMPARE(int8, i8x16, i8x16, 16, a <= b);
+                        break;
+                    case SIMD_i8x16_le_u:
+                        DEF_OP_SIMD_COMPARE(uint8, i8x16, i8x16, 16, a <= b);
+                        break;
+                    case SIMD_i8x16_ge_s:
+                        DEF_OP_SIMD_COMPARE(int8, i8x16, i8x16, 16, a >= b);
+                        break;
+                    case SIMD_i8x16_ge_u:
+                        DEF_OP_SIMD_COMPARE(uint8, i8x16, i8x16, 16, a >= b);
+                        break;
+
+                    /* i16x8 compare operation */
+                    case SIMD_i16x8_eq:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmpeq_epi16, u16,
+                                                u16, vceqq_u16, int16, i16x8,
+                                                i16x8, 8, a == b);
+                        break;
+                    case SIMD_i16x8_ne:
+                        DEF_OP_SIMD_COMPARE(int16, i16x8, i16x8, 8, a != b);
+                        break;
+                    case SIMD_i16x8_lt_s:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmplt_epi16, s16,
+                                                u16, vcltq_s16, int16, i16x8,
+                                                i16x8, 8, a < b);
+                        break;
+                    case SIMD_i16x8_lt_u:
+                        DEF_OP_SIMD_COMPARE(uint16, i16x8, i16x8, 8, a < b);
+                        break;
+                    case SIMD_i16x8_gt_s:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmpgt_epi16, s16,
+                                                u16, vcgtq_s16, int16, i16x8,
+                                                i16x8, 8, a > b);
+                        break;
+                    case SIMD_i16x8_gt_u:
+                        DEF_OP_SIMD_COMPARE(uint16, i16x8, i16x8, 8, a > b);
+                        break;
+                    case SIMD_i16x8_le_s:
+                        DEF_OP_SIMD_COMPARE(int16, i16x8, i16x8, 8, a <= b);
+                        break;
+                    case SIMD_i16x8_le_u:
+                        DEF_OP_SIMD_COMPARE(uint16, i16x8, i16x8, 8, a <= b);
+                        break;
+                    case SIMD_i16x8_ge_s:
+                        DEF_OP_SIMD_COMPARE(int16, i16x8, i16x8, 8, a >= b);
+                        break;
+                    case SIMD_i16x8_ge_u:
+                        DEF_OP_SIMD_COMPARE(uint16, i16x8, i16x8, 8, a >= b);
+                        break;
+
+                    /* i32x4 compare operation */
+                    case SIMD_i32x4_eq:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmpeq_epi32, u32,
+                                                u32, vceqq_u32, int32, i32x4,
+                                                i32x4, 4, a == b);
+                        break;
+                    case SIMD_i32x4_ne:
+                        DEF_OP_SIMD_COMPARE(int32, i32x4, i32x4, 4, a != b);
+                        break;
+                    case SIMD_i32x4_lt_s:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmplt_epi32, s32,
+                                                u32, vcltq_s32, int32, i32x4,
+                                                i32x4, 4, a < b);
+                        break;
+                    case SIMD_i32x4_lt_u:
+                        DEF_OP_SIMD_COMPARE(uint32, i32x4, i32x4, 4, a < b);
+                        break;
+                    case SIMD_i32x4_gt_s:
+                        DEF_OP_SIMD_COMPARE_OPT(si128, _mm_cmpgt_epi32, s32,
+                                                u32, vcgtq_s32, int32, i32x4,
+                                                i32x4, 4, a > b);
+                        break;
+                    case SIMD_i32x4_gt_u:
+                        DEF_OP_SIMD_COMPARE(uint32, i32x4, i32x4, 4, a > b);
+                        break;
+                    case SIMD_i32x4_le_s:
+                        DEF_OP_SIMD_COMPARE(int32, i32x4, i32x4, 4, a <= b);
+                        break;
+                    case SIMD_i32x4_le_u:
+                        DEF_OP_SIMD_COMPARE(uint32, i32x4, i32x4, 4, a <= b);
+                        break;
+                    case SIMD_i32x4_ge_s:
+                        DEF_OP_SIMD_COMPARE(int32, i32x4, i32x4, 4, a >= b);
+                        break;
+                    case SIMD_i32x4_ge_u:
+                        DEF_OP_SIMD_COMPARE(uint32, i32x4, i32x4, 4, a >= b);
+                        break;
+
+                    /* f32x4 compare operation */
+                    case SIMD_f32x4_eq:
+                        DEF_OP_SIMD_COMPARE_OPT(ps, _mm_cmpeq_ps, f32, u32,
+                                                vceqq_f32, float32, f32x4,
+                                                i32x4, 4, a == b);
+                        break;
+                    case SIMD_f32x4_ne:
+                        DEF_OP_SIMD_COMPARE(float32, f32x4, i32x4, 4, a != b);
+                        break;
+                    case SIMD_f32x4_lt:
+                        DEF_OP_SIMD_COMPARE_OPT(ps, _mm_cmplt_ps, f32, u32,
+                                                vcltq_f32, float32, f32x4,
+                                                i32x4, 4, a < b);
+                        break;
+                    case SIMD_f32x4_gt:
+                        DEF_OP_SIMD_COMPARE_OPT(ps, _mm_cmpgt_ps, f32, u32,
+                                                vcgtq_f32, float32, f32x4,
+                                                i32x4, 4, a > b);
+                        break;
+                    case SIMD_f32x4_le:
+                        DEF_OP_SIMD_COMPARE_OPT(ps, _mm_cmple_ps, f32, u32,
+                                                vcleq_f32, float32, f32x4,
+                                                i32x4, 4, a <= b);
+                        break;
+                    case SIMD_f32x4_ge:
+                        DEF_OP_SIMD_COMPARE_OPT(ps, _mm_cmpge_ps, f32, u32,
+                                                vcgeq_f32, float32, f32x4,
+                                                i32x4, 4, a >= b);
+                        break;
+
+                    /* f64x2 compare operation */
+                    case SIMD_f64x2_eq:
+                        DEF_OP_SIMD_COMPARE_OPT(pd, _mm_cmpeq_pd, f64, u64,
+                                                vceqq_f64, float64, f64x2,
+                                                i64x2, 2, a == b);
+                        break;
+                    case SIMD_f64x2_ne:
+                        DEF_OP_SIMD_COMPARE(float64, f64x2, i64x2, 2, a != b);
+                        break;
+                    case SIMD_f64x2_lt:
+                        DEF_OP_SIMD_COMPARE_OPT(pd, _mm_cmplt_pd, f64, u64,
+                                                vcltq_f64, float64, f64x2,
+                                                i64x2, 2, a < b);
+                        break;
+                    case SIMD_f64x2_gt:
+                        DEF_OP_SIMD_COMPARE_OPT(pd, _mm_cmpgt_pd, f64, u64,
+                                                vcgtq_f64, float64, f64x2,
+                                                i64x2, 2, a > b);
+                        break;
+                    case SIMD_f64x2_le:
+                        DEF_OP_SIMD_COMPARE_OPT(pd, _mm_cmple_pd, f64, u64,
+                                                vcleq_f64, float64, f64x2,
+                                                i64x2, 2, a <= b);
+                        break;
+                    case SIMD_f64x2_ge:
+                        DEF_OP_SIMD_COMPARE_OPT(pd, _mm_cmpge_pd, f64, u64,
+                                                vcgeq_f64, float64, f64x2,
+                                                i64x2, 2, a >= b);
+                        break;
+
+                    /* v128 operation */
+                    case SIMD_v128_not:
+                        DEF_OP_SIMD_UNARY(uint64, i64x2, 2, ~a);
+                        break;
+                    case SIMD_v128_and:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_and_si128, u8,
+                                               vandq_u8, uint64, i64x2, 2,
+                                               a & b);
+                        break;
+                    case SIMD_v128_andnot:
+                        DEF_OP_SIMD_BINARY_OPT(si128, sse2_v128_andnot, u8,
+                                               vbicq_u8, uint64, i64x2, 2,
+                                               a & ~b);
+                        break;
+                    case SIMD_v128_or:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_or_si128, u8,
+                                               vorrq_u8, uint64, i64x2, 2,
+                                               a | b);
+                        break;
+                    case SIMD_v128_xor:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_xor_si128, u8,
+                                               veorq_u8, uint64, i64x2, 2,
+                                               a ^ b);
+                        break;
+                    case SIMD_v128_bitselect:
+                    {
+                        V128 c = POP_V128(), v2 = POP_V128(),
+                             v1 = POP_V128(), res;
+                        res.i64x2[0] = (v1.i64x2[0] & c.i64x2[0])
+                                       | (v2.i64x2[0] & ~c.i64x2[0]);
+                        res.i64x2[1] = (v1.i64x2[1] & c.i64x2[1])
+                                       | (v2.i64x2[1] & ~c.i64x2[1]);
+                        PUSH_V128(res);
+                        break;
+                    }
+                    case SIMD_v128_any_true:
+                    {
+                        V128 v1 = POP_V128();
+                        PUSH_I32((v1.i64x2[0] | v1.i64x2[1]) != 0);
+                        break;
+                    }
+
+                    /* load lane operation */
+                    case SIMD_v128_load8_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(1, true);
+                        break;
+                    case SIMD_v128_load16_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(2, true);
+                        break;
+                    case SIMD_v128_load32_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(4, true);
+                        break;
+                    case SIMD_v128_load64_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(8, true);
+                        break;
+                    case SIMD_v128_store8_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(1, false);
+                        break;
+                    case SIMD_v128_store16_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(2, false);
+                        break;
+                    case SIMD_v128_store32_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(4, false);
+                        break;
+                    case SIMD_v128_store64_lane:
+                        DEF_OP_SIMD_LOAD_STORE_LANE(8, false);
+                        break;
+                    case SIMD_v128_load32_zero:
+                    case SIMD_v128_load64_zero:
+                    {
+                        uint32 offset, addr;
+                        uint32 bytes =
+                            opcode == SIMD_v128_load32_zero ? 4 : 8;
+                        V128 res;
+                        offset = read_uint32(frame_ip);
+                        addr = (uint32)POP_I32();
+                        CHECK_MEMORY_OVERFLOW(bytes);
+                        res.i64x2[0] = res.i64x2[1] = 0;
+                        memcpy(&res, maddr, bytes);
+                        PUSH_V128(res);
+                        break;
+                    }
+
+                    /* float conversion */
+                    case SIMD_f32x4_demote_f64x2_zero:
+                    {
+                        V128 v1 = POP_V128(), res;
+                        res.f32x4[0] = (float32)v1.f64x2[0];
+                        res.f32x4[1] = (float32)v1.f64x2[1];
+                        res.f32x4[2] = res.f32x4[3] = 0;
+                        PUSH_V128(res);
+                        break;
+                    }
+                    case SIMD_f64x2_promote_low_f32x4_zero:
+                    {
+                        V128 v1 = POP_V128(), res;
+                        res.f64x2[0] = (float64)v1.f32x4[0];
+                        res.f64x2[1] = (float64)v1.f32x4[1];
+                        PUSH_V128(res);
+                        break;
+                    }
+
+                    /* i8x16 operation */
+                    case SIMD_i8x16_abs:
+                        DEF_OP_SIMD_UNARY(int32, i8x16, 16, a < 0 ? -a : a);
+                        break;
+                    case SIMD_i8x16_neg:
+                        DEF_OP_SIMD_UNARY(int32, i8x16, 16, -a);
+                        break;
+                    case SIMD_i8x16_popcnt:
+                        DEF_OP_SIMD_UNARY(uint8, i8x16, 16, popcount32(a));
+                        break;
+                    case SIMD_i8x16_all_true:
+                        DEF_OP_SIMD_ALL_TRUE(i8x16, 16);
+                        break;
+                    case SIMD_i8x16_bitmask:
+                    {
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        int16 off1 = GET_OFFSET();
+                        PUSH_I32(_mm_movemask_epi8(
+                            _mm_loadu_si128((void *)(frame_lp + off1))));
+#else
+                        DEF_OP_SIMD_BITMASK(i8x16, 16);
+#endif
+                        break;
+                    }
+                    case SIMD_i8x16_narrow_i16x8_s:
+                        DEF_OP_SIMD_NARROW(i16x8, i8x16, 8, -128, 127);
+                        break;
+                    case SIMD_i8x16_narrow_i16x8_u:
+                        DEF_OP_SIMD_NARROW(i16x8, i8x16, 8, 0, 255);
+                        break;
+                    case SIMD_f32x4_ceil:
+                        DEF_OP_SIMD_UNARY(float32, f32x4, 4, ceilf(a));
+                        break;
+                    case SIMD_f32x4_floor:
+                        DEF_OP_SIMD_UNARY(float32, f32x4, 4, floorf(a));
+                        break;
+                    case SIMD_f32x4_trunc:
+                        DEF_OP_SIMD_UNARY(float32, f32x4, 4, truncf(a));
+                        break;
+                    case SIMD_f32x4_nearest:
+                        DEF_OP_SIMD_UNARY(float32, f32x4, 4, rintf(a));
+                        break;
+                    case SIMD_i8x16_shl:
+                        DEF_OP_SIMD_SHIFT(uint8, i8x16, 16, a << c);
+                        break;
+                    case SIMD_i8x16_shr_s:
+                        DEF_OP_SIMD_SHIFT(int8, i8x16, 16, a >> c);
+                        break;
+                    case SIMD_i8x16_shr_u:
+                        DEF_OP_SIMD_SHIFT(uint8, i8x16, 16, a >> c);
+                        break;
+                    case SIMD_i8x16_add:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_add_epi8, u8,
+                                               vaddq_u8, uint8, i8x16, 16,
+                                               a + b);
+                        break;
+                    case SIMD_i8x16_add_sat_s:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_adds_epi8, s8,
+                                               vqaddq_s8, int8, i8x16, 16,
+                                               SIMD_SAT(a + b, -128, 127));
+                        break;
+                    case SIMD_i8x16_add_sat_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_adds_epu8, u8,
+                                               vqaddq_u8, uint8, i8x16, 16,
+                                               SIMD_SAT(a + b, 0, 255));
+                        break;
+                    case SIMD_i8x16_sub:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_sub_epi8, u8,
+                                               vsubq_u8, uint8, i8x16, 16,
+                                               a - b);
+                        break;
+                    case SIMD_i8x16_sub_sat_s:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_subs_epi8, s8,
+                                               vqsubq_s8, int8, i8x16, 16,
+                                               SIMD_SAT(a - b, -128, 127));
+                        break;
+                    case SIMD_i8x16_sub_sat_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_subs_epu8, u8,
+                                               vqsubq_u8, uint8, i8x16, 16,
+                                               SIMD_SAT(a - b, 0, 255));
+                        break;
+                    case SIMD_f64x2_ceil:
+                        DEF_OP_SIMD_UNARY(float64, f64x2, 2, ceil(a));
+                        break;
+                    case SIMD_f64x2_floor:
+                        DEF_OP_SIMD_UNARY(float64, f64x2, 2, floor(a));
+                        break;
+                    case SIMD_i8x16_min_s:
+                        DEF_OP_SIMD_BINARY(int8, i8x16, 16, a < b ? a : b);
+                        break;
+                    case SIMD_i8x16_min_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_min_epu8, u8,
+                                               vminq_u8, uint8, i8x16, 16,
+                                               a < b ? a : b);
+                        break;
+                    case SIMD_i8x16_max_s:
+                        DEF_OP_SIMD_BINARY(int8, i8x16, 16, a > b ? a : b);
+                        break;
+                    case SIMD_i8x16_max_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_max_epu8, u8,
+                                               vmaxq_u8, uint8, i8x16, 16,
+                                               a > b ? a : b);
+                        break;
+                    case SIMD_f64x2_trunc:
+                        DEF_OP_SIMD_UNARY(float64, f64x2, 2, trunc(a));
+                        break;
+                    case SIMD_i8x16_avgr_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_avg_epu8, u8,
+                                               vrhaddq_u8, uint8, i8x16, 16,
+                                               (a + b + 1) >> 1);
+                        break;
+                    case SIMD_i16x8_extadd_pairwise_i8x16_s:
+                        DEF_OP_SIMD_PAIRWISE(int8, i8x16, i16x8, 8, a + b);
+                        break;
+                    case SIMD_i16x8_extadd_pairwise_i8x16_u:
+                        DEF_OP_SIMD_PAIRWISE(uint8, i8x16, i16x8, 8, a + b);
+                        break;
+                    case SIMD_i32x4_extadd_pairwise_i16x8_s:
+                        DEF_OP_SIMD_PAIRWISE(int16, i16x8, i32x4, 4, a + b);
+                        break;
+                    case SIMD_i32x4_extadd_pairwise_i16x8_u:
+                        DEF_OP_SIMD_PAIRWISE(uint16, i16x8, i32x4, 4, a + b);
+                        break;
+
+                    /* i16x8 operation */
+                    case SIMD_i16x8_abs:
+                        DEF_OP_SIMD_UNARY(int32, i16x8, 8, a < 0 ? -a : a);
+                        break;
+                    case SIMD_i16x8_neg:
+                        DEF_OP_SIMD_UNARY(int32, i16x8, 8, -a);
+                        break;
+                    case SIMD_i16x8_q15mulr_sat_s:
+                        DEF_OP_SIMD_BINARY(int32, i16x8, 8,
+                                           SIMD_SAT((a * b + 0x4000) >> 15,
+                                                    -32768, 32767));
+                        break;
+                    case SIMD_i16x8_all_true:
+                        DEF_OP_SIMD_ALL_TRUE(i16x8, 8);
+                        break;
+                    case SIMD_i16x8_bitmask:
+                        DEF_OP_SIMD_BITMASK(i16x8, 8);
+                        break;
+                    case SIMD_i16x8_narrow_i32x4_s:
+                        DEF_OP_SIMD_NARROW(i32x4, i16x8, 4, -32768, 32767);
+                        break;
+                    case SIMD_i16x8_narrow_i32x4_u:
+                        DEF_OP_SIMD_NARROW(i32x4, i16x8, 4, 0, 65535);
+                        break;
+                    case SIMD_i16x8_extend_low_i8x16_s:
+                        DEF_OP_SIMD_EXTEND(int8, i8x16, i16x8, 8, false, a);
+                        break;
+                    case SIMD_i16x8_extend_high_i8x16_s:
+                        DEF_OP_SIMD_EXTEND(int8, i8x16, i16x8, 8, true, a);
+                        break;
+                    case SIMD_i16x8_extend_low_i8x16_u:
+                        DEF_OP_SIMD_EXTEND(uint8, i8x16, i16x8, 8, false, a);
+                        break;
+                    case SIMD_i16x8_extend_high_i8x16_u:
+                        DEF_OP_SIMD_EXTEND(uint8, i8x16, i16x8, 8, true, a);
+                        break;
+                    case SIMD_i16x8_shl:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_sll_epi16, 15);
+#else
+                        DEF_OP_SIMD_SHIFT(uint16, i16x8, 8, a << c);
+#endif
+                        break;
+                    case SIMD_i16x8_shr_s:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_sra_epi16, 15);
+#else
+                        DEF_OP_SIMD_SHIFT(int16, i16x8, 8, a >> c);
+#endif
+                        break;
+                    case SIMD_i16x8_shr_u:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_srl_epi16, 15);
+#else
+                        DEF_OP_SIMD_SHIFT(uint16, i16x8, 8, a >> c);
+#endif
+                        break;
+                    case SIMD_i16x8_add:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_add_epi16, u16,
+                                               vaddq_u16, uint16, i16x8, 8,
+                                               a + b);
+                        break;
+                    case SIMD_i16x8_add_sat_s:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_adds_epi16, s16,
+                                               vqaddq_s16, int16, i16x8, 8,
+                                               SIMD_SAT(a + b, -32768, 32767));
+                        break;
+                    case SIMD_i16x8_add_sat_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_adds_epu16, u16,
+                                               vqaddq_u16, uint16, i16x8, 8,
+                                               SIMD_SAT(a + b, 0, 65535));
+                        break;
+                    case SIMD_i16x8_sub:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_sub_epi16, u16,
+                                               vsubq_u16, uint16, i16x8, 8,
+                                               a - b);
+                        break;
+                    case SIMD_i16x8_sub_sat_s:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_subs_epi16, s16,
+                                               vqsubq_s16, int16, i16x8, 8,
+                                               SIMD_SAT(a - b, -32768, 32767));
+                        break;
+                    case SIMD_i16x8_sub_sat_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_subs_epu16, u16,
+                                               vqsubq_u16, uint16, i16x8, 8,
+                                               SIMD_SAT(a - b, 0, 65535));
+                        break;
+                    case SIMD_f64x2_nearest:
+                        DEF_OP_SIMD_UNARY(float64, f64x2, 2, rint(a));
+                        break;
+                    case SIMD_i16x8_mul:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_mullo_epi16, u16,
+                                               vmulq_u16, uint32, i16x8, 8,
+                                               a * b);
+                        break;
+                    case SIMD_i16x8_min_s:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_min_epi16, s16,
+                                               vminq_s16, int16, i16x8, 8,
+                                               a < b ? a : b);
+                        break;
+                    case SIMD_i16x8_min_u:
+                        DEF_OP_SIMD_BINARY(uint16, i16x8, 8, a < b ? a : b);
+                        break;
+                    case SIMD_i16x8_max_s:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_max_epi16, s16,
+                                               vmaxq_s16, int16, i16x8, 8,
+                                               a > b ? a : b);
+                        break;
+                    case SIMD_i16x8_max_u:
+                        DEF_OP_SIMD_BINARY(uint16, i16x8, 8, a > b ? a : b);
+                        break;
+                    case SIMD_i16x8_avgr_u:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_avg_epu16, u16,
+                                               vrhaddq_u16, uint16, i16x8, 8,
+                                               (a + b + 1) >> 1);
+                        break;
+                    case SIMD_i16x8_extmul_low_i8x16_s:
+                        DEF_OP_SIMD_EXTMUL(int8, i8x16, i16x8, 8, false,
+                                           a * b);
+                        break;
+                    case SIMD_i16x8_extmul_high_i8x16_s:
+                        DEF_OP_SIMD_EXTMUL(int8, i8x16, i16x8, 8, true, a * b);
+                        break;
+                    case SIMD_i16x8_extmul_low_i8x16_u:
+                        DEF_OP_SIMD_EXTMUL(uint8, i8x16, i16x8, 8, false,
+                                           a * b);
+                        break;
+                    case SIMD_i16x8_extmul_high_i8x16_u:
+                        DEF_OP_SIMD_EXTMUL(uint8, i8x16, i16x8, 8, true,
+                                           a * b);
+                        break;
+
+                    /* i32x4 operation */
+                    case SIMD_i32x4_abs:
+                        DEF_OP_SIMD_UNARY(int32, i32x4, 4,
+                                          a < 0 ? 0 - (uint32)a : (uint32)a);
+                        break;
+                    case SIMD_i32x4_neg:
+                        DEF_OP_SIMD_UNARY(uint32, i32x4, 4, 0 - a);
+                        break;
+                    case SIMD_i32x4_all_true:
+                        DEF_OP_SIMD_ALL_TRUE(i32x4, 4);
+                        break;
+                    case SIMD_i32x4_bitmask:
+                        DEF_OP_SIMD_BITMASK(i32x4, 4);
+                        break;
+                    case SIMD_i32x4_extend_low_i16x8_s:
+                        DEF_OP_SIMD_EXTEND(int16, i16x8, i32x4, 4, false, a);
+                        break;
+                    case SIMD_i32x4_extend_high_i16x8_s:
+                        DEF_OP_SIMD_EXTEND(int16, i16x8, i32x4, 4, true, a);
                         break;
-                    }
-
-                    case WASM_OP_ATOMIC_I64_STORE:
-                    case WASM_OP_ATOMIC_I64_STORE8:
-                    case WASM_OP_ATOMIC_I64_STORE16:
-                    case WASM_OP_ATOMIC_I64_STORE32:
+                    case SIMD_i32x4_extend_low_i16x8_u:
+                        DEF_OP_SIMD_EXTEND(uint16, i16x8, i32x4, 4, false, a);
+                        break;
+                    case SIMD_i32x4_extend_high_i16x8_u:
+                        DEF_OP_SIMD_EXTEND(uint16, i16x8, i32x4, 4, true, a);
+                        break;
+                    case SIMD_i32x4_shl:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_sll_epi32, 31);
+#else
+                        DEF_OP_SIMD_SHIFT(uint32, i32x4, 4, a << c);
+#endif
+                        break;
+                    case SIMD_i32x4_shr_s:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_sra_epi32, 31);
+#else
+                        DEF_OP_SIMD_SHIFT(int32, i32x4, 4, a >> c);
+#endif
+                        break;
+                    case SIMD_i32x4_shr_u:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_srl_epi32, 31);
+#else
+                        DEF_OP_SIMD_SHIFT(uint32, i32x4, 4, a >> c);
+#endif
+                        break;
+                    case SIMD_i32x4_add:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_add_epi32, u32,
+                                               vaddq_u32, uint32, i32x4, 4,
+                                               a + b);
+                        break;
+                    case SIMD_i32x4_sub:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_sub_epi32, u32,
+                                               vsubq_u32, uint32, i32x4, 4,
+                                               a - b);
+                        break;
+                    case SIMD_i32x4_mul:
+                        /* SSE2 has no 32-bit lane multiplication */
+#if defined(WASM_INTERP_SIMD_NEON)
+                        DEF_OP_SIMD_NEON(u32, u32, vmulq_u32);
+#else
+                        DEF_OP_SIMD_BINARY(uint32, i32x4, 4, a * b);
+#endif
+                        break;
+                    case SIMD_i32x4_min_s:
+                        DEF_OP_SIMD_BINARY(int32, i32x4, 4, a < b ? a : b);
+                        break;
+                    case SIMD_i32x4_min_u:
+                        DEF_OP_SIMD_BINARY(uint32, i32x4, 4, a < b ? a : b);
+                        break;
+                    case SIMD_i32x4_max_s:
+                        DEF_OP_SIMD_BINARY(int32, i32x4, 4, a > b ? a : b);
+                        break;
+                    case SIMD_i32x4_max_u:
+                        DEF_OP_SIMD_BINARY(uint32, i32x4, 4, a > b ? a : b);
+                        break;
+                    case SIMD_i32x4_dot_i16x8_s:
                     {
-                        uint64 sval;
-
-                        sval = (uint64)POP_I64();
-                        addr = POP_I32();
-
-                        if (opcode == WASM_OP_ATOMIC_I64_STORE8) {
-                            CHECK_MEMORY_OVERFLOW(1);
-                            CHECK_ATOMIC_MEMORY_ACCESS(1);
-                            shared_memory_lock(memory);
-                            *(uint8 *)maddr = (uint8)sval;
-                            shared_memory_unlock(memory);
-                        }
-                        else if (opcode == WASM_OP_ATOMIC_I64_STORE16) {
-                            CHECK_MEMORY_OVERFLOW(2);
-                            CHECK_ATOMIC_MEMORY_ACCESS(2);
-                            shared_memory_lock(memory);
-                            STORE_U16(maddr, (uint16)sval);
-                            shared_memory_unlock(memory);
-                        }
-                        else if (opcode == WASM_OP_ATOMIC_I64_STORE32) {
-                            CHECK_MEMORY_OVERFLOW(4);
-                            CHECK_ATOMIC_MEMORY_ACCESS(4);
-                            shared_memory_lock(memory);
-                            STORE_U32(maddr, (uint32)sval);
-                            shared_memory_unlock(memory);
-                        }
-                        else {
-                            CHECK_MEMORY_OVERFLOW(8);
-                            CHECK_ATOMIC_MEMORY_ACCESS(8);
-                            shared_memory_lock(memory);
-                            STORE_I64(maddr, sval);
-                            shared_memory_unlock(memory);
+                        V128 v2 = POP_V128(), v1 = POP_V128(), res;
+                        uint32 i;
+                        for (i = 0; i < 4; i++) {
+                            res.i32x4[i] = (int32)(
+                                (uint32)((int32)v1.i16x8[i * 2]
+                                         * v2.i16x8[i * 2])
+                                + (uint32)((int32)v1.i16x8[i * 2 + 1]
+                                           * v2.i16x8[i * 2 + 1]));
                         }
+                        PUSH_V128(res);
                         break;
                     }
+                    case SIMD_i32x4_extmul_low_i16x8_s:
+                        DEF_OP_SIMD_EXTMUL(int32, i16x8, i32x4, 4, false,
+                                           a * b);
+                        break;
+                    case SIMD_i32x4_extmul_high_i16x8_s:
+                        DEF_OP_SIMD_EXTMUL(int32, i16x8, i32x4, 4, true,
+                                           a * b);
+                        break;
+                    case SIMD_i32x4_extmul_low_i16x8_u:
+                        DEF_OP_SIMD_EXTMUL(uint16, i16x8, i32x4, 4, false,
+                                           (uint32)a * b);
+                        break;
+                    case SIMD_i32x4_extmul_high_i16x8_u:
+                        DEF_OP_SIMD_EXTMUL(uint16, i16x8, i32x4, 4, true,
+                                           (uint32)a * b);
+                        break;
 
-                    case WASM_OP_ATOMIC_RMW_I32_CMPXCHG:
-                    case WASM_OP_ATOMIC_RMW_I32_CMPXCHG8_U:
-                    case WASM_OP_ATOMIC_RMW_I32_CMPXCHG16_U:
-                    {
-                        uint32 readv, sval, expect;
-
-                        sval = POP_I32();
-                        expect = POP_I32();
-                        addr = POP_I32();
-
-                        if (opcode == WASM_OP_ATOMIC_RMW_I32_CMPXCHG8_U) {
-                            CHECK_MEMORY_OVERFLOW(1);
-                            CHECK_ATOMIC_MEMORY_ACCESS(1);
+                    /* i64x2 operation */
+                    case SIMD_i64x2_abs:
+                        DEF_OP_SIMD_UNARY(int64, i64x2, 2,
+                                          a < 0 ? 0 - (uint64)a : (uint64)a);
+                        break;
+                    case SIMD_i64x2_neg:
+                        DEF_OP_SIMD_UNARY(uint64, i64x2, 2, 0 - a);
+                        break;
+                    case SIMD_i64x2_all_true:
+                        DEF_OP_SIMD_ALL_TRUE(i64x2, 2);
+                        break;
+                    case SIMD_i64x2_bitmask:
+                        DEF_OP_SIMD_BITMASK(i64x2, 2);
+                        break;
+                    case SIMD_i64x2_extend_low_i32x4_s:
+                        DEF_OP_SIMD_EXTEND(int32, i32x4, i64x2, 2, false, a);
+                        break;
+                    case SIMD_i64x2_extend_high_i32x4_s:
+                        DEF_OP_SIMD_EXTEND(int32, i32x4, i64x2, 2, true, a);
+                        break;
+                    case SIMD_i64x2_extend_low_i32x4_u:
+                        DEF_OP_SIMD_EXTEND(uint32, i32x4, i64x2, 2, false, a);
+                        break;
+                    case SIMD_i64x2_extend_high_i32x4_u:
+                        DEF_OP_SIMD_EXTEND(uint32, i32x4, i64x2, 2, true, a);
+                        break;
+                    case SIMD_i64x2_shl:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_sll_epi64, 63);
+#else
+                        DEF_OP_SIMD_SHIFT(uint64, i64x2, 2, a << c);
+#endif
+                        break;
+                    case SIMD_i64x2_shr_s:
+                        DEF_OP_SIMD_SHIFT(int64, i64x2, 2, a >> c);
+                        break;
+                    case SIMD_i64x2_shr_u:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2_SHIFT(_mm_srl_epi64, 63);
+#else
+                        DEF_OP_SIMD_SHIFT(uint64, i64x2, 2, a >> c);
+#endif
+                        break;
+                    case SIMD_i64x2_add:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_add_epi64, u64,
+                                               vaddq_u64, uint64, i64x2, 2,
+                                               a + b);
+                        break;
+                    case SIMD_i64x2_sub:
+                        DEF_OP_SIMD_BINARY_OPT(si128, _mm_sub_epi64, u64,
+                                               vsubq_u64, uint64, i64x2, 2,
+                                               a - b);
+                        break;
+                    case SIMD_i64x2_mul:
+                        DEF_OP_SIMD_BINARY(uint64, i64x2, 2, a * b);
+                        break;
+                    case SIMD_i64x2_eq:
+                        DEF_OP_SIMD_COMPARE(int64, i64x2, i64x2, 2, a == b);
+                        break;
+                    case SIMD_i64x2_ne:
+                        DEF_OP_SIMD_COMPARE(int64, i64x2, i64x2, 2, a != b);
+                        break;
+                    case SIMD_i64x2_lt_s:
+                        DEF_OP_SIMD_COMPARE(int64, i64x2, i64x2, 2, a < b);
+                        break;
+                    case SIMD_i64x2_gt_s:
+                        DEF_OP_SIMD_COMPARE(int64, i64x2, i64x2, 2, a > b);
+                        break;
+                    case SIMD_i64x2_le_s:
+                        DEF_OP_SIMD_COMPARE(int64, i64x2, i64x2, 2, a <= b);
+                        break;
+                    case SIMD_i64x2_ge_s:
+                        DEF_OP_SIMD_COMPARE(int64, i64x2, i64x2, 2, a >= b);
+                        break;
+                    case SIMD_i64x2_extmul_low_i32x4_s:
+                        DEF_OP_SIMD_EXTMUL(int64, i32x4, i64x2, 2, false,
+                                           a * b);
+                        break;
+                    case SIMD_i64x2_extmul_high_i32x4_s:
+                        DEF_OP_SIMD_EXTMUL(int64, i32x4, i64x2, 2, true,
+                                           a * b);
+                        break;
+                    case SIMD_i64x2_extmul_low_i32x4_u:
+                        DEF_OP_SIMD_EXTMUL(uint32, i32x4, i64x2, 2, false,
+                                           (uint64)a * b);
+                        break;
+                    case SIMD_i64x2_extmul_high_i32x4_u:
+                        DEF_OP_SIMD_EXTMUL(uint32, i32x4, i64x2, 2, true,
+                                           (uint64)a * b);
+                        break;
 
-                            expect = (uint8)expect;
-                            shared_memory_lock(memory);
-                            readv = (uint32)(*(uint8 *)maddr);
-                            if (readv == expect)
-                                *(uint8 *)maddr = (uint8)(sval);
-                            shared_memory_unlock(memory);
-                        }
-                        else if (opcode == WASM_OP_ATOMIC_RMW_I32_CMPXCHG16_U) {
-                            CHECK_MEMORY_OVERFLOW(2);
-                            CHECK_ATOMIC_MEMORY_ACCESS(2);
+                    /* f32x4 operation */
+                    case SIMD_f32x4_abs:
+                        DEF_OP_SIMD_UNARY(uint32, i32x4, 4, a & 0x7FFFFFFF);
+                        break;
+                    case SIMD_f32x4_neg:
+                        DEF_OP_SIMD_UNARY(uint32, i32x4, 4, a ^ 0x80000000);
+                        break;
+                    case SIMD_f32x4_sqrt:
+                        DEF_OP_SIMD_UNARY_OPT(ps, _mm_sqrt_ps, f32, vsqrtq_f32,
+                                              float32, f32x4, 4, sqrtf(a));
+                        break;
+                    case SIMD_f32x4_add:
+                        DEF_OP_SIMD_BINARY_OPT(ps, _mm_add_ps, f32, vaddq_f32,
+                                               float32, f32x4, 4, a + b);
+                        break;
+                    case SIMD_f32x4_sub:
+                        DEF_OP_SIMD_BINARY_OPT(ps, _mm_sub_ps, f32, vsubq_f32,
+                                               float32, f32x4, 4, a - b);
+                        break;
+                    case SIMD_f32x4_mul:
+                        DEF_OP_SIMD_BINARY_OPT(ps, _mm_mul_ps, f32, vmulq_f32,
+                                               float32, f32x4, 4, a * b);
+                        break;
+                    case SIMD_f32x4_div:
+                        DEF_OP_SIMD_BINARY_OPT(ps, _mm_div_ps, f32, vdivq_f32,
+                                               float32, f32x4, 4, a / b);
+                        break;
+                    case SIMD_f32x4_min:
+                        DEF_OP_SIMD_BINARY(float32, f32x4, 4, f32_min(a, b));
+                        break;
+                    case SIMD_f32x4_max:
+                        DEF_OP_SIMD_BINARY(float32, f32x4, 4, f32_max(a, b));
+                        break;
+                    case SIMD_f32x4_pmin:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2(ps, sse2_f32x4_pmin);
+#else
+                        DEF_OP_SIMD_BINARY(float32, f32x4, 4, b < a ? b : a);
+#endif
+                        break;
+                    case SIMD_f32x4_pmax:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2(ps, sse2_f32x4_pmax);
+#else
+                        DEF_OP_SIMD_BINARY(float32, f32x4, 4, a < b ? b : a);
+#endif
+                        break;
 
-                            expect = (uint16)expect;
-                            shared_memory_lock(memory);
-                            readv = (uint32)LOAD_U16(maddr);
-                            if (readv == expect)
-                                STORE_U16(maddr, (uint16)(sval));
-                            shared_memory_unlock(memory);
-                        }
-                        else {
-                            CHECK_MEMORY_OVERFLOW(4);
-                            CHECK_ATOMIC_MEMORY_ACCESS(4);
+                    /* f64x2 operation */
+                    case SIMD_f64x2_abs:
+                        DEF_OP_SIMD_UNARY(uint64, i64x2, 2,
+                                          a & 0x7FFFFFFFFFFFFFFFULL);
+                        break;
+                    case SIMD_f64x2_neg:
+                        DEF_OP_SIMD_UNARY(uint64, i64x2, 2,
+                                          a ^ 0x8000000000000000ULL);
+                        break;
+                    case SIMD_f64x2_sqrt:
+                        DEF_OP_SIMD_UNARY_OPT(pd, _mm_sqrt_pd, f64, vsqrtq_f64,
+                                              float64, f64x2, 2, sqrt(a));
+                        break;
+                    case SIMD_f64x2_add:
+                        DEF_OP_SIMD_BINARY_OPT(pd, _mm_add_pd, f64, vaddq_f64,
+                                               float64, f64x2, 2, a + b);
+                        break;
+                    case SIMD_f64x2_sub:
+                        DEF_OP_SIMD_BINARY_OPT(pd, _mm_sub_pd, f64, vsubq_f64,
+                                               float64, f64x2, 2, a - b);
+                        break;
+                    case SIMD_f64x2_mul:
+                        DEF_OP_SIMD_BINARY_OPT(pd, _mm_mul_pd, f64, vmulq_f64,
+                                               float64, f64x2, 2, a * b);
+                        break;
+                    case SIMD_f64x2_div:
+                        DEF_OP_SIMD_BINARY_OPT(pd, _mm_div_pd, f64, vdivq_f64,
+                                               float64, f64x2, 2, a / b);
+                        break;
+                    case SIMD_f64x2_min:
+                        DEF_OP_SIMD_BINARY(float64, f64x2, 2, f64_min(a, b));
+                        break;
+                    case SIMD_f64x2_max:
+                        DEF_OP_SIMD_BINARY(float64, f64x2, 2, f64_max(a, b));
+                        break;
+                    case SIMD_f64x2_pmin:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2(pd, sse2_f64x2_pmin);
+#else
+                        DEF_OP_SIMD_BINARY(float64, f64x2, 2, b < a ? b : a);
+#endif
+                        break;
+                    case SIMD_f64x2_pmax:
+#if defined(WASM_INTERP_SIMD_SSE2)
+                        DEF_OP_SIMD_SSE2(pd, sse2_f64x2_pmax);
+#else
+                        DEF_OP_SIMD_BINARY(float64, f64x2, 2, a < b ? b : a);
+#endif
+                        break;
 
-                            shared_memory_lock(memory);
-                            readv = LOAD_I32(maddr);
-                            if (readv == expect)
-                                STORE_U32(maddr, sval);
-                            shared_memory_unlock(memory);
-                        }
-                        PUSH_I32(readv);
+                    /* conversion operation */
+                    case SIMD_i32x4_trunc_sat_f32x4_s:
+                    {
+                        V128 v1 = POP_V128(), res;
+                        uint32 i;
+                        for (i = 0; i < 4; i++)
+                            res.i32x4[i] = simd_f32_to_i32_sat(v1.f32x4[i]);
+                        PUSH_V128(res);
                         break;
                     }
-                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG:
-                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG8_U:
-                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG16_U:
-                    case WASM_OP_ATOMIC_RMW_I64_CMPXCHG32_U:
+                    case SIMD_i32x4_trunc_sat_f32x4_u:
                     {
-                        uint64 readv, sval, expect;
-
-                        sval = (uint64)POP_I64();
-                        expect = (uint64)POP_I64();
-                        addr = POP_I32();
-
-                        if (opcode == WASM_OP_ATOMIC_RMW_I64_CMPXCHG8_U) {
-                            CHECK_MEMORY_OVERFLOW(1);
-                            CHECK_ATOMIC_MEMORY_ACCESS(1);
-
-                            expect = (uint8)expect;
-                            shared_memory_lock(memory);
-                            readv = (uint64)(*(uint8 *)maddr);
-                            if (readv == expect)
-                                *(uint8 *)maddr = (uint8)(sval);
-                            shared_memory_unlock(memory);
-                        }
-                        else if (opcode == WASM_OP_ATOMIC_RMW_I64_CMPXCHG16_U) {
-                            CHECK_MEMORY_OVERFLOW(2);
-                            CHECK_ATOMIC_MEMORY_ACCESS(2);
-
-                            expect = (uint16)expect;
-                            shared_memory_lock(memory);
-                            readv = (uint64)LOAD_U16(maddr);
-                            if (readv == expect)
-                                STORE_U16(maddr, (uint16)(sval));
-                            shared_memory_unlock(memory);
-                        }
-                        else if (opcode == WASM_OP_ATOMIC_RMW_I64_CMPXCHG32_U) {
-                            CHECK_MEMORY_OVERFLOW(4);
-                            CHECK_ATOMIC_MEMORY_ACCESS(4);
-
-                            expect = (uint32)expect;
-                            shared_memory_lock(memory);
-                            readv = (uint64)LOAD_U32(maddr);
-                            if (readv == expect)
-                                STORE_U32(maddr, (uint32)(sval));
-                            shared_memory_unlock(memory);
-                        }
-                        else {
-                            CHECK_MEMORY_OVERFLOW(8);
-                            CHECK_ATOMIC_MEMORY_ACCESS(8);
-
-                            shared_memory_lock(memory);
-                            readv = (uint64)LOAD_I64(maddr);
-                            if (readv == expect)
-                                STORE_I64(maddr, sval);
-                            shared_memory_unlock(memory);
+                        V128 v1 = POP_V128(), res;
+                        uint32 i;
+                        for (i = 0; i < 4; i++)
+                            res.i32x4[i] =
+                                (int32)simd_f32_to_u32_sat(v1.f32x4[i]);
+                        PUSH_V128(res);
+                        break;
+                    }
+                    case SIMD_f32x4_convert_i32x4_s:
+                        DEF_OP_SIMD_EXTEND(int32, i32x4, f32x4, 4, false,
+                                           (float32)a);
+                        break;
+                    case SIMD_f32x4_convert_i32x4_u:
+                        DEF_OP_SIMD_EXTEND(uint32, i32x4, f32x4, 4, false,
+                                           (float32)a);
+                        break;
+                    case SIMD_i32x4_trunc_sat_f64x2_s_zero:
+                    case SIMD_i32x4_trunc_sat_f64x2_u_zero:
+                    {
+                        V128 v1 = POP_V128(), res;
+                        uint32 i;
+                        for (i = 0; i < 2; i++) {
+                            res.i32x4[i] =
+                                opcode == SIMD_i32x4_trunc_sat_f64x2_s_zero
+                                    ? simd_f64_to_i32_sat(v1.f64x2[i])
+                                    : (int32)simd_f64_to_u32_sat(
+                                        v1.f64x2[i]);
                         }
-                        PUSH_I64(readv);
+                        res.i32x4[2] = res.i32x4[3] = 0;
+                        PUSH_V128(res);
                         break;
                     }
+                    case SIMD_f64x2_convert_low_i32x4_s:
+                        DEF_OP_SIMD_EXTEND(int32, i32x4, f64x2, 2, false,
+                                           (float64)a);
+                        break;
+                    case SIMD_f64x2_convert_low_i32x4_u:
+                        DEF_OP_SIMD_EXTEND(uint32, i32x4, f64x2, 2, false,
+                                           (float64)a);
+                        break;
 
-                        DEF_ATOMIC_RMW_OPCODE(ADD, +);
-                        DEF_ATOMIC_RMW_OPCODE(SUB, -);
-                        DEF_ATOMIC_RMW_OPCODE(AND, &);
-                        DEF_ATOMIC_RMW_OPCODE(OR, |);
-                        DEF_ATOMIC_RMW_OPCODE(XOR, ^);
-                        /* xchg, ignore the read value, and store the given
-                          value: readv * 0 + sval */
-                        DEF_ATOMIC_RMW_OPCODE(XCHG, *0 +);
+                    default:
+                        wasm_set_exception(module, "unsupported opcode");
+                        goto got_exception;
                 }
-
                 HANDLE_OP_END();
             }
-#endif
+#endif /* end of WASM_ENABLE_SIMD != 0 */
 
             HANDLE_OP(WASM_OP_IMPDEP)
             {
@@ -5758,6 +9218,11 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         uint32 *lp_base = NULL, *lp = NULL;
         int i;
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        if (!wasm_ensure_func_prepared(module, cur_func)) {
+            goto got_exception;
+        }
+#endif
         if (cur_func->param_cell_num > 0
             && !(lp_base = lp = wasm_runtime_malloc(cur_func->param_cell_num
                                                     * sizeof(uint32)))) {
@@ -5772,6 +9237,14 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                                     2 * (cur_func->param_count - i - 1)));
                 lp += 2;
             }
+#if WASM_ENABLE_SIMD != 0
+            else if (cur_func->param_types[i] == VALUE_TYPE_V128) {
+                PUT_V128_TO_ADDR(
+                    lp, GET_OPERAND(V128, V128,
+                                    2 * (cur_func->param_count - i - 1)));
+                lp += 4;
+            }
+#endif
             else {
                 *lp = GET_OPERAND(uint32, I32,
                                   (2 * (cur_func->param_count - i - 1)));
@@ -5798,6 +9271,11 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         WASMInterpFrame *outs_area = wasm_exec_env_wasm_stack_top(exec_env);
         int i;
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        if (!wasm_ensure_func_prepared(module, cur_func)) {
+            goto got_exception;
+        }
+#endif
 #if WASM_ENABLE_MULTI_MODULE != 0
         if (cur_func->is_import_func) {
             outs_area->lp = outs_area->operand
@@ -5826,6 +9304,15 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                                 2 * (cur_func->param_count - i - 1)));
                 outs_area->lp += 2;
             }
+#if WASM_ENABLE_SIMD != 0
+            else if (cur_func->param_types[i] == VALUE_TYPE_V128) {
+                PUT_V128_TO_ADDR(
+                    outs_area->lp,
+                    GET_OPERAND(V128, V128,
+                                2 * (cur_func->param_count - i - 1)));
+                outs_area->lp += 4;
+            }
+#endif
 #if WASM_ENABLE_GC != 0
             else if (wasm_is_type_reftype(cur_func->param_types[i])) {
                 PUT_REF_TO_ADDR(
@@ -5868,6 +9355,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
     call_func_from_entry:
     {
         if (cur_func->is_import_func) {
+            SYNC_FUEL();
 #if WASM_ENABLE_MULTI_MODULE != 0
             if (cur_func->import_func_inst) {
                 wasm_interp_call_func_import(module, exec_env, cur_func,
@@ -5879,6 +9367,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
                 wasm_interp_call_func_native(module, exec_env, cur_func,
                                              prev_frame);
             }
+            UPDATE_FUEL();
 
 #if WASM_ENABLE_TAIL_CALL != 0 || WASM_ENABLE_GC != 0
             if (is_return_call) {
@@ -5990,9 +9479,11 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         FREE_FRAME(exec_env, frame);
         wasm_exec_env_set_cur_frame(exec_env, (WASMRuntimeFrame *)prev_frame);
 
-        if (!prev_frame->ip)
+        if (!prev_frame->ip) {
             /* Called from native. */
+            SYNC_FUEL();
             return;
+        }
 
         RECOVER_CONTEXT(prev_frame);
 #if WASM_ENABLE_GC != 0
@@ -6001,6 +9492,22 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
         HANDLE_OP_END();
     }
 
+#if WASM_INTERP_TAIL_DISPATCH != 0
+    tail_dispatch:
+    {
+        WASMInterpTailHandler tail_handler =
+            *(WASMInterpTailHandler *)frame_ip;
+
+        /* The tail handlers charge exec_env->fuel */
+        SYNC_FUEL();
+        frame_ip = tail_handler(frame_ip + sizeof(void *), frame_lp,
+                                memory ? memory->memory_data : NULL,
+                                get_tail_memory_size(), &tail_ctx);
+        UPDATE_FUEL();
+        goto *handle_table[tail_ctx.opcode];
+    }
+#endif
+
         (void)frame_ip_end;
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -6018,6 +9525,7 @@ wasm_interp_call_func_bytecode(WASMModuleInstance *module,
 
     got_exception:
         SYNC_ALL_TO_FRAME();
+        SYNC_FUEL();
         return;
 
 #if WASM_ENABLE_LABELS_AS_VALUES == 0
@@ -6113,6 +9621,12 @@ wasm_interp_call_wasm(WASMModuleInstance *module_inst, WASMExecEnv *exec_env,
     }
     argc = function->param_cell_num;
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    if (!wasm_ensure_func_prepared(module_inst, function)) {
+        return;
+    }
+#endif
+
 #if defined(OS_ENABLE_HW_BOUND_CHECK) && WASM_DISABLE_STACK_HW_BOUND_CHECK == 0
     /*
      * wasm_runtime_detect_native_stack_overflow is done by
@@ -26,6 +26,9 @@
 #if WASM_ENABLE_JIT != 0
 #include "../compilation/aot_llvm.h"
 #endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+#include "wasm_fast_interp_cache.h"
+#endif
 
 #ifndef TRACE_WASM_LOADER
 #define TRACE_WASM_LOADER 0
@@ -335,7 +338,8 @@ is_value_type(uint8 type)
         || (type == VALUE_TYPE_FUNCREF || type == VALUE_TYPE_EXTERNREF)
 #endif
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
         || type == VALUE_TYPE_V128 /* 0x7B */
 #endif
 #endif
@@ -359,7 +363,8 @@ is_byte_a_type(uint8 type)
 }
 
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
 static V128
 read_i8x16(uint8 *p_buf, char *error_buf, uint32 error_buf_size)
 {
@@ -372,7 +377,8 @@ read_i8x16(uint8 *p_buf, char *error_buf, uint32 error_buf_size)
 
     return result;
 }
-#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
+#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+          || (WASM_ENABLE_FAST_INTERP != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 static void *
@@ -691,7 +697,7 @@ load_init_expr(WASMModule *module, const uint8 **p_buf, const uint8 *buf_end,
     uint8 flag, *p_float;
     uint32 i;
     ConstExprContext const_expr_ctx = { 0 };
-    WASMValue cur_value;
+    WASMValue cur_value = { 0 };
 #if WASM_ENABLE_GC != 0
     uint32 opcode1, type_idx;
     uint8 opcode;
@@ -760,7 +766,8 @@ load_init_expr(WASMModule *module, const uint8 **p_buf, const uint8 *buf_end,
                     goto fail;
                 break;
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
             /* v128.const */
             case INIT_EXPR_TYPE_V128_CONST:
             {
@@ -789,7 +796,8 @@ load_init_expr(WASMModule *module, const uint8 **p_buf, const uint8 *buf_end,
 #endif
                 break;
             }
-#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
+#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+          || (WASM_ENABLE_FAST_INTERP != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_REF_TYPES != 0 || WASM_ENABLE_GC != 0
@@ -2608,6 +2616,13 @@ load_function_import(const uint8 **p_buf, const uint8 *buf_end,
     function->import_module = is_native_symbol ? NULL : sub_module;
     function->import_func_linked = is_native_symbol ? NULL : linked_func;
 #endif
+
+    if (is_native_symbol && !linked_call_conv_raw
+        && !wasm_runtime_create_native_call_desc(
+            declare_func_type, linked_signature, &function->call_desc)) {
+        set_error_buf(error_buf, error_buf_size, "allocate memory failed");
+        return false;
+    }
     return true;
 fail:
     return false;
@@ -5434,6 +5449,21 @@ init_llvm_jit_functions_stage1(WASMModule *module, char *error_buf,
     option.enable_memory_profiling = true;
     option.enable_stack_estimation = true;
 #endif
+#if WASM_ENABLE_FUEL_METERING != 0
+    option.enable_fuel_metering = true;
+#endif
+#if WASM_ENABLE_AOT_SAFEPOINT != 0 && defined(OS_ENABLE_HW_BOUND_CHECK)
+    option.enable_safepoint_page = true;
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+    option.enable_gc_write_barrier = true;
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    option.enable_gc_pre_write_barrier = true;
+#endif
+#if WASM_ENABLE_SHARED_HEAP != 0
+    option.enable_shared_heap = true;
+#endif
 
     module->comp_ctx = aot_create_comp_context(module->comp_data, &option);
     if (!module->comp_ctx) {
@@ -6125,12 +6155,44 @@ load_from_sections(WASMModule *module, WASMSection *sections,
     handle_table = wasm_interp_get_handle_table();
 #endif
 
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    if (module->fast_interp_cache && wasm_fast_interp_cache_attach(module)) {
+        LOG_VERBOSE("Map prepared code of functions from cache file.\n");
+    }
+#endif
+
     for (i = 0; i < module->function_count; i++) {
         WASMFunction *func = module->functions[i];
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+        if (module->fast_interp_cache) {
+            /* The function body was validated and prepared when the
+               cache file was created, and has been mapped from it */
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+            func->prepare_state = WASM_FUNC_STATE_PREPARED;
+#endif
+        }
+        else
+#endif
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        if (module->is_lazy_func_validation) {
+            /* Only the function boundaries are checked, the function body
+               is validated and prepared when the function is called for
+               the first time, see wasm_loader_prepare_func_lazily */
+            func->prepare_state = WASM_FUNC_STATE_UNPREPARED;
+        }
+        else {
+            if (!wasm_loader_prepare_bytecode(module, func, i, error_buf,
+                                              error_buf_size)) {
+                return false;
+            }
+            func->prepare_state = WASM_FUNC_STATE_PREPARED;
+        }
+#else
         if (!wasm_loader_prepare_bytecode(module, func, i, error_buf,
                                           error_buf_size)) {
             return false;
         }
+#endif
 
         if (i == module->function_count - 1
             && func->code + func->code_size != buf_code_end) {
@@ -6140,6 +6202,12 @@ load_from_sections(WASMModule *module, WASMSection *sections,
         }
     }
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    /* The memory.grow opcode may be in the functions not validated yet */
+    if (module->is_lazy_func_validation)
+        module->possible_memory_grow = true;
+#endif
+
     if (!module->possible_memory_grow) {
         WASMMemoryImport *memory_import;
         WASMMemory *memory;
@@ -6318,9 +6386,26 @@ create_module(char *name, char *error_buf, uint32 error_buf_size)
     }
 #endif
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    if (os_mutex_init(&module->lazy_prepare_lock) != 0) {
+        set_error_buf(error_buf, error_buf_size,
+                      "init lazy prepare lock failed");
+        goto fail4;
+    }
+#endif
+
     (void)ret;
     return module;
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+fail4:
+#if WASM_ENABLE_DEBUG_INTERP != 0                         \
+    || (WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT != 0 \
+        && WASM_ENABLE_LAZY_JIT != 0)
+    os_mutex_destroy(&module->instance_list_lock);
+#endif
+#endif
+
 #if WASM_ENABLE_DEBUG_INTERP != 0                    \
     || (WASM_ENABLE_FAST_JIT != 0 && WASM_ENABLE_JIT \
         && WASM_ENABLE_LAZY_JIT != 0)
@@ -6692,6 +6777,22 @@ check_wasi_abi_compatibility(const WASMModule *module,
 }
 #endif
 
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+static void
+free_code_relocs(WASMModule *module)
+{
+    uint32 i;
+
+    for (i = 0; i < module->function_count; i++) {
+        if (module->functions[i] && module->functions[i]->code_relocs) {
+            wasm_runtime_free(module->functions[i]->code_relocs);
+            module->functions[i]->code_relocs = NULL;
+            module->functions[i]->code_reloc_count = 0;
+        }
+    }
+}
+#endif
+
 WASMModule *
 wasm_loader_load(uint8 *buf, uint32 size,
 #if WASM_ENABLE_MULTI_MODULE != 0
@@ -6700,6 +6801,11 @@ wasm_loader_load(uint8 *buf, uint32 size,
                  const LoadArgs *args, char *error_buf, uint32 error_buf_size)
 {
     WASMModule *module = create_module(args->name, error_buf, error_buf_size);
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    const char *cache_dir = args->fast_interp_cache_dir;
+    uint8 *binary_copy = NULL;
+    uint64 binary_hash = 0;
+#endif
     if (!module) {
         return NULL;
     }
@@ -6710,11 +6816,53 @@ wasm_loader_load(uint8 *buf, uint32 size,
     module->load_size = size;
 #endif
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    module->is_lazy_func_validation = args->lazy_func_validation;
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    /* The function bodies aren't prepared at load time */
+    if (module->is_lazy_func_validation)
+        cache_dir = NULL;
+#endif
+#endif
+
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    if (cache_dir) {
+        binary_hash = wasm_fast_interp_cache_hash(buf, size);
+        module->fast_interp_cache =
+            wasm_fast_interp_cache_open(cache_dir, binary_hash, buf, size);
+        /* Record the relocations in case the cache file doesn't match, and
+           keep the binary to save since the loader modifies it */
+        module->record_code_relocs = true;
+        if (!module->fast_interp_cache
+            && (binary_copy = wasm_runtime_malloc(size ? size : 1))) {
+            bh_memcpy_s(binary_copy, size, buf, size);
+        }
+    }
+#endif
+
     if (!load(buf, size, module, args->wasm_binary_freeable, error_buf,
               error_buf_size)) {
         goto fail;
     }
 
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    if (cache_dir) {
+        if (binary_copy
+            && !wasm_fast_interp_cache_save(cache_dir, binary_hash,
+                                            binary_copy, size, module)) {
+            LOG_WARNING("warning: failed to save fast interpreter cache "
+                        "file to %s",
+                        cache_dir);
+        }
+        module->record_code_relocs = false;
+        free_code_relocs(module);
+    }
+    if (binary_copy) {
+        wasm_runtime_free(binary_copy);
+        binary_copy = NULL;
+    }
+#endif
+
 #if WASM_ENABLE_LIBC_WASI != 0
     /* Check the WASI application ABI */
     if (!check_wasi_abi_compatibility(module,
@@ -6730,6 +6878,10 @@ wasm_loader_load(uint8 *buf, uint32 size,
     return module;
 
 fail:
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    if (binary_copy)
+        wasm_runtime_free(binary_copy);
+#endif
     wasm_loader_unload(module);
     return NULL;
 }
@@ -6772,8 +6924,21 @@ wasm_loader_unload(WASMModule *module)
     }
 #endif
 
-    if (module->imports)
+    if (module->imports) {
+        for (i = 0; i < module->import_function_count; i++) {
+            if (module->import_functions[i].u.function.call_desc)
+                wasm_runtime_destroy_native_call_desc(
+                    module->import_functions[i].u.function.call_desc);
+        }
         wasm_runtime_free(module->imports);
+    }
+
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    /* Don't free the code and consts mapped from the cache file */
+    wasm_fast_interp_cache_detach(module);
+    if (module->functions)
+        free_code_relocs(module);
+#endif
 
     if (module->functions) {
         for (i = 0; i < module->function_count; i++) {
@@ -6786,6 +6951,10 @@ wasm_loader_unload(WASMModule *module)
                 if (module->functions[i]->consts)
                     wasm_runtime_free(module->functions[i]->consts);
 #endif
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+                if (module->functions[i]->prepare_error)
+                    wasm_runtime_free(module->functions[i]->prepare_error);
+#endif
 #if WASM_ENABLE_FAST_JIT != 0
                 if (module->functions[i]->fast_jit_jitted_code) {
                     jit_code_cache_free(
@@ -6948,6 +7117,14 @@ wasm_loader_unload(WASMModule *module)
     os_mutex_destroy(&module->instance_list_lock);
 #endif
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    if (module->is_lazy_func_validation) {
+        LOG_VERBOSE("Prepared %" PRIu32 " of %" PRIu32 " functions lazily",
+                    module->prepared_func_count, module->function_count);
+    }
+    os_mutex_destroy(&module->lazy_prepare_lock);
+#endif
+
 #if WASM_ENABLE_LOAD_CUSTOM_SECTION != 0
     wasm_runtime_destroy_custom_sections(module->custom_section_list);
 #endif
@@ -7669,7 +7846,8 @@ wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
             }
 
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
             case WASM_OP_SIMD_PREFIX:
             {
                 uint32 opcode1;
@@ -7762,7 +7940,8 @@ wasm_loader_find_block_addr(WASMExecEnv *exec_env, BlockAddr *block_addr_cache,
                 }
                 break;
             }
-#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
+#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+          || (WASM_ENABLE_FAST_INTERP != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -7942,6 +8121,23 @@ typedef struct WASMLoaderContext {
      * than the final code_compiled_size, we record the peak size to ensure
      * there will not be invalid memory access during second traverse */
     uint32 code_compiled_peak_size;
+
+    /* the i32 comparison emitted last, which may be fused with the
+       br_if or if following it */
+    WASMFusibleCmp fusible_cmp;
+#if WASM_ENABLE_FUEL_METERING != 0
+    /* instruction count of the region since the last control instruction
+       which ends a region, and the cost charged by the EXT_OP_CHARGE_FUEL
+       emitted before the current opcode, 0 if it isn't emitted */
+    int32 fuel_region_cost;
+    uint32 fuel_charged_cost;
+#endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    /* offsets of the pointer slots emitted during second traverse */
+    bool record_code_relocs;
+    uint32 *code_relocs;
+    uint32 code_reloc_count;
+#endif
 #endif
 } WASMLoaderContext;
 
@@ -8170,6 +8366,10 @@ wasm_loader_ctx_destroy(WASMLoaderContext *ctx)
             wasm_runtime_free(ctx->frame_offset_bottom);
         if (ctx->const_buf)
             wasm_runtime_free(ctx->const_buf);
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+        if (ctx->code_relocs)
+            wasm_runtime_free(ctx->code_relocs);
+#endif
 #endif
         wasm_runtime_free(ctx);
     }
@@ -8766,6 +8966,7 @@ fail:
         wasm_loader_emit_backspace(loader_ctx, sizeof(void *)); \
         LOG_OP("\ndelete last op\n");                           \
     } while (0)
+#define LABEL_SIZE sizeof(void *)
 #else /* else of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 #if UINTPTR_MAX == UINT64_MAX
 #define emit_label(opcode)                                                     \
@@ -8790,6 +8991,7 @@ fail:
         wasm_loader_emit_backspace(loader_ctx, sizeof(int32)); \
         LOG_OP("\ndelete last op\n");                          \
     } while (0)
+#define LABEL_SIZE sizeof(int32)
 #endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 #else  /* else of WASM_ENABLE_LABELS_AS_VALUES */
 #define emit_label(opcode)                          \
@@ -8802,6 +9004,12 @@ fail:
         wasm_loader_emit_backspace(loader_ctx, sizeof(uint8)); \
         LOG_OP("\ndelete last op\n");                          \
     } while (0)
+#if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
+#define LABEL_SIZE sizeof(uint8)
+#else
+/* the opcode is followed by a padding byte */
+#define LABEL_SIZE (sizeof(uint8) * 2)
+#endif
 #endif /* end of WASM_ENABLE_LABELS_AS_VALUES */
 
 #define emit_empty_label_addr_and_frame_ip(type)                             \
@@ -8907,6 +9115,13 @@ fail:
         LOG_OP("%f\t", value);                      \
     } while (0)
 
+#define emit_v128(ctx, value)                                      \
+    do {                                                           \
+        wasm_loader_emit_const(ctx, &(value).i64x2[0], false);     \
+        wasm_loader_emit_const(ctx, &(value).i64x2[1], false);     \
+        LOG_OP("%llx %llx\t", (value).i64x2[0], (value).i64x2[1]); \
+    } while (0)
+
 static bool
 wasm_loader_ctx_reinit(WASMLoaderContext *ctx)
 {
@@ -8916,6 +9131,19 @@ wasm_loader_ctx_reinit(WASMLoaderContext *ctx)
     ctx->p_code_compiled_end =
         ctx->p_code_compiled + ctx->code_compiled_peak_size;
 
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    if (ctx->record_code_relocs) {
+        /* the pointer slots never overlap, so the peak size is enough */
+        uint64 reloc_size = sizeof(uint32)
+                            * ((uint64)ctx->code_compiled_peak_size
+                                   / sizeof(void *)
+                               + 1);
+        if (!(ctx->code_relocs = loader_malloc(reloc_size, NULL, 0)))
+            return false;
+        ctx->code_reloc_count = 0;
+    }
+#endif
+
     /* clean up frame ref */
     memset(ctx->frame_ref_bottom, 0, ctx->frame_ref_size);
     ctx->frame_ref = ctx->frame_ref_bottom;
@@ -9039,6 +9267,14 @@ wasm_loader_emit_ptr(WASMLoaderContext *ctx, void *value)
     if (ctx->p_code_compiled) {
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS == 0
         bh_assert(((uintptr_t)ctx->p_code_compiled & 1) == 0);
+#endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+        if (ctx->code_relocs) {
+            uint8 *code_start =
+                ctx->p_code_compiled_end - ctx->code_compiled_peak_size;
+            ctx->code_relocs[ctx->code_reloc_count++] =
+                (uint32)(ctx->p_code_compiled - code_start);
+        }
 #endif
         STORE_PTR(ctx->p_code_compiled, value);
         ctx->p_code_compiled += sizeof(void *);
@@ -9061,6 +9297,20 @@ wasm_loader_emit_backspace(WASMLoaderContext *ctx, uint32 size)
             ctx->p_code_compiled--;
             bh_assert(((uintptr_t)ctx->p_code_compiled & 1) == 0);
         }
+#endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+        if (ctx->code_relocs) {
+            /* drop the pointer slots which will be overwritten, note that
+               the code may be rewound into the middle of a slot */
+            uint8 *code_start =
+                ctx->p_code_compiled_end - ctx->code_compiled_peak_size;
+            uint32 offset = (uint32)(ctx->p_code_compiled - code_start);
+            while (ctx->code_reloc_count > 0
+                   && ctx->code_relocs[ctx->code_reloc_count - 1]
+                              + sizeof(void *)
+                          > offset)
+                ctx->code_reloc_count--;
+        }
 #endif
     }
     else {
@@ -9074,6 +9324,93 @@ wasm_loader_emit_backspace(WASMLoaderContext *ctx, uint32 size)
     }
 }
 
+static uint32
+wasm_loader_get_code_offset(WASMLoaderContext *ctx)
+{
+    if (ctx->p_code_compiled)
+        return (uint32)(ctx->p_code_compiled
+                        - (ctx->p_code_compiled_end
+                           - ctx->code_compiled_peak_size));
+    return ctx->code_compiled_size;
+}
+
+/* Fuse the i32 comparison emitted last with the br_if or if whose
+   condition operand was just emitted, i.e. replace
+     cmp, operands, result, br_if/if, condition
+   with
+     fused cmp, operands
+   so that the result needn't be written to and read from the frame,
+   and one dispatch is saved, the branch info of br_if or the else and
+   end addresses of if are emitted after it as usual */
+static void
+fuse_i32_cmp_and_branch(WASMLoaderContext *loader_ctx, uint8 cmp_opcode,
+                        uint8 branch_opcode)
+{
+    WASMFusibleCmp *cmp = &loader_ctx->fusible_cmp;
+    uint32 i, charge_size = 0;
+    uint8 fused_opcode;
+
+#if WASM_ENABLE_FUEL_METERING != 0
+    if (loader_ctx->fuel_charged_cost > 0)
+        charge_size = LABEL_SIZE + sizeof(uint32);
+#endif
+
+    if (!(fused_opcode = wasm_loader_get_fused_cmp_opcode(
+              cmp, cmp_opcode, branch_opcode,
+              wasm_loader_get_code_offset(loader_ctx),
+              charge_size + LABEL_SIZE + sizeof(int16))))
+        return;
+
+    /* skip the condition operand and the label of br_if/if */
+    wasm_loader_emit_backspace(loader_ctx, sizeof(int16));
+    skip_label();
+    if (charge_size > 0) {
+        /* skip the fuel charging, which is emitted again before the
+           fused opcode, the comparison has no side effect */
+        wasm_loader_emit_backspace(loader_ctx, sizeof(uint32));
+        skip_label();
+    }
+    /* skip the operands and result of the comparison and its label */
+    wasm_loader_emit_backspace(loader_ctx,
+                               sizeof(int16) * (cmp->operand_count + 1));
+    skip_label();
+
+#if WASM_ENABLE_FUEL_METERING != 0
+    if (charge_size > 0) {
+        emit_label(EXT_OP_CHARGE_FUEL);
+        emit_uint32(loader_ctx, loader_ctx->fuel_charged_cost);
+    }
+#endif
+    emit_label(fused_opcode);
+    for (i = 0; i < cmp->operand_count; i++)
+        emit_operand(loader_ctx, cmp->operands[i]);
+    cmp->operand_count = 0;
+}
+
+#if WASM_ENABLE_FUEL_METERING != 0
+/* Count the opcode in the current region, and charge the region before
+   the opcode if it is a control instruction which ends the region, the
+   fuel is charged only if the opcode is reached by executing the region,
+   but not when it is the target of a branch */
+static void
+emit_fuel_charge(WASMLoaderContext *loader_ctx, uint8 opcode, const uint8 *p,
+                 const uint8 *p_end)
+{
+    loader_ctx->fuel_charged_cost = 0;
+    loader_ctx->fuel_region_cost++;
+
+    if (!wasm_is_fuel_charging_opcode(opcode, p, p_end))
+        return;
+
+    if (loader_ctx->fuel_region_cost > 0) {
+        emit_label(EXT_OP_CHARGE_FUEL);
+        emit_uint32(loader_ctx, (uint32)loader_ctx->fuel_region_cost);
+        loader_ctx->fuel_charged_cost = (uint32)loader_ctx->fuel_region_cost;
+    }
+    loader_ctx->fuel_region_cost = 0;
+}
+#endif
+
 static bool
 preserve_referenced_local(WASMLoaderContext *loader_ctx, uint8 opcode,
                           uint32 local_index, uint32 local_type,
@@ -9103,6 +9440,13 @@ preserve_referenced_local(WASMLoaderContext *loader_ctx, uint8 opcode,
                         loader_ctx->preserved_local_offset++;
                     emit_label(EXT_OP_COPY_STACK_TOP);
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (local_type == VALUE_TYPE_V128) {
+                    if (loader_ctx->p_code_compiled)
+                        loader_ctx->preserved_local_offset += 4;
+                    emit_label(EXT_OP_COPY_STACK_TOP_V128);
+                }
+#endif
                 else {
                     if (loader_ctx->p_code_compiled)
                         loader_ctx->preserved_local_offset += 2;
@@ -9117,6 +9461,10 @@ preserve_referenced_local(WASMLoaderContext *loader_ctx, uint8 opcode,
 
         if (is_32bit_type(cur_type))
             i++;
+#if WASM_ENABLE_SIMD != 0
+        else if (cur_type == VALUE_TYPE_V128)
+            i += 4;
+#endif
         else
             i += 2;
     }
@@ -9150,6 +9498,11 @@ preserve_local_for_block(WASMLoaderContext *loader_ctx, uint8 opcode,
         if (is_32bit_type(cur_type)) {
             i++;
         }
+#if WASM_ENABLE_SIMD != 0
+        else if (cur_type == VALUE_TYPE_V128) {
+            i += 4;
+        }
+#endif
         else {
             i += 2;
         }
@@ -9308,6 +9661,8 @@ wasm_loader_push_frame_offset(WASMLoaderContext *ctx, uint8 type,
                               bool disable_emit, int16 operand_offset,
                               char *error_buf, uint32 error_buf_size)
 {
+    uint32 cell_num, i;
+
     if (type == VALUE_TYPE_VOID)
         return true;
 
@@ -9334,18 +9689,23 @@ wasm_loader_push_frame_offset(WASMLoaderContext *ctx, uint8 type,
     if (is_32bit_type(type))
         return true;
 
-    if (ctx->p_code_compiled == NULL) {
-        if (!check_offset_push(ctx, error_buf, error_buf_size))
-            return false;
-    }
+    /* the remaining cells of i64/f64/v128, which only take the
+       slots of the offset stack */
+    cell_num = is_64bit_type(type) ? 2 : wasm_value_type_cell_num(type);
+    for (i = 1; i < cell_num; i++) {
+        if (ctx->p_code_compiled == NULL) {
+            if (!check_offset_push(ctx, error_buf, error_buf_size))
+                return false;
+        }
 
-    ctx->frame_offset++;
-    if (!disable_emit) {
-        ctx->dynamic_offset++;
-        if (ctx->dynamic_offset > ctx->max_dynamic_offset) {
-            ctx->max_dynamic_offset = ctx->dynamic_offset;
-            if (ctx->max_dynamic_offset >= INT16_MAX) {
-                goto fail;
+        ctx->frame_offset++;
+        if (!disable_emit) {
+            ctx->dynamic_offset++;
+            if (ctx->dynamic_offset > ctx->max_dynamic_offset) {
+                ctx->max_dynamic_offset = ctx->dynamic_offset;
+                if (ctx->max_dynamic_offset >= INT16_MAX) {
+                    goto fail;
+                }
             }
         }
     }
@@ -9393,13 +9753,17 @@ wasm_loader_pop_frame_offset(WASMLoaderContext *ctx, uint8 type,
             ctx->dynamic_offset -= 1;
     }
     else {
-        if (!check_offset_pop(ctx, 2))
+        /* i64/f64 take 2 cells and v128 takes 4 cells */
+        int16 cell_num =
+            is_64bit_type(type) ? 2 : (int16)wasm_value_type_cell_num(type);
+
+        if (!check_offset_pop(ctx, cell_num))
             return true;
 
-        ctx->frame_offset -= 2;
+        ctx->frame_offset -= cell_num;
         if ((*(ctx->frame_offset) > ctx->start_dynamic_offset)
             && (*(ctx->frame_offset) < ctx->max_dynamic_offset))
-            ctx->dynamic_offset -= 2;
+            ctx->dynamic_offset -= cell_num;
     }
     emit_operand(ctx, *(ctx->frame_offset));
 
@@ -9476,7 +9840,6 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
     /* Search existing constant */
     for (c = (Const *)ctx->const_buf;
          (uint8 *)c < ctx->const_buf + ctx->num_const * sizeof(Const); c++) {
-        /* TODO: handle v128 type? */
         if ((type == c->value_type)
             && ((type == VALUE_TYPE_I64 && *(int64 *)value == c->value.i64)
                 || (type == VALUE_TYPE_I32 && *(int32 *)value == c->value.i32)
@@ -9489,13 +9852,21 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
                 || (type == VALUE_TYPE_F64
                     && (0 == memcmp(value, &(c->value.f64), sizeof(float64))))
                 || (type == VALUE_TYPE_F32
-                    && (0
-                        == memcmp(value, &(c->value.f32), sizeof(float32)))))) {
+                    && (0 == memcmp(value, &(c->value.f32), sizeof(float32))))
+#if WASM_ENABLE_SIMD != 0
+                || (type == VALUE_TYPE_V128
+                    && (0 == memcmp(value, &(c->value.v128), sizeof(V128))))
+#endif
+                    )) {
             operand_offset = c->slot_index;
             break;
         }
         if (is_32bit_type(c->value_type))
             operand_offset += 1;
+#if WASM_ENABLE_SIMD != 0
+        else if (c->value_type == VALUE_TYPE_V128)
+            operand_offset += 4;
+#endif
         else
             operand_offset += 2;
     }
@@ -9505,6 +9876,11 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
         if ((type == VALUE_TYPE_F64) || (type == VALUE_TYPE_I64)) {
             bytes_to_increase = 2;
         }
+#if WASM_ENABLE_SIMD != 0
+        else if (type == VALUE_TYPE_V128) {
+            bytes_to_increase = 4;
+        }
+#endif
         else {
             bytes_to_increase = 1;
         }
@@ -9547,6 +9923,15 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
                 c->value.i32 = *(int32 *)value;
                 ctx->const_cell_num++;
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                bh_memcpy_s(&(c->value.v128), sizeof(WASMValue), value,
+                            sizeof(V128));
+                ctx->const_cell_num += 4;
+                /* Use the fourth cell of the v128 const like i64/f64 */
+                operand_offset += 3;
+                break;
+#endif
 #if WASM_ENABLE_REF_TYPES != 0 && WASM_ENABLE_GC == 0
             case VALUE_TYPE_EXTERNREF:
             case VALUE_TYPE_FUNCREF:
@@ -9746,17 +10131,24 @@ reserve_block_ret(WASMLoaderContext *loader_ctx, uint8 opcode,
         block_type, &return_types, &reftype_maps, &reftype_map_count);
 #endif
 
-    /* If there is only one return value, use EXT_OP_COPY_STACK_TOP/_I64 instead
-     * of EXT_OP_COPY_STACK_VALUES for interpreter performance. */
+    /* If there is only one return value, use EXT_OP_COPY_STACK_TOP/_I64/_V128
+     * instead of EXT_OP_COPY_STACK_VALUES for interpreter performance. */
     if (return_count == 1) {
         uint8 cell = (uint8)wasm_value_type_cell_num(return_types[0]);
-        if (cell <= 2 /* V128 isn't supported whose cell num is 4 */
-            && block->dynamic_offset != *(loader_ctx->frame_offset - cell)) {
+        if (block->dynamic_offset != *(loader_ctx->frame_offset - cell)) {
             /* insert op_copy before else opcode */
             if (opcode == WASM_OP_ELSE)
                 skip_label();
-            emit_label(cell == 1 ? EXT_OP_COPY_STACK_TOP
-                                 : EXT_OP_COPY_STACK_TOP_I64);
+#if WASM_ENABLE_SIMD != 0
+            if (cell == 4) {
+                emit_label(EXT_OP_COPY_STACK_TOP_V128);
+            }
+            else
+#endif
+            {
+                emit_label(cell == 1 ? EXT_OP_COPY_STACK_TOP
+                                     : EXT_OP_COPY_STACK_TOP_I64);
+            }
             emit_operand(loader_ctx, *(loader_ctx->frame_offset - cell));
             emit_operand(loader_ctx, block->dynamic_offset);
 
@@ -10003,7 +10395,8 @@ check_memory_access_align(uint8 opcode, uint32 align, char *error_buf,
 }
 
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
 static bool
 check_simd_memory_access_align(uint8 opcode, uint32 align, char *error_buf,
                                uint32 error_buf_size)
@@ -10117,7 +10510,8 @@ check_simd_shuffle_mask(V128 mask, char *error_buf, uint32 error_buf_size)
     }
     return true;
 }
-#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
+#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+          || (WASM_ENABLE_FAST_INTERP != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -10959,6 +11353,9 @@ wasm_loader_prepare_bytecode(WASMModule *module, WASMFunction *func,
     loader_ctx->ref_type_set = module->ref_type_set;
     loader_ctx->ref_type_tmp = &wasm_ref_type;
 #endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    loader_ctx->record_code_relocs = module->record_code_relocs;
+#endif
 
 #if WASM_ENABLE_FAST_INTERP != 0
     /* For the first traverse, the initial value of preserved_local_offset has
@@ -10984,12 +11381,18 @@ re_scan:
 #endif
 
     PUSH_CSP(LABEL_TYPE_FUNCTION, func_block_type, p);
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL_METERING != 0
+    loader_ctx->fuel_region_cost = 0;
+#endif
 
     while (p < p_end) {
         opcode = *p++;
 #if WASM_ENABLE_FAST_INTERP != 0
         p_org = p;
         disable_emit = false;
+#if WASM_ENABLE_FUEL_METERING != 0
+        emit_fuel_charge(loader_ctx, opcode, p, p_end);
+#endif
         emit_label(opcode);
 #endif
         switch (opcode) {
@@ -11289,6 +11692,8 @@ re_scan:
                                     (uint32)size);
                     }
 
+                    fuse_i32_cmp_and_branch(loader_ctx, last_op, opcode);
+
                     block->start_dynamic_offset = loader_ctx->dynamic_offset;
 
                     emit_empty_label_addr_and_frame_ip(PATCH_ELSE);
@@ -11610,6 +12015,12 @@ re_scan:
                     skip_label();
                     disable_emit = false;
                     emit_label(opcode);
+#if WASM_ENABLE_FUEL_METERING != 0
+                    /* The end is scanned again after the virtual else,
+                       it has been charged before the else, and isn't
+                       reached by the if-false branch */
+                    loader_ctx->fuel_region_cost = -1;
+#endif
 #endif
                     goto handle_op_else;
                 }
@@ -11666,6 +12077,9 @@ re_scan:
             case WASM_OP_BR_IF:
             {
                 POP_I32();
+#if WASM_ENABLE_FAST_INTERP != 0
+                fuse_i32_cmp_and_branch(loader_ctx, last_op, opcode);
+#endif
 
                 if (!(frame_csp_tmp =
                           check_branch_block(loader_ctx, &p, p_end, opcode,
@@ -12166,10 +12580,20 @@ re_scan:
 #endif
                     }
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
                     else if (*(loader_ctx->frame_ref - 1) == VALUE_TYPE_V128) {
                         loader_ctx->frame_ref -= 4;
                         loader_ctx->stack_cell_num -= 4;
+#if WASM_ENABLE_FAST_INTERP != 0
+                        skip_label();
+                        loader_ctx->frame_offset -= 4;
+                        if ((*(loader_ctx->frame_offset)
+                             > loader_ctx->start_dynamic_offset)
+                            && (*(loader_ctx->frame_offset)
+                                < loader_ctx->max_dynamic_offset))
+                            loader_ctx->dynamic_offset -= 4;
+#endif
                     }
 #endif
 #endif
@@ -12218,12 +12642,20 @@ re_scan:
                             break;
                         case VALUE_TYPE_I64:
                         case VALUE_TYPE_F64:
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+                        case VALUE_TYPE_V128:
+#endif
 #if WASM_ENABLE_FAST_INTERP == 0
                             *(p - 1) = WASM_OP_SELECT_64;
 #endif
 #if WASM_ENABLE_FAST_INTERP != 0
                             if (loader_ctx->p_code_compiled) {
                                 uint8 opcode_tmp = WASM_OP_SELECT_64;
+#if WASM_ENABLE_SIMD != 0
+                                if (*(loader_ctx->frame_ref - 1)
+                                    == VALUE_TYPE_V128)
+                                    opcode_tmp = WASM_OP_SELECT_128;
+#endif
 #if WASM_ENABLE_LABELS_AS_VALUES != 0
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
                                 *(void **)(p_code_compiled_tmp
@@ -12255,12 +12687,12 @@ re_scan:
                             }
 #endif /* end of WASM_ENABLE_FAST_INTERP */
                             break;
-#if WASM_ENABLE_SIMD != 0
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP == 0
 #if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
                         case VALUE_TYPE_V128:
                             break;
 #endif /* (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
-#endif /* WASM_ENABLE_SIMD != 0 */
+#endif /* WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP == 0 */
                         default:
                         {
                             set_error_buf(error_buf, error_buf_size,
@@ -12354,11 +12786,12 @@ re_scan:
                     uint8 opcode_tmp = WASM_OP_SELECT;
 
                     if (type == VALUE_TYPE_V128) {
-#if (WASM_ENABLE_SIMD == 0) \
-    || ((WASM_ENABLE_WAMR_COMPILER == 0) && (WASM_ENABLE_JIT == 0))
+#if WASM_ENABLE_SIMD == 0
                         set_error_buf(error_buf, error_buf_size,
                                       "SIMD v128 type isn't supported");
                         goto fail;
+#else
+                        opcode_tmp = WASM_OP_SELECT_128;
 #endif
                     }
                     else {
@@ -12368,31 +12801,30 @@ re_scan:
                         if (wasm_is_type_reftype(type))
                             opcode_tmp = WASM_OP_SELECT_T;
 #endif
+                    }
 #if WASM_ENABLE_LABELS_AS_VALUES != 0
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
-                        *(void **)(p_code_compiled_tmp - sizeof(void *)) =
-                            handle_table[opcode_tmp];
+                    *(void **)(p_code_compiled_tmp - sizeof(void *)) =
+                        handle_table[opcode_tmp];
 #else
 #if UINTPTR_MAX == UINT64_MAX
-                        /* emit int32 relative offset in 64-bit target */
-                        int32 offset = (int32)((uint8 *)handle_table[opcode_tmp]
-                                               - (uint8 *)handle_table[0]);
-                        *(int32 *)(p_code_compiled_tmp - sizeof(int32)) =
-                            offset;
+                    /* emit int32 relative offset in 64-bit target */
+                    int32 offset = (int32)((uint8 *)handle_table[opcode_tmp]
+                                           - (uint8 *)handle_table[0]);
+                    *(int32 *)(p_code_compiled_tmp - sizeof(int32)) = offset;
 #else
-                        /* emit uint32 label address in 32-bit target */
-                        *(uint32 *)(p_code_compiled_tmp - sizeof(uint32)) =
-                            (uint32)(uintptr_t)handle_table[opcode_tmp];
+                    /* emit uint32 label address in 32-bit target */
+                    *(uint32 *)(p_code_compiled_tmp - sizeof(uint32)) =
+                        (uint32)(uintptr_t)handle_table[opcode_tmp];
 #endif
 #endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 #else  /* else of WASM_ENABLE_LABELS_AS_VALUES */
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
-                        *(p_code_compiled_tmp - 1) = opcode_tmp;
+                    *(p_code_compiled_tmp - 1) = opcode_tmp;
 #else
-                        *(p_code_compiled_tmp - 2) = opcode_tmp;
+                    *(p_code_compiled_tmp - 2) = opcode_tmp;
 #endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 #endif /* end of WASM_ENABLE_LABELS_AS_VALUES */
-                    }
                 }
 #endif /* WASM_ENABLE_FAST_INTERP != 0 */
 
@@ -12846,6 +13278,12 @@ re_scan:
                             emit_label(EXT_OP_SET_LOCAL_FAST);
                             emit_byte(loader_ctx, (uint8)local_offset);
                         }
+#if WASM_ENABLE_SIMD != 0
+                        else if (local_type == VALUE_TYPE_V128) {
+                            emit_label(EXT_OP_SET_LOCAL_FAST_V128);
+                            emit_byte(loader_ctx, (uint8)local_offset);
+                        }
+#endif
                         else {
                             emit_label(EXT_OP_SET_LOCAL_FAST_I64);
                             emit_byte(loader_ctx, (uint8)local_offset);
@@ -12922,6 +13360,12 @@ re_scan:
                         emit_label(EXT_OP_TEE_LOCAL_FAST);
                         emit_byte(loader_ctx, (uint8)local_offset);
                     }
+#if WASM_ENABLE_SIMD != 0
+                    else if (local_type == VALUE_TYPE_V128) {
+                        emit_label(EXT_OP_TEE_LOCAL_FAST_V128);
+                        emit_byte(loader_ctx, (uint8)local_offset);
+                    }
+#endif
                     else {
                         emit_label(EXT_OP_TEE_LOCAL_FAST_I64);
                         emit_byte(loader_ctx, (uint8)local_offset);
@@ -13016,6 +13460,12 @@ re_scan:
                     skip_label();
                     emit_label(WASM_OP_GET_GLOBAL_64);
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (global_type == VALUE_TYPE_V128) {
+                    skip_label();
+                    emit_label(WASM_OP_GET_GLOBAL_V128);
+                }
+#endif
                 emit_uint32(loader_ctx, global_idx);
                 PUSH_OFFSET_TYPE(global_type);
 #endif /* end of WASM_ENABLE_FAST_INTERP */
@@ -13105,6 +13555,12 @@ re_scan:
                     skip_label();
                     emit_label(WASM_OP_SET_GLOBAL_64);
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (global_type == VALUE_TYPE_V128) {
+                    skip_label();
+                    emit_label(WASM_OP_SET_GLOBAL_V128);
+                }
+#endif
                 else if (module->aux_stack_size > 0
                          && global_idx == module->aux_stack_top_global_index) {
                     skip_label();
@@ -13339,7 +13795,18 @@ re_scan:
                 break;
 
             case WASM_OP_I32_EQZ:
+#if WASM_ENABLE_FAST_INTERP != 0
+                wasm_loader_record_fusible_cmp(
+                    &loader_ctx->fusible_cmp, loader_ctx->frame_offset,
+                    loader_ctx->stack_cell_num
+                        - (loader_ctx->frame_csp - 1)->stack_cell_num,
+                    1);
+#endif
                 POP_AND_PUSH(VALUE_TYPE_I32, VALUE_TYPE_I32);
+#if WASM_ENABLE_FAST_INTERP != 0
+                loader_ctx->fusible_cmp.code_end =
+                    wasm_loader_get_code_offset(loader_ctx);
+#endif
                 break;
 
             case WASM_OP_I32_EQ:
@@ -13352,7 +13819,18 @@ re_scan:
             case WASM_OP_I32_LE_U:
             case WASM_OP_I32_GE_S:
             case WASM_OP_I32_GE_U:
+#if WASM_ENABLE_FAST_INTERP != 0
+                wasm_loader_record_fusible_cmp(
+                    &loader_ctx->fusible_cmp, loader_ctx->frame_offset,
+                    loader_ctx->stack_cell_num
+                        - (loader_ctx->frame_csp - 1)->stack_cell_num,
+                    2);
+#endif
                 POP2_AND_PUSH(VALUE_TYPE_I32, VALUE_TYPE_I32);
+#if WASM_ENABLE_FAST_INTERP != 0
+                loader_ctx->fusible_cmp.code_end =
+                    wasm_loader_get_code_offset(loader_ctx);
+#endif
                 break;
 
             case WASM_OP_I64_EQZ:
@@ -14928,7 +15406,8 @@ re_scan:
             }
 
 #if WASM_ENABLE_SIMD != 0
-#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0)
+#if (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+    || (WASM_ENABLE_FAST_INTERP != 0)
             case WASM_OP_SIMD_PREFIX:
             {
                 /* TODO: memory64 offset type changes */
@@ -14940,6 +15419,11 @@ re_scan:
 #endif
 
                 read_leb_uint32(p, p_end, opcode1);
+#if WASM_ENABLE_FAST_INTERP != 0
+                /* v128.const is emitted as a const slot if possible */
+                if (opcode1 != SIMD_v128_const)
+                    emit_byte(loader_ctx, (uint8)opcode1);
+#endif
 
                 /* follow the order of enum WASMSimdEXTOpcode in wasm_opcode.h
                  */
@@ -14966,6 +15450,9 @@ re_scan:
                         }
 
                         read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_uint32(loader_ctx, mem_offset);
+#endif
 
                         POP_AND_PUSH(mem_offset_type, VALUE_TYPE_V128);
 #if WASM_ENABLE_JIT != 0 || WASM_ENABLE_WAMR_COMPILER != 0
@@ -14985,6 +15472,9 @@ re_scan:
                         }
 
                         read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_uint32(loader_ctx, mem_offset);
+#endif
 
                         POP_V128();
                         POP_MEM_OFFSET();
@@ -14997,8 +15487,26 @@ re_scan:
                     /* basic operation */
                     case SIMD_v128_const:
                     {
+#if WASM_ENABLE_FAST_INTERP != 0
+                        V128 v128_const;
+#endif
                         CHECK_BUF1(p, p_end, 16);
+#if WASM_ENABLE_FAST_INTERP != 0
+                        bh_memcpy_s(&v128_const, sizeof(V128), p, 16);
+#endif
                         p += 16;
+#if WASM_ENABLE_FAST_INTERP != 0
+                        skip_label();
+                        disable_emit = true;
+                        GET_CONST_OFFSET(VALUE_TYPE_V128, v128_const);
+
+                        if (operand_offset == 0) {
+                            disable_emit = false;
+                            emit_label(WASM_OP_SIMD_PREFIX);
+                            emit_byte(loader_ctx, SIMD_v128_const);
+                            emit_v128(loader_ctx, v128_const);
+                        }
+#endif
                         PUSH_V128();
                         break;
                     }
@@ -15014,6 +15522,9 @@ re_scan:
                                                      error_buf_size)) {
                             goto fail;
                         }
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_v128(loader_ctx, mask);
+#endif
 
                         POP2_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_V128);
                         break;
@@ -15085,14 +15596,26 @@ re_scan:
                                                     error_buf_size)) {
                             goto fail;
                         }
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_byte(loader_ctx, lane);
+#endif
 
                         if (replace[opcode1 - SIMD_i8x16_extract_lane_s]) {
+#if WASM_ENABLE_FAST_INTERP != 0
+                            if (!(wasm_loader_pop_frame_ref_offset(
+                                    loader_ctx,
+                                    replace[opcode1
+                                            - SIMD_i8x16_extract_lane_s],
+                                    error_buf, error_buf_size)))
+                                goto fail;
+#else
                             if (!(wasm_loader_pop_frame_ref(
                                     loader_ctx,
                                     replace[opcode1
                                             - SIMD_i8x16_extract_lane_s],
                                     error_buf, error_buf_size)))
                                 goto fail;
+#endif
                         }
 
                         POP_AND_PUSH(
@@ -15203,6 +15726,9 @@ re_scan:
                         }
 
                         read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_uint32(loader_ctx, mem_offset);
+#endif
 
                         CHECK_BUF(p, p_end, 1);
                         lane = read_uint8(p);
@@ -15210,6 +15736,9 @@ re_scan:
                                                     error_buf_size)) {
                             goto fail;
                         }
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_byte(loader_ctx, lane);
+#endif
 
                         POP_V128();
                         POP_MEM_OFFSET();
@@ -15234,6 +15763,9 @@ re_scan:
                         }
 
                         read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+#if WASM_ENABLE_FAST_INTERP != 0
+                        emit_uint32(loader_ctx, mem_offset);
+#endif
 
                         POP_AND_PUSH(mem_offset_type, VALUE_TYPE_V128);
 #if WASM_ENABLE_JIT != 0 || WASM_ENABLE_WAMR_COMPILER != 0
@@ -15583,7 +16115,8 @@ re_scan:
                 }
                 break;
             }
-#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) */
+#endif /* end of (WASM_ENABLE_WAMR_COMPILER != 0) || (WASM_ENABLE_JIT != 0) \
+          || (WASM_ENABLE_FAST_INTERP != 0) */
 #endif /* end of WASM_ENABLE_SIMD */
 
 #if WASM_ENABLE_SHARED_MEMORY != 0
@@ -15784,6 +16317,13 @@ re_scan:
                             &(c->value.f64), (uint32)sizeof(int64));
                 func_const += sizeof(int64);
             }
+#if WASM_ENABLE_SIMD != 0
+            else if (c->value_type == VALUE_TYPE_V128) {
+                bh_memcpy_s(func_const, (uint32)(func_const_end - func_const),
+                            &(c->value.v128), (uint32)sizeof(V128));
+                func_const += sizeof(V128);
+            }
+#endif
             else {
                 bh_memcpy_s(func_const, (uint32)(func_const_end - func_const),
                             &(c->value.f32), (uint32)sizeof(int32));
@@ -15794,6 +16334,12 @@ re_scan:
 
     func->max_stack_cell_num = loader_ctx->preserved_local_offset
                                - loader_ctx->start_dynamic_offset + 1;
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    /* hand over the relocations, they are freed after saving the cache */
+    func->code_relocs = loader_ctx->code_relocs;
+    func->code_reloc_count = loader_ctx->code_reloc_count;
+    loader_ctx->code_relocs = NULL;
+#endif
 #else
     func->max_stack_cell_num = loader_ctx->max_stack_cell_num;
 #endif
@@ -15812,4 +16358,46 @@ fail:
     (void)mem_offset;
     (void)align;
     return return_value;
-}
\ No newline at end of file
+}
+
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+bool
+wasm_loader_prepare_func_lazily(WASMModule *module, uint32 func_idx,
+                                char *error_buf, uint32 error_buf_size)
+{
+    WASMFunction *func;
+    bool ret;
+
+    bh_assert(module->is_lazy_func_validation);
+    bh_assert(func_idx < module->function_count);
+    func = module->functions[func_idx];
+
+    os_mutex_lock(&module->lazy_prepare_lock);
+
+    if (func->prepare_state == WASM_FUNC_STATE_UNPREPARED) {
+        if (wasm_loader_prepare_bytecode(module, func, func_idx, error_buf,
+                                         error_buf_size)) {
+            module->prepared_func_count++;
+            /* Publish the state after all the prepared fields are set,
+               the callers check it without holding the lock */
+            BH_ATOMIC_32_STORE(func->prepare_state, WASM_FUNC_STATE_PREPARED);
+        }
+        else {
+            /* The function body may have been partly rewritten, so it
+               can't be validated again, keep the error instead */
+            func->prepare_error = bh_strdup(error_buf);
+            BH_ATOMIC_32_STORE(func->prepare_state, WASM_FUNC_STATE_INVALID);
+        }
+    }
+    else if (func->prepare_state == WASM_FUNC_STATE_INVALID) {
+        if (func->prepare_error)
+            snprintf(error_buf, error_buf_size, "%s", func->prepare_error);
+        else
+            set_error_buf(error_buf, error_buf_size, "invalid function body");
+    }
+
+    ret = func->prepare_state == WASM_FUNC_STATE_PREPARED;
+    os_mutex_unlock(&module->lazy_prepare_lock);
+    return ret;
+}
+#endif /* end of WASM_ENABLE_LAZY_FUNC_VALIDATION != 0 */
\ No newline at end of file
@@ -51,6 +51,24 @@ wasm_loader_load_from_sections(WASMSection *section_list, char *error_buf,
 void
 wasm_loader_unload(WASMModule *module);
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+/**
+ * Validate and prepare the body of a function of the module loaded with
+ * lazy function validation if it hasn't been prepared.
+ *
+ * @param module the module which defines the function
+ * @param func_idx the index of the function, not including the imported
+ *        functions
+ * @param error_buf output of the validation error
+ * @param error_buf_size the size of the error string
+ *
+ * @return true if the function body is valid, false otherwise
+ */
+bool
+wasm_loader_prepare_func_lazily(WASMModule *module, uint32 func_idx,
+                                char *error_buf, uint32 error_buf_size);
+#endif
+
 /**
  * Find address of related else opcode and end opcode of opcode block/loop/if
  * according to the start address of opcode.
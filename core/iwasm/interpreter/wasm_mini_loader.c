@@ -95,6 +95,9 @@ is_value_type(uint8 type)
         || type == VALUE_TYPE_F32 || type == VALUE_TYPE_F64
 #if WASM_ENABLE_REF_TYPES != 0
         || type == VALUE_TYPE_FUNCREF || type == VALUE_TYPE_EXTERNREF
+#endif
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+        || type == VALUE_TYPE_V128
 #endif
     )
         return true;
@@ -426,6 +429,30 @@ load_init_expr(WASMModule *module, const uint8 **p_buf, const uint8 *buf_end,
                     bh_assert(0);
                 }
                 break;
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+            /* v128.const */
+            case INIT_EXPR_TYPE_V128_CONST:
+            {
+                uint64 high, low;
+
+                CHECK_BUF(p, p_end, 1);
+                (void)read_uint8(p);
+
+                CHECK_BUF(p, p_end, 16);
+                wasm_runtime_read_v128(p, &high, &low);
+                p += 16;
+
+                cur_value.v128.i64x2[0] = high;
+                cur_value.v128.i64x2[1] = low;
+
+                if (!push_const_expr_stack(&const_expr_ctx, flag,
+                                           VALUE_TYPE_V128, &cur_value,
+                                           error_buf, error_buf_size)) {
+                    bh_assert(0);
+                }
+                break;
+            }
+#endif
 
 #if WASM_ENABLE_REF_TYPES != 0
             /* ref.func */
@@ -671,6 +698,13 @@ load_function_import(const uint8 **p_buf, const uint8 *buf_end,
     function->signature = linked_signature;
     function->attachment = linked_attachment;
     function->call_conv_raw = linked_call_conv_raw;
+
+    if (linked_func && !linked_call_conv_raw
+        && !wasm_runtime_create_native_call_desc(
+            declare_func_type, linked_signature, &function->call_desc)) {
+        set_error_buf(error_buf, error_buf_size, "allocate memory failed");
+        return false;
+    }
     return true;
 }
 
@@ -2187,6 +2221,21 @@ init_llvm_jit_functions_stage1(WASMModule *module, char *error_buf,
     option.enable_memory_profiling = true;
     option.enable_stack_estimation = true;
 #endif
+#if WASM_ENABLE_FUEL_METERING != 0
+    option.enable_fuel_metering = true;
+#endif
+#if WASM_ENABLE_AOT_SAFEPOINT != 0 && defined(OS_ENABLE_HW_BOUND_CHECK)
+    option.enable_safepoint_page = true;
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+    option.enable_gc_write_barrier = true;
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    option.enable_gc_pre_write_barrier = true;
+#endif
+#if WASM_ENABLE_SHARED_HEAP != 0
+    option.enable_shared_heap = true;
+#endif
 
     module->comp_ctx = aot_create_comp_context(module->comp_data, &option);
     if (!module->comp_ctx) {
@@ -3315,8 +3364,14 @@ wasm_loader_unload(WASMModule *module)
         wasm_runtime_free(module->types);
     }
 
-    if (module->imports)
+    if (module->imports) {
+        for (i = 0; i < module->import_function_count; i++) {
+            if (module->import_functions[i].u.function.call_desc)
+                wasm_runtime_destroy_native_call_desc(
+                    module->import_functions[i].u.function.call_desc);
+        }
         wasm_runtime_free(module->imports);
+    }
 
     if (module->functions) {
         for (i = 0; i < module->function_count; i++) {
@@ -4004,6 +4059,17 @@ typedef struct WASMLoaderContext {
      * than the final code_compiled_size, we record the peak size to ensure
      * there will not be invalid memory access during second traverse */
     uint32 code_compiled_peak_size;
+
+    /* the i32 comparison emitted last, which may be fused with the
+       br_if or if following it */
+    WASMFusibleCmp fusible_cmp;
+#if WASM_ENABLE_FUEL_METERING != 0
+    /* instruction count of the region since the last control instruction
+       which ends a region, and the cost charged by the EXT_OP_CHARGE_FUEL
+       emitted before the current opcode, 0 if it isn't emitted */
+    int32 fuel_region_cost;
+    uint32 fuel_charged_cost;
+#endif
 #endif
 } WASMLoaderContext;
 
@@ -4119,6 +4185,11 @@ check_stack_top_values(uint8 *frame_ref, int32 stack_cell_num, uint8 type,
 {
     bh_assert(!((is_32bit_type(type) && stack_cell_num < 1)
                 || (is_64bit_type(type) && stack_cell_num < 2)));
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+    bh_assert(!(type == VALUE_TYPE_V128
+                && (stack_cell_num < 4 || *(frame_ref - 1) != VALUE_TYPE_V128
+                    || *(frame_ref - 4) != VALUE_TYPE_V128)));
+#endif
 
     bh_assert(!(
         (type == VALUE_TYPE_I32 && *(frame_ref - 1) != REF_I32)
@@ -4229,6 +4300,8 @@ static bool
 wasm_loader_push_frame_ref(WASMLoaderContext *ctx, uint8 type, char *error_buf,
                            uint32 error_buf_size)
 {
+    uint32 cell_num, i;
+
     if (type == VALUE_TYPE_VOID)
         return true;
 
@@ -4243,13 +4316,17 @@ wasm_loader_push_frame_ref(WASMLoaderContext *ctx, uint8 type, char *error_buf,
     if (is_32bit_type(type))
         return true;
 
-    if (!check_stack_push(ctx, error_buf, error_buf_size))
-        return false;
-    *ctx->frame_ref++ = type;
-    ctx->stack_cell_num++;
-    if (ctx->stack_cell_num > ctx->max_stack_cell_num) {
-        ctx->max_stack_cell_num = ctx->stack_cell_num;
-        bh_assert(ctx->max_stack_cell_num <= UINT16_MAX);
+    /* the remaining cells of i64/f64/v128 */
+    cell_num = wasm_value_type_cell_num(type);
+    for (i = 1; i < cell_num; i++) {
+        if (!check_stack_push(ctx, error_buf, error_buf_size))
+            return false;
+        *ctx->frame_ref++ = type;
+        ctx->stack_cell_num++;
+        if (ctx->stack_cell_num > ctx->max_stack_cell_num) {
+            ctx->max_stack_cell_num = ctx->stack_cell_num;
+            bh_assert(ctx->max_stack_cell_num <= UINT16_MAX);
+        }
     }
     return true;
 }
@@ -4261,6 +4338,7 @@ wasm_loader_pop_frame_ref(WASMLoaderContext *ctx, uint8 type, char *error_buf,
     BranchBlock *cur_block = ctx->frame_csp - 1;
     int32 available_stack_cell =
         (int32)(ctx->stack_cell_num - cur_block->stack_cell_num);
+    uint32 cell_num;
 
     /* Directly return success if current block is in stack
      * polymorphic state while stack is empty. */
@@ -4279,8 +4357,10 @@ wasm_loader_pop_frame_ref(WASMLoaderContext *ctx, uint8 type, char *error_buf,
     if (is_32bit_type(type) || *ctx->frame_ref == VALUE_TYPE_ANY)
         return true;
 
-    ctx->frame_ref--;
-    ctx->stack_cell_num--;
+    /* the remaining cells of i64/f64/v128 */
+    cell_num = wasm_value_type_cell_num(type) - 1;
+    ctx->frame_ref -= cell_num;
+    ctx->stack_cell_num -= cell_num;
     return true;
 }
 
@@ -4355,6 +4435,7 @@ wasm_loader_pop_frame_csp(WASMLoaderContext *ctx, char *error_buf,
         wasm_loader_emit_backspace(loader_ctx, sizeof(void *)); \
         LOG_OP("\ndelete last op\n");                           \
     } while (0)
+#define LABEL_SIZE sizeof(void *)
 #else /* else of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 #if UINTPTR_MAX == UINT64_MAX
 #define emit_label(opcode)                                                     \
@@ -4379,6 +4460,7 @@ wasm_loader_pop_frame_csp(WASMLoaderContext *ctx, char *error_buf,
         wasm_loader_emit_backspace(loader_ctx, sizeof(int32)); \
         LOG_OP("\ndelete last op\n");                          \
     } while (0)
+#define LABEL_SIZE sizeof(int32)
 #endif /* end of WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS */
 #else  /* else of WASM_ENABLE_LABELS_AS_VALUES */
 #define emit_label(opcode)                          \
@@ -4391,6 +4473,12 @@ wasm_loader_pop_frame_csp(WASMLoaderContext *ctx, char *error_buf,
         wasm_loader_emit_backspace(loader_ctx, sizeof(uint8)); \
         LOG_OP("\ndelete last op\n");                          \
     } while (0)
+#if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
+#define LABEL_SIZE sizeof(uint8)
+#else
+/* the opcode is followed by a padding byte */
+#define LABEL_SIZE (sizeof(uint8) * 2)
+#endif
 #endif /* end of WASM_ENABLE_LABELS_AS_VALUES */
 
 #define emit_empty_label_addr_and_frame_ip(type)                             \
@@ -4496,6 +4584,13 @@ wasm_loader_pop_frame_csp(WASMLoaderContext *ctx, char *error_buf,
         LOG_OP("%f\t", value);                      \
     } while (0)
 
+#define emit_v128(ctx, value)                                      \
+    do {                                                           \
+        wasm_loader_emit_const(ctx, &(value).i64x2[0], false);     \
+        wasm_loader_emit_const(ctx, &(value).i64x2[1], false);     \
+        LOG_OP("%llx %llx\t", (value).i64x2[0], (value).i64x2[1]); \
+    } while (0)
+
 static bool
 wasm_loader_ctx_reinit(WASMLoaderContext *ctx)
 {
@@ -4656,6 +4751,93 @@ wasm_loader_emit_backspace(WASMLoaderContext *ctx, uint32 size)
     }
 }
 
+static uint32
+wasm_loader_get_code_offset(WASMLoaderContext *ctx)
+{
+    if (ctx->p_code_compiled)
+        return (uint32)(ctx->p_code_compiled
+                        - (ctx->p_code_compiled_end
+                           - ctx->code_compiled_peak_size));
+    return ctx->code_compiled_size;
+}
+
+/* Fuse the i32 comparison emitted last with the br_if or if whose
+   condition operand was just emitted, i.e. replace
+     cmp, operands, result, br_if/if, condition
+   with
+     fused cmp, operands
+   so that the result needn't be written to and read from the frame,
+   and one dispatch is saved, the branch info of br_if or the else and
+   end addresses of if are emitted after it as usual */
+static void
+fuse_i32_cmp_and_branch(WASMLoaderContext *loader_ctx, uint8 cmp_opcode,
+                        uint8 branch_opcode)
+{
+    WASMFusibleCmp *cmp = &loader_ctx->fusible_cmp;
+    uint32 i, charge_size = 0;
+    uint8 fused_opcode;
+
+#if WASM_ENABLE_FUEL_METERING != 0
+    if (loader_ctx->fuel_charged_cost > 0)
+        charge_size = LABEL_SIZE + sizeof(uint32);
+#endif
+
+    if (!(fused_opcode = wasm_loader_get_fused_cmp_opcode(
+              cmp, cmp_opcode, branch_opcode,
+              wasm_loader_get_code_offset(loader_ctx),
+              charge_size + LABEL_SIZE + sizeof(int16))))
+        return;
+
+    /* skip the condition operand and the label of br_if/if */
+    wasm_loader_emit_backspace(loader_ctx, sizeof(int16));
+    skip_label();
+    if (charge_size > 0) {
+        /* skip the fuel charging, which is emitted again before the
+           fused opcode, the comparison has no side effect */
+        wasm_loader_emit_backspace(loader_ctx, sizeof(uint32));
+        skip_label();
+    }
+    /* skip the operands and result of the comparison and its label */
+    wasm_loader_emit_backspace(loader_ctx,
+                               sizeof(int16) * (cmp->operand_count + 1));
+    skip_label();
+
+#if WASM_ENABLE_FUEL_METERING != 0
+    if (charge_size > 0) {
+        emit_label(EXT_OP_CHARGE_FUEL);
+        emit_uint32(loader_ctx, loader_ctx->fuel_charged_cost);
+    }
+#endif
+    emit_label(fused_opcode);
+    for (i = 0; i < cmp->operand_count; i++)
+        emit_operand(loader_ctx, cmp->operands[i]);
+    cmp->operand_count = 0;
+}
+
+#if WASM_ENABLE_FUEL_METERING != 0
+/* Count the opcode in the current region, and charge the region before
+   the opcode if it is a control instruction which ends the region, the
+   fuel is charged only if the opcode is reached by executing the region,
+   but not when it is the target of a branch */
+static void
+emit_fuel_charge(WASMLoaderContext *loader_ctx, uint8 opcode, const uint8 *p,
+                 const uint8 *p_end)
+{
+    loader_ctx->fuel_charged_cost = 0;
+    loader_ctx->fuel_region_cost++;
+
+    if (!wasm_is_fuel_charging_opcode(opcode, p, p_end))
+        return;
+
+    if (loader_ctx->fuel_region_cost > 0) {
+        emit_label(EXT_OP_CHARGE_FUEL);
+        emit_uint32(loader_ctx, (uint32)loader_ctx->fuel_region_cost);
+        loader_ctx->fuel_charged_cost = (uint32)loader_ctx->fuel_region_cost;
+    }
+    loader_ctx->fuel_region_cost = 0;
+}
+#endif
+
 static bool
 preserve_referenced_local(WASMLoaderContext *loader_ctx, uint8 opcode,
                           uint32 local_index, uint32 local_type,
@@ -4685,6 +4867,13 @@ preserve_referenced_local(WASMLoaderContext *loader_ctx, uint8 opcode,
                         loader_ctx->preserved_local_offset++;
                     emit_label(EXT_OP_COPY_STACK_TOP);
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (local_type == VALUE_TYPE_V128) {
+                    if (loader_ctx->p_code_compiled)
+                        loader_ctx->preserved_local_offset += 4;
+                    emit_label(EXT_OP_COPY_STACK_TOP_V128);
+                }
+#endif
                 else {
                     if (loader_ctx->p_code_compiled)
                         loader_ctx->preserved_local_offset += 2;
@@ -4699,6 +4888,10 @@ preserve_referenced_local(WASMLoaderContext *loader_ctx, uint8 opcode,
 
         if (is_32bit_type(cur_type))
             i++;
+#if WASM_ENABLE_SIMD != 0
+        else if (cur_type == VALUE_TYPE_V128)
+            i += 4;
+#endif
         else
             i += 2;
     }
@@ -4727,9 +4920,14 @@ preserve_local_for_block(WASMLoaderContext *loader_ctx, uint8 opcode,
                 return false;
         }
 
-        if (is_32bit_type(cur_type == VALUE_TYPE_I32)) {
+        if (is_32bit_type(cur_type)) {
             i++;
         }
+#if WASM_ENABLE_SIMD != 0
+        else if (cur_type == VALUE_TYPE_V128) {
+            i += 4;
+        }
+#endif
         else {
             i += 2;
         }
@@ -4876,6 +5074,8 @@ wasm_loader_push_frame_offset(WASMLoaderContext *ctx, uint8 type,
                               bool disable_emit, int16 operand_offset,
                               char *error_buf, uint32 error_buf_size)
 {
+    uint32 cell_num, i;
+
     if (type == VALUE_TYPE_VOID)
         return true;
 
@@ -4900,17 +5100,22 @@ wasm_loader_push_frame_offset(WASMLoaderContext *ctx, uint8 type,
     if (is_32bit_type(type))
         return true;
 
-    if (ctx->p_code_compiled == NULL) {
-        if (!check_offset_push(ctx, error_buf, error_buf_size))
-            return false;
-    }
+    /* the remaining cells of i64/f64/v128, which only take the
+       slots of the offset stack */
+    cell_num = is_64bit_type(type) ? 2 : wasm_value_type_cell_num(type);
+    for (i = 1; i < cell_num; i++) {
+        if (ctx->p_code_compiled == NULL) {
+            if (!check_offset_push(ctx, error_buf, error_buf_size))
+                return false;
+        }
 
-    ctx->frame_offset++;
-    if (!disable_emit) {
-        ctx->dynamic_offset++;
-        if (ctx->dynamic_offset > ctx->max_dynamic_offset) {
-            ctx->max_dynamic_offset = ctx->dynamic_offset;
-            bh_assert(ctx->max_dynamic_offset < INT16_MAX);
+        ctx->frame_offset++;
+        if (!disable_emit) {
+            ctx->dynamic_offset++;
+            if (ctx->dynamic_offset > ctx->max_dynamic_offset) {
+                ctx->max_dynamic_offset = ctx->dynamic_offset;
+                bh_assert(ctx->max_dynamic_offset < INT16_MAX);
+            }
         }
     }
     return true;
@@ -4952,13 +5157,17 @@ wasm_loader_pop_frame_offset(WASMLoaderContext *ctx, uint8 type,
             ctx->dynamic_offset -= 1;
     }
     else {
-        if (!check_offset_pop(ctx, 2))
+        /* i64/f64 take 2 cells and v128 takes 4 cells */
+        int16 cell_num =
+            is_64bit_type(type) ? 2 : (int16)wasm_value_type_cell_num(type);
+
+        if (!check_offset_pop(ctx, cell_num))
             return true;
 
-        ctx->frame_offset -= 2;
+        ctx->frame_offset -= cell_num;
         if ((*(ctx->frame_offset) > ctx->start_dynamic_offset)
             && (*(ctx->frame_offset) < ctx->max_dynamic_offset))
-            ctx->dynamic_offset -= 2;
+            ctx->dynamic_offset -= cell_num;
     }
     emit_operand(ctx, *(ctx->frame_offset));
     return true;
@@ -5044,13 +5253,21 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
                 || (type == VALUE_TYPE_F64
                     && (0 == memcmp(value, &(c->value.f64), sizeof(float64))))
                 || (type == VALUE_TYPE_F32
-                    && (0
-                        == memcmp(value, &(c->value.f32), sizeof(float32)))))) {
+                    && (0 == memcmp(value, &(c->value.f32), sizeof(float32))))
+#if WASM_ENABLE_SIMD != 0
+                || (type == VALUE_TYPE_V128
+                    && (0 == memcmp(value, &(c->value.v128), sizeof(V128))))
+#endif
+                    )) {
             operand_offset = c->slot_index;
             break;
         }
         if (c->value_type == VALUE_TYPE_I64 || c->value_type == VALUE_TYPE_F64)
             operand_offset += 2;
+#if WASM_ENABLE_SIMD != 0
+        else if (c->value_type == VALUE_TYPE_V128)
+            operand_offset += 4;
+#endif
         else
             operand_offset += 1;
     }
@@ -5060,6 +5277,11 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
         if ((type == VALUE_TYPE_F64) || (type == VALUE_TYPE_I64)) {
             bytes_to_increase = 2;
         }
+#if WASM_ENABLE_SIMD != 0
+        else if (type == VALUE_TYPE_V128) {
+            bytes_to_increase = 4;
+        }
+#endif
         else {
             bytes_to_increase = 1;
         }
@@ -5102,6 +5324,15 @@ wasm_loader_get_const_offset(WASMLoaderContext *ctx, uint8 type, void *value,
                 c->value.i32 = *(int32 *)value;
                 ctx->const_cell_num++;
                 break;
+#if WASM_ENABLE_SIMD != 0
+            case VALUE_TYPE_V128:
+                bh_memcpy_s(&(c->value.v128), sizeof(WASMValue), value,
+                            sizeof(V128));
+                ctx->const_cell_num += 4;
+                /* Use the fourth cell of the v128 const like i64/f64 */
+                operand_offset += 3;
+                break;
+#endif
 #if WASM_ENABLE_REF_TYPES != 0
             case VALUE_TYPE_EXTERNREF:
             case VALUE_TYPE_FUNCREF:
@@ -5181,6 +5412,16 @@ fail:
             goto fail;                                                         \
     } while (0)
 
+#if WASM_ENABLE_SIMD != 0
+#define PUSH_V128()                                                          \
+    do {                                                                     \
+        if (!wasm_loader_push_frame_ref_offset(loader_ctx, VALUE_TYPE_V128,  \
+                                               disable_emit, operand_offset, \
+                                               error_buf, error_buf_size))   \
+            goto fail;                                                       \
+    } while (0)
+#endif
+
 #define POP_I32()                                                         \
     do {                                                                  \
         if (!wasm_loader_pop_frame_ref_offset(loader_ctx, VALUE_TYPE_I32, \
@@ -5209,6 +5450,15 @@ fail:
             goto fail;                                                    \
     } while (0)
 
+#if WASM_ENABLE_SIMD != 0
+#define POP_V128()                                                         \
+    do {                                                                   \
+        if (!wasm_loader_pop_frame_ref_offset(loader_ctx, VALUE_TYPE_V128, \
+                                              error_buf, error_buf_size))  \
+            goto fail;                                                     \
+    } while (0)
+#endif
+
 #define PUSH_OFFSET_TYPE(type)                                              \
     do {                                                                    \
         if (!(wasm_loader_push_frame_offset(loader_ctx, type, disable_emit, \
@@ -5381,17 +5631,24 @@ reserve_block_ret(WASMLoaderContext *loader_ctx, uint8 opcode,
 
     return_count = block_type_get_result_types(block_type, &return_types);
 
-    /* If there is only one return value, use EXT_OP_COPY_STACK_TOP/_I64 instead
-     * of EXT_OP_COPY_STACK_VALUES for interpreter performance. */
+    /* If there is only one return value, use EXT_OP_COPY_STACK_TOP/_I64/_V128
+     * instead of EXT_OP_COPY_STACK_VALUES for interpreter performance. */
     if (return_count == 1) {
         uint8 cell = (uint8)wasm_value_type_cell_num(return_types[0]);
-        if (cell <= 2 /* V128 isn't supported whose cell num is 4 */
-            && block->dynamic_offset != *(loader_ctx->frame_offset - cell)) {
+        if (block->dynamic_offset != *(loader_ctx->frame_offset - cell)) {
             /* insert op_copy before else opcode */
             if (opcode == WASM_OP_ELSE)
                 skip_label();
-            emit_label(cell == 1 ? EXT_OP_COPY_STACK_TOP
-                                 : EXT_OP_COPY_STACK_TOP_I64);
+#if WASM_ENABLE_SIMD != 0
+            if (cell == 4) {
+                emit_label(EXT_OP_COPY_STACK_TOP_V128);
+            }
+            else
+#endif
+            {
+                emit_label(cell == 1 ? EXT_OP_COPY_STACK_TOP
+                                     : EXT_OP_COPY_STACK_TOP_I64);
+            }
             emit_operand(loader_ctx, *(loader_ctx->frame_offset - cell));
             emit_operand(loader_ctx, block->dynamic_offset);
 
@@ -6037,12 +6294,18 @@ re_scan:
 #endif
 
     PUSH_CSP(LABEL_TYPE_FUNCTION, func_block_type, p);
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL_METERING != 0
+    loader_ctx->fuel_region_cost = 0;
+#endif
 
     while (p < p_end) {
         opcode = *p++;
 #if WASM_ENABLE_FAST_INTERP != 0
         p_org = p;
         disable_emit = false;
+#if WASM_ENABLE_FUEL_METERING != 0
+        emit_fuel_charge(loader_ctx, opcode, p, p_end);
+#endif
         emit_label(opcode);
 #endif
 
@@ -6254,6 +6517,8 @@ re_scan:
                                     (uint32)size);
                     }
 
+                    fuse_i32_cmp_and_branch(loader_ctx, last_op, opcode);
+
                     block->start_dynamic_offset = loader_ctx->dynamic_offset;
 
                     emit_empty_label_addr_and_frame_ip(PATCH_ELSE);
@@ -6337,6 +6602,12 @@ re_scan:
                     skip_label();
                     disable_emit = false;
                     emit_label(opcode);
+#if WASM_ENABLE_FUEL_METERING != 0
+                    /* The end is scanned again after the virtual else,
+                       it has been charged before the else, and isn't
+                       reached by the if-false branch */
+                    loader_ctx->fuel_region_cost = -1;
+#endif
 #endif
                     goto handle_op_else;
                 }
@@ -6389,6 +6660,9 @@ re_scan:
             case WASM_OP_BR_IF:
             {
                 POP_I32();
+#if WASM_ENABLE_FAST_INTERP != 0
+                fuse_i32_cmp_and_branch(loader_ctx, last_op, opcode);
+#endif
 
                 if (!(frame_csp_tmp =
                           check_branch_block(loader_ctx, &p, p_end, opcode,
@@ -6710,6 +6984,19 @@ re_scan:
                             loader_ctx->dynamic_offset -= 2;
 #endif
                     }
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+                    else if (*(loader_ctx->frame_ref - 1) == VALUE_TYPE_V128) {
+                        loader_ctx->frame_ref -= 4;
+                        loader_ctx->stack_cell_num -= 4;
+                        skip_label();
+                        loader_ctx->frame_offset -= 4;
+                        if ((*(loader_ctx->frame_offset)
+                             > loader_ctx->start_dynamic_offset)
+                            && (*(loader_ctx->frame_offset)
+                                < loader_ctx->max_dynamic_offset))
+                            loader_ctx->dynamic_offset -= 4;
+                    }
+#endif
                     else {
                         bh_assert(0);
                     }
@@ -6747,12 +7034,20 @@ re_scan:
                             break;
                         case REF_I64_2:
                         case REF_F64_2:
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+                        case VALUE_TYPE_V128:
+#endif
 #if WASM_ENABLE_FAST_INTERP == 0
                             *(p - 1) = WASM_OP_SELECT_64;
 #endif
 #if WASM_ENABLE_FAST_INTERP != 0
                             if (loader_ctx->p_code_compiled) {
                                 uint8 opcode_tmp = WASM_OP_SELECT_64;
+#if WASM_ENABLE_SIMD != 0
+                                if (*(loader_ctx->frame_ref - 1)
+                                    == VALUE_TYPE_V128)
+                                    opcode_tmp = WASM_OP_SELECT_128;
+#endif
 #if WASM_ENABLE_LABELS_AS_VALUES != 0
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
                                 *(void **)(p_code_compiled_tmp
@@ -6842,6 +7137,10 @@ re_scan:
                     if (ref_type == VALUE_TYPE_F64
                         || ref_type == VALUE_TYPE_I64)
                         opcode_tmp = WASM_OP_SELECT_64;
+#if WASM_ENABLE_SIMD != 0
+                    else if (ref_type == VALUE_TYPE_V128)
+                        opcode_tmp = WASM_OP_SELECT_128;
+#endif
 
 #if WASM_ENABLE_LABELS_AS_VALUES != 0
 #if WASM_CPU_SUPPORTS_UNALIGNED_ADDR_ACCESS != 0
@@ -7109,6 +7408,12 @@ re_scan:
                             emit_label(EXT_OP_SET_LOCAL_FAST);
                             emit_byte(loader_ctx, (uint8)local_offset);
                         }
+#if WASM_ENABLE_SIMD != 0
+                        else if (local_type == VALUE_TYPE_V128) {
+                            emit_label(EXT_OP_SET_LOCAL_FAST_V128);
+                            emit_byte(loader_ctx, (uint8)local_offset);
+                        }
+#endif
                         else {
                             emit_label(EXT_OP_SET_LOCAL_FAST_I64);
                             emit_byte(loader_ctx, (uint8)local_offset);
@@ -7167,6 +7472,12 @@ re_scan:
                         emit_label(EXT_OP_TEE_LOCAL_FAST);
                         emit_byte(loader_ctx, (uint8)local_offset);
                     }
+#if WASM_ENABLE_SIMD != 0
+                    else if (local_type == VALUE_TYPE_V128) {
+                        emit_label(EXT_OP_TEE_LOCAL_FAST_V128);
+                        emit_byte(loader_ctx, (uint8)local_offset);
+                    }
+#endif
                     else {
                         emit_label(EXT_OP_TEE_LOCAL_FAST_I64);
                         emit_byte(loader_ctx, (uint8)local_offset);
@@ -7221,6 +7532,12 @@ re_scan:
                     skip_label();
                     emit_label(WASM_OP_GET_GLOBAL_64);
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (global_type == VALUE_TYPE_V128) {
+                    skip_label();
+                    emit_label(WASM_OP_GET_GLOBAL_V128);
+                }
+#endif
                 emit_uint32(loader_ctx, global_idx);
                 PUSH_OFFSET_TYPE(global_type);
 #endif /* end of WASM_ENABLE_FAST_INTERP */
@@ -7268,6 +7585,12 @@ re_scan:
                     skip_label();
                     emit_label(WASM_OP_SET_GLOBAL_64);
                 }
+#if WASM_ENABLE_SIMD != 0
+                else if (global_type == VALUE_TYPE_V128) {
+                    skip_label();
+                    emit_label(WASM_OP_SET_GLOBAL_V128);
+                }
+#endif
                 else if (module->aux_stack_size > 0
                          && global_idx == module->aux_stack_top_global_index) {
                     skip_label();
@@ -7493,7 +7816,18 @@ re_scan:
                 break;
 
             case WASM_OP_I32_EQZ:
+#if WASM_ENABLE_FAST_INTERP != 0
+                wasm_loader_record_fusible_cmp(
+                    &loader_ctx->fusible_cmp, loader_ctx->frame_offset,
+                    loader_ctx->stack_cell_num
+                        - (loader_ctx->frame_csp - 1)->stack_cell_num,
+                    1);
+#endif
                 POP_AND_PUSH(VALUE_TYPE_I32, VALUE_TYPE_I32);
+#if WASM_ENABLE_FAST_INTERP != 0
+                loader_ctx->fusible_cmp.code_end =
+                    wasm_loader_get_code_offset(loader_ctx);
+#endif
                 break;
 
             case WASM_OP_I32_EQ:
@@ -7506,7 +7840,18 @@ re_scan:
             case WASM_OP_I32_LE_U:
             case WASM_OP_I32_GE_S:
             case WASM_OP_I32_GE_U:
+#if WASM_ENABLE_FAST_INTERP != 0
+                wasm_loader_record_fusible_cmp(
+                    &loader_ctx->fusible_cmp, loader_ctx->frame_offset,
+                    loader_ctx->stack_cell_num
+                        - (loader_ctx->frame_csp - 1)->stack_cell_num,
+                    2);
+#endif
                 POP2_AND_PUSH(VALUE_TYPE_I32, VALUE_TYPE_I32);
+#if WASM_ENABLE_FAST_INTERP != 0
+                loader_ctx->fusible_cmp.code_end =
+                    wasm_loader_get_code_offset(loader_ctx);
+#endif
                 break;
 
             case WASM_OP_I64_EQZ:
@@ -7961,6 +8306,422 @@ re_scan:
                 break;
             }
 
+#if WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0
+            case WASM_OP_SIMD_PREFIX:
+            {
+                uint32 opcode1;
+
+                read_leb_uint32(p, p_end, opcode1);
+                /* v128.const is emitted as a const slot if possible */
+                if (opcode1 != SIMD_v128_const)
+                    emit_byte(loader_ctx, (uint8)opcode1);
+
+                /* follow the order of enum WASMSimdEXTOpcode in wasm_opcode.h
+                 */
+                switch (opcode1) {
+                    /* memory instruction */
+                    case SIMD_v128_load:
+                    case SIMD_v128_load8x8_s:
+                    case SIMD_v128_load8x8_u:
+                    case SIMD_v128_load16x4_s:
+                    case SIMD_v128_load16x4_u:
+                    case SIMD_v128_load32x2_s:
+                    case SIMD_v128_load32x2_u:
+                    case SIMD_v128_load8_splat:
+                    case SIMD_v128_load16_splat:
+                    case SIMD_v128_load32_splat:
+                    case SIMD_v128_load64_splat:
+                    case SIMD_v128_load32_zero:
+                    case SIMD_v128_load64_zero:
+                    {
+                        CHECK_MEMORY();
+                        read_leb_uint32(p, p_end, align);          /* align */
+                        read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+                        emit_uint32(loader_ctx, mem_offset);
+
+                        POP_AND_PUSH(mem_offset_type, VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    case SIMD_v128_store:
+                    {
+                        CHECK_MEMORY();
+                        read_leb_uint32(p, p_end, align);          /* align */
+                        read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+                        emit_uint32(loader_ctx, mem_offset);
+
+                        POP_V128();
+                        POP_MEM_OFFSET();
+                        break;
+                    }
+
+                    /* basic operation */
+                    case SIMD_v128_const:
+                    {
+                        V128 v128_const;
+
+                        CHECK_BUF1(p, p_end, 16);
+                        bh_memcpy_s(&v128_const, sizeof(V128), p, 16);
+                        p += 16;
+
+                        skip_label();
+                        disable_emit = true;
+                        GET_CONST_OFFSET(VALUE_TYPE_V128, v128_const);
+
+                        if (operand_offset == 0) {
+                            disable_emit = false;
+                            emit_label(WASM_OP_SIMD_PREFIX);
+                            emit_byte(loader_ctx, SIMD_v128_const);
+                            emit_v128(loader_ctx, v128_const);
+                        }
+                        PUSH_V128();
+                        break;
+                    }
+
+                    case SIMD_v8x16_shuffle:
+                    {
+                        V128 mask;
+
+                        CHECK_BUF1(p, p_end, 16);
+                        bh_memcpy_s(&mask, sizeof(V128), p, 16);
+                        p += 16;
+                        emit_v128(loader_ctx, mask);
+
+                        POP2_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    /* splat operation */
+                    case SIMD_i8x16_splat:
+                    case SIMD_i16x8_splat:
+                    case SIMD_i32x4_splat:
+                    case SIMD_i64x2_splat:
+                    case SIMD_f32x4_splat:
+                    case SIMD_f64x2_splat:
+                    {
+                        uint8 pop_type[] = { VALUE_TYPE_I32, VALUE_TYPE_I32,
+                                             VALUE_TYPE_I32, VALUE_TYPE_I64,
+                                             VALUE_TYPE_F32, VALUE_TYPE_F64 };
+                        POP_AND_PUSH(pop_type[opcode1 - SIMD_i8x16_splat],
+                                     VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    /* lane operation */
+                    case SIMD_i8x16_extract_lane_s:
+                    case SIMD_i8x16_extract_lane_u:
+                    case SIMD_i8x16_replace_lane:
+                    case SIMD_i16x8_extract_lane_s:
+                    case SIMD_i16x8_extract_lane_u:
+                    case SIMD_i16x8_replace_lane:
+                    case SIMD_i32x4_extract_lane:
+                    case SIMD_i32x4_replace_lane:
+                    case SIMD_i64x2_extract_lane:
+                    case SIMD_i64x2_replace_lane:
+                    case SIMD_f32x4_extract_lane:
+                    case SIMD_f32x4_replace_lane:
+                    case SIMD_f64x2_extract_lane:
+                    case SIMD_f64x2_replace_lane:
+                    {
+                        uint8 lane;
+                        /* clang-format off */
+                        uint8 replace[] = {
+                            /*i8x16*/ 0x0, 0x0, VALUE_TYPE_I32,
+                            /*i16x8*/ 0x0, 0x0, VALUE_TYPE_I32,
+                            /*i32x4*/ 0x0, VALUE_TYPE_I32,
+                            /*i64x2*/ 0x0, VALUE_TYPE_I64,
+                            /*f32x4*/ 0x0, VALUE_TYPE_F32,
+                            /*f64x2*/ 0x0, VALUE_TYPE_F64,
+                        };
+                        uint8 push_type[] = {
+                            /*i8x16*/ VALUE_TYPE_I32, VALUE_TYPE_I32,
+                                      VALUE_TYPE_V128,
+                            /*i16x8*/ VALUE_TYPE_I32, VALUE_TYPE_I32,
+                                      VALUE_TYPE_V128,
+                            /*i32x4*/ VALUE_TYPE_I32, VALUE_TYPE_V128,
+                            /*i64x2*/ VALUE_TYPE_I64, VALUE_TYPE_V128,
+                            /*f32x4*/ VALUE_TYPE_F32, VALUE_TYPE_V128,
+                            /*f64x2*/ VALUE_TYPE_F64, VALUE_TYPE_V128,
+                        };
+                        /* clang-format on */
+
+                        CHECK_BUF(p, p_end, 1);
+                        lane = read_uint8(p);
+                        emit_byte(loader_ctx, lane);
+
+                        if (replace[opcode1 - SIMD_i8x16_extract_lane_s]) {
+                            if (!(wasm_loader_pop_frame_ref_offset(
+                                    loader_ctx,
+                                    replace[opcode1
+                                            - SIMD_i8x16_extract_lane_s],
+                                    error_buf, error_buf_size)))
+                                goto fail;
+                        }
+
+                        POP_AND_PUSH(
+                            VALUE_TYPE_V128,
+                            push_type[opcode1 - SIMD_i8x16_extract_lane_s]);
+                        break;
+                    }
+
+                    case SIMD_v128_bitselect:
+                    {
+                        POP_V128();
+                        POP2_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    case SIMD_v128_any_true:
+                    case SIMD_i8x16_all_true:
+                    case SIMD_i8x16_bitmask:
+                    case SIMD_i16x8_all_true:
+                    case SIMD_i16x8_bitmask:
+                    case SIMD_i32x4_all_true:
+                    case SIMD_i32x4_bitmask:
+                    case SIMD_i64x2_all_true:
+                    case SIMD_i64x2_bitmask:
+                    {
+                        POP_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_I32);
+                        break;
+                    }
+
+                    /* load lane operation */
+                    case SIMD_v128_load8_lane:
+                    case SIMD_v128_load16_lane:
+                    case SIMD_v128_load32_lane:
+                    case SIMD_v128_load64_lane:
+                    case SIMD_v128_store8_lane:
+                    case SIMD_v128_store16_lane:
+                    case SIMD_v128_store32_lane:
+                    case SIMD_v128_store64_lane:
+                    {
+                        uint8 lane;
+
+                        CHECK_MEMORY();
+                        read_leb_uint32(p, p_end, align);          /* align */
+                        read_leb_mem_offset(p, p_end, mem_offset); /* offset */
+                        emit_uint32(loader_ctx, mem_offset);
+
+                        CHECK_BUF(p, p_end, 1);
+                        lane = read_uint8(p);
+                        emit_byte(loader_ctx, lane);
+
+                        POP_V128();
+                        POP_MEM_OFFSET();
+                        if (opcode1 < SIMD_v128_store8_lane) {
+                            PUSH_V128();
+                        }
+                        break;
+                    }
+
+                    case SIMD_i8x16_shl:
+                    case SIMD_i8x16_shr_s:
+                    case SIMD_i8x16_shr_u:
+                    case SIMD_i16x8_shl:
+                    case SIMD_i16x8_shr_s:
+                    case SIMD_i16x8_shr_u:
+                    case SIMD_i32x4_shl:
+                    case SIMD_i32x4_shr_s:
+                    case SIMD_i32x4_shr_u:
+                    case SIMD_i64x2_shl:
+                    case SIMD_i64x2_shr_s:
+                    case SIMD_i64x2_shr_u:
+                    {
+                        POP_I32();
+                        POP_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    /* unary operation */
+                    case SIMD_v128_not:
+                    case SIMD_f32x4_demote_f64x2_zero:
+                    case SIMD_f64x2_promote_low_f32x4_zero:
+                    case SIMD_i8x16_abs:
+                    case SIMD_i8x16_neg:
+                    case SIMD_i8x16_popcnt:
+                    case SIMD_f32x4_ceil:
+                    case SIMD_f32x4_floor:
+                    case SIMD_f32x4_trunc:
+                    case SIMD_f32x4_nearest:
+                    case SIMD_f64x2_ceil:
+                    case SIMD_f64x2_floor:
+                    case SIMD_f64x2_trunc:
+                    case SIMD_f64x2_nearest:
+                    case SIMD_i16x8_extadd_pairwise_i8x16_s:
+                    case SIMD_i16x8_extadd_pairwise_i8x16_u:
+                    case SIMD_i32x4_extadd_pairwise_i16x8_s:
+                    case SIMD_i32x4_extadd_pairwise_i16x8_u:
+                    case SIMD_i16x8_abs:
+                    case SIMD_i16x8_neg:
+                    case SIMD_i16x8_extend_low_i8x16_s:
+                    case SIMD_i16x8_extend_high_i8x16_s:
+                    case SIMD_i16x8_extend_low_i8x16_u:
+                    case SIMD_i16x8_extend_high_i8x16_u:
+                    case SIMD_i32x4_abs:
+                    case SIMD_i32x4_neg:
+                    case SIMD_i32x4_extend_low_i16x8_s:
+                    case SIMD_i32x4_extend_high_i16x8_s:
+                    case SIMD_i32x4_extend_low_i16x8_u:
+                    case SIMD_i32x4_extend_high_i16x8_u:
+                    case SIMD_i64x2_abs:
+                    case SIMD_i64x2_neg:
+                    case SIMD_i64x2_extend_low_i32x4_s:
+                    case SIMD_i64x2_extend_high_i32x4_s:
+                    case SIMD_i64x2_extend_low_i32x4_u:
+                    case SIMD_i64x2_extend_high_i32x4_u:
+                    case SIMD_f32x4_abs:
+                    case SIMD_f32x4_neg:
+                    case SIMD_f32x4_sqrt:
+                    case SIMD_f64x2_abs:
+                    case SIMD_f64x2_neg:
+                    case SIMD_f64x2_sqrt:
+                    case SIMD_i32x4_trunc_sat_f32x4_s:
+                    case SIMD_i32x4_trunc_sat_f32x4_u:
+                    case SIMD_f32x4_convert_i32x4_s:
+                    case SIMD_f32x4_convert_i32x4_u:
+                    case SIMD_i32x4_trunc_sat_f64x2_s_zero:
+                    case SIMD_i32x4_trunc_sat_f64x2_u_zero:
+                    case SIMD_f64x2_convert_low_i32x4_s:
+                    case SIMD_f64x2_convert_low_i32x4_u:
+                    {
+                        POP_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    /* binary operation */
+                    case SIMD_v8x16_swizzle:
+                    case SIMD_i8x16_eq:
+                    case SIMD_i8x16_ne:
+                    case SIMD_i8x16_lt_s:
+                    case SIMD_i8x16_lt_u:
+                    case SIMD_i8x16_gt_s:
+                    case SIMD_i8x16_gt_u:
+                    case SIMD_i8x16_le_s:
+                    case SIMD_i8x16_le_u:
+                    case SIMD_i8x16_ge_s:
+                    case SIMD_i8x16_ge_u:
+                    case SIMD_i16x8_eq:
+                    case SIMD_i16x8_ne:
+                    case SIMD_i16x8_lt_s:
+                    case SIMD_i16x8_lt_u:
+                    case SIMD_i16x8_gt_s:
+                    case SIMD_i16x8_gt_u:
+                    case SIMD_i16x8_le_s:
+                    case SIMD_i16x8_le_u:
+                    case SIMD_i16x8_ge_s:
+                    case SIMD_i16x8_ge_u:
+                    case SIMD_i32x4_eq:
+                    case SIMD_i32x4_ne:
+                    case SIMD_i32x4_lt_s:
+                    case SIMD_i32x4_lt_u:
+                    case SIMD_i32x4_gt_s:
+                    case SIMD_i32x4_gt_u:
+                    case SIMD_i32x4_le_s:
+                    case SIMD_i32x4_le_u:
+                    case SIMD_i32x4_ge_s:
+                    case SIMD_i32x4_ge_u:
+                    case SIMD_f32x4_eq:
+                    case SIMD_f32x4_ne:
+                    case SIMD_f32x4_lt:
+                    case SIMD_f32x4_gt:
+                    case SIMD_f32x4_le:
+                    case SIMD_f32x4_ge:
+                    case SIMD_f64x2_eq:
+                    case SIMD_f64x2_ne:
+                    case SIMD_f64x2_lt:
+                    case SIMD_f64x2_gt:
+                    case SIMD_f64x2_le:
+                    case SIMD_f64x2_ge:
+                    case SIMD_v128_and:
+                    case SIMD_v128_andnot:
+                    case SIMD_v128_or:
+                    case SIMD_v128_xor:
+                    case SIMD_i8x16_narrow_i16x8_s:
+                    case SIMD_i8x16_narrow_i16x8_u:
+                    case SIMD_i8x16_add:
+                    case SIMD_i8x16_add_sat_s:
+                    case SIMD_i8x16_add_sat_u:
+                    case SIMD_i8x16_sub:
+                    case SIMD_i8x16_sub_sat_s:
+                    case SIMD_i8x16_sub_sat_u:
+                    case SIMD_i8x16_min_s:
+                    case SIMD_i8x16_min_u:
+                    case SIMD_i8x16_max_s:
+                    case SIMD_i8x16_max_u:
+                    case SIMD_i8x16_avgr_u:
+                    case SIMD_i16x8_q15mulr_sat_s:
+                    case SIMD_i16x8_narrow_i32x4_s:
+                    case SIMD_i16x8_narrow_i32x4_u:
+                    case SIMD_i16x8_add:
+                    case SIMD_i16x8_add_sat_s:
+                    case SIMD_i16x8_add_sat_u:
+                    case SIMD_i16x8_sub:
+                    case SIMD_i16x8_sub_sat_s:
+                    case SIMD_i16x8_sub_sat_u:
+                    case SIMD_i16x8_mul:
+                    case SIMD_i16x8_min_s:
+                    case SIMD_i16x8_min_u:
+                    case SIMD_i16x8_max_s:
+                    case SIMD_i16x8_max_u:
+                    case SIMD_i16x8_avgr_u:
+                    case SIMD_i16x8_extmul_low_i8x16_s:
+                    case SIMD_i16x8_extmul_high_i8x16_s:
+                    case SIMD_i16x8_extmul_low_i8x16_u:
+                    case SIMD_i16x8_extmul_high_i8x16_u:
+                    case SIMD_i32x4_add:
+                    case SIMD_i32x4_sub:
+                    case SIMD_i32x4_mul:
+                    case SIMD_i32x4_min_s:
+                    case SIMD_i32x4_min_u:
+                    case SIMD_i32x4_max_s:
+                    case SIMD_i32x4_max_u:
+                    case SIMD_i32x4_dot_i16x8_s:
+                    case SIMD_i32x4_extmul_low_i16x8_s:
+                    case SIMD_i32x4_extmul_high_i16x8_s:
+                    case SIMD_i32x4_extmul_low_i16x8_u:
+                    case SIMD_i32x4_extmul_high_i16x8_u:
+                    case SIMD_i64x2_add:
+                    case SIMD_i64x2_sub:
+                    case SIMD_i64x2_mul:
+                    case SIMD_i64x2_eq:
+                    case SIMD_i64x2_ne:
+                    case SIMD_i64x2_lt_s:
+                    case SIMD_i64x2_gt_s:
+                    case SIMD_i64x2_le_s:
+                    case SIMD_i64x2_ge_s:
+                    case SIMD_i64x2_extmul_low_i32x4_s:
+                    case SIMD_i64x2_extmul_high_i32x4_s:
+                    case SIMD_i64x2_extmul_low_i32x4_u:
+                    case SIMD_i64x2_extmul_high_i32x4_u:
+                    case SIMD_f32x4_add:
+                    case SIMD_f32x4_sub:
+                    case SIMD_f32x4_mul:
+                    case SIMD_f32x4_div:
+                    case SIMD_f32x4_min:
+                    case SIMD_f32x4_max:
+                    case SIMD_f32x4_pmin:
+                    case SIMD_f32x4_pmax:
+                    case SIMD_f64x2_add:
+                    case SIMD_f64x2_sub:
+                    case SIMD_f64x2_mul:
+                    case SIMD_f64x2_div:
+                    case SIMD_f64x2_min:
+                    case SIMD_f64x2_max:
+                    case SIMD_f64x2_pmin:
+                    case SIMD_f64x2_pmax:
+                    {
+                        POP2_AND_PUSH(VALUE_TYPE_V128, VALUE_TYPE_V128);
+                        break;
+                    }
+
+                    default:
+                        bh_assert(0);
+                        break;
+                }
+                break;
+            }
+#endif /* end of WASM_ENABLE_SIMD != 0 && WASM_ENABLE_FAST_INTERP != 0 */
+
 #if WASM_ENABLE_SHARED_MEMORY != 0
             case WASM_OP_ATOMIC_PREFIX:
             {
@@ -8142,6 +8903,13 @@ re_scan:
                             &(c->value.f64), (uint32)sizeof(int64));
                 func_const += sizeof(int64);
             }
+#if WASM_ENABLE_SIMD != 0
+            else if (c->value_type == VALUE_TYPE_V128) {
+                bh_memcpy_s(func_const, (uint32)(func_const_end - func_const),
+                            &(c->value.v128), (uint32)sizeof(V128));
+                func_const += sizeof(V128);
+            }
+#endif
             else {
                 bh_memcpy_s(func_const, (uint32)(func_const_end - func_const),
                             &(c->value.f32), (uint32)sizeof(int32));
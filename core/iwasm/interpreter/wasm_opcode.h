@@ -278,6 +278,44 @@ typedef enum WASMOpcode {
     DEBUG_OP_BREAK = 0xdc, /* debug break point */
 #endif
 
+    /* v128 variants of the ops above, only used by fast interpreter */
+    EXT_OP_SET_LOCAL_FAST_V128 = 0xdd,
+    EXT_OP_TEE_LOCAL_FAST_V128 = 0xde,
+    EXT_OP_COPY_STACK_TOP_V128 = 0xdf,
+    WASM_OP_GET_GLOBAL_V128 = 0xe0,
+    WASM_OP_SET_GLOBAL_V128 = 0xe1,
+    WASM_OP_SELECT_128 = 0xe2,
+
+    /* i32 comparisons fused with the following br_if or if, only used
+       by fast interpreter */
+    EXT_OP_BR_IF_I32_EQZ = 0xe3,
+    EXT_OP_BR_IF_I32_EQ = 0xe4,
+    EXT_OP_BR_IF_I32_NE = 0xe5,
+    EXT_OP_BR_IF_I32_LT_S = 0xe6,
+    EXT_OP_BR_IF_I32_LT_U = 0xe7,
+    EXT_OP_BR_IF_I32_GT_S = 0xe8,
+    EXT_OP_BR_IF_I32_GT_U = 0xe9,
+    EXT_OP_BR_IF_I32_LE_S = 0xea,
+    EXT_OP_BR_IF_I32_LE_U = 0xeb,
+    EXT_OP_BR_IF_I32_GE_S = 0xec,
+    EXT_OP_BR_IF_I32_GE_U = 0xed,
+
+    EXT_OP_IF_I32_EQZ = 0xee,
+    EXT_OP_IF_I32_EQ = 0xef,
+    EXT_OP_IF_I32_NE = 0xf0,
+    EXT_OP_IF_I32_LT_S = 0xf1,
+    EXT_OP_IF_I32_LT_U = 0xf2,
+    EXT_OP_IF_I32_GT_S = 0xf3,
+    EXT_OP_IF_I32_GT_U = 0xf4,
+    EXT_OP_IF_I32_LE_S = 0xf5,
+    EXT_OP_IF_I32_LE_U = 0xf6,
+    EXT_OP_IF_I32_GE_S = 0xf7,
+    EXT_OP_IF_I32_GE_U = 0xf8,
+
+    /* charge the fuel of exec_env with the instruction count of the
+       region ending here, only used by fast interpreter */
+    EXT_OP_CHARGE_FUEL = 0xf9,
+
     /* Post-MVP extend op prefix */
     WASM_OP_GC_PREFIX = 0xfb,
     WASM_OP_MISC_PREFIX = 0xfc,
@@ -782,13 +820,61 @@ typedef enum WASMAtomicEXTOpcode {
 
 #define SET_GOTO_TABLE_ELEM(opcode) [opcode] = HANDLE_OPCODE(opcode)
 
-#if WASM_ENABLE_JIT != 0 && WASM_ENABLE_SIMD != 0
+#if (WASM_ENABLE_JIT != 0 || WASM_ENABLE_FAST_INTERP != 0) \
+    && WASM_ENABLE_SIMD != 0
 #define SET_GOTO_TABLE_SIMD_PREFIX_ELEM() \
     SET_GOTO_TABLE_ELEM(WASM_OP_SIMD_PREFIX),
 #else
 #define SET_GOTO_TABLE_SIMD_PREFIX_ELEM()
 #endif
 
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_SIMD != 0
+#define DEF_EXT_V128_HANDLE()                                       \
+    SET_GOTO_TABLE_ELEM(EXT_OP_SET_LOCAL_FAST_V128),     /* 0xdd */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_TEE_LOCAL_FAST_V128), /* 0xde */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_COPY_STACK_TOP_V128), /* 0xdf */ \
+        SET_GOTO_TABLE_ELEM(WASM_OP_GET_GLOBAL_V128),    /* 0xe0 */ \
+        SET_GOTO_TABLE_ELEM(WASM_OP_SET_GLOBAL_V128),    /* 0xe1 */ \
+        SET_GOTO_TABLE_ELEM(WASM_OP_SELECT_128),         /* 0xe2 */
+#else
+#define DEF_EXT_V128_HANDLE()
+#endif
+
+#if WASM_ENABLE_FAST_INTERP != 0
+#define DEF_EXT_FUSED_CMP_HANDLE()                             \
+    SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_EQZ),      /* 0xe3 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_EQ),   /* 0xe4 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_NE),   /* 0xe5 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LT_S), /* 0xe6 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LT_U), /* 0xe7 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GT_S), /* 0xe8 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GT_U), /* 0xe9 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LE_S), /* 0xea */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_LE_U), /* 0xeb */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GE_S), /* 0xec */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_BR_IF_I32_GE_U), /* 0xed */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_EQZ),     /* 0xee */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_EQ),      /* 0xef */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_NE),      /* 0xf0 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_LT_S),    /* 0xf1 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_LT_U),    /* 0xf2 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_GT_S),    /* 0xf3 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_GT_U),    /* 0xf4 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_LE_S),    /* 0xf5 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_LE_U),    /* 0xf6 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_GE_S),    /* 0xf7 */ \
+        SET_GOTO_TABLE_ELEM(EXT_OP_IF_I32_GE_U),    /* 0xf8 */
+#else
+#define DEF_EXT_FUSED_CMP_HANDLE()
+#endif
+
+#if WASM_ENABLE_FAST_INTERP != 0 && WASM_ENABLE_FUEL_METERING != 0
+#define DEF_EXT_CHARGE_FUEL_HANDLE() \
+    SET_GOTO_TABLE_ELEM(EXT_OP_CHARGE_FUEL), /* 0xf9 */
+#else
+#define DEF_EXT_CHARGE_FUEL_HANDLE()
+#endif
+
 /*
  * Macro used to generate computed goto tables for the C interpreter.
  */
@@ -1021,8 +1107,59 @@ typedef enum WASMAtomicEXTOpcode {
         SET_GOTO_TABLE_SIMD_PREFIX_ELEM()            /* 0xfd */ \
         SET_GOTO_TABLE_ELEM(WASM_OP_ATOMIC_PREFIX),  /* 0xfe */ \
         DEF_DEBUG_BREAK_HANDLE()                                \
+        DEF_EXT_V128_HANDLE()                                   \
+        DEF_EXT_FUSED_CMP_HANDLE()                              \
+        DEF_EXT_CHARGE_FUEL_HANDLE()                            \
     };
 
+/* Whether the opcode is a control instruction which ends a region of
+   straight-line code for the fuel metering, the instruction count of
+   the region is charged when the instruction is reached, p points to
+   the byte following the opcode */
+static inline bool
+wasm_is_fuel_charging_opcode(uint8 opcode, const uint8 *p,
+                             const uint8 *p_end)
+{
+    uint32 sub_opcode = 0, shift = 0;
+    uint8 byte;
+
+    switch (opcode) {
+        case WASM_OP_LOOP:
+        case WASM_OP_IF:
+        case WASM_OP_ELSE:
+        case WASM_OP_END:
+        case WASM_OP_BR:
+        case WASM_OP_BR_IF:
+        case WASM_OP_BR_TABLE:
+        case WASM_OP_RETURN:
+        case WASM_OP_CALL:
+        case WASM_OP_CALL_INDIRECT:
+        case WASM_OP_RETURN_CALL:
+        case WASM_OP_RETURN_CALL_INDIRECT:
+        case WASM_OP_CALL_REF:
+        case WASM_OP_RETURN_CALL_REF:
+        case WASM_OP_BR_ON_NULL:
+        case WASM_OP_BR_ON_NON_NULL:
+        case EXT_OP_LOOP:
+        case EXT_OP_IF:
+        case EXT_OP_BR_TABLE_CACHE:
+            return true;
+        case WASM_OP_GC_PREFIX:
+            /* the sub opcode is leb128 encoded */
+            do {
+                if (p >= p_end || shift >= 32)
+                    return false;
+                byte = *p++;
+                sub_opcode |= (uint32)(byte & 0x7f) << shift;
+                shift += 7;
+            } while (byte & 0x80);
+            return sub_opcode == WASM_OP_BR_ON_CAST
+                   || sub_opcode == WASM_OP_BR_ON_CAST_FAIL;
+        default:
+            return false;
+    }
+}
+
 #ifdef __cplusplus
 }
 #endif
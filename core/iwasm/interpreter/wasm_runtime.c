@@ -18,6 +18,9 @@
 #if WASM_ENABLE_SHARED_MEMORY != 0
 #include "../common/wasm_shared_memory.h"
 #endif
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+#include "../common/wasm_module_snapshot.h"
+#endif
 #if WASM_ENABLE_THREAD_MGR != 0
 #include "../libraries/thread-mgr/thread_manager.h"
 #endif
@@ -80,9 +83,43 @@ wasm_load_from_sections(WASMSection *section_list, char *error_buf,
 void
 wasm_unload(WASMModule *module)
 {
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    if (module->snapshot)
+        wasm_module_snapshot_delete(module->snapshot);
+#endif
     wasm_loader_unload(module);
 }
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+bool
+wasm_prepare_func_lazily(WASMModuleInstance *module_inst,
+                         WASMFunctionInstance *func)
+{
+    WASMModule *module = module_inst->module;
+    const char *load_failed_prefix = "WASM module load failed: ";
+    char error_buf[128], *error = error_buf;
+    uint32 func_idx;
+
+    bh_assert(!func->is_import_func);
+    func_idx = (uint32)(func - module_inst->e->functions)
+               - module->import_function_count;
+
+    if (!wasm_loader_prepare_func_lazily(module, func_idx, error_buf,
+                                         sizeof(error_buf))) {
+        /* Trap with the validation error */
+        if (!strncmp(error, load_failed_prefix, strlen(load_failed_prefix)))
+            error += strlen(load_failed_prefix);
+        wasm_set_exception(module_inst, error);
+        return false;
+    }
+
+#if WASM_ENABLE_FAST_INTERP != 0
+    func->const_cell_num = (uint16)func->u.func->const_cell_num;
+#endif
+    return true;
+}
+#endif /* end of WASM_ENABLE_LAZY_FUNC_VALIDATION != 0 */
+
 static void *
 runtime_malloc(uint64 size, char *error_buf, uint32 error_buf_size)
 {
@@ -2117,7 +2154,8 @@ wasm_set_running_mode(WASMModuleInstance *module_inst, RunningMode running_mode)
 WASMModuleInstance *
 wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
                  WASMExecEnv *exec_env_main, uint32 stack_size,
-                 uint32 heap_size, uint32 max_memory_pages, char *error_buf,
+                 uint32 heap_size, uint32 max_memory_pages,
+                 const struct WASMModuleSnapshot *snapshot, char *error_buf,
                  uint32 error_buf_size)
 {
     WASMModuleInstance *module_inst;
@@ -2201,6 +2239,9 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
     module_inst->module = module;
     module_inst->e =
         (WASMModuleInstanceExtra *)((uint8 *)module_inst + extra_info_offset);
+#if WASM_ENABLE_SHARED_HEAP != 0
+    module_inst->e->common.shared_heap_start_off = UINT64_MAX;
+#endif
 
 #if WASM_ENABLE_MULTI_MODULE != 0
     module_inst->e->sub_module_inst_list =
@@ -2261,10 +2302,24 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
         if (!module_inst->e->common.gc_heap_pool)
             goto fail;
 
-        module_inst->e->common.gc_heap_handle = mem_allocator_create(
+        module_inst->e->common.gc_heap_handle = mem_allocator_create_gc_heap(
             module_inst->e->common.gc_heap_pool, gc_heap_size);
         if (!module_inst->e->common.gc_heap_handle)
             goto fail;
+
+#if WASM_ENABLE_GC_NURSERY != 0
+        /* The interpreter and the LLVM JIT code have write barriers for
+           the ref stores, the heap keeps working without nursery if the
+           nursery can't be enabled */
+        (void)mem_allocator_enable_nursery(
+            module_inst->e->common.gc_heap_handle);
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* Likewise the ref stores are preceded by the pre-write barrier,
+           the heap is collected stop-the-world if it fails to enable */
+        (void)mem_allocator_enable_incremental(
+            module_inst->e->common.gc_heap_handle);
+#endif
     }
 #endif
 
@@ -2458,8 +2513,10 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
         goto fail;
     }
 
-    /* Initialize the memory data with data segment section */
-    for (i = 0; i < module->data_seg_count; i++) {
+    /* Initialize the memory data with data segment section, the
+       memory of the instance created from a snapshot is restored
+       from the snapshot later */
+    for (i = 0; !snapshot && i < module->data_seg_count; i++) {
         WASMMemoryInstance *memory = NULL;
         uint8 *memory_data = NULL;
         uint64 memory_size = 0;
@@ -2634,7 +2691,8 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
 #endif /* end of WASM_ENABLE_GC != 0 */
 
     /* Initialize the table data with table segment section */
-    for (i = 0; module_inst->table_count > 0 && i < module->table_seg_count;
+    for (i = 0; !snapshot && module_inst->table_count > 0
+                && i < module->table_seg_count;
          i++) {
         WASMTableSeg *table_seg = module->table_segments + i;
         /* has check it in loader */
@@ -2945,6 +3003,17 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
         }
     }
 
+#if WASM_ENABLE_MEMORY_SNAPSHOT != 0
+    if (snapshot
+        && !wasm_module_snapshot_apply(snapshot,
+                                       (WASMModuleInstanceCommon *)module_inst,
+                                       error_buf, error_buf_size)) {
+        goto fail;
+    }
+#else
+    bh_assert(!snapshot);
+#endif
+
     /* Initialize the thread related data */
     if (stack_size == 0)
         stack_size = DEFAULT_WASM_STACK_SIZE;
@@ -3024,8 +3093,11 @@ wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
                 &module_inst->e->functions[module->start_function];
     }
 
-    if (!execute_post_instantiate_functions(module_inst, is_sub_inst,
-                                            exec_env_main)) {
+    /* The start function and the others have been executed before the
+       snapshot was taken */
+    if (!snapshot
+        && !execute_post_instantiate_functions(module_inst, is_sub_inst,
+                                               exec_env_main)) {
         set_error_buf(error_buf, error_buf_size, module_inst->cur_exception);
         goto fail;
     }
@@ -3133,6 +3205,10 @@ wasm_deinstantiate(WASMModuleInstance *module_inst, bool is_sub_inst)
         (WASMModuleInstanceCommon *)module_inst);
 #endif
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    wasm_runtime_detach_shared_heap((WASMModuleInstanceCommon *)module_inst);
+#endif
+
     if (module_inst->memory_count > 0)
         memories_deinstantiate(module_inst, module_inst->memories,
                                module_inst->memory_count);
@@ -3379,7 +3455,8 @@ wasm_call_function(WASMExecEnv *exec_env, WASMFunctionInstance *function,
     return !wasm_copy_exception(module_inst, NULL);
 }
 
-#if WASM_ENABLE_PERF_PROFILING != 0 || WASM_ENABLE_DUMP_CALL_STACK != 0
+#if WASM_ENABLE_PERF_PROFILING != 0 || WASM_ENABLE_DUMP_CALL_STACK != 0 \
+    || WASM_ENABLE_SAMPLING_PROFILING != 0
 /* look for the function name */
 static char *
 get_func_name_from_index(const WASMModuleInstance *inst, uint32 func_index)
@@ -3411,7 +3488,19 @@ get_func_name_from_index(const WASMModuleInstance *inst, uint32 func_index)
 
     return func_name;
 }
-#endif /*WASM_ENABLE_PERF_PROFILING != 0 || WASM_ENABLE_DUMP_CALL_STACK != 0*/
+
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+const char *
+wasm_get_func_name(const WASMModuleInstance *module_inst, uint32 func_index)
+{
+    if (func_index >= module_inst->e->function_count)
+        return NULL;
+    return get_func_name_from_index(module_inst, func_index);
+}
+#endif
+#endif /* end of WASM_ENABLE_PERF_PROFILING != 0        \
+          || WASM_ENABLE_DUMP_CALL_STACK != 0           \
+          || WASM_ENABLE_SAMPLING_PROFILING != 0 */
 
 #if WASM_ENABLE_PERF_PROFILING != 0
 void
@@ -4278,6 +4367,11 @@ llvm_jit_invoke_native(WASMExecEnv *exec_env, uint32 func_idx, uint32 argc,
             (WASMModuleInstanceCommon *)module_inst, func_ptr, func_type, argc,
             argv, c_api_func_import->with_env_arg, c_api_func_import->env_arg);
     }
+    else if (import_func->call_desc) {
+        ret = wasm_runtime_invoke_native_desc(exec_env, func_ptr,
+                                              import_func->call_desc,
+                                              attachment, argv, argv);
+    }
     else if (!import_func->call_conv_raw) {
         signature = import_func->signature;
         ret =
@@ -4336,6 +4430,15 @@ llvm_jit_memory_init(WASMModuleInstance *module_inst, uint32 seg_index,
     maddr = wasm_runtime_addr_app_to_native(
         (WASMModuleInstanceCommon *)module_inst, (uint64)dst);
 
+#if WASM_ENABLE_SHARED_HEAP != 0
+    if (wasm_runtime_is_app_addr_in_shared_heap(
+            (WASMModuleInstanceCommon *)module_inst, (uint64)dst,
+            (uint64)len)) {
+        bh_memcpy_s(maddr, len, data + offset, len);
+        return true;
+    }
+#endif
+
     SHARED_MEMORY_LOCK(memory_inst);
     bh_memcpy_s(maddr, CLAMP_U64_TO_U32(memory_inst->memory_data_size - dst),
                 data + offset, len);
@@ -88,6 +88,7 @@ typedef enum WASMExceptionID {
     EXCE_FAILED_TO_CREATE_STRINGVIEW,
     EXCE_FAILED_TO_ENCODE_STRING,
     EXCE_ALREADY_THROWN,
+    EXCE_OUT_OF_FUEL,
     EXCE_NUM,
 } WASMExceptionID;
 
@@ -110,9 +111,13 @@ struct WASMMemoryInstance {
          0: non-shared memory, > 0: shared memory */
     bh_atomic_16_t ref_count;
 
-    /* Four-byte paddings to ensure the layout of WASMMemoryInstance is the same
-     * in both 64-bit and 32-bit */
-    uint8 _paddings[4];
+    /* Whether a file (e.g. a memory snapshot) is mapped privately over
+       the memory data */
+    uint8 is_file_mapped;
+
+    /* Three-byte paddings to ensure the layout of WASMMemoryInstance is the
+     * same in both 64-bit and 32-bit */
+    uint8 _paddings[3];
 
     /* Number bytes per page */
     uint32 num_bytes_per_page;
@@ -299,6 +304,16 @@ typedef struct CApiFuncImport {
 
 /* The common part of WASMModuleInstanceExtra and AOTModuleInstanceExtra */
 typedef struct WASMModuleInstanceExtraCommon {
+#if WASM_ENABLE_SHARED_HEAP != 0
+    /* The app offset where the shared heap attached starts, UINT64_MAX
+       if no shared heap is attached. The two fields are kept at the
+       beginning since they are loaded by the AOT/JIT code. */
+    uint64 shared_heap_start_off;
+    /* The base address of the shared heap minus shared_heap_start_off,
+       so the native address of app offset x in it is adj + x */
+    DefPointer(uint8 *, shared_heap_base_addr_adj);
+    struct WASMSharedHeap *shared_heap;
+#endif
 #if WASM_ENABLE_MODULE_INST_CONTEXT != 0
     void *contexts[WASM_MAX_INSTANCE_CONTEXTS];
 #endif
@@ -319,6 +334,18 @@ typedef struct WASMModuleInstanceExtraCommon {
     /* The gc heap created */
     void *gc_heap_handle;
 #endif
+
+#if WASM_ENABLE_THREAD_MGR != 0
+    /* The exec_envs running this instance, maintained by the thread
+       manager to find them without scanning all the clusters */
+    struct WASMExecEnv *exec_env_list;
+#endif
+
+#if WASM_ENABLE_INSTANCE_RESET != 0
+    /* The state restored by wasm_runtime_instance_reset, NULL if the
+       instance isn't created with InstantiationArgs.enable_reset */
+    struct WASMInstanceResetImage *reset_image;
+#endif
 } WASMModuleInstanceExtraCommon;
 
 /* Extra info of WASM module instance for interpreter/jit mode */
@@ -503,6 +530,48 @@ wasm_get_func_code_end(WASMFunctionInstance *func)
 #endif
 }
 
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+bool
+wasm_prepare_func_lazily(WASMModuleInstance *module_inst,
+                         WASMFunctionInstance *func);
+
+/**
+ * Make sure that the body of a function to call was validated and
+ * prepared, which is done when the function is called for the first time
+ * if the module is loaded with lazy function validation.
+ *
+ * @param module_inst the module instance which the function belongs to
+ * @param func the WASM function instance
+ *
+ * @return true if the function can be called, false and the exception is
+ *         set if its body is invalid
+ */
+static inline bool
+wasm_ensure_func_prepared(WASMModuleInstance *module_inst,
+                          WASMFunctionInstance *func)
+{
+    if (func->is_import_func) {
+#if WASM_ENABLE_MULTI_MODULE != 0
+        if (func->import_func_inst)
+            return wasm_ensure_func_prepared(func->import_module_inst,
+                                             func->import_func_inst);
+#endif
+        return true;
+    }
+
+    if (BH_ATOMIC_32_LOAD(func->u.func->prepare_state)
+        != WASM_FUNC_STATE_PREPARED)
+        return wasm_prepare_func_lazily(module_inst, func);
+
+#if WASM_ENABLE_FAST_INTERP != 0
+    /* The instance may be created before the function is prepared */
+    if (func->const_cell_num != func->u.func->const_cell_num)
+        func->const_cell_num = (uint16)func->u.func->const_cell_num;
+#endif
+    return true;
+}
+#endif /* end of WASM_ENABLE_LAZY_FUNC_VALIDATION != 0 */
+
 WASMModule *
 wasm_load(uint8 *buf, uint32 size,
 #if WASM_ENABLE_MULTI_MODULE != 0
@@ -520,12 +589,20 @@ wasm_unload(WASMModule *module);
 WASMModuleInstance *
 wasm_instantiate(WASMModule *module, WASMModuleInstance *parent,
                  WASMExecEnv *exec_env_main, uint32 stack_size,
-                 uint32 heap_size, uint32 max_memory_pages, char *error_buf,
+                 uint32 heap_size, uint32 max_memory_pages,
+                 const struct WASMModuleSnapshot *snapshot, char *error_buf,
                  uint32 error_buf_size);
 
 void
 wasm_dump_perf_profiling(const WASMModuleInstance *module_inst);
 
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+/* Get the name of a function from the name section, or its import or
+   export name, return NULL if not found */
+const char *
+wasm_get_func_name(const WASMModuleInstance *module_inst, uint32 func_index);
+#endif
+
 double
 wasm_summarize_wasm_execute_time(const WASMModuleInstance *inst);
 
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef __wasi__
+#error This example only compiles to WASM/WASI target
+#endif
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Contention benchmark for memory.atomic.wait32/notify, it reports:
+ * - ping-pong: the round trip latency between pairs of threads, each
+ *   pair waits on its own addresses, so the pairs should not contend
+ *   with each other in the runtime
+ * - broadcast: one thread wakes up all the other threads waiting on
+ *   the same address, and waits until all of them acknowledge
+ */
+
+enum Constants {
+    MAX_THREADS_NUM = 8,
+    PING_PONG_ITER_NUM = 2000,
+    BROADCAST_ITER_NUM = 500,
+};
+
+/* Keep the futex words of different pairs in different cache lines */
+typedef struct {
+    int turn;
+    int padding[15];
+} PingPongPair;
+
+static PingPongPair pairs[MAX_THREADS_NUM / 2];
+
+typedef struct {
+    PingPongPair *pair;
+    int side;
+} PingPongArg;
+
+static int broadcast_generation = 0;
+static int broadcast_acked = 0;
+
+static double
+now_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void
+wait_turn(int *turn, int expected)
+{
+    int cur;
+
+    while ((cur = __atomic_load_n(turn, __ATOMIC_SEQ_CST)) != expected) {
+        __builtin_wasm_memory_atomic_wait32(turn, cur, -1);
+    }
+}
+
+static void
+pass_turn(int *turn, int next)
+{
+    __atomic_store_n(turn, next, __ATOMIC_SEQ_CST);
+    __builtin_wasm_memory_atomic_notify(turn, 1);
+}
+
+static void *
+ping_pong_thread(void *arg)
+{
+    PingPongArg *ping_pong_arg = (PingPongArg *)arg;
+    int *turn = &ping_pong_arg->pair->turn;
+    int side = ping_pong_arg->side;
+
+    for (int i = 0; i < PING_PONG_ITER_NUM; i++) {
+        wait_turn(turn, side);
+        pass_turn(turn, !side);
+    }
+    return NULL;
+}
+
+static void
+test_ping_pong(int threads_num)
+{
+    pthread_t threads[MAX_THREADS_NUM];
+    PingPongArg args[MAX_THREADS_NUM];
+    int pairs_num = threads_num / 2;
+    double begin, elapsed;
+
+    for (int i = 0; i < pairs_num; i++) {
+        pairs[i].turn = 0;
+    }
+
+    begin = now_us();
+    for (int i = 0; i < threads_num; i++) {
+        args[i].pair = &pairs[i / 2];
+        args[i].side = i % 2;
+        assert(pthread_create(&threads[i], NULL, ping_pong_thread, &args[i])
+               == 0);
+    }
+    for (int i = 0; i < threads_num; i++) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+    elapsed = now_us() - begin;
+
+    printf("ping-pong  threads: %2d, round trip latency: %8.2f us, "
+           "throughput: %10.0f notify/s\n",
+           threads_num, elapsed / PING_PONG_ITER_NUM,
+           2.0 * PING_PONG_ITER_NUM * pairs_num * 1e6 / elapsed);
+}
+
+static void *
+broadcast_waiter_thread(void *arg)
+{
+    int generation = 0;
+
+    (void)arg;
+    for (int i = 0; i < BROADCAST_ITER_NUM; i++) {
+        wait_turn(&broadcast_generation, ++generation);
+        __atomic_fetch_add(&broadcast_acked, 1, __ATOMIC_SEQ_CST);
+        __builtin_wasm_memory_atomic_notify(&broadcast_acked, 1);
+    }
+    return NULL;
+}
+
+static void
+test_broadcast(int waiters_num)
+{
+    pthread_t threads[MAX_THREADS_NUM];
+    double begin, elapsed;
+    int acked;
+
+    broadcast_generation = 0;
+    broadcast_acked = 0;
+
+    for (int i = 0; i < waiters_num; i++) {
+        assert(pthread_create(&threads[i], NULL, broadcast_waiter_thread, NULL)
+               == 0);
+    }
+
+    begin = now_us();
+    for (int i = 1; i <= BROADCAST_ITER_NUM; i++) {
+        __atomic_store_n(&broadcast_generation, i, __ATOMIC_SEQ_CST);
+        __builtin_wasm_memory_atomic_notify(&broadcast_generation, ~0U);
+        while ((acked = __atomic_load_n(&broadcast_acked, __ATOMIC_SEQ_CST))
+               != i * waiters_num) {
+            __builtin_wasm_memory_atomic_wait32(&broadcast_acked, acked, -1);
+        }
+    }
+    elapsed = now_us() - begin;
+
+    for (int i = 0; i < waiters_num; i++) {
+        assert(pthread_join(threads[i], NULL) == 0);
+    }
+
+    printf("broadcast  waiters: %2d, wake-all latency:   %8.2f us, "
+           "throughput: %10.0f wakeup/s\n",
+           waiters_num, elapsed / BROADCAST_ITER_NUM,
+           1.0 * BROADCAST_ITER_NUM * waiters_num * 1e6 / elapsed);
+}
+
+int
+main(int argc, char **argv)
+{
+    for (int threads_num = 2; threads_num <= MAX_THREADS_NUM;
+         threads_num *= 2) {
+        test_ping_pong(threads_num);
+    }
+
+    for (int waiters_num = 1; waiters_num <= MAX_THREADS_NUM;
+         waiters_num *= 2) {
+        test_broadcast(waiters_num);
+    }
+
+    fprintf(stderr, "Atomic wait/notify stress test finished successfully\n");
+    return 0;
+}
@@ -0,0 +1,98 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#ifndef __wasi__
+#error This example only compiles to WASM/WASI target
+#endif
+
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <time.h>
+
+/*
+ * Spawn latency benchmark, it reports:
+ * - serial: the latency of creating a thread and joining it, one thread
+ *   alive at a time
+ * - batch: the latency of creating a batch of threads and then joining
+ *   all of them
+ * Run it with and without the thread pool to compare, e.g.
+ *   iwasm --max-threads=12 spawn_latency_stress_test.wasm
+ *   iwasm --max-threads=12 --thread-pool-size=8 spawn_latency_stress_test.wasm
+ */
+
+enum Constants {
+    SERIAL_ITER_NUM = 2000,
+    BATCH_ITER_NUM = 250,
+    BATCH_THREADS_NUM = 8,
+};
+
+static double
+now_us()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static void *
+thread_func(void *arg)
+{
+    return (void *)((unsigned long)arg + 1);
+}
+
+static void
+test_serial()
+{
+    pthread_t thread;
+    void *ret;
+    double begin, elapsed;
+
+    begin = now_us();
+    for (unsigned long i = 0; i < SERIAL_ITER_NUM; i++) {
+        assert(pthread_create(&thread, NULL, thread_func, (void *)i) == 0);
+        assert(pthread_join(thread, &ret) == 0);
+        assert((unsigned long)ret == i + 1);
+    }
+    elapsed = now_us() - begin;
+
+    printf("serial  threads: %2d, create + join latency: %8.2f us\n", 1,
+           elapsed / SERIAL_ITER_NUM);
+}
+
+static void
+test_batch()
+{
+    pthread_t threads[BATCH_THREADS_NUM];
+    void *ret;
+    double begin, elapsed;
+
+    begin = now_us();
+    for (int i = 0; i < BATCH_ITER_NUM; i++) {
+        for (unsigned long j = 0; j < BATCH_THREADS_NUM; j++) {
+            assert(pthread_create(&threads[j], NULL, thread_func, (void *)j)
+                   == 0);
+        }
+        for (unsigned long j = 0; j < BATCH_THREADS_NUM; j++) {
+            assert(pthread_join(threads[j], &ret) == 0);
+            assert((unsigned long)ret == j + 1);
+        }
+    }
+    elapsed = now_us() - begin;
+
+    printf("batch   threads: %2d, create + join latency: %8.2f us\n",
+           BATCH_THREADS_NUM,
+           elapsed / ((double)BATCH_ITER_NUM * BATCH_THREADS_NUM));
+}
+
+int
+main(int argc, char **argv)
+{
+    test_serial();
+    test_batch();
+
+    fprintf(stderr, "Spawn latency stress test finished successfully\n");
+    return 0;
+}
@@ -5,6 +5,7 @@
 
 #include "thread_manager.h"
 #include "../common/wasm_c_api_internal.h"
+#include "../common/wasm_memory.h"
 
 #if WASM_ENABLE_INTERP != 0
 #include "../interpreter/wasm_runtime.h"
@@ -17,6 +18,10 @@
 #include "debug_engine.h"
 #endif
 
+#if WASM_ENABLE_SHARED_MEMORY != 0
+#include "../common/wasm_shared_memory.h"
+#endif
+
 typedef struct {
     bh_list_link l;
     void (*destroy_cb)(WASMCluster *);
@@ -31,10 +36,62 @@ static korp_mutex cluster_list_lock;
 
 static korp_mutex _exception_lock;
 
+/* Lock to update the exec_env lists of the module instances, the list
+   heads are read without the lock */
+static korp_mutex exec_env_registry_lock;
+
+/* The list heads are published with release stores and read with acquire
+   loads, so that the lookup sees the exec_env fully initialized. Without
+   the atomic builtins, the lookup takes exec_env_registry_lock instead */
+#if defined(CLANG_GCC_HAS_ATOMIC_BUILTIN)
+#define EXEC_ENV_LIST_LOAD(list) __atomic_load_n(&(list), __ATOMIC_ACQUIRE)
+#define EXEC_ENV_LIST_STORE(list, exec_env) \
+    __atomic_store_n(&(list), exec_env, __ATOMIC_RELEASE)
+#else
+#define EXEC_ENV_LIST_STORE(list, exec_env) (list) = (exec_env)
+#endif
+
 typedef void (*list_visitor)(void *, void *);
 
 static uint32 cluster_max_thread_num = CLUSTER_MAX_THREAD_NUM;
 
+/*
+ * The thread pool keeps the native threads of the exited wasm threads
+ * parked instead of exiting them, so as to avoid the cost of creating
+ * the native thread and its signal stack again when the next wasm thread
+ * is spawned. The exec_env isn't kept with the worker, it is retired to
+ * its cluster, see cluster_retire_exec_env.
+ */
+typedef struct ThreadPoolWorker {
+    /* Next worker in the idle list */
+    struct ThreadPoolWorker *next;
+    /* Signaled when a task is assigned, the task finishes, or the
+       joining threads have got the result */
+    korp_cond cond;
+    /* The exec_env of the task running, NULL if the worker is idle */
+    WASMExecEnv *exec_env;
+    /* Increased each time a task finishes */
+    uint32 finished_count;
+    /* Return value of the last task */
+    void *ret_value;
+    /* The count of threads which are joining the task running */
+    uint32 join_count;
+    /* Whether to exit the worker once it becomes idle */
+    bool retire;
+} ThreadPoolWorker;
+
+static korp_mutex thread_pool_lock;
+/* Signaled when a worker exits */
+static korp_cond thread_pool_cond;
+static ThreadPoolWorker *thread_pool_idle_list;
+static uint32 thread_pool_idle_num;
+static uint32 thread_pool_worker_num;
+/* Max idle workers kept in the pool, 0 means the pool is disabled */
+static uint32 thread_pool_size;
+static bool thread_pool_quit;
+static uint64 thread_pool_hit_count;
+static uint64 thread_pool_miss_count;
+
 /* Set the maximum thread number, if this function is not called,
     the max thread num is defined by CLUSTER_MAX_THREAD_NUM */
 void
@@ -44,6 +101,44 @@ wasm_cluster_set_max_thread_num(uint32 num)
         cluster_max_thread_num = num;
 }
 
+/* Must be called with thread_pool_lock held */
+static void
+thread_pool_retire_idle_workers(uint32 keep_num)
+{
+    ThreadPoolWorker *worker;
+
+    while (thread_pool_idle_num > keep_num) {
+        worker = thread_pool_idle_list;
+        thread_pool_idle_list = worker->next;
+        thread_pool_idle_num--;
+
+        worker->next = NULL;
+        worker->retire = true;
+        os_cond_signal(&worker->cond);
+    }
+}
+
+void
+wasm_cluster_set_thread_pool_size(uint32 size)
+{
+    os_mutex_lock(&thread_pool_lock);
+    thread_pool_size = size;
+    thread_pool_retire_idle_workers(size);
+    os_mutex_unlock(&thread_pool_lock);
+}
+
+void
+wasm_cluster_get_thread_pool_stats(thread_pool_stats_t *stats)
+{
+    os_mutex_lock(&thread_pool_lock);
+    stats->pool_size = thread_pool_size;
+    stats->worker_count = thread_pool_worker_num;
+    stats->idle_count = thread_pool_idle_num;
+    stats->hit_count = thread_pool_hit_count;
+    stats->miss_count = thread_pool_miss_count;
+    os_mutex_unlock(&thread_pool_lock);
+}
+
 bool
 thread_manager_init()
 {
@@ -51,11 +146,30 @@ thread_manager_init()
         return false;
     if (os_mutex_init(&cluster_list_lock) != 0)
         return false;
-    if (os_mutex_init(&_exception_lock) != 0) {
-        os_mutex_destroy(&cluster_list_lock);
-        return false;
-    }
+    if (os_mutex_init(&_exception_lock) != 0)
+        goto fail1;
+    if (os_mutex_init(&thread_pool_lock) != 0)
+        goto fail2;
+    if (os_cond_init(&thread_pool_cond) != 0)
+        goto fail3;
+    if (os_mutex_init(&exec_env_registry_lock) != 0)
+        goto fail4;
+
+    thread_pool_idle_list = NULL;
+    thread_pool_idle_num = thread_pool_worker_num = 0;
+    thread_pool_quit = false;
+    thread_pool_hit_count = thread_pool_miss_count = 0;
     return true;
+
+fail4:
+    os_cond_destroy(&thread_pool_cond);
+fail3:
+    os_mutex_destroy(&thread_pool_lock);
+fail2:
+    os_mutex_destroy(&_exception_lock);
+fail1:
+    os_mutex_destroy(&cluster_list_lock);
+    return false;
 }
 
 void
@@ -69,6 +183,20 @@ thread_manager_destroy()
         cluster = next;
     }
     wasm_cluster_cancel_all_callbacks();
+
+    /* Exit all the workers and wait until they release their resources,
+       the workers still running tasks exit once the tasks finish */
+    os_mutex_lock(&thread_pool_lock);
+    thread_pool_quit = true;
+    thread_pool_retire_idle_workers(0);
+    while (thread_pool_worker_num > 0) {
+        os_cond_wait(&thread_pool_cond, &thread_pool_lock);
+    }
+    os_mutex_unlock(&thread_pool_lock);
+
+    os_mutex_destroy(&exec_env_registry_lock);
+    os_cond_destroy(&thread_pool_cond);
+    os_mutex_destroy(&thread_pool_lock);
     os_mutex_destroy(&_exception_lock);
     os_mutex_destroy(&cluster_list_lock);
 }
@@ -219,6 +347,91 @@ wasm_cluster_free_aux_stack(WASMExecEnv *exec_env, uint64 start)
 #endif
 }
 
+static WASMModuleInstanceExtraCommon *
+get_module_inst_extra_common(WASMModuleInstanceCommon *module_inst)
+{
+#if WASM_ENABLE_INTERP != 0
+    if (module_inst->module_type == Wasm_Module_Bytecode) {
+        return &((WASMModuleInstance *)module_inst)->e->common;
+    }
+#endif
+#if WASM_ENABLE_AOT != 0
+    if (module_inst->module_type == Wasm_Module_AoT) {
+        return &((AOTModuleInstanceExtra *)((AOTModuleInstance *)module_inst)
+                     ->e)
+                    ->common;
+    }
+#endif
+    bh_assert(0);
+    return NULL;
+}
+
+/* Add exec_env to the exec_env list of its module instance */
+static void
+exec_env_registry_add(WASMExecEnv *exec_env)
+{
+    WASMExecEnv **list =
+        &get_module_inst_extra_common(exec_env->module_inst)->exec_env_list;
+
+    os_mutex_lock(&exec_env_registry_lock);
+    bh_assert(!exec_env->inst_exec_env_list);
+    exec_env->inst_exec_env_list = list;
+    exec_env->inst_prev = NULL;
+    exec_env->inst_next = *list;
+    if (*list)
+        (*list)->inst_prev = exec_env;
+    EXEC_ENV_LIST_STORE(*list, exec_env);
+    os_mutex_unlock(&exec_env_registry_lock);
+}
+
+/* Remove exec_env from the exec_env list of its module instance,
+   return false if it isn't in any list */
+static bool
+exec_env_registry_remove(WASMExecEnv *exec_env)
+{
+    WASMExecEnv **list;
+
+    os_mutex_lock(&exec_env_registry_lock);
+    if (!(list = exec_env->inst_exec_env_list)) {
+        os_mutex_unlock(&exec_env_registry_lock);
+        return false;
+    }
+
+    if (exec_env->inst_prev)
+        exec_env->inst_prev->inst_next = exec_env->inst_next;
+    else
+        EXEC_ENV_LIST_STORE(*list, exec_env->inst_next);
+    if (exec_env->inst_next)
+        exec_env->inst_next->inst_prev = exec_env->inst_prev;
+
+    exec_env->inst_exec_env_list = NULL;
+    exec_env->inst_prev = exec_env->inst_next = NULL;
+    os_mutex_unlock(&exec_env_registry_lock);
+
+    return true;
+}
+
+void
+wasm_cluster_unregister_module_inst(WASMModuleInstanceCommon *module_inst)
+{
+    WASMExecEnv **list =
+        &get_module_inst_extra_common(module_inst)->exec_env_list;
+    WASMExecEnv *exec_env, *next;
+
+    /* The exec_envs may be destroyed after the instance, unlink them so
+       that they won't access the instance's list then */
+    os_mutex_lock(&exec_env_registry_lock);
+    exec_env = *list;
+    while (exec_env) {
+        next = exec_env->inst_next;
+        exec_env->inst_exec_env_list = NULL;
+        exec_env->inst_prev = exec_env->inst_next = NULL;
+        exec_env = next;
+    }
+    EXEC_ENV_LIST_STORE(*list, NULL);
+    os_mutex_unlock(&exec_env_registry_lock);
+}
+
 WASMCluster *
 wasm_cluster_create(WASMExecEnv *exec_env)
 {
@@ -237,6 +450,7 @@ wasm_cluster_create(WASMExecEnv *exec_env)
 
     bh_list_init(&cluster->exec_env_list);
     bh_list_insert(&cluster->exec_env_list, exec_env);
+    bh_list_init(&cluster->retired_exec_env_list);
     if (os_mutex_init(&cluster->lock) != 0) {
         wasm_runtime_free(cluster);
         LOG_ERROR("thread manager error: failed to init mutex");
@@ -259,6 +473,7 @@ wasm_cluster_create(WASMExecEnv *exec_env)
         }
         os_mutex_unlock(&cluster_list_lock);
 
+        exec_env_registry_add(exec_env);
         return cluster;
     }
 
@@ -313,6 +528,7 @@ wasm_cluster_create(WASMExecEnv *exec_env)
     }
     os_mutex_unlock(&cluster_list_lock);
 
+    exec_env_registry_add(exec_env);
     return cluster;
 
 fail:
@@ -322,6 +538,12 @@ fail:
     return NULL;
 }
 
+static void
+destroy_exec_env_visitor(void *node, void *user_data)
+{
+    wasm_exec_env_destroy_internal((WASMExecEnv *)node);
+}
+
 static void
 destroy_cluster_visitor(void *node, void *user_data)
 {
@@ -344,6 +566,9 @@ wasm_cluster_destroy(WASMCluster *cluster)
 
     os_mutex_destroy(&cluster->lock);
 
+    traverse_list(&cluster->retired_exec_env_list, destroy_exec_env_visitor,
+                  NULL);
+
 #if WASM_ENABLE_HEAP_AUX_STACK_ALLOCATION == 0
     if (cluster->stack_tops)
         wasm_runtime_free(cluster->stack_tops);
@@ -398,9 +623,23 @@ wasm_cluster_add_exec_env(WASMCluster *cluster, WASMExecEnv *exec_env)
     if (ret && bh_list_insert(&cluster->exec_env_list, exec_env) != 0)
         ret = false;
 
+    if (ret)
+        exec_env_registry_add(exec_env);
+
     return ret;
 }
 
+/* Release an exec_env which was added to the cluster and is removed from
+   it, the caller should hold cluster->lock. A concurrent
+   wasm_clusters_search_exec_env may still return it, so it is kept
+   until the cluster is destroyed instead of being freed or reused */
+static void
+cluster_retire_exec_env(WASMCluster *cluster, WASMExecEnv *exec_env)
+{
+    bh_assert(!exec_env->inst_exec_env_list);
+    bh_list_insert(&cluster->retired_exec_env_list, exec_env);
+}
+
 static bool
 wasm_cluster_del_exec_env_internal(WASMCluster *cluster, WASMExecEnv *exec_env,
                                    bool can_destroy_cluster)
@@ -426,6 +665,8 @@ wasm_cluster_del_exec_env_internal(WASMCluster *cluster, WASMExecEnv *exec_env,
     if (bh_list_remove(&cluster->exec_env_list, exec_env) != 0)
         ret = false;
 
+    exec_env_registry_remove(exec_env);
+
     if (can_destroy_cluster) {
         if (cluster->exec_env_list.len == 0) {
             /* exec_env_list empty, destroy the cluster */
@@ -446,47 +687,40 @@ wasm_cluster_del_exec_env(WASMCluster *cluster, WASMExecEnv *exec_env)
     return wasm_cluster_del_exec_env_internal(cluster, exec_env, true);
 }
 
-static WASMExecEnv *
-wasm_cluster_search_exec_env(WASMCluster *cluster,
-                             WASMModuleInstanceCommon *module_inst)
+/* find an exec_env running the given module instance */
+WASMExecEnv *
+wasm_clusters_search_exec_env(WASMModuleInstanceCommon *module_inst)
 {
-    WASMExecEnv *node = NULL;
+    WASMModuleInstanceExtraCommon *e =
+        get_module_inst_extra_common(module_inst);
+    WASMExecEnv *exec_env;
 
-    os_mutex_lock(&cluster->lock);
-    node = bh_list_first_elem(&cluster->exec_env_list);
-    while (node) {
-        if (node->module_inst == module_inst) {
-            os_mutex_unlock(&cluster->lock);
-            return node;
-        }
-        node = bh_list_elem_next(node);
-    }
+    /* The exec_envs removed from the list are retired to their cluster
+       and not freed until the cluster is destroyed, see
+       cluster_retire_exec_env, so the exec_env returned stays valid even
+       if it is being removed */
+#if defined(CLANG_GCC_HAS_ATOMIC_BUILTIN)
+    exec_env = EXEC_ENV_LIST_LOAD(e->exec_env_list);
+#else
+    os_mutex_lock(&exec_env_registry_lock);
+    exec_env = e->exec_env_list;
+    os_mutex_unlock(&exec_env_registry_lock);
+#endif
 
-    os_mutex_unlock(&cluster->lock);
-    return NULL;
+    return exec_env;
 }
 
-/* search the global cluster list to find if the given
-   module instance have a corresponding exec_env */
-WASMExecEnv *
-wasm_clusters_search_exec_env(WASMModuleInstanceCommon *module_inst)
+void
+wasm_cluster_set_exec_env_module_inst(WASMExecEnv *exec_env,
+                                      WASMModuleInstanceCommon *module_inst)
 {
-    WASMCluster *cluster = NULL;
-    WASMExecEnv *exec_env = NULL;
-
-    os_mutex_lock(&cluster_list_lock);
-    cluster = bh_list_first_elem(cluster_list);
-    while (cluster) {
-        exec_env = wasm_cluster_search_exec_env(cluster, module_inst);
-        if (exec_env) {
-            os_mutex_unlock(&cluster_list_lock);
-            return exec_env;
-        }
-        cluster = bh_list_elem_next(cluster);
+    if (exec_env_registry_remove(exec_env)) {
+        exec_env->module_inst = module_inst;
+        exec_env_registry_add(exec_env);
+    }
+    else {
+        exec_env->module_inst = module_inst;
     }
-
-    os_mutex_unlock(&cluster_list_lock);
-    return NULL;
 }
 
 WASMExecEnv *
@@ -614,20 +848,19 @@ wasm_cluster_destroy_spawned_exec_env(WASMExecEnv *exec_env)
 
     /* Remove exec_env */
     wasm_cluster_del_exec_env_internal(cluster, exec_env, false);
-    /* Destroy exec_env */
-    wasm_exec_env_destroy_internal(exec_env);
+    /* Retire exec_env */
+    cluster_retire_exec_env(cluster, exec_env);
     /* Routine exit, destroy instance */
     wasm_runtime_deinstantiate_internal(module_inst, true);
 
     os_mutex_unlock(&cluster->lock);
 }
 
-/* start routine of thread manager */
+/* Run the wasm thread and then release its resources */
 static void *
-thread_manager_start_routine(void *arg)
+thread_manager_run_thread(WASMExecEnv *exec_env)
 {
     void *ret;
-    WASMExecEnv *exec_env = (WASMExecEnv *)arg;
     WASMCluster *cluster = wasm_exec_env_get_cluster(exec_env);
     WASMModuleInstanceCommon *module_inst =
         wasm_exec_env_get_module_inst(exec_env);
@@ -666,8 +899,10 @@ thread_manager_start_routine(void *arg)
 
     os_mutex_lock(&cluster->lock);
 
-    /* Detach the native thread here to ensure the resources are freed */
-    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached) {
+    /* Detach the native thread here to ensure the resources are freed,
+       the native thread of thread pool worker never exits here */
+    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached
+        && !exec_env->thread_pool_worker) {
         /* Only detach current thread when there is no other thread
            joining it, otherwise let the system resources for the
            thread be released after joining */
@@ -684,8 +919,8 @@ thread_manager_start_routine(void *arg)
 
     /* Remove exec_env */
     wasm_cluster_del_exec_env_internal(cluster, exec_env, false);
-    /* Destroy exec_env */
-    wasm_exec_env_destroy_internal(exec_env);
+    /* Retire exec_env */
+    cluster_retire_exec_env(cluster, exec_env);
     /* Routine exit, destroy instance */
     wasm_runtime_deinstantiate_internal(module_inst, true);
 
@@ -693,10 +928,195 @@ thread_manager_start_routine(void *arg)
 
     os_mutex_unlock(&cluster_list_lock);
 
+    return ret;
+}
+
+/* start routine of thread manager */
+static void *
+thread_manager_start_routine(void *arg)
+{
+    void *ret = thread_manager_run_thread((WASMExecEnv *)arg);
+
+    wasm_memory_flush_thread_cache();
     os_thread_exit(ret);
     return ret;
 }
 
+/* Publish the result of the task to the joining threads, then put the
+   worker back to the idle list unless it should exit, return whether
+   it should exit */
+static bool
+thread_pool_worker_finish_task(ThreadPoolWorker *worker, void *ret,
+                               bool retire)
+{
+    os_mutex_lock(&thread_pool_lock);
+
+    worker->ret_value = ret;
+    worker->exec_env = NULL;
+    worker->finished_count++;
+    os_cond_broadcast(&worker->cond);
+
+    if (thread_pool_quit || thread_pool_idle_num >= thread_pool_size)
+        retire = true;
+    if (!retire) {
+        worker->next = thread_pool_idle_list;
+        thread_pool_idle_list = worker;
+        thread_pool_idle_num++;
+    }
+
+    os_mutex_unlock(&thread_pool_lock);
+    return retire;
+}
+
+/* Release the resources of the worker and exit the native thread */
+static void
+thread_pool_worker_exit(ThreadPoolWorker *worker)
+{
+    /* Wait until the joining threads have got the result */
+    os_mutex_lock(&thread_pool_lock);
+    while (worker->join_count > 0) {
+        os_cond_wait(&worker->cond, &thread_pool_lock);
+    }
+    os_mutex_unlock(&thread_pool_lock);
+
+    os_cond_destroy(&worker->cond);
+    wasm_runtime_free(worker);
+    wasm_memory_flush_thread_cache();
+
+    os_mutex_lock(&thread_pool_lock);
+    /* Don't access runtime resources after this since the runtime may
+       be destroyed once there is no worker */
+    if (--thread_pool_worker_num == 0) {
+        os_cond_signal(&thread_pool_cond);
+    }
+    os_mutex_unlock(&thread_pool_lock);
+
+    os_thread_detach(os_self_thread());
+    os_thread_exit(NULL);
+}
+
+/* start routine of the thread pool worker */
+static void *
+thread_pool_worker_routine(void *arg)
+{
+    ThreadPoolWorker *worker = (ThreadPoolWorker *)arg;
+    WASMExecEnv *exec_env;
+    void *ret;
+
+    while (true) {
+        os_mutex_lock(&thread_pool_lock);
+        while (!worker->exec_env && !worker->retire) {
+            os_cond_wait(&worker->cond, &thread_pool_lock);
+        }
+        exec_env = worker->exec_env;
+        os_mutex_unlock(&thread_pool_lock);
+
+        if (!exec_env)
+            break;
+
+        ret = thread_manager_run_thread(exec_env);
+
+        if (thread_pool_worker_finish_task(worker, ret, false))
+            break;
+    }
+
+    thread_pool_worker_exit(worker);
+    return NULL;
+}
+
+/* Get an idle worker from the pool, or NULL if there is none or the
+   pool is disabled, the caller should hold cluster->lock */
+static ThreadPoolWorker *
+thread_pool_get_idle_worker(bool *p_use_thread_pool)
+{
+    ThreadPoolWorker *worker = NULL, **p_worker;
+
+    os_mutex_lock(&thread_pool_lock);
+    *p_use_thread_pool = thread_pool_size > 0 ? true : false;
+    if (*p_use_thread_pool) {
+        /* Skip the workers whose last results haven't been got by the
+           joining threads */
+        p_worker = &thread_pool_idle_list;
+        while (*p_worker && (*p_worker)->join_count > 0) {
+            p_worker = &(*p_worker)->next;
+        }
+        if ((worker = *p_worker)) {
+            *p_worker = worker->next;
+            thread_pool_idle_num--;
+            worker->next = NULL;
+            thread_pool_hit_count++;
+        }
+        else {
+            thread_pool_miss_count++;
+        }
+    }
+    os_mutex_unlock(&thread_pool_lock);
+
+    return worker;
+}
+
+/* Put back the worker got by thread_pool_get_idle_worker while failed
+   to assign it a task */
+static void
+thread_pool_put_idle_worker(ThreadPoolWorker *worker)
+{
+    os_mutex_lock(&thread_pool_lock);
+    worker->next = thread_pool_idle_list;
+    thread_pool_idle_list = worker;
+    thread_pool_idle_num++;
+    os_mutex_unlock(&thread_pool_lock);
+}
+
+/* Run the thread of exec_env with the idle worker, or create a new
+   worker to run it if worker is NULL, the caller should hold
+   exec_env->wait_lock */
+static bool
+thread_pool_run_thread(ThreadPoolWorker *worker, WASMExecEnv *exec_env)
+{
+    korp_tid tid;
+
+    if (worker) {
+        os_mutex_lock(&thread_pool_lock);
+        exec_env->thread_pool_worker = worker;
+        worker->exec_env = exec_env;
+        os_cond_signal(&worker->cond);
+        os_mutex_unlock(&thread_pool_lock);
+        return true;
+    }
+
+    if (!(worker = wasm_runtime_malloc(sizeof(ThreadPoolWorker)))) {
+        return false;
+    }
+    memset(worker, 0, sizeof(ThreadPoolWorker));
+
+    if (os_cond_init(&worker->cond) != 0) {
+        wasm_runtime_free(worker);
+        return false;
+    }
+
+    exec_env->thread_pool_worker = worker;
+    worker->exec_env = exec_env;
+
+    os_mutex_lock(&thread_pool_lock);
+    thread_pool_worker_num++;
+    os_mutex_unlock(&thread_pool_lock);
+
+    if (0
+        != os_thread_create(&tid, thread_pool_worker_routine, worker,
+                            APP_THREAD_STACK_SIZE_DEFAULT)) {
+        os_mutex_lock(&thread_pool_lock);
+        thread_pool_worker_num--;
+        os_mutex_unlock(&thread_pool_lock);
+
+        exec_env->thread_pool_worker = NULL;
+        os_cond_destroy(&worker->cond);
+        wasm_runtime_free(worker);
+        return false;
+    }
+
+    return true;
+}
+
 int32
 wasm_cluster_create_thread(WASMExecEnv *exec_env,
                            wasm_module_inst_t module_inst,
@@ -705,7 +1125,9 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
                            void *(*thread_routine)(void *), void *arg)
 {
     WASMCluster *cluster;
-    WASMExecEnv *new_exec_env;
+    WASMExecEnv *new_exec_env = NULL;
+    ThreadPoolWorker *worker = NULL;
+    bool use_thread_pool;
     korp_tid tid;
 
     cluster = wasm_exec_env_get_cluster(exec_env);
@@ -717,8 +1139,10 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
         goto fail1;
     }
 
-    new_exec_env =
-        wasm_exec_env_create_internal(module_inst, exec_env->wasm_stack_size);
+    worker = thread_pool_get_idle_worker(&use_thread_pool);
+
+    new_exec_env = wasm_exec_env_create_internal(module_inst,
+                                                 exec_env->wasm_stack_size);
     if (!new_exec_env)
         goto fail1;
 
@@ -749,12 +1173,16 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
 
     os_mutex_lock(&new_exec_env->wait_lock);
 
-    if (0
-        != os_thread_create(&tid, thread_manager_start_routine,
-                            (void *)new_exec_env,
-                            APP_THREAD_STACK_SIZE_DEFAULT)) {
-        os_mutex_unlock(&new_exec_env->wait_lock);
-        goto fail3;
+    if (!use_thread_pool || !thread_pool_run_thread(worker, new_exec_env)) {
+        /* The thread pool is disabled or failed to create a new worker,
+           create a native thread which exits with the wasm thread */
+        if (0
+            != os_thread_create(&tid, thread_manager_start_routine,
+                                (void *)new_exec_env,
+                                APP_THREAD_STACK_SIZE_DEFAULT)) {
+            os_mutex_unlock(&new_exec_env->wait_lock);
+            goto fail3;
+        }
     }
 
     /* Wait until the new_exec_env->handle is set to avoid it is
@@ -768,9 +1196,13 @@ wasm_cluster_create_thread(WASMExecEnv *exec_env,
 
 fail3:
     wasm_cluster_del_exec_env_internal(cluster, new_exec_env, false);
+    cluster_retire_exec_env(cluster, new_exec_env);
+    goto fail1;
 fail2:
     wasm_exec_env_destroy_internal(new_exec_env);
 fail1:
+    if (worker)
+        thread_pool_put_idle_worker(worker);
     os_mutex_unlock(&cluster->lock);
 
     return -1;
@@ -979,6 +1411,8 @@ clusters_have_exec_env(WASMExecEnv *exec_env)
 int32
 wasm_cluster_join_thread(WASMExecEnv *exec_env, void **ret_val)
 {
+    ThreadPoolWorker *worker;
+    uint32 finished_count;
     korp_tid handle;
 
     os_mutex_lock(&cluster_list_lock);
@@ -994,11 +1428,32 @@ wasm_cluster_join_thread(WASMExecEnv *exec_env, void **ret_val)
     os_mutex_lock(&exec_env->wait_lock);
     exec_env->wait_count++;
     handle = exec_env->handle;
+    worker = exec_env->thread_pool_worker;
     os_mutex_unlock(&exec_env->wait_lock);
 
+    if (!worker) {
+        os_mutex_unlock(&cluster_list_lock);
+        return os_thread_join(handle, ret_val);
+    }
+
+    /* The native thread of the worker doesn't exit, wait until the
+       task finishes instead, the exec_env is still in the cluster so
+       the worker hasn't finished it */
+    os_mutex_lock(&thread_pool_lock);
+    finished_count = worker->finished_count;
+    worker->join_count++;
     os_mutex_unlock(&cluster_list_lock);
 
-    return os_thread_join(handle, ret_val);
+    while (worker->finished_count == finished_count) {
+        os_cond_wait(&worker->cond, &thread_pool_lock);
+    }
+    if (ret_val)
+        *ret_val = worker->ret_value;
+    if (--worker->join_count == 0)
+        os_cond_broadcast(&worker->cond);
+    os_mutex_unlock(&thread_pool_lock);
+
+    return 0;
 }
 
 int32
@@ -1015,8 +1470,10 @@ wasm_cluster_detach_thread(WASMExecEnv *exec_env)
     if (exec_env->wait_count == 0 && !exec_env->thread_is_detached) {
         /* Only detach current thread when there is no other thread
            joining it, otherwise let the system resources for the
-           thread be released after joining */
-        ret = os_thread_detach(exec_env->handle);
+           thread be released after joining, the native thread of
+           thread pool worker is never joined */
+        if (!exec_env->thread_pool_worker)
+            ret = os_thread_detach(exec_env->handle);
         exec_env->thread_is_detached = true;
     }
     os_mutex_unlock(&cluster_list_lock);
@@ -1028,6 +1485,7 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
 {
     WASMCluster *cluster;
     WASMModuleInstanceCommon *module_inst;
+    ThreadPoolWorker *worker;
 
 #ifdef OS_ENABLE_HW_BOUND_CHECK
     if (exec_env->jmpbuf_stack_top) {
@@ -1067,7 +1525,8 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
     os_mutex_lock(&cluster->lock);
 
     /* Detach the native thread here to ensure the resources are freed */
-    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached) {
+    if (exec_env->wait_count == 0 && !exec_env->thread_is_detached
+        && !exec_env->thread_pool_worker) {
         /* Only detach current thread when there is no other thread
            joining it, otherwise let the system resources for the
            thread be released after joining */
@@ -1077,11 +1536,12 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
     }
 
     module_inst = exec_env->module_inst;
+    worker = exec_env->thread_pool_worker;
 
     /* Remove exec_env */
     wasm_cluster_del_exec_env_internal(cluster, exec_env, false);
-    /* Destroy exec_env */
-    wasm_exec_env_destroy_internal(exec_env);
+    /* Retire exec_env */
+    cluster_retire_exec_env(cluster, exec_env);
     /* Routine exit, destroy instance */
     wasm_runtime_deinstantiate_internal(module_inst, true);
 
@@ -1089,6 +1549,15 @@ wasm_cluster_exit_thread(WASMExecEnv *exec_env, void *retval)
 
     os_mutex_unlock(&cluster_list_lock);
 
+    wasm_memory_flush_thread_cache();
+
+    if (worker) {
+        /* The native thread can't go back to the worker routine since
+           we are in the middle of the wasm call stack, retire it */
+        thread_pool_worker_finish_task(worker, retval, true);
+        thread_pool_worker_exit(worker);
+    }
+
     os_thread_exit(retval);
 }
 
@@ -1105,6 +1574,14 @@ set_thread_cancel_flags(WASMExecEnv *exec_env)
 
     os_mutex_unlock(&exec_env->wait_lock);
 
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+    wasm_exec_env_arm_safepoint(exec_env);
+#endif
+
+#if WASM_ENABLE_SHARED_MEMORY != 0
+    wasm_runtime_atomic_wait_interrupt(exec_env);
+#endif
+
 #ifdef OS_ENABLE_WAKEUP_BLOCKING_OP
     wasm_runtime_interrupt_blocking_op(exec_env);
 #endif
@@ -1239,6 +1716,9 @@ wasm_cluster_suspend_thread(WASMExecEnv *exec_env)
     /* Set the suspend flag */
     WASM_SUSPEND_FLAGS_FETCH_OR(exec_env->suspend_flags,
                                 WASM_SUSPEND_FLAG_SUSPEND);
+#if WASM_ENABLE_AOT_SAFEPOINT != 0
+    wasm_exec_env_arm_safepoint(exec_env);
+#endif
 }
 
 static void
@@ -1274,9 +1754,14 @@ wasm_cluster_suspend_all_except_self(WASMCluster *cluster,
 void
 wasm_cluster_resume_thread(WASMExecEnv *exec_env)
 {
+    /* Clear the flag and signal with the wait lock held, otherwise the
+       signal may be sent between the flag check and the wait of a thread
+       suspended at its safepoint, and the wakeup is lost */
+    os_mutex_lock(&exec_env->wait_lock);
     WASM_SUSPEND_FLAGS_FETCH_AND(exec_env->suspend_flags,
                                  ~WASM_SUSPEND_FLAG_SUSPEND);
     os_cond_signal(&exec_env->wait_cond);
+    os_mutex_unlock(&exec_env->wait_lock);
 }
 
 static void
@@ -25,6 +25,9 @@ struct WASMCluster {
 
     korp_mutex lock;
     bh_list exec_env_list;
+    /* The exec_envs removed from exec_env_list, which are freed when the
+       cluster is destroyed, see wasm_clusters_search_exec_env */
+    bh_list retired_exec_env_list;
 
 #if WASM_ENABLE_HEAP_AUX_STACK_ALLOCATION == 0
     /* The aux stack of a module with shared memory will be
@@ -63,6 +66,12 @@ struct WASMCluster {
 void
 wasm_cluster_set_max_thread_num(uint32 num);
 
+void
+wasm_cluster_set_thread_pool_size(uint32 size);
+
+void
+wasm_cluster_get_thread_pool_stats(thread_pool_stats_t *stats);
+
 bool
 thread_manager_init();
 
@@ -144,9 +153,20 @@ wasm_cluster_wait_for_all_except_self(WASMCluster *cluster,
 bool
 wasm_cluster_del_exec_env(WASMCluster *cluster, WASMExecEnv *exec_env);
 
+/* Find an exec_env running the module instance in constant time */
 WASMExecEnv *
 wasm_clusters_search_exec_env(WASMModuleInstanceCommon *module_inst);
 
+/* Change the module instance of exec_env, the caller should hold
+   cluster->lock */
+void
+wasm_cluster_set_exec_env_module_inst(WASMExecEnv *exec_env,
+                                      WASMModuleInstanceCommon *module_inst);
+
+/* Called before the module instance is deinstantiated */
+void
+wasm_cluster_unregister_module_inst(WASMModuleInstanceCommon *module_inst);
+
 void
 wasm_cluster_set_exception(WASMExecEnv *exec_env, const char *exception);
 
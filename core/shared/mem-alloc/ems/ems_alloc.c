@@ -45,7 +45,7 @@ hmu_is_in_heap(void *hmu, gc_uint8 *heap_base_addr, gc_uint8 *heap_end_addr)
 static bool
 remove_tree_node(gc_heap_t *heap, hmu_tree_node_t *p)
 {
-    hmu_tree_node_t *q = NULL, **slot = NULL;
+    hmu_tree_node_t *q = NULL, **slot = NULL, *same;
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
     hmu_tree_node_t *root = heap->kfc_tree_root, *parent;
     gc_uint8 *base_addr = heap->base_addr;
@@ -63,6 +63,22 @@ remove_tree_node(gc_heap_t *heap, hmu_tree_node_t *p)
     }
 #endif
 
+    if (p == p->parent->next_same) {
+        /* p is in the list of the chunks of the same size, unlink it */
+        p->parent->next_same = p->next_same;
+        if (p->next_same) {
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+            if (!hmu_is_in_heap(p->next_same, base_addr, end_addr)) {
+                goto fail;
+            }
+#endif
+            p->next_same->parent = p->parent;
+        }
+
+        p->next_same = p->parent = NULL;
+        return true;
+    }
+
     /* get the slot which holds pointer to node p */
     if (p == p->parent->right) {
         /* Don't use `slot = &p->parent->right` to avoid compiler warning */
@@ -79,6 +95,28 @@ remove_tree_node(gc_heap_t *heap, hmu_tree_node_t *p)
         goto fail;
     }
 
+    if (p->next_same) {
+        /* replace p with the next chunk of the same size, which keeps the
+           rest of the list */
+        q = p->next_same;
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+        if (!hmu_is_in_heap(q, base_addr, end_addr)) {
+            goto fail;
+        }
+#endif
+        *slot = q;
+        q->parent = p->parent;
+        q->left = p->left;
+        q->right = p->right;
+        if (q->left)
+            q->left->parent = q;
+        if (q->right)
+            q->right->parent = q;
+
+        p->left = p->right = p->parent = p->next_same = NULL;
+        return true;
+    }
+
     /**
      * algorithms used to remove node p
      * case 1: if p has no left child, replace p with its right child
@@ -135,9 +173,12 @@ remove_tree_node(gc_heap_t *heap, hmu_tree_node_t *p)
 #endif
     }
 
-    /* remove from the tree*/
+    /* remove from the tree, q keeps its list of the same size */
+    same = q->next_same;
+    q->next_same = NULL;
     if (!remove_tree_node(heap, q))
         return false;
+    q->next_same = same;
 
     *slot = q;
     q->parent = p->parent;
@@ -295,7 +336,7 @@ gci_add_fc(gc_heap_t *heap, hmu_t *hmu, gc_size_t size)
     /* big block */
     node = (hmu_tree_node_t *)hmu;
     node->size = size;
-    node->left = node->right = node->parent = NULL;
+    node->left = node->right = node->parent = node->next_same = NULL;
 
     /* find proper node to link this new node to */
     root = heap->kfc_tree_root;
@@ -310,7 +351,18 @@ gci_add_fc(gc_heap_t *heap, hmu_t *hmu, gc_size_t size)
             }
             tp = tp->right;
         }
-        else { /* tp->size >= size */
+        else if (tp->size == size) {
+            /* link the node to the list of the node of the same size, so
+               that many chunks of one size, e.g. the nursery regions,
+               don't make the tree deeper */
+            node->next_same = tp->next_same;
+            if (node->next_same)
+                node->next_same->parent = node;
+            tp->next_same = node;
+            node->parent = tp;
+            break;
+        }
+        else { /* tp->size > size */
             if (!tp->left) {
                 tp->left = node;
                 node->parent = tp;
@@ -443,13 +495,18 @@ alloc_hmu(gc_heap_t *heap, gc_size_t size)
 
         /* record the last node with size equal to or bigger than given size*/
         last_tp = tp;
+        if (tp->size == size)
+            break;
         tp = tp->left;
     }
 
     if (last_tp) {
         bh_assert(last_tp->size >= size);
 
-        /* alloc in last_p*/
+        /* alloc in last_p, or in a chunk of the same size, which is
+           removed without re-organizing the tree */
+        if (last_tp->next_same)
+            last_tp = last_tp->next_same;
 
         /* remove node last_p from tree*/
         if (!remove_tree_node(heap, last_tp))
@@ -488,7 +545,7 @@ do_gc_heap(gc_heap_t *heap)
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
     uint64 start = 0, end = 0, time = 0;
 
-    start = os_time_get_boot_microsecond();
+    start = os_time_get_boot_us();
 #endif
     if (heap->is_reclaim_enabled) {
         UNLOCK_HEAP(heap);
@@ -496,7 +553,7 @@ do_gc_heap(gc_heap_t *heap)
         LOCK_HEAP(heap);
     }
 #if WASM_ENABLE_GC_PERF_PROFILING != 0
-    end = os_time_get_boot_microsecond();
+    end = os_time_get_boot_us();
     time = end - start;
     heap->total_gc_time += time;
     if (time > heap->max_gc_time) {
@@ -508,6 +565,417 @@ do_gc_heap(gc_heap_t *heap)
 }
 #endif
 
+#if BH_ENABLE_GC_SLAB != 0
+#define GC_SLAB_PAGE_SEARCH_CNT 8
+
+static int
+free_vo_locked(gc_heap_t *heap, gc_object_t obj);
+
+static inline gc_slab_page_t *
+slab_page_at(gc_heap_t *heap, gc_uint32 offset)
+{
+    return (gc_slab_page_t *)(heap->base_addr + offset);
+}
+
+static inline int
+slab_lowest_bit(gc_uint32 bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(bits);
+#else
+    int n = 0;
+
+    while (!(bits & 1)) {
+        bits >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+void
+gci_slab_link_page(gc_heap_t *heap, gc_slab_page_t *page)
+{
+    gc_uint32 *p_head = &heap->slab_partial[page->is_wo][page->class_idx];
+    gc_uint32 offset = (gc_uint32)((gc_uint8 *)page - heap->base_addr);
+
+    page->prev_offset = 0;
+    page->next_offset = *p_head;
+    if (*p_head)
+        slab_page_at(heap, *p_head)->prev_offset = offset;
+    *p_head = offset;
+}
+
+static void
+slab_unlink_page(gc_heap_t *heap, gc_slab_page_t *page)
+{
+    if (page->prev_offset)
+        slab_page_at(heap, page->prev_offset)->next_offset = page->next_offset;
+    else
+        heap->slab_partial[page->is_wo][page->class_idx] = page->next_offset;
+    if (page->next_offset)
+        slab_page_at(heap, page->next_offset)->prev_offset = page->prev_offset;
+    page->prev_offset = page->next_offset = 0;
+}
+
+void
+gci_slab_release_page(gc_heap_t *heap, gc_slab_page_t *page)
+{
+    gc_size_t offset =
+        (gc_size_t)((gc_uint8 *)obj_to_hmu(page) - heap->base_addr);
+
+    heap->slab_map[offset / GC_SLAB_PAGE_SIZE] = 0;
+}
+
+/**
+ * Check whether a free chunk of the tree can hold a slab page
+ *
+ * @param p_page_offset return the offset of the slab page from the heap
+ *        base address, the space left before and after the page in the
+ *        chunk are either empty or large enough to be free chunks
+ */
+static bool
+slab_page_fit(gc_heap_t *heap, hmu_tree_node_t *node, gc_size_t *p_page_offset)
+{
+    gc_size_t offset = (gc_size_t)((gc_uint8 *)node - heap->base_addr);
+    gc_size_t end = offset + node->size;
+    gc_size_t page_offset =
+        (offset + GC_SLAB_PAGE_SIZE - 1) & ~(gc_size_t)(GC_SLAB_PAGE_SIZE - 1);
+
+    if (page_offset != offset && page_offset - offset < GC_SMALLEST_SIZE)
+        page_offset += GC_SLAB_PAGE_SIZE;
+    if (page_offset + GC_SLAB_PAGE_SIZE > end)
+        return false;
+    if (page_offset + GC_SLAB_PAGE_SIZE != end
+        && end - (page_offset + GC_SLAB_PAGE_SIZE) < GC_SMALLEST_SIZE)
+        return false;
+
+    *p_page_offset = page_offset;
+    return true;
+}
+
+/* Find the smallest node of the tree whose size isn't less than size */
+static hmu_tree_node_t *
+find_tree_node(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_tree_node_t *tp = heap->kfc_tree_root->right, *last_tp = NULL;
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    gc_uint8 *base_addr = heap->base_addr;
+    gc_uint8 *end_addr = base_addr + heap->current_size;
+#endif
+
+    while (tp) {
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+        if (!hmu_is_in_heap(tp, base_addr, end_addr)) {
+            heap->is_heap_corrupted = true;
+            return NULL;
+        }
+#endif
+        if (tp->size < size) {
+            tp = tp->right;
+            continue;
+        }
+        last_tp = tp;
+        if (tp->size == size)
+            break;
+        tp = tp->left;
+    }
+    return last_tp;
+}
+
+/* Get the next node of the tree in the order of size */
+static hmu_tree_node_t *
+next_tree_node(gc_heap_t *heap, hmu_tree_node_t *tp)
+{
+    if (tp->right) {
+        tp = tp->right;
+        while (tp->left)
+            tp = tp->left;
+        return tp;
+    }
+
+    while (tp->parent && tp == tp->parent->right)
+        tp = tp->parent;
+    tp = tp->parent;
+    return tp != heap->kfc_tree_root ? tp : NULL;
+}
+
+/**
+ * Split a slab page out of a free chunk of the tree, the offset of the
+ * page from the heap base address is a multiple of GC_SLAB_PAGE_SIZE
+ *
+ * @return the hmu of the page if success, NULL otherwise
+ */
+static hmu_t *
+alloc_slab_page_hmu(gc_heap_t *heap)
+{
+    hmu_tree_node_t *tp, *fc;
+    hmu_t *hmu, *next;
+    gc_size_t offset, end, page_offset = 0;
+    gc_uint32 pinuse;
+    int i;
+
+    /* Try the smallest chunks which are large enough at first, then the
+       best chunk which can always hold an aligned page */
+    tp = find_tree_node(heap, GC_SLAB_PAGE_SIZE);
+    for (i = 0; tp && i < GC_SLAB_PAGE_SEARCH_CNT;
+         tp = next_tree_node(heap, tp)) {
+        /* The chunks of the same size may be at different offsets */
+        for (fc = tp; fc && i < GC_SLAB_PAGE_SEARCH_CNT;
+             fc = fc->next_same, i++) {
+            if (slab_page_fit(heap, fc, &page_offset)) {
+                tp = fc;
+                goto found;
+            }
+        }
+    }
+    tp = find_tree_node(heap, GC_SLAB_PAGE_SIZE * 2 + GC_SMALLEST_SIZE * 2);
+    if (!tp || !slab_page_fit(heap, tp, &page_offset))
+        return NULL;
+
+found:
+    offset = (gc_size_t)((gc_uint8 *)tp - heap->base_addr);
+    end = offset + tp->size;
+    pinuse = hmu_get_pinuse((hmu_t *)tp);
+
+    if (!remove_tree_node(heap, tp))
+        return NULL;
+
+    hmu = (hmu_t *)(heap->base_addr + page_offset);
+    if (page_offset > offset) {
+        /* The chunk before the page keeps the pinuse bit */
+        if (!gci_add_fc(heap, (hmu_t *)tp, page_offset - offset))
+            return NULL;
+        hmu->header = 0;
+    }
+    else {
+        hmu->header = 0;
+        if (pinuse)
+            hmu_mark_pinuse(hmu);
+    }
+    hmu_set_ut(hmu, HMU_VO);
+    hmu_set_size(hmu, GC_SLAB_PAGE_SIZE);
+
+    next = (hmu_t *)((gc_uint8 *)hmu + GC_SLAB_PAGE_SIZE);
+    if (end > page_offset + GC_SLAB_PAGE_SIZE) {
+        next->header = 0;
+        if (!gci_add_fc(heap, next, end - page_offset - GC_SLAB_PAGE_SIZE))
+            return NULL;
+        hmu_mark_pinuse(next);
+    }
+    else if (hmu_is_in_heap(next, heap->base_addr,
+                            heap->base_addr + heap->current_size)) {
+        hmu_mark_pinuse(next);
+    }
+
+    heap->total_free_size -= GC_SLAB_PAGE_SIZE;
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
+#if GC_STAT_DATA != 0
+    heap->total_size_allocated += GC_SLAB_PAGE_SIZE;
+#endif
+    return hmu;
+}
+
+/* Get a slab page with free slots of the class, a new page is added if
+   there is no such page */
+static gc_slab_page_t *
+slab_add_page(gc_heap_t *heap, gc_uint32 class_idx, bool is_wo)
+{
+    gc_slab_page_t *page;
+    hmu_t *hmu;
+    gc_uint32 i;
+
+#if WASM_ENABLE_GC != 0
+    if (heap->total_free_size < heap->gc_threshold
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* the threshold is updated at the end of the cycle */
+        && heap->gc_phase == GC_PHASE_IDLE
+#endif
+    ) {
+        if (GC_SUCCESS != do_gc_heap(heap))
+            return NULL;
+        /* Slots may have been freed by the gc */
+        if (heap->slab_partial[is_wo][class_idx])
+            return slab_page_at(heap, heap->slab_partial[is_wo][class_idx]);
+    }
+#endif
+
+    if (heap->slab_empty) {
+        /* Reuse an empty page, its slab map entry is still set */
+        page = slab_page_at(heap, heap->slab_empty);
+        heap->slab_empty = page->next_offset;
+        heap->slab_empty_cnt--;
+        hmu = obj_to_hmu(page);
+    }
+    else if (!(hmu = alloc_slab_page_hmu(heap)))
+        return NULL;
+
+    page = (gc_slab_page_t *)hmu_to_obj(hmu);
+    memset(page, 0, sizeof(gc_slab_page_t));
+    page->slot_size = (gc_uint16)((class_idx + 1) << 3);
+    page->slot_num =
+        (gc_uint16)((GC_SLAB_PAGE_SIZE - HMU_SIZE - sizeof(gc_slab_page_t))
+                    / page->slot_size);
+    page->free_num = page->slot_num;
+    page->class_idx = (gc_uint8)class_idx;
+    page->is_wo = is_wo ? 1 : 0;
+    for (i = 0; i < GC_SLAB_BITMAP_WORDS; i++)
+        page->alloc_bits[i] = page->mark_bits[i] =
+            gci_slab_padding_bits(page, i);
+
+    heap->slab_map[((gc_uint8 *)hmu - heap->base_addr) / GC_SLAB_PAGE_SIZE] =
+        1;
+    gci_slab_link_page(heap, page);
+    /* The free slots are counted as free memory of the heap */
+    heap->total_free_size += (gc_size_t)page->slot_num * page->slot_size;
+    return page;
+}
+
+/**
+ * Allocate an object from the slab pages
+ *
+ * @param size the object size, should be not larger than
+ *        GC_SLAB_MAX_OBJ_SIZE
+ * @param p_slot_size return the size of the slot allocated
+ *
+ * @return the object allocated, or NULL if no slab page can be used
+ */
+static gc_object_t
+slab_alloc(gc_heap_t *heap, gc_size_t size, bool is_wo,
+           gc_size_t *p_slot_size)
+{
+    gc_uint32 class_idx = size > 0 ? (size - 1) >> 3 : 0, i;
+    gc_slab_page_t *page = NULL;
+    int slot_idx;
+
+    bh_assert(size <= GC_SLAB_MAX_OBJ_SIZE);
+
+    if (heap->slab_partial[is_wo][class_idx])
+        page = slab_page_at(heap, heap->slab_partial[is_wo][class_idx]);
+    else if (!(page = slab_add_page(heap, class_idx, is_wo))) {
+        /* Use a page of larger slots before falling back to hmu */
+        for (i = class_idx + 1; i < GC_SLAB_CLASS_NUM; i++) {
+            if (heap->slab_partial[is_wo][i]) {
+                page = slab_page_at(heap, heap->slab_partial[is_wo][i]);
+                break;
+            }
+        }
+        if (!page)
+            return NULL;
+    }
+
+    bh_assert(page->free_num > 0);
+    for (i = 0; i < GC_SLAB_BITMAP_WORDS; i++) {
+        if (page->alloc_bits[i] != ~(gc_uint32)0)
+            break;
+    }
+    bh_assert(i < GC_SLAB_BITMAP_WORDS);
+
+    slot_idx = (int)(i * 32) + slab_lowest_bit(~page->alloc_bits[i]);
+    GC_SLAB_SET_BIT(page->alloc_bits, slot_idx);
+    if (is_wo) {
+#if GC_MANUALLY != 0
+        GC_SLAB_SET_BIT(page->mark_bits, slot_idx);
+#else
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* the objects allocated in the mark phase are live */
+        if (heap->gc_phase == GC_PHASE_MARK)
+            GC_SLAB_SET_BIT(page->mark_bits, slot_idx);
+        else
+#endif
+            GC_SLAB_CLR_BIT(page->mark_bits, slot_idx);
+#endif
+    }
+    if (--page->free_num == 0)
+        slab_unlink_page(heap, page);
+
+    heap->total_free_size -= page->slot_size;
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
+
+    *p_slot_size = page->slot_size;
+    return GC_SLAB_PAGE_SLOTS(page) + slot_idx * page->slot_size;
+}
+
+/**
+ * Free a vo object of a slab page
+ *
+ * @param p_release return whether the page becomes empty and is released,
+ *        the hmu of the page should be freed by the caller then
+ */
+static int
+slab_free_vo(gc_heap_t *heap, gc_slab_page_t *page, gc_object_t obj,
+             bool *p_release)
+{
+    int slot_idx = gci_slab_slot_index(page, obj);
+
+    *p_release = false;
+    if (slot_idx < 0 || page->is_wo)
+        return GC_ERROR;
+
+    /* A slot freed twice can't be told from a slot never allocated,
+       fail like freeing any other address not allocated */
+    if (!GC_SLAB_BIT_IS_SET(page->alloc_bits, slot_idx))
+        return GC_ERROR;
+
+    GC_SLAB_CLR_BIT(page->alloc_bits, slot_idx);
+    heap->total_free_size += page->slot_size;
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (gci_is_unswept(heap, obj_to_hmu(page))) {
+        /* the page is linked or released when the lazy sweep reaches it */
+        page->free_num++;
+        return GC_SUCCESS;
+    }
+#endif
+    if (page->free_num++ == 0) {
+        gci_slab_link_page(heap, page);
+    }
+    else if (page->free_num == page->slot_num
+             && (page->prev_offset || page->next_offset)) {
+        /* Keep the last page of the class, and some other empty pages
+           for any class, to avoid allocating and releasing pages
+           repeatedly */
+        slab_unlink_page(heap, page);
+        /* The page is counted as used memory again */
+        heap->total_free_size -= (gc_size_t)page->slot_num * page->slot_size;
+        if (heap->slab_empty_cnt < GC_SLAB_EMPTY_PAGE_MAX(heap)) {
+            page->next_offset = heap->slab_empty;
+            heap->slab_empty =
+                (gc_uint32)((gc_uint8 *)page - heap->base_addr);
+            heap->slab_empty_cnt++;
+        }
+        else {
+            gci_slab_release_page(heap, page);
+            *p_release = true;
+        }
+    }
+    return GC_SUCCESS;
+}
+
+/* Release the empty slab pages kept for reuse, return whether any page
+   is released */
+static bool
+slab_trim_empty_pages(gc_heap_t *heap)
+{
+    gc_slab_page_t *page;
+    bool released = false;
+
+    while (heap->slab_empty) {
+        page = slab_page_at(heap, heap->slab_empty);
+        heap->slab_empty = page->next_offset;
+        heap->slab_empty_cnt--;
+        page->next_offset = 0;
+        gci_slab_release_page(heap, page);
+        /* The page is a normal vo object now */
+        if (free_vo_locked(heap, (gc_object_t)page) != GC_SUCCESS)
+            break;
+        released = true;
+    }
+    return released;
+}
+#endif /* end of BH_ENABLE_GC_SLAB != 0 */
+
 /**
  * Find a proper HMU with given size
  *
@@ -518,7 +986,8 @@ do_gc_heap(gc_heap_t *heap)
  *   1. Find a proper on available HMUs.
  *   2. GC will be triggered if 1 failed.
  *   3. Find a proper on available HMUS.
- *   4. Return NULL if 3 failed
+ *   4. Release the empty slab pages and retry if 3 failed.
+ *   5. Return NULL if 4 failed
  *
  * @return hmu allocated if success, which will be aligned to 8 bytes,
  *         NULL otherwise
@@ -526,6 +995,8 @@ do_gc_heap(gc_heap_t *heap)
 static hmu_t *
 alloc_hmu_ex(gc_heap_t *heap, gc_size_t size)
 {
+    hmu_t *hmu;
+
     bh_assert(gci_is_heap_valid(heap));
     bh_assert(size > 0 && !(size & 7));
 
@@ -534,7 +1005,13 @@ alloc_hmu_ex(gc_heap_t *heap, gc_size_t size)
     if (GC_SUCCESS != do_gc_heap(heap))
         return NULL;
 #else
-    if (heap->total_free_size < heap->gc_threshold) {
+    if (heap->total_free_size < heap->gc_threshold
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* the threshold is updated at the end of the cycle, the heap
+           is collected in one pause only if it runs out of memory */
+        && heap->gc_phase == GC_PHASE_IDLE
+#endif
+    ) {
         if (GC_SUCCESS != do_gc_heap(heap))
             return NULL;
     }
@@ -543,28 +1020,49 @@ alloc_hmu_ex(gc_heap_t *heap, gc_size_t size)
         if ((ret = alloc_hmu(heap, size))) {
             return ret;
         }
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        /* find a free chunk in the part of the heap not swept yet */
+        while (gci_incremental_sweep(heap, size)) {
+            if ((ret = alloc_hmu(heap, size)))
+                return ret;
+        }
+#endif
         if (GC_SUCCESS != do_gc_heap(heap))
             return NULL;
     }
 #endif
 #endif
 
-    return alloc_hmu(heap, size);
+    hmu = alloc_hmu(heap, size);
+#if BH_ENABLE_GC_SLAB != 0
+    if (!hmu && heap->slab_empty && slab_trim_empty_pages(heap))
+        /* Retry with the memory of the empty slab pages */
+        hmu = alloc_hmu(heap, size);
+#endif
+    return hmu;
 }
 
-#if BH_ENABLE_GC_VERIFY == 0
-gc_object_t
-gc_alloc_vo(void *vheap, gc_size_t size)
-#else
-gc_object_t
-gc_alloc_vo_internal(void *vheap, gc_size_t size, const char *file, int line)
+/* Allocate a vo object, the heap lock must have been held */
+static gc_object_t
+alloc_vo_locked(gc_heap_t *heap, gc_size_t size
+#if BH_ENABLE_GC_VERIFY != 0
+                ,
+                const char *file, int line
 #endif
+)
 {
-    gc_heap_t *heap = (gc_heap_t *)vheap;
     hmu_t *hmu = NULL;
     gc_object_t ret = (gc_object_t)NULL;
     gc_size_t tot_size = 0, tot_size_unaligned;
 
+#if BH_ENABLE_GC_SLAB != 0
+    if (size <= GC_SLAB_MAX_OBJ_SIZE && heap->slab_map
+        && (ret = slab_alloc(heap, size, false, &tot_size))) {
+        memset((uint8 *)ret + size, 0, tot_size - size);
+        return ret;
+    }
+#endif
+
     /* hmu header + prefix + obj + suffix */
     tot_size_unaligned = HMU_SIZE + OBJ_PREFIX_SIZE + size + OBJ_SUFFIX_SIZE;
     /* aligned size*/
@@ -573,18 +1071,9 @@ gc_alloc_vo_internal(void *vheap, gc_size_t size, const char *file, int line)
         /* integer overflow */
         return NULL;
 
-#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
-    if (heap->is_heap_corrupted) {
-        LOG_ERROR("[GC_ERROR]Heap is corrupted, allocate memory failed.\n");
-        return NULL;
-    }
-#endif
-
-    LOCK_HEAP(heap);
-
     hmu = alloc_hmu_ex(heap, tot_size);
     if (!hmu)
-        goto finish;
+        return NULL;
 
     bh_assert(hmu_get_size(hmu) >= tot_size);
     /* the total size allocated may be larger than
@@ -607,11 +1096,88 @@ gc_alloc_vo_internal(void *vheap, gc_size_t size, const char *file, int line)
         /* clear buffer appended by GC_ALIGN_8() */
         memset((uint8 *)ret + size, 0, tot_size - tot_size_unaligned);
 
-finish:
+    return ret;
+}
+
+#if BH_ENABLE_GC_VERIFY == 0
+gc_object_t
+gc_alloc_vo(void *vheap, gc_size_t size)
+#else
+gc_object_t
+gc_alloc_vo_internal(void *vheap, gc_size_t size, const char *file, int line)
+#endif
+{
+    gc_heap_t *heap = (gc_heap_t *)vheap;
+    gc_object_t ret;
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (heap->is_heap_corrupted) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, allocate memory failed.\n");
+        return NULL;
+    }
+#endif
+
+    LOCK_HEAP(heap);
+#if BH_ENABLE_GC_VERIFY == 0
+    ret = alloc_vo_locked(heap, size);
+#else
+    ret = alloc_vo_locked(heap, size, file, line);
+#endif
     UNLOCK_HEAP(heap);
     return ret;
 }
 
+#if BH_ENABLE_GC_VERIFY == 0
+int
+gc_alloc_vo_batch(void *vheap, gc_size_t size, gc_object_t *objs, int count)
+{
+    gc_heap_t *heap = (gc_heap_t *)vheap;
+    int i;
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (heap->is_heap_corrupted) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, allocate memory failed.\n");
+        return 0;
+    }
+#endif
+
+    LOCK_HEAP(heap);
+    for (i = 0; i < count; i++) {
+        if (!(objs[i] = alloc_vo_locked(heap, size)))
+            break;
+    }
+    UNLOCK_HEAP(heap);
+    return i;
+}
+
+gc_size_t
+gc_get_vo_size(void *vheap, gc_object_t obj)
+{
+    gc_heap_t *heap = (gc_heap_t *)vheap;
+    gc_uint8 *base_addr = heap->base_addr;
+    gc_uint8 *end_addr = base_addr + heap->current_size;
+    hmu_t *hmu = obj_to_hmu(obj);
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    int slot_idx;
+
+    if ((page = gci_obj_to_slab_page(heap, obj))) {
+        slot_idx = gci_slab_slot_index(page, obj);
+        if (slot_idx < 0 || page->is_wo
+            || !GC_SLAB_BIT_IS_SET(page->alloc_bits, slot_idx))
+            return 0;
+        return page->slot_size;
+    }
+#endif
+
+    if (!hmu_is_in_heap(hmu, base_addr, end_addr) || hmu_get_ut(hmu) != HMU_VO
+        || hmu_is_vo_freed(hmu))
+        return 0;
+
+    return hmu_obj_size(hmu_get_size(hmu));
+}
+#endif
+
 #if BH_ENABLE_GC_VERIFY == 0
 gc_object_t
 gc_realloc_vo(void *vheap, void *ptr, gc_size_t size)
@@ -628,6 +1194,9 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
     gc_size_t obj_size, obj_size_old;
     gc_uint8 *base_addr, *end_addr;
     hmu_type_t ut;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+#endif
 
     /* hmu header + prefix + obj + suffix */
     tot_size_unaligned = HMU_SIZE + OBJ_PREFIX_SIZE + size + OBJ_SUFFIX_SIZE;
@@ -644,6 +1213,26 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
     }
 #endif
 
+#if BH_ENABLE_GC_SLAB != 0
+    if (obj_old && (page = gci_obj_to_slab_page(heap, obj_old))) {
+        obj_size_old = page->slot_size;
+        if (size <= obj_size_old)
+            /* current slot already meets requirement */
+            return obj_old;
+
+        LOCK_HEAP(heap);
+        ret = alloc_vo_locked(heap, size);
+        UNLOCK_HEAP(heap);
+
+        if (ret) {
+            bh_memcpy_s(ret, size, obj_old, obj_size_old);
+            memset((uint8 *)ret + obj_size_old, 0, size - obj_size_old);
+            gc_free_vo(vheap, obj_old);
+        }
+        return ret;
+    }
+#endif
+
     if (obj_old) {
         hmu_old = obj_to_hmu(obj_old);
         tot_size_old = hmu_get_size(hmu_old);
@@ -662,12 +1251,25 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
         if (hmu_is_in_heap(hmu_next, base_addr, end_addr)) {
             ut = hmu_get_ut(hmu_next);
             tot_size_next = hmu_get_size(hmu_next);
-            if (ut == HMU_FC && tot_size <= tot_size_old + tot_size_next) {
+            if (ut == HMU_FC && tot_size <= tot_size_old + tot_size_next
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+                /* the free chunks not swept yet aren't in the free lists */
+                && !gci_is_unswept(heap, hmu_next)
+#endif
+            ) {
                 /* current node and next node meets requirement */
                 if (!unlink_hmu(heap, hmu_next)) {
                     UNLOCK_HEAP(heap);
                     return NULL;
                 }
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+                /* the merged block may be a boundary of the parallel sweep */
+                heap->is_sweep_bounds_valid = 0;
+#endif
+                /* a remainder smaller than the smallest chunk can't be
+                   linked into the free lists, take it as a whole */
+                if (tot_size_old + tot_size_next - tot_size < GC_SMALLEST_SIZE)
+                    tot_size = tot_size_old + tot_size_next;
                 hmu_set_size(hmu_old, tot_size);
                 memset((char *)hmu_old + tot_size_old, 0,
                        tot_size - tot_size_old);
@@ -683,6 +1285,18 @@ gc_realloc_vo_internal(void *vheap, void *ptr, gc_size_t size, const char *file,
                     }
                     hmu_mark_pinuse(hmu_next);
                 }
+                else {
+                    /* the next node is used up, the node after it must
+                       know that its previous node is in use now */
+                    hmu_next = (hmu_t *)((char *)hmu_old + tot_size);
+                    if (hmu_is_in_heap(hmu_next, base_addr, end_addr))
+                        hmu_mark_pinuse(hmu_next);
+                }
+                heap->total_free_size -= tot_size - tot_size_old;
+                if ((heap->current_size - heap->total_free_size)
+                    > heap->highmark_size)
+                    heap->highmark_size =
+                        heap->current_size - heap->total_free_size;
                 UNLOCK_HEAP(heap);
                 return obj_old;
             }
@@ -738,9 +1352,22 @@ gc_free_wo(void *vheap, void *ptr)
     gc_heap_t *heap = (gc_heap_t *)vheap;
     gc_object_t *obj = (gc_object_t *)ptr;
     hmu_t *hmu = obj_to_hmu(obj);
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    int slot_idx;
+#endif
 
     bh_assert(gci_is_heap_valid(heap));
     bh_assert(obj);
+
+#if BH_ENABLE_GC_SLAB != 0
+    if ((page = gci_obj_to_slab_page(heap, obj))) {
+        slot_idx = gci_slab_slot_index(page, obj);
+        bh_assert(page->is_wo && slot_idx >= 0);
+        GC_SLAB_CLR_BIT(page->mark_bits, slot_idx);
+        return;
+    }
+#endif
     bh_assert((gc_uint8 *)hmu >= heap->base_addr
               && (gc_uint8 *)hmu < heap->base_addr + heap->current_size);
     bh_assert(hmu_get_ut(hmu) == HMU_WO);
@@ -750,6 +1377,109 @@ gc_free_wo(void *vheap, void *ptr)
 }
 #endif
 
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Add a region to the nursery, the nursery is collected at first if
+ * it is full or the heap is running out of memory
+ *
+ * @return true if success, false otherwise
+ */
+static bool
+nursery_add_region(gc_heap_t *heap)
+{
+    hmu_t *hmu;
+    gc_uint32 idx;
+
+    if (heap->nursery_region_cnt == heap->nursery_region_max
+        || heap->total_free_size < heap->gc_threshold) {
+        if (GC_SUCCESS != do_gc_heap(heap))
+            return false;
+        if (heap->nursery_region_cnt == heap->nursery_region_max)
+            /* reclaim isn't enabled yet */
+            return false;
+    }
+
+    /* don't trigger GC again here, the caller falls back to the normal
+       allocation if the heap has no free chunk for the region */
+    if (!(hmu = alloc_hmu(heap, GC_NURSERY_REGION_SIZE)))
+        return false;
+
+    /* the unused memory of the region isn't linked to the free lists */
+    hmu_set_ut(hmu, HMU_FM);
+
+    idx = heap->nursery_region_cnt++;
+    heap->nursery_regions[idx * 2] =
+        (gc_uint32)((gc_uint8 *)hmu - heap->base_addr);
+    heap->nursery_regions[idx * 2 + 1] = hmu_get_size(hmu);
+    heap->nursery_cur = (gc_uint8 *)hmu;
+    heap->nursery_end = heap->nursery_cur + hmu_get_size(hmu);
+    return true;
+}
+
+/**
+ * Bump allocate an object from the current nursery region
+ *
+ * @param size the total size of the object, including the hmu header
+ *
+ * @return the hmu of the object if success, NULL otherwise
+ */
+static hmu_t *
+nursery_alloc(gc_heap_t *heap, gc_size_t size)
+{
+    hmu_t *hmu, *rest;
+    gc_size_t remain;
+
+    if ((gc_size_t)(heap->nursery_end - heap->nursery_cur) < size
+        && !nursery_add_region(heap))
+        return NULL;
+
+    hmu = (hmu_t *)heap->nursery_cur;
+    remain = (gc_size_t)(heap->nursery_end - heap->nursery_cur) - size;
+    if (remain < GC_SMALLEST_SIZE) {
+        /* the remaining memory is too small to be a chunk */
+        size += remain;
+        remain = 0;
+    }
+
+    /* the object takes the place and the pinuse bit of the free tail */
+    hmu_set_ut(hmu, HMU_WO);
+    hmu_set_size(hmu, size);
+    heap->nursery_cur += size;
+
+    if (remain > 0) {
+        rest = (hmu_t *)heap->nursery_cur;
+        rest->header = 0;
+        hmu_set_ut(rest, HMU_FM);
+        hmu_set_size(rest, remain);
+        hmu_mark_pinuse(rest);
+    }
+    return hmu;
+}
+#endif /* end of WASM_ENABLE_GC_NURSERY != 0 */
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+/**
+ * Run a slice of the incremental collection if the heap is running low
+ * on memory, or enough objects are allocated since the last slice in
+ * the collection cycle
+ *
+ * @param size the total size of the object to allocate
+ */
+static void
+incremental_alloc_step(gc_heap_t *heap, gc_size_t size)
+{
+    if (!heap->is_reclaim_enabled)
+        return;
+
+    heap->step_alloc_size += size;
+    if (heap->gc_phase == GC_PHASE_IDLE
+            ? heap->total_free_size / GC_INCREMENTAL_START_FACTOR
+                  < heap->gc_threshold
+            : heap->step_alloc_size >= GC_INCREMENTAL_STEP_SIZE)
+        gci_incremental_step(heap);
+}
+#endif
+
 /* see ems_gc.h for description*/
 #if BH_ENABLE_GC_VERIFY == 0
 gc_object_t
@@ -781,7 +1511,35 @@ gc_alloc_wo_internal(void *vheap, gc_size_t size, const char *file, int line)
 
     LOCK_HEAP(heap);
 
-    hmu = alloc_hmu_ex(heap, tot_size);
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (heap->is_incremental)
+        incremental_alloc_step(heap, tot_size);
+#endif
+
+#if BH_ENABLE_GC_SLAB != 0
+    if (size <= GC_SLAB_MAX_OBJ_SIZE && heap->slab_map
+#if WASM_ENABLE_GC_NURSERY != 0
+        /* the slab objects have no hmu header to keep the old mark */
+        && !heap->is_generational
+#endif
+        && (ret = slab_alloc(heap, size, true, &tot_size))) {
+        memset((uint8 *)ret + size, 0, tot_size - size);
+        goto finish;
+    }
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (heap->is_generational) {
+        if (tot_size <= GC_NURSERY_MAX_OBJ_SIZE)
+            hmu = nursery_alloc(heap, tot_size);
+        if (!hmu && (hmu = alloc_hmu_ex(heap, tot_size)))
+            /* the young object out of the nursery is traced as a root
+               by the minor collections until it becomes old */
+            gci_remset_add(heap, hmu_to_obj(hmu));
+    }
+    else
+#endif
+        hmu = alloc_hmu_ex(heap, tot_size);
     if (!hmu)
         goto finish;
 
@@ -801,7 +1559,13 @@ gc_alloc_wo_internal(void *vheap, gc_size_t size, const char *file, int line)
 #if GC_MANUALLY != 0
     hmu_mark_wo(hmu);
 #else
-    hmu_unmark_wo(hmu);
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    /* the objects allocated in the mark phase are live */
+    if (heap->gc_phase == GC_PHASE_MARK)
+        hmu_mark_wo(hmu);
+    else
+#endif
+        hmu_unmark_wo(hmu);
 #endif
 
 #if BH_ENABLE_GC_VERIFY != 0
@@ -833,32 +1597,19 @@ gci_is_heap_valid(gc_heap_t *heap)
     return GC_TRUE;
 }
 
-#if BH_ENABLE_GC_VERIFY == 0
-int
-gc_free_vo(void *vheap, gc_object_t obj)
-#else
-int
-gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
-#endif
+/* Free a vo object, the heap lock must have been held */
+static int
+free_vo_locked(gc_heap_t *heap, gc_object_t obj)
 {
-    gc_heap_t *heap = (gc_heap_t *)vheap;
     gc_uint8 *base_addr, *end_addr;
     hmu_t *hmu = NULL;
     hmu_t *prev = NULL;
     hmu_t *next = NULL;
     gc_size_t size = 0;
     hmu_type_t ut;
-    int ret = GC_SUCCESS;
-
-    if (!obj) {
-        return GC_SUCCESS;
-    }
-
-#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
-    if (heap->is_heap_corrupted) {
-        LOG_ERROR("[GC_ERROR]Heap is corrupted, free memory failed.\n");
-        return GC_ERROR;
-    }
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    bool release;
 #endif
 
     hmu = obj_to_hmu(obj);
@@ -866,75 +1617,144 @@ gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
     base_addr = heap->base_addr;
     end_addr = base_addr + heap->current_size;
 
-    LOCK_HEAP(heap);
+    if (!hmu_is_in_heap(hmu, base_addr, end_addr))
+        return GC_SUCCESS;
+
+#if BH_ENABLE_GC_SLAB != 0
+    if ((page = gci_obj_to_slab_page(heap, obj))) {
+        if (slab_free_vo(heap, page, obj, &release) != GC_SUCCESS)
+            return GC_ERROR;
+        if (!release)
+            return GC_SUCCESS;
+        /* Free the hmu of the empty page */
+        hmu = obj_to_hmu(page);
+    }
+#endif
 
-    if (hmu_is_in_heap(hmu, base_addr, end_addr)) {
 #if BH_ENABLE_GC_VERIFY != 0
-        hmu_verify(heap, hmu);
-#endif
-        ut = hmu_get_ut(hmu);
-        if (ut == HMU_VO) {
-            if (hmu_is_vo_freed(hmu)) {
-                bh_assert(0);
-                ret = GC_ERROR;
-                goto out;
-            }
+    hmu_verify(heap, hmu);
+#endif
+    ut = hmu_get_ut(hmu);
+    if (ut != HMU_VO)
+        return GC_ERROR;
 
-            size = hmu_get_size(hmu);
+    if (hmu_is_vo_freed(hmu)) {
+        bh_assert(0);
+        return GC_ERROR;
+    }
+
+    size = hmu_get_size(hmu);
 
-            heap->total_free_size += size;
+    heap->total_free_size += size;
 
 #if GC_STAT_DATA != 0
-            heap->total_size_freed += size;
+    heap->total_size_freed += size;
 #endif
 
-            if (!hmu_get_pinuse(hmu)) {
-                prev = (hmu_t *)((char *)hmu - *((int *)hmu - 1));
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (gci_is_unswept(heap, hmu)) {
+        /* the block is reclaimed when the lazy sweep reaches it */
+        hmu_free_vo(hmu);
+        return GC_SUCCESS;
+    }
+#endif
 
-                if (hmu_is_in_heap(prev, base_addr, end_addr)
-                    && hmu_get_ut(prev) == HMU_FC) {
-                    size += hmu_get_size(prev);
-                    hmu = prev;
-                    if (!unlink_hmu(heap, prev)) {
-                        ret = GC_ERROR;
-                        goto out;
-                    }
-                }
-            }
+    if (!hmu_get_pinuse(hmu)) {
+        prev = (hmu_t *)((char *)hmu - *((int *)hmu - 1));
+
+        if (hmu_is_in_heap(prev, base_addr, end_addr)
+            && hmu_get_ut(prev) == HMU_FC) {
+            size += hmu_get_size(prev);
+            hmu = prev;
+            if (!unlink_hmu(heap, prev))
+                return GC_ERROR;
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+            /* the merged block may be a boundary of the parallel sweep */
+            heap->is_sweep_bounds_valid = 0;
+#endif
+        }
+    }
 
+    next = (hmu_t *)((char *)hmu + size);
+    if (hmu_is_in_heap(next, base_addr, end_addr)) {
+        if (hmu_get_ut(next) == HMU_FC
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+            /* the free chunks not swept yet aren't in the free lists */
+            && !gci_is_unswept(heap, next)
+#endif
+        ) {
+            size += hmu_get_size(next);
+            if (!unlink_hmu(heap, next))
+                return GC_ERROR;
             next = (hmu_t *)((char *)hmu + size);
-            if (hmu_is_in_heap(next, base_addr, end_addr)) {
-                if (hmu_get_ut(next) == HMU_FC) {
-                    size += hmu_get_size(next);
-                    if (!unlink_hmu(heap, next)) {
-                        ret = GC_ERROR;
-                        goto out;
-                    }
-                    next = (hmu_t *)((char *)hmu + size);
-                }
-            }
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+            /* the merged block may be a boundary of the parallel sweep */
+            heap->is_sweep_bounds_valid = 0;
+#endif
+        }
+    }
 
-            if (!gci_add_fc(heap, hmu, size)) {
-                ret = GC_ERROR;
-                goto out;
-            }
+    if (!gci_add_fc(heap, hmu, size))
+        return GC_ERROR;
 
-            if (hmu_is_in_heap(next, base_addr, end_addr)) {
-                hmu_unmark_pinuse(next);
-            }
-        }
-        else {
-            ret = GC_ERROR;
-            goto out;
-        }
-        ret = GC_SUCCESS;
-        goto out;
+    if (hmu_is_in_heap(next, base_addr, end_addr)) {
+        hmu_unmark_pinuse(next);
     }
 
-out:
+    return GC_SUCCESS;
+}
+
+#if BH_ENABLE_GC_VERIFY == 0
+int
+gc_free_vo(void *vheap, gc_object_t obj)
+#else
+int
+gc_free_vo_internal(void *vheap, gc_object_t obj, const char *file, int line)
+#endif
+{
+    gc_heap_t *heap = (gc_heap_t *)vheap;
+    int ret;
+
+    if (!obj) {
+        return GC_SUCCESS;
+    }
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (heap->is_heap_corrupted) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, free memory failed.\n");
+        return GC_ERROR;
+    }
+#endif
+
+    LOCK_HEAP(heap);
+    ret = free_vo_locked(heap, obj);
+    UNLOCK_HEAP(heap);
+    return ret;
+}
+
+#if BH_ENABLE_GC_VERIFY == 0
+int
+gc_free_vo_batch(void *vheap, gc_object_t *objs, int count)
+{
+    gc_heap_t *heap = (gc_heap_t *)vheap;
+    int i, ret = GC_SUCCESS;
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (heap->is_heap_corrupted) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, free memory failed.\n");
+        return GC_ERROR;
+    }
+#endif
+
+    LOCK_HEAP(heap);
+    for (i = 0; i < count; i++) {
+        if (free_vo_locked(heap, objs[i]) != GC_SUCCESS)
+            ret = GC_ERROR;
+    }
     UNLOCK_HEAP(heap);
     return ret;
 }
+#endif
 
 void
 gc_dump_heap_stats(gc_heap_t *heap)
@@ -981,6 +1801,10 @@ gci_dump(gc_heap_t *heap)
             inuse = hmu_is_wo_marked(cur) ? 'W' : 'w';
         else if (ut == HMU_FC)
             inuse = 'F';
+#if BH_ENABLE_GC_SLAB != 0
+        if (ut == HMU_VO && gci_hmu_to_slab_page(heap, cur))
+            inuse = 'S';
+#endif
 
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
         if (size == 0 || size > (uint32)((uint8 *)end - (uint8 *)cur)) {
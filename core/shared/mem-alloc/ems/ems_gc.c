@@ -58,27 +58,1757 @@ free_mark_node(mark_node_t *node)
     BH_FREE((gc_object_t)node);
 }
 
+#if WASM_ENABLE_GC_NURSERY != 0
+/* the heaps with nursery, the write barrier searches them to find
+   the heap of an object */
+static gc_heap_t *generational_heap_list;
+static korp_mutex generational_heap_list_lock;
+
+int
+gc_init_nursery_list(void)
+{
+    if (os_mutex_init(&generational_heap_list_lock) != BHT_OK) {
+        LOG_ERROR("[GC_ERROR]failed to init lock\n");
+        return GC_ERROR;
+    }
+    return GC_SUCCESS;
+}
+
+void
+gc_destroy_nursery_list(void)
+{
+    os_mutex_destroy(&generational_heap_list_lock);
+}
+
+int
+gc_enable_nursery(gc_handle_t handle)
+{
+#if BH_ENABLE_GC_VERIFY == 0 && GC_MANUALLY == 0 \
+    && GC_IN_EVERY_ALLOCATION == 0
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    gc_uint32 region_max = heap->current_size / 4 / GC_NURSERY_REGION_SIZE;
+
+    if (heap->is_generational)
+        return GC_SUCCESS;
+
+    /* the nursery takes at most a quarter of the heap */
+    if (region_max < 2)
+        return GC_ERROR;
+    if (region_max > GC_NURSERY_REGION_MAX)
+        region_max = GC_NURSERY_REGION_MAX;
+
+    /* two words for the offset and size of each region */
+    heap->nursery_regions =
+        (gc_uint32 *)BH_MALLOC(sizeof(gc_uint32) * 2 * region_max);
+    if (!heap->nursery_regions) {
+        LOG_ERROR("alloc nursery regions failed");
+        return GC_ERROR;
+    }
+    heap->nursery_region_max = region_max;
+    heap->is_generational = 1;
+
+    os_mutex_lock(&generational_heap_list_lock);
+    heap->next_generational = generational_heap_list;
+    generational_heap_list = heap;
+    os_mutex_unlock(&generational_heap_list_lock);
+    return GC_SUCCESS;
+#else
+    /* the nursery objects have no verification prefix and suffix,
+       and they are never collected in the allocation path */
+    (void)handle;
+    return GC_ERROR;
+#endif
+}
+
+void
+gci_destroy_nursery(gc_heap_t *heap)
+{
+    gc_heap_t **p_heap;
+
+    if (!heap->is_generational)
+        return;
+
+    os_mutex_lock(&generational_heap_list_lock);
+    for (p_heap = &generational_heap_list; *p_heap;
+         p_heap = &(*p_heap)->next_generational) {
+        if (*p_heap == heap) {
+            *p_heap = heap->next_generational;
+            break;
+        }
+    }
+    os_mutex_unlock(&generational_heap_list_lock);
+
+    BH_FREE(heap->nursery_regions);
+    if (heap->remset)
+        BH_FREE(heap->remset);
+    heap->nursery_regions = NULL;
+    heap->remset = NULL;
+    heap->is_generational = 0;
+}
+
+void
+gci_remset_add(gc_heap_t *heap, gc_object_t obj)
+{
+    gc_object_t *remset;
+    gc_uint32 capacity;
+
+    if (heap->is_major_gc_required)
+        /* all objects will be traced by the next collection */
+        return;
+
+    if (heap->remset_cnt == heap->remset_capacity) {
+        capacity = heap->remset_capacity > 0 ? heap->remset_capacity * 2
+                                             : GC_REMSET_INIT_SIZE;
+        if (capacity > GC_REMSET_MAX_SIZE
+            || !(remset = (gc_object_t *)BH_MALLOC(sizeof(gc_object_t)
+                                                   * capacity))) {
+            /* give up remembering, the next collection is a major one */
+            heap->is_major_gc_required = 1;
+            return;
+        }
+        if (heap->remset) {
+            bh_memcpy_s(remset, (uint32)(sizeof(gc_object_t) * capacity),
+                        heap->remset,
+                        (uint32)(sizeof(gc_object_t) * heap->remset_cnt));
+            BH_FREE(heap->remset);
+        }
+        heap->remset = remset;
+        heap->remset_capacity = capacity;
+    }
+
+    heap->remset[heap->remset_cnt++] = obj;
+}
+
+void
+gc_write_barrier(gc_object_t obj, gc_object_t ref)
+{
+    gc_heap_t *heap;
+    hmu_t *hmu = obj_to_hmu(obj);
+
+    /* only an old (marked) object made to refer to a young (unmarked)
+       object needs to be remembered, null and i31 refs aren't objects */
+    if (!ref || ((uintptr_t)ref & 1) || !hmu_is_wo_marked(hmu)
+        || hmu_is_wo_marked(obj_to_hmu(ref)) || !generational_heap_list)
+        return;
+
+    os_mutex_lock(&generational_heap_list_lock);
+    heap = generational_heap_list;
+    while (heap
+           && !((gc_uint8 *)hmu >= heap->base_addr
+                && (gc_uint8 *)hmu < heap->base_addr + heap->current_size))
+        heap = heap->next_generational;
+    os_mutex_unlock(&generational_heap_list_lock);
+
+    if (!heap)
+        return;
+
+    gct_vm_mutex_lock(&heap->lock);
+    /* unmark the object so that it is remembered only once, the next
+       minor collection marks it again */
+    if (hmu_is_wo_marked(hmu)) {
+        hmu_unmark_wo(hmu);
+        gci_remset_add(heap, obj);
+    }
+    gct_vm_mutex_unlock(&heap->lock);
+}
+
+/**
+ * Make the nursery empty after a collection, the next objects are
+ * allocated from new regions
+ *
+ * @param heap the generational heap
+ * @param is_major_gc_required whether the next collection must trace
+ *        all objects
+ */
+static void
+reset_nursery(gc_heap_t *heap, bool is_major_gc_required)
+{
+    heap->nursery_cur = heap->nursery_end = NULL;
+    heap->nursery_region_cnt = 0;
+    heap->remset_cnt = 0;
+    heap->is_major_gc_required = is_major_gc_required ? 1 : 0;
+}
+#endif /* end of WASM_ENABLE_GC_NURSERY != 0 */
+
+#if BH_ENABLE_GC_SLAB != 0
+/**
+ * Sweep the wo objects of a slab page, and add the page to the list of
+ * pages with free slots of its class if it isn't empty
+ *
+ * @param lock the lock to hold when running the finalizers and linking
+ *        the page, NULL if the heap is swept by one thread
+ *
+ * @return true if the page is still in use, false if it becomes empty
+ *         and is released
+ */
+static bool
+sweep_slab_page(gc_heap_t *heap, gc_slab_page_t *page, korp_mutex *lock)
+{
+    gc_uint32 i, j, dead;
+    gc_object_t obj;
+    bool ret = true;
+
+    if (page->is_wo) {
+        for (i = 0; i < GC_SLAB_BITMAP_WORDS; i++) {
+            dead = page->alloc_bits[i] & ~page->mark_bits[i];
+            for (j = 0; dead; j++, dead >>= 1) {
+                if (!(dead & 1))
+                    continue;
+
+                /* Invoke registered finalizer */
+                obj = GC_SLAB_PAGE_SLOTS(page)
+                      + (i * 32 + j) * (gc_uint32)page->slot_size;
+                if (gct_vm_get_extra_info_flag(obj)) {
+                    extra_info_node_t *node;
+
+                    if (lock)
+                        os_mutex_lock(lock);
+                    node = gc_search_extra_info_node((gc_handle_t)heap, obj,
+                                                     NULL);
+                    bh_assert(node);
+                    node->finalizer(node->obj, node->data);
+                    gc_unset_finalizer((gc_handle_t)heap, obj);
+                    if (lock)
+                        os_mutex_unlock(lock);
+                }
+                page->free_num++;
+            }
+            page->alloc_bits[i] &= page->mark_bits[i];
+            /* unmark the live objects */
+            page->mark_bits[i] = gci_slab_padding_bits(page, i);
+        }
+    }
+
+    if (page->free_num == 0)
+        return true;
+
+    if (lock)
+        os_mutex_lock(lock);
+    if (page->free_num == page->slot_num) {
+        gci_slab_release_page(heap, page);
+        ret = false;
+    }
+    else
+        gci_slab_link_page(heap, page);
+    if (lock)
+        os_mutex_unlock(lock);
+    return ret;
+}
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+/* The jobs run by all the GC workers */
+#define GC_MARK_JOB_MARK 0
+#define GC_MARK_JOB_SWEEP 1
+#define GC_MARK_JOB_EXIT 2
+
+/* A free area found by the parallel sweep, it is saved at the head of
+   the area until the area is added to the free lists */
+typedef struct sweep_area {
+    gc_size_t size;
+    /* offset of the next area from the heap base address, 0 if none */
+    gc_uint32 next_offset;
+} sweep_area_t;
+
+typedef struct gc_mark_worker {
+    /* the private mark stack */
+    mark_node_t *stack;
+    /* the full mark nodes which can be stolen by the other workers */
+    mark_node_t *shared;
+    korp_mutex shared_lock;
+    korp_tid tid;
+    /* the number and the size of the objects marked */
+    gc_uint64 marked_cnt;
+    gc_uint64 marked_size;
+    /* the free areas of the range swept in address order, and the
+       free size of the range */
+    sweep_area_t *free_areas;
+    sweep_area_t *free_areas_tail;
+    gc_size_t free_size;
+} gc_mark_worker_t;
+
+typedef struct gc_mark_pool {
+    /* the worker 0 is the thread doing the collection, the others are
+       the threads of the pool */
+    gc_mark_worker_t workers[WASM_GC_MARK_THREAD_NUM];
+    korp_mutex lock;
+    /* signaled when a job is posted and when it is finished by all
+       threads of the pool */
+    korp_cond job_cond;
+    korp_cond done_cond;
+    gc_heap_t *heap;
+    int job;
+    gc_uint32 job_seq;
+    gc_uint32 running_cnt;
+    gc_uint32 thread_cnt;
+    /* whether a heap is being collected with the pool */
+    bool is_busy;
+    bool is_inited;
+
+    /* the workers waiting for the mark nodes to steal, the marking is
+       finished when all workers are idle and no node is shared */
+    korp_mutex idle_lock;
+    korp_cond idle_cond;
+    gc_uint32 idle_cnt;
+    gc_uint32 shared_cnt;
+    gc_uint32 is_failed;
+
+    /* protects the finalizers and the slab page lists in sweeping */
+    korp_mutex sweep_lock;
+} gc_mark_pool_t;
+
+static gc_mark_pool_t mark_pool;
+
+static void
+sweep_heap_range(gc_heap_t *heap, gc_mark_worker_t *worker);
+
+static void
+mark_objects_parallel(gc_heap_t *heap, gc_mark_worker_t *worker);
+
+static void
+run_mark_job(gc_heap_t *heap, int job, gc_mark_worker_t *worker)
+{
+    if (job == GC_MARK_JOB_MARK)
+        mark_objects_parallel(heap, worker);
+    else
+        sweep_heap_range(heap, worker);
+}
+
+static void *
+mark_worker_routine(void *arg)
+{
+    gc_mark_worker_t *worker = (gc_mark_worker_t *)arg;
+    gc_uint32 job_seq = 0;
+    int job;
+
+    os_mutex_lock(&mark_pool.lock);
+    while (true) {
+        while (mark_pool.job_seq == job_seq)
+            os_cond_wait(&mark_pool.job_cond, &mark_pool.lock);
+
+        job_seq = mark_pool.job_seq;
+        if ((job = mark_pool.job) == GC_MARK_JOB_EXIT)
+            break;
+        os_mutex_unlock(&mark_pool.lock);
+
+        run_mark_job(mark_pool.heap, job, worker);
+
+        os_mutex_lock(&mark_pool.lock);
+        if (--mark_pool.running_cnt == 0)
+            os_cond_signal(&mark_pool.done_cond);
+    }
+    os_mutex_unlock(&mark_pool.lock);
+
+    return NULL;
+}
+
+/**
+ * Run the job with all the workers, return after all of them finish it
+ */
+static void
+post_mark_job(gc_heap_t *heap, int job)
+{
+    os_mutex_lock(&mark_pool.lock);
+    mark_pool.heap = heap;
+    mark_pool.job = job;
+    mark_pool.job_seq++;
+    mark_pool.running_cnt = mark_pool.thread_cnt - 1;
+    os_cond_broadcast(&mark_pool.job_cond);
+    os_mutex_unlock(&mark_pool.lock);
+
+    if (job == GC_MARK_JOB_EXIT)
+        return;
+
+    run_mark_job(heap, job, &mark_pool.workers[0]);
+
+    os_mutex_lock(&mark_pool.lock);
+    while (mark_pool.running_cnt > 0)
+        os_cond_wait(&mark_pool.done_cond, &mark_pool.lock);
+    os_mutex_unlock(&mark_pool.lock);
+}
+
+static void
+stop_mark_workers(void)
+{
+    gc_uint32 i;
+
+    post_mark_job(NULL, GC_MARK_JOB_EXIT);
+
+    for (i = 1; i < mark_pool.thread_cnt; i++)
+        os_thread_join(mark_pool.workers[i].tid, NULL);
+    mark_pool.thread_cnt = 1;
+}
+
+int
+gc_init_mark_workers(void)
+{
+    gc_mark_worker_t *worker;
+    gc_uint32 i;
+
+    memset(&mark_pool, 0, sizeof(mark_pool));
+
+    if (os_mutex_init(&mark_pool.lock) != 0)
+        return GC_ERROR;
+    if (os_cond_init(&mark_pool.job_cond) != 0)
+        goto fail1;
+    if (os_cond_init(&mark_pool.done_cond) != 0)
+        goto fail2;
+    if (os_mutex_init(&mark_pool.idle_lock) != 0)
+        goto fail3;
+    if (os_cond_init(&mark_pool.idle_cond) != 0)
+        goto fail4;
+    if (os_mutex_init(&mark_pool.sweep_lock) != 0)
+        goto fail5;
+
+    for (i = 0; i < WASM_GC_MARK_THREAD_NUM; i++) {
+        if (os_mutex_init(&mark_pool.workers[i].shared_lock) != 0)
+            goto fail6;
+    }
+
+    for (mark_pool.thread_cnt = 1;
+         mark_pool.thread_cnt < WASM_GC_MARK_THREAD_NUM;
+         mark_pool.thread_cnt++) {
+        worker = &mark_pool.workers[mark_pool.thread_cnt];
+        if (os_thread_create(&worker->tid, mark_worker_routine, worker,
+                             APP_THREAD_STACK_SIZE_DEFAULT)
+            != 0) {
+            LOG_ERROR("create GC worker thread failed");
+            stop_mark_workers();
+            goto fail6;
+        }
+    }
+
+    mark_pool.is_inited = true;
+    return GC_SUCCESS;
+
+fail6:
+    while (i > 0)
+        os_mutex_destroy(&mark_pool.workers[--i].shared_lock);
+    os_mutex_destroy(&mark_pool.sweep_lock);
+fail5:
+    os_cond_destroy(&mark_pool.idle_cond);
+fail4:
+    os_mutex_destroy(&mark_pool.idle_lock);
+fail3:
+    os_cond_destroy(&mark_pool.done_cond);
+fail2:
+    os_cond_destroy(&mark_pool.job_cond);
+fail1:
+    os_mutex_destroy(&mark_pool.lock);
+    return GC_ERROR;
+}
+
+void
+gc_destroy_mark_workers(void)
+{
+    gc_uint32 i;
+
+    if (!mark_pool.is_inited)
+        return;
+
+    stop_mark_workers();
+
+    for (i = 0; i < WASM_GC_MARK_THREAD_NUM; i++)
+        os_mutex_destroy(&mark_pool.workers[i].shared_lock);
+    os_mutex_destroy(&mark_pool.sweep_lock);
+    os_cond_destroy(&mark_pool.idle_cond);
+    os_mutex_destroy(&mark_pool.idle_lock);
+    os_cond_destroy(&mark_pool.done_cond);
+    os_cond_destroy(&mark_pool.job_cond);
+    os_mutex_destroy(&mark_pool.lock);
+    mark_pool.is_inited = false;
+}
+
+/**
+ * Take the pool to collect the heap, return false if the heap is small
+ * or another heap is being collected with the pool
+ */
+static bool
+acquire_mark_workers(gc_heap_t *heap)
+{
+    bool ret = false;
+
+    if (heap->current_size < GC_PARALLEL_MARK_MIN_HEAP_SIZE)
+        return false;
+
+    os_mutex_lock(&mark_pool.lock);
+    if (mark_pool.is_inited && !mark_pool.is_busy)
+        ret = mark_pool.is_busy = true;
+    os_mutex_unlock(&mark_pool.lock);
+
+    return ret;
+}
+
+static void
+release_mark_workers(void)
+{
+    os_mutex_lock(&mark_pool.lock);
+    mark_pool.is_busy = false;
+    os_mutex_unlock(&mark_pool.lock);
+}
+
+static void
+add_sweep_area(gc_heap_t *heap, gc_mark_worker_t *worker, hmu_t *hmu,
+               gc_size_t size)
+{
+    sweep_area_t *area = (sweep_area_t *)hmu;
+
+    area->size = size;
+    area->next_offset = 0;
+    if (worker->free_areas_tail)
+        worker->free_areas_tail->next_offset =
+            (gc_uint32)((gc_uint8 *)area - heap->base_addr);
+    else
+        worker->free_areas = area;
+    worker->free_areas_tail = area;
+    worker->free_size += size;
+}
+
+/**
+ * Sweep the range of the heap between two sweep bounds, the free areas
+ * found are added to the free lists by the thread doing the collection
+ */
+static void
+sweep_heap_range(gc_heap_t *heap, gc_mark_worker_t *worker)
+{
+    gc_uint32 idx = (gc_uint32)(worker - mark_pool.workers);
+    hmu_t *cur = NULL, *end = NULL, *last = NULL;
+    hmu_type_t ut;
+    gc_size_t size;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+#endif
+
+    cur = (hmu_t *)(heap->base_addr + heap->sweep_bounds[idx]);
+    end = (hmu_t *)(heap->base_addr
+                    + (idx + 1 < WASM_GC_MARK_THREAD_NUM
+                           ? heap->sweep_bounds[idx + 1]
+                           : heap->current_size));
+
+    worker->free_areas = worker->free_areas_tail = NULL;
+    worker->free_size = 0;
+
+    while (cur < end) {
+        ut = hmu_get_ut(cur);
+        size = hmu_get_size(cur);
+        bh_assert(size > 0);
+
+#if BH_ENABLE_GC_SLAB != 0
+        if (ut == HMU_VO && (page = gci_hmu_to_slab_page(heap, cur))) {
+            if (!sweep_slab_page(heap, page, &mark_pool.sweep_lock))
+                ut = HMU_FM;
+            else
+                worker->free_size +=
+                    (gc_size_t)page->free_num * page->slot_size;
+        }
+#endif
+
+        if (ut == HMU_FC || ut == HMU_FM
+            || (ut == HMU_VO && hmu_is_vo_freed(cur))
+            || (ut == HMU_WO && !hmu_is_wo_marked(cur))) {
+            if (!last)
+                last = cur;
+
+            if (ut == HMU_WO) {
+                gc_object_t cur_obj = hmu_to_obj(cur);
+                if (gct_vm_get_extra_info_flag(cur_obj)) {
+                    extra_info_node_t *node;
+
+                    os_mutex_lock(&mark_pool.sweep_lock);
+                    node = gc_search_extra_info_node((gc_handle_t)heap,
+                                                     cur_obj, NULL);
+                    bh_assert(node);
+                    node->finalizer(node->obj, node->data);
+                    gc_unset_finalizer((gc_handle_t)heap, cur_obj);
+                    os_mutex_unlock(&mark_pool.sweep_lock);
+                }
+            }
+        }
+        else {
+            if (last) {
+                add_sweep_area(heap, worker, last,
+                               (gc_size_t)((char *)cur - (char *)last));
+                last = NULL;
+            }
+
+            if (ut == HMU_WO) {
+#if WASM_ENABLE_GC_NURSERY != 0
+                if (!heap->is_generational)
+#endif
+                    hmu_unmark_wo(cur);
+            }
+        }
+
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+    bh_assert(cur == end);
+
+    if (last)
+        add_sweep_area(heap, worker, last,
+                       (gc_size_t)((char *)cur - (char *)last));
+}
+
+/**
+ * Sweep the heap with all the workers
+ *
+ * @return the free size of the heap
+ */
+static gc_size_t
+sweep_heap_parallel(gc_heap_t *heap)
+{
+    gc_mark_worker_t *worker;
+    sweep_area_t *area;
+    gc_uint32 i, next_offset;
+    gc_size_t size, tot_free = 0;
+
+    post_mark_job(heap, GC_MARK_JOB_SWEEP);
+
+    for (i = 0; i < WASM_GC_MARK_THREAD_NUM; i++) {
+        worker = &mark_pool.workers[i];
+        area = worker->free_areas;
+        while (area) {
+            next_offset = area->next_offset;
+            size = area->size;
+            gci_add_fc(heap, (hmu_t *)area, size);
+            hmu_mark_pinuse((hmu_t *)area);
+            area = next_offset ? (sweep_area_t *)(heap->base_addr + next_offset)
+                               : NULL;
+        }
+        tot_free += worker->free_size;
+    }
+
+    return tot_free;
+}
+
+/**
+ * Set the mark bit of the wo object atomically
+ *
+ * @return true if the object is marked by this call, false if it has
+ *         already been marked
+ */
+static inline bool
+try_mark_wo(gc_heap_t *heap, gc_object_t obj)
+{
+    hmu_t *hmu = obj_to_hmu(obj);
+    gc_uint32 bit;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    int slot_idx;
+
+    if ((page = gci_obj_to_slab_page(heap, obj))) {
+        slot_idx = gci_slab_slot_index(page, obj);
+        bh_assert(page->is_wo && slot_idx >= 0);
+        bit = (gc_uint32)1 << (slot_idx & 31);
+        if (BH_ATOMIC_32_LOAD(page->mark_bits[slot_idx >> 5]) & bit)
+            return false;
+        return (BH_ATOMIC_32_FETCH_OR(page->mark_bits[slot_idx >> 5], bit)
+                & bit)
+                   ? false
+                   : true;
+    }
+#else
+    (void)heap;
+#endif
+
+    bh_assert(hmu_get_ut(hmu) == HMU_WO);
+    bit = (gc_uint32)1 << HMU_WO_MB_OFFSET;
+    if (BH_ATOMIC_32_LOAD(hmu->header) & bit)
+        return false;
+    return (BH_ATOMIC_32_FETCH_OR(hmu->header, bit) & bit) ? false : true;
+}
+
+/* Let the other workers steal the mark node */
+static void
+share_mark_node(gc_mark_worker_t *worker, mark_node_t *node)
+{
+    os_mutex_lock(&worker->shared_lock);
+    node->next = worker->shared;
+    worker->shared = node;
+    BH_ATOMIC_32_FETCH_ADD(mark_pool.shared_cnt, 1);
+    os_mutex_unlock(&worker->shared_lock);
+
+    if (BH_ATOMIC_32_LOAD(mark_pool.idle_cnt) > 0) {
+        os_mutex_lock(&mark_pool.idle_lock);
+        os_cond_broadcast(&mark_pool.idle_cond);
+        os_mutex_unlock(&mark_pool.idle_lock);
+    }
+}
+
+/* Share part of the mark stack with the idle workers */
+static void
+share_mark_stack(gc_mark_worker_t *worker)
+{
+    mark_node_t *node = worker->stack, *next, *new_node;
+    gc_uint32 half;
+
+    if (!node)
+        return;
+
+    if ((next = node->next) && next->idx > 0) {
+        /* share a full node under the top one */
+        node->next = next->next;
+        share_mark_node(worker, next);
+        return;
+    }
+
+    if (node->idx < 2 || !(new_node = alloc_mark_node()))
+        return;
+
+    /* share the bottom half of the top node, which were pushed earlier
+       and are likely to have more objects to expand */
+    half = node->idx / 2;
+    bh_memcpy_s(new_node->set, (uint32)sizeof(new_node->set), node->set,
+                (uint32)(half * sizeof(gc_object_t)));
+    memmove(node->set, node->set + half,
+            (node->idx - half) * sizeof(gc_object_t));
+    new_node->idx = half;
+    node->idx -= half;
+    share_mark_node(worker, new_node);
+}
+
+static bool
+push_mark_stack(gc_mark_worker_t *worker, gc_object_t obj)
+{
+    mark_node_t *node = worker->stack, *new_node;
+
+    if (!node || node->idx == node->cnt) {
+        if (!(new_node = alloc_mark_node()))
+            return false;
+        if (node
+            && BH_ATOMIC_32_LOAD(mark_pool.shared_cnt)
+                   < WASM_GC_MARK_THREAD_NUM) {
+            /* share the full node rather than keep it */
+            worker->stack = node->next;
+            share_mark_node(worker, node);
+        }
+        new_node->next = worker->stack;
+        worker->stack = new_node;
+        node = new_node;
+    }
+
+    node->set[node->idx++] = obj;
+    return true;
+}
+
+static gc_object_t
+pop_mark_stack(gc_mark_worker_t *worker)
+{
+    mark_node_t *node;
+
+    while ((node = worker->stack)) {
+        if (node->idx > 0)
+            return node->set[--node->idx];
+        if (!node->next)
+            break; /* keep the last node for the later pushes */
+        worker->stack = node->next;
+        free_mark_node(node);
+    }
+
+    return NULL;
+}
+
+/* Steal a shared mark node, the ones shared by the worker itself are
+   taken back at first */
+static bool
+steal_mark_node(gc_mark_worker_t *worker)
+{
+    gc_mark_worker_t *victim;
+    mark_node_t *node = NULL;
+    gc_uint32 self = (gc_uint32)(worker - mark_pool.workers), i;
+
+    for (i = 0; i < WASM_GC_MARK_THREAD_NUM && !node; i++) {
+        victim = &mark_pool.workers[(self + i) % WASM_GC_MARK_THREAD_NUM];
+        os_mutex_lock(&victim->shared_lock);
+        if ((node = victim->shared)) {
+            victim->shared = node->next;
+            BH_ATOMIC_32_FETCH_SUB(mark_pool.shared_cnt, 1);
+        }
+        os_mutex_unlock(&victim->shared_lock);
+    }
+
+    if (!node)
+        return false;
+
+    node->next = worker->stack;
+    worker->stack = node;
+    return true;
+}
+
+/**
+ * Wait until there are shared mark nodes to steal
+ *
+ * @return true if there may be nodes to steal, false if the marking is
+ *         finished or failed
+ */
+static bool
+wait_for_mark_work(void)
+{
+    bool ret;
+
+    os_mutex_lock(&mark_pool.idle_lock);
+    BH_ATOMIC_32_FETCH_ADD(mark_pool.idle_cnt, 1);
+    while (!BH_ATOMIC_32_LOAD(mark_pool.is_failed)
+           && BH_ATOMIC_32_LOAD(mark_pool.shared_cnt) == 0
+           && BH_ATOMIC_32_LOAD(mark_pool.idle_cnt) < WASM_GC_MARK_THREAD_NUM)
+        os_cond_wait(&mark_pool.idle_cond, &mark_pool.idle_lock);
+
+    if (!BH_ATOMIC_32_LOAD(mark_pool.is_failed)
+        && BH_ATOMIC_32_LOAD(mark_pool.shared_cnt) > 0) {
+        BH_ATOMIC_32_FETCH_SUB(mark_pool.idle_cnt, 1);
+        ret = true;
+    }
+    else {
+        /* all workers are idle with nothing shared, wake up the
+           others to finish too */
+        os_cond_broadcast(&mark_pool.idle_cond);
+        ret = false;
+    }
+    os_mutex_unlock(&mark_pool.idle_lock);
+
+    return ret;
+}
+
+/**
+ * The marking of a worker: expand the objects of its own mark stack,
+ * and steal the nodes shared by the others when the stack is empty
+ */
+static void
+mark_objects_parallel(gc_heap_t *heap, gc_mark_worker_t *worker)
+{
+    gc_object_t obj, ref;
+    bool is_compact_mode = false;
+    gc_uint32 ref_num = 0, ref_start_offset = 0, size, offset, j;
+    gc_uint16 *ref_list = NULL;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+#endif
+
+    while (true) {
+        while (!BH_ATOMIC_32_LOAD(mark_pool.is_failed)
+               && (obj = pop_mark_stack(worker))) {
+#if BH_ENABLE_GC_SLAB != 0
+            if ((page = gci_obj_to_slab_page(heap, obj)))
+                size = HMU_SIZE + page->slot_size;
+            else
+#endif
+                size = hmu_get_size(obj_to_hmu(obj));
+
+            if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode,
+                                                 &ref_num, &ref_list,
+                                                 &ref_start_offset)
+                || ref_num >= 2U * GB) {
+                LOG_ERROR("mark process failed because failed "
+                          "vm_get_wasm_object_ref_list");
+                goto fail;
+            }
+
+            for (j = 0; j < ref_num; j++) {
+                offset = is_compact_mode
+                             ? ref_start_offset + j * (gc_uint32)sizeof(void *)
+                             : ref_list[j];
+                bh_assert(offset + sizeof(void *) < size);
+                ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+                if (ref == NULL_REF || ((uintptr_t)ref & 1))
+                    continue; /* null object or i31 object */
+                if (try_mark_wo(heap, ref) && !push_mark_stack(worker, ref)) {
+                    LOG_ERROR("mark process failed");
+                    goto fail;
+                }
+            }
+
+            worker->marked_cnt++;
+            worker->marked_size += size;
+
+            if (BH_ATOMIC_32_LOAD(mark_pool.idle_cnt) > 0
+                && BH_ATOMIC_32_LOAD(mark_pool.shared_cnt) == 0)
+                share_mark_stack(worker);
+        }
+
+        if (BH_ATOMIC_32_LOAD(mark_pool.is_failed))
+            return;
+        if (!steal_mark_node(worker) && !wait_for_mark_work())
+            return;
+    }
+
+fail:
+    BH_ATOMIC_32_STORE(mark_pool.is_failed, 1);
+    os_mutex_lock(&mark_pool.idle_lock);
+    os_cond_broadcast(&mark_pool.idle_cond);
+    os_mutex_unlock(&mark_pool.idle_lock);
+}
+
+/**
+ * Mark the objects reachable from the rootset with all the workers
+ *
+ * @return true if success, false otherwise
+ */
+static bool
+mark_heap_parallel(gc_heap_t *heap)
+{
+    gc_mark_worker_t *worker;
+    mark_node_t *node, *next;
+    gc_uint32 i;
+
+    mark_pool.idle_cnt = 0;
+    mark_pool.shared_cnt = 0;
+    mark_pool.is_failed = 0;
+    for (i = 0; i < WASM_GC_MARK_THREAD_NUM; i++) {
+        mark_pool.workers[i].marked_cnt = 0;
+        mark_pool.workers[i].marked_size = 0;
+    }
+
+    /* share the rootset among the workers */
+    node = (mark_node_t *)heap->root_set;
+    heap->root_set = NULL;
+    for (i = 0; node; node = next, i++) {
+        next = node->next;
+        worker = &mark_pool.workers[i % WASM_GC_MARK_THREAD_NUM];
+        node->next = worker->shared;
+        worker->shared = node;
+        mark_pool.shared_cnt++;
+    }
+
+    post_mark_job(heap, GC_MARK_JOB_MARK);
+
+    for (i = 0; i < WASM_GC_MARK_THREAD_NUM; i++) {
+        worker = &mark_pool.workers[i];
+        /* the nodes are left only if the marking failed */
+        while ((node = worker->stack)) {
+            worker->stack = node->next;
+            free_mark_node(node);
+        }
+        while ((node = worker->shared)) {
+            worker->shared = node->next;
+            free_mark_node(node);
+        }
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+        heap->total_marked_cnt += worker->marked_cnt;
+        heap->total_marked_size += worker->marked_size;
+#endif
+    }
+
+    return mark_pool.is_failed ? false : true;
+}
+#endif /* end of WASM_ENABLE_GC_PARALLEL_MARK != 0 */
+
+/**
+ * Sweep the heap with the current thread
+ *
+ * @return the free size of the heap
+ */
+static gc_size_t
+sweep_heap_serial(gc_heap_t *heap)
+{
+    hmu_t *cur = NULL, *end = NULL, *last = NULL;
+    hmu_type_t ut;
+    gc_size_t size;
+    gc_size_t tot_free = 0;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+#endif
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    /* record the bounds of the ranges to sweep in parallel next time */
+    gc_uint32 bound_idx =
+        heap->current_size >= GC_PARALLEL_MARK_MIN_HEAP_SIZE
+            ? 0
+            : WASM_GC_MARK_THREAD_NUM;
+    gc_size_t bound_offset = 0;
+#endif
+
+    cur = (hmu_t *)heap->base_addr;
+    last = NULL;
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    while (cur < end) {
+        ut = hmu_get_ut(cur);
+        size = hmu_get_size(cur);
+        bh_assert(size > 0);
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+        if (bound_idx < WASM_GC_MARK_THREAD_NUM
+            && (gc_size_t)((gc_uint8 *)cur - heap->base_addr)
+                   >= bound_offset) {
+            /* the free area before the bound isn't merged with the
+               following blocks, so that the bound is still the start
+               of a block in the next sweep */
+            if (last) {
+                tot_free += (gc_size_t)((char *)cur - (char *)last);
+                gci_add_fc(heap, last,
+                           (gc_size_t)((char *)cur - (char *)last));
+                hmu_mark_pinuse(last);
+                last = NULL;
+            }
+            heap->sweep_bounds[bound_idx++] =
+                (gc_uint32)((gc_uint8 *)cur - heap->base_addr);
+            bound_offset =
+                heap->current_size / WASM_GC_MARK_THREAD_NUM * bound_idx;
+        }
+#endif
+
+#if BH_ENABLE_GC_SLAB != 0
+        if (ut == HMU_VO && (page = gci_hmu_to_slab_page(heap, cur))) {
+            if (!sweep_slab_page(heap, page, NULL))
+                /* the slab page is released, merge it as free memory */
+                ut = HMU_FM;
+            else
+                /* the free slots are counted as free memory */
+                tot_free += (gc_size_t)page->free_num * page->slot_size;
+        }
+#endif
+
+        if (ut == HMU_FC || ut == HMU_FM
+            || (ut == HMU_VO && hmu_is_vo_freed(cur))
+            || (ut == HMU_WO && !hmu_is_wo_marked(cur))) {
+            /* merge previous free areas with current one */
+            if (!last)
+                last = cur;
+
+            if (ut == HMU_WO) {
+                /* Invoke registered finalizer */
+                gc_object_t cur_obj = hmu_to_obj(cur);
+                if (gct_vm_get_extra_info_flag(cur_obj)) {
+                    extra_info_node_t *node = gc_search_extra_info_node(
+                        (gc_handle_t)heap, cur_obj, NULL);
+                    bh_assert(node);
+                    node->finalizer(node->obj, node->data);
+                    gc_unset_finalizer((gc_handle_t)heap, cur_obj);
+                }
+            }
+        }
+        else {
+            /* current block is still live */
+            if (last) {
+                tot_free += (gc_size_t)((char *)cur - (char *)last);
+                gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
+                hmu_mark_pinuse(last);
+                last = NULL;
+            }
+
+            if (ut == HMU_WO) {
+#if WASM_ENABLE_GC_NURSERY != 0
+                /* the live objects of a generational heap keep the
+                   mark as old objects */
+                if (!heap->is_generational)
+#endif
+                    /* unmark it */
+                    hmu_unmark_wo(cur);
+            }
+        }
+
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+    bh_assert(cur == end);
+
+    if (last) {
+        tot_free += (gc_size_t)((char *)cur - (char *)last);
+        gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
+        hmu_mark_pinuse(last);
+    }
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    if (heap->current_size >= GC_PARALLEL_MARK_MIN_HEAP_SIZE) {
+        /* the last block covers the remaining bounds, sweep nothing
+           with the remaining workers */
+        while (bound_idx < WASM_GC_MARK_THREAD_NUM)
+            heap->sweep_bounds[bound_idx++] = heap->current_size;
+        heap->is_sweep_bounds_valid = 1;
+    }
+#endif
+
+    return tot_free;
+}
+
 /**
  * Sweep phase of mark_sweep algorithm
  * @param heap the heap to sweep, should be a valid instance heap
  *        which has already been marked
+ * @param is_parallel whether to sweep with the GC workers
+ */
+static void
+sweep_instance_heap(gc_heap_t *heap, bool is_parallel)
+{
+    int i, lsize;
+    gc_size_t tot_free = 0;
+
+    bh_assert(gci_is_heap_valid(heap));
+
+    /* reset KFC */
+    lsize =
+        (int)(sizeof(heap->kfc_normal_list) / sizeof(heap->kfc_normal_list[0]));
+    for (i = 0; i < lsize; i++) {
+        heap->kfc_normal_list[i].next = NULL;
+    }
+    heap->kfc_tree_root->right = NULL;
+    heap->root_set = NULL;
+#if BH_ENABLE_GC_SLAB != 0
+    /* the lists of slab pages with free slots are rebuilt too, and the
+       empty pages kept for reuse are released */
+    memset(heap->slab_partial, 0, sizeof(heap->slab_partial));
+    heap->slab_empty = 0;
+    heap->slab_empty_cnt = 0;
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    if (is_parallel && heap->is_sweep_bounds_valid)
+        tot_free = sweep_heap_parallel(heap);
+    else
+#endif
+        tot_free = sweep_heap_serial(heap);
+
+    heap->total_free_size = tot_free;
+
+#if GC_STAT_DATA != 0
+    heap->total_gc_count++;
+    if ((heap->current_size - tot_free) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - tot_free;
+
+#endif
+    gc_update_threshold(heap);
+
+    (void)is_parallel;
+}
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Sweep the nursery regions only, the unmarked objects in them are
+ * dead and the marked ones become old objects
+ *
+ * @param heap the generational heap to sweep, which has already been
+ *        marked from the roots and the remembered set
+ */
+static void
+sweep_nursery(gc_heap_t *heap)
+{
+    hmu_t *cur = NULL, *end = NULL, *last = NULL;
+    hmu_type_t ut;
+    gc_size_t size;
+    gc_size_t tot_free = 0;
+    gc_uint32 i;
+
+    bh_assert(gci_is_heap_valid(heap));
+
+    heap->root_set = NULL;
+
+    for (i = 0; i < heap->nursery_region_cnt; i++) {
+        cur = (hmu_t *)(heap->base_addr + heap->nursery_regions[i * 2]);
+        end = (hmu_t *)((char *)cur + heap->nursery_regions[i * 2 + 1]);
+        last = NULL;
+
+        while (cur < end) {
+            ut = hmu_get_ut(cur);
+            size = hmu_get_size(cur);
+            bh_assert(size > 0);
+            bh_assert(ut == HMU_WO || ut == HMU_FM);
+
+            if (ut == HMU_FM || !hmu_is_wo_marked(cur)) {
+                /* merge previous free areas with current one */
+                if (!last)
+                    last = cur;
+
+                if (ut == HMU_WO) {
+                    /* Invoke registered finalizer */
+                    gc_object_t cur_obj = hmu_to_obj(cur);
+                    if (gct_vm_get_extra_info_flag(cur_obj)) {
+                        extra_info_node_t *node = gc_search_extra_info_node(
+                            (gc_handle_t)heap, cur_obj, NULL);
+                        bh_assert(node);
+                        node->finalizer(node->obj, node->data);
+                        gc_unset_finalizer((gc_handle_t)heap, cur_obj);
+                    }
+                }
+            }
+            else if (last) {
+                /* current object survives */
+                tot_free += (gc_size_t)((char *)cur - (char *)last);
+                gci_add_fc(heap, last,
+                           (gc_size_t)((char *)cur - (char *)last));
+                hmu_mark_pinuse(last);
+                last = NULL;
+            }
+
+            cur = (hmu_t *)((char *)cur + size);
+        }
+
+        bh_assert(cur == end);
+
+        if (last) {
+            tot_free += (gc_size_t)((char *)cur - (char *)last);
+            gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
+            hmu_mark_pinuse(last);
+        }
+    }
+
+    heap->total_free_size += tot_free;
+
+#if GC_STAT_DATA != 0
+    heap->total_gc_count++;
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
+#endif
+}
+#endif /* end of WASM_ENABLE_GC_NURSERY != 0 */
+
+/**
+ * Add a to-expand node to the to-expand list
+ *
+ * @param heap should be a valid instance heap
+ * @param obj should be a valid wo inside @heap
+ *
+ * @return GC_ERROR if there is no more resource for marking,
+ *         GC_SUCCESS if success
+ */
+static int
+add_wo_to_expand(gc_heap_t *heap, gc_object_t obj)
+{
+    mark_node_t *mark_node = NULL, *new_node = NULL;
+    hmu_t *hmu = NULL;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    int slot_idx = -1;
+#endif
+
+    bh_assert(obj);
+
+    hmu = obj_to_hmu(obj);
+
+    bh_assert(gci_is_heap_valid(heap));
+    bh_assert((gc_uint8 *)hmu >= heap->base_addr
+              && (gc_uint8 *)hmu < heap->base_addr + heap->current_size);
+
+#if BH_ENABLE_GC_SLAB != 0
+    if ((page = gci_obj_to_slab_page(heap, obj))) {
+        slot_idx = gci_slab_slot_index(page, obj);
+        bh_assert(page->is_wo && slot_idx >= 0);
+        if (GC_SLAB_BIT_IS_SET(page->mark_bits, slot_idx))
+            return GC_SUCCESS; /* already marked*/
+    }
+    else
+#endif
+    {
+        bh_assert(hmu_get_ut(hmu) == HMU_WO);
+        if (hmu_is_wo_marked(hmu))
+            return GC_SUCCESS; /* already marked*/
+    }
+
+    mark_node = (mark_node_t *)heap->root_set;
+    if (!mark_node || mark_node->idx == mark_node->cnt) {
+        new_node = alloc_mark_node();
+        if (!new_node) {
+            LOG_ERROR("can not add obj to mark node because of mark node "
+                      "allocation failed");
+            return GC_ERROR;
+        }
+        new_node->next = mark_node;
+        heap->root_set = new_node;
+        mark_node = new_node;
+    }
+
+    mark_node->set[mark_node->idx++] = obj;
+#if BH_ENABLE_GC_SLAB != 0
+    if (page) {
+        GC_SLAB_SET_BIT(page->mark_bits, slot_idx);
+        return GC_SUCCESS;
+    }
+#endif
+    hmu_mark_wo(hmu);
+    return GC_SUCCESS;
+}
+
+/* Check ems_gc.h for description*/
+int
+gc_add_root(void *heap_p, gc_object_t obj)
+{
+    gc_heap_t *heap = (gc_heap_t *)heap_p;
+    hmu_t *hmu = NULL;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    int slot_idx;
+#endif
+
+    if (!obj) {
+        LOG_ERROR("gc_add_root with NULL obj");
+        return GC_ERROR;
+    }
+
+    hmu = obj_to_hmu(obj);
+
+    if (!gci_is_heap_valid(heap)) {
+        LOG_ERROR("vm_get_gc_handle_for_current_instance returns invalid heap");
+        return GC_ERROR;
+    }
+
+    if (!((gc_uint8 *)hmu >= heap->base_addr
+          && (gc_uint8 *)hmu < heap->base_addr + heap->current_size)) {
+        LOG_ERROR("Obj is not a object in current instance heap");
+        return GC_ERROR;
+    }
+
+#if BH_ENABLE_GC_SLAB != 0
+    if ((page = gci_obj_to_slab_page(heap, obj))) {
+        slot_idx = gci_slab_slot_index(page, obj);
+        if (!page->is_wo || slot_idx < 0
+            || !GC_SLAB_BIT_IS_SET(page->alloc_bits, slot_idx)) {
+            LOG_ERROR("Given object is not wo");
+            return GC_ERROR;
+        }
+    }
+    else if (hmu_get_ut(hmu) != HMU_WO) {
+        LOG_ERROR("Given object is not wo");
+        return GC_ERROR;
+    }
+#else
+    if (hmu_get_ut(hmu) != HMU_WO) {
+        LOG_ERROR("Given object is not wo");
+        return GC_ERROR;
+    }
+#endif
+
+    if (add_wo_to_expand(heap, obj) != GC_SUCCESS) {
+        heap->is_fast_marking_failed = 1;
+        return GC_ERROR;
+    }
+
+    return GC_SUCCESS;
+}
+
+/**
+ * Traverse the heap to unmark all marked wos
+ *
+ * @param heap should be a valid instance heap
+ */
+static void
+unmark_all_wo(gc_heap_t *heap)
+{
+    hmu_t *cur = NULL, *end = NULL;
+    hmu_type_t ut;
+    gc_size_t size;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    gc_uint32 i;
+#endif
+
+    cur = (hmu_t *)heap->base_addr;
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+
+    while (cur < end) {
+        ut = hmu_get_ut(cur);
+        size = hmu_get_size(cur);
+
+        if (ut == HMU_WO && hmu_is_wo_marked(cur)) {
+            hmu_unmark_wo(cur);
+        }
+#if BH_ENABLE_GC_SLAB != 0
+        else if (ut == HMU_VO && (page = gci_hmu_to_slab_page(heap, cur))
+                 && page->is_wo) {
+            for (i = 0; i < GC_SLAB_BITMAP_WORDS; i++)
+                page->mark_bits[i] = gci_slab_padding_bits(page, i);
+        }
+#endif
+
+        cur = (hmu_t *)((char *)cur + size);
+    }
+
+    bh_assert(cur == end);
+}
+
+/**
+ * Unmark all marked objects to do rollback
+ *
+ * @param heap the heap to do rollback, should be a valid instance heap
  */
 static void
-sweep_instance_heap(gc_heap_t *heap)
+rollback_mark(gc_heap_t *heap)
 {
-    hmu_t *cur = NULL, *end = NULL, *last = NULL;
-    hmu_type_t ut;
-    gc_size_t size;
-    int i, lsize;
-    gc_size_t tot_free = 0;
+    mark_node_t *mark_node = NULL, *next_mark_node = NULL;
 
     bh_assert(gci_is_heap_valid(heap));
 
-    cur = (hmu_t *)heap->base_addr;
-    last = NULL;
-    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+    /* roll back*/
+    mark_node = (mark_node_t *)heap->root_set;
+    while (mark_node) {
+        next_mark_node = mark_node->next;
+        free_mark_node(mark_node);
+        mark_node = next_mark_node;
+    }
+
+    heap->root_set = NULL;
+
+    /* then traverse the heap to unmark all marked wos*/
+    unmark_all_wo(heap);
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* the old objects are unmarked too, the next collection must
+       trace all objects */
+    if (heap->is_generational)
+        reset_nursery(heap, true);
+#endif
+}
+
+/**
+ * Mark the objects reachable from the rootset with the current thread
+ *
+ * @return true if success, false otherwise
+ */
+static bool
+mark_heap_serial(gc_heap_t *heap)
+{
+    mark_node_t *mark_node = NULL;
+    int idx = 0, j = 0;
+    bool is_compact_mode = false;
+    gc_object_t obj = NULL, ref = NULL;
+    hmu_t *hmu = NULL;
+    gc_uint32 ref_num = 0, ref_start_offset = 0, size = 0, offset = 0;
+    gc_uint16 *ref_list = NULL;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+#endif
+
+    /* the algorithm we use to mark all objects */
+    /* 1. mark rootset and organize them into a mark_node list (last marked
+     * roots at list header, i.e. stack top) */
+    /* 2. in every iteration, we use the top node to expand*/
+    /* 3. execute step 2 till no expanding */
+    /* this is a BFS & DFS mixed algorithm, but more like DFS */
+    mark_node = (mark_node_t *)heap->root_set;
+    while (mark_node) {
+        heap->root_set = mark_node->next;
+
+        /* note that mark_node->idx may change in each loop */
+        for (idx = 0; idx < (int)mark_node->idx; idx++) {
+            obj = mark_node->set[idx];
+            hmu = obj_to_hmu(obj);
+#if BH_ENABLE_GC_SLAB != 0
+            if ((page = gci_obj_to_slab_page(heap, obj)))
+                size = HMU_SIZE + page->slot_size;
+            else
+#endif
+                size = hmu_get_size(hmu);
+
+            if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode,
+                                                 &ref_num, &ref_list,
+                                                 &ref_start_offset)) {
+                LOG_ERROR("mark process failed because failed "
+                          "vm_get_wasm_object_ref_list");
+                break;
+            }
+
+            if (ref_num >= 2U * GB) {
+                LOG_ERROR("Invalid ref_num returned");
+                break;
+            }
+
+            if (is_compact_mode) {
+                for (j = 0; j < (int)ref_num; j++) {
+                    offset = ref_start_offset + j * sizeof(void *);
+                    bh_assert(offset + sizeof(void *) < size);
+                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
+                        continue; /* null object or i31 object */
+                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
+                        LOG_ERROR("add_wo_to_expand failed");
+                        break;
+                    }
+                }
+                if (j < (int)ref_num)
+                    break;
+            }
+            else {
+                for (j = 0; j < (int)ref_num; j++) {
+                    offset = ref_list[j];
+                    bh_assert(offset + sizeof(void *) < size);
+
+                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
+                        continue; /* null object or i31 object */
+                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
+                        LOG_ERROR("mark process failed");
+                        break;
+                    }
+                }
+                if (j < (int)ref_num)
+                    break;
+            }
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+            heap->total_marked_cnt++;
+            heap->total_marked_size += size;
+#endif
+        }
+        if (idx < (int)mark_node->idx)
+            break; /* not yet done */
+
+        /* obj's in mark_node are all expanded */
+        free_mark_node(mark_node);
+        mark_node = heap->root_set;
+    }
+
+    (void)size;
+
+    if (mark_node) {
+        LOG_ERROR("mark process is not successfully finished");
+
+        free_mark_node(mark_node);
+        return false;
+    }
+
+    return true;
+}
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+/* the heaps in the mark phase, the pre-write barrier searches them to
+   find the heap of an object */
+static gc_heap_t *marking_heap_list;
+static korp_mutex marking_heap_list_lock;
+
+int
+gc_init_incremental_list(void)
+{
+    if (os_mutex_init(&marking_heap_list_lock) != BHT_OK) {
+        LOG_ERROR("[GC_ERROR]failed to init lock\n");
+        return GC_ERROR;
+    }
+    return GC_SUCCESS;
+}
+
+void
+gc_destroy_incremental_list(void)
+{
+    os_mutex_destroy(&marking_heap_list_lock);
+}
+
+int
+gc_enable_incremental(gc_handle_t handle)
+{
+#if GC_MANUALLY == 0 && GC_IN_EVERY_ALLOCATION == 0
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* the old objects aren't unmarked by the generational collection */
+    if (heap->is_generational)
+        return GC_ERROR;
+#endif
+
+    gct_vm_mutex_lock(&heap->lock);
+    heap->is_incremental = 1;
+    if (heap->pause_budget == 0)
+        heap->pause_budget = WASM_GC_PAUSE_BUDGET_US;
+    gct_vm_mutex_unlock(&heap->lock);
+    return GC_SUCCESS;
+#else
+    /* the objects are never collected in the allocation path */
+    (void)handle;
+    return GC_ERROR;
+#endif
+}
+
+void
+gc_set_pause_budget(gc_handle_t handle, gc_uint32 budget_us)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    gct_vm_mutex_lock(&heap->lock);
+    heap->pause_budget = budget_us > 0 ? budget_us : WASM_GC_PAUSE_BUDGET_US;
+    gct_vm_mutex_unlock(&heap->lock);
+}
+
+void
+gc_get_pause_stats(gc_handle_t handle, gc_pause_stats_t *stats)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+
+    gct_vm_mutex_lock(&heap->lock);
+    bh_memcpy_s(stats, (uint32)sizeof(gc_pause_stats_t), &heap->pause_stats,
+                (uint32)sizeof(gc_pause_stats_t));
+    gct_vm_mutex_unlock(&heap->lock);
+}
+
+/* Add the pause to the statistics of the heap */
+static void
+record_pause(gc_heap_t *heap, gc_uint64 pause_us)
+{
+    gc_pause_stats_t *stats = &heap->pause_stats;
+    gc_uint32 i = 0;
+
+    while (i < GC_PAUSE_HISTOGRAM_SIZE - 1 && pause_us >= ((gc_uint64)16 << i))
+        i++;
+    stats->histogram[i]++;
+    stats->pause_count++;
+    stats->total_pause_us += pause_us;
+    if (pause_us > stats->max_pause_us)
+        stats->max_pause_us = pause_us;
+}
+
+/* Record a slice of the incremental GC, which isn't run by do_gc_heap */
+static void
+record_slice(gc_heap_t *heap, gc_uint64 pause_us)
+{
+    record_pause(heap, pause_us);
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    heap->total_gc_time += (gc_size_t)pause_us;
+    if (pause_us > heap->max_gc_time)
+        heap->max_gc_time = (gc_size_t)pause_us;
+#endif
+}
+
+static void
+add_marking_heap(gc_heap_t *heap)
+{
+    os_mutex_lock(&marking_heap_list_lock);
+    heap->next_marking = marking_heap_list;
+    marking_heap_list = heap;
+    os_mutex_unlock(&marking_heap_list_lock);
+}
+
+static void
+remove_marking_heap(gc_heap_t *heap)
+{
+    gc_heap_t **p_heap;
+
+    os_mutex_lock(&marking_heap_list_lock);
+    for (p_heap = &marking_heap_list; *p_heap;
+         p_heap = &(*p_heap)->next_marking) {
+        if (*p_heap == heap) {
+            *p_heap = heap->next_marking;
+            break;
+        }
+    }
+    os_mutex_unlock(&marking_heap_list_lock);
+    heap->next_marking = NULL;
+}
+
+void
+gc_pre_write_barrier(gc_object_t *refs, gc_uint32 ref_num)
+{
+    gc_heap_t *heap = NULL;
+    gc_object_t ref;
+    gc_uint32 i;
+
+    if (!marking_heap_list)
+        return;
+
+    for (i = 0; i < ref_num; i++) {
+        ref = refs[i];
+        if (ref == NULL_REF || ((uintptr_t)ref & 1))
+            continue; /* null object or i31 object */
+
+        if (!heap) {
+            os_mutex_lock(&marking_heap_list_lock);
+            heap = marking_heap_list;
+            while (heap
+                   && !((gc_uint8 *)ref >= heap->base_addr
+                        && (gc_uint8 *)ref
+                               < heap->base_addr + heap->current_size))
+                heap = heap->next_marking;
+            os_mutex_unlock(&marking_heap_list_lock);
+
+            if (!heap)
+                /* the heap of the objects isn't in the mark phase */
+                return;
+            gct_vm_mutex_lock(&heap->lock);
+        }
+
+        if (heap->gc_phase != GC_PHASE_MARK)
+            break;
+        if (!((gc_uint8 *)ref >= heap->base_addr
+              && (gc_uint8 *)ref < heap->base_addr + heap->current_size))
+            continue;
+        /* the object reachable at the beginning of the cycle is kept */
+        if (add_wo_to_expand(heap, ref) != GC_SUCCESS) {
+            heap->is_fast_marking_failed = 1;
+            break;
+        }
+    }
+
+    if (heap)
+        gct_vm_mutex_unlock(&heap->lock);
+}
+
+/**
+ * Mark the objects in the mark stack of the heap until it is empty or
+ * the deadline is reached
+ *
+ * @param deadline the time (us) to stop marking, 0 for no limit
+ *
+ * @return true if the mark stack is empty, false otherwise, and
+ *         is_fast_marking_failed is set if the marking fails
+ */
+static bool
+mark_heap_step(gc_heap_t *heap, gc_uint64 deadline)
+{
+    mark_node_t *mark_node;
+    gc_object_t obj, ref;
+    bool is_compact_mode = false;
+    gc_uint32 ref_num = 0, ref_start_offset = 0, offset, j, cnt = 0;
+    gc_uint16 *ref_list = NULL;
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+#endif
+#endif
+
+    /* the objects are popped from the top node one by one, so that the
+       marking can be stopped at any object */
+    while ((mark_node = (mark_node_t *)heap->root_set)) {
+        if (mark_node->idx == 0) {
+            heap->root_set = mark_node->next;
+            free_mark_node(mark_node);
+            continue;
+        }
+
+        if (deadline && ++cnt % GC_INCREMENTAL_CHECK_CNT == 0
+            && os_time_get_boot_us() >= deadline)
+            return false;
+
+        obj = mark_node->set[--mark_node->idx];
+        if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode, &ref_num,
+                                             &ref_list, &ref_start_offset)) {
+            LOG_ERROR("mark process failed because failed "
+                      "vm_get_wasm_object_ref_list");
+            heap->is_fast_marking_failed = 1;
+            return false;
+        }
+
+        for (j = 0; j < ref_num; j++) {
+            offset = is_compact_mode
+                         ? ref_start_offset + j * (gc_uint32)sizeof(void *)
+                         : ref_list[j];
+            ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
+            if (ref == NULL_REF || ((uintptr_t)ref & 1))
+                continue; /* null object or i31 object */
+            if (add_wo_to_expand(heap, ref) == GC_ERROR) {
+                LOG_ERROR("mark process failed");
+                heap->is_fast_marking_failed = 1;
+                return false;
+            }
+        }
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+        heap->total_marked_cnt++;
+#if BH_ENABLE_GC_SLAB != 0
+        if ((page = gci_obj_to_slab_page(heap, obj)))
+            heap->total_marked_size += HMU_SIZE + page->slot_size;
+        else
+#endif
+            heap->total_marked_size += hmu_get_size(obj_to_hmu(obj));
+#endif
+    }
+
+    return true;
+}
+
+/**
+ * Start the lazy sweep of the heap, the free lists are reset and the
+ * free chunks are added back when the sweep reaches them
+ */
+static void
+begin_lazy_sweep(gc_heap_t *heap)
+{
+    int i, lsize;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    gc_uint32 offset;
+#endif
 
-    /* reset KFC */
     lsize =
         (int)(sizeof(heap->kfc_normal_list) / sizeof(heap->kfc_normal_list[0]));
     for (i = 0; i < lsize; i++) {
@@ -86,11 +1816,85 @@ sweep_instance_heap(gc_heap_t *heap)
     }
     heap->kfc_tree_root->right = NULL;
     heap->root_set = NULL;
+#if BH_ENABLE_GC_SLAB != 0
+    /* the empty pages kept for reuse are released by the sweep, count
+       their slots as free memory like those of the other pages */
+    for (offset = heap->slab_empty; offset; offset = page->next_offset) {
+        page = (gc_slab_page_t *)(heap->base_addr + offset);
+        heap->total_free_size += (gc_size_t)page->slot_num * page->slot_size;
+    }
+    memset(heap->slab_partial, 0, sizeof(heap->slab_partial));
+    heap->slab_empty = 0;
+    heap->slab_empty_cnt = 0;
+#endif
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    /* the lazy sweep doesn't record the bounds */
+    heap->is_sweep_bounds_valid = 0;
+#endif
+
+    heap->sweep_offset = 0;
+    heap->gc_phase = GC_PHASE_SWEEP;
+}
+
+/**
+ * Sweep the heap from sweep_offset, the free areas found are added to
+ * the free lists, which already count in total_free_size except the
+ * dead objects. A free area is split by sweep_offset only if the
+ * deadline is reached in it, the part after is added separately by the
+ * next step.
+ *
+ * @param deadline the time (us) to stop sweeping, 0 for no limit
+ * @param size stop after a free chunk of the size is found, 0 for no
+ *        limit
+ *
+ * @return true if the whole heap is swept, false otherwise
+ */
+static bool
+sweep_heap_step(gc_heap_t *heap, gc_uint64 deadline, gc_size_t size)
+{
+    hmu_t *cur = NULL, *end = NULL, *last = NULL;
+    hmu_type_t ut;
+    gc_size_t blk_size, free_size;
+    gc_uint32 cnt = 0;
+    bool is_found = false;
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    gc_uint32 free_num;
+#endif
+
+    cur = (hmu_t *)(heap->base_addr + heap->sweep_offset);
+    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
 
     while (cur < end) {
+        if (is_found
+            || (deadline && ++cnt % GC_INCREMENTAL_CHECK_CNT == 0
+                && os_time_get_boot_us() >= deadline)) {
+            if (last) {
+                gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
+                hmu_mark_pinuse(last);
+            }
+            heap->sweep_offset = (gc_size_t)((gc_uint8 *)cur - heap->base_addr);
+            return false;
+        }
+
         ut = hmu_get_ut(cur);
-        size = hmu_get_size(cur);
-        bh_assert(size > 0);
+        blk_size = hmu_get_size(cur);
+        bh_assert(blk_size > 0);
+
+#if BH_ENABLE_GC_SLAB != 0
+        if (ut == HMU_VO && (page = gci_hmu_to_slab_page(heap, cur))) {
+            free_num = page->free_num;
+            if (!sweep_slab_page(heap, page, NULL)) {
+                /* the released page is free memory as a whole */
+                heap->total_free_size +=
+                    blk_size - (gc_size_t)free_num * page->slot_size;
+                ut = HMU_FM;
+            }
+            else
+                heap->total_free_size +=
+                    (gc_size_t)(page->free_num - free_num) * page->slot_size;
+        }
+#endif
 
         if (ut == HMU_FC || ut == HMU_FM
             || (ut == HMU_VO && hmu_is_vo_freed(cur))
@@ -100,6 +1904,9 @@ sweep_instance_heap(gc_heap_t *heap)
                 last = cur;
 
             if (ut == HMU_WO) {
+                /* the freed vo objects were counted when freed */
+                heap->total_free_size += blk_size;
+
                 /* Invoke registered finalizer */
                 gc_object_t cur_obj = hmu_to_obj(cur);
                 if (gct_vm_get_extra_info_flag(cur_obj)) {
@@ -114,189 +1921,263 @@ sweep_instance_heap(gc_heap_t *heap)
         else {
             /* current block is still live */
             if (last) {
-                tot_free += (gc_size_t)((char *)cur - (char *)last);
-                gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
+                free_size = (gc_size_t)((char *)cur - (char *)last);
+                gci_add_fc(heap, last, free_size);
                 hmu_mark_pinuse(last);
                 last = NULL;
+                if (size > 0 && free_size >= size)
+                    is_found = true;
             }
 
-            if (ut == HMU_WO) {
-                /* unmark it */
+            if (ut == HMU_WO)
                 hmu_unmark_wo(cur);
-            }
         }
 
-        cur = (hmu_t *)((char *)cur + size);
+        cur = (hmu_t *)((char *)cur + blk_size);
     }
 
     bh_assert(cur == end);
 
     if (last) {
-        tot_free += (gc_size_t)((char *)cur - (char *)last);
         gci_add_fc(heap, last, (gc_size_t)((char *)cur - (char *)last));
         hmu_mark_pinuse(last);
     }
 
-    heap->total_free_size = tot_free;
+    heap->sweep_offset = heap->current_size;
+    return true;
+}
 
+/* Finish the collection cycle after the heap is swept */
+static void
+end_collection_cycle(gc_heap_t *heap)
+{
+    heap->gc_phase = GC_PHASE_IDLE;
+    heap->pause_stats.gc_count++;
 #if GC_STAT_DATA != 0
     heap->total_gc_count++;
-    if ((heap->current_size - tot_free) > heap->highmark_size)
-        heap->highmark_size = heap->current_size - tot_free;
-
+    if ((heap->current_size - heap->total_free_size) > heap->highmark_size)
+        heap->highmark_size = heap->current_size - heap->total_free_size;
 #endif
     gc_update_threshold(heap);
 }
 
+/* Give up the marking of the cycle */
+static void
+abort_collection_cycle(gc_heap_t *heap)
+{
+    LOG_ERROR("incremental marking failed, all marked wos will be unmarked");
+
+    remove_marking_heap(heap);
+    rollback_mark(heap);
+    heap->is_fast_marking_failed = 0;
+    heap->gc_phase = GC_PHASE_IDLE;
+}
+
 /**
- * Add a to-expand node to the to-expand list
- *
- * @param heap should be a valid instance heap
- * @param obj should be a valid wo inside @heap
+ * Enumerate the root set and start the mark phase of a cycle
  *
- * @return GC_ERROR if there is no more resource for marking,
- *         GC_SUCCESS if success
+ * @return true if success, false otherwise
  */
-static int
-add_wo_to_expand(gc_heap_t *heap, gc_object_t obj)
+static bool
+begin_collection_cycle(gc_heap_t *heap)
 {
-    mark_node_t *mark_node = NULL, *new_node = NULL;
-    hmu_t *hmu = NULL;
-
-    bh_assert(obj);
-
-    hmu = obj_to_hmu(obj);
-
-    bh_assert(gci_is_heap_valid(heap));
-    bh_assert((gc_uint8 *)hmu >= heap->base_addr
-              && (gc_uint8 *)hmu < heap->base_addr + heap->current_size);
-    bh_assert(hmu_get_ut(hmu) == HMU_WO);
+    bool ret;
 
-    if (hmu_is_wo_marked(hmu))
-        return GC_SUCCESS; /* already marked*/
-
-    mark_node = (mark_node_t *)heap->root_set;
-    if (!mark_node || mark_node->idx == mark_node->cnt) {
-        new_node = alloc_mark_node();
-        if (!new_node) {
-            LOG_ERROR("can not add obj to mark node because of mark node "
-                      "allocation failed");
-            return GC_ERROR;
-        }
-        new_node->next = mark_node;
-        heap->root_set = new_node;
-        mark_node = new_node;
+    heap->root_set = NULL;
+#if WASM_ENABLE_THREAD_MGR == 0
+    if (!heap->exec_env)
+        return false;
+    ret = gct_vm_begin_rootset_enumeration(heap->exec_env, heap);
+#else
+    if (!heap->cluster)
+        return false;
+    ret = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
+#endif
+    if (!ret || heap->is_fast_marking_failed) {
+        LOG_ERROR("enumerate rootset failed");
+        rollback_mark(heap);
+        heap->is_fast_marking_failed = 0;
+        return false;
     }
 
-    mark_node->set[mark_node->idx++] = obj;
-    hmu_mark_wo(hmu);
-    return GC_SUCCESS;
+    heap->gc_phase = GC_PHASE_MARK;
+    add_marking_heap(heap);
+    return true;
 }
 
-/* Check ems_gc.h for description*/
-int
-gc_add_root(void *heap_p, gc_object_t obj)
+void
+gci_incremental_step(gc_heap_t *heap)
 {
-    gc_heap_t *heap = (gc_heap_t *)heap_p;
-    hmu_t *hmu = NULL;
+    gc_uint64 start = os_time_get_boot_us();
+    gc_uint64 deadline = start + heap->pause_budget;
+    bool is_marked;
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    gc_uint64 time_marked = start;
+#endif
 
-    if (!obj) {
-        LOG_ERROR("gc_add_root with NULL obj");
-        return GC_ERROR;
-    }
+    bh_assert(heap->is_incremental && !heap->is_doing_reclaim);
 
-    hmu = obj_to_hmu(obj);
+    heap->step_alloc_size = 0;
+    heap->is_doing_reclaim = 1;
 
-    if (!gci_is_heap_valid(heap)) {
-        LOG_ERROR("vm_get_gc_handle_for_current_instance returns invalid heap");
-        return GC_ERROR;
-    }
+    if (heap->gc_phase == GC_PHASE_IDLE && !begin_collection_cycle(heap))
+        goto finish;
 
-    if (!((gc_uint8 *)hmu >= heap->base_addr
-          && (gc_uint8 *)hmu < heap->base_addr + heap->current_size)) {
-        LOG_ERROR("Obj is not a object in current instance heap");
-        return GC_ERROR;
-    }
+    if (heap->gc_phase == GC_PHASE_MARK) {
+        /* the pre-write barrier may have failed to push an object */
+        is_marked =
+            !heap->is_fast_marking_failed && mark_heap_step(heap, deadline);
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+        time_marked = os_time_get_boot_us();
+        heap->total_mark_time += time_marked - start;
+#endif
+        if (heap->is_fast_marking_failed) {
+            abort_collection_cycle(heap);
+            goto finish;
+        }
+        if (!is_marked)
+            goto finish;
 
-    if (hmu_get_ut(hmu) != HMU_WO) {
-        LOG_ERROR("Given object is not wo");
-        return GC_ERROR;
+        /* all the objects reachable are marked */
+        remove_marking_heap(heap);
+        begin_lazy_sweep(heap);
     }
 
-    if (add_wo_to_expand(heap, obj) != GC_SUCCESS) {
-        heap->is_fast_marking_failed = 1;
-        return GC_ERROR;
-    }
+    if (sweep_heap_step(heap, deadline, 0))
+        end_collection_cycle(heap);
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    heap->total_sweep_time += os_time_get_boot_us() - time_marked;
+#endif
 
-    return GC_SUCCESS;
+finish:
+    heap->is_doing_reclaim = 0;
+    record_slice(heap, os_time_get_boot_us() - start);
 }
 
-/**
- * Unmark all marked objects to do rollback
- *
- * @param heap the heap to do rollback, should be a valid instance heap
- */
-static void
-rollback_mark(gc_heap_t *heap)
+bool
+gci_incremental_sweep(gc_heap_t *heap, gc_size_t size)
 {
-    mark_node_t *mark_node = NULL, *next_mark_node = NULL;
-    hmu_t *cur = NULL, *end = NULL;
-    hmu_type_t ut;
-    gc_size_t size;
+    gc_uint64 start;
 
-    bh_assert(gci_is_heap_valid(heap));
+    if (heap->gc_phase != GC_PHASE_SWEEP)
+        return false;
 
-    /* roll back*/
-    mark_node = (mark_node_t *)heap->root_set;
-    while (mark_node) {
-        next_mark_node = mark_node->next;
-        free_mark_node(mark_node);
-        mark_node = next_mark_node;
-    }
+    start = os_time_get_boot_us();
+    heap->is_doing_reclaim = 1;
+    if (sweep_heap_step(heap, 0, size))
+        end_collection_cycle(heap);
+    heap->is_doing_reclaim = 0;
+    record_slice(heap, os_time_get_boot_us() - start);
+    return true;
+}
 
-    heap->root_set = NULL;
+bool
+gc_incremental_step(gc_handle_t handle)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    bool ret;
 
-    /* then traverse the heap to unmark all marked wos*/
+    gct_vm_mutex_lock(&heap->lock);
+    if (heap->is_incremental && heap->is_reclaim_enabled
+        && (heap->gc_phase != GC_PHASE_IDLE
+            || heap->total_free_size / GC_INCREMENTAL_START_FACTOR
+                   < heap->gc_threshold))
+        gci_incremental_step(heap);
+    ret = heap->gc_phase != GC_PHASE_IDLE;
+    gct_vm_mutex_unlock(&heap->lock);
+    return ret;
+}
 
-    cur = (hmu_t *)heap->base_addr;
-    end = (hmu_t *)((char *)heap->base_addr + heap->current_size);
+void
+gci_incremental_migrate(gc_heap_t *heap, intptr_t offset)
+{
+    mark_node_t *mark_node = (mark_node_t *)heap->root_set;
+    uint32 i;
 
-    while (cur < end) {
-        ut = hmu_get_ut(cur);
-        size = hmu_get_size(cur);
+    for (; mark_node; mark_node = mark_node->next) {
+        for (i = 0; i < mark_node->idx; i++)
+            mark_node->set[i] =
+                (gc_object_t)((intptr_t)mark_node->set[i] + offset);
+    }
+}
 
-        if (ut == HMU_WO && hmu_is_wo_marked(cur)) {
-            hmu_unmark_wo(cur);
+void
+gci_destroy_incremental(gc_heap_t *heap)
+{
+    mark_node_t *mark_node, *next_mark_node;
+
+    if (heap->gc_phase == GC_PHASE_MARK) {
+        remove_marking_heap(heap);
+        for (mark_node = (mark_node_t *)heap->root_set; mark_node;
+             mark_node = next_mark_node) {
+            next_mark_node = mark_node->next;
+            free_mark_node(mark_node);
         }
-
-        cur = (hmu_t *)((char *)cur + size);
+        heap->root_set = NULL;
     }
+    heap->gc_phase = GC_PHASE_IDLE;
+}
 
-    bh_assert(cur == end);
+/**
+ * Finish the collection cycle of the heap in one pause
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+finish_collection_cycle(gc_heap_t *heap)
+{
+    if (heap->gc_phase == GC_PHASE_MARK) {
+        remove_marking_heap(heap);
+        if (heap->is_fast_marking_failed || !mark_heap_serial(heap)) {
+            rollback_mark(heap);
+            heap->is_fast_marking_failed = 0;
+            heap->gc_phase = GC_PHASE_IDLE;
+            return GC_ERROR;
+        }
+        sweep_instance_heap(heap, false);
+        heap->gc_phase = GC_PHASE_IDLE;
+    }
+    else if (heap->gc_phase == GC_PHASE_SWEEP) {
+        sweep_heap_step(heap, 0, 0);
+        end_collection_cycle(heap);
+    }
+    return GC_SUCCESS;
 }
+#endif /* end of WASM_ENABLE_GC_INCREMENTAL != 0 */
 
 /**
  * Reclaim GC instance heap
  *
  * @param heap the heap to reclaim, should be a valid instance heap
+ * @param is_minor whether to collect the nursery of a generational
+ *        heap only
  *
  * @return GC_SUCCESS if success, GC_ERROR otherwise
  */
 static int
-reclaim_instance_heap(gc_heap_t *heap)
+reclaim_instance_heap(gc_heap_t *heap, bool is_minor)
 {
+#if BH_ENABLE_GC_VERIFY != 0
     mark_node_t *mark_node = NULL;
-    int idx = 0, j = 0;
-    bool ret, is_compact_mode = false;
-    gc_object_t obj = NULL, ref = NULL;
+    gc_object_t obj = NULL;
     hmu_t *hmu = NULL;
-    gc_uint32 ref_num = 0, ref_start_offset = 0, size = 0, offset = 0;
-    gc_uint16 *ref_list = NULL;
+#endif
+#if BH_ENABLE_GC_VERIFY != 0 || WASM_ENABLE_GC_NURSERY != 0
+    int idx = 0;
+#endif
+    bool ret, is_parallel = false;
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    uint64 time_start, time_marked;
+#endif
 
     bh_assert(gci_is_heap_valid(heap));
 
     heap->root_set = NULL;
 
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    time_start = os_time_get_boot_us();
+#endif
+
 #if WASM_ENABLE_THREAD_MGR == 0
     if (!heap->exec_env)
         return GC_SUCCESS;
@@ -306,8 +2187,25 @@ reclaim_instance_heap(gc_heap_t *heap)
         return GC_SUCCESS;
     ret = gct_vm_begin_rootset_enumeration(heap->cluster, heap);
 #endif
-    if (!ret)
+    if (!ret) {
+#if WASM_ENABLE_GC_NURSERY != 0
+        /* the partly marked young objects mustn't become old */
+        if (heap->is_generational)
+            rollback_mark(heap);
+#endif
         return GC_ERROR;
+    }
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* the old objects which may refer to young objects are roots
+       of a minor collection */
+    for (idx = 0; is_minor && idx < (int)heap->remset_cnt; idx++) {
+        if (add_wo_to_expand(heap, heap->remset[idx]) != GC_SUCCESS) {
+            heap->is_fast_marking_failed = 1;
+            break;
+        }
+    }
+#endif
 
 #if BH_ENABLE_GC_VERIFY != 0
     /* no matter whether the enumeration is successful or not, the data
@@ -345,92 +2243,88 @@ reclaim_instance_heap(gc_heap_t *heap)
         return GC_ERROR;
     }
 
-    /* the algorithm we use to mark all objects */
-    /* 1. mark rootset and organize them into a mark_node list (last marked
-     * roots at list header, i.e. stack top) */
-    /* 2. in every iteration, we use the top node to expand*/
-    /* 3. execute step 2 till no expanding */
-    /* this is a BFS & DFS mixed algorithm, but more like DFS */
-    mark_node = (mark_node_t *)heap->root_set;
-    while (mark_node) {
-        heap->root_set = mark_node->next;
-
-        /* note that mark_node->idx may change in each loop */
-        for (idx = 0; idx < (int)mark_node->idx; idx++) {
-            obj = mark_node->set[idx];
-            hmu = obj_to_hmu(obj);
-            size = hmu_get_size(hmu);
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    /* a large heap is marked and swept with the GC workers unless
+       they are collecting another heap */
+    is_parallel = acquire_mark_workers(heap);
+    if (is_parallel)
+        ret = mark_heap_parallel(heap);
+    else
+#endif
+        ret = mark_heap_serial(heap);
 
-            if (!gct_vm_get_wasm_object_ref_list(obj, &is_compact_mode,
-                                                 &ref_num, &ref_list,
-                                                 &ref_start_offset)) {
-                LOG_ERROR("mark process failed because failed "
-                          "vm_get_wasm_object_ref_list");
-                break;
-            }
+    if (!ret) {
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+        if (is_parallel)
+            release_mark_workers();
+#endif
+        /* roll back is required */
+        rollback_mark(heap);
+        return GC_ERROR;
+    }
 
-            if (ref_num >= 2U * GB) {
-                LOG_ERROR("Invalid ref_num returned");
-                break;
-            }
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    time_marked = os_time_get_boot_us();
+    heap->total_mark_time += time_marked - time_start;
+    if (is_parallel)
+        heap->parallel_gc_count++;
+#endif
 
-            if (is_compact_mode) {
-                for (j = 0; j < (int)ref_num; j++) {
-                    offset = ref_start_offset + j * sizeof(void *);
-                    bh_assert(offset + sizeof(void *) < size);
-                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
-                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
-                        continue; /* null object or i31 object */
-                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
-                        LOG_ERROR("add_wo_to_expand failed");
-                        break;
-                    }
-                }
-                if (j < (int)ref_num)
-                    break;
-            }
-            else {
-                for (j = 0; j < (int)ref_num; j++) {
-                    offset = ref_list[j];
-                    bh_assert(offset + sizeof(void *) < size);
+    /* now sweep */
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (is_minor)
+        sweep_nursery(heap);
+    else
+#endif
+        sweep_instance_heap(heap, is_parallel);
 
-                    ref = *(gc_object_t *)(((gc_uint8 *)obj) + offset);
-                    if (ref == NULL_REF || ((uintptr_t)ref & 1))
-                        continue; /* null object or i31 object */
-                    if (add_wo_to_expand(heap, ref) == GC_ERROR) {
-                        LOG_ERROR("mark process failed");
-                        break;
-                    }
-                }
-                if (j < (int)ref_num)
-                    break;
-            }
-        }
-        if (idx < (int)mark_node->idx)
-            break; /* not yet done */
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    if (is_parallel)
+        release_mark_workers();
+#endif
 
-        /* obj's in mark_node are all expanded */
-        free_mark_node(mark_node);
-        mark_node = heap->root_set;
-    }
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    heap->total_sweep_time += os_time_get_boot_us() - time_marked;
+#endif
 
-    if (mark_node) {
-        LOG_ERROR("mark process is not successfully finished");
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (heap->is_generational)
+        reset_nursery(heap, false);
+#endif
 
-        free_mark_node(mark_node);
-        /* roll back is required */
-        rollback_mark(heap);
+    (void)is_minor;
 
-        return GC_ERROR;
-    }
+    return GC_SUCCESS;
+}
 
-    /* now sweep */
-    sweep_instance_heap(heap);
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Reclaim a generational heap, do a minor collection at first and
+ * a major collection if the old objects take too much memory
+ *
+ * @param heap the heap to reclaim, should be a generational heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+static int
+reclaim_generational_heap(gc_heap_t *heap)
+{
+    int ret;
 
-    (void)size;
+    if (!heap->is_major_gc_required) {
+        heap->minor_gc_count++;
+        ret = reclaim_instance_heap(heap, true);
+        if (ret != GC_SUCCESS || heap->total_free_size >= heap->gc_threshold)
+            return ret;
+    }
 
-    return GC_SUCCESS;
+    /* trace all objects again */
+    unmark_all_wo(heap);
+    heap->major_gc_count++;
+    ret = reclaim_instance_heap(heap, false);
+    return ret;
 }
+#endif
 
 /**
  * Do GC on given heap
@@ -444,6 +2338,9 @@ gci_gc_heap(void *h)
 {
     int ret = GC_ERROR;
     gc_heap_t *heap = (gc_heap_t *)h;
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    gc_uint64 start = os_time_get_boot_us();
+#endif
 
     bh_assert(gci_is_heap_valid(heap));
 
@@ -456,7 +2353,27 @@ gci_gc_heap(void *h)
     gct_vm_mutex_lock(&heap->lock);
     heap->is_doing_reclaim = 1;
 
-    ret = reclaim_instance_heap(heap);
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    /* the heap being swept lazily is swept up at first */
+    if (heap->gc_phase == GC_PHASE_SWEEP)
+        finish_collection_cycle(heap);
+    if (heap->gc_phase == GC_PHASE_MARK)
+        /* the heap is collected by finishing the marking of the cycle */
+        ret = finish_collection_cycle(heap);
+    else
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+    if (heap->is_generational)
+        ret = reclaim_generational_heap(heap);
+    else
+#endif
+        ret = reclaim_instance_heap(heap, false);
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    if (ret == GC_SUCCESS)
+        heap->pause_stats.gc_count++;
+    record_pause(heap, os_time_get_boot_us() - start);
+#endif
 
     heap->is_doing_reclaim = 0;
     gct_vm_mutex_unlock(&heap->lock);
@@ -480,8 +2397,20 @@ gci_gc_heap(void *h)
 }
 
 int
-gc_is_dead_object(void *obj)
+gc_is_dead_object(void *vheap, void *obj)
 {
+#if BH_ENABLE_GC_SLAB != 0
+    gc_slab_page_t *page;
+    int slot_idx;
+
+    if ((page = gci_obj_to_slab_page((gc_heap_t *)vheap, obj))) {
+        slot_idx = gci_slab_slot_index(page, obj);
+        bh_assert(slot_idx >= 0);
+        return !GC_SLAB_BIT_IS_SET(page->mark_bits, slot_idx);
+    }
+#else
+    (void)vheap;
+#endif
     return !hmu_is_wo_marked(obj_to_hmu(obj));
 }
 
@@ -100,6 +100,19 @@ typedef struct extra_info_node {
 gc_handle_t
 gc_init_with_pool(char *buf, gc_size_t buf_size);
 
+/**
+ * GC initialization from a buffer like gc_init_with_pool, for the heap
+ * of the GC objects of wasm apps, which serves the small objects from
+ * slab pages if BH_ENABLE_GC_SLAB is enabled
+ *
+ * @param buf the buffer to be initialized to a heap
+ * @param buf_size the size of buffer
+ *
+ * @return gc handle if success, NULL otherwise
+ */
+gc_handle_t
+gc_init_gc_heap_with_pool(char *buf, gc_size_t buf_size);
+
 /**
  * GC initialization from heap struct buffer and pool buffer
  *
@@ -145,6 +158,148 @@ gc_enable_gc_reclaim(gc_handle_t handle, void *exec_env);
 void
 gc_enable_gc_reclaim(gc_handle_t handle, void *cluster);
 #endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Initialize the list of the heaps with nursery, which is searched by
+ * the write barrier
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+int
+gc_init_nursery_list(void);
+
+/**
+ * Destroy the list of the heaps with nursery
+ */
+void
+gc_destroy_nursery_list(void);
+
+/**
+ * Enable the nursery of a heap, the wo objects are then allocated in
+ * the nursery and collected by generations, which requires the stores
+ * of references into the objects to be tracked by gc_write_barrier.
+ * It should be called before any wo object is allocated.
+ *
+ * @param handle handle of the heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if the heap can't have a
+ *         nursery, e.g. it is too small
+ */
+int
+gc_enable_nursery(gc_handle_t handle);
+
+/**
+ * Write barrier, called after a reference is stored into a wo object
+ *
+ * @param obj the wo object stored into
+ * @param ref the reference stored, may be null or an i31 reference
+ */
+void
+gc_write_barrier(gc_object_t obj, gc_object_t ref);
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+/**
+ * Create the pool of GC worker threads which mark and sweep the large
+ * heaps in parallel with the thread doing the collection
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+int
+gc_init_mark_workers(void);
+
+/**
+ * Stop the GC worker threads and destroy the pool
+ */
+void
+gc_destroy_mark_workers(void);
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+#define GC_PAUSE_HISTOGRAM_SIZE 16
+
+/* The pauses of the incremental collection of a heap, the bucket 0 of
+   the histogram counts the pauses shorter than 16 us, the bucket i
+   counts the pauses in [16 << (i - 1), 16 << i) us, and the last bucket
+   counts all the longer pauses */
+typedef struct gc_pause_stats {
+    gc_uint64 pause_count;
+    gc_uint64 gc_count;
+    gc_uint64 total_pause_us;
+    gc_uint64 max_pause_us;
+    gc_uint64 histogram[GC_PAUSE_HISTOGRAM_SIZE];
+} gc_pause_stats_t;
+
+/**
+ * Initialize the list of the heaps in the mark phase, which is searched
+ * by the pre-write barrier
+ *
+ * @return GC_SUCCESS if success, GC_ERROR otherwise
+ */
+int
+gc_init_incremental_list(void);
+
+/**
+ * Destroy the list of the heaps in the mark phase
+ */
+void
+gc_destroy_incremental_list(void);
+
+/**
+ * Enable the incremental collection of a heap, the heap is then marked
+ * and swept in slices run at the allocations of the wo objects, which
+ * requires the references overwritten in the wo objects to be recorded
+ * by gc_pre_write_barrier.
+ *
+ * @param handle handle of the heap
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if the heap can't be collected
+ *         incrementally, e.g. it has a nursery
+ */
+int
+gc_enable_incremental(gc_handle_t handle);
+
+/**
+ * Set the maximum time of a slice of the incremental collection
+ *
+ * @param handle handle of the heap
+ * @param budget_us the time in microseconds, 0 to use the default one
+ */
+void
+gc_set_pause_budget(gc_handle_t handle, gc_uint32 budget_us);
+
+/**
+ * Get the pause statistics of a heap
+ *
+ * @param handle handle of the heap
+ * @param stats [out] the statistics
+ */
+void
+gc_get_pause_stats(gc_handle_t handle, gc_pause_stats_t *stats);
+
+/**
+ * Run a slice of the incremental collection of a heap, a new collection
+ * cycle is started if the heap is running low on memory
+ *
+ * @param handle handle of the heap
+ *
+ * @return true if a collection cycle is still in progress, false otherwise
+ */
+bool
+gc_incremental_step(gc_handle_t handle);
+
+/**
+ * Pre-write barrier, called before the references stored in a wo object
+ * are overwritten
+ *
+ * @param refs the references to be overwritten, may be null or i31
+ *        references, and all the objects should be in the same heap
+ * @param ref_num the number of the references
+ */
+void
+gc_pre_write_barrier(gc_object_t *refs, gc_uint32 ref_num);
+#endif
 #endif
 
 /**
@@ -165,6 +320,37 @@ gc_get_heap_struct_size(void);
 int
 gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size);
 
+/**
+ * Save the heap structure, so that the heap can be restored to the
+ * current state with gc_restore_heap_struct, together with the content
+ * of its pool saved by the caller
+ *
+ * @param handle handle of the heap
+ * @param image the buffer to save the heap structure, whose size is
+ *        gc_get_heap_struct_size()
+ *
+ * @return GC_SUCCESS if success, GC_ERROR if the heap is collected or
+ *         corrupted
+ */
+int
+gc_save_heap_struct(gc_handle_t handle, char *image);
+
+/**
+ * Restore the heap saved by gc_save_heap_struct into the struct buffer
+ * it was saved from, which has been destroyed. The content of the pool
+ * must have been restored, and the pool may have been moved.
+ *
+ * @param struct_buf the struct buffer of the heap saved
+ * @param image the heap structure saved
+ * @param pool_buf the pool buffer restored
+ * @param pool_buf_size the size of the pool buffer
+ *
+ * @return gc handle if success, NULL otherwise
+ */
+gc_handle_t
+gc_restore_heap_struct(char *struct_buf, const char *image, char *pool_buf,
+                       gc_size_t pool_buf_size);
+
 /**
  * Check whether the heap is corrupted
  *
@@ -196,6 +382,38 @@ gc_realloc_vo(void *heap, void *ptr, gc_size_t size);
 int
 gc_free_vo(void *heap, gc_object_t obj);
 
+/**
+ * Allocate up to count vo objects of the same size while taking the
+ * heap lock only once
+ *
+ * @param heap the heap to allocate from
+ * @param size the size of each object
+ * @param objs buffer to receive the allocated objects
+ * @param count the number of objects requested
+ *
+ * @return the number of objects actually allocated
+ */
+int
+gc_alloc_vo_batch(void *heap, gc_size_t size, gc_object_t *objs, int count);
+
+/**
+ * Free count vo objects while taking the heap lock only once
+ *
+ * @return GC_SUCCESS if all the objects were freed, GC_ERROR otherwise
+ */
+int
+gc_free_vo_batch(void *heap, gc_object_t *objs, int count);
+
+/**
+ * Get the usable size of a vo object, which may be larger than the
+ * size requested when it was allocated
+ *
+ * @return the usable size, or 0 if obj isn't an allocated vo object
+ *         of the heap
+ */
+gc_size_t
+gc_get_vo_size(void *heap, gc_object_t obj);
+
 #if WASM_ENABLE_GC != 0
 gc_object_t
 gc_alloc_wo(void *heap, gc_size_t size);
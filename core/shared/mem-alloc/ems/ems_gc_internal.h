@@ -11,6 +11,7 @@ extern "C" {
 #endif
 
 #include "bh_platform.h"
+#include "bh_atomic.h"
 #include "ems_gc.h"
 
 /* HMU (heap memory unit) basic block type */
@@ -156,6 +157,7 @@ hmu_verify(void *vheap, hmu_t *hmu);
 
 #define hmu_is_vo_freed(hmu) GETBIT((hmu)->header, HMU_VO_FB_OFFSET)
 #define hmu_unfree_vo(hmu) CLRBIT((hmu)->header, HMU_VO_FB_OFFSET)
+#define hmu_free_vo(hmu) SETBIT((hmu)->header, HMU_VO_FB_OFFSET)
 
 #define hmu_get_size(hmu) \
     (GETBITS((hmu)->header, HMU_SIZE_OFFSET, HMU_SIZE_SIZE) << 3)
@@ -226,11 +228,17 @@ __pragma(pack(push, 1));
 #define __attr_aligned(a)
 #endif
 
+/**
+ * The tree only holds one node of each size, the other free chunks of the
+ * size are linked in a list by next_same from the node, and their parent
+ * is the previous chunk of the list, their left and right are NULL.
+ */
 typedef struct hmu_tree_node {
     hmu_t hmu_header;
     struct hmu_tree_node *left;
     struct hmu_tree_node *right;
     struct hmu_tree_node *parent;
+    struct hmu_tree_node *next_same;
     gc_size_t size;
 } __attr_packed __attr_aligned(4) hmu_tree_node_t;
 
@@ -240,7 +248,7 @@ __pragma(pack(pop));
 #endif
 #endif
 
-bh_static_assert(sizeof(hmu_tree_node_t) == 8 + 3 * sizeof(void *));
+bh_static_assert(sizeof(hmu_tree_node_t) == 8 + 4 * sizeof(void *));
 bh_static_assert(offsetof(hmu_tree_node_t, left) == 4);
 
 #define ASSERT_TREE_NODE_ALIGNED_ACCESS(tree_node)                          \
@@ -249,6 +257,130 @@ bh_static_assert(offsetof(hmu_tree_node_t, left) == 4);
                   == 0);                                                    \
     } while (0)
 
+/**
+ * Slab pages for small objects
+ *
+ * A slab page is a VO hmu of GC_SLAB_PAGE_SIZE bytes whose offset from
+ * the heap base address is a multiple of GC_SLAB_PAGE_SIZE, it holds a
+ * gc_slab_page_t header followed by the slots of one size class, which
+ * have no hmu header. The heap keeps one byte for each page-sized range
+ * of the heap in slab_map to tell whether the range is a slab page.
+ */
+
+/* The heap verification requires the prefix and suffix of each object,
+   and the GC in every allocation mode requires all objects to be
+   allocated through alloc_hmu_ex */
+#if BH_ENABLE_GC_VERIFY != 0 || GC_IN_EVERY_ALLOCATION != 0
+#undef BH_ENABLE_GC_SLAB
+#define BH_ENABLE_GC_SLAB 0
+#endif
+
+#if BH_ENABLE_GC_SLAB != 0
+
+#define GC_SLAB_PAGE_SIZE 4096
+/* The slot sizes of the classes are 8, 16, ..., 64 */
+#define GC_SLAB_CLASS_NUM 8
+#define GC_SLAB_MAX_OBJ_SIZE (GC_SLAB_CLASS_NUM << 3)
+#define GC_SLAB_BITMAP_WORDS 16
+/* Smaller heaps don't use slab pages */
+#define GC_SLAB_MIN_HEAP_SIZE (16 * GC_SLAB_PAGE_SIZE)
+/* The empty slab pages kept for reuse take at most 1/64 of the heap */
+#define GC_SLAB_EMPTY_PAGE_MAX(heap) \
+    ((heap)->current_size / 64 / GC_SLAB_PAGE_SIZE)
+
+typedef struct gc_slab_page {
+    /* Offsets of the previous and next slab pages with free slots of the
+       same kind and class from the heap base address, 0 if none */
+    gc_uint32 prev_offset;
+    gc_uint32 next_offset;
+    gc_uint16 slot_size;
+    gc_uint16 slot_num;
+    gc_uint16 free_num;
+    gc_uint8 class_idx;
+    gc_uint8 is_wo;
+    /* Bits of the slots which are allocated, the bits beyond slot_num
+       are always set */
+    gc_uint32 alloc_bits[GC_SLAB_BITMAP_WORDS];
+    /* Bits of the wo objects which are marked, the bits beyond slot_num
+       are always set */
+    gc_uint32 mark_bits[GC_SLAB_BITMAP_WORDS];
+} gc_slab_page_t;
+
+bh_static_assert((sizeof(gc_slab_page_t) & 7) == 0);
+bh_static_assert(GC_SLAB_BITMAP_WORDS * 32
+                 >= (GC_SLAB_PAGE_SIZE - HMU_SIZE - sizeof(gc_slab_page_t))
+                        / 8);
+
+#define GC_SLAB_PAGE_SLOTS(page) \
+    ((gc_uint8 *)(page) + sizeof(gc_slab_page_t))
+
+#endif /* end of BH_ENABLE_GC_SLAB != 0 */
+
+/**
+ * Nursery of the GC heap
+ *
+ * The wo objects are allocated by bumping a pointer in the nursery
+ * regions, which are carved from the free chunks of the heap. A wo
+ * object is kept marked after it survives a collection, so the marked
+ * objects are old and the unmarked ones are young. A minor collection
+ * marks from the root set and the remembered set without tracing the
+ * old objects, and only sweeps the nursery regions. A major collection
+ * unmarks the whole heap before marking and sweeping it.
+ *
+ * An old object never refers to a young object unless it is in the
+ * remembered set: the write barrier unmarks the old object which is
+ * made to refer to a young one and adds it to the set. The objects
+ * allocated outside the nursery are added to the set too.
+ */
+#if WASM_ENABLE_GC_NURSERY != 0
+#define GC_NURSERY_REGION_SIZE (8 * 1024)
+/* Larger objects are allocated outside the nursery */
+#define GC_NURSERY_MAX_OBJ_SIZE (GC_NURSERY_REGION_SIZE / 4)
+/* The nursery takes 1/4 of the heap and at most 1024 regions, the heap
+   which can't hold two regions in it has no nursery */
+#define GC_NURSERY_REGION_MAX 1024
+/* The remembered set is grown up to GC_REMSET_MAX_SIZE objects, after
+   that the next collection will be a major one */
+#define GC_REMSET_INIT_SIZE 256
+#define GC_REMSET_MAX_SIZE (64 * 1024)
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+#if BH_ATOMIC_32_IS_ATOMIC == 0
+#error "GC parallel marking requires 32-bit atomic operations"
+#endif
+/* The smaller heaps are marked and swept by the thread doing the
+   collection only */
+#define GC_PARALLEL_MARK_MIN_HEAP_SIZE (4 * 1024 * 1024)
+#endif
+
+/**
+ * Incremental collection of the GC heap
+ *
+ * A collection cycle enumerates the root set at its beginning, then the
+ * objects are marked in slices with the mark stack of the heap kept
+ * between them. The reference overwritten in a wo object is marked by
+ * the pre-write barrier, and the objects allocated in the mark phase are
+ * marked, so all the objects reachable at the beginning of the cycle are
+ * marked at the end of it. The heap is then swept lazily from the lowest
+ * address: the free lists are reset and only hold the free chunks below
+ * sweep_offset, and the blocks freed above it are just marked as freed
+ * until the sweep reaches them.
+ */
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+#define GC_PHASE_IDLE 0
+#define GC_PHASE_MARK 1
+#define GC_PHASE_SWEEP 2
+/* A cycle is started when the free memory falls below this times the
+   GC threshold */
+#define GC_INCREMENTAL_START_FACTOR 2
+/* A slice is run every time this size of wo objects is allocated */
+#define GC_INCREMENTAL_STEP_SIZE (64 * 1024)
+/* The time is checked every this number of objects marked or live
+   blocks swept */
+#define GC_INCREMENTAL_CHECK_CNT 64
+#endif
+
 typedef struct gc_heap_struct {
     /* for double checking*/
     gc_handle_t heap_id;
@@ -296,6 +428,27 @@ typedef struct gc_heap_struct {
 
     /* Whether the heap can do reclaim */
     unsigned is_reclaim_enabled : 1;
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* Whether the heap has a nursery */
+    unsigned is_generational : 1;
+
+    /* Whether the next collection must be a major one */
+    unsigned is_major_gc_required : 1;
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    /* Whether sweep_bounds can be used to split the heap */
+    unsigned is_sweep_bounds_valid : 1;
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    /* Whether the heap is collected incrementally */
+    unsigned is_incremental : 1;
+
+    /* Phase of the current collection cycle, GC_PHASE_XXX */
+    unsigned gc_phase : 2;
+#endif
 #endif
 
 #if BH_ENABLE_GC_CORRUPTION_CHECK != 0
@@ -314,6 +467,15 @@ typedef struct gc_heap_struct {
     gc_size_t total_gc_count;
     gc_size_t total_gc_time;
     gc_size_t max_gc_time;
+#if WASM_ENABLE_GC_PERF_PROFILING != 0
+    /* Time (us) of the mark and the sweep phases, and the number and
+       the total size of the objects marked */
+    gc_uint64 total_mark_time;
+    gc_uint64 total_sweep_time;
+    gc_uint64 total_marked_cnt;
+    gc_uint64 total_marked_size;
+    gc_size_t parallel_gc_count;
+#endif
     /* Usually there won't be too many extra info node, so we try to use a fixed
      * array to store them, if the fixed array don't have enough space to store
      * the nodes, a new space will be allocated from heap */
@@ -329,8 +491,204 @@ typedef struct gc_heap_struct {
     gc_uint64 total_size_allocated;
     gc_uint64 total_size_freed;
 #endif
+
+#if BH_ENABLE_GC_SLAB != 0
+    /* One byte for each page of the heap, non-zero if the page is a slab
+       page, NULL if the heap doesn't use slab pages. It is placed after
+       the end of the heap. */
+    gc_uint8 *slab_map;
+    gc_size_t slab_page_cnt;
+    /* Offsets of the first slab page with free slots of each class,
+       [0] for vo objects and [1] for wo objects, 0 if none */
+    gc_uint32 slab_partial[2][GC_SLAB_CLASS_NUM];
+    /* Offset of the first empty slab page kept for reuse, the pages
+       are linked with next_offset, 0 if none */
+    gc_uint32 slab_empty;
+    gc_size_t slab_empty_cnt;
+#endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+    /* The free part of the current nursery region */
+    gc_uint8 *nursery_cur;
+    gc_uint8 *nursery_end;
+    /* Offsets from the heap base address and sizes of the nursery
+       regions allocated since the last collection */
+    gc_uint32 *nursery_regions;
+    gc_uint32 nursery_region_cnt;
+    gc_uint32 nursery_region_max;
+    /* The old objects which may refer to young objects, and the objects
+       allocated outside the nursery since the last collection */
+    gc_object_t *remset;
+    gc_uint32 remset_cnt;
+    gc_uint32 remset_capacity;
+    gc_size_t minor_gc_count;
+    gc_size_t major_gc_count;
+    /* Next heap in the list of the heaps with nursery */
+    struct gc_heap_struct *next_generational;
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+    /* Offsets of the blocks from which the heap is split into ranges
+       to sweep in parallel, recorded by the last full sweep. A free
+       area never spans over them, and they are invalidated when a
+       freed block is merged with its neighbours */
+    gc_uint32 sweep_bounds[WASM_GC_MARK_THREAD_NUM];
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    /* Maximum time (us) of a slice */
+    gc_uint32 pause_budget;
+    /* Size of the wo objects allocated since the last slice */
+    gc_size_t step_alloc_size;
+    /* Offset from the heap base address of the first block which isn't
+       swept yet in the sweep phase */
+    gc_size_t sweep_offset;
+    gc_pause_stats_t pause_stats;
+    /* Next heap in the list of the heaps in the mark phase */
+    struct gc_heap_struct *next_marking;
+#endif
 } gc_heap_t;
 
+#if BH_ENABLE_GC_SLAB != 0
+/* Return the slab page which the hmu is, or NULL if it isn't one */
+static inline gc_slab_page_t *
+gci_hmu_to_slab_page(gc_heap_t *heap, hmu_t *hmu)
+{
+    gc_size_t offset = (gc_size_t)((gc_uint8 *)hmu - heap->base_addr);
+
+    if (!heap->slab_map || (offset & (GC_SLAB_PAGE_SIZE - 1)) != 0
+        || offset / GC_SLAB_PAGE_SIZE >= heap->slab_page_cnt
+        || !heap->slab_map[offset / GC_SLAB_PAGE_SIZE])
+        return NULL;
+    return (gc_slab_page_t *)hmu_to_obj(hmu);
+}
+
+/* Return the slab page which contains the object, or NULL if the object
+   isn't in a slab page */
+static inline gc_slab_page_t *
+gci_obj_to_slab_page(gc_heap_t *heap, gc_object_t obj)
+{
+    gc_uint8 *addr = (gc_uint8 *)obj;
+    gc_size_t page_idx;
+
+    if (!heap->slab_map || addr < heap->base_addr)
+        return NULL;
+
+    page_idx = (gc_size_t)(addr - heap->base_addr) / GC_SLAB_PAGE_SIZE;
+    if (page_idx >= heap->slab_page_cnt || !heap->slab_map[page_idx])
+        return NULL;
+    return (gc_slab_page_t *)hmu_to_obj(heap->base_addr
+                                        + page_idx * GC_SLAB_PAGE_SIZE);
+}
+
+/* Return the slot index of the object, or -1 if it isn't the start
+   address of a slot */
+static inline int
+gci_slab_slot_index(gc_slab_page_t *page, gc_object_t obj)
+{
+    gc_uint8 *slots = GC_SLAB_PAGE_SLOTS(page);
+    gc_size_t offset;
+
+    if ((gc_uint8 *)obj < slots)
+        return -1;
+    offset = (gc_size_t)((gc_uint8 *)obj - slots);
+    if (offset % page->slot_size != 0
+        || offset / page->slot_size >= page->slot_num)
+        return -1;
+    return (int)(offset / page->slot_size);
+}
+
+#define GC_SLAB_BIT_IS_SET(bits, idx) \
+    ((bits)[(idx) >> 5] & ((gc_uint32)1 << ((idx)&31)))
+#define GC_SLAB_SET_BIT(bits, idx) \
+    ((bits)[(idx) >> 5] |= ((gc_uint32)1 << ((idx)&31)))
+#define GC_SLAB_CLR_BIT(bits, idx) \
+    ((bits)[(idx) >> 5] &= ~((gc_uint32)1 << ((idx)&31)))
+
+/* Return the bits beyond slot_num in the given word of the bitmaps */
+static inline gc_uint32
+gci_slab_padding_bits(gc_slab_page_t *page, gc_uint32 word_idx)
+{
+    gc_uint32 first = word_idx * 32;
+
+    if (first >= page->slot_num)
+        return ~(gc_uint32)0;
+    if (page->slot_num - first >= 32)
+        return 0;
+    return ~(gc_uint32)0 << (page->slot_num - first);
+}
+
+/**
+ * Add the slab page to the list of pages with free slots of its class
+ */
+void
+gci_slab_link_page(gc_heap_t *heap, gc_slab_page_t *page);
+
+/**
+ * Release the empty slab page, the page must not be in the list of
+ * pages with free slots, and the hmu of the page is left for the caller
+ * to reclaim as a free chunk
+ */
+void
+gci_slab_release_page(gc_heap_t *heap, gc_slab_page_t *page);
+#endif /* end of BH_ENABLE_GC_SLAB != 0 */
+
+#if WASM_ENABLE_GC_NURSERY != 0
+/**
+ * Add the object to the remembered set of the heap, the heap lock must
+ * have been held
+ */
+void
+gci_remset_add(gc_heap_t *heap, gc_object_t obj);
+
+/**
+ * Remove the heap from the list of heaps with nursery and release the
+ * nursery data of it
+ */
+void
+gci_destroy_nursery(gc_heap_t *heap);
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+/* Whether the block isn't swept yet by the lazy sweep */
+static inline bool
+gci_is_unswept(gc_heap_t *heap, void *hmu)
+{
+    return heap->gc_phase == GC_PHASE_SWEEP
+           && (gc_uint8 *)hmu >= heap->base_addr + heap->sweep_offset;
+}
+
+/**
+ * Run a slice of the incremental collection, a cycle is started if
+ * there is none. The heap lock must have been held.
+ */
+void
+gci_incremental_step(gc_heap_t *heap);
+
+/**
+ * Sweep the heap lazily until a free chunk of the size is found, the
+ * heap lock must have been held
+ *
+ * @return true if any block is swept, false if the heap isn't in the
+ *         sweep phase
+ */
+bool
+gci_incremental_sweep(gc_heap_t *heap, gc_size_t size);
+
+/**
+ * Adjust the objects in the mark stack after the heap is migrated
+ */
+void
+gci_incremental_migrate(gc_heap_t *heap, intptr_t offset);
+
+/**
+ * Stop the collection cycle of the heap and remove it from the list of
+ * the heaps in the mark phase
+ */
+void
+gci_destroy_incremental(gc_heap_t *heap);
+#endif
+
 #if WASM_ENABLE_GC != 0
 
 #define GC_DEFAULT_THRESHOLD_FACTOR 300
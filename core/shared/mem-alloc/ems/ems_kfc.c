@@ -6,7 +6,8 @@
 #include "ems_gc_internal.h"
 
 static gc_handle_t
-gc_init_internal(gc_heap_t *heap, char *base_addr, gc_size_t heap_max_size)
+gc_init_internal(gc_heap_t *heap, char *base_addr, gc_size_t heap_max_size,
+                 bool enable_slab)
 {
     hmu_tree_node_t *root = NULL, *q = NULL;
     int ret;
@@ -14,6 +15,19 @@ gc_init_internal(gc_heap_t *heap, char *base_addr, gc_size_t heap_max_size)
     memset(heap, 0, sizeof *heap);
     memset(base_addr, 0, heap_max_size);
 
+#if BH_ENABLE_GC_SLAB != 0
+    if (enable_slab && heap_max_size >= GC_SLAB_MIN_HEAP_SIZE) {
+        /* Place the slab page map after the end of the heap */
+        gc_size_t slab_map_size = GC_ALIGN_8(heap_max_size / GC_SLAB_PAGE_SIZE);
+
+        heap_max_size -= slab_map_size;
+        heap->slab_map = (gc_uint8 *)base_addr + heap_max_size;
+        heap->slab_page_cnt = heap_max_size / GC_SLAB_PAGE_SIZE;
+    }
+#else
+    (void)enable_slab;
+#endif
+
     ret = os_mutex_init(&heap->lock);
     if (ret != BHT_OK) {
         LOG_ERROR("[GC_ERROR]failed to init lock\n");
@@ -56,8 +70,8 @@ gc_init_internal(gc_heap_t *heap, char *base_addr, gc_size_t heap_max_size)
     return heap;
 }
 
-gc_handle_t
-gc_init_with_pool(char *buf, gc_size_t buf_size)
+static gc_handle_t
+init_with_pool(char *buf, gc_size_t buf_size, bool enable_slab)
 {
     char *buf_end = buf + buf_size;
     char *buf_aligned = (char *)(((uintptr_t)buf + 7) & (uintptr_t)~7);
@@ -82,7 +96,19 @@ gc_init_with_pool(char *buf, gc_size_t buf_size)
     os_printf("   padding bytes: %u\n",
               buf_size - sizeof(gc_heap_t) - heap_max_size);
 #endif
-    return gc_init_internal(heap, base_addr, heap_max_size);
+    return gc_init_internal(heap, base_addr, heap_max_size, enable_slab);
+}
+
+gc_handle_t
+gc_init_with_pool(char *buf, gc_size_t buf_size)
+{
+    return init_with_pool(buf, buf_size, false);
+}
+
+gc_handle_t
+gc_init_gc_heap_with_pool(char *buf, gc_size_t buf_size)
+{
+    return init_with_pool(buf, buf_size, true);
 }
 
 gc_handle_t
@@ -125,7 +151,7 @@ gc_init_with_struct_and_pool(char *struct_buf, gc_size_t struct_buf_size,
     os_printf("   actual heap size: %u\n", heap_max_size);
     os_printf("   padding bytes: %u\n", pool_buf_size - heap_max_size);
 #endif
-    return gc_init_internal(heap, base_addr, heap_max_size);
+    return gc_init_internal(heap, base_addr, heap_max_size, false);
 }
 
 int
@@ -137,6 +163,13 @@ gc_destroy_with_pool(gc_handle_t handle)
 #if WASM_ENABLE_GC != 0
     gc_size_t i = 0;
 
+#if WASM_ENABLE_GC_NURSERY != 0
+    gci_destroy_nursery(heap);
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    gci_destroy_incremental(heap);
+#endif
+
     if (heap->extra_info_node_cnt > 0) {
         for (i = 0; i < heap->extra_info_node_cnt; i++) {
             extra_info_node_t *node = heap->extra_info_nodes[i];
@@ -221,7 +254,7 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     intptr_t offset = (uint8 *)base_addr_new - (uint8 *)heap->base_addr;
     hmu_t *cur = NULL, *end = NULL;
     hmu_tree_node_t *tree_node;
-    uint8 **p_left, **p_right, **p_parent;
+    uint8 **p_left, **p_right, **p_parent, **p_next_same;
     gc_size_t heap_max_size, size;
 
     if ((((uintptr_t)pool_buf_new) & 7) != 0) {
@@ -230,6 +263,11 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     }
 
     heap_max_size = (uint32)(pool_buf_end - base_addr_new) & (uint32)~7;
+#if BH_ENABLE_GC_SLAB != 0
+    if (heap->slab_map && heap_max_size >= heap->slab_page_cnt)
+        /* The slab page map is placed after the end of the heap */
+        heap_max_size -= heap->slab_page_cnt;
+#endif
 
     if (pool_buf_end < base_addr_new || heap_max_size < heap->current_size) {
         LOG_ERROR("[GC_ERROR]heap migrate invlaid pool buf size\n");
@@ -247,6 +285,18 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
 #endif
 
     heap->base_addr = (uint8 *)base_addr_new;
+#if BH_ENABLE_GC_SLAB != 0
+    adjust_ptr(&heap->slab_map, offset);
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+    adjust_ptr(&heap->nursery_cur, offset);
+    adjust_ptr(&heap->nursery_end, offset);
+    for (size = 0; size < heap->remset_cnt; size++)
+        adjust_ptr((uint8 **)&heap->remset[size], offset);
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+    gci_incremental_migrate(heap, offset);
+#endif
 
     ASSERT_TREE_NODE_ALIGNED_ACCESS(heap->kfc_tree_root);
 
@@ -285,8 +335,11 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
                                  + offsetof(hmu_tree_node_t, right));
             p_parent = (uint8 **)((uint8 *)tree_node
                                   + offsetof(hmu_tree_node_t, parent));
+            p_next_same = (uint8 **)((uint8 *)tree_node
+                                     + offsetof(hmu_tree_node_t, next_same));
             adjust_ptr(p_left, offset);
             adjust_ptr(p_right, offset);
+            adjust_ptr(p_next_same, offset);
             if (tree_node->parent != heap->kfc_tree_root)
                 /* The root node belongs to heap structure,
                    it is fixed part and isn't changed. */
@@ -308,6 +361,87 @@ gc_migrate(gc_handle_t handle, char *pool_buf_new, gc_size_t pool_buf_size)
     return 0;
 }
 
+int
+gc_save_heap_struct(gc_handle_t handle, char *image)
+{
+    gc_heap_t *heap = (gc_heap_t *)handle;
+    uint32 lock_offset = (uint32)offsetof(gc_heap_t, lock);
+    uint32 lock_end = lock_offset + (uint32)sizeof(korp_mutex);
+    int ret = GC_SUCCESS;
+
+    os_mutex_lock(&heap->lock);
+
+#if WASM_ENABLE_GC != 0
+    /* The objects of a heap which is collected may be referred to out of
+       the heap, and its nursery and marking state are allocated out of
+       the pool */
+    if (heap->is_reclaim_enabled || heap->extra_info_node_cnt > 0
+#if WASM_ENABLE_GC_NURSERY != 0
+        || heap->is_generational
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        || heap->gc_phase != GC_PHASE_IDLE
+#endif
+    ) {
+        LOG_ERROR("[GC_ERROR]heap save struct of a collected heap\n");
+        ret = GC_ERROR;
+    }
+#endif
+
+#if BH_ENABLE_GC_CORRUPTION_CHECK != 0
+    if (heap->is_heap_corrupted) {
+        LOG_ERROR("[GC_ERROR]Heap is corrupted, heap save struct failed.\n");
+        ret = GC_ERROR;
+    }
+#endif
+
+    if (ret == GC_SUCCESS) {
+        /* The lock isn't saved, it is initialized again when the heap
+           is restored */
+        bh_memcpy_s(image, lock_offset, heap, lock_offset);
+        memset(image + lock_offset, 0, sizeof(korp_mutex));
+        bh_memcpy_s(image + lock_end, (uint32)sizeof(gc_heap_t) - lock_end,
+                    (uint8 *)heap + lock_end,
+                    (uint32)sizeof(gc_heap_t) - lock_end);
+    }
+
+    os_mutex_unlock(&heap->lock);
+    return ret;
+}
+
+gc_handle_t
+gc_restore_heap_struct(char *struct_buf, const char *image, char *pool_buf,
+                       gc_size_t pool_buf_size)
+{
+    gc_heap_t *heap = (gc_heap_t *)struct_buf;
+    uint32 lock_offset = (uint32)offsetof(gc_heap_t, lock);
+    uint32 lock_end = lock_offset + (uint32)sizeof(korp_mutex);
+
+    /* The heap structure refers to itself, e.g. kfc_tree_root, so it
+       can only be restored into the struct buffer it was saved from */
+    if (((const gc_heap_t *)image)->heap_id != (gc_handle_t)struct_buf) {
+        LOG_ERROR("[GC_ERROR]heap restore struct buf mismatch\n");
+        return NULL;
+    }
+
+    bh_memcpy_s(heap, lock_offset, image, lock_offset);
+    bh_memcpy_s((uint8 *)heap + lock_end, (uint32)sizeof(gc_heap_t) - lock_end,
+                image + lock_end, (uint32)sizeof(gc_heap_t) - lock_end);
+
+    if (os_mutex_init(&heap->lock) != BHT_OK) {
+        LOG_ERROR("[GC_ERROR]failed to init lock\n");
+        return NULL;
+    }
+
+    /* Adjust the pointers to the pool if it has been moved */
+    if (gc_migrate((gc_handle_t)heap, pool_buf, pool_buf_size)
+        != GC_SUCCESS) {
+        os_mutex_destroy(&heap->lock);
+        return NULL;
+    }
+    return (gc_handle_t)heap;
+}
+
 bool
 gc_is_heap_corrupted(gc_handle_t handle)
 {
@@ -464,13 +598,16 @@ gc_heap_stats(void *heap_arg, uint32 *stats, int size)
 void
 gc_traverse_tree(hmu_tree_node_t *node, gc_size_t *stats, int *n)
 {
+    hmu_tree_node_t *same;
+
     if (!node)
         return;
 
     if (*n > 0)
         gc_traverse_tree(node->right, stats, n);
 
-    if (*n > 0) {
+    /* The chunks of the same size as the node */
+    for (same = node; same && *n > 0; same = same->next_same) {
         (*n)--;
         stats[*n] = node->size;
     }
@@ -515,9 +652,62 @@ gc_dump_perf_profiling(gc_handle_t *handle)
     gc_heap_t *gc_heap_handle = (void *)handle;
     if (gc_heap_handle) {
         os_printf("\nGC performance summary\n");
-        os_printf("    Total GC time (ms): %u\n",
-                  gc_heap_handle->total_gc_time);
-        os_printf("    Max GC time (ms): %u\n", gc_heap_handle->max_gc_time);
+        /* the times are recorded in microseconds */
+        os_printf("    Total GC time (ms): %.3f\n",
+                  gc_heap_handle->total_gc_time / 1000.0);
+        os_printf("    Max GC time (ms): %.3f\n",
+                  gc_heap_handle->max_gc_time / 1000.0);
+        os_printf("    Total mark time (ms): %.3f\n",
+                  gc_heap_handle->total_mark_time / 1000.0);
+        os_printf("    Total sweep time (ms): %.3f\n",
+                  gc_heap_handle->total_sweep_time / 1000.0);
+        if (gc_heap_handle->total_gc_count > 0)
+            os_printf("    Average GC pause (us): %" PRIu64 "\n",
+                      (uint64)gc_heap_handle->total_gc_time
+                          / gc_heap_handle->total_gc_count);
+        os_printf("    Marked objects: %" PRIu64 ", %" PRIu64 " bytes\n",
+                  gc_heap_handle->total_marked_cnt,
+                  gc_heap_handle->total_marked_size);
+        if (gc_heap_handle->total_mark_time > 0)
+            /* bytes per microsecond is MB per second */
+            os_printf("    Mark throughput (MB/s): %.1f\n",
+                      (double)gc_heap_handle->total_marked_size
+                          / gc_heap_handle->total_mark_time);
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+        os_printf("    Parallel GC count: %u, with %u threads\n",
+                  gc_heap_handle->parallel_gc_count,
+                  (uint32)WASM_GC_MARK_THREAD_NUM);
+#endif
+#if WASM_ENABLE_GC_NURSERY != 0
+        if (gc_heap_handle->is_generational) {
+            os_printf("    Minor GC count: %u\n",
+                      gc_heap_handle->minor_gc_count);
+            os_printf("    Major GC count: %u\n",
+                      gc_heap_handle->major_gc_count);
+        }
+#endif
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+        if (gc_heap_handle->pause_stats.pause_count > 0) {
+            gc_pause_stats_t *stats = &gc_heap_handle->pause_stats;
+            gc_uint32 i;
+
+            os_printf("    GC pauses: %" PRIu64 ", max %" PRIu64
+                      " us, average %" PRIu64 " us\n",
+                      stats->pause_count, stats->max_pause_us,
+                      stats->total_pause_us / stats->pause_count);
+            os_printf("    GC pause histogram (us):");
+            for (i = 0; i < GC_PAUSE_HISTOGRAM_SIZE; i++) {
+                if (stats->histogram[i] == 0)
+                    continue;
+                if (i < GC_PAUSE_HISTOGRAM_SIZE - 1)
+                    os_printf(" <%u: %" PRIu64, 16u << i, stats->histogram[i]);
+                else
+                    os_printf(" >=%u: %" PRIu64, 16u << (i - 1),
+                              stats->histogram[i]);
+            }
+            os_printf("\n");
+        }
+#endif
     }
     else {
         os_printf("Failed to dump GC performance\n");
@@ -16,6 +16,12 @@ mem_allocator_create(void *mem, uint32_t size)
     return gc_init_with_pool((char *)mem, size);
 }
 
+mem_allocator_t
+mem_allocator_create_gc_heap(void *mem, uint32_t size)
+{
+    return gc_init_gc_heap_with_pool((char *)mem, size);
+}
+
 mem_allocator_t
 mem_allocator_create_with_struct_and_pool(void *struct_buf,
                                           uint32_t struct_buf_size,
@@ -57,6 +63,28 @@ mem_allocator_free(mem_allocator_t allocator, void *ptr)
         gc_free_vo((gc_handle_t)allocator, ptr);
 }
 
+#if BH_ENABLE_GC_VERIFY == 0
+int
+mem_allocator_malloc_batch(mem_allocator_t allocator, uint32_t size,
+                           void **ptrs, int count)
+{
+    return gc_alloc_vo_batch((gc_handle_t)allocator, size,
+                             (gc_object_t *)ptrs, count);
+}
+
+void
+mem_allocator_free_batch(mem_allocator_t allocator, void **ptrs, int count)
+{
+    gc_free_vo_batch((gc_handle_t)allocator, (gc_object_t *)ptrs, count);
+}
+
+uint32
+mem_allocator_get_size(mem_allocator_t allocator, void *ptr)
+{
+    return gc_get_vo_size((gc_handle_t)allocator, (gc_object_t)ptr);
+}
+#endif
+
 #if WASM_ENABLE_GC != 0
 void *
 mem_allocator_malloc_with_gc(mem_allocator_t allocator, uint32_t size)
@@ -107,6 +135,20 @@ mem_allocator_is_heap_corrupted(mem_allocator_t allocator)
     return gc_is_heap_corrupted((gc_handle_t)allocator);
 }
 
+int
+mem_allocator_save_heap_struct(mem_allocator_t allocator, void *image)
+{
+    return gc_save_heap_struct((gc_handle_t)allocator, (char *)image);
+}
+
+mem_allocator_t
+mem_allocator_restore_heap_struct(void *struct_buf, const void *image,
+                                  void *pool_buf, uint32_t pool_buf_size)
+{
+    return gc_restore_heap_struct((char *)struct_buf, (const char *)image,
+                                  (char *)pool_buf, pool_buf_size);
+}
+
 bool
 mem_allocator_get_alloc_info(mem_allocator_t allocator, void *mem_alloc_info)
 {
@@ -136,6 +178,91 @@ mem_allocator_dump_perf_profiling(mem_allocator_t allocator)
 }
 #endif
 
+#if WASM_ENABLE_GC_NURSERY != 0
+bool
+mem_allocator_init_nursery_list(void)
+{
+    return gc_init_nursery_list() == GC_SUCCESS;
+}
+
+void
+mem_allocator_destroy_nursery_list(void)
+{
+    gc_destroy_nursery_list();
+}
+
+bool
+mem_allocator_enable_nursery(mem_allocator_t allocator)
+{
+    return gc_enable_nursery((gc_handle_t)allocator) == GC_SUCCESS;
+}
+
+void
+mem_allocator_write_barrier(void *obj, void *ref)
+{
+    gc_write_barrier((gc_object_t)obj, (gc_object_t)ref);
+}
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+bool
+mem_allocator_init_incremental_list(void)
+{
+    return gc_init_incremental_list() == GC_SUCCESS;
+}
+
+void
+mem_allocator_destroy_incremental_list(void)
+{
+    gc_destroy_incremental_list();
+}
+
+bool
+mem_allocator_enable_incremental(mem_allocator_t allocator)
+{
+    return gc_enable_incremental((gc_handle_t)allocator) == GC_SUCCESS;
+}
+
+void
+mem_allocator_set_gc_pause_budget(mem_allocator_t allocator,
+                                  uint32_t budget_us)
+{
+    gc_set_pause_budget((gc_handle_t)allocator, budget_us);
+}
+
+void
+mem_allocator_get_gc_pause_stats(mem_allocator_t allocator, void *stats)
+{
+    gc_get_pause_stats((gc_handle_t)allocator, (gc_pause_stats_t *)stats);
+}
+
+bool
+mem_allocator_gc_step(mem_allocator_t allocator)
+{
+    return gc_incremental_step((gc_handle_t)allocator);
+}
+
+void
+mem_allocator_pre_write_barrier(void **refs, uint32_t ref_num)
+{
+    gc_pre_write_barrier((gc_object_t *)refs, ref_num);
+}
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+bool
+mem_allocator_init_mark_workers(void)
+{
+    return gc_init_mark_workers() == GC_SUCCESS;
+}
+
+void
+mem_allocator_destroy_mark_workers(void)
+{
+    gc_destroy_mark_workers();
+}
+#endif
+
 #endif
 
 #else /* else of DEFAULT_MEM_ALLOCATOR */
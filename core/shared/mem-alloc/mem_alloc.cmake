@@ -24,6 +24,21 @@ if (WAMR_BUILD_GC_CORRUPTION_CHECK EQUAL 0)
     add_definitions (-DBH_ENABLE_GC_CORRUPTION_CHECK=0)
 endif ()
 
+if (NOT DEFINED WAMR_BUILD_GC_SLAB)
+    # Only the GC heaps use the slab pages, enable them
+    # when GC is enabled
+    if (WAMR_BUILD_GC EQUAL 1)
+        set (WAMR_BUILD_GC_SLAB 1)
+    else ()
+        set (WAMR_BUILD_GC_SLAB 0)
+    endif ()
+endif ()
+
+if (WAMR_BUILD_GC_SLAB EQUAL 1)
+    # Enable the slab pages for small objects of the GC heaps
+    add_definitions (-DBH_ENABLE_GC_SLAB=1)
+endif ()
+
 file (GLOB_RECURSE source_all
       ${MEM_ALLOC_DIR}/ems/*.c
       ${MEM_ALLOC_DIR}/tlsf/*.c
@@ -25,6 +25,12 @@ typedef void (*gc_finalizer_t)(void *obj, void *data);
 mem_allocator_t
 mem_allocator_create(void *mem, uint32_t size);
 
+#if DEFAULT_MEM_ALLOCATOR == MEM_ALLOCATOR_EMS
+/* Create the heap of the GC objects of wasm apps */
+mem_allocator_t
+mem_allocator_create_gc_heap(void *mem, uint32_t size);
+#endif
+
 mem_allocator_t
 mem_allocator_create_with_struct_and_pool(void *struct_buf,
                                           uint32_t struct_buf_size,
@@ -53,6 +59,25 @@ mem_allocator_migrate(mem_allocator_t allocator, char *pool_buf_new,
 bool
 mem_allocator_is_heap_corrupted(mem_allocator_t allocator);
 
+int
+mem_allocator_save_heap_struct(mem_allocator_t allocator, void *image);
+
+mem_allocator_t
+mem_allocator_restore_heap_struct(void *struct_buf, const void *image,
+                                  void *pool_buf, uint32_t pool_buf_size);
+
+#if DEFAULT_MEM_ALLOCATOR == MEM_ALLOCATOR_EMS && BH_ENABLE_GC_VERIFY == 0
+int
+mem_allocator_malloc_batch(mem_allocator_t allocator, uint32_t size,
+                           void **ptrs, int count);
+
+void
+mem_allocator_free_batch(mem_allocator_t allocator, void **ptrs, int count);
+
+uint32
+mem_allocator_get_size(mem_allocator_t allocator, void *ptr);
+#endif
+
 #if WASM_ENABLE_GC != 0
 void *
 mem_allocator_malloc_with_gc(mem_allocator_t allocator, uint32_t size);
@@ -84,6 +109,52 @@ mem_allocator_unset_gc_finalizer(mem_allocator_t allocator, void *obj);
 void
 mem_allocator_dump_perf_profiling(mem_allocator_t allocator);
 #endif
+
+#if WASM_ENABLE_GC_NURSERY != 0
+bool
+mem_allocator_init_nursery_list(void);
+
+void
+mem_allocator_destroy_nursery_list(void);
+
+bool
+mem_allocator_enable_nursery(mem_allocator_t allocator);
+
+void
+mem_allocator_write_barrier(void *obj, void *ref);
+#endif
+
+#if WASM_ENABLE_GC_INCREMENTAL != 0
+bool
+mem_allocator_init_incremental_list(void);
+
+void
+mem_allocator_destroy_incremental_list(void);
+
+bool
+mem_allocator_enable_incremental(mem_allocator_t allocator);
+
+void
+mem_allocator_set_gc_pause_budget(mem_allocator_t allocator,
+                                  uint32_t budget_us);
+
+void
+mem_allocator_get_gc_pause_stats(mem_allocator_t allocator, void *stats);
+
+bool
+mem_allocator_gc_step(mem_allocator_t allocator);
+
+void
+mem_allocator_pre_write_barrier(void **refs, uint32_t ref_num);
+#endif
+
+#if WASM_ENABLE_GC_PARALLEL_MARK != 0
+bool
+mem_allocator_init_mark_workers(void);
+
+void
+mem_allocator_destroy_mark_workers(void);
+#endif
 #endif /* end of WASM_ENABLE_GC != 0 */
 
 bool
@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "platform_api_vmcore.h"
+#include "platform_api_extension.h"
+
+#ifdef OS_ENABLE_FILE_MAP
+
+void *
+os_mmap_file(const char *path, uint64 *p_size)
+{
+    struct stat stat_buf;
+    void *addr;
+    int fd;
+
+    if ((fd = open(path, O_RDONLY)) < 0)
+        return NULL;
+
+    if (fstat(fd, &stat_buf) != 0 || stat_buf.st_size <= 0
+        || (uint64)stat_buf.st_size > SIZE_MAX) {
+        close(fd);
+        return NULL;
+    }
+
+    /* the mapping is kept valid after the file is closed */
+    addr = mmap(NULL, (size_t)stat_buf.st_size, PROT_READ | PROT_WRITE,
+                MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED)
+        return NULL;
+
+    *p_size = (uint64)stat_buf.st_size;
+    return addr;
+}
+
+void
+os_munmap_file(void *addr, uint64 size)
+{
+    if (addr && munmap(addr, (size_t)size) != 0)
+        os_printf("os_munmap_file error addr:%p, size:0x%" PRIx64
+                  ", errno:%d\n",
+                  addr, size, errno);
+}
+
+#endif /* end of OS_ENABLE_FILE_MAP */
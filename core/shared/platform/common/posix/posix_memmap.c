@@ -277,6 +277,35 @@ os_mprotect(void *addr, size_t size, int prot)
     return mprotect(addr, request_size, map_prot);
 }
 
+int
+os_mem_decommit(void *addr, size_t size)
+{
+    uint64 page_size = (uint64)getpagesize();
+    uint64 request_size = (size + page_size - 1) & ~(page_size - 1);
+
+    if (!addr || request_size == 0)
+        return 0;
+
+#if defined(__linux__) && defined(MADV_DONTNEED)
+    /* private anonymous pages are zero-filled on the next access */
+    if (madvise(addr, request_size, MADV_DONTNEED) == 0)
+        return 0;
+#endif
+
+    /* replace the pages with a fresh inaccessible mapping, MADV_DONTNEED
+       doesn't guarantee zero-filled pages on other systems */
+    if (mmap(addr, request_size, PROT_NONE,
+             MAP_ANONYMOUS | MAP_PRIVATE | MAP_FIXED, -1, 0)
+        == MAP_FAILED) {
+        os_printf("os_mem_decommit error addr:%p, size:0x%" PRIx64
+                  ", errno:%d\n",
+                  addr, request_size, errno);
+        return -1;
+    }
+
+    return 0;
+}
+
 void
 os_dcache_flush(void)
 {}
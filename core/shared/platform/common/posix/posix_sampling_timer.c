@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "platform_api_vmcore.h"
+#include "platform_api_extension.h"
+
+#ifdef OS_ENABLE_SAMPLING_TIMER
+
+#include <sys/time.h>
+
+static os_sampling_timer_handler g_sampling_timer_handler = NULL;
+static struct sigaction g_prev_sig_act_SIGPROF;
+static bool g_sampling_timer_started = false;
+
+static void
+sampling_timer_sighandler(int signo)
+{
+    int saved_errno = errno;
+    os_sampling_timer_handler handler = g_sampling_timer_handler;
+
+    (void)signo;
+    if (handler)
+        handler();
+    errno = saved_errno;
+}
+
+int
+os_sampling_timer_start(os_sampling_timer_handler handler, uint32 interval_us)
+{
+    struct sigaction sa;
+    struct itimerval timer = { 0 };
+
+    if (!handler || interval_us == 0 || g_sampling_timer_started) {
+        return BHT_ERROR;
+    }
+
+    g_sampling_timer_handler = handler;
+
+    sigemptyset(&sa.sa_mask);
+    /* Restart the system calls interrupted by the timer */
+    sa.sa_flags = SA_RESTART;
+    sa.sa_handler = sampling_timer_sighandler;
+    if (sigaction(SIGPROF, &sa, &g_prev_sig_act_SIGPROF) != 0) {
+        g_sampling_timer_handler = NULL;
+        return BHT_ERROR;
+    }
+
+    timer.it_interval.tv_sec = interval_us / 1000000;
+    timer.it_interval.tv_usec = interval_us % 1000000;
+    timer.it_value = timer.it_interval;
+    if (setitimer(ITIMER_PROF, &timer, NULL) != 0) {
+        sigaction(SIGPROF, &g_prev_sig_act_SIGPROF, NULL);
+        g_sampling_timer_handler = NULL;
+        return BHT_ERROR;
+    }
+
+    g_sampling_timer_started = true;
+    return BHT_OK;
+}
+
+void
+os_sampling_timer_stop()
+{
+    struct itimerval timer = { 0 };
+
+    if (!g_sampling_timer_started) {
+        return;
+    }
+
+    setitimer(ITIMER_PROF, &timer, NULL);
+    /* Keep the handler installed, a SIGPROF which is already pending
+       may still be delivered, the handler of the runtime ignores it
+       after the profiler is stopped */
+    g_sampling_timer_started = false;
+}
+
+#endif /* end of OS_ENABLE_SAMPLING_TIMER */
@@ -409,6 +409,26 @@ os_thread_exit(void *retval)
     return pthread_exit(retval);
 }
 
+#ifdef OS_ENABLE_THREAD_KEY
+int
+os_thread_key_create(korp_thread_key *key, void (*destructor)(void *))
+{
+    return pthread_key_create(key, destructor) == 0 ? BHT_OK : BHT_ERROR;
+}
+
+int
+os_thread_key_delete(korp_thread_key key)
+{
+    return pthread_key_delete(key) == 0 ? BHT_OK : BHT_ERROR;
+}
+
+int
+os_thread_key_set(korp_thread_key key, void *value)
+{
+    return pthread_setspecific(key, value) == 0 ? BHT_OK : BHT_ERROR;
+}
+#endif /* end of OS_ENABLE_THREAD_KEY */
+
 #if defined(os_thread_local_attribute)
 static os_thread_local_attribute uint8 *thread_stack_boundary = NULL;
 #endif
@@ -604,7 +624,10 @@ signal_callback(int sig_num, siginfo_t *sig_info, void *sig_ucontext)
 
     /* Try to handle signal with the registered signal handler */
     if (signal_handler && (sig_num == SIGSEGV || sig_num == SIGBUS)) {
-        signal_handler(sig_addr);
+        /* Return to restart the faulting instruction, the signal mask
+           is restored from sig_ucontext by the kernel */
+        if (signal_handler(sig_addr))
+            return;
     }
 
     if (sig_num == SIGSEGV)
@@ -85,7 +85,9 @@ typedef jmp_buf korp_jmpbuf;
 #define os_longjmp longjmp
 #define os_alloca alloca
 
-typedef void (*os_signal_handler)(void *sig_addr);
+/* Return true if the signal is handled and the faulting instruction
+   can be restarted, otherwise the signal is forwarded */
+typedef bool (*os_signal_handler)(void *sig_addr);
 
 int
 os_thread_signal_init(os_signal_handler handler);
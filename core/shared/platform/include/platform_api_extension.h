@@ -402,6 +402,121 @@ os_end_blocking_op();
 int
 os_wakeup_blocking_op(korp_tid tid);
 
+#ifdef OS_ENABLE_FUTEX
+/**
+ * Block the calling thread while *addr still equals expected, until
+ * it is woken by os_futex_wake or the timeout expires.
+ *
+ * The caller must re-check its own condition after return, the call
+ * may also return because of a signal or a spurious wakeup.
+ *
+ * @param addr the 32-bit futex word, must be 4-byte aligned
+ * @param expected the value the futex word is expected to hold
+ * @param useconds relative timeout, or BHT_WAIT_FOREVER
+ *
+ * @return BHT_OK if woken or *addr != expected, BHT_TIMED_OUT if
+ *         the timeout expired, BHT_ERROR otherwise
+ */
+int
+os_futex_wait(uint32 *addr, uint32 expected, uint64 useconds);
+
+/**
+ * Wake up at most count threads blocked in os_futex_wait on addr.
+ *
+ * @param addr the 32-bit futex word
+ * @param count the max number of threads to wake up
+ *
+ * @return the number of threads woken up, or BHT_ERROR
+ */
+int
+os_futex_wake(uint32 *addr, uint32 count);
+#endif /* end of OS_ENABLE_FUTEX */
+
+#ifdef OS_ENABLE_SAMPLING_TIMER
+typedef void (*os_sampling_timer_handler)(void);
+
+/**
+ * Start the process-wide profiling timer. Each time the process has
+ * consumed interval_us of cpu time, the handler is called in signal
+ * context on the thread which is running, so it must be async-signal
+ * safe.
+ *
+ * @param handler the handler to call
+ * @param interval_us the sampling interval in microseconds of cpu time
+ *
+ * @return BHT_OK if success, BHT_ERROR otherwise
+ */
+int
+os_sampling_timer_start(os_sampling_timer_handler handler, uint32 interval_us);
+
+/**
+ * Stop the timer started by os_sampling_timer_start.
+ */
+void
+os_sampling_timer_stop(void);
+#endif /* end of OS_ENABLE_SAMPLING_TIMER */
+
+#ifdef OS_ENABLE_THREAD_KEY
+/**
+ * Create a thread-specific data key, the destructor is called with the
+ * value of the key when a thread whose value isn't NULL exits, including
+ * the threads which aren't created by os_thread_create.
+ *
+ * @param key output of the key created
+ * @param destructor the destructor of the values, or NULL
+ *
+ * @return BHT_OK if success, BHT_ERROR otherwise
+ */
+int
+os_thread_key_create(korp_thread_key *key, void (*destructor)(void *));
+
+/**
+ * Delete a key created by os_thread_key_create, the destructor isn't
+ * called for the values which are still set.
+ *
+ * @param key the key to delete
+ *
+ * @return BHT_OK if success, BHT_ERROR otherwise
+ */
+int
+os_thread_key_delete(korp_thread_key key);
+
+/**
+ * Set the value of a key for the current thread.
+ *
+ * @param key the key
+ * @param value the value, NULL to unset it
+ *
+ * @return BHT_OK if success, BHT_ERROR otherwise
+ */
+int
+os_thread_key_set(korp_thread_key key, void *value);
+#endif /* end of OS_ENABLE_THREAD_KEY */
+
+#ifdef OS_ENABLE_FILE_MAP
+/**
+ * Map a whole file privately into memory with read and write access,
+ * the pages written are copied and never written back to the file, the
+ * other pages are shared with the page cache.
+ *
+ * @param path the path of the file
+ * @param p_size output of the size of the file
+ *
+ * @return the address of the mapping if success, NULL otherwise
+ */
+void *
+os_mmap_file(const char *path, uint64 *p_size);
+
+/**
+ * Unmap a file mapped by os_mmap_file.
+ *
+ * @param addr the address of the mapping
+ * @param size the size of the file
+ */
+void
+os_munmap_file(void *addr, uint64 size);
+#endif /* end of OS_ENABLE_FILE_MAP */
+
 /****************************************************
  *                     Section 2                    *
  *                   Socket support                 *
@@ -142,6 +142,14 @@ os_munmap(void *addr, size_t size);
 int
 os_mprotect(void *addr, size_t size, int prot);
 
+/* Release the physical pages of a private anonymous mapped range while
+   keeping the range reserved, the pages read as zero when they are made
+   accessible again with os_mprotect (and os_mem_commit on Windows).
+   Returns 0 if success. Only required when OS_ENABLE_HW_BOUND_CHECK is
+   defined */
+int
+os_mem_decommit(void *addr, size_t size);
+
 static inline void *
 os_mremap_slow(void *old_addr, size_t old_size, size_t new_size)
 {
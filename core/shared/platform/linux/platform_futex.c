@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "platform_api_extension.h"
+
+#ifdef OS_ENABLE_FUTEX
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+
+int
+os_futex_wait(uint32 *addr, uint32 expected, uint64 useconds)
+{
+    struct timespec timeout, *p_timeout = NULL;
+    long ret;
+
+    if (useconds != BHT_WAIT_FOREVER) {
+        timeout.tv_sec = (time_t)(useconds / 1000000);
+        timeout.tv_nsec = (long)(useconds % 1000000) * 1000;
+        p_timeout = &timeout;
+    }
+
+    /* The futex words are only shared between threads of this process */
+    ret = syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, expected, p_timeout,
+                  NULL, 0);
+    if (ret == 0)
+        return BHT_OK;
+
+    switch (errno) {
+        case EAGAIN: /* *addr != expected */
+        case EINTR:
+            return BHT_OK;
+        case ETIMEDOUT:
+            return BHT_TIMED_OUT;
+        default:
+            return BHT_ERROR;
+    }
+}
+
+int
+os_futex_wake(uint32 *addr, uint32 count)
+{
+    long ret;
+
+    if (count > INT32_MAX)
+        count = INT32_MAX;
+
+    ret = syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, (int)count, NULL, NULL,
+                  0);
+    if (ret < 0)
+        return BHT_ERROR;
+
+    return (int)ret;
+}
+
+#endif /* end of OS_ENABLE_FUTEX */
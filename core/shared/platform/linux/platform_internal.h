@@ -56,6 +56,7 @@ typedef pthread_mutex_t korp_mutex;
 typedef pthread_cond_t korp_cond;
 typedef pthread_t korp_thread;
 typedef pthread_rwlock_t korp_rwlock;
+typedef pthread_key_t korp_thread_key;
 typedef sem_t korp_sem;
 
 #define OS_THREAD_MUTEX_INITIALIZER PTHREAD_MUTEX_INITIALIZER
@@ -95,7 +96,9 @@ typedef jmp_buf korp_jmpbuf;
 #define os_longjmp longjmp
 #define os_alloca alloca
 
-typedef void (*os_signal_handler)(void *sig_addr);
+/* Return true if the signal is handled and the faulting instruction
+   can be restarted, otherwise the signal is forwarded */
+typedef bool (*os_signal_handler)(void *sig_addr);
 
 int
 os_thread_signal_init(os_signal_handler handler);
@@ -122,6 +125,16 @@ os_sigreturn();
 void
 os_set_signal_number_for_blocking_op(int signo);
 
+#if WASM_DISABLE_FUTEX == 0
+#define OS_ENABLE_FUTEX
+#endif
+
+#define OS_ENABLE_SAMPLING_TIMER
+
+#define OS_ENABLE_THREAD_KEY
+
+#define OS_ENABLE_FILE_MAP
+
 typedef int os_file_handle;
 typedef DIR *os_dir_stream;
 typedef int os_raw_file_handle;
@@ -89,7 +89,7 @@ unsigned
 os_getpagesize();
 void *
 os_mem_commit(void *ptr, size_t size, int flags);
-void
+int
 os_mem_decommit(void *ptr, size_t size);
 
 #define os_thread_local_attribute __declspec(thread)
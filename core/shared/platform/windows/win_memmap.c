@@ -111,20 +111,20 @@ os_mem_commit(void *addr, size_t size, int flags)
     return VirtualAlloc((LPVOID)addr, request_size, MEM_COMMIT, protect);
 }
 
-void
+int
 os_mem_decommit(void *addr, size_t size)
 {
     size_t page_size = os_getpagesize();
     size_t request_size = (size + page_size - 1) & ~(page_size - 1);
 
     if (!addr)
-        return;
+        return 0;
 
 #if TRACE_MEMMAP != 0
     printf("Decommit memory, addr: %p, request_size: %zu\n", addr,
            request_size);
 #endif
-    VirtualFree((LPVOID)addr, request_size, MEM_DECOMMIT);
+    return VirtualFree((LPVOID)addr, request_size, MEM_DECOMMIT) ? 0 : -1;
 }
 
 int
@@ -501,6 +501,7 @@ CSRCS += ${SHARED_ROOT}/platform/nuttx/nuttx_platform.c \
          ${IWASM_ROOT}/common/wasm_application.c \
          ${IWASM_ROOT}/common/wasm_blocking_op.c \
          ${IWASM_ROOT}/common/wasm_runtime_common.c \
+         ${IWASM_ROOT}/common/wasm_sampling_profiler.c \
          ${IWASM_ROOT}/common/wasm_native.c \
          ${IWASM_ROOT}/common/wasm_exec_env.c \
          ${IWASM_ROOT}/common/wasm_memory.c \
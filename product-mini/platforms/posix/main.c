@@ -83,6 +83,20 @@ print_help()
 #if WASM_CONFIGURABLE_BOUNDS_CHECKS != 0
     printf("  --disable-bounds-checks  Disable bounds checks for memory accesses\n");
 #endif
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+    printf("  --lazy-validation        Validate and prepare the wasm functions when they are\n");
+    printf("                           called for the first time instead of at load time\n");
+#endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+    printf("  --fast-interp-cache=<dir>\n");
+    printf("                           Cache the prepared bytecode of the wasm module in the\n");
+    printf("                           directory and map it when the module is loaded again\n");
+#endif
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0
+    printf("  --map-aot-file           Map the AOT file into memory instead of reading it, the\n");
+    printf("                           text generated by wamrc --enable-shared-text is executed\n");
+    printf("                           in place and shared between processes\n");
+#endif
 #if WASM_ENABLE_LIBC_WASI != 0
     libc_wasi_print_help();
 #endif
@@ -97,6 +111,8 @@ print_help()
 #endif
 #if WASM_ENABLE_LIB_PTHREAD != 0 || WASM_ENABLE_LIB_WASI_THREADS != 0
     printf("  --max-threads=n          Set maximum thread number per cluster, default is 4\n");
+    printf("  --thread-pool-size=n     Set maximum idle native threads kept to run the\n");
+    printf("                           spawned threads, default is 0 (disabled)\n");
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
     printf("  --timeout=ms             Set the maximum execution time in ms.\n");
@@ -109,6 +125,11 @@ print_help()
 #endif
 #if WASM_ENABLE_STATIC_PGO != 0
     printf("  --gen-prof-file=<path>   Generate LLVM PGO (Profile-Guided Optimization) profile file\n");
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    printf("  --sampling-profile=<path>\n");
+    printf("                           Sample the wasm call stacks and write them to the file\n");
+    printf("                           in the collapsed format of FlameGraph\n");
 #endif
     printf("  --version                Show version information\n");
     return 1;
@@ -565,7 +586,7 @@ int
 main(int argc, char *argv[])
 {
     int32 ret = -1;
-    int fd;
+    int fd = -1;
     struct stat sb;
     char *wasm_file = NULL;
     const char *func_name = NULL;
@@ -604,6 +625,13 @@ main(int argc, char *argv[])
 #if WASM_CONFIGURABLE_BOUNDS_CHECKS != 0
     bool disable_bounds_checks = false;
 #endif
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0 \
+    || WASM_ENABLE_FAST_INTERP_CACHE != 0 || WASM_ENABLE_AOT_SHARED_TEXT != 0
+    LoadArgs load_args = { 0 };
+#endif
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0
+    bool map_aot_file = false;
+#endif
 #if WASM_ENABLE_LIBC_WASI != 0
     libc_wasi_parse_context_t wasi_parse_ctx;
 #endif
@@ -620,9 +648,15 @@ main(int argc, char *argv[])
 #if WASM_ENABLE_STATIC_PGO != 0
     const char *gen_prof_file = NULL;
 #endif
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    const char *sampling_profile_file = NULL;
+#endif
 #if WASM_ENABLE_THREAD_MGR != 0
     int timeout_ms = -1;
 #endif
+#if WASM_ENABLE_LIB_PTHREAD != 0 || WASM_ENABLE_LIB_WASI_THREADS != 0
+    uint32 thread_pool_size = 0;
+#endif
 
 #if WASM_ENABLE_LIBC_WASI != 0
     memset(&wasi_parse_ctx, 0, sizeof(wasi_parse_ctx));
@@ -672,6 +706,23 @@ main(int argc, char *argv[])
         else if (!strcmp(argv[0], "--disable-bounds-checks")) {
             disable_bounds_checks = true;
         }
+#endif
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0
+        else if (!strcmp(argv[0], "--lazy-validation")) {
+            load_args.lazy_func_validation = true;
+        }
+#endif
+#if WASM_ENABLE_FAST_INTERP_CACHE != 0
+        else if (!strncmp(argv[0], "--fast-interp-cache=", 20)) {
+            if (argv[0][20] == '\0')
+                return print_help();
+            load_args.fast_interp_cache_dir = argv[0] + 20;
+        }
+#endif
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0
+        else if (!strcmp(argv[0], "--map-aot-file")) {
+            map_aot_file = true;
+        }
 #endif
         else if (!strncmp(argv[0], "--stack-size=", 13)) {
             if (argv[0][13] == '\0')
@@ -770,6 +821,11 @@ main(int argc, char *argv[])
                 return print_help();
             wasm_runtime_set_max_thread_num(atoi(argv[0] + 14));
         }
+        else if (!strncmp(argv[0], "--thread-pool-size=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            thread_pool_size = atoi(argv[0] + 19);
+        }
 #endif
 #if WASM_ENABLE_THREAD_MGR != 0
         else if (!strncmp(argv[0], "--timeout=", 10)) {
@@ -797,6 +853,13 @@ main(int argc, char *argv[])
                 return print_help();
             gen_prof_file = argv[0] + 16;
         }
+#endif
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+        else if (!strncmp(argv[0], "--sampling-profile=", 19)) {
+            if (argv[0][19] == '\0')
+                return print_help();
+            sampling_profile_file = argv[0] + 19;
+        }
 #endif
         else if (!strcmp(argv[0], "--version")) {
             uint32 major, minor, patch;
@@ -864,6 +927,9 @@ main(int argc, char *argv[])
 #if WASM_ENABLE_LINUX_PERF != 0
     init_args.enable_linux_perf = enable_linux_perf;
 #endif
+#if WASM_ENABLE_LIB_PTHREAD != 0 || WASM_ENABLE_LIB_WASI_THREADS != 0
+    init_args.thread_pool_size = thread_pool_size;
+#endif
 
 #if WASM_ENABLE_DEBUG_INTERP != 0
     init_args.instance_port = instance_port;
@@ -887,6 +953,17 @@ main(int argc, char *argv[])
         native_lib_list, native_lib_count, native_lib_loaded_list);
 #endif
 
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0
+    if (map_aot_file) {
+        /* The AOT file is mapped by the runtime instead of being read */
+        is_mapped_file = false;
+        load_args.name = "";
+        wasm_module = wasm_runtime_load_aot_file_mapped(
+            wasm_file, &load_args, error_buf, sizeof(error_buf));
+        goto check_module;
+    }
+#endif
+
     /* Try to open wasm_file by mmap */
 
     if ((fd = open(wasm_file, O_RDONLY)) < 0) {
@@ -930,8 +1007,21 @@ main(int argc, char *argv[])
 #endif
 
     /* load WASM module */
-    if (!(wasm_module = wasm_runtime_load(wasm_file_buf, wasm_file_size,
-                                          error_buf, sizeof(error_buf)))) {
+#if WASM_ENABLE_LAZY_FUNC_VALIDATION != 0 || WASM_ENABLE_FAST_INTERP_CACHE != 0
+    if (load_args.lazy_func_validation || load_args.fast_interp_cache_dir) {
+        load_args.name = "";
+        wasm_module = wasm_runtime_load_ex(wasm_file_buf, wasm_file_size,
+                                           &load_args, error_buf,
+                                           sizeof(error_buf));
+    }
+    else
+#endif
+        wasm_module = wasm_runtime_load(wasm_file_buf, wasm_file_size,
+                                        error_buf, sizeof(error_buf));
+#if WASM_ENABLE_AOT_SHARED_TEXT != 0
+check_module:
+#endif
+    if (!wasm_module) {
         printf("%s\n", error_buf);
         goto fail2;
     }
@@ -996,6 +1086,11 @@ main(int argc, char *argv[])
     }
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    if (sampling_profile_file && !wasm_runtime_set_sampling_profiling(true, 0))
+        printf("Failed to start sampling profiling\n");
+#endif
+
     ret = 0;
     const char *exception = NULL;
     if (is_repl_mode) {
@@ -1032,6 +1127,16 @@ main(int argc, char *argv[])
         dump_pgo_prof_data(wasm_module_inst, gen_prof_file);
 #endif
 
+#if WASM_ENABLE_SAMPLING_PROFILING != 0
+    if (sampling_profile_file) {
+        wasm_runtime_set_sampling_profiling(false, 0);
+        if (!wasm_runtime_dump_sampling_profile(wasm_module_inst,
+                                                sampling_profile_file))
+            printf("Failed to dump sampling profile to %s\n",
+                   sampling_profile_file);
+    }
+#endif
+
 #if WASM_ENABLE_THREAD_MGR != 0
     if (timeout_ms >= 0) {
         timeout_arg.cancel = true;
@@ -1053,11 +1158,14 @@ fail3:
     wasm_runtime_unload(wasm_module);
 
 fail2:
-    /* free the file buffer */
-    if (!is_mapped_file)
-        wasm_runtime_free(wasm_file_buf);
-    else
-        os_munmap(wasm_file_buf, wasm_file_size);
+    /* free the file buffer, which isn't read if the AOT file is mapped by
+       the runtime */
+    if (wasm_file_buf) {
+        if (!is_mapped_file)
+            wasm_runtime_free(wasm_file_buf);
+        else
+            os_munmap(wasm_file_buf, wasm_file_size);
+    }
 
 fail1:
 #if BH_HAS_DLFCN
@@ -1070,7 +1178,8 @@ fail1:
     wasm_runtime_destroy();
 
     /* close the file */
-    close(fd);
+    if (fd >= 0)
+        close(fd);
 
     return ret;
 }
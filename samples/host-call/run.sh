@@ -0,0 +1,3 @@
+#!/bin/bash
+
+out/host_call -f out/wasm-apps/testapp.wasm
@@ -0,0 +1,207 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <string.h>
+#include <time.h>
+
+#include "wasm_export.h"
+#include "bh_read_file.h"
+#include "bh_getopt.h"
+
+static void
+host_void(wasm_exec_env_t exec_env)
+{
+    (void)exec_env;
+}
+
+static int32_t
+host_ints(wasm_exec_env_t exec_env, int32_t a, int32_t b)
+{
+    return a + b;
+}
+
+static int32_t
+host_many_ints(wasm_exec_env_t exec_env, int32_t a, int32_t b, int32_t c,
+               int32_t d, int32_t e, int32_t f, int32_t g, int32_t h)
+{
+    return a + b + c + d + e + f + g + h;
+}
+
+static double
+host_floats(wasm_exec_env_t exec_env, float a, double b)
+{
+    return a + b;
+}
+
+static int32_t
+host_buf(wasm_exec_env_t exec_env, const char *buf, uint32_t len)
+{
+    return buf[0] == 'a' ? (int32_t)len : -1;
+}
+
+static int32_t
+host_str(wasm_exec_env_t exec_env, const char *str)
+{
+    return (int32_t)strlen(str);
+}
+
+/* clang-format off */
+static NativeSymbol native_symbols[] = {
+    { "host_void", host_void, "()", NULL },
+    { "host_ints", host_ints, "(ii)i", NULL },
+    { "host_many_ints", host_many_ints, "(iiiiiiii)i", NULL },
+    { "host_floats", host_floats, "(fF)F", NULL },
+    { "host_buf", host_buf, "(*~)i", NULL },
+    { "host_str", host_str, "($)i", NULL },
+};
+/* clang-format on */
+
+/* The wasm functions calling the natives in a loop, and the signature
+   shape of the natives */
+static const char *benchmarks[][2] = {
+    { "bench_void", "()" },
+    { "bench_ints", "(ii)i" },
+    { "bench_many_ints", "(iiiiiiii)i" },
+    { "bench_floats", "(fF)F" },
+    { "bench_buf", "(*~)i" },
+    { "bench_str", "($)i" },
+};
+
+void
+print_usage(void)
+{
+    fprintf(stdout, "Options:\r\n");
+    fprintf(stdout, "  -f [path of wasm file] \n");
+    fprintf(stdout, "  -n [host calls of each shape, default 10000000] \n");
+}
+
+static double
+now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Return the time of calling the wasm function with n in ns */
+static double
+run_func(wasm_module_inst_t module_inst, wasm_exec_env_t exec_env,
+         const char *name, uint32 n)
+{
+    wasm_function_inst_t func;
+    uint32 argv[1] = { n };
+    double begin;
+
+    if (!(func = wasm_runtime_lookup_function(module_inst, name))) {
+        printf("The wasm function %s is not found.\n", name);
+        return -1;
+    }
+
+    begin = now_ns();
+    if (!wasm_runtime_call_wasm(exec_env, func, 1, argv)) {
+        printf("call wasm function %s failed. error: %s\n", name,
+               wasm_runtime_get_exception(module_inst));
+        return -1;
+    }
+    return now_ns() - begin;
+}
+
+int
+main(int argc, char *argv_main[])
+{
+    char *buffer = NULL;
+    char error_buf[128];
+    int opt;
+    char *wasm_path = NULL;
+    uint32 buf_size, stack_size = 16 * 1024, heap_size = 0, n = 10000000, i;
+    double loop_time, time;
+
+    wasm_module_t module = NULL;
+    wasm_module_inst_t module_inst = NULL;
+    wasm_exec_env_t exec_env = NULL;
+
+    RuntimeInitArgs init_args;
+    memset(&init_args, 0, sizeof(RuntimeInitArgs));
+
+    while ((opt = getopt(argc, argv_main, "hf:n:")) != -1) {
+        switch (opt) {
+            case 'f':
+                wasm_path = optarg;
+                break;
+            case 'n':
+                n = (uint32)atoi(optarg);
+                break;
+            case 'h':
+                print_usage();
+                return 0;
+            case '?':
+                print_usage();
+                return 0;
+        }
+    }
+    if (optind == 1 || !wasm_path || n == 0) {
+        print_usage();
+        return 0;
+    }
+
+    init_args.mem_alloc_type = Alloc_With_System_Allocator;
+    init_args.native_module_name = "env";
+    init_args.n_native_symbols = sizeof(native_symbols) / sizeof(NativeSymbol);
+    init_args.native_symbols = native_symbols;
+
+    if (!wasm_runtime_full_init(&init_args)) {
+        printf("Init runtime environment failed.\n");
+        return -1;
+    }
+
+    buffer = bh_read_file_to_buffer(wasm_path, &buf_size);
+
+    if (!buffer) {
+        printf("Open wasm app file [%s] failed.\n", wasm_path);
+        goto fail;
+    }
+
+    module = wasm_runtime_load((uint8 *)buffer, buf_size, error_buf,
+                               sizeof(error_buf));
+    if (!module) {
+        printf("Load wasm module failed. error: %s\n", error_buf);
+        goto fail;
+    }
+
+    module_inst = wasm_runtime_instantiate(module, stack_size, heap_size,
+                                           error_buf, sizeof(error_buf));
+    if (!module_inst) {
+        printf("Instantiate wasm module failed. error: %s\n", error_buf);
+        goto fail;
+    }
+
+    exec_env = wasm_runtime_create_exec_env(module_inst, stack_size);
+    if (!exec_env) {
+        printf("Create wasm execution environment failed.\n");
+        goto fail;
+    }
+
+    if ((loop_time = run_func(module_inst, exec_env, "bench_loop", n)) < 0)
+        goto fail;
+
+    printf("%-12s %14s\n", "signature", "ns per call");
+    for (i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) {
+        if ((time = run_func(module_inst, exec_env, benchmarks[i][0], n)) < 0)
+            goto fail;
+        printf("%-12s %14.2f\n", benchmarks[i][1], (time - loop_time) / n);
+    }
+
+fail:
+    if (exec_env)
+        wasm_runtime_destroy_exec_env(exec_env);
+    if (module_inst)
+        wasm_runtime_deinstantiate(module_inst);
+    if (module)
+        wasm_runtime_unload(module);
+    if (buffer)
+        BH_FREE(buffer);
+    wasm_runtime_destroy();
+    return 0;
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <stdint.h>
+
+/* The natives registered by the host, one for each signature shape */
+void
+host_void(void);
+
+int32_t
+host_ints(int32_t a, int32_t b);
+
+int32_t
+host_many_ints(int32_t a, int32_t b, int32_t c, int32_t d, int32_t e,
+               int32_t f, int32_t g, int32_t h);
+
+double
+host_floats(float a, double b);
+
+int32_t
+host_buf(const char *buf, uint32_t len);
+
+int32_t
+host_str(const char *str);
+
+static char buf[64] = "a buffer checked by the runtime";
+
+/* The loop without any host call, to subtract its cost */
+uint32_t
+bench_loop(uint32_t n)
+{
+    uint32_t i, sum = 0;
+
+    for (i = 0; i < n; i++)
+        __asm__ volatile("" : "+r"(sum));
+    return sum;
+}
+
+uint32_t
+bench_void(uint32_t n)
+{
+    uint32_t i;
+
+    for (i = 0; i < n; i++)
+        host_void();
+    return n;
+}
+
+uint32_t
+bench_ints(uint32_t n)
+{
+    uint32_t i, sum = 0;
+
+    for (i = 0; i < n; i++)
+        sum += host_ints(i, 1);
+    return sum;
+}
+
+uint32_t
+bench_many_ints(uint32_t n)
+{
+    uint32_t i, sum = 0;
+
+    for (i = 0; i < n; i++)
+        sum += host_many_ints(i, 1, 2, 3, 4, 5, 6, 7);
+    return sum;
+}
+
+uint32_t
+bench_floats(uint32_t n)
+{
+    uint32_t i;
+    double sum = 0;
+
+    for (i = 0; i < n; i++)
+        sum += host_floats(1.5f, (double)i);
+    return (uint32_t)sum;
+}
+
+uint32_t
+bench_buf(uint32_t n)
+{
+    uint32_t i, sum = 0;
+
+    for (i = 0; i < n; i++)
+        sum += host_buf(buf, sizeof(buf));
+    return sum;
+}
+
+uint32_t
+bench_str(uint32_t n)
+{
+    uint32_t i, sum = 0;
+
+    for (i = 0; i < n; i++)
+        sum += host_str(buf);
+    return sum;
+}
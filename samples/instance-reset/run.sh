@@ -0,0 +1,3 @@
+#!/bin/bash
+
+out/instance_reset -f out/wasm-apps/testapp.wasm
@@ -0,0 +1,275 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <time.h>
+
+#include "wasm_export.h"
+#include "bh_read_file.h"
+#include "bh_getopt.h"
+
+static uint32 stack_size = 16 * 1024;
+
+void
+print_usage(void)
+{
+    fprintf(stdout, "Options:\r\n");
+    fprintf(stdout, "  -f [path of wasm file] \n");
+    fprintf(stdout, "  -n [iterations, default 1000] \n");
+    fprintf(stdout, "  -s [bytes touched by each request, default 16384] \n");
+}
+
+static double
+now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static bool
+call_func(wasm_module_inst_t module_inst, const char *name, uint32 argc,
+          uint32 argv[])
+{
+    wasm_function_inst_t func;
+    wasm_exec_env_t exec_env;
+
+    if (!(func = wasm_runtime_lookup_function(module_inst, name))) {
+        printf("The wasm function %s is not found.\n", name);
+        return false;
+    }
+    if (!(exec_env = wasm_runtime_get_exec_env_singleton(module_inst))) {
+        printf("Create wasm execution environment failed.\n");
+        return false;
+    }
+    if (!wasm_runtime_call_wasm(exec_env, func, argc, argv)) {
+        printf("call wasm function %s failed. error: %s\n", name,
+               wasm_runtime_get_exception(module_inst));
+        return false;
+    }
+    return true;
+}
+
+static wasm_module_inst_t
+instantiate(wasm_module_t module, bool enable_reset)
+{
+    InstantiationArgs args = { 0 };
+    wasm_module_inst_t module_inst;
+    char error_buf[128];
+
+    args.default_stack_size = stack_size;
+    args.enable_reset = enable_reset;
+
+    module_inst = wasm_runtime_instantiate_ex(module, &args, error_buf,
+                                              sizeof(error_buf));
+    if (!module_inst)
+        printf("Instantiate wasm module failed. error: %s\n", error_buf);
+    return module_inst;
+}
+
+/* Check that the state left by the requests is discarded by the reset */
+static bool
+check_reset(wasm_module_t module, uint32 touch_size)
+{
+    wasm_module_inst_t module_inst;
+    char error_buf[128];
+    uint32 argv[1], init_pages;
+    bool ret = false;
+
+    if (!(module_inst = instantiate(module, true)))
+        return false;
+
+    argv[0] = 0;
+    if (!call_func(module_inst, "grow", 1, argv))
+        goto fail;
+    init_pages = argv[0];
+
+    argv[0] = touch_size;
+    if (!call_func(module_inst, "handle", 1, argv))
+        goto fail;
+    argv[0] = 4;
+    if (!call_func(module_inst, "grow", 1, argv))
+        goto fail;
+
+    if (!wasm_runtime_instance_reset(module_inst, false, error_buf,
+                                     sizeof(error_buf))) {
+        printf("Reset instance failed. error: %s\n", error_buf);
+        goto fail;
+    }
+
+    argv[0] = touch_size;
+    if (!call_func(module_inst, "handle", 1, argv))
+        goto fail;
+    bh_assert(argv[0] == 1);
+    argv[0] = 0;
+    if (!call_func(module_inst, "grow", 1, argv))
+        goto fail;
+    bh_assert(argv[0] == init_pages);
+    printf("memory pages after reset: %u\n", argv[0]);
+
+    if (!wasm_runtime_instance_reset(module_inst, false, error_buf,
+                                     sizeof(error_buf))) {
+        printf("Reset instance failed. error: %s\n", error_buf);
+        goto fail;
+    }
+    if (!call_func(module_inst, "first_char", 0, argv))
+        goto fail;
+    bh_assert(argv[0] == 'h');
+    printf("first char after reset: %c\n", (char)argv[0]);
+    ret = true;
+
+fail:
+    wasm_runtime_deinstantiate(module_inst);
+    return ret;
+}
+
+static bool
+benchmark_instantiate(wasm_module_t module, uint32 touch_size,
+                      int iterations)
+{
+    wasm_module_inst_t module_inst;
+    uint32 argv[1];
+    double begin, elapsed;
+    int i;
+
+    begin = now_us();
+    for (i = 0; i < iterations; i++) {
+        if (!(module_inst = instantiate(module, false)))
+            return false;
+
+        argv[0] = touch_size;
+        if (!call_func(module_inst, "handle", 1, argv)) {
+            wasm_runtime_deinstantiate(module_inst);
+            return false;
+        }
+        wasm_runtime_deinstantiate(module_inst);
+    }
+    elapsed = now_us() - begin;
+
+    printf("%-34s %10.2f us %12.0f req/s\n", "instantiate per request:",
+           elapsed / iterations, iterations * 1e6 / elapsed);
+    return true;
+}
+
+static bool
+benchmark_pool(wasm_module_t module, uint32 touch_size, int iterations)
+{
+    InstantiationArgs args = { 0 };
+    wasm_instance_pool_t pool;
+    wasm_module_inst_t module_inst;
+    char error_buf[128];
+    uint32 argv[1];
+    double begin, elapsed;
+    bool ret = false;
+    int i;
+
+    args.default_stack_size = stack_size;
+    if (!(pool = wasm_runtime_create_instance_pool(module, &args, 4, false,
+                                                   error_buf,
+                                                   sizeof(error_buf)))) {
+        printf("Create instance pool failed. error: %s\n", error_buf);
+        return false;
+    }
+
+    begin = now_us();
+    for (i = 0; i < iterations; i++) {
+        if (!(module_inst = wasm_runtime_instance_pool_acquire(pool)))
+            goto fail;
+
+        argv[0] = touch_size;
+        if (!call_func(module_inst, "handle", 1, argv)) {
+            wasm_runtime_instance_pool_release(pool, module_inst);
+            goto fail;
+        }
+        bh_assert(argv[0] == 1);
+
+        if (!wasm_runtime_instance_pool_release(pool, module_inst))
+            goto fail;
+    }
+    elapsed = now_us() - begin;
+
+    printf("%-34s %10.2f us %12.0f req/s\n",
+           "reset pooled instance per request:", elapsed / iterations,
+           iterations * 1e6 / elapsed);
+    ret = true;
+
+fail:
+    wasm_runtime_destroy_instance_pool(pool);
+    return ret;
+}
+
+int
+main(int argc, char *argv_main[])
+{
+    char *buffer = NULL;
+    char error_buf[128];
+    int opt, iterations = 1000;
+    char *wasm_path = NULL;
+    uint32 buf_size, touch_size = 16 * 1024;
+
+    wasm_module_t module = NULL;
+
+    RuntimeInitArgs init_args;
+    memset(&init_args, 0, sizeof(RuntimeInitArgs));
+
+    while ((opt = getopt(argc, argv_main, "hf:n:s:")) != -1) {
+        switch (opt) {
+            case 'f':
+                wasm_path = optarg;
+                break;
+            case 'n':
+                iterations = atoi(optarg);
+                break;
+            case 's':
+                touch_size = (uint32)atoi(optarg);
+                break;
+            case 'h':
+                print_usage();
+                return 0;
+            case '?':
+                print_usage();
+                return 0;
+        }
+    }
+    if (optind == 1 || !wasm_path || iterations <= 0) {
+        print_usage();
+        return 0;
+    }
+
+    init_args.mem_alloc_type = Alloc_With_System_Allocator;
+
+    if (!wasm_runtime_full_init(&init_args)) {
+        printf("Init runtime environment failed.\n");
+        return -1;
+    }
+
+    buffer = bh_read_file_to_buffer(wasm_path, &buf_size);
+
+    if (!buffer) {
+        printf("Open wasm app file [%s] failed.\n", wasm_path);
+        goto fail;
+    }
+
+    module = wasm_runtime_load((uint8 *)buffer, buf_size, error_buf,
+                               sizeof(error_buf));
+    if (!module) {
+        printf("Load wasm module failed. error: %s\n", error_buf);
+        goto fail;
+    }
+
+    if (!check_reset(module, touch_size))
+        goto fail;
+
+    if (!benchmark_instantiate(module, touch_size, iterations)
+        || !benchmark_pool(module, touch_size, iterations))
+        goto fail;
+
+fail:
+    if (module)
+        wasm_runtime_unload(module);
+    if (buffer)
+        BH_FREE(buffer);
+    wasm_runtime_destroy();
+    return 0;
+}
@@ -0,0 +1,48 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <stdint.h>
+
+#define SCRATCH_SIZE (64 * 1024)
+
+/* Initialized by the data segment */
+static char greeting[32] = "hello";
+
+/* Zero after instantiation */
+static uint32_t request_count;
+static uint8_t scratch[SCRATCH_SIZE];
+
+/* Handle a request which touches size bytes of the memory, returns the
+   number of requests handled by the instance, which is always 1 if the
+   instance is reset after each request */
+uint32_t
+handle(uint32_t size)
+{
+    uint32_t i, sum = 0;
+
+    if (size > SCRATCH_SIZE)
+        size = SCRATCH_SIZE;
+    for (i = 0; i < size; i++) {
+        scratch[i] = (uint8_t)(greeting[i % 5] + i);
+        sum += scratch[i];
+    }
+
+    /* Leave the state dirty, as a request leaking its changes would */
+    greeting[0] = (char)sum;
+    return ++request_count;
+}
+
+/* Grow the memory by pages, which is undone by the reset */
+uint32_t
+grow(uint32_t pages)
+{
+    return (uint32_t)__builtin_wasm_memory_grow(0, pages);
+}
+
+uint32_t
+first_char(void)
+{
+    return (uint32_t)greeting[0];
+}
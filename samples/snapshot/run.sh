@@ -0,0 +1,3 @@
+#!/bin/bash
+
+out/snapshot -f out/wasm-apps/testapp.wasm
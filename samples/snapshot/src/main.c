@@ -0,0 +1,212 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <time.h>
+
+#include "wasm_export.h"
+#include "bh_read_file.h"
+#include "bh_getopt.h"
+
+static uint32 stack_size = 16 * 1024;
+
+void
+print_usage(void)
+{
+    fprintf(stdout, "Options:\r\n");
+    fprintf(stdout, "  -f [path of wasm file] \n");
+    fprintf(stdout, "  -n [iterations, default 1000] \n");
+}
+
+static double
+now_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static bool
+call_func(wasm_module_inst_t module_inst, const char *name, uint32 argc,
+          uint32 argv[])
+{
+    wasm_function_inst_t func;
+    wasm_exec_env_t exec_env;
+
+    if (!(func = wasm_runtime_lookup_function(module_inst, name))) {
+        printf("The wasm function %s is not found.\n", name);
+        return false;
+    }
+    if (!(exec_env = wasm_runtime_get_exec_env_singleton(module_inst))) {
+        printf("Create wasm execution environment failed.\n");
+        return false;
+    }
+    if (!wasm_runtime_call_wasm(exec_env, func, argc, argv)) {
+        printf("call wasm function %s failed. error: %s\n", name,
+               wasm_runtime_get_exception(module_inst));
+        return false;
+    }
+    return true;
+}
+
+/* Instantiate the module and run the init function, either normally or
+   from the snapshot */
+static wasm_module_inst_t
+instantiate(wasm_module_t module, bool enable_snapshot)
+{
+    InstantiationArgs args = { 0 };
+    wasm_module_inst_t module_inst;
+    char error_buf[128];
+
+    args.default_stack_size = stack_size;
+    args.enable_snapshot = enable_snapshot;
+    args.snapshot_init_func = "init";
+
+    module_inst = wasm_runtime_instantiate_ex(module, &args, error_buf,
+                                              sizeof(error_buf));
+    if (!module_inst) {
+        printf("Instantiate wasm module failed. error: %s\n", error_buf);
+        return NULL;
+    }
+
+    if (!enable_snapshot && !call_func(module_inst, "init", 0, NULL)) {
+        wasm_runtime_deinstantiate(module_inst);
+        return NULL;
+    }
+    return module_inst;
+}
+
+static bool
+benchmark(wasm_module_t module, bool enable_snapshot, int iterations)
+{
+    wasm_module_inst_t module_inst;
+    uint32 argv[2];
+    double begin;
+    int i;
+
+    begin = now_us();
+    for (i = 0; i < iterations; i++) {
+        if (!(module_inst = instantiate(module, enable_snapshot)))
+            return false;
+
+        /* Dirty a page so that the copy-on-write is measured too */
+        argv[0] = (uint32)i;
+        argv[1] = 0;
+        if (!call_func(module_inst, "update", 2, argv)) {
+            wasm_runtime_deinstantiate(module_inst);
+            return false;
+        }
+        wasm_runtime_deinstantiate(module_inst);
+    }
+
+    printf("%-28s %10.2f us\n",
+           enable_snapshot ? "instantiate from snapshot:"
+                           : "instantiate and run init:",
+           (now_us() - begin) / iterations);
+    return true;
+}
+
+int
+main(int argc, char *argv_main[])
+{
+    char *buffer = NULL;
+    char error_buf[128];
+    int opt, iterations = 1000;
+    char *wasm_path = NULL;
+    uint32 buf_size, argv[1], expected;
+
+    wasm_module_t module = NULL;
+    wasm_module_inst_t inst1 = NULL, inst2 = NULL;
+
+    RuntimeInitArgs init_args;
+    memset(&init_args, 0, sizeof(RuntimeInitArgs));
+
+    while ((opt = getopt(argc, argv_main, "hf:n:")) != -1) {
+        switch (opt) {
+            case 'f':
+                wasm_path = optarg;
+                break;
+            case 'n':
+                iterations = atoi(optarg);
+                break;
+            case 'h':
+                print_usage();
+                return 0;
+            case '?':
+                print_usage();
+                return 0;
+        }
+    }
+    if (optind == 1 || !wasm_path || iterations <= 0) {
+        print_usage();
+        return 0;
+    }
+
+    init_args.mem_alloc_type = Alloc_With_System_Allocator;
+
+    if (!wasm_runtime_full_init(&init_args)) {
+        printf("Init runtime environment failed.\n");
+        return -1;
+    }
+
+    buffer = bh_read_file_to_buffer(wasm_path, &buf_size);
+
+    if (!buffer) {
+        printf("Open wasm app file [%s] failed.\n", wasm_path);
+        goto fail;
+    }
+
+    module = wasm_runtime_load((uint8 *)buffer, buf_size, error_buf,
+                               sizeof(error_buf));
+    if (!module) {
+        printf("Load wasm module failed. error: %s\n", error_buf);
+        goto fail;
+    }
+
+    /* The instances created from the snapshot see the state left by the
+       init function, and don't see the changes of each other */
+    if (!(inst1 = instantiate(module, true))
+        || !(inst2 = instantiate(module, false)))
+        goto fail;
+
+    argv[0] = 7;
+    if (!call_func(inst2, "lookup", 1, argv))
+        goto fail;
+    expected = argv[0];
+
+    argv[0] = 7;
+    if (!call_func(inst1, "lookup", 1, argv))
+        goto fail;
+    bh_assert(argv[0] == expected);
+
+    wasm_runtime_deinstantiate(inst2);
+    inst2 = NULL;
+
+    uint32 argv2[2] = { 7, 0 };
+    if (!call_func(inst1, "update", 2, argv2)
+        || !(inst2 = instantiate(module, true)))
+        goto fail;
+
+    argv[0] = 7;
+    if (!call_func(inst2, "lookup", 1, argv))
+        goto fail;
+    bh_assert(argv[0] == expected);
+    printf("lookup(7) of the instance from snapshot: 0x%08x\n", argv[0]);
+
+    if (!benchmark(module, false, iterations)
+        || !benchmark(module, true, iterations))
+        goto fail;
+
+fail:
+    if (inst2)
+        wasm_runtime_deinstantiate(inst2);
+    if (inst1)
+        wasm_runtime_deinstantiate(inst1);
+    if (module)
+        wasm_runtime_unload(module);
+    if (buffer)
+        BH_FREE(buffer);
+    wasm_runtime_destroy();
+    return 0;
+}
@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2019 Intel Corporation.  All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include <stdint.h>
+
+#define TABLE_SIZE (64 * 1024)
+
+/* Initialized by the data segment */
+static uint32_t seeds[4096] = { 1, 2, 3, 5, 8, 13, 21, 34, 55, 89 };
+
+/* Initialized by the init function, which is expensive */
+static uint32_t table[TABLE_SIZE];
+
+void
+init(void)
+{
+    uint32_t i, x = 2166136261u;
+
+    for (i = 0; i < TABLE_SIZE; i++) {
+        x = (x ^ seeds[i % 10]) * 16777619u;
+        table[i] = x;
+    }
+}
+
+uint32_t
+lookup(uint32_t i)
+{
+    return table[i % TABLE_SIZE];
+}
+
+void
+update(uint32_t i, uint32_t value)
+{
+    table[i % TABLE_SIZE] = value;
+}
@@ -9,6 +9,14 @@ OUT_DIR=$PWD/out
 WAMRC_CMD=$PWD/../../../wamr-compiler/build/wamrc
 POLYBENCH_CASES="datamining linear-algebra medley stencils"
 
+# Build the wasm files with the SIMD auto-vectorization, which can be run
+# by both the AOT mode and the fast interpreter
+if [[ $1 == "--simd" ]]; then
+    WASM_SIMD_FLAGS="-msimd128"
+else
+    WASM_SIMD_FLAGS=""
+fi
+
 if [ ! -d PolyBenchC-4.2.1 ]; then
     git clone https://github.com/MatthiasJReisinger/PolyBenchC-4.2.1.git
 fi
@@ -32,7 +40,8 @@ do
                 -DPOLYBENCH_TIME -lm -o ${OUT_DIR}/${file_name%.*}_native
 
         echo "Build ${file_name%.*}.wasm"
-        /opt/wasi-sdk/bin/clang -O3 -I utilities -I ${file%/*}      \
+        /opt/wasi-sdk/bin/clang -O3 ${WASM_SIMD_FLAGS}              \
+                -I utilities -I ${file%/*}                          \
                 utilities/polybench.c ${file}                       \
                 -Wl,--export=__heap_base -Wl,--export=__data_end    \
                 -Wl,--export=malloc -Wl,--export=free               \
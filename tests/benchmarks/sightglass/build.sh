@@ -11,6 +11,14 @@ SHOOTOUT_CASES="base64 fib2 gimli heapsort matrix memmove nestedloop \
                 nestedloop2 nestedloop3 random seqhash sieve strchr \
                 switch2"
 
+# Build the wasm files with the SIMD auto-vectorization, which can be run
+# by both the AOT mode and the fast interpreter
+if [[ $1 == "--simd" ]]; then
+    WASM_SIMD_FLAGS="-msimd128"
+else
+    WASM_SIMD_FLAGS=""
+fi
+
 if [ ! -d sightglass ]; then
     git clone https://github.com/wasm-micro-runtime/sightglass.git
 fi
@@ -26,7 +34,7 @@ do
         -I../../include ${bench}.c main/main_${bench}.c main/my_libc.c
 
     echo "Build ${bench}.wasm"
-    /opt/wasi-sdk/bin/clang -O3 -nostdlib \
+    /opt/wasi-sdk/bin/clang -O3 -nostdlib ${WASM_SIMD_FLAGS} \
         -Wno-unknown-attributes \
         -Dblack_box=set_res \
         -I../../include -DNOSTDLIB_MODE \
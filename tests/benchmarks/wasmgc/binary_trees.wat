@@ -0,0 +1,43 @@
+;; Copyright (C) 2019 Intel Corporation.  All rights reserved.
+;; SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+;; Keep a long-lived tree of depth 16 and build n short-lived trees of
+;; depth 10, most of the objects die young
+(module
+  (type $node (struct (field $left (ref null $node))
+                      (field $right (ref null $node))))
+
+  (func $make (param $depth i32) (result (ref null $node))
+    (if (result (ref null $node)) (i32.eqz (local.get $depth))
+      (then
+        (struct.new $node (ref.null $node) (ref.null $node)))
+      (else
+        (struct.new $node
+          (call $make (i32.sub (local.get $depth) (i32.const 1)))
+          (call $make (i32.sub (local.get $depth) (i32.const 1)))))))
+
+  (func $check (param $tree (ref null $node)) (result i32)
+    (if (result i32) (ref.is_null (struct.get $node $left (local.get $tree)))
+      (then
+        (i32.const 1))
+      (else
+        (i32.add
+          (i32.add
+            (i32.const 1)
+            (call $check (struct.get $node $left (local.get $tree))))
+          (call $check (struct.get $node $right (local.get $tree)))))))
+
+  (func (export "run") (param $n i32) (result i32)
+    (local $long (ref null $node))
+    (local $i i32)
+    (local $sum i32)
+    (local.set $long (call $make (i32.const 16)))
+    (loop $iter
+      (local.set $sum
+        (i32.add (local.get $sum)
+                 (call $check (call $make (i32.const 10)))))
+      (br_if $iter
+        (i32.lt_s (local.tee $i (i32.add (local.get $i) (i32.const 1)))
+                  (local.get $n))))
+    (i32.add (local.get $sum) (call $check (local.get $long))))
+)
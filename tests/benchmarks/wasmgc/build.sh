@@ -0,0 +1,26 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+OUT_DIR=$PWD/out
+WAMRC_CMD=$PWD/../../../wamr-compiler/build/wamrc
+WASMGC_CASES="binary_trees list_update"
+
+mkdir -p ${OUT_DIR}
+
+for case in $WASMGC_CASES
+do
+    echo "Build ${case}.wasm"
+    wasm-tools parse ${case}.wat -o ${OUT_DIR}/${case}.wasm
+
+    echo "Compile ${case}.wasm into ${case}.aot"
+    ${WAMRC_CMD} --enable-gc -o ${OUT_DIR}/${case}.aot \
+            ${OUT_DIR}/${case}.wasm
+
+    echo "Compile ${case}.wasm into ${case}_wb.aot"
+    ${WAMRC_CMD} --enable-gc --enable-gc-write-barrier \
+            -o ${OUT_DIR}/${case}_wb.aot ${OUT_DIR}/${case}.wasm
+done
+
+echo "Done"
@@ -0,0 +1,54 @@
+;; Copyright (C) 2019 Intel Corporation.  All rights reserved.
+;; SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+;; Insert n nodes into 1024 long-lived lists, each new node is linked
+;; after the old head of its list with struct.set, so that old objects
+;; keep referring to young ones, and a short-lived object is allocated
+;; for each node. Returns the sum of the values of all nodes.
+(module
+  (type $node (struct (field $val (mut i32))
+                      (field $next (mut (ref null $node)))))
+  (type $heads (array (mut (ref null $node))))
+
+  (func (export "run") (param $n i32) (result i32)
+    (local $heads (ref null $heads))
+    (local $node (ref null $node))
+    (local $head (ref null $node))
+    (local $i i32)
+    (local $j i32)
+    (local $sum i32)
+    (local.set $heads (array.new_default $heads (i32.const 1024)))
+    (loop $insert
+      (local.set $node (struct.new $node (local.get $i) (ref.null $node)))
+      (drop (struct.new_default $node))
+      (local.set $head
+        (array.get $heads (local.get $heads)
+                   (i32.and (local.get $i) (i32.const 1023))))
+      (if (ref.is_null (local.get $head))
+        (then
+          (array.set $heads (local.get $heads)
+                     (i32.and (local.get $i) (i32.const 1023))
+                     (local.get $node)))
+        (else
+          (struct.set $node $next (local.get $node)
+                      (struct.get $node $next (local.get $head)))
+          (struct.set $node $next (local.get $head) (local.get $node))))
+      (br_if $insert
+        (i32.lt_s (local.tee $i (i32.add (local.get $i) (i32.const 1)))
+                  (local.get $n))))
+    (block $done
+      (loop $lists
+        (br_if $done (i32.ge_s (local.get $j) (i32.const 1024)))
+        (local.set $node (array.get $heads (local.get $heads) (local.get $j)))
+        (block $end
+          (loop $walk
+            (br_if $end (ref.is_null (local.get $node)))
+            (local.set $sum
+              (i32.add (local.get $sum)
+                       (struct.get $node $val (local.get $node))))
+            (local.set $node (struct.get $node $next (local.get $node)))
+            (br $walk)))
+        (local.set $j (i32.add (local.get $j) (i32.const 1)))
+        (br $lists)))
+    (local.get $sum))
+)
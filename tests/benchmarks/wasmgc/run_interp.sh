@@ -0,0 +1,53 @@
+#!/bin/bash
+
+# Copyright (C) 2019 Intel Corporation.  All rights reserved.
+# SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+CUR_DIR=$PWD
+OUT_DIR=$CUR_DIR/out
+REPORT=$CUR_DIR/report.txt
+TIME=/usr/bin/time
+
+PLATFORM=$(uname -s | tr A-Z a-z)
+IWASM_CMD=${IWASM_CMD:-$CUR_DIR/../../../product-mini/platforms/${PLATFORM}/build/iwasm}
+
+BENCH_NAME_MAX_LEN=20
+GC_HEAP_SIZE=8388608
+
+# The case name and the argument passed to its "run" function
+WASMGC_CASES="binary_trees:500 list_update:300000"
+
+rm -f $REPORT
+touch $REPORT
+
+function print_bench_name()
+{
+    name=$1
+    echo -en "$name" >> $REPORT
+    name_len=${#name}
+    if [ $name_len -lt $BENCH_NAME_MAX_LEN ]
+    then
+        spaces=$(( $BENCH_NAME_MAX_LEN - $name_len ))
+        for i in $(eval echo "{1..$spaces}"); do echo -n " " >> $REPORT; done
+    fi
+}
+
+echo "Start to run cases, the result is written to report.txt"
+
+#run benchmarks
+cd $OUT_DIR
+echo -en "\t\t    iwasm-interp\n" >> $REPORT
+
+for c in $WASMGC_CASES
+do
+    t=${c%:*}
+    arg=${c#*:}
+    print_bench_name $t
+
+    echo "run $t with iwasm interp .."
+    echo -en "\t" >> $REPORT
+    $TIME -f "real-%e-time" $IWASM_CMD --gc-heap-size=${GC_HEAP_SIZE} \
+        -f run ${t}.wasm ${arg} 2>&1 | grep "real-.*-time" | awk -F '-' '{ORS=""; print $2}' >> $REPORT
+
+    echo -en "\n" >> $REPORT
+done
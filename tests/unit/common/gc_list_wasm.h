@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/* A linked list of GC structs, whose nodes are replaced by copies while
+   garbage is allocated, so that the collections run while the references
+   between the live objects change:
+     (module
+       (type $node (struct (field (mut i32)) (field (mut (ref null $node)))))
+       (global $head (mut (ref null $node)) (ref.null $node))
+       (global $cursor (mut (ref null $node)) (ref.null $node))
+       ;; build the list of the values n, ..., 1
+       (func (export "build") (param $n i32)
+         (block
+           (loop
+             (br_if 1 (i32.eqz (local.get $n)))
+             (global.set $head
+               (struct.new $node (local.get $n) (global.get $head)))
+             (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+             (br 0)))
+         (global.set $cursor (ref.null $node)))
+       ;; return the sum of the values of the list
+       (func (export "sum") (result i32)
+         (local $p (ref null $node)) (local $s i32)
+         (local.set $p (global.get $head))
+         (block
+           (loop
+             (br_if 1 (ref.is_null (local.get $p)))
+             (local.set $s (i32.add (local.get $s)
+                                    (struct.get $node 0 (local.get $p))))
+             (local.set $p (struct.get $node 1 (local.get $p)))
+             (br 0)))
+         (local.get $s))
+       ;; replace the k nodes after the cursor with copies, the cursor
+       ;; moves to the copy and wraps around at the end of the list
+       (func (export "churn") (param $k i32)
+         (local $cur (ref null $node)) (local $next (ref null $node))
+         (block
+           (loop
+             (br_if 1 (i32.eqz (local.get $k)))
+             (local.set $cur (global.get $cursor))
+             (if (ref.is_null (local.get $cur))
+               (then (local.set $cur (global.get $head))))
+             (local.set $next (struct.get $node 1 (local.get $cur)))
+             (if (ref.is_null (local.get $next))
+               (then (global.set $cursor (global.get $head)))
+               (else
+                 (struct.set $node 1 (local.get $cur)
+                   (struct.new $node (struct.get $node 0 (local.get $next))
+                                     (struct.get $node 1 (local.get $next))))
+                 (global.set $cursor (struct.get $node 1 (local.get $cur)))))
+             (drop (struct.new $node (local.get $k) (ref.null $node)))
+             (drop (struct.new $node (local.get $k) (global.get $head)))
+             (local.set $k (i32.sub (local.get $k) (i32.const 1)))
+             (br 0))))
+     ) */
+static uint8_t gc_list_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x10, 0x03, 0x5f,
+    0x02, 0x7f, 0x01, 0x63, 0x00, 0x01, 0x60, 0x01, 0x7f, 0x00, 0x60, 0x00,
+    0x01, 0x7f, 0x03, 0x04, 0x03, 0x01, 0x02, 0x01, 0x06, 0x0d, 0x02, 0x63,
+    0x00, 0x01, 0xd0, 0x00, 0x0b, 0x63, 0x00, 0x01, 0xd0, 0x00, 0x0b, 0x07,
+    0x17, 0x03, 0x05, 0x62, 0x75, 0x69, 0x6c, 0x64, 0x00, 0x00, 0x03, 0x73,
+    0x75, 0x6d, 0x00, 0x01, 0x05, 0x63, 0x68, 0x75, 0x72, 0x6e, 0x00, 0x02,
+    0x0a, 0xbb, 0x01, 0x03, 0x23, 0x00, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00,
+    0x45, 0x0d, 0x01, 0x20, 0x00, 0x23, 0x00, 0xfb, 0x00, 0x00, 0x24, 0x00,
+    0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0xd0,
+    0x00, 0x24, 0x01, 0x0b, 0x2d, 0x02, 0x01, 0x63, 0x00, 0x01, 0x7f, 0x23,
+    0x00, 0x21, 0x00, 0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0xd1, 0x0d, 0x01,
+    0x20, 0x01, 0x20, 0x00, 0xfb, 0x02, 0x00, 0x00, 0x6a, 0x21, 0x01, 0x20,
+    0x00, 0xfb, 0x02, 0x00, 0x01, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x20,
+    0x01, 0x0b, 0x67, 0x01, 0x02, 0x63, 0x00, 0x02, 0x40, 0x03, 0x40, 0x20,
+    0x00, 0x45, 0x0d, 0x01, 0x23, 0x01, 0x21, 0x01, 0x20, 0x01, 0xd1, 0x04,
+    0x40, 0x23, 0x00, 0x21, 0x01, 0x0b, 0x20, 0x01, 0xfb, 0x02, 0x00, 0x01,
+    0x21, 0x02, 0x20, 0x02, 0xd1, 0x04, 0x40, 0x23, 0x00, 0x24, 0x01, 0x05,
+    0x20, 0x01, 0x20, 0x02, 0xfb, 0x02, 0x00, 0x00, 0x20, 0x02, 0xfb, 0x02,
+    0x00, 0x01, 0xfb, 0x00, 0x00, 0xfb, 0x05, 0x00, 0x01, 0x20, 0x01, 0xfb,
+    0x02, 0x00, 0x01, 0x24, 0x01, 0x0b, 0x20, 0x00, 0xd0, 0x00, 0xfb, 0x00,
+    0x00, 0x1a, 0x20, 0x00, 0x23, 0x00, 0xfb, 0x00, 0x00, 0x1a, 0x20, 0x00,
+    0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c, 0x00, 0x0b, 0x0b, 0x0b,
+};
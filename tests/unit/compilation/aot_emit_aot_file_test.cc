@@ -102,3 +102,76 @@ TEST_F(aot_emit_aot_file_test_suite, aot_emit_aot_file)
 
     EXPECT_EQ(false, aot_emit_aot_file(comp_ctx, comp_data, nullptr));
 }
+
+static uint8 *
+emit_aot_file_buf(wasm_module_t wasm_module, uint32 thread_num,
+                  uint32 *p_aot_file_size)
+{
+    aot_comp_data_t comp_data = nullptr;
+    aot_comp_context_t comp_ctx = nullptr;
+    AOTCompOption option = { 0 };
+    uint8 *aot_file_buf = nullptr;
+
+    option.opt_level = 3;
+    option.size_level = 3;
+    option.output_format = AOT_FORMAT_FILE;
+    /* default value, enable or disable depends on the platform */
+    option.bounds_checks = 2;
+    option.thread_num = thread_num;
+
+    comp_data = aot_create_comp_data(wasm_module, NULL, false);
+    EXPECT_NE(nullptr, comp_data);
+    comp_ctx = aot_create_comp_context(comp_data, &option);
+    EXPECT_NE(comp_ctx, nullptr);
+
+    if (comp_ctx && aot_compile_wasm(comp_ctx))
+        aot_file_buf =
+            aot_emit_aot_file_buf(comp_ctx, comp_data, p_aot_file_size);
+
+    if (comp_ctx)
+        aot_destroy_comp_context(comp_ctx);
+    if (comp_data)
+        aot_destroy_comp_data(comp_data);
+    return aot_file_buf;
+}
+
+TEST_F(aot_emit_aot_file_test_suite, aot_emit_aot_file_threads)
+{
+#if !defined(BUILD_TARGET_X86_64) && !defined(BUILD_TARGET_AMD_64)
+    GTEST_SKIP() << "multi-threaded compilation only supports x86_64";
+#endif
+    unsigned int wasm_file_size = 0;
+    unsigned char *wasm_file_buf = nullptr;
+    char error_buf[128] = { 0 };
+    wasm_module_t wasm_module = nullptr;
+    uint8 *expected_buf, *aot_file_buf;
+    uint32 expected_size = 0, aot_file_size, thread_num;
+
+    wasm_file_buf =
+        (unsigned char *)bh_read_file_to_buffer(WASM_FILE, &wasm_file_size);
+    ASSERT_NE(wasm_file_buf, nullptr);
+    wasm_module = wasm_runtime_load(wasm_file_buf, wasm_file_size, error_buf,
+                                    sizeof(error_buf));
+    ASSERT_NE(wasm_module, nullptr) << error_buf;
+
+    expected_buf = emit_aot_file_buf(wasm_module, 1, &expected_size);
+    ASSERT_NE(expected_buf, nullptr);
+
+    /* The output must be identical to the single-threaded one, whether
+       the functions are split or compiled serially as a fallback */
+    for (thread_num = 2; thread_num <= 8; thread_num *= 2) {
+        aot_file_size = 0;
+        aot_file_buf = emit_aot_file_buf(wasm_module, thread_num,
+                                         &aot_file_size);
+        ASSERT_NE(aot_file_buf, nullptr) << aot_get_last_error();
+        EXPECT_EQ(aot_file_size, expected_size);
+        EXPECT_TRUE(aot_file_size == expected_size
+                    && !memcmp(aot_file_buf, expected_buf, aot_file_size))
+            << "thread_num: " << thread_num;
+        wasm_runtime_free(aot_file_buf);
+    }
+
+    wasm_runtime_free(expected_buf);
+    wasm_runtime_unload(wasm_module);
+    BH_FREE(wasm_file_buf);
+}
@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "wasm_export.h"
+#include "thread_manager.h"
+
+/* (module
+     (memory (export "memory") 1)
+     ;; the aux stack top, __data_end and __heap_base, which are required
+     ;; to spawn exec_envs
+     (global (mut i32) (i32.const 32768))
+     (global (export "__data_end") i32 (i32.const 1024))
+     (global (export "__heap_base") i32 (i32.const 32768))
+     (func (export "get") (result i32) (i32.const 42))
+   ) */
+static uint8_t registry_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+    0x00, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x05, 0x03, 0x01, 0x00, 0x01,
+    0x06, 0x15, 0x03, 0x7f, 0x01, 0x41, 0x80, 0x80, 0x02, 0x0b, 0x7f, 0x00,
+    0x41, 0x80, 0x08, 0x0b, 0x7f, 0x00, 0x41, 0x80, 0x80, 0x02, 0x0b, 0x07,
+    0x2b, 0x04, 0x03, 0x67, 0x65, 0x74, 0x00, 0x00, 0x06, 0x6d, 0x65, 0x6d,
+    0x6f, 0x72, 0x79, 0x02, 0x00, 0x0a, 0x5f, 0x5f, 0x64, 0x61, 0x74, 0x61,
+    0x5f, 0x65, 0x6e, 0x64, 0x03, 0x01, 0x0b, 0x5f, 0x5f, 0x68, 0x65, 0x61,
+    0x70, 0x5f, 0x62, 0x61, 0x73, 0x65, 0x03, 0x02, 0x0a, 0x06, 0x01, 0x04,
+    0x00, 0x41, 0x2a, 0x0b,
+};
+
+class ExecEnvRegistryTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        char error_buf[128] = { 0 };
+
+        wasm_buf.assign(registry_wasm, registry_wasm + sizeof(registry_wasm));
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+
+        module_inst = wasm_runtime_instantiate(module, 16 * 1024, 0,
+                                               error_buf, sizeof(error_buf));
+        ASSERT_NE(module_inst, nullptr) << error_buf;
+
+        exec_env = wasm_runtime_create_exec_env(module_inst, 16 * 1024);
+        ASSERT_NE(exec_env, nullptr);
+        cluster = wasm_exec_env_get_cluster(exec_env);
+        ASSERT_NE(cluster, nullptr);
+    }
+
+    void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    std::vector<uint8_t> wasm_buf;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+    WASMCluster *cluster = nullptr;
+};
+
+TEST_F(ExecEnvRegistryTest, exec_env_of_instance_found)
+{
+    wasm_exec_env_t spawned = wasm_runtime_spawn_exec_env(exec_env);
+    wasm_module_inst_t spawned_inst;
+
+    ASSERT_NE(spawned, nullptr);
+    spawned_inst = wasm_runtime_get_module_inst(spawned);
+    ASSERT_NE(spawned_inst, module_inst);
+
+    EXPECT_EQ(wasm_clusters_search_exec_env(module_inst), exec_env);
+    EXPECT_EQ(wasm_clusters_search_exec_env(spawned_inst), spawned);
+
+    /* Switched to another instance temporarily */
+    wasm_exec_env_set_module_inst(spawned, module_inst);
+    EXPECT_EQ(wasm_clusters_search_exec_env(spawned_inst), nullptr);
+    wasm_exec_env_set_module_inst(spawned, spawned_inst);
+    EXPECT_EQ(wasm_clusters_search_exec_env(spawned_inst), spawned);
+
+    wasm_runtime_destroy_spawned_exec_env(spawned);
+    EXPECT_EQ(wasm_clusters_search_exec_env(module_inst), exec_env);
+}
+
+TEST_F(ExecEnvRegistryTest, removed_exec_env_kept_until_cluster_destroyed)
+{
+    std::vector<wasm_exec_env_t> found;
+
+    for (int i = 0; i < 3; i++) {
+        wasm_exec_env_t spawned = wasm_runtime_spawn_exec_env(exec_env);
+
+        ASSERT_NE(spawned, nullptr);
+        /* As if a lookup returned it right before it is removed */
+        found.push_back(wasm_clusters_search_exec_env(
+            wasm_runtime_get_module_inst(spawned)));
+        ASSERT_EQ(found.back(), spawned);
+        wasm_runtime_destroy_spawned_exec_env(spawned);
+    }
+
+    /* The exec_envs removed are still readable, which is checked by
+       the address sanitizer if it is enabled */
+    EXPECT_EQ(cluster->retired_exec_env_list.len, found.size());
+    for (wasm_exec_env_t retired : found) {
+        EXPECT_EQ(wasm_exec_env_get_cluster(retired), cluster);
+    }
+
+    /* They are freed with the cluster */
+    wasm_runtime_destroy_exec_env(exec_env);
+    exec_env = nullptr;
+}
+
+TEST_F(ExecEnvRegistryTest, lookups_concurrent_with_updates)
+{
+    wasm_exec_env_t spawned = wasm_runtime_spawn_exec_env(exec_env);
+    wasm_module_inst_t spawned_inst;
+    std::atomic<bool> stop(false);
+    std::vector<std::thread> readers;
+    std::atomic<uint32_t> unexpected(0);
+
+    ASSERT_NE(spawned, nullptr);
+    spawned_inst = wasm_runtime_get_module_inst(spawned);
+
+    for (int i = 0; i < 4; i++) {
+        readers.emplace_back([&]() {
+            while (!stop.load()) {
+                wasm_exec_env_t found =
+                    wasm_clusters_search_exec_env(module_inst);
+                /* The spawned exec_env is added to the head of the list
+                   of the instance while it is switched to it */
+                if ((found != exec_env && found != spawned)
+                    || wasm_exec_env_get_cluster(found) != cluster)
+                    unexpected++;
+            }
+        });
+    }
+
+    for (int i = 0; i < 20000; i++) {
+        wasm_exec_env_set_module_inst(spawned, module_inst);
+        wasm_exec_env_set_module_inst(spawned, spawned_inst);
+    }
+
+    stop = true;
+    for (std::thread &reader : readers)
+        reader.join();
+
+    EXPECT_EQ(unexpected.load(), 0u);
+    wasm_runtime_destroy_spawned_exec_env(spawned);
+}
@@ -0,0 +1,320 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <list>
+#include <string>
+#include <vector>
+
+#include "wasm_export.h"
+
+/* The module of:
+     (module
+       (func (export "sum") (param $n i32) (result i32) (local $s i32)
+         (block
+           (loop
+             (br_if 1 (i32.eqz (local.get $n)))
+             (local.set $s (i32.add (local.get $s) (local.get $n)))
+             (local.set $n (i32.sub (local.get $n) (i32.const 1)))
+             (br 0)))
+         (i32.add (local.get $s) (i32.const 7)))
+     ) */
+static uint8_t sum_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x06, 0x01, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x03, 0x02, 0x01, 0x00, 0x07, 0x07, 0x01, 0x03,
+    0x73, 0x75, 0x6d, 0x00, 0x00, 0x0a, 0x26, 0x01, 0x24, 0x01, 0x01, 0x7f,
+    0x02, 0x40, 0x03, 0x40, 0x20, 0x00, 0x45, 0x0d, 0x01, 0x20, 0x01, 0x20,
+    0x00, 0x6a, 0x21, 0x01, 0x20, 0x00, 0x41, 0x01, 0x6b, 0x21, 0x00, 0x0c,
+    0x00, 0x0b, 0x0b, 0x20, 0x01, 0x41, 0x07, 0x6a, 0x0b
+};
+
+/* Offset of the immediate of the last i32.const, patching it makes a
+   module of the same size whose sum function returns a different value */
+#define SUM_CONST_OFFSET 66
+
+/* Offsets of the fields in the header of the cache file */
+#define CACHE_BUILD_ID_OFFSET 8
+#define CACHE_BINARY_HASH_OFFSET 16
+#define CACHE_FUNC_COUNT_OFFSET 32
+
+class FastInterpCacheTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        ASSERT_NE(mkdtemp(cache_dir), nullptr);
+    }
+
+    void TearDown()
+    {
+        for (const std::string &file : list_cache_files())
+            unlink(file.c_str());
+        rmdir(cache_dir);
+    }
+
+    std::vector<uint8_t> make_module(uint8_t sum_const)
+    {
+        std::vector<uint8_t> buf(sum_wasm, sum_wasm + sizeof(sum_wasm));
+
+        buf[SUM_CONST_OFFSET] = sum_const;
+        return buf;
+    }
+
+    /* Load the module from a copy of buf with the cache directory, the
+       copy is kept until the end of the test */
+    wasm_module_t load(const std::vector<uint8_t> &buf)
+    {
+        std::vector<uint8_t> &wasm_buf = wasm_bufs.emplace_back(buf);
+        char error_buf[128] = { 0 };
+        LoadArgs load_args;
+        wasm_module_t module;
+
+        memset(&load_args, 0, sizeof(load_args));
+        load_args.name = (char *)"sum";
+        load_args.fast_interp_cache_dir = cache_dir;
+        module = wasm_runtime_load_ex(wasm_buf.data(), wasm_buf.size(),
+                                      &load_args, error_buf, sizeof(error_buf));
+        EXPECT_NE(module, nullptr) << error_buf;
+        return module;
+    }
+
+    /* Load the module, call sum(10) and unload it */
+    int32_t load_and_sum(const std::vector<uint8_t> &buf)
+    {
+        char error_buf[128] = { 0 };
+        wasm_module_t module = load(buf);
+        wasm_module_inst_t module_inst;
+        wasm_exec_env_t exec_env;
+        wasm_function_inst_t func;
+        uint32_t argv[1] = { 10 };
+
+        if (!module)
+            return -1;
+
+        module_inst = wasm_runtime_instantiate(module, 16 * 1024, 0,
+                                               error_buf, sizeof(error_buf));
+        EXPECT_NE(module_inst, nullptr) << error_buf;
+        if (!module_inst) {
+            wasm_runtime_unload(module);
+            return -1;
+        }
+
+        exec_env = wasm_runtime_create_exec_env(module_inst, 16 * 1024);
+        func = wasm_runtime_lookup_function(module_inst, "sum");
+        EXPECT_NE(func, nullptr);
+        if (!exec_env || !func || !wasm_runtime_call_wasm(exec_env, func, 1, argv))
+            argv[0] = (uint32_t)-1;
+
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        wasm_runtime_deinstantiate(module_inst);
+        wasm_runtime_unload(module);
+        return (int32_t)argv[0];
+    }
+
+    std::vector<std::string> list_cache_files()
+    {
+        std::vector<std::string> files;
+        DIR *dir = opendir(cache_dir);
+        struct dirent *entry;
+
+        if (!dir)
+            return files;
+        while ((entry = readdir(dir))) {
+            if (entry->d_name[0] != '.')
+                files.push_back(std::string(cache_dir) + "/" + entry->d_name);
+        }
+        closedir(dir);
+        return files;
+    }
+
+    /* The cache file is replaced by rename when it is saved again */
+    ino_t get_inode(const std::string &file)
+    {
+        struct stat st;
+
+        EXPECT_EQ(stat(file.c_str(), &st), 0);
+        return st.st_ino;
+    }
+
+    void patch_file(const std::string &file, off_t offset, uint8_t xor_byte)
+    {
+        int fd = open(file.c_str(), O_RDWR);
+        uint8_t byte;
+
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(pread(fd, &byte, 1, offset), 1);
+        byte ^= xor_byte;
+        ASSERT_EQ(pwrite(fd, &byte, 1, offset), 1);
+        close(fd);
+    }
+
+    void copy_file_bytes(const std::string &from, const std::string &to,
+                         off_t offset, size_t size)
+    {
+        std::vector<uint8_t> bytes(size);
+        int fd;
+
+        fd = open(from.c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(pread(fd, bytes.data(), size, offset), (ssize_t)size);
+        close(fd);
+
+        fd = open(to.c_str(), O_RDWR);
+        ASSERT_GE(fd, 0);
+        ASSERT_EQ(pwrite(fd, bytes.data(), size, offset), (ssize_t)size);
+        close(fd);
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    char cache_dir[32] = "/tmp/fast_interp_cache_XXXXXX";
+    std::list<std::vector<uint8_t>> wasm_bufs;
+};
+
+TEST_F(FastInterpCacheTest, cache_created_and_reused)
+{
+    std::vector<uint8_t> buf = make_module(7);
+    std::vector<std::string> files;
+    ino_t inode;
+
+    ASSERT_EQ(load_and_sum(buf), 62);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 1u);
+    inode = get_inode(files[0]);
+
+    /* Loaded from the cache, which isn't written again */
+    for (int i = 0; i < 3; i++) {
+        ASSERT_EQ(load_and_sum(buf), 62);
+        ASSERT_EQ(list_cache_files(), files);
+        ASSERT_EQ(get_inode(files[0]), inode);
+    }
+}
+
+TEST_F(FastInterpCacheTest, module_changed)
+{
+    std::vector<uint8_t> buf = make_module(7), buf_changed = make_module(9);
+    std::vector<std::string> files, files_changed;
+    std::string file, file_changed;
+
+    ASSERT_EQ(load_and_sum(buf), 62);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 1u);
+    file = files[0];
+
+    /* A module of the same size with different content has its own
+       cache file */
+    ASSERT_EQ(load_and_sum(buf_changed), 64);
+    files_changed = list_cache_files();
+    ASSERT_EQ(files_changed.size(), 2u);
+    file_changed = files_changed[0] == file ? files_changed[1]
+                                            : files_changed[0];
+    ASSERT_EQ(load_and_sum(buf_changed), 64);
+    ASSERT_EQ(load_and_sum(buf), 62);
+
+    /* A stale cache file under the name of the module, e.g. of a module
+       whose hash collides, is ignored and replaced */
+    ASSERT_EQ(rename(file_changed.c_str(), file.c_str()), 0);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_EQ(list_cache_files().size(), 1u);
+    ASSERT_EQ(load_and_sum(buf), 62);
+}
+
+TEST_F(FastInterpCacheTest, build_changed)
+{
+    std::vector<uint8_t> buf = make_module(7);
+    std::vector<std::string> files;
+    ino_t inode;
+
+    ASSERT_EQ(load_and_sum(buf), 62);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 1u);
+
+    /* A cache file created by a runtime built with different features
+       is ignored and replaced */
+    patch_file(files[0], CACHE_BUILD_ID_OFFSET, 0x01);
+    inode = get_inode(files[0]);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_EQ(list_cache_files(), files);
+    ASSERT_NE(get_inode(files[0]), inode);
+
+    /* The replaced one is used again */
+    inode = get_inode(files[0]);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_EQ(get_inode(files[0]), inode);
+}
+
+TEST_F(FastInterpCacheTest, cache_file_corrupted)
+{
+    std::vector<uint8_t> buf = make_module(7);
+    std::vector<std::string> files;
+    struct stat st;
+    off_t file_size;
+
+    ASSERT_EQ(load_and_sum(buf), 62);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 1u);
+
+    /* A truncated cache file is ignored and replaced */
+    ASSERT_EQ(stat(files[0].c_str(), &st), 0);
+    file_size = st.st_size;
+    ASSERT_EQ(truncate(files[0].c_str(), file_size / 2), 0);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_EQ(stat(files[0].c_str(), &st), 0);
+    ASSERT_EQ(st.st_size, file_size);
+    ASSERT_EQ(load_and_sum(buf), 62);
+}
+
+TEST_F(FastInterpCacheTest, hash_collision)
+{
+    std::vector<uint8_t> buf = make_module(7), buf_other = make_module(9);
+    std::vector<std::string> files;
+    std::string file, file_other;
+    ino_t inode;
+
+    ASSERT_EQ(load_and_sum(buf), 62);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 1u);
+    file = files[0];
+    ASSERT_EQ(load_and_sum(buf_other), 64);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 2u);
+    file_other = files[0] == file ? files[1] : files[0];
+
+    /* Make the cache file of the other module look like the one of the
+       module, as if the hashes of the two modules collided. The binary
+       saved in it doesn't match, so it is ignored and replaced instead
+       of running the code of the other module */
+    copy_file_bytes(file, file_other, CACHE_BINARY_HASH_OFFSET, 8);
+    ASSERT_EQ(rename(file_other.c_str(), file.c_str()), 0);
+    inode = get_inode(file);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_NE(get_inode(file), inode);
+    ASSERT_EQ(load_and_sum(buf), 62);
+}
+
+TEST_F(FastInterpCacheTest, cache_file_not_attachable)
+{
+    std::vector<uint8_t> buf = make_module(7);
+    std::vector<std::string> files;
+
+    ASSERT_EQ(load_and_sum(buf), 62);
+    files = list_cache_files();
+    ASSERT_EQ(files.size(), 1u);
+
+    /* A cache file which passes the checks of the header but doesn't
+       match the module is removed, and created again by the next load */
+    patch_file(files[0], CACHE_FUNC_COUNT_OFFSET, 0x02);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_EQ(list_cache_files().size(), 0u);
+    ASSERT_EQ(load_and_sum(buf), 62);
+    ASSERT_EQ(list_cache_files(), files);
+    ASSERT_EQ(load_and_sum(buf), 62);
+}
@@ -0,0 +1,244 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include <climits>
+#include <vector>
+
+#include "wasm_export.h"
+
+/* The module of:
+     (module
+       ;; $cmp<i> is the i-th of i32.eqz, i32.eq, i32.ne, i32.lt_s,
+       ;; i32.lt_u, i32.gt_s, i32.gt_u, i32.le_s, i32.le_u, i32.ge_s
+       ;; and i32.ge_u, whose operands are (local.get 0) for i32.eqz
+       ;; and (local.get 0) (local.get 1) for the others
+       (func (export "fused") (param i32 i32) (result i32) (local i32 i32)
+         ;; for each $cmp<i>
+         (block
+           (br_if 0 ($cmp<i>))
+           (local.set 2 (i32.or (local.get 2) (i32.const 1 << i))))
+         (if ($cmp<i>)
+           (then
+             (local.set 2 (i32.or (local.get 2) (i32.const 1 << (i + 11))))))
+         ;; br_if and if carrying values
+         (local.set 2 (i32.or
+           (block (result i32)
+             (br_if 0 (i32.const 1 << 22)
+                      (i32.lt_s (local.get 0) (local.get 1)))
+             (drop)
+             (i32.const 1 << 23))
+           (local.get 2)))
+         (local.set 2 (i32.or
+           (if (result i32) (i32.ge_u (local.get 0) (local.get 1))
+             (then (i32.const 1 << 24))
+             (else (i32.const 1 << 25)))
+           (local.get 2)))
+         ;; local 0 is preserved before the if which sets it
+         (local.get 0)
+         (if (i32.eq (local.get 0) (local.get 1))
+           (then (local.set 0 (i32.const 5))))
+         (local.set 2 (i32.or
+           (i32.shl (i32.ne (i32.sub (local.get 0)) (i32.const 0))
+                    (i32.const 26))
+           (local.get 2)))
+         (local.get 2))
+       ;; the same as "fused" except that each $cmp<i> is followed by
+       ;; (local.set 3) (local.get 3), so they aren't fused with
+       ;; br_if and if
+       (func (export "unfused") (param i32 i32) (result i32) (local i32 i32)
+         ...)
+       ;; the comparisons in unreachable code whose operands aren't on
+       ;; the stack
+       (func (param i32 i32) (result i32)
+         unreachable
+         i32.lt_s
+         br_if 0
+         unreachable
+         i32.eqz
+         if
+         end
+         i32.const 0)
+     ) */
+static uint8_t fused_branch_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x07, 0x01, 0x60,
+    0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x03, 0x04, 0x03, 0x00, 0x00, 0x00, 0x07,
+    0x13, 0x02, 0x05, 0x66, 0x75, 0x73, 0x65, 0x64, 0x00, 0x00, 0x07, 0x75,
+    0x6e, 0x66, 0x75, 0x73, 0x65, 0x64, 0x00, 0x01, 0x0a, 0x8d, 0x08, 0x03,
+    0xcb, 0x03, 0x01, 0x02, 0x7f, 0x02, 0x40, 0x20, 0x00, 0x45, 0x0d, 0x00,
+    0x20, 0x02, 0x41, 0x01, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x45, 0x04,
+    0x40, 0x20, 0x02, 0x41, 0x80, 0x10, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40,
+    0x20, 0x00, 0x20, 0x01, 0x46, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x02, 0x72,
+    0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x46, 0x04, 0x40, 0x20, 0x02,
+    0x41, 0x80, 0x20, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20,
+    0x01, 0x47, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x04, 0x72, 0x21, 0x02, 0x0b,
+    0x20, 0x00, 0x20, 0x01, 0x47, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0xc0,
+    0x00, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x48,
+    0x0d, 0x00, 0x20, 0x02, 0x41, 0x08, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00,
+    0x20, 0x01, 0x48, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x01, 0x72,
+    0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x49, 0x0d, 0x00,
+    0x20, 0x02, 0x41, 0x10, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01,
+    0x49, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x02, 0x72, 0x21, 0x02,
+    0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x4a, 0x0d, 0x00, 0x20, 0x02,
+    0x41, 0x20, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4a, 0x04,
+    0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x04, 0x72, 0x21, 0x02, 0x0b, 0x02,
+    0x40, 0x20, 0x00, 0x20, 0x01, 0x4b, 0x0d, 0x00, 0x20, 0x02, 0x41, 0xc0,
+    0x00, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4b, 0x04, 0x40,
+    0x20, 0x02, 0x41, 0x80, 0x80, 0x08, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40,
+    0x20, 0x00, 0x20, 0x01, 0x4c, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x80, 0x01,
+    0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4c, 0x04, 0x40, 0x20,
+    0x02, 0x41, 0x80, 0x80, 0x10, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20,
+    0x00, 0x20, 0x01, 0x4d, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x80, 0x02, 0x72,
+    0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4d, 0x04, 0x40, 0x20, 0x02,
+    0x41, 0x80, 0x80, 0x20, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00,
+    0x20, 0x01, 0x4e, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x80, 0x04, 0x72, 0x21,
+    0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4e, 0x04, 0x40, 0x20, 0x02, 0x41,
+    0x80, 0x80, 0xc0, 0x00, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00,
+    0x20, 0x01, 0x4f, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x80, 0x08, 0x72, 0x21,
+    0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4f, 0x04, 0x40, 0x20, 0x02, 0x41,
+    0x80, 0x80, 0x80, 0x01, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x7f, 0x41, 0x80,
+    0x80, 0x80, 0x02, 0x20, 0x00, 0x20, 0x01, 0x48, 0x0d, 0x00, 0x1a, 0x41,
+    0x80, 0x80, 0x80, 0x04, 0x0b, 0x20, 0x02, 0x72, 0x21, 0x02, 0x20, 0x00,
+    0x20, 0x01, 0x4f, 0x04, 0x7f, 0x41, 0x80, 0x80, 0x80, 0x08, 0x05, 0x41,
+    0x80, 0x80, 0x80, 0x10, 0x0b, 0x20, 0x02, 0x72, 0x21, 0x02, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x46, 0x04, 0x40, 0x41, 0x05, 0x21, 0x00, 0x0b,
+    0x20, 0x00, 0x6b, 0x41, 0x00, 0x47, 0x41, 0x1a, 0x74, 0x20, 0x02, 0x72,
+    0x21, 0x02, 0x20, 0x02, 0x0b, 0xaf, 0x04, 0x01, 0x02, 0x7f, 0x02, 0x40,
+    0x20, 0x00, 0x45, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00, 0x20, 0x02, 0x41,
+    0x01, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x45, 0x21, 0x03, 0x20, 0x03,
+    0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x10, 0x72, 0x21, 0x02, 0x0b, 0x02,
+    0x40, 0x20, 0x00, 0x20, 0x01, 0x46, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00,
+    0x20, 0x02, 0x41, 0x02, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01,
+    0x46, 0x21, 0x03, 0x20, 0x03, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x20,
+    0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x47, 0x21,
+    0x03, 0x20, 0x03, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x04, 0x72, 0x21, 0x02,
+    0x0b, 0x20, 0x00, 0x20, 0x01, 0x47, 0x21, 0x03, 0x20, 0x03, 0x04, 0x40,
+    0x20, 0x02, 0x41, 0x80, 0xc0, 0x00, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40,
+    0x20, 0x00, 0x20, 0x01, 0x48, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00, 0x20,
+    0x02, 0x41, 0x08, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x48,
+    0x21, 0x03, 0x20, 0x03, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x01,
+    0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x49, 0x21,
+    0x03, 0x20, 0x03, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x10, 0x72, 0x21, 0x02,
+    0x0b, 0x20, 0x00, 0x20, 0x01, 0x49, 0x21, 0x03, 0x20, 0x03, 0x04, 0x40,
+    0x20, 0x02, 0x41, 0x80, 0x80, 0x02, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40,
+    0x20, 0x00, 0x20, 0x01, 0x4a, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00, 0x20,
+    0x02, 0x41, 0x20, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4a,
+    0x21, 0x03, 0x20, 0x03, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x04,
+    0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x4b, 0x21,
+    0x03, 0x20, 0x03, 0x0d, 0x00, 0x20, 0x02, 0x41, 0xc0, 0x00, 0x72, 0x21,
+    0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4b, 0x21, 0x03, 0x20, 0x03, 0x04,
+    0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x08, 0x72, 0x21, 0x02, 0x0b, 0x02,
+    0x40, 0x20, 0x00, 0x20, 0x01, 0x4c, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00,
+    0x20, 0x02, 0x41, 0x80, 0x01, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20,
+    0x01, 0x4c, 0x21, 0x03, 0x20, 0x03, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80,
+    0x80, 0x10, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01,
+    0x4d, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00, 0x20, 0x02, 0x41, 0x80, 0x02,
+    0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4d, 0x21, 0x03, 0x20,
+    0x03, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x20, 0x72, 0x21, 0x02,
+    0x0b, 0x02, 0x40, 0x20, 0x00, 0x20, 0x01, 0x4e, 0x21, 0x03, 0x20, 0x03,
+    0x0d, 0x00, 0x20, 0x02, 0x41, 0x80, 0x04, 0x72, 0x21, 0x02, 0x0b, 0x20,
+    0x00, 0x20, 0x01, 0x4e, 0x21, 0x03, 0x20, 0x03, 0x04, 0x40, 0x20, 0x02,
+    0x41, 0x80, 0x80, 0xc0, 0x00, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x40, 0x20,
+    0x00, 0x20, 0x01, 0x4f, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00, 0x20, 0x02,
+    0x41, 0x80, 0x08, 0x72, 0x21, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x01, 0x4f,
+    0x21, 0x03, 0x20, 0x03, 0x04, 0x40, 0x20, 0x02, 0x41, 0x80, 0x80, 0x80,
+    0x01, 0x72, 0x21, 0x02, 0x0b, 0x02, 0x7f, 0x41, 0x80, 0x80, 0x80, 0x02,
+    0x20, 0x00, 0x20, 0x01, 0x48, 0x21, 0x03, 0x20, 0x03, 0x0d, 0x00, 0x1a,
+    0x41, 0x80, 0x80, 0x80, 0x04, 0x0b, 0x20, 0x02, 0x72, 0x21, 0x02, 0x20,
+    0x00, 0x20, 0x01, 0x4f, 0x21, 0x03, 0x20, 0x03, 0x04, 0x7f, 0x41, 0x80,
+    0x80, 0x80, 0x08, 0x05, 0x41, 0x80, 0x80, 0x80, 0x10, 0x0b, 0x20, 0x02,
+    0x72, 0x21, 0x02, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x46, 0x21, 0x03,
+    0x20, 0x03, 0x04, 0x40, 0x41, 0x05, 0x21, 0x00, 0x0b, 0x20, 0x00, 0x6b,
+    0x41, 0x00, 0x47, 0x41, 0x1a, 0x74, 0x20, 0x02, 0x72, 0x21, 0x02, 0x20,
+    0x02, 0x0b, 0x0d, 0x00, 0x00, 0x48, 0x0d, 0x00, 0x00, 0x45, 0x04, 0x40,
+    0x0b, 0x41, 0x00, 0x0b,
+};
+
+static uint32_t
+expected_result(int32_t a, int32_t b)
+{
+    uint32_t ua = (uint32_t)a, ub = (uint32_t)b;
+    bool results[] = { ua == 0, ua == ub, ua != ub, a < b,    ua < ub, a > b,
+                       ua > ub, a <= b,   ua <= ub, a >= b, ua >= ub };
+    uint32_t mask = 0;
+
+    for (uint32_t i = 0; i < sizeof(results) / sizeof(results[0]); i++) {
+        /* bit i is set if br_if isn't taken, and bit i + 11 if the
+           then branch of if is taken */
+        mask |= results[i] ? 1u << (i + 11) : 1u << i;
+    }
+    mask |= a < b ? 1u << 22 : 1u << 23;
+    mask |= ua >= ub ? 1u << 24 : 1u << 25;
+    if (ua == ub && ua != 5)
+        mask |= 1u << 26;
+    return mask;
+}
+
+class FusedBranchTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        char error_buf[128] = { 0 };
+
+        wasm_buf.assign(fused_branch_wasm,
+                        fused_branch_wasm + sizeof(fused_branch_wasm));
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+
+        module_inst = wasm_runtime_instantiate(module, 8 * 1024, 0,
+                                               error_buf, sizeof(error_buf));
+        ASSERT_NE(module_inst, nullptr) << error_buf;
+
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8 * 1024);
+        ASSERT_NE(exec_env, nullptr);
+    }
+
+    void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    uint32_t call(const char *name, int32_t a, int32_t b)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+        uint32_t argv[2] = { (uint32_t)a, (uint32_t)b };
+
+        EXPECT_NE(func, nullptr);
+        EXPECT_TRUE(wasm_runtime_call_wasm(exec_env, func, 2, argv))
+            << wasm_runtime_get_exception(module_inst);
+        return argv[0];
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    std::vector<uint8_t> wasm_buf;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(FusedBranchTest, fused_same_as_unfused)
+{
+    int32_t values[] = { INT_MIN, INT_MIN + 1, -2, -1, 0, 1, 2, 5,
+                         INT_MAX - 1, INT_MAX };
+
+    for (int32_t a : values) {
+        for (int32_t b : values) {
+            uint32_t fused = call("fused", a, b);
+
+            EXPECT_EQ(fused, call("unfused", a, b)) << a << ", " << b;
+            EXPECT_EQ(fused, expected_result(a, b)) << a << ", " << b;
+        }
+    }
+}
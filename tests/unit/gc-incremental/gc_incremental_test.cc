@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gc_list_wasm.h"
+#include "gtest/gtest.h"
+
+#include <list>
+#include <vector>
+
+#include "wasm_export.h"
+#include "gc_export.h"
+
+#define GC_HEAP_SIZE (4 * 1024 * 1024)
+#define LIST_LEN 50000
+#define LIST_SUM ((uint32_t)LIST_LEN * (LIST_LEN + 1) / 2)
+
+class GCIncrementalTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        RuntimeInitArgs init_args;
+        std::vector<uint8_t> &wasm_buf = wasm_bufs.emplace_back(
+            gc_list_wasm, gc_list_wasm + sizeof(gc_list_wasm));
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.gc_heap_size = GC_HEAP_SIZE;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+        module_inst = wasm_runtime_instantiate(module, 64 * 1024, 0,
+                                               error_buf, sizeof(error_buf));
+        ASSERT_NE(module_inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 64 * 1024);
+        ASSERT_NE(exec_env, nullptr);
+
+        /* Small slices, so that a cycle takes many of them */
+        ASSERT_TRUE(wasm_runtime_set_gc_pause_budget(module_inst, 20));
+        ASSERT_TRUE(call_i32("build", LIST_LEN, NULL));
+    }
+
+    void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        wasm_runtime_destroy();
+    }
+
+    bool call_i32(const char *name, uint32_t arg, uint32_t *p_result)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+        uint32_t argv[1] = { arg };
+
+        if (!func
+            || !wasm_runtime_call_wasm(exec_env, func, p_result ? 0 : 1,
+                                       argv)) {
+            ADD_FAILURE() << name << " failed: "
+                          << wasm_runtime_get_exception(module_inst);
+            return false;
+        }
+        if (p_result)
+            *p_result = argv[0];
+        return true;
+    }
+
+    bool check_sum()
+    {
+        uint32_t sum = 0;
+
+        if (!call_i32("sum", 0, &sum))
+            return false;
+        EXPECT_EQ(sum, LIST_SUM);
+        return sum == LIST_SUM;
+    }
+
+    wasm_gc_pause_stats_t get_stats()
+    {
+        wasm_gc_pause_stats_t stats;
+
+        EXPECT_TRUE(wasm_runtime_get_gc_pause_stats(module_inst, &stats));
+        return stats;
+    }
+
+    char error_buf[128] = { 0 };
+    std::list<std::vector<uint8_t>> wasm_bufs;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+};
+
+TEST_F(GCIncrementalTest, list_mutated_during_cycles)
+{
+    wasm_gc_pause_stats_t stats;
+
+    /* The slices run at the allocations of the churn */
+    for (int i = 0; i < 40; i++) {
+        ASSERT_TRUE(call_i32("churn", 10000, NULL));
+        ASSERT_TRUE(check_sum()) << "round " << i;
+    }
+
+    stats = get_stats();
+    ASSERT_GT(stats.gc_count, 1u);
+    /* Each cycle runs in more than one slice */
+    ASSERT_GT(stats.pause_count, stats.gc_count * 2);
+}
+
+TEST_F(GCIncrementalTest, list_mutated_between_host_steps)
+{
+    wasm_gc_pause_stats_t stats;
+    uint64_t gc_count;
+    int steps = 0, mutations_in_cycle = 0;
+
+    /* Allocate until a cycle is started by a host step */
+    while (!wasm_runtime_gc_step(module_inst)) {
+        ASSERT_TRUE(call_i32("churn", 1000, NULL));
+        ASSERT_LT(++steps, 1000);
+    }
+    gc_count = get_stats().gc_count;
+
+    /* Replace the nodes of the list between the slices of the cycle,
+       the overwritten references must be marked */
+    while (wasm_runtime_gc_step(module_inst)) {
+        ASSERT_TRUE(call_i32("churn", 50, NULL));
+        ASSERT_TRUE(check_sum());
+        mutations_in_cycle++;
+        ASSERT_LT(mutations_in_cycle, 100000);
+    }
+    ASSERT_GT(mutations_in_cycle, 1);
+
+    stats = get_stats();
+    ASSERT_GT(stats.gc_count, gc_count);
+    ASSERT_TRUE(check_sum());
+
+    /* No cycle is in progress now, and the heap keeps working */
+    for (int i = 0; i < 10; i++) {
+        ASSERT_TRUE(call_i32("churn", 10000, NULL));
+        ASSERT_TRUE(check_sum());
+    }
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gc_list_wasm.h"
+#include "gtest/gtest.h"
+
+#include <list>
+#include <thread>
+#include <vector>
+
+#include "wasm_export.h"
+#include "wasm_runtime_common.h"
+#include "ems/ems_gc_internal.h"
+
+/* Larger than GC_PARALLEL_MARK_MIN_HEAP_SIZE */
+#define GC_HEAP_SIZE (8 * 1024 * 1024)
+#define LIST_LEN 100000
+#define LIST_SUM ((uint32_t)LIST_LEN * (LIST_LEN + 1) / 2)
+
+class GCParallelMarkTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        init_args.gc_heap_size = GC_HEAP_SIZE;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+
+        std::vector<uint8_t> &wasm_buf = wasm_bufs.emplace_back(
+            gc_list_wasm, gc_list_wasm + sizeof(gc_list_wasm));
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+    }
+
+    void TearDown()
+    {
+        if (module)
+            wasm_runtime_unload(module);
+        wasm_runtime_destroy();
+    }
+
+    static bool call(wasm_exec_env_t exec_env, const char *name,
+                     uint32_t *argv, uint32_t argc)
+    {
+        wasm_module_inst_t module_inst =
+            wasm_runtime_get_module_inst(exec_env);
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+
+        if (!func || !wasm_runtime_call_wasm(exec_env, func, argc, argv)) {
+            ADD_FAILURE() << name << " failed: "
+                          << wasm_runtime_get_exception(module_inst);
+            return false;
+        }
+        return true;
+    }
+
+    /* Build the list, and replace its nodes while allocating garbage,
+       checking that no live node is collected */
+    void run_list(wasm_module_inst_t module_inst, int rounds)
+    {
+        wasm_exec_env_t exec_env =
+            wasm_runtime_create_exec_env(module_inst, 64 * 1024);
+        uint32_t argv[1];
+
+        ASSERT_NE(exec_env, nullptr);
+
+        argv[0] = LIST_LEN;
+        ASSERT_TRUE(call(exec_env, "build", argv, 1));
+        for (int i = 0; i < rounds; i++) {
+            argv[0] = 20000;
+            ASSERT_TRUE(call(exec_env, "churn", argv, 1));
+            ASSERT_TRUE(call(exec_env, "sum", argv, 0));
+            ASSERT_EQ(argv[0], LIST_SUM) << "round " << i;
+        }
+
+        wasm_runtime_destroy_exec_env(exec_env);
+    }
+
+    wasm_module_inst_t instantiate()
+    {
+        wasm_module_inst_t module_inst = wasm_runtime_instantiate(
+            module, 64 * 1024, 0, error_buf, sizeof(error_buf));
+
+        EXPECT_NE(module_inst, nullptr) << error_buf;
+        return module_inst;
+    }
+
+    static gc_heap_t *get_gc_heap(wasm_module_inst_t module_inst)
+    {
+        return (gc_heap_t *)wasm_runtime_get_gc_heap_handle(
+            (WASMModuleInstanceCommon *)module_inst);
+    }
+
+    char error_buf[128] = { 0 };
+    std::list<std::vector<uint8_t>> wasm_bufs;
+    wasm_module_t module = nullptr;
+};
+
+TEST_F(GCParallelMarkTest, list_mutated_between_collections)
+{
+    wasm_module_inst_t module_inst = instantiate();
+    gc_heap_t *heap;
+
+    ASSERT_NE(module_inst, nullptr);
+    run_list(module_inst, 30);
+
+    heap = get_gc_heap(module_inst);
+    ASSERT_GT(heap->total_gc_count, 0u);
+    /* The heap is large enough to be collected by the mark workers */
+    ASSERT_EQ(heap->parallel_gc_count, heap->total_gc_count);
+
+    wasm_runtime_deinstantiate(module_inst);
+}
+
+TEST_F(GCParallelMarkTest, heaps_collected_at_same_time)
+{
+    wasm_module_inst_t module_insts[2];
+    std::vector<std::thread> threads;
+    uint32_t parallel_gc_count = 0;
+
+    for (int i = 0; i < 2; i++) {
+        module_insts[i] = instantiate();
+        ASSERT_NE(module_insts[i], nullptr);
+    }
+
+    /* The mark workers are used by one heap at a time, the other heap is
+       collected by the serial marker meanwhile */
+    for (int i = 0; i < 2; i++) {
+        threads.emplace_back([&, i]() {
+            ASSERT_TRUE(wasm_runtime_init_thread_env());
+            run_list(module_insts[i], 20);
+            wasm_runtime_destroy_thread_env();
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (int i = 0; i < 2; i++) {
+        gc_heap_t *heap = get_gc_heap(module_insts[i]);
+
+        ASSERT_GT(heap->total_gc_count, 0u);
+        parallel_gc_count += heap->parallel_gc_count;
+        wasm_runtime_deinstantiate(module_insts[i]);
+    }
+    ASSERT_GT(parallel_gc_count, 0u);
+}
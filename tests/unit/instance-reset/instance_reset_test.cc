@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include <stdio.h>
+#include <unistd.h>
+#include <vector>
+
+#include "wasm_export.h"
+
+/* The module of wasm-apps/reset.wat, its start function allocates 100
+   bytes from the app heap, stores 0x12345678 there and keeps the offset
+   in a global */
+static uint8_t reset_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x11, 0x04, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x60, 0x00, 0x00, 0x60, 0x00, 0x01, 0x7f, 0x60,
+    0x01, 0x7f, 0x00, 0x02, 0x31, 0x02, 0x03, 0x65, 0x6e, 0x76, 0x06, 0x6d,
+    0x61, 0x6c, 0x6c, 0x6f, 0x63, 0x00, 0x00, 0x16, 0x77, 0x61, 0x73, 0x69,
+    0x5f, 0x73, 0x6e, 0x61, 0x70, 0x73, 0x68, 0x6f, 0x74, 0x5f, 0x70, 0x72,
+    0x65, 0x76, 0x69, 0x65, 0x77, 0x31, 0x09, 0x70, 0x72, 0x6f, 0x63, 0x5f,
+    0x65, 0x78, 0x69, 0x74, 0x00, 0x03, 0x03, 0x07, 0x06, 0x01, 0x02, 0x02,
+    0x00, 0x00, 0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06, 0x06, 0x01, 0x7f,
+    0x01, 0x41, 0x00, 0x0b, 0x07, 0x2f, 0x06, 0x05, 0x67, 0x65, 0x74, 0x5f,
+    0x70, 0x00, 0x03, 0x04, 0x67, 0x72, 0x6f, 0x77, 0x00, 0x04, 0x05, 0x61,
+    0x6c, 0x6c, 0x6f, 0x63, 0x00, 0x05, 0x04, 0x6c, 0x6f, 0x61, 0x64, 0x00,
+    0x06, 0x04, 0x73, 0x69, 0x7a, 0x65, 0x00, 0x07, 0x06, 0x6d, 0x65, 0x6d,
+    0x6f, 0x72, 0x79, 0x02, 0x00, 0x08, 0x01, 0x02, 0x0a, 0x36, 0x06, 0x14,
+    0x00, 0x41, 0xe4, 0x00, 0x10, 0x00, 0x24, 0x00, 0x23, 0x00, 0x41, 0xf8,
+    0xac, 0xd1, 0x91, 0x01, 0x36, 0x02, 0x00, 0x0b, 0x04, 0x00, 0x23, 0x00,
+    0x0b, 0x06, 0x00, 0x41, 0x01, 0x40, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00,
+    0x10, 0x00, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x00, 0x0b, 0x04,
+    0x00, 0x3f, 0x00, 0x0b
+};
+
+#define MAGIC 0x12345678
+
+class InstanceResetTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        char error_buf[128] = { 0 };
+
+        wasm_buf = std::vector<uint8_t>(reset_wasm,
+                                        reset_wasm + sizeof(reset_wasm));
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+
+        memset(&args, 0, sizeof(args));
+        args.default_stack_size = 16 * 1024;
+        args.host_managed_heap_size = 16 * 1024;
+        args.enable_reset = true;
+    }
+
+    void TearDown()
+    {
+        if (module)
+            wasm_runtime_unload(module);
+    }
+
+    wasm_module_inst_t instantiate()
+    {
+        char error_buf[128] = { 0 };
+        wasm_module_inst_t module_inst = wasm_runtime_instantiate_ex(
+            module, &args, error_buf, sizeof(error_buf));
+
+        EXPECT_NE(module_inst, nullptr) << error_buf;
+        return module_inst;
+    }
+
+    uint32_t call(wasm_module_inst_t module_inst, const char *name,
+                  uint32_t arg = 0)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+        wasm_exec_env_t exec_env =
+            wasm_runtime_get_exec_env_singleton(module_inst);
+        uint32_t argv[1] = { arg };
+
+        EXPECT_NE(func, nullptr);
+        EXPECT_NE(exec_env, nullptr);
+        EXPECT_TRUE(wasm_runtime_call_wasm(exec_env, func, 1, argv))
+            << wasm_runtime_get_exception(module_inst);
+        return argv[0];
+    }
+
+    /* Allocate 256-byte blocks from the app heap until it is full, and
+       return their offsets */
+    std::vector<uint64_t> fill_app_heap(wasm_module_inst_t module_inst)
+    {
+        std::vector<uint64_t> offsets;
+        uint64_t offset;
+
+        while ((offset = wasm_runtime_module_malloc(module_inst, 256, NULL))
+               != 0)
+            offsets.push_back(offset);
+        return offsets;
+    }
+
+    /* Check that the block allocated by the start function is kept and
+       that the other blocks don't overlap it */
+    void check_app_heap(wasm_module_inst_t module_inst, uint32_t p,
+                        const std::vector<uint64_t> &offsets)
+    {
+        ASSERT_EQ(call(module_inst, "get_p"), p);
+        ASSERT_EQ(call(module_inst, "load", p), (uint32_t)MAGIC);
+        for (uint64_t offset : offsets)
+            ASSERT_TRUE(offset + 256 <= p || offset >= p + 100);
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    std::vector<uint8_t> wasm_buf;
+    wasm_module_t module = nullptr;
+    InstantiationArgs args;
+};
+
+TEST_F(InstanceResetTest, reset_after_malloc_in_start_function)
+{
+    char error_buf[128] = { 0 };
+    wasm_module_inst_t module_inst = instantiate();
+    std::vector<uint64_t> offsets, offsets_reset;
+    uint32_t p;
+
+    ASSERT_NE(module_inst, nullptr);
+    p = call(module_inst, "get_p");
+    ASSERT_NE(p, 0u);
+
+    offsets = fill_app_heap(module_inst);
+    ASSERT_FALSE(offsets.empty());
+    check_app_heap(module_inst, p, offsets);
+
+    /* The blocks allocated since instantiation are freed, and the one
+       allocated by the start function isn't given out again */
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(wasm_runtime_instance_reset(module_inst, false, error_buf,
+                                                sizeof(error_buf)))
+            << error_buf;
+        offsets_reset = fill_app_heap(module_inst);
+        ASSERT_EQ(offsets_reset, offsets);
+        check_app_heap(module_inst, p, offsets_reset);
+    }
+
+    /* The heap is still consistent, the block can be freed and reused */
+    wasm_runtime_module_free(module_inst, p);
+    ASSERT_NE(wasm_runtime_module_malloc(module_inst, 64, NULL), 0u);
+
+    wasm_runtime_deinstantiate(module_inst);
+}
+
+TEST_F(InstanceResetTest, reset_after_memory_grow)
+{
+    char error_buf[128] = { 0 };
+    wasm_module_inst_t module_inst = instantiate();
+    std::vector<uint64_t> offsets, offsets_reset;
+    uint32_t p, page_count;
+
+    ASSERT_NE(module_inst, nullptr);
+    p = call(module_inst, "get_p");
+    page_count = call(module_inst, "size");
+    offsets = fill_app_heap(module_inst);
+    ASSERT_TRUE(wasm_runtime_instance_reset(module_inst, false, error_buf,
+                                            sizeof(error_buf)))
+        << error_buf;
+
+    /* The linear memory may be moved when it grows and when it shrinks
+       back, and the app heap with it */
+    for (int i = 0; i < 4; i++) {
+        ASSERT_EQ(call(module_inst, "grow"), page_count + i);
+        ASSERT_NE(call(module_inst, "alloc", 1000), 0u);
+    }
+    ASSERT_EQ(call(module_inst, "size"), page_count + 4);
+
+    ASSERT_TRUE(wasm_runtime_instance_reset(module_inst, false, error_buf,
+                                            sizeof(error_buf)))
+        << error_buf;
+    ASSERT_EQ(call(module_inst, "size"), page_count);
+    offsets_reset = fill_app_heap(module_inst);
+    ASSERT_EQ(offsets_reset, offsets);
+    check_app_heap(module_inst, p, offsets_reset);
+
+    wasm_runtime_deinstantiate(module_inst);
+}
+
+TEST_F(InstanceResetTest, pool_replaces_instance_failing_to_reset)
+{
+    char error_buf[128] = { 0 };
+    wasm_instance_pool_t pool;
+    wasm_module_inst_t module_inst, module_inst_acquired, module_inst_new;
+    InstantiationArgs args_no_reset = args;
+    std::vector<uint64_t> offsets;
+    uint32_t p;
+
+    pool = wasm_runtime_create_instance_pool(module, &args, 1, false,
+                                             error_buf, sizeof(error_buf));
+    ASSERT_NE(pool, nullptr) << error_buf;
+
+    module_inst_acquired = wasm_runtime_instance_pool_acquire(pool);
+    ASSERT_NE(module_inst_acquired, nullptr);
+    ASSERT_EQ(wasm_runtime_instance_pool_acquire(pool), nullptr);
+    p = call(module_inst_acquired, "get_p");
+    offsets = fill_app_heap(module_inst_acquired);
+
+    /* An instance created without enable_reset can't be reset, it is
+       replaced by a new instance */
+    args_no_reset.enable_reset = false;
+    module_inst = wasm_runtime_instantiate_ex(module, &args_no_reset,
+                                              error_buf, sizeof(error_buf));
+    ASSERT_NE(module_inst, nullptr) << error_buf;
+    fill_app_heap(module_inst);
+    ASSERT_TRUE(wasm_runtime_instance_pool_release(pool, module_inst));
+    wasm_runtime_deinstantiate(module_inst_acquired);
+
+    module_inst_new = wasm_runtime_instance_pool_acquire(pool);
+    ASSERT_NE(module_inst_new, nullptr);
+    ASSERT_EQ(call(module_inst_new, "get_p"), p);
+    ASSERT_EQ(fill_app_heap(module_inst_new), offsets);
+
+    /* The new instance can be reset */
+    ASSERT_TRUE(wasm_runtime_instance_pool_release(pool, module_inst_new));
+    module_inst_new = wasm_runtime_instance_pool_acquire(pool);
+    ASSERT_NE(module_inst_new, nullptr);
+    check_app_heap(module_inst_new, p, fill_app_heap(module_inst_new));
+    ASSERT_TRUE(wasm_runtime_instance_pool_release(pool, module_inst_new));
+
+    wasm_runtime_destroy_instance_pool(pool);
+}
+
+#if WASM_ENABLE_LIBC_WASI != 0
+TEST_F(InstanceResetTest, pool_shrinks_when_replacement_fails)
+{
+    char error_buf[128] = { 0 }, dir[] = "/tmp/instance_reset_XXXXXX";
+    const char *dir_list[1] = { dir };
+    wasm_instance_pool_t pool;
+    wasm_module_inst_t module_inst;
+
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    wasm_runtime_set_wasi_args(module, dir_list, 1, NULL, 0, NULL, 0, NULL,
+                               0);
+
+    pool = wasm_runtime_create_instance_pool(module, &args, 1, true, error_buf,
+                                             sizeof(error_buf));
+    ASSERT_NE(pool, nullptr) << error_buf;
+
+    module_inst = wasm_runtime_instance_pool_acquire(pool);
+    ASSERT_NE(module_inst, nullptr);
+    ASSERT_TRUE(wasm_runtime_instance_pool_release(pool, module_inst));
+
+    /* The preopened directory can't be opened again, neither the WASI
+       context of the instance can be reinitialized nor a new instance
+       can be created */
+    module_inst = wasm_runtime_instance_pool_acquire(pool);
+    ASSERT_NE(module_inst, nullptr);
+    ASSERT_EQ(rmdir(dir), 0);
+    ASSERT_FALSE(wasm_runtime_instance_pool_release(pool, module_inst));
+    ASSERT_EQ(wasm_runtime_instance_pool_acquire(pool), nullptr);
+
+    wasm_runtime_destroy_instance_pool(pool);
+}
+#endif
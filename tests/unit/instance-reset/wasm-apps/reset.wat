@@ -0,0 +1,23 @@
+;; Copyright (C) 2019 Intel Corporation. All rights reserved.
+;; SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+
+(module
+  (import "env" "malloc" (func $malloc (param i32) (result i32)))
+  (import "wasi_snapshot_preview1" "proc_exit" (func $proc_exit (param i32)))
+  (memory (export "memory") 1)
+  (global $p (mut i32) (i32.const 0))
+
+  ;; Allocate from the app heap before the reset image is taken
+  (func $init
+    (global.set $p (call $malloc (i32.const 100)))
+    (i32.store (global.get $p) (i32.const 0x12345678))
+  )
+
+  (func (export "get_p") (result i32) (global.get $p))
+  (func (export "grow") (result i32) (memory.grow (i32.const 1)))
+  (func (export "alloc") (param i32) (result i32) (call $malloc (local.get 0)))
+  (func (export "load") (param i32) (result i32) (i32.load (local.get 0)))
+  (func (export "size") (result i32) (memory.size))
+
+  (start $init)
+)
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include <list>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "wasm_export.h"
+
+/* The module of:
+     (module
+       (func (export "good") (result i32) (i32.const 42))
+       (func (export "bad") (result i32)
+         (i32.add (i32.const 1) (i64.const 2)))
+       (func (export "calls_bad") (result i32)
+         (i32.add (call 1) (i32.const 1)))
+       (func (export "calls_good") (result i32)
+         (i32.add (call 0) (i32.const 1)))
+     )
+   whose "bad" function doesn't pass validation */
+static uint8_t lazy_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x05, 0x01, 0x60,
+    0x00, 0x01, 0x7f, 0x03, 0x05, 0x04, 0x00, 0x00, 0x00, 0x00, 0x07, 0x27,
+    0x04, 0x04, 0x67, 0x6f, 0x6f, 0x64, 0x00, 0x00, 0x03, 0x62, 0x61, 0x64,
+    0x00, 0x01, 0x09, 0x63, 0x61, 0x6c, 0x6c, 0x73, 0x5f, 0x62, 0x61, 0x64,
+    0x00, 0x02, 0x0a, 0x63, 0x61, 0x6c, 0x6c, 0x73, 0x5f, 0x67, 0x6f, 0x6f,
+    0x64, 0x00, 0x03, 0x0a, 0x1e, 0x04, 0x04, 0x00, 0x41, 0x2a, 0x0b, 0x07,
+    0x00, 0x41, 0x01, 0x42, 0x02, 0x6a, 0x0b, 0x07, 0x00, 0x10, 0x01, 0x41,
+    0x01, 0x6a, 0x0b, 0x07, 0x00, 0x10, 0x00, 0x41, 0x01, 0x6a, 0x0b
+};
+
+static const char *load_failed_prefix = "WASM module load failed: ";
+
+class LazyFuncValidationTest : public testing::Test
+{
+  protected:
+    /* The loader may rewrite the buffer, load each module from a copy,
+       which is kept until the module is unloaded */
+    wasm_module_t load(bool lazy, char *error_buf, uint32_t error_buf_size)
+    {
+        std::vector<uint8_t> &wasm_buf = wasm_bufs.emplace_back(
+            lazy_wasm, lazy_wasm + sizeof(lazy_wasm));
+        LoadArgs load_args;
+
+        memset(&load_args, 0, sizeof(load_args));
+        load_args.name = (char *)"lazy";
+        load_args.lazy_func_validation = lazy;
+        return wasm_runtime_load_ex(wasm_buf.data(), wasm_buf.size(),
+                                    &load_args, error_buf, error_buf_size);
+    }
+
+    bool call(wasm_module_inst_t module_inst, const char *name,
+              uint32_t *p_result)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+        wasm_exec_env_t exec_env =
+            wasm_runtime_create_exec_env(module_inst, 16 * 1024);
+        uint32_t argv[1] = { 0 };
+        bool ret;
+
+        EXPECT_NE(func, nullptr);
+        EXPECT_NE(exec_env, nullptr);
+        ret = wasm_runtime_call_wasm(exec_env, func, 0, argv);
+        wasm_runtime_destroy_exec_env(exec_env);
+        *p_result = argv[0];
+        return ret;
+    }
+
+    /* The validation error the eager loader reports for the module */
+    std::string eager_error()
+    {
+        char error_buf[128] = { 0 };
+        wasm_module_t module = load(false, error_buf, sizeof(error_buf));
+        std::string error = error_buf;
+
+        EXPECT_EQ(module, nullptr);
+        EXPECT_EQ(error.rfind(load_failed_prefix, 0), 0u);
+        return error.substr(strlen(load_failed_prefix));
+    }
+
+    WAMRRuntimeRAII<512 * 1024> runtime;
+    std::list<std::vector<uint8_t>> wasm_bufs;
+};
+
+TEST_F(LazyFuncValidationTest, invalid_body_reported_at_first_call)
+{
+    char error_buf[128] = { 0 };
+    std::string error = eager_error();
+    wasm_module_t module;
+    wasm_module_inst_t module_inst;
+    uint32_t result;
+
+    ASSERT_FALSE(error.empty());
+
+    /* Only the module structure is checked at load time */
+    module = load(true, error_buf, sizeof(error_buf));
+    ASSERT_NE(module, nullptr) << error_buf;
+    ASSERT_EQ(wasm_runtime_get_prepared_func_count(module), 0u);
+    ASSERT_FALSE(wasm_runtime_is_underlying_binary_freeable(module));
+
+    module_inst =
+        wasm_runtime_instantiate(module, 16 * 1024, 0, error_buf,
+                                 sizeof(error_buf));
+    ASSERT_NE(module_inst, nullptr) << error_buf;
+
+    ASSERT_TRUE(call(module_inst, "good", &result));
+    ASSERT_EQ(result, 42u);
+    ASSERT_EQ(wasm_runtime_get_prepared_func_count(module), 1u);
+
+    /* The invalid function traps with the error of the eager loader, also
+       when it is called again */
+    for (int i = 0; i < 2; i++) {
+        ASSERT_FALSE(call(module_inst, "bad", &result));
+        ASSERT_EQ(std::string(wasm_runtime_get_exception(module_inst)),
+                  std::string("Exception: ") + error);
+        wasm_runtime_clear_exception(module_inst);
+    }
+    ASSERT_EQ(wasm_runtime_get_prepared_func_count(module), 1u);
+
+    /* Called from another function, which is prepared first */
+    ASSERT_FALSE(call(module_inst, "calls_bad", &result));
+    ASSERT_EQ(std::string(wasm_runtime_get_exception(module_inst)),
+              std::string("Exception: ") + error);
+    wasm_runtime_clear_exception(module_inst);
+    ASSERT_EQ(wasm_runtime_get_prepared_func_count(module), 2u);
+
+    ASSERT_TRUE(call(module_inst, "calls_good", &result));
+    ASSERT_EQ(result, 43u);
+    ASSERT_EQ(wasm_runtime_get_prepared_func_count(module), 3u);
+
+    wasm_runtime_deinstantiate(module_inst);
+    wasm_runtime_unload(module);
+}
+
+TEST_F(LazyFuncValidationTest, prepared_once_by_concurrent_first_calls)
+{
+    char error_buf[128] = { 0 };
+    wasm_module_t module;
+    std::vector<std::thread> threads;
+    bool results[4] = { false };
+
+    module = load(true, error_buf, sizeof(error_buf));
+    ASSERT_NE(module, nullptr) << error_buf;
+
+    /* Each thread calls the function of its own instance, the body is
+       shared by the instances and prepared once */
+    for (int i = 0; i < 4; i++) {
+        threads.emplace_back([this, module, &results, i]() {
+            char error_buf[128] = { 0 };
+            wasm_module_inst_t module_inst;
+            uint32_t result = 0;
+
+            if (!wasm_runtime_init_thread_env())
+                return;
+            module_inst = wasm_runtime_instantiate(
+                module, 16 * 1024, 0, error_buf, sizeof(error_buf));
+            if (module_inst) {
+                results[i] =
+                    call(module_inst, "calls_good", &result) && result == 43;
+                wasm_runtime_deinstantiate(module_inst);
+            }
+            wasm_runtime_destroy_thread_env();
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    for (int i = 0; i < 4; i++)
+        ASSERT_TRUE(results[i]);
+    ASSERT_EQ(wasm_runtime_get_prepared_func_count(module), 2u);
+
+    wasm_runtime_unload(module);
+}
@@ -0,0 +1,281 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "test_helper.h"
+#include "gtest/gtest.h"
+
+#include <pthread.h>
+#include <thread>
+#include <vector>
+
+#include "wasm_export.h"
+
+/* The module with the aux stack required to spawn threads:
+     (module
+       (memory 1)
+       (global (mut i32) (i32.const 32768))
+       (global (export "__data_end") i32 (i32.const 1024))
+       (global (export "__heap_base") i32 (i32.const 32768))
+     ) */
+static uint8_t thread_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x05, 0x03, 0x01, 0x00,
+    0x01, 0x06, 0x15, 0x03, 0x7f, 0x01, 0x41, 0x80, 0x80, 0x02, 0x0b, 0x7f,
+    0x00, 0x41, 0x80, 0x08, 0x0b, 0x7f, 0x00, 0x41, 0x80, 0x80, 0x02, 0x0b,
+    0x07, 0x1c, 0x02, 0x0a, 0x5f, 0x5f, 0x64, 0x61, 0x74, 0x61, 0x5f, 0x65,
+    0x6e, 0x64, 0x03, 0x01, 0x0b, 0x5f, 0x5f, 0x68, 0x65, 0x61, 0x70, 0x5f,
+    0x62, 0x61, 0x73, 0x65, 0x03, 0x02,
+};
+
+#define THREAD_NUM 4
+
+static uint32_t
+get_free_size()
+{
+    mem_alloc_info_t info;
+
+    EXPECT_TRUE(wasm_runtime_get_mem_alloc_info(&info));
+    return info.total_free_size;
+}
+
+/* Allocate and free blocks of all the cached sizes, and some larger blocks
+   which aren't cached, more blocks than a size class keeps are allocated
+   for the small sizes, the freed ones are kept in the cache of the current
+   thread */
+static bool
+alloc_and_free_blocks(int seed)
+{
+    std::vector<void *> blocks;
+
+    for (uint32_t size = 1; size <= 2048; size += 13 + seed) {
+        uint32_t count = 8192 / size < 20 ? 8192 / size + 1 : 20;
+
+        for (uint32_t i = 0; i < count; i++) {
+            void *ptr = wasm_runtime_malloc(size);
+
+            if (!ptr)
+                return false;
+            memset(ptr, seed, size);
+            blocks.push_back(ptr);
+        }
+        /* Free in another order than allocated */
+        for (size_t i = 0; i < blocks.size(); i += 2)
+            wasm_runtime_free(blocks[i]);
+        for (size_t i = 1; i < blocks.size(); i += 2)
+            wasm_runtime_free(blocks[i]);
+        blocks.clear();
+    }
+    return true;
+}
+
+static void *
+wasm_thread_callback(wasm_exec_env_t exec_env, void *arg)
+{
+    *(bool *)arg = alloc_and_free_blocks(3);
+    return NULL;
+}
+
+/* Create the exec_env of the main thread, spawn a thread with the runtime
+   and destroy the exec_env together with its cluster */
+static void
+spawn_and_join_thread(wasm_module_inst_t module_inst)
+{
+    wasm_exec_env_t exec_env;
+    wasm_thread_t tid;
+    bool ret = false;
+
+    exec_env = wasm_runtime_create_exec_env(module_inst, 8192);
+    ASSERT_NE(exec_env, nullptr);
+    ASSERT_EQ(wasm_runtime_spawn_thread(exec_env, &tid, wasm_thread_callback,
+                                        &ret),
+              0);
+    ASSERT_EQ(wasm_runtime_join_thread(tid, NULL), 0);
+    EXPECT_TRUE(ret);
+    wasm_runtime_destroy_exec_env(exec_env);
+}
+
+/* The destructor of a key created after the runtime is initialized, it
+   is called after the one flushing the cache of the exiting thread */
+static void
+free_block_on_thread_exit(void *ptr)
+{
+    wasm_runtime_free(ptr);
+    /* Allocate and free blocks again after the cache was flushed */
+    alloc_and_free_blocks(5);
+}
+
+class MemAllocThreadCacheTest : public testing::Test
+{
+  protected:
+    WAMRRuntimeRAII<512 * 1024> runtime;
+};
+
+TEST_F(MemAllocThreadCacheTest, flushed_by_destroy_thread_env)
+{
+    uint32_t free_size = get_free_size();
+    uint32_t free_size_cached = 0;
+    bool ret = false;
+
+    std::thread thread([&]() {
+        if (!wasm_runtime_init_thread_env())
+            return;
+        ret = alloc_and_free_blocks(1);
+        free_size_cached = get_free_size();
+        wasm_runtime_destroy_thread_env();
+    });
+    thread.join();
+
+    ASSERT_TRUE(ret);
+    /* The blocks were kept by the thread before it exited, and are all
+       returned to the pool */
+    ASSERT_LT(free_size_cached, free_size);
+    ASSERT_EQ(get_free_size(), free_size);
+}
+
+TEST_F(MemAllocThreadCacheTest, flushed_on_host_thread_exit)
+{
+    uint32_t free_size = get_free_size();
+    uint32_t free_size_cached = 0;
+    bool ret = false;
+
+    /* The thread exits without wasm_runtime_destroy_thread_env */
+    std::thread thread([&]() {
+        ret = alloc_and_free_blocks(4);
+        free_size_cached = get_free_size();
+    });
+    thread.join();
+
+    ASSERT_TRUE(ret);
+    ASSERT_LT(free_size_cached, free_size);
+    ASSERT_EQ(get_free_size(), free_size);
+}
+
+TEST_F(MemAllocThreadCacheTest, freed_to_cache_after_flushed_on_exit)
+{
+    uint32_t free_size = get_free_size();
+    pthread_key_t key;
+    bool ret = false;
+
+    ASSERT_EQ(pthread_key_create(&key, free_block_on_thread_exit), 0);
+
+    /* The block is freed by the destructor of the key after the cache
+       was flushed, which caches it again */
+    std::thread thread([&]() {
+        void *ptr = wasm_runtime_malloc(64);
+
+        if (!ptr)
+            return;
+        ret = alloc_and_free_blocks(6);
+        pthread_setspecific(key, ptr);
+    });
+    thread.join();
+    pthread_key_delete(key);
+
+    ASSERT_TRUE(ret);
+    ASSERT_EQ(get_free_size(), free_size);
+}
+
+TEST_F(MemAllocThreadCacheTest, flushed_by_current_thread)
+{
+    uint32_t free_size;
+
+    /* Drop the blocks cached by the main thread before measuring */
+    wasm_runtime_destroy_thread_env();
+    ASSERT_TRUE(wasm_runtime_init_thread_env());
+    free_size = get_free_size();
+
+    ASSERT_TRUE(alloc_and_free_blocks(2));
+    ASSERT_LT(get_free_size(), free_size);
+
+    /* The main thread may call it before releasing its resources too */
+    wasm_runtime_destroy_thread_env();
+    ASSERT_EQ(get_free_size(), free_size);
+    ASSERT_TRUE(wasm_runtime_init_thread_env());
+}
+
+TEST_F(MemAllocThreadCacheTest, blocks_freed_by_other_threads)
+{
+    std::vector<void *> blocks[THREAD_NUM];
+    std::vector<std::thread> threads;
+    bool ret[THREAD_NUM] = { false };
+    uint32_t free_size;
+
+    /* Drop the blocks cached by the main thread before measuring */
+    wasm_runtime_destroy_thread_env();
+    ASSERT_TRUE(wasm_runtime_init_thread_env());
+    free_size = get_free_size();
+
+    /* Each thread frees the blocks allocated by the previous one, so
+       that blocks are cached by a thread other than the allocating one */
+    for (int i = 0; i < THREAD_NUM; i++) {
+        for (uint32_t size = 8; size <= 1024; size += 128) {
+            void *ptr = wasm_runtime_malloc(size);
+            ASSERT_NE(ptr, nullptr);
+            blocks[i].push_back(ptr);
+        }
+    }
+
+    for (int i = 0; i < THREAD_NUM; i++) {
+        threads.emplace_back([&, i]() {
+            if (!wasm_runtime_init_thread_env())
+                return;
+            for (void *ptr : blocks[(i + 1) % THREAD_NUM])
+                wasm_runtime_free(ptr);
+            ret[i] = alloc_and_free_blocks(i);
+            wasm_runtime_destroy_thread_env();
+        });
+    }
+    for (std::thread &thread : threads)
+        thread.join();
+
+    for (int i = 0; i < THREAD_NUM; i++)
+        ASSERT_TRUE(ret[i]);
+
+    /* The blocks allocated by the main thread were all freed, and nothing
+       is kept by the exited threads once the blocks refilled to the cache
+       of the main thread are flushed */
+    wasm_runtime_destroy_thread_env();
+    ASSERT_TRUE(wasm_runtime_init_thread_env());
+    ASSERT_EQ(get_free_size(), free_size);
+
+    /* The pool is still usable as a whole after the flush */
+    void *ptr = wasm_runtime_malloc(get_free_size() / 2);
+    ASSERT_NE(ptr, nullptr);
+    wasm_runtime_free(ptr);
+}
+
+TEST_F(MemAllocThreadCacheTest, flushed_on_wasm_thread_exit)
+{
+    char error_buf[128] = { 0 };
+    wasm_module_t module;
+    wasm_module_inst_t module_inst;
+    uint32_t free_size;
+
+    module = wasm_runtime_load(thread_wasm, sizeof(thread_wasm), error_buf,
+                               sizeof(error_buf));
+    ASSERT_NE(module, nullptr) << error_buf;
+    module_inst =
+        wasm_runtime_instantiate(module, 8192, 0, error_buf, sizeof(error_buf));
+    ASSERT_NE(module_inst, nullptr) << error_buf;
+
+    /* Spawn a thread first, so that the memory kept by the runtime once
+       a thread was created isn't counted */
+    spawn_and_join_thread(module_inst);
+
+    wasm_runtime_destroy_thread_env();
+    ASSERT_TRUE(wasm_runtime_init_thread_env());
+    free_size = get_free_size();
+
+    /* The exec_env of the exited thread is kept until the cluster is
+       destroyed with the exec_env of the main thread, and the thread
+       created by the runtime flushes its cache when exiting */
+    spawn_and_join_thread(module_inst);
+
+    wasm_runtime_destroy_thread_env();
+    ASSERT_TRUE(wasm_runtime_init_thread_env());
+    ASSERT_EQ(get_free_size(), free_size);
+
+    wasm_runtime_deinstantiate(module_inst);
+    wasm_runtime_unload(module);
+}
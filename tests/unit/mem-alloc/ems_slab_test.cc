@@ -0,0 +1,262 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+
+#include <map>
+#include <random>
+#include <set>
+#include <vector>
+
+#include "mem_alloc.h"
+#include "ems/ems_gc_internal.h"
+
+#if BH_ENABLE_GC_SLAB != 0
+
+#define HEAP_SIZE (1024 * 1024)
+
+class EmsSlabTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        allocator = mem_allocator_create_gc_heap(heap_buf, sizeof(heap_buf));
+        ASSERT_NE(allocator, nullptr);
+        heap = (gc_heap_t *)allocator;
+        ASSERT_NE(heap->slab_map, nullptr);
+    }
+
+    void TearDown()
+    {
+        ASSERT_FALSE(mem_allocator_is_heap_corrupted(allocator));
+        mem_allocator_destroy(allocator);
+    }
+
+    gc_slab_page_t *get_page(void *ptr)
+    {
+        return gci_obj_to_slab_page(heap, (gc_object_t)ptr);
+    }
+
+    static uint32_t get_slot_size(uint32_t size)
+    {
+        return size > 0 ? ((size - 1) / 8 + 1) * 8 : 8;
+    }
+
+    static void fill(void *ptr, uint32_t size, uint8_t value)
+    {
+        memset(ptr, value, size);
+    }
+
+    static bool check(void *ptr, uint32_t size, uint8_t value)
+    {
+        for (uint32_t i = 0; i < size; i++) {
+            if (((uint8_t *)ptr)[i] != value)
+                return false;
+        }
+        return true;
+    }
+
+    /* Allocate a block of most of the free memory, which requires the
+       empty slab pages to be merged back with the free chunks */
+    bool alloc_most_of_heap()
+    {
+        uint32_t size = heap->total_free_size - 64 * 1024;
+        void *ptr = mem_allocator_malloc(allocator, size);
+
+        if (!ptr)
+            return false;
+        mem_allocator_free(allocator, ptr);
+        return true;
+    }
+
+    char heap_buf[HEAP_SIZE];
+    mem_allocator_t allocator;
+    gc_heap_t *heap;
+};
+
+TEST_F(EmsSlabTest, alloc_and_free_of_each_class)
+{
+    for (uint32_t size = 1; size <= GC_SLAB_MAX_OBJ_SIZE; size++) {
+        std::vector<void *> ptrs;
+        std::set<gc_slab_page_t *> pages;
+
+        /* More objects than a page holds */
+        for (uint32_t i = 0; i < 4096 / size + 16; i++) {
+            void *ptr = mem_allocator_malloc(allocator, size);
+            gc_slab_page_t *page = get_page(ptr);
+
+            ASSERT_NE(ptr, nullptr);
+            ASSERT_NE(page, nullptr) << "size " << size;
+            ASSERT_EQ(page->slot_size, get_slot_size(size));
+            ASSERT_EQ(mem_allocator_get_size(allocator, ptr),
+                      get_slot_size(size));
+            fill(ptr, size, (uint8_t)i);
+            ptrs.push_back(ptr);
+            pages.insert(page);
+        }
+        ASSERT_GT(pages.size(), 1u);
+        ASSERT_EQ(std::set<void *>(ptrs.begin(), ptrs.end()).size(),
+                  ptrs.size());
+
+        for (uint32_t i = 0; i < ptrs.size(); i++) {
+            ASSERT_TRUE(check(ptrs[i], size, (uint8_t)i));
+            mem_allocator_free(allocator, ptrs[i]);
+        }
+        ASSERT_LE(heap->slab_empty_cnt, GC_SLAB_EMPTY_PAGE_MAX(heap));
+    }
+
+    ASSERT_TRUE(alloc_most_of_heap());
+}
+
+TEST_F(EmsSlabTest, larger_objects_not_in_slab)
+{
+    void *ptr = mem_allocator_malloc(allocator, GC_SLAB_MAX_OBJ_SIZE + 1);
+
+    ASSERT_NE(ptr, nullptr);
+    ASSERT_EQ(get_page(ptr), nullptr);
+    mem_allocator_free(allocator, ptr);
+}
+
+TEST_F(EmsSlabTest, realloc_across_classes)
+{
+    /* Grown and shrunk within the slab, to and from a normal chunk */
+    static const uint32_t sizes[] = { 4,  8,   12, 40, 64, 65,  300, 64,
+                                      24, 100, 16, 1,  48, 2000, 8 };
+    uint32_t size = sizes[0];
+    void *ptr = mem_allocator_malloc(allocator, size);
+
+    ASSERT_NE(ptr, nullptr);
+    fill(ptr, size, 0x5a);
+    for (uint32_t i = 1; i < sizeof(sizes) / sizeof(sizes[0]); i++) {
+        uint32_t new_size = sizes[i];
+        gc_slab_page_t *page = get_page(ptr);
+        void *ptr_old = ptr;
+
+        ptr = mem_allocator_realloc(allocator, ptr, new_size);
+        ASSERT_NE(ptr, nullptr);
+        ASSERT_TRUE(check(ptr, std::min(size, new_size), 0x5a))
+            << size << " -> " << new_size;
+        if (page && new_size <= page->slot_size) {
+            /* The slot is kept if it is large enough */
+            ASSERT_EQ(ptr, ptr_old);
+        }
+        else if (page && new_size <= GC_SLAB_MAX_OBJ_SIZE) {
+            /* Moved to a slot of a larger class */
+            ASSERT_NE(get_page(ptr), nullptr);
+            ASSERT_EQ(get_page(ptr)->slot_size, get_slot_size(new_size));
+        }
+        else if (new_size > GC_SLAB_MAX_OBJ_SIZE) {
+            ASSERT_EQ(get_page(ptr), nullptr);
+        }
+        ASSERT_GE(mem_allocator_get_size(allocator, ptr), new_size);
+        fill(ptr, new_size, 0x5a);
+        size = new_size;
+    }
+    mem_allocator_free(allocator, ptr);
+
+    ASSERT_TRUE(alloc_most_of_heap());
+}
+
+TEST_F(EmsSlabTest, slot_freed_twice)
+{
+    void *ptr = mem_allocator_malloc(allocator, 16), *ptr1, *ptr2;
+
+    ASSERT_NE(ptr, nullptr);
+    mem_allocator_free(allocator, ptr);
+    /* Fails quietly without freeing the slot again */
+    mem_allocator_free(allocator, ptr);
+
+    ptr1 = mem_allocator_malloc(allocator, 16);
+    ptr2 = mem_allocator_malloc(allocator, 16);
+    ASSERT_NE(ptr1, nullptr);
+    ASSERT_NE(ptr2, nullptr);
+    ASSERT_NE(ptr1, ptr2);
+    mem_allocator_free(allocator, ptr1);
+    mem_allocator_free(allocator, ptr2);
+}
+
+TEST_F(EmsSlabTest, random_alloc_realloc_free)
+{
+    std::mt19937 rng(2024);
+    /* The live objects with their sizes and the bytes they are filled
+       with */
+    std::map<void *, std::pair<uint32_t, uint8_t>> objs;
+    std::vector<void *> ptrs;
+    gc_size_t free_size;
+    uint8_t value = 0;
+
+    for (int i = 0; i < 50000; i++) {
+        uint32_t op = rng() % 10;
+        uint32_t size = rng() % 4 ? rng() % 96 + 1 : rng() % 512 + 1;
+
+        if (ptrs.empty() || op < 4) {
+            void *ptr = mem_allocator_malloc(allocator, size);
+
+            ASSERT_NE(ptr, nullptr);
+            ASSERT_EQ(objs.count(ptr), 0u);
+            fill(ptr, size, ++value);
+            objs[ptr] = { size, value };
+            ptrs.push_back(ptr);
+        }
+        else {
+            uint32_t idx = rng() % ptrs.size();
+            void *ptr = ptrs[idx];
+            std::pair<uint32_t, uint8_t> obj = objs[ptr];
+
+            ASSERT_TRUE(check(ptr, obj.first, obj.second));
+            objs.erase(ptr);
+            if (op < 8) {
+                ptrs[idx] = ptrs.back();
+                ptrs.pop_back();
+                mem_allocator_free(allocator, ptr);
+            }
+            else {
+                ptr = mem_allocator_realloc(allocator, ptr, size);
+                ASSERT_NE(ptr, nullptr);
+                ASSERT_TRUE(
+                    check(ptr, std::min(size, obj.first), obj.second));
+                fill(ptr, size, obj.second);
+                objs[ptr] = { size, obj.second };
+                ptrs[idx] = ptr;
+            }
+        }
+    }
+    ASSERT_FALSE(mem_allocator_is_heap_corrupted(allocator));
+
+    for (void *ptr : ptrs) {
+        std::pair<uint32_t, uint8_t> obj = objs[ptr];
+
+        ASSERT_TRUE(check(ptr, obj.first, obj.second));
+        mem_allocator_free(allocator, ptr);
+    }
+
+    /* Only the kept empty slab pages aren't free */
+    free_size = heap->total_free_size;
+    ASSERT_LE(heap->current_size - free_size,
+              (GC_SLAB_EMPTY_PAGE_MAX(heap) + GC_SLAB_CLASS_NUM)
+                  * GC_SLAB_PAGE_SIZE);
+    ASSERT_TRUE(alloc_most_of_heap());
+}
+
+TEST_F(EmsSlabTest, only_gc_heaps_use_slab)
+{
+    static char other_heap_buf[HEAP_SIZE];
+    mem_allocator_t other_allocator =
+        mem_allocator_create(other_heap_buf, sizeof(other_heap_buf));
+    void *ptr;
+
+    ASSERT_NE(other_allocator, nullptr);
+    ASSERT_EQ(((gc_heap_t *)other_allocator)->slab_map, nullptr);
+
+    ptr = mem_allocator_malloc(other_allocator, 16);
+    ASSERT_NE(ptr, nullptr);
+    EXPECT_EQ(gci_obj_to_slab_page((gc_heap_t *)other_allocator,
+                                   (gc_object_t)ptr),
+              nullptr);
+    mem_allocator_free(other_allocator, ptr);
+    mem_allocator_destroy(other_allocator);
+}
+
+#endif /* end of BH_ENABLE_GC_SLAB != 0 */
@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+
+#include <set>
+#include <vector>
+
+#include "mem_alloc.h"
+#include "ems/ems_gc_internal.h"
+
+#define HEAP_SIZE (4 * 1024 * 1024)
+
+/* Chunk sizes of the free chunk tree, including the hmu header */
+#define CHUNK_SIZE_SMALL 768
+#define CHUNK_SIZE 1024
+#define CHUNK_SIZE_LARGE 2048
+#define CHUNK_NUM 512
+
+class EmsTreeTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        allocator = mem_allocator_create(heap_buf, sizeof(heap_buf));
+        ASSERT_NE(allocator, nullptr);
+        heap = (gc_heap_t *)allocator;
+    }
+
+    void TearDown()
+    {
+        ASSERT_FALSE(mem_allocator_is_heap_corrupted(allocator));
+        mem_allocator_destroy(allocator);
+    }
+
+    /* The object size to allocate a chunk of the size */
+    static uint32_t get_obj_size(uint32_t chunk_size)
+    {
+        return chunk_size - HMU_SIZE - OBJ_PREFIX_SIZE - OBJ_SUFFIX_SIZE;
+    }
+
+    /* Allocate a chunk followed by a used chunk, so that it isn't merged
+       with its neighbours when it is freed */
+    void *alloc_separated(uint32_t chunk_size)
+    {
+        void *ptr = mem_allocator_malloc(allocator, get_obj_size(chunk_size));
+
+        EXPECT_NE(ptr, nullptr);
+        separators.push_back(mem_allocator_malloc(allocator, 128));
+        EXPECT_NE(separators.back(), nullptr);
+        return ptr;
+    }
+
+    /* Check that the sizes of the left subtree are smaller than the node
+       size and those of the right subtree are larger, the chunks linked to
+       the node are of its size, and the parent links, return the number of
+       free chunks */
+    size_t check_tree(hmu_tree_node_t *node, hmu_tree_node_t *parent,
+                      gc_size_t min_exclusive, gc_size_t max_exclusive)
+    {
+        hmu_tree_node_t *same, *prev = parent;
+        size_t chunk_num = 0;
+
+        if (!node)
+            return 0;
+
+        EXPECT_GT(node->size, min_exclusive);
+        EXPECT_LT(node->size, max_exclusive);
+        for (same = node; same; prev = same, same = same->next_same) {
+            EXPECT_EQ(same->parent, prev);
+            EXPECT_EQ(same->size, node->size);
+            EXPECT_EQ(hmu_get_ut(&same->hmu_header), HMU_FC);
+            EXPECT_EQ(hmu_get_size(&same->hmu_header), node->size);
+            if (same != node) {
+                EXPECT_EQ(same->left, nullptr);
+                EXPECT_EQ(same->right, nullptr);
+            }
+            chunk_num++;
+        }
+        if (::testing::Test::HasFailure())
+            return 0;
+
+        return chunk_num
+               + check_tree(node->left, node, min_exclusive, node->size)
+               + check_tree(node->right, node, node->size, max_exclusive);
+    }
+
+    size_t check_tree()
+    {
+        hmu_tree_node_t *root = heap->kfc_tree_root;
+
+        return check_tree(root->right, root, root->size, UINT32_MAX);
+    }
+
+    /* The number of nodes visited by the best-fit search to find the
+       first node of the size */
+    uint32_t get_search_depth(gc_size_t size)
+    {
+        hmu_tree_node_t *node = heap->kfc_tree_root->right;
+        uint32_t depth = 1;
+
+        while (node && node->size != size) {
+            node = node->size < size ? node->right : node->left;
+            depth++;
+        }
+        return node ? depth : 0;
+    }
+
+    /* Return the number of free chunks of the size in the tree */
+    size_t count_chunks(gc_size_t size)
+    {
+        hmu_tree_node_t *node = heap->kfc_tree_root->right;
+        size_t chunk_num = 0;
+
+        while (node && node->size != size)
+            node = node->size < size ? node->right : node->left;
+        for (; node; node = node->next_same)
+            chunk_num++;
+        return chunk_num;
+    }
+
+    char heap_buf[HEAP_SIZE];
+    mem_allocator_t allocator;
+    gc_heap_t *heap;
+    std::vector<void *> separators;
+};
+
+TEST_F(EmsTreeTest, many_chunks_of_same_size)
+{
+    std::vector<void *> chunks, chunks_small, chunks_large;
+    std::set<void *> freed;
+    size_t node_num;
+
+    for (int i = 0; i < CHUNK_NUM; i++) {
+        chunks.push_back(alloc_separated(CHUNK_SIZE));
+        if (i % 64 == 0) {
+            chunks_small.push_back(alloc_separated(CHUNK_SIZE_SMALL));
+            chunks_large.push_back(alloc_separated(CHUNK_SIZE_LARGE));
+        }
+    }
+    ASSERT_FALSE(::testing::Test::HasFailure());
+
+    /* Only the free memory at the end of the heap is in the tree */
+    ASSERT_EQ(check_tree(), 1u);
+
+    for (void *ptr : chunks_large)
+        mem_allocator_free(allocator, ptr);
+    for (void *ptr : chunks) {
+        mem_allocator_free(allocator, ptr);
+        freed.insert(ptr);
+    }
+    for (void *ptr : chunks_small)
+        mem_allocator_free(allocator, ptr);
+
+    node_num = check_tree();
+    ASSERT_FALSE(::testing::Test::HasFailure());
+    ASSERT_EQ(node_num,
+              1 + chunks.size() + chunks_small.size() + chunks_large.size());
+    ASSERT_EQ(count_chunks(CHUNK_SIZE), chunks.size());
+    ASSERT_EQ(count_chunks(CHUNK_SIZE_SMALL), chunks_small.size());
+    ASSERT_EQ(count_chunks(CHUNK_SIZE_LARGE), chunks_large.size());
+
+    /* The chunks of one size don't make the tree deeper, there are only
+       three sizes and the free memory at the end of the heap */
+    ASSERT_GT(get_search_depth(CHUNK_SIZE), 0u);
+    ASSERT_LE(get_search_depth(CHUNK_SIZE), 4u);
+    ASSERT_GT(get_search_depth(CHUNK_SIZE_SMALL), 0u);
+    ASSERT_LE(get_search_depth(CHUNK_SIZE_SMALL), 4u);
+    ASSERT_GT(get_search_depth(CHUNK_SIZE_LARGE), 0u);
+    ASSERT_LE(get_search_depth(CHUNK_SIZE_LARGE), 4u);
+
+    /* The smallest chunk which fits is picked */
+    for (uint32_t chunk_size :
+         { CHUNK_SIZE_SMALL, CHUNK_SIZE - 128, CHUNK_SIZE, CHUNK_SIZE - 8 }) {
+        void *ptr = mem_allocator_malloc(allocator, get_obj_size(chunk_size));
+
+        ASSERT_NE(ptr, nullptr);
+        if (chunk_size == CHUNK_SIZE_SMALL) {
+            ASSERT_NE(std::find(chunks_small.begin(), chunks_small.end(), ptr),
+                      chunks_small.end());
+        }
+        else {
+            ASSERT_EQ(freed.count(ptr), 1u) << "chunk size " << chunk_size;
+            freed.erase(ptr);
+        }
+        ASSERT_GT(check_tree(), 0u);
+        ASSERT_FALSE(::testing::Test::HasFailure());
+    }
+
+    /* Take all the chunks of the size */
+    while (!freed.empty()) {
+        void *ptr = mem_allocator_malloc(allocator, get_obj_size(CHUNK_SIZE));
+
+        ASSERT_EQ(freed.count(ptr), 1u);
+        freed.erase(ptr);
+    }
+    check_tree();
+    ASSERT_FALSE(::testing::Test::HasFailure());
+    ASSERT_EQ(count_chunks(CHUNK_SIZE), 0u);
+
+    /* The next one is taken from a larger chunk */
+    void *ptr = mem_allocator_malloc(allocator, get_obj_size(CHUNK_SIZE));
+    ASSERT_NE(
+        std::find(chunks_large.begin(), chunks_large.end(), ptr),
+        chunks_large.end());
+}
+
+TEST_F(EmsTreeTest, remove_nodes_of_same_size)
+{
+    std::vector<void *> chunks;
+
+    for (int i = 0; i < CHUNK_NUM; i++)
+        chunks.push_back(alloc_separated(CHUNK_SIZE + (i % 4) * 64));
+    ASSERT_FALSE(::testing::Test::HasFailure());
+    for (void *ptr : chunks)
+        mem_allocator_free(allocator, ptr);
+    ASSERT_EQ(check_tree(), 1 + chunks.size());
+
+    /* Merging a free chunk with its neighbours removes the chunks of the
+       neighbours from the tree, which are tree nodes, or in the lists of
+       the same size at different positions */
+    for (size_t i = 0; i < separators.size(); i += 3) {
+        mem_allocator_free(allocator, separators[i]);
+        separators[i] = NULL;
+        check_tree();
+        ASSERT_FALSE(::testing::Test::HasFailure()) << "separator " << i;
+    }
+    ASSERT_EQ(check_tree(), 1 + chunks.size() - (separators.size() + 2) / 3);
+
+    for (void *ptr : separators) {
+        if (ptr)
+            mem_allocator_free(allocator, ptr);
+    }
+    /* All merged into one chunk */
+    ASSERT_EQ(check_tree(), 1u);
+}
@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+#include "wasm_export.h"
+#include "wasm.h"
+
+/* (module
+     (import "env" "buf" (func $buf (param i32 i32) (result i32)))
+     (import "env" "str" (func $str (param i32) (result i32)))
+     (import "env" "addr" (func $addr (param i32) (result i32)))
+     (import "env" "mixed"
+       (func $mixed (param i32 i32 i32 i32 i32 i32 i32 i32 i32 i32
+                           f32 f64 i64 f64) (result f64)))
+     (import "env" "many" (func $many (param i32 ... i32) (result i32)))
+     (import "env" "nosig" (func $nosig (param i32) (result i32)))
+     (memory 1)
+     ;; call_<name> forwards its params to the import <name>
+     (func (export "call_buf") (param i32 i32) (result i32)
+       (call $buf (local.get 0) (local.get 1)))
+     ...
+   )
+   where $many has 30 i32 params */
+static uint8_t native_call_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x4a, 0x06, 0x60,
+    0x02, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f, 0x60, 0x01,
+    0x7f, 0x01, 0x7f, 0x60, 0x0e, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f,
+    0x7f, 0x7f, 0x7f, 0x7d, 0x7c, 0x7e, 0x7c, 0x01, 0x7c, 0x60, 0x1e, 0x7f,
+    0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f,
+    0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x7f,
+    0x7f, 0x7f, 0x7f, 0x7f, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7f, 0x01, 0x7f,
+    0x02, 0x43, 0x06, 0x03, 0x65, 0x6e, 0x76, 0x03, 0x62, 0x75, 0x66, 0x00,
+    0x00, 0x03, 0x65, 0x6e, 0x76, 0x03, 0x73, 0x74, 0x72, 0x00, 0x01, 0x03,
+    0x65, 0x6e, 0x76, 0x04, 0x61, 0x64, 0x64, 0x72, 0x00, 0x02, 0x03, 0x65,
+    0x6e, 0x76, 0x05, 0x6d, 0x69, 0x78, 0x65, 0x64, 0x00, 0x03, 0x03, 0x65,
+    0x6e, 0x76, 0x04, 0x6d, 0x61, 0x6e, 0x79, 0x00, 0x04, 0x03, 0x65, 0x6e,
+    0x76, 0x05, 0x6e, 0x6f, 0x73, 0x69, 0x67, 0x00, 0x05, 0x03, 0x07, 0x06,
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x05, 0x03, 0x01, 0x00, 0x01, 0x07,
+    0x49, 0x06, 0x08, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x62, 0x75, 0x66, 0x00,
+    0x06, 0x08, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x73, 0x74, 0x72, 0x00, 0x07,
+    0x09, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x61, 0x64, 0x64, 0x72, 0x00, 0x08,
+    0x0a, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x6d, 0x69, 0x78, 0x65, 0x64, 0x00,
+    0x09, 0x09, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x6d, 0x61, 0x6e, 0x79, 0x00,
+    0x0a, 0x0a, 0x63, 0x61, 0x6c, 0x6c, 0x5f, 0x6e, 0x6f, 0x73, 0x69, 0x67,
+    0x00, 0x0b, 0x0a, 0x81, 0x01, 0x06, 0x08, 0x00, 0x20, 0x00, 0x20, 0x01,
+    0x10, 0x00, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x10, 0x01, 0x0b, 0x06, 0x00,
+    0x20, 0x00, 0x10, 0x02, 0x0b, 0x20, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20,
+    0x02, 0x20, 0x03, 0x20, 0x04, 0x20, 0x05, 0x20, 0x06, 0x20, 0x07, 0x20,
+    0x08, 0x20, 0x09, 0x20, 0x0a, 0x20, 0x0b, 0x20, 0x0c, 0x20, 0x0d, 0x10,
+    0x03, 0x0b, 0x40, 0x00, 0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0x20, 0x03,
+    0x20, 0x04, 0x20, 0x05, 0x20, 0x06, 0x20, 0x07, 0x20, 0x08, 0x20, 0x09,
+    0x20, 0x0a, 0x20, 0x0b, 0x20, 0x0c, 0x20, 0x0d, 0x20, 0x0e, 0x20, 0x0f,
+    0x20, 0x10, 0x20, 0x11, 0x20, 0x12, 0x20, 0x13, 0x20, 0x14, 0x20, 0x15,
+    0x20, 0x16, 0x20, 0x17, 0x20, 0x18, 0x20, 0x19, 0x20, 0x1a, 0x20, 0x1b,
+    0x20, 0x1c, 0x20, 0x1d, 0x10, 0x04, 0x0b, 0x06, 0x00, 0x20, 0x00, 0x10,
+    0x05, 0x0b,
+};
+
+#define SHARED_HEAP_SIZE (64 * 1024)
+
+/* The native address and the length received by the last native call */
+static void *last_native_addr;
+static uint32_t last_len;
+static uint32_t native_call_count;
+static int attachment;
+
+static uint32_t
+buf_native(wasm_exec_env_t exec_env, uint8_t *buf, uint32_t len)
+{
+    uint32_t sum = 0;
+
+    EXPECT_EQ(wasm_runtime_get_function_attachment(exec_env), &attachment);
+    native_call_count++;
+    last_native_addr = buf;
+    last_len = len;
+    for (uint32_t i = 0; i < len; i++)
+        sum += buf[i];
+    return sum;
+}
+
+static uint32_t
+str_native(wasm_exec_env_t exec_env, const char *str)
+{
+    native_call_count++;
+    last_native_addr = (void *)str;
+    return (uint32_t)strlen(str);
+}
+
+static uint32_t
+addr_native(wasm_exec_env_t exec_env, uint8_t *addr)
+{
+    native_call_count++;
+    last_native_addr = addr;
+    return *addr;
+}
+
+static double
+mixed_native(wasm_exec_env_t exec_env, int32_t a0, int32_t a1, int32_t a2,
+             int32_t a3, int32_t a4, int32_t a5, int32_t a6, int32_t a7,
+             int32_t a8, int32_t a9, float f, double d, int64_t l, double d2)
+{
+    int32_t ints[] = { a0, a1, a2, a3, a4, a5, a6, a7, a8, a9 };
+    double ret = 0;
+
+    native_call_count++;
+    /* Each argument is weighted, so a misplaced one changes the result */
+    for (int i = 0; i < 10; i++)
+        ret = ret * 2 + ints[i];
+    return ret * 4 + f * 3 + d * 5 + (double)l * 7 + d2 * 11;
+}
+
+static uint32_t
+many_native(wasm_exec_env_t exec_env, uint32_t a0, uint32_t a1, uint32_t a2,
+            uint32_t a3, uint32_t a4, uint32_t a5, uint32_t a6, uint32_t a7,
+            uint32_t a8, uint32_t a9, uint32_t a10, uint32_t a11,
+            uint32_t a12, uint32_t a13, uint32_t a14, uint32_t a15,
+            uint32_t a16, uint32_t a17, uint32_t a18, uint32_t a19,
+            uint32_t a20, uint32_t a21, uint32_t a22, uint32_t a23,
+            uint32_t a24, uint32_t a25, uint32_t a26, uint32_t a27,
+            uint32_t a28, uint32_t a29)
+{
+    uint32_t args[] = { a0,  a1,  a2,  a3,  a4,  a5,  a6,  a7,  a8,  a9,
+                        a10, a11, a12, a13, a14, a15, a16, a17, a18, a19,
+                        a20, a21, a22, a23, a24, a25, a26, a27, a28, a29 };
+    uint32_t ret = 0;
+
+    native_call_count++;
+    for (int i = 0; i < 30; i++)
+        ret = ret * 31 + args[i];
+    return ret;
+}
+
+static uint32_t
+nosig_native(wasm_exec_env_t exec_env, uint32_t value)
+{
+    native_call_count++;
+    return value;
+}
+
+static NativeSymbol native_symbols[] = {
+    { "buf", (void *)buf_native, "(*~)i", &attachment },
+    { "str", (void *)str_native, "($)i", NULL },
+    { "addr", (void *)addr_native, "(*)i", NULL },
+    { "mixed", (void *)mixed_native, "(iiiiiiiiiifFIF)F", NULL },
+    { "many", (void *)many_native, "(iiiiiiiiiiiiiiiiiiiiiiiiiiiiii)i",
+      NULL },
+    /* Without signature, the app addresses aren't converted */
+    { "nosig", (void *)nosig_native, NULL, NULL },
+};
+
+class NativeCallDescTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        RuntimeInitArgs init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+        ASSERT_TRUE(wasm_runtime_register_natives(
+            "env", native_symbols,
+            sizeof(native_symbols) / sizeof(NativeSymbol)));
+
+        /* The loader rewrites the buffer, so it is loaded from a copy */
+        wasm_buf.assign(native_call_wasm,
+                        native_call_wasm + sizeof(native_call_wasm));
+        module = wasm_runtime_load(wasm_buf.data(), wasm_buf.size(),
+                                   error_buf, sizeof(error_buf));
+        ASSERT_NE(module, nullptr) << error_buf;
+
+        module_inst = wasm_runtime_instantiate(module, 8 * 1024, 8 * 1024,
+                                               error_buf, sizeof(error_buf));
+        ASSERT_NE(module_inst, nullptr) << error_buf;
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8 * 1024);
+        ASSERT_NE(exec_env, nullptr);
+
+        /* The linear memory is enlarged by the app heap */
+        ASSERT_TRUE(wasm_runtime_get_app_addr_range(module_inst, 0, NULL,
+                                                    &mem_size));
+
+        native_call_count = 0;
+        last_native_addr = NULL;
+        last_len = 0;
+    }
+
+    void TearDown()
+    {
+        if (exec_env)
+            wasm_runtime_destroy_exec_env(exec_env);
+        if (module_inst)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        wasm_runtime_destroy();
+    }
+
+    /* Call the wrapper of the import, return false and clear the
+       exception if the arguments are rejected */
+    bool call(const char *name, wasm_val_t *args, uint32_t num_args,
+              wasm_val_t *result)
+    {
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+        const char *exception;
+
+        EXPECT_NE(func, nullptr) << name;
+        if (wasm_runtime_call_wasm_a(exec_env, func, 1, result, num_args,
+                                     args))
+            return true;
+
+        exception = wasm_runtime_get_exception(module_inst);
+        EXPECT_NE(exception, nullptr);
+        if (exception)
+            EXPECT_NE(strstr(exception, "out of bounds memory access"),
+                      nullptr)
+                << exception;
+        wasm_runtime_clear_exception(module_inst);
+        return false;
+    }
+
+    bool call_i32(const char *name, uint32_t arg, uint32_t *p_ret)
+    {
+        wasm_val_t args[1], result;
+
+        args[0].kind = WASM_I32;
+        args[0].of.i32 = (int32_t)arg;
+        if (!call(name, args, 1, &result))
+            return false;
+        *p_ret = (uint32_t)result.of.i32;
+        return true;
+    }
+
+    bool call_buf(uint64_t app_addr, uint32_t len, uint32_t *p_ret)
+    {
+        wasm_val_t args[2], result;
+
+        args[0].kind = WASM_I32;
+        args[0].of.i32 = (int32_t)app_addr;
+        args[1].kind = WASM_I32;
+        args[1].of.i32 = (int32_t)len;
+        if (!call("call_buf", args, 2, &result))
+            return false;
+        *p_ret = (uint32_t)result.of.i32;
+        return true;
+    }
+
+    char error_buf[128] = { 0 };
+    std::vector<uint8_t> wasm_buf;
+    wasm_module_t module = nullptr;
+    wasm_module_inst_t module_inst = nullptr;
+    wasm_exec_env_t exec_env = nullptr;
+    uint64_t mem_size = 0;
+};
+
+TEST_F(NativeCallDescTest, descriptors_compiled_at_load)
+{
+    WASMModule *wasm_module = (WASMModule *)module;
+
+    ASSERT_EQ(wasm_module->import_function_count, 6u);
+#if defined(BUILD_TARGET_X86_64) || defined(BUILD_TARGET_AMD_64) \
+    || defined(BUILD_TARGET_AARCH64)
+    /* All the shapes are compiled on the 64-bit targets */
+    for (uint32_t i = 0; i < wasm_module->import_function_count; i++) {
+        ASSERT_NE(wasm_module->import_functions[i].u.function.call_desc,
+                  nullptr)
+            << wasm_module->import_functions[i].u.function.field_name;
+    }
+#endif
+}
+
+TEST_F(NativeCallDescTest, app_addrs_in_linear_memory)
+{
+    uint8_t *memory_data;
+    uint64_t app_addr;
+    uint32_t ret;
+    void *native;
+
+    app_addr = wasm_runtime_module_malloc(module_inst, 16, &native);
+    ASSERT_NE(app_addr, 0u);
+    strcpy((char *)native, "hello");
+
+    ASSERT_TRUE(call_buf(app_addr, 5, &ret));
+    ASSERT_EQ(ret, (uint32_t)('h' + 'e' + 'l' + 'l' + 'o'));
+    ASSERT_EQ(last_native_addr, native);
+    ASSERT_EQ(last_len, 5u);
+
+    ASSERT_TRUE(call_i32("call_str", (uint32_t)app_addr, &ret));
+    ASSERT_EQ(ret, 5u);
+    ASSERT_EQ(last_native_addr, native);
+
+    ASSERT_TRUE(call_i32("call_addr", (uint32_t)app_addr + 1, &ret));
+    ASSERT_EQ(ret, (uint32_t)'e');
+    ASSERT_EQ(last_native_addr, (uint8_t *)native + 1);
+
+    /* The last bytes of the linear memory */
+    memory_data = (uint8_t *)wasm_runtime_addr_app_to_native(module_inst, 0);
+    memory_data[mem_size - 2] = 'x';
+    memory_data[mem_size - 1] = '\0';
+    ASSERT_TRUE(call_buf(mem_size - 2, 2, &ret));
+    ASSERT_EQ(ret, (uint32_t)'x');
+    ASSERT_TRUE(call_i32("call_str", mem_size - 2, &ret));
+    ASSERT_EQ(ret, 1u);
+    ASSERT_TRUE(call_i32("call_addr", mem_size - 2, &ret));
+    ASSERT_EQ(ret, (uint32_t)'x');
+    ASSERT_EQ(native_call_count, 6u);
+
+    wasm_runtime_module_free(module_inst, app_addr);
+}
+
+/* The app addresses not in the linear memory are left to the generic
+   validation, which rejects them before the native is called */
+TEST_F(NativeCallDescTest, invalid_app_addrs_rejected)
+{
+    uint8_t *memory_data;
+    uint32_t ret;
+
+    memory_data = (uint8_t *)wasm_runtime_addr_app_to_native(module_inst, 0);
+    memset(memory_data + mem_size - 4, 'x', 4);
+
+    ASSERT_FALSE(call_buf(mem_size - 4, 5, &ret));
+    ASSERT_FALSE(call_buf(mem_size, 1, &ret));
+    ASSERT_FALSE(call_buf(16, UINT32_MAX, &ret));
+    ASSERT_FALSE(call_buf(UINT32_MAX, 1, &ret));
+    /* Not terminated before the end of the linear memory */
+    ASSERT_FALSE(call_i32("call_str", mem_size - 4, &ret));
+    ASSERT_FALSE(call_i32("call_str", mem_size, &ret));
+    ASSERT_FALSE(call_i32("call_addr", mem_size, &ret));
+    ASSERT_FALSE(call_i32("call_addr", UINT32_MAX, &ret));
+    ASSERT_EQ(native_call_count, 0u);
+
+    /* The module instance is still usable */
+    ASSERT_TRUE(call_buf(mem_size - 4, 4, &ret));
+    ASSERT_EQ(ret, 4u * 'x');
+}
+
+TEST_F(NativeCallDescTest, app_addrs_in_shared_heap)
+{
+    SharedHeapInitArgs heap_init_args;
+    wasm_shared_heap_t shared_heap;
+    uint64_t app_addr, end_addr;
+    uint8_t *native_end;
+    uint32_t ret;
+    void *native;
+
+    heap_init_args.size = SHARED_HEAP_SIZE;
+    shared_heap = wasm_runtime_create_shared_heap(&heap_init_args);
+    ASSERT_NE(shared_heap, nullptr);
+
+    app_addr = wasm_runtime_shared_heap_malloc(shared_heap, 16, &native);
+    ASSERT_NE(app_addr, 0u);
+    strcpy((char *)native, "shared");
+
+    /* Rejected until the heap is attached */
+    ASSERT_FALSE(call_buf(app_addr, 6, &ret));
+    ASSERT_FALSE(call_i32("call_str", (uint32_t)app_addr, &ret));
+    ASSERT_EQ(native_call_count, 0u);
+
+    ASSERT_TRUE(wasm_runtime_attach_shared_heap(module_inst, shared_heap));
+
+    ASSERT_TRUE(call_buf(app_addr, 6, &ret));
+    ASSERT_EQ(ret, (uint32_t)('s' + 'h' + 'a' + 'r' + 'e' + 'd'));
+    ASSERT_EQ(last_native_addr, native);
+    ASSERT_TRUE(call_i32("call_str", (uint32_t)app_addr, &ret));
+    ASSERT_EQ(ret, 6u);
+    ASSERT_EQ(last_native_addr, native);
+    ASSERT_TRUE(call_i32("call_addr", (uint32_t)app_addr + 2, &ret));
+    ASSERT_EQ(ret, (uint32_t)'a');
+    ASSERT_EQ(native_call_count, 3u);
+
+    /* Across the end of the heap, and not terminated before it */
+    end_addr = (uint64_t)UINT32_MAX + 1;
+    native_end = (uint8_t *)wasm_runtime_addr_app_to_native(module_inst,
+                                                            end_addr - 4);
+    ASSERT_NE(native_end, nullptr);
+    memset(native_end, 'y', 4);
+    ASSERT_TRUE(call_buf(end_addr - 4, 4, &ret));
+    ASSERT_EQ(ret, 4u * 'y');
+    ASSERT_FALSE(call_buf(end_addr - 4, 5, &ret));
+    ASSERT_FALSE(call_i32("call_str", (uint32_t)(end_addr - 4), &ret));
+    ASSERT_EQ(native_call_count, 4u);
+
+    wasm_runtime_detach_shared_heap(module_inst);
+    ASSERT_FALSE(call_buf(app_addr, 6, &ret));
+    ASSERT_TRUE(wasm_runtime_destroy_shared_heap(shared_heap));
+}
+
+TEST_F(NativeCallDescTest, args_placed)
+{
+    wasm_val_t args[30], result;
+    double expected_f64 = 0;
+    uint32_t expected = 0, ret;
+
+    /* The ints in the registers and in the stack, and the floats */
+    for (int i = 0; i < 10; i++) {
+        args[i].kind = WASM_I32;
+        args[i].of.i32 = i + 1;
+        expected_f64 = expected_f64 * 2 + (i + 1);
+    }
+    args[10].kind = WASM_F32;
+    args[10].of.f32 = 0.5f;
+    args[11].kind = WASM_F64;
+    args[11].of.f64 = 0.25;
+    args[12].kind = WASM_I64;
+    args[12].of.i64 = (int64_t)1 << 40;
+    args[13].kind = WASM_F64;
+    args[13].of.f64 = -8;
+    expected_f64 =
+        expected_f64 * 4 + 0.5 * 3 + 0.25 * 5 + (double)((int64_t)1 << 40) * 7
+        - 8 * 11;
+    ASSERT_TRUE(call("call_mixed", args, 14, &result));
+    ASSERT_EQ(result.kind, WASM_F64);
+    ASSERT_EQ(result.of.f64, expected_f64);
+
+    /* More arguments than the buffer on the stack holds */
+    for (int i = 0; i < 30; i++) {
+        args[i].kind = WASM_I32;
+        args[i].of.i32 = i * 7 + 3;
+        expected = expected * 31 + (uint32_t)(i * 7 + 3);
+    }
+    ASSERT_TRUE(call("call_many", args, 30, &result));
+    ASSERT_EQ((uint32_t)result.of.i32, expected);
+
+    /* Passed as is without signature */
+    ASSERT_TRUE(call_i32("call_nosig", UINT32_MAX - 1, &ret));
+    ASSERT_EQ(ret, UINT32_MAX - 1);
+    ASSERT_EQ(native_call_count, 3u);
+}
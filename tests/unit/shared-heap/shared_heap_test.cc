@@ -0,0 +1,404 @@
+/*
+ * Copyright (C) 2019 Intel Corporation. All rights reserved.
+ * SPDX-License-Identifier: Apache-2.0 WITH LLVM-exception
+ */
+
+#include "gtest/gtest.h"
+
+#include <list>
+#include <vector>
+
+#include "wasm_export.h"
+
+/* (module
+     (memory 1)
+     (func (export "load") (param i32) (result i32)
+       (i32.load (local.get 0)))
+     (func (export "store") (param i32 i32)
+       (i32.store (local.get 0) (local.get 1)))
+     (func (export "load16") (param i32) (result i32)
+       (i32.load offset=16 (local.get 0)))
+     (func (export "fill") (param i32 i32 i32)
+       (memory.fill (local.get 0) (local.get 1) (local.get 2)))
+     (func (export "copy") (param i32 i32 i32)
+       (memory.copy (local.get 0) (local.get 1) (local.get 2)))
+     (func (export "grow") (param i32) (result i32)
+       (memory.grow (local.get 0)))
+   ) */
+static uint8_t shared_heap_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x11, 0x03, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x60, 0x02, 0x7f, 0x7f, 0x00, 0x60, 0x03, 0x7f,
+    0x7f, 0x7f, 0x00, 0x03, 0x07, 0x06, 0x00, 0x01, 0x00, 0x02, 0x02, 0x00,
+    0x05, 0x03, 0x01, 0x00, 0x01, 0x07, 0x2e, 0x06, 0x04, 0x6c, 0x6f, 0x61,
+    0x64, 0x00, 0x00, 0x05, 0x73, 0x74, 0x6f, 0x72, 0x65, 0x00, 0x01, 0x06,
+    0x6c, 0x6f, 0x61, 0x64, 0x31, 0x36, 0x00, 0x02, 0x04, 0x66, 0x69, 0x6c,
+    0x6c, 0x00, 0x03, 0x04, 0x63, 0x6f, 0x70, 0x79, 0x00, 0x04, 0x04, 0x67,
+    0x72, 0x6f, 0x77, 0x00, 0x05, 0x0a, 0x3b, 0x06, 0x07, 0x00, 0x20, 0x00,
+    0x28, 0x02, 0x00, 0x0b, 0x09, 0x00, 0x20, 0x00, 0x20, 0x01, 0x36, 0x02,
+    0x00, 0x0b, 0x07, 0x00, 0x20, 0x00, 0x28, 0x02, 0x10, 0x0b, 0x0b, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0b, 0x00, 0x0b, 0x0c, 0x00,
+    0x20, 0x00, 0x20, 0x01, 0x20, 0x02, 0xfc, 0x0a, 0x00, 0x00, 0x0b, 0x06,
+    0x00, 0x20, 0x00, 0x40, 0x00, 0x0b,
+};
+
+/* (module (func (export "f"))) */
+static uint8_t no_memory_wasm[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x04, 0x01, 0x60,
+    0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0x07, 0x05, 0x01, 0x01, 0x66, 0x00,
+    0x00, 0x0a, 0x04, 0x01, 0x02, 0x00, 0x0b,
+};
+
+#define HEAP_SIZE (64 * 1024)
+/* The heap is mapped at the top of the 32-bit app address space */
+#define HEAP_START ((uint32_t)((uint64_t)UINT32_MAX + 1 - HEAP_SIZE))
+#define LINEAR_MEM_SIZE (64 * 1024)
+
+class SharedHeapTest : public testing::Test
+{
+  protected:
+    void SetUp()
+    {
+        RuntimeInitArgs init_args;
+        SharedHeapInitArgs heap_init_args;
+
+        memset(&init_args, 0, sizeof(RuntimeInitArgs));
+        init_args.mem_alloc_type = Alloc_With_System_Allocator;
+        ASSERT_TRUE(wasm_runtime_full_init(&init_args));
+
+        module = load(shared_heap_wasm, sizeof(shared_heap_wasm));
+        ASSERT_NE(module, nullptr);
+
+        heap_init_args.size = HEAP_SIZE;
+        shared_heap = wasm_runtime_create_shared_heap(&heap_init_args);
+        ASSERT_NE(shared_heap, nullptr);
+    }
+
+    void TearDown()
+    {
+        for (wasm_exec_env_t exec_env : exec_envs)
+            wasm_runtime_destroy_exec_env(exec_env);
+        for (wasm_module_inst_t module_inst : module_insts)
+            wasm_runtime_deinstantiate(module_inst);
+        if (module)
+            wasm_runtime_unload(module);
+        /* The heaps not destroyed are released by the runtime */
+        wasm_runtime_destroy();
+    }
+
+    /* The loader rewrites the buffer, so each load uses a fresh copy */
+    wasm_module_t load(uint8_t *wasm, uint32_t size)
+    {
+        std::vector<uint8_t> &wasm_buf =
+            wasm_bufs.emplace_back(wasm, wasm + size);
+        wasm_module_t loaded = wasm_runtime_load(
+            wasm_buf.data(), wasm_buf.size(), error_buf, sizeof(error_buf));
+
+        EXPECT_NE(loaded, nullptr) << error_buf;
+        return loaded;
+    }
+
+    wasm_exec_env_t instantiate()
+    {
+        wasm_module_inst_t module_inst = wasm_runtime_instantiate(
+            module, 8 * 1024, 0, error_buf, sizeof(error_buf));
+        wasm_exec_env_t exec_env;
+
+        EXPECT_NE(module_inst, nullptr) << error_buf;
+        if (!module_inst)
+            return nullptr;
+        module_insts.push_back(module_inst);
+
+        exec_env = wasm_runtime_create_exec_env(module_inst, 8 * 1024);
+        EXPECT_NE(exec_env, nullptr);
+        if (exec_env)
+            exec_envs.push_back(exec_env);
+        return exec_env;
+    }
+
+    /* Call the function, return false and clear the exception if it
+       traps on an out of bounds access */
+    static bool call(wasm_exec_env_t exec_env, const char *name,
+                     uint32_t *argv, uint32_t argc)
+    {
+        wasm_module_inst_t module_inst =
+            wasm_runtime_get_module_inst(exec_env);
+        wasm_function_inst_t func =
+            wasm_runtime_lookup_function(module_inst, name);
+        const char *exception;
+
+        EXPECT_NE(func, nullptr) << name;
+        if (wasm_runtime_call_wasm(exec_env, func, argc, argv))
+            return true;
+
+        exception = wasm_runtime_get_exception(module_inst);
+        EXPECT_NE(exception, nullptr);
+        if (exception)
+            EXPECT_NE(strstr(exception, "out of bounds memory access"),
+                      nullptr)
+                << exception;
+        wasm_runtime_clear_exception(module_inst);
+        return false;
+    }
+
+    static bool load_i32(wasm_exec_env_t exec_env, uint32_t addr,
+                         uint32_t *p_value)
+    {
+        uint32_t argv[1] = { addr };
+
+        if (!call(exec_env, "load", argv, 1))
+            return false;
+        *p_value = argv[0];
+        return true;
+    }
+
+    static bool store_i32(wasm_exec_env_t exec_env, uint32_t addr,
+                          uint32_t value)
+    {
+        uint32_t argv[2] = { addr, value };
+
+        return call(exec_env, "store", argv, 2);
+    }
+
+    static bool call3(wasm_exec_env_t exec_env, const char *name, uint32_t a,
+                      uint32_t b, uint32_t c)
+    {
+        uint32_t argv[3] = { a, b, c };
+
+        return call(exec_env, name, argv, 3);
+    }
+
+    char error_buf[128] = { 0 };
+    std::list<std::vector<uint8_t>> wasm_bufs;
+    std::vector<wasm_module_inst_t> module_insts;
+    std::vector<wasm_exec_env_t> exec_envs;
+    wasm_module_t module = nullptr;
+    wasm_shared_heap_t shared_heap = nullptr;
+};
+
+TEST_F(SharedHeapTest, accessed_in_place_by_instances)
+{
+    wasm_exec_env_t exec_envs[2];
+    wasm_module_inst_t module_insts[2];
+    uint8_t *native_addr;
+    uint32_t *words, value;
+    uint64_t app_addr;
+    void *native;
+
+    for (int i = 0; i < 2; i++) {
+        exec_envs[i] = instantiate();
+        ASSERT_NE(exec_envs[i], nullptr);
+        module_insts[i] = wasm_runtime_get_module_inst(exec_envs[i]);
+        ASSERT_TRUE(
+            wasm_runtime_attach_shared_heap(module_insts[i], shared_heap));
+    }
+
+    app_addr = wasm_runtime_shared_heap_malloc(shared_heap, 256, &native);
+    ASSERT_GE(app_addr, HEAP_START);
+    ASSERT_NE(native, nullptr);
+    native_addr = (uint8_t *)native;
+    words = (uint32_t *)native;
+
+    /* The app address maps to the same buffer in both instances */
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(wasm_runtime_validate_app_addr(module_insts[i], app_addr,
+                                                   256));
+        ASSERT_FALSE(wasm_runtime_validate_app_addr(
+            module_insts[i], HEAP_START + HEAP_SIZE - 4, 8));
+        /* The exception thrown by the failed validation */
+        wasm_runtime_clear_exception(module_insts[i]);
+        ASSERT_EQ(wasm_runtime_addr_app_to_native(module_insts[i], app_addr),
+                  native);
+        ASSERT_EQ(wasm_runtime_addr_native_to_app(module_insts[i],
+                                                  native_addr + 8),
+                  app_addr + 8);
+    }
+
+    /* Written by the host, read by the wasm code */
+    words[0] = 0x12345678;
+    for (int i = 0; i < 2; i++) {
+        ASSERT_TRUE(load_i32(exec_envs[i], (uint32_t)app_addr, &value));
+        ASSERT_EQ(value, 0x12345678u);
+    }
+
+    /* Written by one instance, read by the other one and the host */
+    ASSERT_TRUE(store_i32(exec_envs[0], (uint32_t)app_addr + 4, 0xcafe));
+    ASSERT_TRUE(load_i32(exec_envs[1], (uint32_t)app_addr + 4, &value));
+    ASSERT_EQ(value, 0xcafeu);
+    ASSERT_EQ(words[1], 0xcafeu);
+    {
+        uint32_t argv[1] = { (uint32_t)app_addr - 16 + 4 };
+
+        ASSERT_TRUE(call(exec_envs[1], "load16", argv, 1));
+        ASSERT_EQ(argv[0], 0xcafeu);
+    }
+
+    /* Bulk memory operations in the heap, and between the heap and the
+       linear memory */
+    ASSERT_TRUE(call3(exec_envs[0], "fill", (uint32_t)app_addr + 16, 0xab, 64));
+    ASSERT_TRUE(call3(exec_envs[1], "copy", (uint32_t)app_addr + 128,
+                      (uint32_t)app_addr + 16, 64));
+    for (int i = 0; i < 64; i++) {
+        ASSERT_EQ(native_addr[16 + i], 0xab) << i;
+        ASSERT_EQ(native_addr[128 + i], 0xab) << i;
+    }
+    ASSERT_TRUE(store_i32(exec_envs[0], 1024, 0x55aa55aa));
+    ASSERT_TRUE(
+        call3(exec_envs[0], "copy", (uint32_t)app_addr + 8, 1024, 4));
+    ASSERT_EQ(words[2], 0x55aa55aau);
+    ASSERT_TRUE(
+        call3(exec_envs[1], "copy", 2048, (uint32_t)app_addr + 8, 4));
+    ASSERT_TRUE(load_i32(exec_envs[1], 2048, &value));
+    ASSERT_EQ(value, 0x55aa55aau);
+
+    /* The linear memories stay private */
+    ASSERT_TRUE(load_i32(exec_envs[1], 1024, &value));
+    ASSERT_EQ(value, 0u);
+
+    wasm_runtime_shared_heap_free(shared_heap, app_addr);
+
+    /* Allocations larger than the heap fail */
+    ASSERT_EQ(wasm_runtime_shared_heap_malloc(shared_heap, HEAP_SIZE, &native),
+              0u);
+    ASSERT_EQ(native, nullptr);
+}
+
+TEST_F(SharedHeapTest, out_of_bounds_accesses_trapped)
+{
+    wasm_exec_env_t exec_env = instantiate();
+    wasm_module_inst_t module_inst;
+    uint32_t value, argv[1];
+
+    ASSERT_NE(exec_env, nullptr);
+    module_inst = wasm_runtime_get_module_inst(exec_env);
+    ASSERT_TRUE(wasm_runtime_attach_shared_heap(module_inst, shared_heap));
+
+    /* The first and the last words of the heap */
+    ASSERT_TRUE(store_i32(exec_env, HEAP_START, 1));
+    ASSERT_TRUE(load_i32(exec_env, HEAP_START, &value));
+    ASSERT_EQ(value, 1u);
+    ASSERT_TRUE(store_i32(exec_env, UINT32_MAX - 3, 2));
+    ASSERT_TRUE(load_i32(exec_env, UINT32_MAX - 3, &value));
+    ASSERT_EQ(value, 2u);
+
+    /* Across the end of the heap, i.e. the end of the address space */
+    ASSERT_FALSE(load_i32(exec_env, UINT32_MAX - 1, &value));
+    ASSERT_FALSE(store_i32(exec_env, UINT32_MAX, 3));
+    argv[0] = UINT32_MAX - 19;
+    ASSERT_TRUE(call(exec_env, "load16", argv, 1));
+    ASSERT_EQ(argv[0], 2u);
+    argv[0] = UINT32_MAX - 15;
+    ASSERT_FALSE(call(exec_env, "load16", argv, 1));
+    ASSERT_FALSE(call3(exec_env, "fill", UINT32_MAX - 3, 0, 5));
+    ASSERT_FALSE(call3(exec_env, "copy", UINT32_MAX - 3, HEAP_START, 5));
+
+    /* Across the start of the heap, and in the gap between the linear
+       memory and the heap */
+    ASSERT_FALSE(load_i32(exec_env, HEAP_START - 2, &value));
+    ASSERT_FALSE(store_i32(exec_env, HEAP_START - 4, 4));
+    ASSERT_FALSE(load_i32(exec_env, HEAP_START / 2, &value));
+    ASSERT_FALSE(call3(exec_env, "fill", HEAP_START - 1, 0, 2));
+    ASSERT_FALSE(call3(exec_env, "copy", 0, HEAP_START - 4, 8));
+
+    /* The end of the linear memory is still checked */
+    ASSERT_TRUE(load_i32(exec_env, LINEAR_MEM_SIZE - 4, &value));
+    ASSERT_FALSE(load_i32(exec_env, LINEAR_MEM_SIZE - 2, &value));
+    ASSERT_FALSE(call3(exec_env, "fill", LINEAR_MEM_SIZE - 1, 0, 2));
+
+    /* The linear memory grows while the heap is attached */
+    argv[0] = 1;
+    ASSERT_TRUE(call(exec_env, "grow", argv, 1));
+    ASSERT_EQ(argv[0], 1u);
+    ASSERT_TRUE(load_i32(exec_env, LINEAR_MEM_SIZE, &value));
+    ASSERT_TRUE(load_i32(exec_env, UINT32_MAX - 3, &value));
+    ASSERT_EQ(value, 2u);
+}
+
+TEST_F(SharedHeapTest, attached_and_detached)
+{
+    wasm_exec_env_t exec_env = instantiate();
+    wasm_module_inst_t module_inst, no_memory_inst;
+    wasm_module_t no_memory_module;
+    wasm_shared_heap_t other_heap;
+    SharedHeapInitArgs heap_init_args;
+    uint64_t app_addr;
+    uint32_t value;
+    void *native;
+
+    ASSERT_NE(exec_env, nullptr);
+    module_inst = wasm_runtime_get_module_inst(exec_env);
+
+    heap_init_args.size = HEAP_SIZE;
+    other_heap = wasm_runtime_create_shared_heap(&heap_init_args);
+    ASSERT_NE(other_heap, nullptr);
+
+    app_addr = wasm_runtime_shared_heap_malloc(shared_heap, 16, &native);
+    ASSERT_NE(app_addr, 0u);
+    *(uint32_t *)native = 0x1234;
+
+    /* Not accessible until attached */
+    ASSERT_FALSE(load_i32(exec_env, (uint32_t)app_addr, &value));
+    ASSERT_FALSE(wasm_runtime_validate_app_addr(module_inst, app_addr, 4));
+    wasm_runtime_clear_exception(module_inst);
+
+    ASSERT_TRUE(wasm_runtime_attach_shared_heap(module_inst, shared_heap));
+    ASSERT_TRUE(load_i32(exec_env, (uint32_t)app_addr, &value));
+    ASSERT_EQ(value, 0x1234u);
+
+    /* One heap is attached at a time, and an attached heap can't be
+       destroyed */
+    ASSERT_FALSE(wasm_runtime_attach_shared_heap(module_inst, other_heap));
+    ASSERT_FALSE(wasm_runtime_attach_shared_heap(module_inst, shared_heap));
+    ASSERT_FALSE(wasm_runtime_destroy_shared_heap(shared_heap));
+
+    wasm_runtime_detach_shared_heap(module_inst);
+    ASSERT_FALSE(load_i32(exec_env, (uint32_t)app_addr, &value));
+    ASSERT_FALSE(wasm_runtime_validate_app_addr(module_inst, app_addr, 4));
+    wasm_runtime_clear_exception(module_inst);
+    /* Detaching twice is harmless */
+    wasm_runtime_detach_shared_heap(module_inst);
+
+    /* Another heap at the same app address */
+    ASSERT_TRUE(wasm_runtime_attach_shared_heap(module_inst, other_heap));
+    ASSERT_TRUE(store_i32(exec_env, (uint32_t)app_addr, 0x5678));
+    ASSERT_EQ(*(uint32_t *)native, 0x1234u);
+    wasm_runtime_detach_shared_heap(module_inst);
+
+    ASSERT_TRUE(wasm_runtime_destroy_shared_heap(shared_heap));
+    shared_heap = nullptr;
+
+    /* The heap is detached when the instance is deinstantiated */
+    ASSERT_TRUE(wasm_runtime_attach_shared_heap(module_inst, other_heap));
+    wasm_runtime_destroy_exec_env(exec_env);
+    exec_envs.clear();
+    wasm_runtime_deinstantiate(module_inst);
+    module_insts.clear();
+    ASSERT_TRUE(wasm_runtime_destroy_shared_heap(other_heap));
+
+    /* A module without linear memory can't attach a heap */
+    no_memory_module = load(no_memory_wasm, sizeof(no_memory_wasm));
+    ASSERT_NE(no_memory_module, nullptr);
+    no_memory_inst = wasm_runtime_instantiate(no_memory_module, 8 * 1024, 0,
+                                              error_buf, sizeof(error_buf));
+    ASSERT_NE(no_memory_inst, nullptr) << error_buf;
+    heap_init_args.size = HEAP_SIZE;
+    other_heap = wasm_runtime_create_shared_heap(&heap_init_args);
+    ASSERT_NE(other_heap, nullptr);
+    ASSERT_FALSE(wasm_runtime_attach_shared_heap(no_memory_inst, other_heap));
+    wasm_runtime_deinstantiate(no_memory_inst);
+    wasm_runtime_unload(no_memory_module);
+}
+
+TEST_F(SharedHeapTest, invalid_sizes_rejected)
+{
+    SharedHeapInitArgs heap_init_args;
+    void *native;
+
+    heap_init_args.size = 0;
+    ASSERT_EQ(wasm_runtime_create_shared_heap(&heap_init_args), nullptr);
+    /* At least one wasm page is left for the linear memory */
+    heap_init_args.size = UINT32_MAX;
+    ASSERT_EQ(wasm_runtime_create_shared_heap(&heap_init_args), nullptr);
+
+    ASSERT_EQ(wasm_runtime_shared_heap_malloc(shared_heap, 0, &native), 0u);
+    ASSERT_EQ(native, nullptr);
+}
@@ -0,0 +1,92 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/core/deps/llvm/build/cmake/FindFFI.cmake"
+  "/root/repo/core/deps/llvm/build/cmake/FindTerminfo.cmake"
+  "/root/repo/core/deps/llvm/build/cmake/LLVMConfig.cmake"
+  "/root/repo/core/deps/llvm/build/cmake/LLVMConfigVersion.cmake"
+  "/root/repo/core/iwasm/aot/iwasm_aot.cmake"
+  "/root/repo/core/iwasm/common/gc/iwasm_gc.cmake"
+  "/root/repo/core/iwasm/common/iwasm_common.cmake"
+  "/root/repo/core/iwasm/compilation/iwasm_compl.cmake"
+  "/root/repo/core/iwasm/interpreter/iwasm_interp.cmake"
+  "/root/repo/core/iwasm/libraries/lib-pthread/lib_pthread.cmake"
+  "/root/repo/core/iwasm/libraries/lib-wasi-threads/lib_wasi_threads.cmake"
+  "/root/repo/core/iwasm/libraries/libc-builtin/libc_builtin.cmake"
+  "/root/repo/core/iwasm/libraries/libc-wasi/libc_wasi.cmake"
+  "/root/repo/core/iwasm/libraries/thread-mgr/thread_mgr.cmake"
+  "/root/repo/core/shared/mem-alloc/mem_alloc.cmake"
+  "/root/repo/core/shared/platform/common/libc-util/platform_common_libc_util.cmake"
+  "/root/repo/core/shared/platform/common/posix/platform_api_posix.cmake"
+  "/root/repo/core/shared/platform/linux/shared_platform.cmake"
+  "/root/repo/core/shared/utils/shared_utils.cmake"
+  "/root/repo/core/shared/utils/uncommon/shared_uncommon.cmake"
+  "/root/repo/wamr-compiler/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeASMCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/usr/lib/llvm-14/lib/cmake/llvm/LLVM-Config.cmake"
+  "/usr/lib/llvm-14/lib/cmake/llvm/LLVMExports-release.cmake"
+  "/usr/lib/llvm-14/lib/cmake/llvm/LLVMExports.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeASMInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePushCheckState.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckPIESupported.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-ASM.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/FindLibXml2.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindZLIB.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckLinkerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/intrinsics_gen.dir/DependInfo.cmake"
+  "CMakeFiles/omp_gen.dir/DependInfo.cmake"
+  "CMakeFiles/acc_gen.dir/DependInfo.cmake"
+  "CMakeFiles/vmlib.dir/DependInfo.cmake"
+  "CMakeFiles/aotclib.dir/DependInfo.cmake"
+  "CMakeFiles/wamrc.dir/DependInfo.cmake"
+  )
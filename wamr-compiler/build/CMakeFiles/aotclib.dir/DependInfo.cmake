@@ -0,0 +1,52 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/iwasm/compilation/aot.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_compiler.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_compiler.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_compiler.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_aot_file.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_aot_file.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_aot_file.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_compare.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_compare.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_compare.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_const.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_const.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_const.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_control.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_control.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_control.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_conversion.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_conversion.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_conversion.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_exception.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_exception.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_exception.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_function.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_function.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_function.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_gc.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_gc.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_gc.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_memory.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_memory.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_memory.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_numberic.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_numberic.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_numberic.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_parametric.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_parametric.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_parametric.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_stringref.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_stringref.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_stringref.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_table.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_table.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_table.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_emit_variable.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_variable.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_variable.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_llvm.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_access_lanes.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_access_lanes.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_access_lanes.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_bit_shifts.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bit_shifts.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bit_shifts.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_bitmask_extracts.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitmask_extracts.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitmask_extracts.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_bitwise_ops.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitwise_ops.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitwise_ops.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_bool_reductions.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bool_reductions.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bool_reductions.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_common.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_common.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_common.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_comparisons.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_comparisons.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_comparisons.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_construct_values.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_construct_values.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_construct_values.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_conversions.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_conversions.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_conversions.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_floating_point.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_floating_point.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_floating_point.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_int_arith.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_int_arith.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_int_arith.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_load_store.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_load_store.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_load_store.c.o.d"
+  "/root/repo/core/iwasm/compilation/simd/simd_sat_int_arith.c" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_sat_int_arith.c.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_sat_int_arith.c.o.d"
+  "/root/repo/core/iwasm/compilation/aot_llvm_extra.cpp" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra.cpp.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra.cpp.o.d"
+  "/root/repo/core/iwasm/compilation/aot_llvm_extra2.cpp" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra2.cpp.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra2.cpp.o.d"
+  "/root/repo/core/iwasm/compilation/aot_orc_extra.cpp" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra.cpp.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra.cpp.o.d"
+  "/root/repo/core/iwasm/compilation/aot_orc_extra2.cpp" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra2.cpp.o" "gcc" "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra2.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
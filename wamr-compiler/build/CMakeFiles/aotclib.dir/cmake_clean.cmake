@@ -0,0 +1,77 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_compiler.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_compiler.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_aot_file.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_aot_file.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_compare.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_compare.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_const.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_const.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_control.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_control.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_conversion.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_conversion.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_exception.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_exception.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_function.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_function.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_gc.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_gc.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_memory.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_memory.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_numberic.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_numberic.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_parametric.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_parametric.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_stringref.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_stringref.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_table.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_table.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_variable.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_emit_variable.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra.cpp.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra.cpp.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra2.cpp.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_llvm_extra2.cpp.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra.cpp.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra.cpp.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra2.cpp.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/aot_orc_extra2.cpp.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_access_lanes.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_access_lanes.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bit_shifts.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bit_shifts.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitmask_extracts.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitmask_extracts.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitwise_ops.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bitwise_ops.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bool_reductions.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_bool_reductions.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_common.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_common.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_comparisons.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_comparisons.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_construct_values.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_construct_values.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_conversions.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_conversions.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_floating_point.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_floating_point.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_int_arith.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_int_arith.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_load_store.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_load_store.c.o.d"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_sat_int_arith.c.o"
+  "CMakeFiles/aotclib.dir/root/repo/core/iwasm/compilation/simd/simd_sat_int_arith.c.o.d"
+  "libaotclib.a"
+  "libaotclib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/aotclib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,149 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  "ASM"
+  )
+# The set of files for implicit dependencies of each language:
+set(CMAKE_DEPENDS_CHECK_ASM
+  "/root/repo/core/iwasm/common/arch/invokeNative_em64.s" "/root/repo/wamr-compiler/build/CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/arch/invokeNative_em64.s.o"
+  )
+set(CMAKE_ASM_COMPILER_ID "GNU")
+
+# Preprocessor definitions for this target.
+set(CMAKE_TARGET_DEFINITIONS_ASM
+  "BH_FREE=wasm_runtime_free"
+  "BH_MALLOC=wasm_runtime_malloc"
+  "BH_PLATFORM_LINUX"
+  "BUILD_TARGET_X86_64"
+  "WASM_DISABLE_HW_BOUND_CHECK=1"
+  "WASM_ENABLE_AOT=1"
+  "WASM_ENABLE_AOT_STACK_FRAME=1"
+  "WASM_ENABLE_BULK_MEMORY=1"
+  "WASM_ENABLE_CUSTOM_NAME_SECTION=1"
+  "WASM_ENABLE_DUMP_CALL_STACK=1"
+  "WASM_ENABLE_GC=1"
+  "WASM_ENABLE_HEAP_AUX_STACK_ALLOCATION=1"
+  "WASM_ENABLE_INTERP=1"
+  "WASM_ENABLE_LIBC_BUILTIN=1"
+  "WASM_ENABLE_LIBC_WASI=1"
+  "WASM_ENABLE_LIB_PTHREAD=1"
+  "WASM_ENABLE_LIB_WASI_THREADS=1"
+  "WASM_ENABLE_LINUX_PERF=1"
+  "WASM_ENABLE_LOAD_CUSTOM_SECTION=1"
+  "WASM_ENABLE_MEMORY64=1"
+  "WASM_ENABLE_MODULE_INST_CONTEXT=1"
+  "WASM_ENABLE_PERF_PROFILING=1"
+  "WASM_ENABLE_REF_TYPES=1"
+  "WASM_ENABLE_SHARED_HEAP=1"
+  "WASM_ENABLE_SHARED_MEMORY=1"
+  "WASM_ENABLE_SIMD=1"
+  "WASM_ENABLE_STRINGREF=1"
+  "WASM_ENABLE_TAIL_CALL=1"
+  "WASM_ENABLE_THREAD_MGR=1"
+  "WASM_ENABLE_WAMR_COMPILER=1"
+  "WASM_HAVE_MREMAP=1"
+  "_FORTIFY_SOURCE=2"
+  "_GNU_SOURCE"
+  )
+
+# The include file search paths:
+set(CMAKE_ASM_TARGET_INCLUDE_PATH
+  "/usr/lib/llvm-14/include"
+  "/root/repo/wamr-compiler/../core/shared/include"
+  "/root/repo/wamr-compiler/../core/iwasm/include"
+  "/root/repo/core/shared/platform/linux"
+  "/root/repo/core/shared/platform/linux/../include"
+  "/root/repo/core/shared/platform/common/libc-util"
+  "/root/repo/core/shared/mem-alloc"
+  "/root/repo/core/shared/utils"
+  "/root/repo/core/shared/utils/uncommon"
+  "/root/repo/core/iwasm/libraries/thread-mgr"
+  "/root/repo/core/iwasm/common"
+  "/root/repo/core/iwasm/common/gc"
+  "/root/repo/core/iwasm/common/gc/stringref"
+  "/root/repo/core/iwasm/interpreter"
+  "/root/repo/core/iwasm/aot"
+  "/root/repo/core/iwasm/compilation"
+  "/root/repo/core/iwasm/libraries/libc-builtin"
+  "/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/include"
+  "/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src"
+  "/root/repo/core/iwasm/libraries/lib-pthread"
+  "/root/repo/core/iwasm/libraries/lib-wasi-threads"
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/core/iwasm/aot/aot_intrinsic.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_intrinsic.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_intrinsic.c.o.d"
+  "/root/repo/core/iwasm/aot/aot_loader.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_loader.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_loader.c.o.d"
+  "/root/repo/core/iwasm/aot/aot_perf_map.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_perf_map.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_perf_map.c.o.d"
+  "/root/repo/core/iwasm/aot/aot_runtime.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_runtime.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_runtime.c.o.d"
+  "/root/repo/core/iwasm/aot/arch/aot_reloc_x86_64.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/arch/aot_reloc_x86_64.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/arch/aot_reloc_x86_64.c.o.d"
+  "/root/repo/core/iwasm/common/gc/gc_common.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_common.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_common.c.o.d"
+  "/root/repo/core/iwasm/common/gc/gc_object.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_object.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_object.c.o.d"
+  "/root/repo/core/iwasm/common/gc/gc_type.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_type.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_type.c.o.d"
+  "/root/repo/core/iwasm/common/gc/stringref/stringref_stub.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/stringref/stringref_stub.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/stringref/stringref_stub.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_application.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_application.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_application.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_blocking_op.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_blocking_op.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_blocking_op.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_c_api.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_c_api.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_c_api.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_exec_env.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_exec_env.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_exec_env.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_instance_reset.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_instance_reset.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_instance_reset.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_loader_common.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_loader_common.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_loader_common.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_memory.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_memory.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_memory.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_module_snapshot.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_module_snapshot.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_module_snapshot.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_native.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_native.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_native.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_runtime_common.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_runtime_common.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_runtime_common.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_sampling_profiler.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_sampling_profiler.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_sampling_profiler.c.o.d"
+  "/root/repo/core/iwasm/common/wasm_shared_memory.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_shared_memory.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_shared_memory.c.o.d"
+  "/root/repo/core/iwasm/interpreter/wasm_interp_classic.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_interp_classic.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_interp_classic.c.o.d"
+  "/root/repo/core/iwasm/interpreter/wasm_loader.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_loader.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_loader.c.o.d"
+  "/root/repo/core/iwasm/interpreter/wasm_runtime.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_runtime.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_runtime.c.o.d"
+  "/root/repo/core/iwasm/libraries/lib-pthread/lib_pthread_wrapper.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-pthread/lib_pthread_wrapper.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-pthread/lib_pthread_wrapper.c.o.d"
+  "/root/repo/core/iwasm/libraries/lib-wasi-threads/lib_wasi_threads_wrapper.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/lib_wasi_threads_wrapper.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/lib_wasi_threads_wrapper.c.o.d"
+  "/root/repo/core/iwasm/libraries/lib-wasi-threads/tid_allocator.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/tid_allocator.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/tid_allocator.c.o.d"
+  "/root/repo/core/iwasm/libraries/libc-builtin/libc_builtin_wrapper.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-builtin/libc_builtin_wrapper.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-builtin/libc_builtin_wrapper.c.o.d"
+  "/root/repo/core/iwasm/libraries/libc-wasi/libc_wasi_wrapper.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/libc_wasi_wrapper.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/libc_wasi_wrapper.c.o.d"
+  "/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/blocking_op.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/blocking_op.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/blocking_op.c.o.d"
+  "/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/posix.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/posix.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/posix.c.o.d"
+  "/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/random.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/random.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/random.c.o.d"
+  "/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/str.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/str.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/str.c.o.d"
+  "/root/repo/core/iwasm/libraries/thread-mgr/thread_manager.c" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/thread-mgr/thread_manager.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/thread-mgr/thread_manager.c.o.d"
+  "/root/repo/core/shared/mem-alloc/ems/ems_alloc.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_alloc.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_alloc.c.o.d"
+  "/root/repo/core/shared/mem-alloc/ems/ems_gc.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_gc.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_gc.c.o.d"
+  "/root/repo/core/shared/mem-alloc/ems/ems_hmu.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_hmu.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_hmu.c.o.d"
+  "/root/repo/core/shared/mem-alloc/ems/ems_kfc.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_kfc.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_kfc.c.o.d"
+  "/root/repo/core/shared/mem-alloc/mem_alloc.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/mem_alloc.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/mem_alloc.c.o.d"
+  "/root/repo/core/shared/platform/common/libc-util/libc_errno.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/libc-util/libc_errno.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/libc-util/libc_errno.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_blocking_op.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_blocking_op.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_blocking_op.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_clock.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_clock.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_clock.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_file.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_file.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_file.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_malloc.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_malloc.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_malloc.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_memmap.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_memmap.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_memmap.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_sampling_timer.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sampling_timer.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sampling_timer.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_sleep.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sleep.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sleep.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_socket.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_socket.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_socket.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_thread.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_thread.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_thread.c.o.d"
+  "/root/repo/core/shared/platform/common/posix/posix_time.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_time.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_time.c.o.d"
+  "/root/repo/core/shared/platform/linux/platform_futex.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_futex.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_futex.c.o.d"
+  "/root/repo/core/shared/platform/linux/platform_init.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_init.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_init.c.o.d"
+  "/root/repo/core/shared/utils/bh_assert.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_assert.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_assert.c.o.d"
+  "/root/repo/core/shared/utils/bh_bitmap.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_bitmap.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_bitmap.c.o.d"
+  "/root/repo/core/shared/utils/bh_common.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_common.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_common.c.o.d"
+  "/root/repo/core/shared/utils/bh_hashmap.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_hashmap.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_hashmap.c.o.d"
+  "/root/repo/core/shared/utils/bh_list.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_list.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_list.c.o.d"
+  "/root/repo/core/shared/utils/bh_log.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_log.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_log.c.o.d"
+  "/root/repo/core/shared/utils/bh_queue.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_queue.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_queue.c.o.d"
+  "/root/repo/core/shared/utils/bh_vector.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_vector.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_vector.c.o.d"
+  "/root/repo/core/shared/utils/runtime_timer.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/runtime_timer.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/runtime_timer.c.o.d"
+  "/root/repo/core/shared/utils/uncommon/bh_getopt.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_getopt.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_getopt.c.o.d"
+  "/root/repo/core/shared/utils/uncommon/bh_read_file.c" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_read_file.c.o" "gcc" "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_read_file.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
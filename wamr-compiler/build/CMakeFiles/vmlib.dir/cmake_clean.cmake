@@ -0,0 +1,136 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_intrinsic.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_intrinsic.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_loader.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_loader.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_perf_map.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_perf_map.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_runtime.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/aot_runtime.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/arch/aot_reloc_x86_64.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/aot/arch/aot_reloc_x86_64.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/arch/invokeNative_em64.s.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_common.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_common.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_object.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_object.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_type.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/gc_type.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/stringref/stringref_stub.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/gc/stringref/stringref_stub.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_application.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_application.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_blocking_op.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_blocking_op.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_c_api.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_c_api.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_exec_env.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_exec_env.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_instance_reset.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_instance_reset.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_loader_common.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_loader_common.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_memory.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_memory.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_module_snapshot.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_module_snapshot.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_native.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_native.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_runtime_common.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_runtime_common.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_sampling_profiler.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_sampling_profiler.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_shared_memory.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/common/wasm_shared_memory.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_interp_classic.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_interp_classic.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_loader.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_loader.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_runtime.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/interpreter/wasm_runtime.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-pthread/lib_pthread_wrapper.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-pthread/lib_pthread_wrapper.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/lib_wasi_threads_wrapper.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/lib_wasi_threads_wrapper.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/tid_allocator.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/lib-wasi-threads/tid_allocator.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-builtin/libc_builtin_wrapper.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-builtin/libc_builtin_wrapper.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/libc_wasi_wrapper.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/libc_wasi_wrapper.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/blocking_op.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/blocking_op.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/posix.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/posix.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/random.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/random.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/str.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/libc-wasi/sandboxed-system-primitives/src/str.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/thread-mgr/thread_manager.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/iwasm/libraries/thread-mgr/thread_manager.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_alloc.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_alloc.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_gc.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_gc.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_hmu.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_hmu.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_kfc.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/ems/ems_kfc.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/mem_alloc.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/mem-alloc/mem_alloc.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/libc-util/libc_errno.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/libc-util/libc_errno.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_blocking_op.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_blocking_op.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_clock.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_clock.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_file.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_file.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_malloc.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_malloc.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_memmap.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_memmap.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sampling_timer.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sampling_timer.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sleep.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_sleep.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_socket.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_socket.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_thread.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_thread.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_time.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/common/posix/posix_time.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_futex.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_futex.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_init.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/platform/linux/platform_init.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_assert.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_assert.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_bitmap.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_bitmap.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_common.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_common.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_hashmap.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_hashmap.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_list.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_list.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_log.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_log.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_queue.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_queue.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_vector.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/bh_vector.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/runtime_timer.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/runtime_timer.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_getopt.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_getopt.c.o.d"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_read_file.c.o"
+  "CMakeFiles/vmlib.dir/root/repo/core/shared/utils/uncommon/bh_read_file.c.o.d"
+  "libvmlib.a"
+  "libvmlib.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang ASM C)
+  include(CMakeFiles/vmlib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
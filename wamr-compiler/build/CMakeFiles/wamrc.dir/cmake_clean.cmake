@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/wamrc.dir/main.c.o"
+  "CMakeFiles/wamrc.dir/main.c.o.d"
+  "wamrc"
+  "wamrc.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/wamrc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -127,6 +127,9 @@ print_help()
     printf("  --opt-level=n             Set the optimization level (0 to 3, default is 3)\n");
     printf("  --size-level=n            Set the code size level (0 to 3, default is 3)\n");
     printf("  -sgx                      Generate code for SGX platform (Intel Software Guard Extensions)\n");
+    printf("  --threads=n               Emit the machine code of the functions with n threads in parallel\n");
+    printf("                            (default is 1), the output is identical to the single-threaded one\n");
+    printf("                            Only supported for x86_64 ELF targets and the aot output format\n");
     printf("  --bounds-checks=1/0       Enable or disable the bounds checks for memory access:\n");
     printf("                              by default it is disabled in all 64-bit platforms except SGX and\n");
     printf("                              in these platforms runtime does bounds checks with hardware trap,\n");
@@ -162,6 +165,25 @@ print_help()
     printf("  --enable-memory-profiling Enable memory usage profiling\n");
     printf("  --xip                     A shorthand of --enalbe-indirect-mode --disable-llvm-intrinsics\n");
     printf("  --enable-indirect-mode    Enalbe call function through symbol table but not direct call\n");
+    printf("  --enable-shared-text      Emit the text section page-aligned and pre-relocated, so that the\n");
+    printf("                              runtime can map it from the AOT file directly and share its pages\n");
+    printf("                              between processes, it implies --xip, only supported for x86_64 linux\n");
+    printf("  --enable-fuel-metering    Charge the fuel of the exec env with the instruction count of each\n");
+    printf("                              block, the runtime must be built with WAMR_BUILD_FUEL_METERING=1\n");
+    printf("  --enable-safepoint-page   Poll the safepoint page of the exec env at the loop back-edges instead\n");
+    printf("                              of checking the suspend flags, so that the runtime interrupts the\n");
+    printf("                              thread by protecting the page, the runtime must be built with\n");
+    printf("                              WAMR_BUILD_AOT_SAFEPOINT=1 on linux or darwin\n");
+    printf("  --enable-gc-write-barrier Call the write barrier after storing a reference into an object, so that\n");
+    printf("                              the runtime built with WAMR_BUILD_GC_NURSERY=1 can collect the young\n");
+    printf("                              objects separately, it requires --enable-gc\n");
+    printf("  --enable-gc-pre-write-barrier\n");
+    printf("                            Call the pre-write barrier before overwriting a reference in an object,\n");
+    printf("                              so that the runtime built with WAMR_BUILD_GC_INCREMENTAL=1 can mark\n");
+    printf("                              the objects incrementally, it requires --enable-gc\n");
+    printf("  --enable-shared-heap      Check the app addresses of the memory accesses against the shared heap,\n");
+    printf("                              so that a shared heap can be attached to the instances by the runtime\n");
+    printf("                              built with WAMR_BUILD_SHARED_HEAP=1, it disables segue\n");
     printf("  --enable-gc               Enalbe GC (Garbage Collection) feature\n");
     printf("  --disable-llvm-intrinsics Disable the LLVM built-in intrinsics\n");
     printf("  --enable-builtin-intrinsics=<flags>\n");
@@ -404,6 +426,13 @@ main(int argc, char *argv[])
                 option.size_level = 3;
             size_level_set = true;
         }
+        else if (!strncmp(argv[0], "--threads=", 10)) {
+            if (argv[0][10] == '\0')
+                PRINT_HELP_AND_EXIT();
+            option.thread_num = (uint32)atoi(argv[0] + 10);
+            if (option.thread_num == 0)
+                PRINT_HELP_AND_EXIT();
+        }
         else if (!strcmp(argv[0], "-sgx")) {
             sgx_mode = true;
         }
@@ -478,6 +507,26 @@ main(int argc, char *argv[])
         else if (!strcmp(argv[0], "--enable-indirect-mode")) {
             option.is_indirect_mode = true;
         }
+        else if (!strcmp(argv[0], "--enable-shared-text")) {
+            option.is_indirect_mode = true;
+            option.disable_llvm_intrinsics = true;
+            option.enable_shared_text = true;
+        }
+        else if (!strcmp(argv[0], "--enable-fuel-metering")) {
+            option.enable_fuel_metering = true;
+        }
+        else if (!strcmp(argv[0], "--enable-safepoint-page")) {
+            option.enable_safepoint_page = true;
+        }
+        else if (!strcmp(argv[0], "--enable-gc-write-barrier")) {
+            option.enable_gc_write_barrier = true;
+        }
+        else if (!strcmp(argv[0], "--enable-gc-pre-write-barrier")) {
+            option.enable_gc_pre_write_barrier = true;
+        }
+        else if (!strcmp(argv[0], "--enable-shared-heap")) {
+            option.enable_shared_heap = true;
+        }
         else if (!strcmp(argv[0], "--enable-gc")) {
             option.enable_aux_stack_frame = true;
             option.enable_gc = true;